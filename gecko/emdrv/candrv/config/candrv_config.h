@@ -0,0 +1,63 @@
+/***************************************************************************//**
+ * @file
+ * @brief CANDRV configuration file.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+
+#ifndef CANDRV_CONFIG_H
+#define CANDRV_CONFIG_H
+
+// <<< Use Configuration Wizard in Context Menu >>>
+
+// <o EMDRV_CANDRV_IRQ_PRIORITY> CAN interrupt priority <0-7>
+// <i> Default: 4
+#define EMDRV_CANDRV_IRQ_PRIORITY 4
+
+// <q EMDRV_CANDRV_IRQ_HANDLERS> CAN interrupt handlers
+// <i> When enabled, the driver implements the interrupt handlers of all CAN
+// <i> instances. Disable it if the application needs these interrupt handlers,
+// <i> the application must then call CANDRV_IRQHandler() from them.
+// <i> Default: 1
+#define EMDRV_CANDRV_IRQ_HANDLERS 1
+
+// <o EMDRV_CANDRV_RX_FIFO_DEPTH> Default number of message objects per RX FIFO <1-31>
+// <i> Number of message objects chained into the hardware RX FIFO of each
+// <i> allocated hardware filter, used when CANDRV_Init_t.rxFifoDepth is 0.
+// <i> Default: 8
+#define EMDRV_CANDRV_RX_FIFO_DEPTH 8
+
+// <o EMDRV_CANDRV_MAX_FILTERS> Maximum number of declared acceptance filters <1-64>
+// <i> Default: 16
+#define EMDRV_CANDRV_MAX_FILTERS 16
+
+// <o EMDRV_CANDRV_TX_PRIORITY_LEVELS> Number of TX priority levels <1-8>
+// <i> Default: 4
+#define EMDRV_CANDRV_TX_PRIORITY_LEVELS 4
+
+// <<< end of configuration section >>>
+
+#endif // CANDRV_CONFIG_H
@@ -0,0 +1,218 @@
+/***************************************************************************//**
+ * @file
+ * @brief CANDRV API definition.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+
+#ifndef __SILICON_LABS_CANDRV_H__
+#define __SILICON_LABS_CANDRV_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "em_device.h"
+
+#if defined(CAN_COUNT) && (CAN_COUNT > 0)
+
+#include "em_can.h"
+#include "sl_status.h"
+#include "candrv_config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***************************************************************************//**
+ * @addtogroup candrv CANDRV - CAN Driver
+ * @brief Interrupt driven CAN driver with RX FIFO and prioritized TX queue.
+ *
+ * @details
+ *  CANDRV owns all 32 message objects of a CAN instance.
+ *
+ *  - The acceptance filters given at initialization are reduced to as few
+ *    hardware filters as possible, see @ref CANDRV_AllocateFilters().
+ *  - Each hardware filter gets a FIFO of chained RX message objects. The
+ *    interrupt handler drains the FIFOs into a software ring, oldest frame
+ *    first, and the application reads the ring with @ref CANDRV_Receive().
+ *  - Frames given to @ref CANDRV_Transmit() are queued per priority level and
+ *    handed one at a time to the TX message object, highest priority first and
+ *    in order within a level.
+ *
+ *  The CAN peripheral must be initialized with CAN_Init() before
+ *  @ref CANDRV_Init() is called.
+ *
+ * @{
+ ******************************************************************************/
+
+#define CANDRV_MSG_OBJECT_COUNT   32U                       ///< Number of message objects of a CAN instance.
+#define CANDRV_TX_MSG_NUM         CANDRV_MSG_OBJECT_COUNT   ///< Message object used for transmission.
+#define CANDRV_RX_MSG_OBJECTS     (CANDRV_MSG_OBJECT_COUNT - 1U) ///< Message objects available for RX FIFOs.
+#define CANDRV_TX_QUEUE_MAX       255U                      ///< Maximum TX queue size.
+
+/// Acceptance filter. A frame is accepted when (frame id & mask) == (id & mask).
+typedef struct {
+  uint32_t  id;         ///< Identifier, 11 bits (standard) or 29 bits (extended).
+  uint32_t  mask;       ///< Identifier bits to compare, 0 to accept all identifiers.
+  bool      extended;   ///< True for extended identifiers, false for standard identifiers.
+} CANDRV_Filter_t;
+
+/// Hardware filter allocated by @ref CANDRV_AllocateFilters().
+typedef struct {
+  uint32_t  id;         ///< Identifier programmed in the message objects.
+  uint32_t  mask;       ///< Mask programmed in the message objects.
+  bool      extended;   ///< True for extended identifiers.
+  bool      exact;      ///< False if the hardware filter accepts identifiers no declared filter accepts.
+} CANDRV_HwFilter_t;
+
+/// CAN data frame.
+typedef struct {
+  uint32_t  id;         ///< Identifier.
+  bool      extended;   ///< True for an extended identifier.
+  uint8_t   dlc;        ///< Data length code [0 - 8].
+  uint8_t   data[8];    ///< Data.
+  uint8_t   filter;     ///< Index of the first declared filter accepting a received frame.
+} CANDRV_Frame_t;
+
+/// TX queue entry, the application provides the storage.
+typedef struct {
+  CANDRV_Frame_t  frame;  ///< Queued frame.
+  uint8_t         next;   ///< Next entry in the same list.
+} CANDRV_TxEntry_t;
+
+/// CANDRV statistics.
+typedef struct {
+  uint32_t  rxFrames;         ///< Frames put in the RX ring.
+  uint32_t  rxRingOverflows;  ///< Frames dropped because the RX ring was full.
+  uint32_t  rxFifoOverflows;  ///< Hardware RX FIFO overflows, each losing one or more frames.
+  uint32_t  rxFiltered;       ///< Frames accepted by a hardware filter but by no declared filter.
+  uint32_t  txFrames;         ///< Frames transmitted.
+} CANDRV_Statistics_t;
+
+/// CANDRV handle data, must stay allocated while the handle is in use.
+typedef struct CANDRV_HandleData CANDRV_HandleData_t;
+
+/// CANDRV handle.
+typedef CANDRV_HandleData_t *CANDRV_Handle_t;
+
+/***************************************************************************//**
+ * @brief
+ *  RX callback, called from interrupt context after frames have been put in
+ *  the RX ring.
+ *
+ * @param[in] handle
+ *  The CANDRV handle.
+ *
+ * @param[in] userParam
+ *  The user parameter given in @ref CANDRV_Init_t.
+ ******************************************************************************/
+typedef void (*CANDRV_RxCallback_t)(CANDRV_Handle_t handle, void *userParam);
+
+/***************************************************************************//**
+ * @brief
+ *  TX callback, called from interrupt context when the last queued frame has
+ *  been transmitted.
+ *
+ * @param[in] handle
+ *  The CANDRV handle.
+ *
+ * @param[in] userParam
+ *  The user parameter given in @ref CANDRV_Init_t.
+ ******************************************************************************/
+typedef void (*CANDRV_TxCallback_t)(CANDRV_Handle_t handle, void *userParam);
+
+/// CANDRV initialization structure.
+typedef struct {
+  CAN_TypeDef             *can;           ///< CAN instance to use.
+  const CANDRV_Filter_t   *filters;       ///< Acceptance filters, must stay allocated.
+  uint8_t                 filterCount;    ///< Number of acceptance filters [1 - EMDRV_CANDRV_MAX_FILTERS].
+  uint8_t                 rxFifoDepth;    ///< Message objects per RX FIFO, 0 for EMDRV_CANDRV_RX_FIFO_DEPTH.
+  CANDRV_Frame_t          *rxBuffer;      ///< RX ring.
+  uint32_t                rxBufferSize;   ///< RX ring size in frames, a power of two.
+  CANDRV_TxEntry_t        *txQueue;       ///< TX queue storage.
+  uint32_t                txQueueSize;    ///< TX queue size in frames [1 - CANDRV_TX_QUEUE_MAX].
+  CANDRV_RxCallback_t     rxCallback;     ///< RX callback, NULL if not used.
+  CANDRV_TxCallback_t     txCallback;     ///< TX queue empty callback, NULL if not used.
+  void                    *userParam;     ///< User parameter passed to the callbacks.
+} CANDRV_Init_t;
+
+/// @cond DO_NOT_INCLUDE_WITH_DOXYGEN
+struct CANDRV_HandleData {
+  CAN_TypeDef             *can;
+  const CANDRV_Filter_t   *filters;
+  uint8_t                 filterCount;
+  uint8_t                 hwFilterCount;
+  uint8_t                 rxFifoDepth;
+  uint32_t                rxMask;         // Message objects used for RX, bit 0 is object 1
+  uint32_t                rxExtendedMask; // RX message objects with an extended filter
+  CANDRV_Frame_t          *rxBuffer;
+  uint32_t                rxBufferMask;
+  volatile uint32_t       rxHead;         // Free running write index
+  volatile uint32_t       rxTail;         // Free running read index
+  CANDRV_TxEntry_t        *txQueue;
+  uint8_t                 txFree;         // Head of the free list
+  uint8_t                 txHead[EMDRV_CANDRV_TX_PRIORITY_LEVELS];
+  uint8_t                 txTail[EMDRV_CANDRV_TX_PRIORITY_LEVELS];
+  volatile uint32_t       txQueued;       // Frames waiting in the queue
+  volatile bool           txBusy;         // A frame is in the TX message object
+  CANDRV_RxCallback_t     rxCallback;
+  CANDRV_TxCallback_t     txCallback;
+  void                    *userParam;
+  CANDRV_Statistics_t     stats;
+  bool                    initialized;
+};
+/// @endcond
+
+sl_status_t CANDRV_Init(CANDRV_Handle_t handle, const CANDRV_Init_t *init);
+sl_status_t CANDRV_DeInit(CANDRV_Handle_t handle);
+
+sl_status_t CANDRV_AllocateFilters(const CANDRV_Filter_t *filters,
+                                   uint8_t               filterCount,
+                                   uint8_t               maxHwFilters,
+                                   CANDRV_HwFilter_t     *hwFilters,
+                                   uint8_t               *hwFilterCount);
+
+sl_status_t CANDRV_Receive(CANDRV_Handle_t handle, CANDRV_Frame_t *frame);
+uint32_t CANDRV_RxPending(CANDRV_Handle_t handle);
+
+sl_status_t CANDRV_Transmit(CANDRV_Handle_t      handle,
+                            const CANDRV_Frame_t *frame,
+                            unsigned int         priority);
+uint32_t CANDRV_TxPending(CANDRV_Handle_t handle);
+
+sl_status_t CANDRV_GetStatistics(CANDRV_Handle_t     handle,
+                                 CANDRV_Statistics_t *stats);
+
+void CANDRV_IRQHandler(CANDRV_Handle_t handle);
+
+/** @} (end addtogroup candrv) */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* defined(CAN_COUNT) && (CAN_COUNT > 0) */
+#endif // __SILICON_LABS_CANDRV_H__
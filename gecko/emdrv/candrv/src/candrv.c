@@ -0,0 +1,847 @@
+/***************************************************************************//**
+ * @file
+ * @brief CAN driver with RX FIFO, filter allocation and prioritized TX queue.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "em_device.h"
+
+#if defined(CAN_COUNT) && (CAN_COUNT > 0)
+
+#include "em_can.h"
+#include "em_core.h"
+#include "sl_common.h"
+
+#include "candrv.h"
+
+/// @cond DO_NOT_INCLUDE_WITH_DOXYGEN
+
+#if !defined(EMDRV_CANDRV_IRQ_PRIORITY)
+#define EMDRV_CANDRV_IRQ_PRIORITY 4
+#endif
+
+#if !defined(EMDRV_CANDRV_IRQ_HANDLERS)
+#define EMDRV_CANDRV_IRQ_HANDLERS 1
+#endif
+
+#if (EMDRV_CANDRV_TX_PRIORITY_LEVELS < 1) || (EMDRV_CANDRV_TX_PRIORITY_LEVELS > 8)
+#error "EMDRV_CANDRV_TX_PRIORITY_LEVELS must be between 1 and 8"
+#endif
+
+// The interrupt handler reads RX objects through one message interface, the
+// TX path loads the TX object through the other one.
+#define RX_INTERFACE      0U
+#define TX_INTERFACE      1U
+
+#define STD_ID_MAX        0x7FFUL
+#define EXT_ID_MAX        0x1FFFFFFFUL
+
+// End of a TX queue list
+#define TX_NONE           0xFFU
+
+#define MSG_BIT(msgNum)   (1UL << ((msgNum) - 1U))
+
+static CANDRV_Handle_t handleTable[CAN_COUNT];
+
+static unsigned int CanIndex(const CAN_TypeDef *can);
+#if (EMDRV_CANDRV_IRQ_HANDLERS == 1)
+static IRQn_Type CanIrq(unsigned int canIndex);
+#endif
+static unsigned int BitCount(uint32_t value);
+static bool FilterMerge(CANDRV_HwFilter_t *hw, uint8_t *count);
+static uint32_t FifoPending(uint32_t pending, uint32_t fifoMask);
+static void RxDrain(CANDRV_Handle_t handle);
+static void RxReadObject(CANDRV_Handle_t handle, uint8_t msgNum);
+static void TxStartNext(CANDRV_Handle_t handle);
+
+/// @endcond
+
+/***************************************************************************//**
+ * @brief
+ *  Initialize a CANDRV handle.
+ *
+ * @details
+ *  The CAN peripheral must be initialized with CAN_Init() and routed to its
+ *  pins before calling this function. All message objects are reset, the
+ *  acceptance filters are allocated with @ref CANDRV_AllocateFilters() and
+ *  each hardware filter gets a FIFO of @p rxFifoDepth chained RX message
+ *  objects. Message object @ref CANDRV_TX_MSG_NUM is used for transmission.
+ *
+ * @param[in] handle
+ *  A pointer to the handle data, which must stay allocated until
+ *  @ref CANDRV_DeInit() is called.
+ *
+ * @param[in] init
+ *  A pointer to the initialization structure.
+ *
+ * @return
+ *  SL_STATUS_OK on success, SL_STATUS_INVALID_CONFIGURATION if the filters
+ *  cannot be allocated with the available message objects. On other
+ *  failures, an appropriate sl_status_t is returned.
+ ******************************************************************************/
+sl_status_t CANDRV_Init(CANDRV_Handle_t handle, const CANDRV_Init_t *init)
+{
+  CANDRV_HwFilter_t hwFilters[CANDRV_RX_MSG_OBJECTS];
+  CAN_MessageObject_TypeDef message;
+  unsigned int canIndex;
+  uint8_t depth;
+  uint8_t hwFilterCount;
+  uint8_t msgNum;
+  sl_status_t status;
+
+  if ((handle == NULL) || (init == NULL) || (init->can == NULL)
+      || (init->filters == NULL) || (init->rxBuffer == NULL)
+      || (init->txQueue == NULL)) {
+    return SL_STATUS_NULL_POINTER;
+  }
+  if (handle->initialized) {
+    return SL_STATUS_ALREADY_INITIALIZED;
+  }
+  canIndex = CanIndex(init->can);
+  if (canIndex >= CAN_COUNT) {
+    return SL_STATUS_INVALID_PARAMETER;
+  }
+  if (handleTable[canIndex] != NULL) {
+    return SL_STATUS_ALREADY_INITIALIZED;
+  }
+  if ((init->rxBufferSize < 2U)
+      || ((init->rxBufferSize & (init->rxBufferSize - 1U)) != 0U)
+      || (init->txQueueSize == 0U)
+      || (init->txQueueSize > CANDRV_TX_QUEUE_MAX)) {
+    return SL_STATUS_INVALID_PARAMETER;
+  }
+
+  depth = (init->rxFifoDepth != 0U) ? init->rxFifoDepth : EMDRV_CANDRV_RX_FIFO_DEPTH;
+  if (depth > CANDRV_RX_MSG_OBJECTS) {
+    return SL_STATUS_INVALID_PARAMETER;
+  }
+
+  status = CANDRV_AllocateFilters(init->filters,
+                                  init->filterCount,
+                                  (uint8_t)(CANDRV_RX_MSG_OBJECTS / depth),
+                                  hwFilters,
+                                  &hwFilterCount);
+  if (status != SL_STATUS_OK) {
+    return status;
+  }
+
+  memset(handle, 0, sizeof(*handle));
+  handle->can           = init->can;
+  handle->filters       = init->filters;
+  handle->filterCount   = init->filterCount;
+  handle->hwFilterCount = hwFilterCount;
+  handle->rxFifoDepth   = depth;
+  handle->rxBuffer      = init->rxBuffer;
+  handle->rxBufferMask  = init->rxBufferSize - 1U;
+  handle->txQueue       = init->txQueue;
+  handle->rxCallback    = init->rxCallback;
+  handle->txCallback    = init->txCallback;
+  handle->userParam     = init->userParam;
+
+  // Chain all TX queue entries in the free list
+  for (uint32_t i = 0U; i < init->txQueueSize; i++) {
+    handle->txQueue[i].next = (i + 1U < init->txQueueSize) ? (uint8_t)(i + 1U) : TX_NONE;
+  }
+  handle->txFree = 0U;
+  for (unsigned int level = 0U; level < EMDRV_CANDRV_TX_PRIORITY_LEVELS; level++) {
+    handle->txHead[level] = TX_NONE;
+    handle->txTail[level] = TX_NONE;
+  }
+
+  CAN_MessageIntDisable(handle->can, _CAN_IF0IEN_MASK);
+  CAN_ResetMessages(handle->can, RX_INTERFACE);
+
+  // Each hardware filter gets a FIFO of consecutive message objects, only the
+  // last one has the end of buffer bit set.
+  for (uint8_t i = 0U; i < hwFilterCount; i++) {
+    for (uint8_t k = 0U; k < depth; k++) {
+      msgNum = (uint8_t)(1U + (i * depth) + k);
+
+      CAN_ConfigureMessageObject(handle->can, RX_INTERFACE, msgNum,
+                                 true, false, false, k == (depth - 1U), true);
+
+      message.msgNum        = msgNum;
+      message.extended      = hwFilters[i].extended;
+      message.id            = hwFilters[i].id;
+      message.mask          = hwFilters[i].mask;
+      message.extendedMask  = hwFilters[i].extended;
+      message.directionMask = true;
+      CAN_SetIdAndFilter(handle->can, RX_INTERFACE, true, &message, true);
+
+      // CAN_SetIdAndFilter() only compares the IDE bit for extended filters,
+      // make standard filters reject extended frames as well.
+      if (!hwFilters[i].extended) {
+        handle->can->MIR[RX_INTERFACE].CMDMASK = CAN_MIR_CMDMASK_WRRD
+                                                 | CAN_MIR_CMDMASK_MASKACC;
+        handle->can->MIR[RX_INTERFACE].MASK |= CAN_MIR_MASK_MXTD;
+        CAN_SendRequest(handle->can, RX_INTERFACE, msgNum, true);
+      }
+
+      handle->rxMask |= MSG_BIT(msgNum);
+      if (hwFilters[i].extended) {
+        handle->rxExtendedMask |= MSG_BIT(msgNum);
+      }
+    }
+  }
+
+  CAN_ConfigureMessageObject(handle->can, TX_INTERFACE, CANDRV_TX_MSG_NUM,
+                             true, true, false, true, true);
+
+  handleTable[canIndex] = handle;
+  handle->initialized = true;
+
+  CAN_MessageIntClear(handle->can, _CAN_IF0IFC_MASK);
+  CAN_MessageIntEnable(handle->can, handle->rxMask | MSG_BIT(CANDRV_TX_MSG_NUM));
+  BUS_RegBitWrite(&handle->can->CTRL, _CAN_CTRL_IE_SHIFT, 1);
+
+#if (EMDRV_CANDRV_IRQ_HANDLERS == 1)
+  NVIC_ClearPendingIRQ(CanIrq(canIndex));
+  NVIC_SetPriority(CanIrq(canIndex), EMDRV_CANDRV_IRQ_PRIORITY);
+  NVIC_EnableIRQ(CanIrq(canIndex));
+#endif
+
+  return SL_STATUS_OK;
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Deinitialize a CANDRV handle.
+ *
+ * @details
+ *  Queued frames are discarded, a frame already in the TX message object is
+ *  aborted and all message objects are reset. The CAN peripheral itself is
+ *  left enabled.
+ *
+ * @param[in] handle
+ *  The CANDRV handle.
+ *
+ * @return
+ *  SL_STATUS_OK on success, SL_STATUS_NOT_INITIALIZED if the handle is not
+ *  initialized.
+ ******************************************************************************/
+sl_status_t CANDRV_DeInit(CANDRV_Handle_t handle)
+{
+  if ((handle == NULL) || !handle->initialized) {
+    return SL_STATUS_NOT_INITIALIZED;
+  }
+
+  CAN_MessageIntDisable(handle->can, _CAN_IF0IEN_MASK);
+#if (EMDRV_CANDRV_IRQ_HANDLERS == 1)
+  NVIC_DisableIRQ(CanIrq(CanIndex(handle->can)));
+#endif
+  CAN_AbortSendMessage(handle->can, TX_INTERFACE, CANDRV_TX_MSG_NUM, true);
+  CAN_ResetMessages(handle->can, RX_INTERFACE);
+  CAN_MessageIntClear(handle->can, _CAN_IF0IFC_MASK);
+
+  handleTable[CanIndex(handle->can)] = NULL;
+  handle->initialized = false;
+
+  return SL_STATUS_OK;
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Reduce a list of acceptance filters to as few hardware filters as possible.
+ *
+ * @details
+ *  Filters accepting a subset of the identifiers of another filter are
+ *  dropped, and filters with the same mask whose identifiers differ in a
+ *  single compared bit are combined into one filter with that bit masked out.
+ *  Both steps keep the accepted identifiers unchanged. If more than
+ *  @p maxHwFilters filters remain, the pairs of filters of the same kind
+ *  losing the fewest compared bits are merged until the list fits. The
+ *  resulting hardware filters are marked as not exact, the driver then checks
+ *  received frames against the declared filters.
+ *
+ * @param[in] filters
+ *  The declared acceptance filters.
+ *
+ * @param[in] filterCount
+ *  The number of declared filters [1 - EMDRV_CANDRV_MAX_FILTERS].
+ *
+ * @param[in] maxHwFilters
+ *  The maximum number of hardware filters.
+ *
+ * @param[out] hwFilters
+ *  The allocated hardware filters, room for @p maxHwFilters entries.
+ *
+ * @param[out] hwFilterCount
+ *  The number of allocated hardware filters.
+ *
+ * @return
+ *  SL_STATUS_OK on success, SL_STATUS_INVALID_CONFIGURATION if the filters
+ *  cannot be merged into @p maxHwFilters hardware filters, e.g. when both
+ *  standard and extended filters are declared and @p maxHwFilters is 1.
+ *  On other failures, an appropriate sl_status_t is returned.
+ ******************************************************************************/
+sl_status_t CANDRV_AllocateFilters(const CANDRV_Filter_t *filters,
+                                   uint8_t               filterCount,
+                                   uint8_t               maxHwFilters,
+                                   CANDRV_HwFilter_t     *hwFilters,
+                                   uint8_t               *hwFilterCount)
+{
+  CANDRV_HwFilter_t work[EMDRV_CANDRV_MAX_FILTERS];
+  uint8_t count = filterCount;
+  uint32_t idMax;
+
+  if ((filters == NULL) || (hwFilters == NULL) || (hwFilterCount == NULL)) {
+    return SL_STATUS_NULL_POINTER;
+  }
+  if ((filterCount == 0U) || (filterCount > EMDRV_CANDRV_MAX_FILTERS)
+      || (maxHwFilters == 0U)) {
+    return SL_STATUS_INVALID_PARAMETER;
+  }
+
+  for (uint8_t i = 0U; i < filterCount; i++) {
+    idMax = filters[i].extended ? EXT_ID_MAX : STD_ID_MAX;
+    if ((filters[i].id > idMax) || (filters[i].mask > idMax)) {
+      return SL_STATUS_INVALID_PARAMETER;
+    }
+    work[i].mask     = filters[i].mask;
+    work[i].id       = filters[i].id & filters[i].mask;
+    work[i].extended = filters[i].extended;
+    work[i].exact    = true;
+  }
+
+  while (FilterMerge(work, &count)) {
+  }
+
+  while (count > maxHwFilters) {
+    int best = -1;
+    uint8_t bestI = 0U;
+    uint8_t bestJ = 0U;
+
+    // Merge the pair keeping the most compared bits
+    for (uint8_t i = 0U; i < count; i++) {
+      for (uint8_t j = (uint8_t)(i + 1U); j < count; j++) {
+        if (work[i].extended == work[j].extended) {
+          int kept = (int)BitCount(work[i].mask & work[j].mask & ~(work[i].id ^ work[j].id));
+          if (kept > best) {
+            best  = kept;
+            bestI = i;
+            bestJ = j;
+          }
+        }
+      }
+    }
+    if (best < 0) {
+      return SL_STATUS_INVALID_CONFIGURATION;
+    }
+
+    work[bestI].mask &= work[bestJ].mask & ~(work[bestI].id ^ work[bestJ].id);
+    work[bestI].id   &= work[bestI].mask;
+    work[bestI].exact = false;
+    work[bestJ] = work[--count];
+
+    while (FilterMerge(work, &count)) {
+    }
+  }
+
+  memcpy(hwFilters, work, count * sizeof(work[0]));
+  *hwFilterCount = count;
+
+  return SL_STATUS_OK;
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Get the oldest received frame.
+ *
+ * @param[in] handle
+ *  The CANDRV handle.
+ *
+ * @param[out] frame
+ *  The received frame.
+ *
+ * @return
+ *  SL_STATUS_OK on success, SL_STATUS_EMPTY if no frame has been received.
+ *  On other failures, an appropriate sl_status_t is returned.
+ ******************************************************************************/
+sl_status_t CANDRV_Receive(CANDRV_Handle_t handle, CANDRV_Frame_t *frame)
+{
+  uint32_t tail;
+
+  if ((handle == NULL) || !handle->initialized) {
+    return SL_STATUS_NOT_INITIALIZED;
+  }
+  if (frame == NULL) {
+    return SL_STATUS_NULL_POINTER;
+  }
+
+  tail = handle->rxTail;
+  if (tail == handle->rxHead) {
+    return SL_STATUS_EMPTY;
+  }
+  *frame = handle->rxBuffer[tail & handle->rxBufferMask];
+  handle->rxTail = tail + 1U;
+
+  return SL_STATUS_OK;
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Get the number of frames waiting in the RX ring.
+ *
+ * @param[in] handle
+ *  The CANDRV handle.
+ *
+ * @return
+ *  The number of received frames not read yet.
+ ******************************************************************************/
+uint32_t CANDRV_RxPending(CANDRV_Handle_t handle)
+{
+  if ((handle == NULL) || !handle->initialized) {
+    return 0U;
+  }
+
+  return handle->rxHead - handle->rxTail;
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Queue a data frame for transmission.
+ *
+ * @details
+ *  The frame is copied to the TX queue. Frames are handed to the TX message
+ *  object one at a time, the highest priority level first and in queuing
+ *  order within a level. A frame already in the TX message object is not
+ *  preempted by a frame of higher priority queued later.
+ *
+ * @param[in] handle
+ *  The CANDRV handle.
+ *
+ * @param[in] frame
+ *  The frame to send, the filter field is ignored.
+ *
+ * @param[in] priority
+ *  The priority level, 0 is the highest
+ *  [0 - EMDRV_CANDRV_TX_PRIORITY_LEVELS - 1].
+ *
+ * @return
+ *  SL_STATUS_OK on success, SL_STATUS_FULL if the TX queue is full. On other
+ *  failures, an appropriate sl_status_t is returned.
+ ******************************************************************************/
+sl_status_t CANDRV_Transmit(CANDRV_Handle_t      handle,
+                            const CANDRV_Frame_t *frame,
+                            unsigned int         priority)
+{
+  uint8_t entry;
+  CORE_DECLARE_IRQ_STATE;
+
+  if ((handle == NULL) || !handle->initialized) {
+    return SL_STATUS_NOT_INITIALIZED;
+  }
+  if (frame == NULL) {
+    return SL_STATUS_NULL_POINTER;
+  }
+  if ((priority >= EMDRV_CANDRV_TX_PRIORITY_LEVELS) || (frame->dlc > 8U)
+      || (frame->id > (frame->extended ? EXT_ID_MAX : STD_ID_MAX))) {
+    return SL_STATUS_INVALID_PARAMETER;
+  }
+
+  CORE_ENTER_ATOMIC();
+  entry = handle->txFree;
+  if (entry == TX_NONE) {
+    CORE_EXIT_ATOMIC();
+    return SL_STATUS_FULL;
+  }
+  handle->txFree = handle->txQueue[entry].next;
+
+  handle->txQueue[entry].frame = *frame;
+  handle->txQueue[entry].next  = TX_NONE;
+  if (handle->txTail[priority] == TX_NONE) {
+    handle->txHead[priority] = entry;
+  } else {
+    handle->txQueue[handle->txTail[priority]].next = entry;
+  }
+  handle->txTail[priority] = entry;
+  handle->txQueued++;
+
+  if (!handle->txBusy) {
+    TxStartNext(handle);
+  }
+  CORE_EXIT_ATOMIC();
+
+  return SL_STATUS_OK;
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Get the number of frames not transmitted yet.
+ *
+ * @param[in] handle
+ *  The CANDRV handle.
+ *
+ * @return
+ *  The number of queued frames, including the one in the TX message object.
+ ******************************************************************************/
+uint32_t CANDRV_TxPending(CANDRV_Handle_t handle)
+{
+  if ((handle == NULL) || !handle->initialized) {
+    return 0U;
+  }
+
+  return handle->txQueued + (handle->txBusy ? 1U : 0U);
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Get the driver statistics.
+ *
+ * @param[in] handle
+ *  The CANDRV handle.
+ *
+ * @param[out] stats
+ *  The statistics.
+ *
+ * @return
+ *  SL_STATUS_OK on success. On failure, an appropriate sl_status_t is
+ *  returned.
+ ******************************************************************************/
+sl_status_t CANDRV_GetStatistics(CANDRV_Handle_t     handle,
+                                 CANDRV_Statistics_t *stats)
+{
+  CORE_DECLARE_IRQ_STATE;
+
+  if ((handle == NULL) || !handle->initialized) {
+    return SL_STATUS_NOT_INITIALIZED;
+  }
+  if (stats == NULL) {
+    return SL_STATUS_NULL_POINTER;
+  }
+
+  CORE_ENTER_ATOMIC();
+  *stats = handle->stats;
+  CORE_EXIT_ATOMIC();
+
+  return SL_STATUS_OK;
+}
+
+/***************************************************************************//**
+ * @brief
+ *  CAN interrupt handler.
+ *
+ * @details
+ *  Drains the RX FIFOs into the RX ring and loads the next queued frame in
+ *  the TX message object. Called by the driver's own interrupt handlers, or
+ *  by the application when EMDRV_CANDRV_IRQ_HANDLERS is 0.
+ *
+ * @param[in] handle
+ *  The CANDRV handle.
+ ******************************************************************************/
+void CANDRV_IRQHandler(CANDRV_Handle_t handle)
+{
+  uint32_t flags;
+  uint32_t rxHead;
+
+  if ((handle == NULL) || !handle->initialized) {
+    return;
+  }
+
+  // Flags are cleared first, frames arriving while draining raise them again
+  flags = CAN_MessageIntGetEnabled(handle->can);
+  CAN_MessageIntClear(handle->can, flags);
+  CAN_StatusIntClear(handle->can, CAN_StatusIntGet(handle->can));
+
+  if ((flags & handle->rxMask) != 0U) {
+    rxHead = handle->rxHead;
+    RxDrain(handle);
+    if ((handle->rxHead != rxHead) && (handle->rxCallback != NULL)) {
+      handle->rxCallback(handle, handle->userParam);
+    }
+  }
+
+  if ((flags & MSG_BIT(CANDRV_TX_MSG_NUM)) != 0U) {
+    handle->txBusy = false;
+    handle->stats.txFrames++;
+    if (handle->txQueued != 0U) {
+      TxStartNext(handle);
+    } else if (handle->txCallback != NULL) {
+      handle->txCallback(handle, handle->userParam);
+    }
+  }
+}
+
+/// @cond DO_NOT_INCLUDE_WITH_DOXYGEN
+
+/***************************************************************************//**
+ * @brief
+ *  Get the index of a CAN instance, CAN_COUNT if unknown.
+ ******************************************************************************/
+static unsigned int CanIndex(const CAN_TypeDef *can)
+{
+  if (can == CAN0) {
+    return 0U;
+  }
+#if defined(CAN1)
+  if (can == CAN1) {
+    return 1U;
+  }
+#endif
+  return CAN_COUNT;
+}
+
+#if (EMDRV_CANDRV_IRQ_HANDLERS == 1)
+/***************************************************************************//**
+ * @brief
+ *  Get the interrupt number of a CAN instance.
+ ******************************************************************************/
+static IRQn_Type CanIrq(unsigned int canIndex)
+{
+#if defined(CAN1)
+  if (canIndex == 1U) {
+    return CAN1_IRQn;
+  }
+#endif
+  (void)canIndex;
+  return CAN0_IRQn;
+}
+#endif
+
+/***************************************************************************//**
+ * @brief
+ *  Count the bits set in a word.
+ ******************************************************************************/
+static unsigned int BitCount(uint32_t value)
+{
+  unsigned int count = 0U;
+
+  while (value != 0U) {
+    value &= value - 1U;
+    count++;
+  }
+  return count;
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Do one lossless reduction step on a list of hardware filters.
+ *
+ * @return
+ *  True if a filter was removed, false if the list cannot be reduced further.
+ ******************************************************************************/
+static bool FilterMerge(CANDRV_HwFilter_t *hw, uint8_t *count)
+{
+  uint32_t diff;
+
+  for (uint8_t i = 0U; i < *count; i++) {
+    for (uint8_t j = 0U; j < *count; j++) {
+      if ((i == j) || (hw[i].extended != hw[j].extended)) {
+        continue;
+      }
+      diff = hw[i].id ^ hw[j].id;
+
+      // Filter j accepts a subset of the identifiers accepted by filter i
+      if (((hw[i].mask & ~hw[j].mask) == 0U) && ((diff & hw[i].mask) == 0U)) {
+        hw[j] = hw[--(*count)];
+        return true;
+      }
+
+      // Same mask and a single differing bit, mask the bit out
+      if ((hw[i].mask == hw[j].mask) && (BitCount(diff) == 1U)) {
+        hw[i].mask &= ~diff;
+        hw[i].id   &= hw[i].mask;
+        hw[i].exact = hw[i].exact && hw[j].exact;
+        hw[j] = hw[--(*count)];
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Select the pending objects of one RX FIFO to read in this pass.
+ *
+ * @details
+ *  The hardware stores a frame in the lowest free object of a FIFO. When the
+ *  pending objects are not contiguous from the bottom, the objects above the
+ *  gap hold older frames than the ones below it, so only they are read in
+ *  this pass and the lower ones in the next pass.
+ ******************************************************************************/
+static uint32_t FifoPending(uint32_t pending, uint32_t fifoMask)
+{
+  uint32_t shift = SL_CTZ(fifoMask);
+  uint32_t bits = pending >> shift;
+  uint32_t top;
+
+  if ((bits == 0U) || (pending == fifoMask)) {
+    return pending;
+  }
+
+  // Contiguous from the bottom, read all of them
+  top = 32U - __CLZ(bits);
+  if (top == BitCount(bits)) {
+    return pending;
+  }
+
+  // Find the lowest object of the run ending at the top pending object
+  while ((bits & (1UL << (top - 2U))) != 0U) {
+    top--;
+  }
+  return (bits & ~((1UL << (top - 1U)) - 1U)) << shift;
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Move all pending frames of the RX FIFOs to the RX ring, oldest first.
+ ******************************************************************************/
+static void RxDrain(CANDRV_Handle_t handle)
+{
+  uint32_t fifoBits = (1UL << handle->rxFifoDepth) - 1U;
+  uint32_t pending;
+  uint32_t fifoPending;
+  unsigned int passes = 0U;
+
+  while (((pending = CAN_HasNewdata(handle->can) & handle->rxMask) != 0U)
+         && (passes++ < CANDRV_MSG_OBJECT_COUNT)) {
+    for (uint8_t i = 0U; i < handle->hwFilterCount; i++) {
+      fifoPending = FifoPending(pending & (fifoBits << (i * handle->rxFifoDepth)),
+                                fifoBits << (i * handle->rxFifoDepth));
+      while (fifoPending != 0U) {
+        RxReadObject(handle, (uint8_t)(SL_CTZ(fifoPending) + 1U));
+        fifoPending &= fifoPending - 1U;
+      }
+    }
+  }
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Read one RX message object and put its frame in the RX ring.
+ ******************************************************************************/
+static void RxReadObject(CANDRV_Handle_t handle, uint8_t msgNum)
+{
+  CAN_MessageObject_TypeDef message;
+  CANDRV_Frame_t *frame;
+  uint32_t head;
+  uint8_t filter;
+
+  message.msgNum   = msgNum;
+  message.extended = (handle->rxExtendedMask & MSG_BIT(msgNum)) != 0U;
+  if (!CAN_ReadMessage(handle->can, RX_INTERFACE, &message)) {
+    return;
+  }
+
+  // Frames were lost when the whole FIFO was full
+  if ((handle->can->MIR[RX_INTERFACE].CTRL & CAN_MIR_CTRL_MESSAGEOF) != 0U) {
+    CAN_MessageLost(handle->can, RX_INTERFACE, msgNum);
+    handle->stats.rxFifoOverflows++;
+  }
+
+  for (filter = 0U; filter < handle->filterCount; filter++) {
+    if ((handle->filters[filter].extended == message.extended)
+        && (((message.id ^ handle->filters[filter].id)
+             & handle->filters[filter].mask) == 0U)) {
+      break;
+    }
+  }
+  if (filter == handle->filterCount) {
+    handle->stats.rxFiltered++;
+    return;
+  }
+
+  head = handle->rxHead;
+  if ((head - handle->rxTail) > handle->rxBufferMask) {
+    handle->stats.rxRingOverflows++;
+    return;
+  }
+
+  frame = &handle->rxBuffer[head & handle->rxBufferMask];
+  frame->id       = message.id;
+  frame->extended = message.extended;
+  frame->dlc      = message.dlc;
+  frame->filter   = filter;
+  memcpy(frame->data, message.data, sizeof(frame->data));
+  handle->rxHead = head + 1U;
+  handle->stats.rxFrames++;
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Load the highest priority queued frame in the TX message object. Must be
+ *  called with interrupts disabled or from the interrupt handler.
+ ******************************************************************************/
+static void TxStartNext(CANDRV_Handle_t handle)
+{
+  CAN_MessageObject_TypeDef message;
+  CANDRV_TxEntry_t *entry;
+  unsigned int level;
+  uint8_t index;
+
+  for (level = 0U; level < EMDRV_CANDRV_TX_PRIORITY_LEVELS; level++) {
+    if (handle->txHead[level] != TX_NONE) {
+      break;
+    }
+  }
+  if (level == EMDRV_CANDRV_TX_PRIORITY_LEVELS) {
+    return;
+  }
+
+  index = handle->txHead[level];
+  entry = &handle->txQueue[index];
+  handle->txHead[level] = entry->next;
+  if (entry->next == TX_NONE) {
+    handle->txTail[level] = TX_NONE;
+  }
+
+  message.msgNum   = CANDRV_TX_MSG_NUM;
+  message.extended = entry->frame.extended;
+  message.id       = entry->frame.id;
+  message.dlc      = entry->frame.dlc;
+  memcpy(message.data, entry->frame.data, sizeof(message.data));
+
+  entry->next    = handle->txFree;
+  handle->txFree = index;
+  handle->txQueued--;
+  handle->txBusy = true;
+
+  CAN_SendMessage(handle->can, TX_INTERFACE, &message, true);
+}
+
+#if (EMDRV_CANDRV_IRQ_HANDLERS == 1)
+void CAN0_IRQHandler(void)
+{
+  CANDRV_IRQHandler(handleTable[0]);
+}
+
+#if defined(CAN1)
+void CAN1_IRQHandler(void)
+{
+  CANDRV_IRQHandler(handleTable[1]);
+}
+#endif
+#endif
+
+/// @endcond
+
+#endif /* defined(CAN_COUNT) && (CAN_COUNT > 0) */
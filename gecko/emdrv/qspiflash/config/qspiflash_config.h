@@ -0,0 +1,61 @@
+/***************************************************************************//**
+ * @file
+ * @brief QSPIFLASH configuration file.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+
+#ifndef QSPIFLASH_CONFIG_H
+#define QSPIFLASH_CONFIG_H
+
+// <<< Use Configuration Wizard in Context Menu >>>
+
+// <o EMDRV_QSPIFLASH_TRIGGER_ADDRESS> Indirect transfer trigger address
+// <i> AHB address used to move indirect transfer data in and out of the QSPI
+// <i> SRAM. Must be aligned to 16 bytes and outside the part of the QSPI
+// <i> memory map used for direct access.
+// <i> Default: 0xCFFFFFF0
+#define EMDRV_QSPIFLASH_TRIGGER_ADDRESS 0xCFFFFFF0
+
+// <o EMDRV_QSPIFLASH_SRAM_READ_WORDS> Size of the SRAM read partition in words <1-255>
+// <i> Default: 128
+#define EMDRV_QSPIFLASH_SRAM_READ_WORDS 128
+
+// <o EMDRV_QSPIFLASH_SRAM_WRITE_WORDS> Size of the SRAM write partition in words <1-255>
+// <i> Number of words the driver keeps queued in the write partition, must
+// <i> not exceed the SRAM size less the read partition.
+// <i> Default: 64
+#define EMDRV_QSPIFLASH_SRAM_WRITE_WORDS 64
+
+// <o EMDRV_QSPIFLASH_DMA_MIN_WORDS> Minimum DMA transfer size in words <1-255>
+// <i> Smaller chunks are moved by the CPU, which is faster than setting up
+// <i> the LDMA channel.
+// <i> Default: 8
+#define EMDRV_QSPIFLASH_DMA_MIN_WORDS 8
+
+// <<< end of configuration section >>>
+
+#endif // QSPIFLASH_CONFIG_H
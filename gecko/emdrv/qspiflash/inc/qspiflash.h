@@ -0,0 +1,190 @@
+/***************************************************************************//**
+ * @file
+ * @brief QSPIFLASH API definition.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+
+#ifndef __SILICON_LABS_QSPIFLASH_H__
+#define __SILICON_LABS_QSPIFLASH_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "em_device.h"
+
+#if defined(QSPI_COUNT) && (QSPI_COUNT > 0)
+
+#include "em_qspi.h"
+#include "em_ldma.h"
+#include "sl_status.h"
+#include "qspiflash_config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***************************************************************************//**
+ * @addtogroup qspiflash QSPIFLASH - QSPI NOR Flash Driver
+ * @brief Serial NOR flash driver using QSPI indirect transfers.
+ *
+ * @details
+ *  QSPIFLASH drives a serial NOR flash device connected to a QSPI instance.
+ *
+ *  - The device geometry, read instruction, erase types and typical timings
+ *    are taken from the SFDP Basic Flash Parameter Table when the device has
+ *    one. Otherwise standard single line instructions are used and the size
+ *    is derived from the JEDEC ID.
+ *  - Reads and page programs use indirect transfers. Data is moved between
+ *    the QSPI SRAM and the application buffer with memory-to-memory LDMA
+ *    transfers, paced by the SRAM fill level. Small and unaligned chunks are
+ *    moved by the CPU.
+ *  - Programs and erases are split in steps of one page or one erase block.
+ *    @ref QSPIFLASH_WriteStart() and @ref QSPIFLASH_EraseStart() return at
+ *    once, @ref QSPIFLASH_Process() polls the device and issues the next step
+ *    as soon as the previous one has completed.
+ *
+ *  When code is executed from the device (XIP), direct accesses return
+ *  invalid data while a program or erase step is in progress. In this mode
+ *  each step is run to completion by a function located in RAM with
+ *  SL_RAMFUNC, with all interrupts disabled. That function moves the program
+ *  data with the CPU and accesses the QSPI registers directly, so no emlib,
+ *  LDMA or C library code runs from the device during a step. Erases use the
+ *  smallest erase type only. The executed image given in
+ *  @ref QSPIFLASH_Init_t is never programmed or erased. Other bus masters
+ *  must not access the direct access windows while an operation is ongoing.
+ *
+ *  Interrupts are disabled for up to the maximum time of one step. That is
+ *  the larger of @ref QSPIFLASH_Info_t::pageProgramTimeUs and the
+ *  @ref QSPIFLASH_EraseType_t::typicalTimeMs of the smallest erase type,
+ *  multiplied by @ref QSPIFLASH_Info_t::maxTimeFactor. The erase dominates.
+ *  For a typical 4 kB sector this is several tens to a few hundred
+ *  milliseconds, check the device datasheet when the SFDP tables do not give
+ *  the timings.
+ *
+ *  The QSPI peripheral must be initialized with QSPI_Init() and routed to
+ *  its pins before @ref QSPIFLASH_Init() is called. When an LDMA channel is
+ *  used, LDMA_Init() must have been called.
+ *
+ * @{
+ ******************************************************************************/
+
+#define QSPIFLASH_ERASE_TYPES     4U    ///< Maximum number of erase types.
+
+/// Erase type.
+typedef struct {
+  uint32_t  size;           ///< Erase block size in bytes, 0 if unused.
+  uint32_t  typicalTimeMs;  ///< Typical erase time in milliseconds, 0 if unknown.
+  uint8_t   opcode;         ///< Erase instruction.
+} QSPIFLASH_EraseType_t;
+
+/// Device parameters.
+typedef struct {
+  uint32_t                  jedecId;              ///< Manufacturer ID, memory type and capacity, first byte in bits 7:0.
+  uint32_t                  size;                 ///< Device size in bytes.
+  uint32_t                  pageSize;             ///< Page size in bytes.
+  uint32_t                  pageProgramTimeUs;    ///< Typical page program time in microseconds, 0 if unknown.
+  uint8_t                   maxTimeFactor;        ///< Factor from typical to maximum program and erase times, 0 if unknown.
+  QSPIFLASH_EraseType_t     eraseTypes[QSPIFLASH_ERASE_TYPES]; ///< Erase types by increasing size.
+  uint8_t                   addressBytes;         ///< Number of address bytes, 3 or 4.
+  uint8_t                   readOpcode;           ///< Read instruction.
+  uint8_t                   readDummyCycles;      ///< Read dummy cycles.
+  QSPI_TransferType_TypeDef readDataTransfer;     ///< Read data lines.
+  bool                      sfdp;                 ///< Parameters read from the SFDP tables.
+} QSPIFLASH_Info_t;
+
+/// QSPIFLASH handle data, must stay allocated while the handle is in use.
+typedef struct QSPIFLASH_HandleData QSPIFLASH_HandleData_t;
+
+/// QSPIFLASH handle.
+typedef QSPIFLASH_HandleData_t *QSPIFLASH_Handle_t;
+
+/// QSPIFLASH initialization structure.
+typedef struct {
+  QSPI_TypeDef  *qspi;        ///< QSPI instance to use.
+  int           dmaChannel;   ///< LDMA channel for indirect transfers, -1 to move data with the CPU.
+  bool          xip;          ///< Code is executed from the device.
+  uint32_t      xipStart;     ///< Device address of the executed image, used with @p xip.
+  uint32_t      xipSize;      ///< Size of the executed image in bytes, used with @p xip.
+} QSPIFLASH_Init_t;
+
+/// @cond DO_NOT_INCLUDE_WITH_DOXYGEN
+struct QSPIFLASH_HandleData {
+  QSPI_TypeDef              *qspi;
+  int                       dmaChannel;
+  bool                      xip;
+  uint32_t                  xipStart;
+  uint32_t                  xipEnd;       // First address after the executed image
+  QSPIFLASH_Info_t          info;
+  LDMA_Descriptor_t         dmaDescriptor;
+  bool                      dmaActive;    // An LDMA transfer to the write partition is ongoing
+  uint8_t                   state;
+  uint8_t                   operation;
+  uint32_t                  address;      // Device address of the current step
+  uint32_t                  remaining;    // Bytes left, current step included
+  const uint8_t             *data;        // Data of the current program step
+  uint32_t                  stepSize;     // Bytes of the current step
+  uint32_t                  stepQueued;   // Bytes of the current program step given to the QSPI
+  uint8_t                   eraseOpcode;  // Erase instruction of the current step
+  bool                      initialized;
+};
+/// @endcond
+
+sl_status_t QSPIFLASH_Init(QSPIFLASH_Handle_t handle, const QSPIFLASH_Init_t *init);
+sl_status_t QSPIFLASH_DeInit(QSPIFLASH_Handle_t handle);
+sl_status_t QSPIFLASH_GetInfo(QSPIFLASH_Handle_t handle, QSPIFLASH_Info_t *info);
+
+sl_status_t QSPIFLASH_Read(QSPIFLASH_Handle_t handle,
+                           uint32_t           address,
+                           void               *buffer,
+                           uint32_t           size);
+
+sl_status_t QSPIFLASH_WriteStart(QSPIFLASH_Handle_t handle,
+                                 uint32_t           address,
+                                 const void         *data,
+                                 uint32_t           size);
+sl_status_t QSPIFLASH_Write(QSPIFLASH_Handle_t handle,
+                            uint32_t           address,
+                            const void         *data,
+                            uint32_t           size);
+
+sl_status_t QSPIFLASH_EraseStart(QSPIFLASH_Handle_t handle,
+                                 uint32_t           address,
+                                 uint32_t           size);
+sl_status_t QSPIFLASH_Erase(QSPIFLASH_Handle_t handle,
+                            uint32_t           address,
+                            uint32_t           size);
+
+sl_status_t QSPIFLASH_Process(QSPIFLASH_Handle_t handle);
+
+/** @} (end addtogroup qspiflash) */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* defined(QSPI_COUNT) && (QSPI_COUNT > 0) */
+#endif // __SILICON_LABS_QSPIFLASH_H__
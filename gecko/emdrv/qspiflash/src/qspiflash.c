@@ -0,0 +1,1280 @@
+/***************************************************************************//**
+ * @file
+ * @brief Serial NOR flash driver using QSPI indirect transfers.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "em_device.h"
+
+#if defined(QSPI_COUNT) && (QSPI_COUNT > 0)
+
+#include "em_core.h"
+#include "em_ldma.h"
+#include "em_qspi.h"
+#include "em_ramfunc.h"
+#include "sl_common.h"
+
+#include "qspiflash.h"
+
+/// @cond DO_NOT_INCLUDE_WITH_DOXYGEN
+
+#if (EMDRV_QSPIFLASH_TRIGGER_ADDRESS & 0xFU) != 0
+#error "EMDRV_QSPIFLASH_TRIGGER_ADDRESS must be aligned to 16 bytes"
+#endif
+
+// Device instructions
+#define CMD_WRITE_STATUS      0x01U
+#define CMD_PAGE_PROGRAM      0x02U
+#define CMD_READ              0x03U
+#define CMD_READ_STATUS       0x05U
+#define CMD_WRITE_ENABLE      0x06U
+#define CMD_FAST_READ         0x0BU
+#define CMD_ERASE_4K          0x20U
+#define CMD_WRITE_STATUS2     0x31U
+#define CMD_READ_STATUS2      0x35U
+#define CMD_WRITE_STATUS2_ALT 0x3EU
+#define CMD_READ_STATUS2_ALT  0x3FU
+#define CMD_READ_SFDP         0x5AU
+#define CMD_READ_ID           0x9FU
+#define CMD_ENTER_4B          0xB7U
+#define CMD_ERASE_64K         0xD8U
+
+#define STATUS_WIP            0x01U
+
+#define SFDP_SIGNATURE        0x50444653UL   // "SFDP"
+#define SFDP_DUMMY_CYCLES     8U
+#define SFDP_BFPT_ID          0x00U
+#define SFDP_BFPT_MIN_DWORDS  9U
+#define SFDP_BFPT_MAX_DWORDS  16U
+
+// Basic Flash Parameter Table fields, DWORD numbers start at 0
+#define BFPT_ERASE_4K_MASK    0x3UL          // DWORD 0
+#define BFPT_ERASE_4K         0x1UL
+#define BFPT_FAST_READ_112    (1UL << 16)
+#define BFPT_ADDR_BYTES_SHIFT 17U
+#define BFPT_ADDR_3           0U
+#define BFPT_ADDR_3_OR_4      1U
+#define BFPT_ADDR_4           2U
+#define BFPT_FAST_READ_114    (1UL << 22)
+#define BFPT_DENSITY_POW2     (1UL << 31)    // DWORD 1
+#define BFPT_QER_SHIFT        20U            // DWORD 14
+#define BFPT_QER_MAX          6U
+#define BFPT_QER_UNKNOWN      0xFFU
+
+#define MAX_DUMMY_CYCLES      30U
+#define SIZE_3B_MAX           (16UL * 1024UL * 1024UL)
+#define DEFAULT_PAGE_SIZE     256U
+#define TRIGGER_RANGE_WIDTH   4U             // 16 byte trigger range
+
+#define TRIGGER               ((volatile uint32_t *)EMDRV_QSPIFLASH_TRIGGER_ADDRESS)
+
+// FLASHCMDCTRL fields for XipStig()
+#define XIP_STIG_OPCODE(opcode)  ((uint32_t)(opcode) << _QSPI_FLASHCMDCTRL_CMDOPCODE_SHIFT)
+#define XIP_STIG_ADDRESS(bytes)  (QSPI_FLASHCMDCTRL_ENBCOMDADDR \
+                                  | (((uint32_t)(bytes) - 1U) << _QSPI_FLASHCMDCTRL_NUMADDRBYTES_SHIFT))
+#define XIP_STIG_READ_BYTE       QSPI_FLASHCMDCTRL_ENBREADDATA
+
+enum {
+  STATE_IDLE,         // No operation
+  STATE_READY,        // Operation ongoing, next step not started
+  STATE_PROGRAM,      // Program data going through the SRAM
+  STATE_WAIT,         // Waiting for the device to complete the step
+};
+
+enum {
+  OPERATION_WRITE,
+  OPERATION_ERASE,
+};
+
+static void StigCommand(QSPI_TypeDef *qspi, uint8_t opcode);
+static void StigAddressCommand(QSPI_TypeDef *qspi,
+                               uint8_t      opcode,
+                               uint32_t     address,
+                               uint8_t      addressBytes);
+static uint8_t StigReadRegister(QSPI_TypeDef *qspi, uint8_t opcode);
+static void StigWriteRegister(QSPI_TypeDef  *qspi,
+                              uint8_t       opcode,
+                              const uint8_t *data,
+                              uint8_t       size);
+static void SfdpRead(QSPI_TypeDef *qspi, uint32_t address, void *buffer, uint32_t size);
+static bool SfdpParse(QSPIFLASH_Handle_t handle, uint8_t *addressMode, uint8_t *qer);
+static bool JedecParse(QSPIFLASH_Handle_t handle);
+static void EraseTypesSort(QSPIFLASH_Info_t *info);
+static bool QuadEnable(QSPI_TypeDef *qspi, uint8_t qer);
+static bool InDevice(uintptr_t address);
+static bool DmaUsable(QSPIFLASH_Handle_t handle, const void *buffer, uint32_t words);
+static void DmaStart(QSPIFLASH_Handle_t handle,
+                     const void         *src,
+                     volatile void      *dst,
+                     uint32_t           words,
+                     bool               toDevice);
+static bool ProgramFeed(QSPIFLASH_Handle_t handle);
+static void StepPrepare(QSPIFLASH_Handle_t handle);
+static void StepStart(QSPIFLASH_Handle_t handle);
+static bool StepDone(QSPIFLASH_Handle_t handle);
+static sl_status_t StepNext(QSPIFLASH_Handle_t handle);
+SL_RAMFUNC_DECLARATOR static uint8_t __attribute__ ((noinline)) XipStig(QSPI_TypeDef *qspi,
+                                                                        uint32_t     ctrl,
+                                                                        uint32_t     address);
+SL_RAMFUNC_DECLARATOR static void __attribute__ ((noinline)) XipStepRun(QSPIFLASH_Handle_t handle);
+
+/// @endcond
+
+/***************************************************************************//**
+ * @brief
+ *  Initialize a QSPIFLASH handle.
+ *
+ * @details
+ *  The device is identified with its JEDEC ID and its SFDP tables. Unless
+ *  @p xip is set, the quad enable bit is set when a quad read is used,
+ *  4 byte addressing is entered for devices larger than 16 MB and the QSPI
+ *  read instruction is configured. With @p xip, the read instruction and
+ *  address setup in use are kept since code is running through them.
+ *
+ * @param[in] handle
+ *  A pointer to the handle data, which must stay allocated until
+ *  @ref QSPIFLASH_DeInit() is called.
+ *
+ * @param[in] init
+ *  A pointer to the initialization structure.
+ *
+ * @return
+ *  SL_STATUS_OK on success, SL_STATUS_NOT_FOUND if no device answers,
+ *  SL_STATUS_NOT_SUPPORTED if the device has no SFDP tables and an unknown
+ *  capacity and SL_STATUS_INVALID_CONFIGURATION if @p xip is set while the
+ *  RAM code of the driver is located in the device, as with
+ *  SL_RAMFUNC_DISABLE. On other failures, an appropriate sl_status_t is
+ *  returned.
+ ******************************************************************************/
+sl_status_t QSPIFLASH_Init(QSPIFLASH_Handle_t handle, const QSPIFLASH_Init_t *init)
+{
+  QSPI_IndirectConfig_TypeDef indirectConfig = QSPI_INDIRECTCONFIG_DEFAULT;
+  QSPI_WriteConfig_TypeDef writeConfig = QSPI_WRITECONFIG_DEFAULT;
+  QSPI_ReadConfig_TypeDef readConfig = QSPI_READCONFIG_DEFAULT;
+  QSPI_StigCmd_TypeDef stigCmd = { 0 };
+  QSPIFLASH_Info_t *info;
+  QSPI_TypeDef *qspi;
+  uint8_t addressMode = BFPT_ADDR_3_OR_4;
+  uint8_t qer = BFPT_QER_UNKNOWN;
+  uint8_t id[3];
+
+  if ((handle == NULL) || (init == NULL) || (init->qspi == NULL)) {
+    return SL_STATUS_NULL_POINTER;
+  }
+  if (handle->initialized) {
+    return SL_STATUS_ALREADY_INITIALIZED;
+  }
+  if ((init->dmaChannel >= (int)DMA_CHAN_COUNT)
+      || (init->xip && (init->xipSize > (UINT32_MAX - init->xipStart)))) {
+    return SL_STATUS_INVALID_PARAMETER;
+  }
+  // Instruction fetches from the device return garbage while a step is in
+  // progress, the code running the step must not be located in the device.
+  if (init->xip
+      && (InDevice((uintptr_t)&XipStepRun) || InDevice((uintptr_t)&XipStig))) {
+    return SL_STATUS_INVALID_CONFIGURATION;
+  }
+
+  qspi = init->qspi;
+  memset(handle, 0, sizeof(*handle));
+  handle->qspi       = qspi;
+  handle->dmaChannel = init->dmaChannel;
+  handle->xip        = init->xip;
+  handle->xipStart   = init->xipStart;
+  handle->xipEnd     = init->xip ? (init->xipStart + init->xipSize) : 0U;
+  info = &handle->info;
+
+  stigCmd.cmdOpcode    = CMD_READ_ID;
+  stigCmd.readDataSize = sizeof(id);
+  stigCmd.readBuffer   = id;
+  QSPI_ExecStigCmd(qspi, &stigCmd);
+  info->jedecId = id[0] | ((uint32_t)id[1] << 8) | ((uint32_t)id[2] << 16);
+  if ((info->jedecId == 0U) || (info->jedecId == 0xFFFFFFUL)) {
+    return SL_STATUS_NOT_FOUND;
+  }
+
+  info->sfdp = SfdpParse(handle, &addressMode, &qer);
+  if (!info->sfdp && !JedecParse(handle)) {
+    return SL_STATUS_NOT_SUPPORTED;
+  }
+  EraseTypesSort(info);
+
+  if (init->xip) {
+    uint32_t rdConfig = qspi->DEVINSTRRDCONFIG;
+
+    info->addressBytes = (uint8_t)(((qspi->DEVSIZECONFIG & _QSPI_DEVSIZECONFIG_NUMADDRBYTES_MASK)
+                                    >> _QSPI_DEVSIZECONFIG_NUMADDRBYTES_SHIFT) + 1U);
+    info->readOpcode = (uint8_t)((rdConfig & _QSPI_DEVINSTRRDCONFIG_RDOPCODENONXIP_MASK)
+                                 >> _QSPI_DEVINSTRRDCONFIG_RDOPCODENONXIP_SHIFT);
+    info->readDummyCycles = (uint8_t)((rdConfig & _QSPI_DEVINSTRRDCONFIG_DUMMYRDCLKCYCLES_MASK)
+                                      >> _QSPI_DEVINSTRRDCONFIG_DUMMYRDCLKCYCLES_SHIFT);
+    info->readDataTransfer = (QSPI_TransferType_TypeDef)
+                             ((rdConfig & _QSPI_DEVINSTRRDCONFIG_DATAXFERTYPEEXTMODE_MASK)
+                              >> _QSPI_DEVINSTRRDCONFIG_DATAXFERTYPEEXTMODE_SHIFT);
+    if (info->addressBytes < 4U) {
+      info->size = SL_MIN(info->size, SIZE_3B_MAX);
+    }
+  } else {
+    if (info->size > SIZE_3B_MAX) {
+      if (addressMode == BFPT_ADDR_3) {
+        info->size = SIZE_3B_MAX;
+      } else if (addressMode == BFPT_ADDR_3_OR_4) {
+        // Some devices need the write enable latch set to change address mode
+        StigCommand(qspi, CMD_WRITE_ENABLE);
+        StigCommand(qspi, CMD_ENTER_4B);
+      }
+    }
+    info->addressBytes = (info->size > SIZE_3B_MAX) ? 4U : 3U;
+
+    // Fall back to the widest read needing no quad enable bit
+    if ((info->readDataTransfer == qspiTransferQuad) && !QuadEnable(qspi, qer)) {
+      info->readDataTransfer = qspiTransferSingle;
+      info->readOpcode       = CMD_FAST_READ;
+      info->readDummyCycles  = 8U;
+    }
+
+    readConfig.opCode       = info->readOpcode;
+    readConfig.dummyCycles  = info->readDummyCycles;
+    readConfig.dataTransfer = info->readDataTransfer;
+    QSPI_ReadConfig(qspi, &readConfig);
+
+    QSPI_WaitForIdle(qspi);
+    qspi->DEVSIZECONFIG = (qspi->DEVSIZECONFIG
+                           & ~(_QSPI_DEVSIZECONFIG_NUMADDRBYTES_MASK
+                               | _QSPI_DEVSIZECONFIG_BYTESPERDEVICEPAGE_MASK))
+                          | ((info->addressBytes - 1UL) << _QSPI_DEVSIZECONFIG_NUMADDRBYTES_SHIFT)
+                          | ((info->pageSize << _QSPI_DEVSIZECONFIG_BYTESPERDEVICEPAGE_SHIFT)
+                             & _QSPI_DEVSIZECONFIG_BYTESPERDEVICEPAGE_MASK);
+  }
+
+  writeConfig.opCode = CMD_PAGE_PROGRAM;
+  QSPI_WriteConfig(qspi, &writeConfig);
+  // Completion is polled by QSPIFLASH_Process() instead of stalling the QSPI
+  qspi->WRITECOMPLETIONCTRL |= QSPI_WRITECOMPLETIONCTRL_DISABLEPOLLING;
+
+  indirectConfig.triggerAddress    = EMDRV_QSPIFLASH_TRIGGER_ADDRESS;
+  indirectConfig.triggerRangeWidth = TRIGGER_RANGE_WIDTH;
+  indirectConfig.readPartition     = EMDRV_QSPIFLASH_SRAM_READ_WORDS;
+  QSPI_IndirectConfig(qspi, &indirectConfig);
+
+  handle->state       = STATE_IDLE;
+  handle->initialized = true;
+  return SL_STATUS_OK;
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Deinitialize a QSPIFLASH handle.
+ *
+ * @param[in] handle
+ *  The QSPIFLASH handle.
+ *
+ * @return
+ *  SL_STATUS_OK on success, SL_STATUS_BUSY if a write or an erase is ongoing.
+ ******************************************************************************/
+sl_status_t QSPIFLASH_DeInit(QSPIFLASH_Handle_t handle)
+{
+  if (handle == NULL) {
+    return SL_STATUS_NULL_POINTER;
+  }
+  if (!handle->initialized) {
+    return SL_STATUS_NOT_INITIALIZED;
+  }
+  if (handle->state != STATE_IDLE) {
+    return SL_STATUS_BUSY;
+  }
+
+  handle->initialized = false;
+  return SL_STATUS_OK;
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Get the device parameters.
+ *
+ * @param[in] handle
+ *  The QSPIFLASH handle.
+ *
+ * @param[out] info
+ *  The device parameters.
+ *
+ * @return
+ *  SL_STATUS_OK on success. On failure, an appropriate sl_status_t is
+ *  returned.
+ ******************************************************************************/
+sl_status_t QSPIFLASH_GetInfo(QSPIFLASH_Handle_t handle, QSPIFLASH_Info_t *info)
+{
+  if ((handle == NULL) || (info == NULL)) {
+    return SL_STATUS_NULL_POINTER;
+  }
+  if (!handle->initialized) {
+    return SL_STATUS_NOT_INITIALIZED;
+  }
+
+  *info = handle->info;
+  return SL_STATUS_OK;
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Read from the device.
+ *
+ * @details
+ *  The data is read with an indirect read. Each time the read partition of
+ *  the QSPI SRAM holds data, it is moved to @p buffer with an LDMA transfer,
+ *  or by the CPU for small chunks and when @p buffer is not word aligned.
+ *  The function returns when all data has been read.
+ *
+ * @param[in] handle
+ *  The QSPIFLASH handle.
+ *
+ * @param[in] address
+ *  Device address to read from.
+ *
+ * @param[out] buffer
+ *  Buffer receiving the data.
+ *
+ * @param[in] size
+ *  Number of bytes to read.
+ *
+ * @return
+ *  SL_STATUS_OK on success, SL_STATUS_BUSY if a write or an erase is ongoing.
+ *  On other failures, an appropriate sl_status_t is returned.
+ ******************************************************************************/
+sl_status_t QSPIFLASH_Read(QSPIFLASH_Handle_t handle,
+                           uint32_t           address,
+                           void               *buffer,
+                           uint32_t           size)
+{
+  uint8_t *dst = buffer;
+  uint32_t done = 0U;
+
+  if ((handle == NULL) || ((buffer == NULL) && (size != 0U))) {
+    return SL_STATUS_NULL_POINTER;
+  }
+  if (!handle->initialized) {
+    return SL_STATUS_NOT_INITIALIZED;
+  }
+  if ((address > handle->info.size) || (size > (handle->info.size - address))) {
+    return SL_STATUS_INVALID_RANGE;
+  }
+  if (handle->state != STATE_IDLE) {
+    return SL_STATUS_BUSY;
+  }
+  if (size == 0U) {
+    return SL_STATUS_OK;
+  }
+
+  QSPI_IndirectReadStart(handle->qspi, address, size);
+
+  while (done < size) {
+    uint32_t words = QSPI_GetReadLevel(handle->qspi);
+    uint32_t fullWords = SL_MIN(words, (size - done) / 4U);
+
+    if (DmaUsable(handle, dst + done, fullWords)) {
+      DmaStart(handle, (const void *)TRIGGER, dst + done, fullWords, false);
+      while (!LDMA_TransferDone(handle->dmaChannel)) {
+      }
+      done += fullWords * 4U;
+      continue;
+    }
+    for (; (words > 0U) && (done < size); words--) {
+      uint32_t word = *TRIGGER;
+      uint32_t count = SL_MIN(4U, size - done);
+
+      memcpy(dst + done, &word, count);
+      done += count;
+    }
+  }
+
+  while (!QSPI_IndirectReadDone(handle->qspi)) {
+  }
+  return SL_STATUS_OK;
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Start writing to the device.
+ *
+ * @details
+ *  The data is programmed one page at a time by @ref QSPIFLASH_Process(),
+ *  which must be called until it no longer returns SL_STATUS_IN_PROGRESS.
+ *  The first page is started before returning unless the handle is
+ *  initialized for XIP. The device area must have been erased.
+ *
+ * @param[in] handle
+ *  The QSPIFLASH handle.
+ *
+ * @param[in] address
+ *  Device address to write to.
+ *
+ * @param[in] data
+ *  Data to write, must stay allocated until the write has completed.
+ *
+ * @param[in] size
+ *  Number of bytes to write.
+ *
+ * @return
+ *  SL_STATUS_OK when the write is started, SL_STATUS_BUSY if a write or an
+ *  erase is ongoing and SL_STATUS_PERMISSION if the area overlaps the
+ *  executed image. On other failures, an appropriate sl_status_t is returned.
+ ******************************************************************************/
+sl_status_t QSPIFLASH_WriteStart(QSPIFLASH_Handle_t handle,
+                                 uint32_t           address,
+                                 const void         *data,
+                                 uint32_t           size)
+{
+  if ((handle == NULL) || ((data == NULL) && (size != 0U))) {
+    return SL_STATUS_NULL_POINTER;
+  }
+  if (!handle->initialized) {
+    return SL_STATUS_NOT_INITIALIZED;
+  }
+  if ((address > handle->info.size) || (size > (handle->info.size - address))) {
+    return SL_STATUS_INVALID_RANGE;
+  }
+  if (handle->state != STATE_IDLE) {
+    return SL_STATUS_BUSY;
+  }
+  if (size == 0U) {
+    return SL_STATUS_OK;
+  }
+  if (handle->xip) {
+    if ((address < handle->xipEnd) && ((address + size) > handle->xipStart)) {
+      return SL_STATUS_PERMISSION;
+    }
+    // The data cannot be read from the device while programming it
+    if (InDevice((uintptr_t)data) || InDevice((uintptr_t)data + size - 1U)) {
+      return SL_STATUS_INVALID_PARAMETER;
+    }
+  }
+
+  handle->operation = OPERATION_WRITE;
+  handle->address   = address;
+  handle->remaining = size;
+  handle->data      = data;
+  handle->state     = STATE_READY;
+  if (!handle->xip) {
+    StepStart(handle);
+  }
+  return SL_STATUS_OK;
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Write to the device.
+ *
+ * @details
+ *  Blocking version of @ref QSPIFLASH_WriteStart().
+ *
+ * @param[in] handle
+ *  The QSPIFLASH handle.
+ *
+ * @param[in] address
+ *  Device address to write to.
+ *
+ * @param[in] data
+ *  Data to write.
+ *
+ * @param[in] size
+ *  Number of bytes to write.
+ *
+ * @return
+ *  SL_STATUS_OK on success. On failure, an appropriate sl_status_t is
+ *  returned, see @ref QSPIFLASH_WriteStart().
+ ******************************************************************************/
+sl_status_t QSPIFLASH_Write(QSPIFLASH_Handle_t handle,
+                            uint32_t           address,
+                            const void         *data,
+                            uint32_t           size)
+{
+  sl_status_t status;
+
+  status = QSPIFLASH_WriteStart(handle, address, data, size);
+  if (status != SL_STATUS_OK) {
+    return status;
+  }
+  do {
+    status = QSPIFLASH_Process(handle);
+  } while (status == SL_STATUS_IN_PROGRESS);
+  return status;
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Start erasing the device.
+ *
+ * @details
+ *  The area is erased with the largest erase blocks fitting in it by
+ *  @ref QSPIFLASH_Process(), which must be called until it no longer returns
+ *  SL_STATUS_IN_PROGRESS. The first block is started before returning unless
+ *  the handle is initialized for XIP. With XIP, the smallest erase blocks
+ *  are used to bound the time interrupts are disabled.
+ *
+ * @param[in] handle
+ *  The QSPIFLASH handle.
+ *
+ * @param[in] address
+ *  Device address to erase from, aligned to the smallest erase block.
+ *
+ * @param[in] size
+ *  Number of bytes to erase, a multiple of the smallest erase block.
+ *
+ * @return
+ *  SL_STATUS_OK when the erase is started, SL_STATUS_BUSY if a write or an
+ *  erase is ongoing and SL_STATUS_PERMISSION if the area overlaps the
+ *  executed image. On other failures, an appropriate sl_status_t is returned.
+ ******************************************************************************/
+sl_status_t QSPIFLASH_EraseStart(QSPIFLASH_Handle_t handle,
+                                 uint32_t           address,
+                                 uint32_t           size)
+{
+  uint32_t blockMask;
+
+  if (handle == NULL) {
+    return SL_STATUS_NULL_POINTER;
+  }
+  if (!handle->initialized) {
+    return SL_STATUS_NOT_INITIALIZED;
+  }
+  if ((address > handle->info.size) || (size > (handle->info.size - address))) {
+    return SL_STATUS_INVALID_RANGE;
+  }
+  blockMask = handle->info.eraseTypes[0].size - 1U;
+  if (((address & blockMask) != 0U) || ((size & blockMask) != 0U)) {
+    return SL_STATUS_INVALID_PARAMETER;
+  }
+  if (handle->state != STATE_IDLE) {
+    return SL_STATUS_BUSY;
+  }
+  if (size == 0U) {
+    return SL_STATUS_OK;
+  }
+  if (handle->xip
+      && (address < handle->xipEnd) && ((address + size) > handle->xipStart)) {
+    return SL_STATUS_PERMISSION;
+  }
+
+  handle->operation = OPERATION_ERASE;
+  handle->address   = address;
+  handle->remaining = size;
+  handle->data      = NULL;
+  handle->state     = STATE_READY;
+  if (!handle->xip) {
+    StepStart(handle);
+  }
+  return SL_STATUS_OK;
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Erase the device.
+ *
+ * @details
+ *  Blocking version of @ref QSPIFLASH_EraseStart().
+ *
+ * @param[in] handle
+ *  The QSPIFLASH handle.
+ *
+ * @param[in] address
+ *  Device address to erase from, aligned to the smallest erase block.
+ *
+ * @param[in] size
+ *  Number of bytes to erase, a multiple of the smallest erase block.
+ *
+ * @return
+ *  SL_STATUS_OK on success. On failure, an appropriate sl_status_t is
+ *  returned, see @ref QSPIFLASH_EraseStart().
+ ******************************************************************************/
+sl_status_t QSPIFLASH_Erase(QSPIFLASH_Handle_t handle,
+                            uint32_t           address,
+                            uint32_t           size)
+{
+  sl_status_t status;
+
+  status = QSPIFLASH_EraseStart(handle, address, size);
+  if (status != SL_STATUS_OK) {
+    return status;
+  }
+  do {
+    status = QSPIFLASH_Process(handle);
+  } while (status == SL_STATUS_IN_PROGRESS);
+  return status;
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Advance an ongoing write or erase.
+ *
+ * @details
+ *  Without XIP, the function checks whether the current page program or
+ *  block erase has completed and starts the next one at once, so that the
+ *  device is kept busy. It can be called from a task, a timer callback or an
+ *  idle loop, the typical timings in @ref QSPIFLASH_Info_t give a suitable
+ *  polling interval.
+ *
+ *  With XIP, each call runs one page program or block erase to completion
+ *  from RAM with interrupts disabled, see @ref qspiflash for the worst-case
+ *  time.
+ *
+ * @param[in] handle
+ *  The QSPIFLASH handle.
+ *
+ * @return
+ *  SL_STATUS_IN_PROGRESS while the operation is ongoing, SL_STATUS_OK once
+ *  it has completed or when no operation is ongoing. On other failures, an
+ *  appropriate sl_status_t is returned.
+ ******************************************************************************/
+sl_status_t QSPIFLASH_Process(QSPIFLASH_Handle_t handle)
+{
+  if (handle == NULL) {
+    return SL_STATUS_NULL_POINTER;
+  }
+  if (!handle->initialized) {
+    return SL_STATUS_NOT_INITIALIZED;
+  }
+  if (handle->state == STATE_IDLE) {
+    return SL_STATUS_OK;
+  }
+
+  if (handle->xip) {
+    StepPrepare(handle);
+    XipStepRun(handle);
+  } else if (!StepDone(handle)) {
+    return SL_STATUS_IN_PROGRESS;
+  }
+
+  return StepNext(handle);
+}
+
+/// @cond DO_NOT_INCLUDE_WITH_DOXYGEN
+
+/***************************************************************************//**
+ * @brief
+ *  Execute an instruction without address and data.
+ ******************************************************************************/
+static void StigCommand(QSPI_TypeDef *qspi, uint8_t opcode)
+{
+  QSPI_StigCmd_TypeDef stigCmd = { 0 };
+
+  stigCmd.cmdOpcode = opcode;
+  QSPI_ExecStigCmd(qspi, &stigCmd);
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Execute an instruction with an address.
+ ******************************************************************************/
+static void StigAddressCommand(QSPI_TypeDef *qspi,
+                               uint8_t      opcode,
+                               uint32_t     address,
+                               uint8_t      addressBytes)
+{
+  QSPI_StigCmd_TypeDef stigCmd = { 0 };
+
+  stigCmd.cmdOpcode = opcode;
+  stigCmd.addrSize  = addressBytes;
+  stigCmd.address   = address;
+  QSPI_ExecStigCmd(qspi, &stigCmd);
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Read a one byte register.
+ ******************************************************************************/
+static uint8_t StigReadRegister(QSPI_TypeDef *qspi, uint8_t opcode)
+{
+  QSPI_StigCmd_TypeDef stigCmd = { 0 };
+  uint8_t value = 0U;
+
+  stigCmd.cmdOpcode    = opcode;
+  stigCmd.readDataSize = 1U;
+  stigCmd.readBuffer   = &value;
+  QSPI_ExecStigCmd(qspi, &stigCmd);
+  return value;
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Write a register and wait for the device to complete the write.
+ *
+ * @details
+ *  Interrupts are disabled while the device is busy in case code is running
+ *  from it.
+ ******************************************************************************/
+static void StigWriteRegister(QSPI_TypeDef  *qspi,
+                              uint8_t       opcode,
+                              const uint8_t *data,
+                              uint8_t       size)
+{
+  QSPI_StigCmd_TypeDef stigCmd = { 0 };
+  uint8_t buffer[2];
+  CORE_DECLARE_IRQ_STATE;
+
+  memcpy(buffer, data, size);
+  stigCmd.cmdOpcode     = opcode;
+  stigCmd.writeDataSize = size;
+  stigCmd.writeBuffer   = buffer;
+
+  CORE_ENTER_ATOMIC();
+  StigCommand(qspi, CMD_WRITE_ENABLE);
+  QSPI_ExecStigCmd(qspi, &stigCmd);
+  while ((StigReadRegister(qspi, CMD_READ_STATUS) & STATUS_WIP) != 0U) {
+  }
+  CORE_EXIT_ATOMIC();
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Read from the SFDP area.
+ ******************************************************************************/
+static void SfdpRead(QSPI_TypeDef *qspi, uint32_t address, void *buffer, uint32_t size)
+{
+  QSPI_StigCmd_TypeDef stigCmd = { 0 };
+  uint8_t *dst = buffer;
+
+  stigCmd.cmdOpcode   = CMD_READ_SFDP;
+  stigCmd.addrSize    = 3U;
+  stigCmd.dummyCycles = SFDP_DUMMY_CYCLES;
+  while (size > 0U) {
+    stigCmd.readDataSize = (uint16_t)SL_MIN(size, 8U);
+    stigCmd.address      = address;
+    stigCmd.readBuffer   = dst;
+    QSPI_ExecStigCmd(qspi, &stigCmd);
+    address += stigCmd.readDataSize;
+    dst     += stigCmd.readDataSize;
+    size    -= stigCmd.readDataSize;
+  }
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Get the device parameters from the SFDP Basic Flash Parameter Table.
+ *
+ * @param[out] addressMode
+ *  Supported address modes, BFPT_ADDR_x.
+ *
+ * @param[out] qer
+ *  Quad enable requirements, BFPT_QER_UNKNOWN if not given.
+ *
+ * @return
+ *  true if the device has a usable parameter table.
+ ******************************************************************************/
+static bool SfdpParse(QSPIFLASH_Handle_t handle, uint8_t *addressMode, uint8_t *qer)
+{
+  static const uint16_t eraseUnitMs[4] = { 1U, 16U, 128U, 1000U };
+  QSPIFLASH_Info_t *info = &handle->info;
+  uint32_t bfpt[SFDP_BFPT_MAX_DWORDS];
+  uint32_t header[2];
+  uint8_t param[8];
+  uint32_t dwords;
+  uint32_t density;
+
+  SfdpRead(handle->qspi, 0U, header, sizeof(header));
+  if (header[0] != SFDP_SIGNATURE) {
+    return false;
+  }
+  // The first parameter header always describes the Basic Flash Parameter Table
+  SfdpRead(handle->qspi, sizeof(header), param, sizeof(param));
+  dwords = param[3];
+  if ((param[0] != SFDP_BFPT_ID) || (dwords < SFDP_BFPT_MIN_DWORDS)) {
+    return false;
+  }
+  dwords = SL_MIN(dwords, SFDP_BFPT_MAX_DWORDS);
+  memset(bfpt, 0, sizeof(bfpt));
+  SfdpRead(handle->qspi,
+           param[4] | ((uint32_t)param[5] << 8) | ((uint32_t)param[6] << 16),
+           bfpt,
+           dwords * 4U);
+
+  density = bfpt[1];
+  if ((density & BFPT_DENSITY_POW2) != 0U) {
+    density &= ~BFPT_DENSITY_POW2;
+    if ((density < 3U) || (density > 34U)) {
+      return false;
+    }
+    info->size = 1UL << (density - 3U);
+  } else {
+    info->size = (uint32_t)(((uint64_t)density + 1U) / 8U);
+  }
+  *addressMode = (uint8_t)((bfpt[0] >> BFPT_ADDR_BYTES_SHIFT) & 0x3U);
+
+  for (uint32_t i = 0U; i < QSPIFLASH_ERASE_TYPES; i++) {
+    uint32_t field = bfpt[7U + i / 2U] >> (16U * (i % 2U));
+    uint32_t sizeLog2 = field & 0xFFU;
+
+    if ((sizeLog2 == 0U) || (sizeLog2 > 31U)) {
+      continue;
+    }
+    info->eraseTypes[i].size   = 1UL << sizeLog2;
+    info->eraseTypes[i].opcode = (uint8_t)(field >> 8);
+    if (dwords >= 10U) {
+      uint32_t time = bfpt[9] >> (4U + 7U * i);
+
+      info->eraseTypes[i].typicalTimeMs = ((time & 0x1FU) + 1U)
+                                          * eraseUnitMs[(time >> 5) & 0x3U];
+    }
+  }
+  if ((info->eraseTypes[0].size == 0U) && (info->eraseTypes[1].size == 0U)
+      && (info->eraseTypes[2].size == 0U) && (info->eraseTypes[3].size == 0U)) {
+    if ((bfpt[0] & BFPT_ERASE_4K_MASK) != BFPT_ERASE_4K) {
+      return false;
+    }
+    info->eraseTypes[0].size   = 4096U;
+    info->eraseTypes[0].opcode = (uint8_t)(bfpt[0] >> 8);
+  }
+
+  info->pageSize = DEFAULT_PAGE_SIZE;
+  if (dwords >= 11U) {
+    info->pageSize = 1UL << ((bfpt[10] >> 4) & 0xFU);
+    info->pageProgramTimeUs = (((bfpt[10] >> 8) & 0x1FU) + 1U)
+                              * (((bfpt[10] & (1UL << 13)) != 0U) ? 64U : 8U);
+    info->maxTimeFactor = (uint8_t)(2U * ((bfpt[10] & 0xFU) + 1U));
+  }
+  if (dwords >= 15U) {
+    *qer = (uint8_t)((bfpt[14] >> BFPT_QER_SHIFT) & 0x7U);
+  }
+
+  // Quad output read is used only when the quad enable method is known
+  if (((bfpt[0] & BFPT_FAST_READ_114) != 0U) && (*qer <= BFPT_QER_MAX)
+      && ((((bfpt[2] >> 16) & 0x1FU) + ((bfpt[2] >> 21) & 0x7U)) <= MAX_DUMMY_CYCLES)) {
+    info->readOpcode       = (uint8_t)(bfpt[2] >> 24);
+    info->readDummyCycles  = (uint8_t)(((bfpt[2] >> 16) & 0x1FU) + ((bfpt[2] >> 21) & 0x7U));
+    info->readDataTransfer = qspiTransferQuad;
+  } else if (((bfpt[0] & BFPT_FAST_READ_112) != 0U)
+             && (((bfpt[3] & 0x1FU) + ((bfpt[3] >> 5) & 0x7U)) <= MAX_DUMMY_CYCLES)) {
+    info->readOpcode       = (uint8_t)(bfpt[3] >> 8);
+    info->readDummyCycles  = (uint8_t)((bfpt[3] & 0x1FU) + ((bfpt[3] >> 5) & 0x7U));
+    info->readDataTransfer = qspiTransferDual;
+  } else {
+    info->readOpcode       = CMD_FAST_READ;
+    info->readDummyCycles  = 8U;
+    info->readDataTransfer = qspiTransferSingle;
+  }
+  return true;
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Get default device parameters for a device without SFDP tables.
+ *
+ * @return
+ *  true if the capacity code of the JEDEC ID is usable.
+ ******************************************************************************/
+static bool JedecParse(QSPIFLASH_Handle_t handle)
+{
+  QSPIFLASH_Info_t *info = &handle->info;
+  uint32_t capacity = info->jedecId >> 16;
+
+  if ((capacity < 0x10U) || (capacity > 0x1FU)) {
+    return false;
+  }
+
+  memset(info->eraseTypes, 0, sizeof(info->eraseTypes));
+  info->size                 = 1UL << capacity;
+  info->pageSize             = DEFAULT_PAGE_SIZE;
+  info->eraseTypes[0].size   = 4096U;
+  info->eraseTypes[0].opcode = CMD_ERASE_4K;
+  info->eraseTypes[1].size   = 65536U;
+  info->eraseTypes[1].opcode = CMD_ERASE_64K;
+  info->readOpcode           = CMD_READ;
+  info->readDummyCycles      = 0U;
+  info->readDataTransfer     = qspiTransferSingle;
+  return true;
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Sort the erase types by increasing size, unused types last.
+ ******************************************************************************/
+static void EraseTypesSort(QSPIFLASH_Info_t *info)
+{
+  for (uint32_t i = 1U; i < QSPIFLASH_ERASE_TYPES; i++) {
+    QSPIFLASH_EraseType_t type = info->eraseTypes[i];
+    uint32_t j = i;
+
+    while ((j > 0U) && (type.size != 0U)
+           && ((info->eraseTypes[j - 1U].size == 0U)
+               || (info->eraseTypes[j - 1U].size > type.size))) {
+      info->eraseTypes[j] = info->eraseTypes[j - 1U];
+      j--;
+    }
+    info->eraseTypes[j] = type;
+  }
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Set the quad enable bit as described by the SFDP quad enable requirements.
+ *
+ * @return
+ *  true if quad reads can be used.
+ ******************************************************************************/
+static bool QuadEnable(QSPI_TypeDef *qspi, uint8_t qer)
+{
+  uint8_t status[2];
+
+  switch (qer) {
+    case 0U:
+      // No quad enable bit
+      return true;
+
+    case 1U:
+    case 4U:
+    case 5U:
+      // Bit 1 of status register 2, written together with status register 1.
+      // Status register 2 cannot be read with requirement 1.
+      status[0] = StigReadRegister(qspi, CMD_READ_STATUS);
+      status[1] = (qer == 1U) ? 0U : StigReadRegister(qspi, CMD_READ_STATUS2);
+      if ((qer == 1U) || ((status[1] & 0x02U) == 0U)) {
+        status[1] |= 0x02U;
+        StigWriteRegister(qspi, CMD_WRITE_STATUS, status, 2U);
+      }
+      return (qer == 1U) || ((StigReadRegister(qspi, CMD_READ_STATUS2) & 0x02U) != 0U);
+
+    case 2U:
+      // Bit 6 of status register 1
+      status[0] = StigReadRegister(qspi, CMD_READ_STATUS);
+      if ((status[0] & 0x40U) == 0U) {
+        status[0] |= 0x40U;
+        StigWriteRegister(qspi, CMD_WRITE_STATUS, status, 1U);
+      }
+      return (StigReadRegister(qspi, CMD_READ_STATUS) & 0x40U) != 0U;
+
+    case 3U:
+      // Bit 7 of status register 2, with its own instructions
+      status[0] = StigReadRegister(qspi, CMD_READ_STATUS2_ALT);
+      if ((status[0] & 0x80U) == 0U) {
+        status[0] |= 0x80U;
+        StigWriteRegister(qspi, CMD_WRITE_STATUS2_ALT, status, 1U);
+      }
+      return (StigReadRegister(qspi, CMD_READ_STATUS2_ALT) & 0x80U) != 0U;
+
+    case 6U:
+      // Bit 1 of status register 2, with its own write instruction
+      status[0] = StigReadRegister(qspi, CMD_READ_STATUS2);
+      if ((status[0] & 0x02U) == 0U) {
+        status[0] |= 0x02U;
+        StigWriteRegister(qspi, CMD_WRITE_STATUS2, status, 1U);
+      }
+      return (StigReadRegister(qspi, CMD_READ_STATUS2) & 0x02U) != 0U;
+
+    default:
+      return false;
+  }
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Check whether an address is inside one of the direct access windows.
+ ******************************************************************************/
+static bool InDevice(uintptr_t address)
+{
+#if defined(QSPI0_CODE_MEM_BASE)
+  if ((address - QSPI0_CODE_MEM_BASE) < QSPI0_CODE_MEM_SIZE) {
+    return true;
+  }
+#endif
+#if defined(QSPI0_MEM_BASE)
+  if ((address - QSPI0_MEM_BASE) < QSPI0_MEM_SIZE) {
+    return true;
+  }
+#endif
+  (void)address;
+  return false;
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Check whether a chunk should be moved with the LDMA.
+ ******************************************************************************/
+static bool DmaUsable(QSPIFLASH_Handle_t handle, const void *buffer, uint32_t words)
+{
+  return (handle->dmaChannel >= 0)
+         && (words >= EMDRV_QSPIFLASH_DMA_MIN_WORDS)
+         && (((uintptr_t)buffer & 0x3U) == 0U);
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Start an LDMA transfer between a buffer and the trigger address.
+ *
+ * @details
+ *  QSPI has no LDMA request, the transfer is a memory-to-memory transfer
+ *  sized to what the SRAM partition can take or give at the time.
+ ******************************************************************************/
+static void DmaStart(QSPIFLASH_Handle_t handle,
+                     const void         *src,
+                     volatile void      *dst,
+                     uint32_t           words,
+                     bool               toDevice)
+{
+  LDMA_TransferCfg_t transfer = LDMA_TRANSFER_CFG_MEMORY();
+  LDMA_Descriptor_t descriptor = LDMA_DESCRIPTOR_SINGLE_M2M_WORD(src, dst, words);
+
+  if (toDevice) {
+    descriptor.xfer.dstInc = ldmaCtrlDstIncNone;
+  } else {
+    descriptor.xfer.srcInc = ldmaCtrlSrcIncNone;
+  }
+  // Completion is polled
+  descriptor.xfer.doneIfs = 0U;
+  handle->dmaDescriptor = descriptor;
+  LDMA_StartTransfer(handle->dmaChannel, &transfer, &handle->dmaDescriptor);
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Move program data to the write partition as space becomes available.
+ *
+ * @return
+ *  true once the indirect write has completed.
+ ******************************************************************************/
+static bool ProgramFeed(QSPIFLASH_Handle_t handle)
+{
+  if (handle->dmaActive) {
+    if (!LDMA_TransferDone(handle->dmaChannel)) {
+      return false;
+    }
+    handle->dmaActive = false;
+  }
+
+  while (handle->stepQueued < handle->stepSize) {
+    const uint8_t *src = handle->data + handle->stepQueued;
+    uint32_t level = QSPI_GetWriteLevel(handle->qspi);
+    uint32_t space;
+    uint32_t words;
+
+    if (level >= EMDRV_QSPIFLASH_SRAM_WRITE_WORDS) {
+      return false;
+    }
+    space = EMDRV_QSPIFLASH_SRAM_WRITE_WORDS - level;
+    words = SL_MIN(space, (handle->stepSize - handle->stepQueued) / 4U);
+
+    if (DmaUsable(handle, src, words)) {
+      DmaStart(handle, src, TRIGGER, words, true);
+      handle->dmaActive   = true;
+      handle->stepQueued += words * 4U;
+      return false;
+    }
+    for (; (space > 0U) && (handle->stepQueued < handle->stepSize); space--) {
+      uint32_t word = 0xFFFFFFFFUL;
+      uint32_t count = SL_MIN(4U, handle->stepSize - handle->stepQueued);
+
+      memcpy(&word, handle->data + handle->stepQueued, count);
+      *TRIGGER = word;
+      handle->stepQueued += count;
+    }
+  }
+
+  return QSPI_IndirectWriteDone(handle->qspi);
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Size the next page program or block erase.
+ ******************************************************************************/
+static void StepPrepare(QSPIFLASH_Handle_t handle)
+{
+  if (handle->operation == OPERATION_WRITE) {
+    uint32_t pageLeft = handle->info.pageSize
+                        - (handle->address & (handle->info.pageSize - 1U));
+
+    handle->stepSize   = SL_MIN(pageLeft, handle->remaining);
+    handle->stepQueued = 0U;
+  } else {
+    const QSPIFLASH_EraseType_t *type = &handle->info.eraseTypes[0];
+
+    // Largest block aligned at the address and fitting in the area. With XIP
+    // the whole erase runs with interrupts disabled, the smallest block is used.
+    for (uint32_t i = handle->xip ? 0U : QSPIFLASH_ERASE_TYPES; i > 0U; i--) {
+      const QSPIFLASH_EraseType_t *candidate = &handle->info.eraseTypes[i - 1U];
+
+      if ((candidate->size != 0U)
+          && ((handle->address & (candidate->size - 1U)) == 0U)
+          && (candidate->size <= handle->remaining)) {
+        type = candidate;
+        break;
+      }
+    }
+    handle->stepSize    = type->size;
+    handle->eraseOpcode = type->opcode;
+  }
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Start the next page program or block erase.
+ ******************************************************************************/
+static void StepStart(QSPIFLASH_Handle_t handle)
+{
+  StepPrepare(handle);
+  if (handle->operation == OPERATION_WRITE) {
+    handle->state = STATE_PROGRAM;
+    QSPI_IndirectWriteStart(handle->qspi, handle->address, handle->stepSize);
+    (void)ProgramFeed(handle);
+  } else {
+    handle->state = STATE_WAIT;
+    StigCommand(handle->qspi, CMD_WRITE_ENABLE);
+    StigAddressCommand(handle->qspi, handle->eraseOpcode, handle->address,
+                       handle->info.addressBytes);
+  }
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Check whether the current step has completed.
+ ******************************************************************************/
+static bool StepDone(QSPIFLASH_Handle_t handle)
+{
+  if (handle->state == STATE_PROGRAM) {
+    if (!ProgramFeed(handle)) {
+      return false;
+    }
+    handle->state = STATE_WAIT;
+  }
+  return (StigReadRegister(handle->qspi, CMD_READ_STATUS) & STATUS_WIP) == 0U;
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Account for a completed step and start the next one.
+ ******************************************************************************/
+static sl_status_t StepNext(QSPIFLASH_Handle_t handle)
+{
+  handle->address   += handle->stepSize;
+  handle->remaining -= handle->stepSize;
+  if (handle->operation == OPERATION_WRITE) {
+    handle->data += handle->stepSize;
+  }
+
+  if (handle->remaining == 0U) {
+    handle->state = STATE_IDLE;
+#if defined(_MSC_CACHECMD_MASK)
+    // Drop stale copies of the modified area
+    MSC->CACHECMD = MSC_CACHECMD_INVCACHE;
+#endif
+    return SL_STATUS_OK;
+  }
+
+  handle->state = STATE_READY;
+  if (!handle->xip) {
+    StepStart(handle);
+  }
+  return SL_STATUS_IN_PROGRESS;
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Execute an instruction from RAM, see @ref XipStepRun().
+ *
+ * @param[in] ctrl
+ *  FLASHCMDCTRL value, without the execute bit.
+ *
+ * @return
+ *  The first byte read, if any.
+ ******************************************************************************/
+SL_RAMFUNC_DEFINITION_BEGIN
+static uint8_t __attribute__ ((noinline)) XipStig(QSPI_TypeDef *qspi,
+                                                  uint32_t     ctrl,
+                                                  uint32_t     address)
+{
+  while ((qspi->CONFIG & _QSPI_CONFIG_IDLE_MASK) == 0U) {
+  }
+  qspi->FLASHCMDADDR = address;
+  qspi->FLASHCMDCTRL = ctrl;
+  qspi->FLASHCMDCTRL = ctrl | QSPI_FLASHCMDCTRL_CMDEXEC;
+  while ((qspi->FLASHCMDCTRL & QSPI_FLASHCMDCTRL_CMDEXECSTATUS) != 0U) {
+  }
+  return (uint8_t)qspi->FLASHRDDATALOWER;
+}
+SL_RAMFUNC_DEFINITION_END
+
+/***************************************************************************//**
+ * @brief
+ *  Run the step sized by @ref StepPrepare() to completion while code is
+ *  executed from the device.
+ *
+ * @details
+ *  From the first instruction sent to the device until it is idle again,
+ *  nothing may be fetched from the device. This function and @ref XipStig()
+ *  are the only code running in that window. Interrupts are masked with
+ *  PRIMASK through the CMSIS intrinsics, since the em_core functions and the
+ *  interrupt handlers may be located in the device. The program data is
+ *  moved with the CPU, without calls to the LDMA helpers or memcpy().
+ ******************************************************************************/
+SL_RAMFUNC_DEFINITION_BEGIN
+static void __attribute__ ((noinline)) XipStepRun(QSPIFLASH_Handle_t handle)
+{
+  QSPI_TypeDef *qspi = handle->qspi;
+  uint32_t primask = __get_PRIMASK();
+
+  __disable_irq();
+  if (handle->operation == OPERATION_WRITE) {
+    qspi->INDIRECTWRITEXFERCTRL     = QSPI_INDIRECTWRITEXFERCTRL_INDOPSDONESTATUS;
+    qspi->INDIRECTWRITEXFERSTART    = handle->address;
+    qspi->INDIRECTWRITEXFERNUMBYTES = handle->stepSize;
+    qspi->INDIRECTWRITEXFERCTRL     = QSPI_INDIRECTWRITEXFERCTRL_START;
+
+    while (handle->stepQueued < handle->stepSize) {
+      uint32_t count = SL_MIN(4U, handle->stepSize - handle->stepQueued);
+      uint32_t word = 0xFFFFFFFFUL;
+
+      for (uint32_t i = 0U; i < count; i++) {
+        word &= ~(0xFFUL << (8U * i));
+        word |= (uint32_t)handle->data[handle->stepQueued + i] << (8U * i);
+      }
+      while (((qspi->SRAMFILL & _QSPI_SRAMFILL_SRAMFILLINDACWRITE_MASK)
+              >> _QSPI_SRAMFILL_SRAMFILLINDACWRITE_SHIFT)
+             >= EMDRV_QSPIFLASH_SRAM_WRITE_WORDS) {
+      }
+      *TRIGGER = word;
+      handle->stepQueued += count;
+    }
+    while ((qspi->INDIRECTWRITEXFERCTRL & QSPI_INDIRECTWRITEXFERCTRL_INDOPSDONESTATUS) == 0U) {
+    }
+  } else {
+    (void)XipStig(qspi, XIP_STIG_OPCODE(CMD_WRITE_ENABLE), 0U);
+    (void)XipStig(qspi,
+                  XIP_STIG_OPCODE(handle->eraseOpcode)
+                  | XIP_STIG_ADDRESS(handle->info.addressBytes),
+                  handle->address);
+  }
+  while ((XipStig(qspi, XIP_STIG_OPCODE(CMD_READ_STATUS) | XIP_STIG_READ_BYTE, 0U)
+          & STATUS_WIP) != 0U) {
+  }
+  __set_PRIMASK(primask);
+}
+SL_RAMFUNC_DEFINITION_END
+
+/// @endcond
+
+#endif /* defined(QSPI_COUNT) && (QSPI_COUNT > 0) */
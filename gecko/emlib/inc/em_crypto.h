@@ -52,6 +52,13 @@
 #include <stdbool.h>
 #include <string.h>
 
+/* LDMA streaming is opt-in, define USE_CRYPTO_LDMA to build it. It requires
+   em_ldma. */
+#if defined(USE_CRYPTO_LDMA) && defined(LDMA_PRESENT) && (LDMA_COUNT == 1)
+#define CRYPTO_LDMA_SUPPORTED
+#include "em_ldma.h"
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -590,6 +597,66 @@ typedef uint8_t CRYPTO_SHA256_Digest_TypeDef[CRYPTO_SHA256_DIGEST_SIZE_IN_BYTES]
  */
 typedef void (*CRYPTO_AES_CtrFuncPtr_TypeDef)(uint8_t * ctr);
 
+#if defined(CRYPTO_LDMA_SUPPORTED)
+/**
+ * Maximum number of bytes streamed by one CRYPTO sequence run in LDMA mode.
+ * Longer buffers are split into several runs by CRYPTO_DmaIRQHandler().
+ */
+#define CRYPTO_DMA_CHUNK_SIZE_IN_BYTES     (8192UL)
+
+/** Operation carried out by an LDMA transfer. */
+typedef enum {
+  cryptoDmaAesCbc,      /**< AES CBC mode */
+  cryptoDmaAesPcbc,     /**< AES PCBC mode */
+  cryptoDmaAesCfb,      /**< AES CFB mode */
+  cryptoDmaAesCtr,      /**< AES CTR mode */
+  cryptoDmaAesEcb,      /**< AES ECB mode */
+  cryptoDmaAesOfb,      /**< AES OFB mode */
+  cryptoDmaSha1,        /**< SHA-1 */
+  cryptoDmaSha256       /**< SHA-256 */
+} CRYPTO_DmaMode_TypeDef;
+
+struct CRYPTO_DmaTransfer;
+
+/**
+ * @brief
+ *   LDMA transfer completion callback.
+ *
+ * @param[in] transfer  The completed transfer.
+ */
+typedef void (*CRYPTO_DmaCallback_TypeDef)(struct CRYPTO_DmaTransfer *transfer);
+
+/**
+ * @brief
+ *   LDMA transfer context.
+ *
+ * @details
+ *   Fill in the fields marked as set by the caller before starting a
+ *   transfer. The structure holds the LDMA descriptors of the transfer and
+ *   must stay valid until the transfer has completed.
+ */
+typedef struct CRYPTO_DmaTransfer {
+  CRYPTO_TypeDef             *crypto;     /**< CRYPTO instance, set by the caller. */
+  unsigned int               txChannel;   /**< LDMA channel feeding CRYPTO, set by the caller. */
+  unsigned int               rxChannel;   /**< LDMA channel draining CRYPTO, set by the caller. Not used for SHA. */
+  CRYPTO_DmaCallback_TypeDef callback;    /**< Called from CRYPTO_DmaIRQHandler() on completion, or NULL. */
+  void                       *userData;   /**< Caller data, not used by the driver. */
+
+  /** @cond DO_NOT_INCLUDE_WITH_DOXYGEN */
+  CRYPTO_DmaMode_TypeDef     mode;
+  const uint8_t              *in;
+  uint8_t                    *out;
+  uint32_t                   remaining;
+  uint32_t                   tailLen;
+  uint64_t                   msgLen;
+  uint8_t                    *result;
+  volatile bool              done;
+  LDMA_Descriptor_t          txDesc;
+  LDMA_Descriptor_t          rxDesc;
+  /** @endcond */
+} CRYPTO_DmaTransfer_TypeDef;
+#endif /* defined(CRYPTO_LDMA_SUPPORTED) */
+
 /*******************************************************************************
  *****************************   PROTOTYPES   **********************************
  ******************************************************************************/
@@ -1271,6 +1338,86 @@ void CRYPTO_AES_OFB256(CRYPTO_TypeDef *crypto,
                        const uint8_t * key,
                        const uint8_t * iv);
 
+#if defined(CRYPTO_LDMA_SUPPORTED)
+void CRYPTO_AES_CBC_DmaStart(CRYPTO_DmaTransfer_TypeDef *transfer,
+                             uint8_t * out,
+                             const uint8_t * in,
+                             unsigned int len,
+                             const uint8_t * key,
+                             const uint8_t * iv,
+                             bool encrypt,
+                             CRYPTO_KeyWidth_TypeDef keyWidth);
+
+void CRYPTO_AES_PCBC_DmaStart(CRYPTO_DmaTransfer_TypeDef *transfer,
+                              uint8_t * out,
+                              const uint8_t * in,
+                              unsigned int len,
+                              const uint8_t * key,
+                              const uint8_t * iv,
+                              bool encrypt,
+                              CRYPTO_KeyWidth_TypeDef keyWidth);
+
+void CRYPTO_AES_CFB_DmaStart(CRYPTO_DmaTransfer_TypeDef *transfer,
+                             uint8_t * out,
+                             const uint8_t * in,
+                             unsigned int len,
+                             const uint8_t * key,
+                             const uint8_t * iv,
+                             bool encrypt,
+                             CRYPTO_KeyWidth_TypeDef keyWidth);
+
+void CRYPTO_AES_CTR_DmaStart(CRYPTO_DmaTransfer_TypeDef *transfer,
+                             uint8_t * out,
+                             const uint8_t * in,
+                             unsigned int len,
+                             const uint8_t * key,
+                             uint8_t * ctr,
+                             CRYPTO_KeyWidth_TypeDef keyWidth);
+
+void CRYPTO_AES_ECB_DmaStart(CRYPTO_DmaTransfer_TypeDef *transfer,
+                             uint8_t * out,
+                             const uint8_t * in,
+                             unsigned int len,
+                             const uint8_t * key,
+                             bool encrypt,
+                             CRYPTO_KeyWidth_TypeDef keyWidth);
+
+void CRYPTO_AES_OFB_DmaStart(CRYPTO_DmaTransfer_TypeDef *transfer,
+                             uint8_t * out,
+                             const uint8_t * in,
+                             unsigned int len,
+                             const uint8_t * key,
+                             const uint8_t * iv,
+                             CRYPTO_KeyWidth_TypeDef keyWidth);
+
+void CRYPTO_SHA_1_DmaStart(CRYPTO_DmaTransfer_TypeDef *transfer,
+                           const uint8_t              *msg,
+                           uint64_t                   msgLen,
+                           CRYPTO_SHA1_Digest_TypeDef digest);
+
+void CRYPTO_SHA_256_DmaStart(CRYPTO_DmaTransfer_TypeDef   *transfer,
+                             const uint8_t                *msg,
+                             uint64_t                     msgLen,
+                             CRYPTO_SHA256_Digest_TypeDef digest);
+
+bool CRYPTO_DmaIRQHandler(CRYPTO_DmaTransfer_TypeDef *transfer);
+
+/***************************************************************************//**
+ * @brief
+ *   Check whether an LDMA transfer has completed.
+ *
+ * @param[in] transfer
+ *   A pointer to the transfer context.
+ *
+ * @return
+ *   True if the transfer has completed and its results are available.
+ ******************************************************************************/
+__STATIC_INLINE bool CRYPTO_DmaIsDone(const CRYPTO_DmaTransfer_TypeDef *transfer)
+{
+  return transfer->done;
+}
+#endif /* defined(CRYPTO_LDMA_SUPPORTED) */
+
 /***************************************************************************//**
  * @brief
  *   Clear one or more pending CRYPTO interrupts.
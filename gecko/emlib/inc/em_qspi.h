@@ -178,6 +178,31 @@ typedef struct {
   void *   writeBuffer;
 } QSPI_StigCmd_TypeDef;
 
+/** QSPI indirect transfer configuration structure. */
+typedef struct {
+  /**
+   * AHB address used to access the internal SRAM during indirect transfers.
+   * Must be inside the QSPI memory map and outside the area used for direct
+   * access. */
+  uint32_t triggerAddress;
+
+  /** Size of the trigger address range as a power of two, [0-15]. */
+  uint8_t  triggerRangeWidth;
+
+  /**
+   * Number of 4 byte words of the internal SRAM used for indirect reads. The
+   * remaining words are used for indirect writes. */
+  uint8_t  readPartition;
+} QSPI_IndirectConfig_TypeDef;
+
+/** Default configuration for QSPI_IndirectConfig_TypeDef structure. */
+#define QSPI_INDIRECTCONFIG_DEFAULT                                     \
+  {                                                                     \
+    QSPI0_MEM_END + 1 - 16, /* Last 16 bytes of the QSPI memory map. */ \
+    4,                      /* 16 byte trigger range. */                \
+    128,                    /* Half of the SRAM for indirect reads. */  \
+  }
+
 /** QSPI initialization structure. */
 typedef struct {
   /** Enable/disable Quad SPI when initialization is completed. */
@@ -204,6 +229,10 @@ void QSPI_Init(QSPI_TypeDef * qspi, const QSPI_Init_TypeDef * init);
 void QSPI_ReadConfig(QSPI_TypeDef * qspi, const QSPI_ReadConfig_TypeDef * config);
 void QSPI_WriteConfig(QSPI_TypeDef * qspi, const QSPI_WriteConfig_TypeDef * config);
 void QSPI_ExecStigCmd(QSPI_TypeDef * qspi, const QSPI_StigCmd_TypeDef * stigCmd);
+void QSPI_IndirectConfig(QSPI_TypeDef * qspi, const QSPI_IndirectConfig_TypeDef * config);
+void QSPI_IndirectReadStart(QSPI_TypeDef * qspi, uint32_t address, uint32_t size);
+void QSPI_IndirectWriteStart(QSPI_TypeDef * qspi, uint32_t address, uint32_t size);
+void QSPI_IndirectCancel(QSPI_TypeDef * qspi);
 
 /***************************************************************************//**
  * @brief
@@ -252,6 +281,36 @@ __STATIC_INLINE uint16_t QSPI_GetReadLevel(QSPI_TypeDef * qspi)
          >> _QSPI_SRAMFILL_SRAMFILLINDACREAD_SHIFT;
 }
 
+/***************************************************************************//**
+ * @brief
+ *   Check if the last indirect read has completed.
+ *
+ * @param[in] qspi
+ *   Pointer to QSPI peripheral register block.
+ *
+ * @return
+ *   true when all bytes of the indirect read have been moved out of the SRAM.
+ ******************************************************************************/
+__STATIC_INLINE bool QSPI_IndirectReadDone(QSPI_TypeDef * qspi)
+{
+  return (qspi->INDIRECTREADXFERCTRL & QSPI_INDIRECTREADXFERCTRL_INDOPSDONESTATUS) != 0;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Check if the last indirect write has completed.
+ *
+ * @param[in] qspi
+ *   Pointer to QSPI peripheral register block.
+ *
+ * @return
+ *   true when all bytes of the indirect write have been sent to the device.
+ ******************************************************************************/
+__STATIC_INLINE bool QSPI_IndirectWriteDone(QSPI_TypeDef * qspi)
+{
+  return (qspi->INDIRECTWRITEXFERCTRL & QSPI_INDIRECTWRITEXFERCTRL_INDOPSDONESTATUS) != 0;
+}
+
 /***************************************************************************//**
  * @brief
  *   Enable/disable Quad SPI.
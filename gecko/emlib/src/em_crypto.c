@@ -153,6 +153,38 @@ static void CRYPTO_AES_OFBx(CRYPTO_TypeDef *crypto,
                             const uint8_t * iv,
                             CRYPTO_KeyWidth_TypeDef keyWidth);
 
+static void cryptoSha1Init(CRYPTO_TypeDef *crypto);
+
+static void cryptoSha256Init(CRYPTO_TypeDef *crypto);
+
+static void cryptoShaFinal(CRYPTO_TypeDef *crypto,
+                           const uint8_t * msg,
+                           uint32_t len,
+                           uint64_t msgLen);
+
+static void cryptoSha1DigestRead(CRYPTO_TypeDef *crypto,
+                                 CRYPTO_SHA1_Digest_TypeDef msgDigest);
+
+#if defined(CRYPTO_LDMA_SUPPORTED)
+static void cryptoDmaStart(CRYPTO_DmaTransfer_TypeDef *transfer,
+                           CRYPTO_DmaMode_TypeDef mode,
+                           uint8_t * out,
+                           const uint8_t * in,
+                           uint32_t len);
+
+static void cryptoDmaAesInit(CRYPTO_TypeDef *crypto);
+
+static void cryptoDmaShaStart(CRYPTO_DmaTransfer_TypeDef *transfer,
+                              CRYPTO_DmaMode_TypeDef mode,
+                              const uint8_t * msg,
+                              uint64_t msgLen,
+                              uint8_t * msgDigest);
+
+static void cryptoDmaChunkStart(CRYPTO_DmaTransfer_TypeDef *transfer);
+
+static void cryptoDmaComplete(CRYPTO_DmaTransfer_TypeDef *transfer);
+#endif
+
 #ifdef USE_VARIABLE_SIZED_DATA_LOADS
 /***************************************************************************//**
  * @brief
@@ -568,34 +600,9 @@ void CRYPTO_SHA_1(CRYPTO_TypeDef *             crypto,
                   uint64_t                     msgLen,
                   CRYPTO_SHA1_Digest_TypeDef   msgDigest)
 {
-  uint32_t  temp;
   uint32_t  len;
-  int       blockLen;
-  uint32_t  shaBlock[CRYPTO_SHA1_BLOCK_SIZE_IN_32BIT_WORDS];
-  uint8_t * p8ShaBlock = (uint8_t *) shaBlock;
-
-  /* Initialize the CRYPTO module to do SHA-1. */
-  crypto->CTRL     = CRYPTO_CTRL_SHA_SHA1;
-  crypto->SEQCTRL  = 0;
-  crypto->SEQCTRLB = 0;
-
-  /* Set the result width of the MADD32 operation. */
-  CRYPTO_ResultWidthSet(crypto, cryptoResult256Bits);
-
-  /* Write the initialization value to DDATA1.  */
-  crypto->DDATA1 = 0x67452301UL;
-  crypto->DDATA1 = 0xefcdab89UL;
-  crypto->DDATA1 = 0x98badcfeUL;
-  crypto->DDATA1 = 0x10325476UL;
-  crypto->DDATA1 = 0xc3d2e1f0UL;
-  crypto->DDATA1 = 0x00000000UL;
-  crypto->DDATA1 = 0x00000000UL;
-  crypto->DDATA1 = 0x00000000UL;
 
-  /* Copy data to DDATA0 and select DDATA0 and DDATA1 for SHA operation. */
-  CRYPTO_EXECUTE_2(crypto,
-                   CRYPTO_CMD_INSTR_DDATA1TODDATA0,
-                   CRYPTO_CMD_INSTR_SELDDATA0DDATA1);
+  cryptoSha1Init(crypto);
 
   len = (uint32_t)msgLen;
 
@@ -614,80 +621,10 @@ void CRYPTO_SHA_1(CRYPTO_TypeDef *             crypto,
     msg += CRYPTO_SHA1_BLOCK_SIZE_IN_BYTES;
   }
 
-  blockLen = 0;
-
-  /* Build the last (or second to last) block. */
-  for (; len > 0U; len--) {
-    p8ShaBlock[blockLen++] = *msg++;
-  }
-
-  /* Append the '1' bit. */
-  p8ShaBlock[blockLen++] = 0x80;
-
-  /* If the length is currently above 56 bytes, zeros are appended
-   * then compressed.  Then, zeros are padded and length
-   * encoded like normal.
-   */
-  if (blockLen > 56) {
-    while (blockLen < 64) {
-      p8ShaBlock[blockLen++] = 0;
-    }
-
-    /* Write block to QDATA1BIG. */
-    CRYPTO_InstructionSequenceWait(crypto);
-    CRYPTO_QDataWrite(&crypto->QDATA1BIG, shaBlock);
-
-    /* Execute SH. */
-    CRYPTO_EXECUTE_3(crypto,
-                     CRYPTO_CMD_INSTR_SHA,
-                     CRYPTO_CMD_INSTR_MADD32,
-                     CRYPTO_CMD_INSTR_DDATA0TODDATA1);
-    blockLen = 0;
-  }
-
-  /* Pad up to 56 bytes of zeros. */
-  while (blockLen < 56) {
-    p8ShaBlock[blockLen++] = 0;
-  }
-
-  /* Finally, encode the message length. */
-  {
-    uint64_t msgLenInBits = msgLen << 3U;
-    temp = (uint32_t)(msgLenInBits >> 32U);
-    *(uint32_t*)&p8ShaBlock[56] = SWAP32(temp);
-    temp = (uint32_t)msgLenInBits & 0xFFFFFFFFUL;
-    *(uint32_t*)&p8ShaBlock[60] = SWAP32(temp);
-  }
-
-  /* Write block to QDATA1BIG. */
-  CRYPTO_InstructionSequenceWait(crypto);
-  CRYPTO_QDataWrite(&crypto->QDATA1BIG, shaBlock);
-
-  /* Execute SHA. */
-  CRYPTO_EXECUTE_3(crypto,
-                   CRYPTO_CMD_INSTR_SHA,
-                   CRYPTO_CMD_INSTR_MADD32,
-                   CRYPTO_CMD_INSTR_DDATA0TODDATA1);
-
-  /* Read the resulting message digest from DDATA0BIG.  */
-  CRYPTO_InstructionSequenceWait(crypto);
+  /* Pad and hash the last (one or two) blocks. */
+  cryptoShaFinal(crypto, msg, len, msgLen);
 
-  /* Check if the buffer pointer is 32-bit aligned, if not read the data into a
-     temporary 32-bit aligned buffer then copy the data to the output buffer.*/
-  if ((uintptr_t)msgDigest & 0x3) {
-    CRYPTO_DData_TypeDef tempDData;
-    CRYPTO_DDataRead(&crypto->DDATA0BIG, tempDData);
-    memcpy(msgDigest, tempDData, sizeof(CRYPTO_SHA1_Digest_TypeDef));
-  } else {
-    ((uint32_t*)msgDigest)[0] = crypto->DDATA0BIG;
-    ((uint32_t*)msgDigest)[1] = crypto->DDATA0BIG;
-    ((uint32_t*)msgDigest)[2] = crypto->DDATA0BIG;
-    ((uint32_t*)msgDigest)[3] = crypto->DDATA0BIG;
-    ((uint32_t*)msgDigest)[4] = crypto->DDATA0BIG;
-    crypto->DDATA0BIG;
-    crypto->DDATA0BIG;
-    crypto->DDATA0BIG;
-  }
+  cryptoSha1DigestRead(crypto, msgDigest);
 }
 
 /***************************************************************************//**
@@ -715,37 +652,10 @@ void CRYPTO_SHA_256(CRYPTO_TypeDef *             crypto,
                     uint64_t                     msgLen,
                     CRYPTO_SHA256_Digest_TypeDef msgDigest)
 {
-  uint32_t  temp;
   uint32_t  len;
-  int       blockLen;
-  uint32_t  shaBlock[CRYPTO_SHA256_BLOCK_SIZE_IN_32BIT_WORDS];
-  uint8_t * p8ShaBlock = (uint8_t *) shaBlock;
-
-  /* Initial values */
-  shaBlock[0] = 0x6a09e667UL;
-  shaBlock[1] = 0xbb67ae85UL;
-  shaBlock[2] = 0x3c6ef372UL;
-  shaBlock[3] = 0xa54ff53aUL;
-  shaBlock[4] = 0x510e527fUL;
-  shaBlock[5] = 0x9b05688cUL;
-  shaBlock[6] = 0x1f83d9abUL;
-  shaBlock[7] = 0x5be0cd19UL;
 
-  /* Initialize the CRYPTO module to do SHA-256 (SHA-2). */
-  crypto->CTRL     = CRYPTO_CTRL_SHA_SHA2;
-  crypto->SEQCTRL  = 0;
-  crypto->SEQCTRLB = 0;
-
-  /* Set the result width of the MADD32 operation. */
-  CRYPTO_ResultWidthSet(crypto, cryptoResult256Bits);
-
-  /* Write the initialization value to DDATA1.  */
-  CRYPTO_DDataWrite(&crypto->DDATA1, shaBlock);
+  cryptoSha256Init(crypto);
 
-  /* Copy data ot DDATA0 and select DDATA0 and DDATA1 for SHA operation. */
-  CRYPTO_EXECUTE_2(crypto,
-                   CRYPTO_CMD_INSTR_DDATA1TODDATA0,
-                   CRYPTO_CMD_INSTR_SELDDATA0DDATA1);
   len = (uint32_t)msgLen;
 
   while (len >= CRYPTO_SHA256_BLOCK_SIZE_IN_BYTES) {
@@ -763,63 +673,10 @@ void CRYPTO_SHA_256(CRYPTO_TypeDef *             crypto,
     msg += CRYPTO_SHA256_BLOCK_SIZE_IN_BYTES;
   }
 
-  blockLen = 0;
-
-  /* Build the last (or second to last) block. */
-  for (; len > 0U; len--) {
-    p8ShaBlock[blockLen++] = *msg++;
-  }
-
-  /* Append the '1' bit. */
-  p8ShaBlock[blockLen++] = 0x80;
-
-  /* If the length is currently above 56 bytes, zeros are appended
-   * then compressed.  Then, zeros are padded and length
-   * encoded like normal.
-   */
-  if (blockLen > 56) {
-    while (blockLen < 64) {
-      p8ShaBlock[blockLen++] = 0;
-    }
-
-    /* Write block to QDATA1BIG. */
-    CRYPTO_InstructionSequenceWait(crypto);
-    CRYPTO_QDataWrite(&crypto->QDATA1BIG, shaBlock);
-
-    /* Execute SHA. */
-    CRYPTO_EXECUTE_3(crypto,
-                     CRYPTO_CMD_INSTR_SHA,
-                     CRYPTO_CMD_INSTR_MADD32,
-                     CRYPTO_CMD_INSTR_DDATA0TODDATA1);
-    blockLen = 0;
-  }
-
-  /* Pad up to 56 bytes of zeros. */
-  while (blockLen < 56) {
-    p8ShaBlock[blockLen++] = 0;
-  }
-
-  /* Finally, encode the message length. */
-  {
-    uint64_t msgLenInBits = msgLen << 3;
-    temp = (uint32_t)(msgLenInBits >> 32);
-    *(uint32_t *)&p8ShaBlock[56] = SWAP32(temp);
-    temp = (uint32_t)msgLenInBits & 0xFFFFFFFFUL;
-    *(uint32_t *)&p8ShaBlock[60] = SWAP32(temp);
-  }
-
-  /* Write the final block to QDATA1BIG. */
-  CRYPTO_InstructionSequenceWait(crypto);
-  CRYPTO_QDataWrite(&crypto->QDATA1BIG, shaBlock);
-
-  /* Execute SHA. */
-  CRYPTO_EXECUTE_3(crypto,
-                   CRYPTO_CMD_INSTR_SHA,
-                   CRYPTO_CMD_INSTR_MADD32,
-                   CRYPTO_CMD_INSTR_DDATA0TODDATA1);
+  /* Pad and hash the last (one or two) blocks. */
+  cryptoShaFinal(crypto, msg, len, msgLen);
 
   /* Read the resulting message digest from DDATA0BIG.  */
-  CRYPTO_InstructionSequenceWait(crypto);
   CRYPTO_DDataReadUnaligned(&crypto->DDATA0BIG, msgDigest);
 }
 
@@ -1860,36 +1717,37 @@ void CRYPTO_AES_OFB256(CRYPTO_TypeDef *  crypto,
   CRYPTO_AES_OFBx(crypto, out, in, len, key, iv, cryptoKey256Bits);
 }
 
-/*******************************************************************************
- **************************   LOCAL FUNCTIONS   *******************************
- ******************************************************************************/
-
+#if defined(CRYPTO_LDMA_SUPPORTED)
 /***************************************************************************//**
  * @brief
- *   Cipher-block chaining (CBC) cipher mode encryption/decryption, 128/256 bit key.
+ *   Start an LDMA driven Cipher-block chaining (CBC) encryption/decryption.
  *
  * @details
- *   See CRYPTO_AES_CBC128() for CBC figure.
+ *   The CRYPTO instruction sequence is run once per block while the LDMA
+ *   moves data in and out of the CRYPTO data registers, so the core is free
+ *   (or can sleep in EM1) until the transfer completes. Completion is
+ *   signaled through the LDMA channel interrupt of @p transfer->rxChannel;
+ *   call CRYPTO_DmaIRQHandler() from the LDMA interrupt handler.
  *
- *   See general comments on layout and byte ordering of parameters.
+ *   The CRYPTO instance must not be used for anything else until the transfer
+ *   has completed.
  *
- * @param[in]  crypto
- *   A pointer to the CRYPTO peripheral register block.
+ *   See CRYPTO_AES_CBC128() for a description of the mode and parameters.
+ *
+ * @param[in,out] transfer
+ *   Transfer context with crypto, txChannel, rxChannel and callback set.
  *
  * @param[out] out
- *   A buffer to place encrypted/decrypted data. Must be at least @p len long. It
- *   may be set equal to @p in, in which case the input buffer is overwritten.
+ *   A buffer to place encrypted/decrypted data. Must be 32-bit aligned.
  *
  * @param[in] in
- *   A buffer holding data to encrypt/decrypt. Must be at least @p len long.
+ *   A buffer holding data to encrypt/decrypt. Must be 32-bit aligned.
  *
  * @param[in] len
  *   A number of bytes to encrypt/decrypt. Must be a multiple of 16.
  *
  * @param[in] key
- *   When encrypting, this is the 256 bit encryption key. When
- *   decrypting, this is the 256 bit decryption key. The decryption key may
- *   be generated from the encryption key with CRYPTO_AES_DecryptKey256().
+ *   An encryption key when encrypting, a decryption key when decrypting.
  *
  * @param[in] iv
  *   128 bit initialization vector to use.
@@ -1900,83 +1758,464 @@ void CRYPTO_AES_OFB256(CRYPTO_TypeDef *  crypto,
  * @param[in] keyWidth
  *   Set to cryptoKey128Bits or cryptoKey256Bits.
  ******************************************************************************/
-static void CRYPTO_AES_CBCx(CRYPTO_TypeDef *  crypto,
-                            uint8_t *         out,
-                            const uint8_t *   in,
-                            unsigned int      len,
-                            const uint8_t *   key,
-                            const uint8_t *   iv,
-                            bool              encrypt,
-                            CRYPTO_KeyWidth_TypeDef keyWidth)
+void CRYPTO_AES_CBC_DmaStart(CRYPTO_DmaTransfer_TypeDef *transfer,
+                             uint8_t * out,
+                             const uint8_t * in,
+                             unsigned int len,
+                             const uint8_t * key,
+                             const uint8_t * iv,
+                             bool encrypt,
+                             CRYPTO_KeyWidth_TypeDef keyWidth)
 {
-  EFM_ASSERT((len % CRYPTO_AES_BLOCKSIZE) == 0U);
-
-  /* Initialize control registers. */
-  crypto->WAC = 0;
+  CRYPTO_TypeDef *crypto = transfer->crypto;
 
+  cryptoDmaAesInit(crypto);
   CRYPTO_KeyBufWriteUnaligned(crypto, key, keyWidth);
 
   if (encrypt) {
     CRYPTO_DataWriteUnaligned(&crypto->DATA0, iv);
 
-    CRYPTO_SEQ_LOAD_2(crypto,
+    CRYPTO_SEQ_LOAD_4(crypto,
+                      CRYPTO_CMD_INSTR_DMA1TODATA,
                       CRYPTO_CMD_INSTR_DATA1TODATA0XOR,
-                      CRYPTO_CMD_INSTR_AESENC);
+                      CRYPTO_CMD_INSTR_AESENC,
+                      CRYPTO_CMD_INSTR_DATATODMA0);
   } else {
     CRYPTO_DataWriteUnaligned(&crypto->DATA2, iv);
 
-    CRYPTO_SEQ_LOAD_4(crypto,
+    CRYPTO_SEQ_LOAD_6(crypto,
+                      CRYPTO_CMD_INSTR_DMA1TODATA,
                       CRYPTO_CMD_INSTR_DATA1TODATA0,
                       CRYPTO_CMD_INSTR_AESDEC,
                       CRYPTO_CMD_INSTR_DATA2TODATA0XOR,
-                      CRYPTO_CMD_INSTR_DATA1TODATA2);
+                      CRYPTO_CMD_INSTR_DATA1TODATA2,
+                      CRYPTO_CMD_INSTR_DATATODMA0);
   }
 
-  CRYPTO_AES_ProcessLoop(crypto, len,
-                         &crypto->DATA1, in,
-                         &crypto->DATA0, out);
+  cryptoDmaStart(transfer, cryptoDmaAesCbc, out, in, len);
 }
 
 /***************************************************************************//**
  * @brief
- *   Propagating cipher-block chaining (PCBC) cipher mode encryption/decryption, 128/256 bit key.
+ *   Start an LDMA driven Propagating cipher-block chaining (PCBC)
+ *   encryption/decryption.
  *
  * @details
- *   See CRYPTO_AES_PCBC128() for PCBC figure.
- *
- *   See general comments on layout and byte ordering of parameters.
- *
- * @param[in]  crypto
- *   A pointer to the CRYPTO peripheral register block.
- *
- * @param[out] out
- *   A buffer to place encrypted/decrypted data. Must be at least @p len long. It
- *   may be set equal to @p in, in which case the input buffer is overwritten.
- *
- * @param[in] in
- *   A buffer holding data to encrypt/decrypt. Must be at least @p len long.
- *
- * @param[in] len
- *   A number of bytes to encrypt/decrypt. Must be a multiple of 16.
- *
- * @param[in] key
- *   When encrypting, this is the 256 bit encryption key. When
- *   decrypting, this is the 256 bit decryption key. The decryption key may
- *   be generated from the encryption key with CRYPTO_AES_DecryptKey256().
- *
- * @param[in] iv
- *   128 bit initialization vector to use.
- *
- * @param[in] encrypt
- *   Set to true to encrypt, false to decrypt.
- *
- * @param[in] keyWidth
- *   Set to cryptoKey128Bits or cryptoKey256Bits.
+ *   See CRYPTO_AES_CBC_DmaStart() for LDMA operation and CRYPTO_AES_PCBC128()
+ *   for a description of the mode. Parameters are as for
+ *   CRYPTO_AES_CBC_DmaStart().
  ******************************************************************************/
-static void CRYPTO_AES_PCBCx(CRYPTO_TypeDef * crypto,
-                             uint8_t *         out,
-                             const uint8_t *   in,
-                             unsigned int      len,
+void CRYPTO_AES_PCBC_DmaStart(CRYPTO_DmaTransfer_TypeDef *transfer,
+                              uint8_t * out,
+                              const uint8_t * in,
+                              unsigned int len,
+                              const uint8_t * key,
+                              const uint8_t * iv,
+                              bool encrypt,
+                              CRYPTO_KeyWidth_TypeDef keyWidth)
+{
+  CRYPTO_TypeDef *crypto = transfer->crypto;
+
+  cryptoDmaAesInit(crypto);
+  CRYPTO_KeyBufWriteUnaligned(crypto, key, keyWidth);
+  CRYPTO_DataWriteUnaligned(&crypto->DATA0, iv);
+
+  /* The result is copied from DATA2 to DATA1 once the input in DATA1 has
+     been consumed, since only DATA0 and DATA1 can be read by the LDMA. */
+  if (encrypt) {
+    CRYPTO_SEQ_LOAD_7(crypto,
+                      CRYPTO_CMD_INSTR_DMA1TODATA,
+                      CRYPTO_CMD_INSTR_DATA1TODATA0XOR,
+                      CRYPTO_CMD_INSTR_AESENC,
+                      CRYPTO_CMD_INSTR_DATA0TODATA2,
+                      CRYPTO_CMD_INSTR_DATA1TODATA0XOR,
+                      CRYPTO_CMD_INSTR_DATA2TODATA1,
+                      CRYPTO_CMD_INSTR_DATATODMA1);
+  } else {
+    CRYPTO_SEQ_LOAD_9(crypto,
+                      CRYPTO_CMD_INSTR_DMA1TODATA,
+                      CRYPTO_CMD_INSTR_DATA0TODATA3,
+                      CRYPTO_CMD_INSTR_DATA1TODATA0,
+                      CRYPTO_CMD_INSTR_AESDEC,
+                      CRYPTO_CMD_INSTR_DATA3TODATA0XOR,
+                      CRYPTO_CMD_INSTR_DATA0TODATA2,
+                      CRYPTO_CMD_INSTR_DATA1TODATA0XOR,
+                      CRYPTO_CMD_INSTR_DATA2TODATA1,
+                      CRYPTO_CMD_INSTR_DATATODMA1);
+  }
+
+  cryptoDmaStart(transfer, cryptoDmaAesPcbc, out, in, len);
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Start an LDMA driven Cipher feedback (CFB) encryption/decryption.
+ *
+ * @details
+ *   See CRYPTO_AES_CBC_DmaStart() for LDMA operation and CRYPTO_AES_CFB128()
+ *   for a description of the mode. Parameters are as for
+ *   CRYPTO_AES_CBC_DmaStart(), except that @p key is always the encryption
+ *   key.
+ ******************************************************************************/
+void CRYPTO_AES_CFB_DmaStart(CRYPTO_DmaTransfer_TypeDef *transfer,
+                             uint8_t * out,
+                             const uint8_t * in,
+                             unsigned int len,
+                             const uint8_t * key,
+                             const uint8_t * iv,
+                             bool encrypt,
+                             CRYPTO_KeyWidth_TypeDef keyWidth)
+{
+  CRYPTO_TypeDef *crypto = transfer->crypto;
+
+  cryptoDmaAesInit(crypto);
+  CRYPTO_KeyBufWriteUnaligned(crypto, key, keyWidth);
+
+  if (encrypt) {
+    CRYPTO_DataWriteUnaligned(&crypto->DATA0, iv);
+
+    CRYPTO_SEQ_LOAD_4(crypto,
+                      CRYPTO_CMD_INSTR_DMA1TODATA,
+                      CRYPTO_CMD_INSTR_AESENC,
+                      CRYPTO_CMD_INSTR_DATA1TODATA0XOR,
+                      CRYPTO_CMD_INSTR_DATATODMA0);
+  } else {
+    CRYPTO_DataWriteUnaligned(&crypto->DATA2, iv);
+
+    CRYPTO_SEQ_LOAD_6(crypto,
+                      CRYPTO_CMD_INSTR_DMA1TODATA,
+                      CRYPTO_CMD_INSTR_DATA2TODATA0,
+                      CRYPTO_CMD_INSTR_AESENC,
+                      CRYPTO_CMD_INSTR_DATA1TODATA0XOR,
+                      CRYPTO_CMD_INSTR_DATA1TODATA2,
+                      CRYPTO_CMD_INSTR_DATATODMA0);
+  }
+
+  cryptoDmaStart(transfer, cryptoDmaAesCfb, out, in, len);
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Start an LDMA driven Counter (CTR) encryption/decryption.
+ *
+ * @details
+ *   See CRYPTO_AES_CBC_DmaStart() for LDMA operation and CRYPTO_AES_CTR128()
+ *   for a description of the mode. The updated counter is written back to
+ *   @p ctr when the transfer completes, so @p ctr must stay valid until then.
+ *   Other parameters are as for CRYPTO_AES_CBC_DmaStart().
+ ******************************************************************************/
+void CRYPTO_AES_CTR_DmaStart(CRYPTO_DmaTransfer_TypeDef *transfer,
+                             uint8_t * out,
+                             const uint8_t * in,
+                             unsigned int len,
+                             const uint8_t * key,
+                             uint8_t * ctr,
+                             CRYPTO_KeyWidth_TypeDef keyWidth)
+{
+  CRYPTO_TypeDef *crypto = transfer->crypto;
+
+  cryptoDmaAesInit(crypto);
+  crypto->CTRL |= CRYPTO_CTRL_INCWIDTH_INCWIDTH4;
+  CRYPTO_KeyBufWriteUnaligned(crypto, key, keyWidth);
+  CRYPTO_DataWriteUnaligned(&crypto->DATA1, ctr);
+
+  /* Input arrives in DATA0 and is parked in DATA2 while the counter is
+     encrypted. */
+  CRYPTO_SEQ_LOAD_7(crypto,
+                    CRYPTO_CMD_INSTR_DMA0TODATA,
+                    CRYPTO_CMD_INSTR_DATA0TODATA2,
+                    CRYPTO_CMD_INSTR_DATA1TODATA0,
+                    CRYPTO_CMD_INSTR_AESENC,
+                    CRYPTO_CMD_INSTR_DATA1INC,
+                    CRYPTO_CMD_INSTR_DATA2TODATA0XOR,
+                    CRYPTO_CMD_INSTR_DATATODMA0);
+
+  transfer->result = ctr;
+  cryptoDmaStart(transfer, cryptoDmaAesCtr, out, in, len);
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Start an LDMA driven Electronic Codebook (ECB) encryption/decryption.
+ *
+ * @details
+ *   See CRYPTO_AES_CBC_DmaStart() for LDMA operation and CRYPTO_AES_ECB128()
+ *   for a description of the mode. Parameters are as for
+ *   CRYPTO_AES_CBC_DmaStart().
+ ******************************************************************************/
+void CRYPTO_AES_ECB_DmaStart(CRYPTO_DmaTransfer_TypeDef *transfer,
+                             uint8_t * out,
+                             const uint8_t * in,
+                             unsigned int len,
+                             const uint8_t * key,
+                             bool encrypt,
+                             CRYPTO_KeyWidth_TypeDef keyWidth)
+{
+  CRYPTO_TypeDef *crypto = transfer->crypto;
+
+  cryptoDmaAesInit(crypto);
+  CRYPTO_KeyBufWriteUnaligned(crypto, key, keyWidth);
+
+  if (encrypt) {
+    CRYPTO_SEQ_LOAD_3(crypto,
+                      CRYPTO_CMD_INSTR_DMA0TODATA,
+                      CRYPTO_CMD_INSTR_AESENC,
+                      CRYPTO_CMD_INSTR_DATATODMA0);
+  } else {
+    CRYPTO_SEQ_LOAD_3(crypto,
+                      CRYPTO_CMD_INSTR_DMA0TODATA,
+                      CRYPTO_CMD_INSTR_AESDEC,
+                      CRYPTO_CMD_INSTR_DATATODMA0);
+  }
+
+  cryptoDmaStart(transfer, cryptoDmaAesEcb, out, in, len);
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Start an LDMA driven Output feedback (OFB) encryption/decryption.
+ *
+ * @details
+ *   See CRYPTO_AES_CBC_DmaStart() for LDMA operation and CRYPTO_AES_OFB128()
+ *   for a description of the mode. Parameters are as for
+ *   CRYPTO_AES_CBC_DmaStart(), except that @p key is always the encryption
+ *   key.
+ ******************************************************************************/
+void CRYPTO_AES_OFB_DmaStart(CRYPTO_DmaTransfer_TypeDef *transfer,
+                             uint8_t * out,
+                             const uint8_t * in,
+                             unsigned int len,
+                             const uint8_t * key,
+                             const uint8_t * iv,
+                             CRYPTO_KeyWidth_TypeDef keyWidth)
+{
+  CRYPTO_TypeDef *crypto = transfer->crypto;
+
+  cryptoDmaAesInit(crypto);
+  CRYPTO_KeyBufWriteUnaligned(crypto, key, keyWidth);
+  CRYPTO_DataWriteUnaligned(&crypto->DATA2, iv);
+
+  CRYPTO_SEQ_LOAD_7(crypto,
+                    CRYPTO_CMD_INSTR_DMA0TODATA,
+                    CRYPTO_CMD_INSTR_DATA0TODATA1,
+                    CRYPTO_CMD_INSTR_DATA2TODATA0,
+                    CRYPTO_CMD_INSTR_AESENC,
+                    CRYPTO_CMD_INSTR_DATA0TODATA2,
+                    CRYPTO_CMD_INSTR_DATA1TODATA0XOR,
+                    CRYPTO_CMD_INSTR_DATATODMA0);
+
+  cryptoDmaStart(transfer, cryptoDmaAesOfb, out, in, len);
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Start an LDMA driven SHA-1 hash operation on a message.
+ *
+ * @details
+ *   All complete 64 byte blocks of the message are fed to CRYPTO by the LDMA.
+ *   Padding and the last block are processed by CRYPTO_DmaIRQHandler() when
+ *   the LDMA transfer on @p transfer->txChannel completes. Messages shorter
+ *   than one block are hashed immediately, and the callback is invoked before
+ *   this function returns.
+ *
+ * @param[in,out] transfer
+ *   Transfer context with crypto, txChannel and callback set.
+ *
+ * @param[in]  msg
+ *   Message to hash. Must be 32-bit aligned.
+ *
+ * @param[in]  msgLen
+ *   Length of message in bytes.
+ *
+ * @param[out] msgDigest
+ *   A message digest. Written when the transfer completes.
+ ******************************************************************************/
+void CRYPTO_SHA_1_DmaStart(CRYPTO_DmaTransfer_TypeDef *transfer,
+                           const uint8_t              *msg,
+                           uint64_t                   msgLen,
+                           CRYPTO_SHA1_Digest_TypeDef msgDigest)
+{
+  cryptoSha1Init(transfer->crypto);
+  cryptoDmaShaStart(transfer, cryptoDmaSha1, msg, msgLen, msgDigest);
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Start an LDMA driven SHA-256 hash operation on a message.
+ *
+ * @details
+ *   See CRYPTO_SHA_1_DmaStart().
+ ******************************************************************************/
+void CRYPTO_SHA_256_DmaStart(CRYPTO_DmaTransfer_TypeDef   *transfer,
+                             const uint8_t                *msg,
+                             uint64_t                     msgLen,
+                             CRYPTO_SHA256_Digest_TypeDef msgDigest)
+{
+  cryptoSha256Init(transfer->crypto);
+  cryptoDmaShaStart(transfer, cryptoDmaSha256, msg, msgLen, msgDigest);
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Process LDMA completion for a CRYPTO transfer.
+ *
+ * @details
+ *   Call this from the LDMA interrupt handler for every transfer in progress.
+ *   It checks and clears the interrupt flag of the channel completing the
+ *   transfer. Buffers longer than CRYPTO_DMA_CHUNK_SIZE_IN_BYTES are
+ *   processed in several chunks, and the next chunk is started from here.
+ *   When the last chunk is done, the transfer is finalized (the counter is
+ *   written back for CTR, the hash is padded and the digest is read for SHA)
+ *   and the callback is invoked.
+ *
+ * @param[in,out] transfer
+ *   A pointer to the transfer context.
+ *
+ * @return
+ *   True if the transfer completed during this call.
+ ******************************************************************************/
+bool CRYPTO_DmaIRQHandler(CRYPTO_DmaTransfer_TypeDef *transfer)
+{
+  CRYPTO_TypeDef *crypto = transfer->crypto;
+  bool isSha = (transfer->mode == cryptoDmaSha1)
+               || (transfer->mode == cryptoDmaSha256);
+  uint32_t chMask = 1UL << (isSha ? transfer->txChannel : transfer->rxChannel);
+
+  if (transfer->done || ((LDMA_IntGet() & chMask) == 0UL)) {
+    return false;
+  }
+  LDMA_IntClear(chMask);
+
+  /* The last data block may still be in the sequencer. */
+  CRYPTO_InstructionSequenceWait(crypto);
+
+  if (transfer->remaining > 0UL) {
+    cryptoDmaChunkStart(transfer);
+    return false;
+  }
+
+  cryptoDmaComplete(transfer);
+  return true;
+}
+#endif /* defined(CRYPTO_LDMA_SUPPORTED) */
+
+/*******************************************************************************
+ **************************   LOCAL FUNCTIONS   *******************************
+ ******************************************************************************/
+
+/***************************************************************************//**
+ * @brief
+ *   Cipher-block chaining (CBC) cipher mode encryption/decryption, 128/256 bit key.
+ *
+ * @details
+ *   See CRYPTO_AES_CBC128() for CBC figure.
+ *
+ *   See general comments on layout and byte ordering of parameters.
+ *
+ * @param[in]  crypto
+ *   A pointer to the CRYPTO peripheral register block.
+ *
+ * @param[out] out
+ *   A buffer to place encrypted/decrypted data. Must be at least @p len long. It
+ *   may be set equal to @p in, in which case the input buffer is overwritten.
+ *
+ * @param[in] in
+ *   A buffer holding data to encrypt/decrypt. Must be at least @p len long.
+ *
+ * @param[in] len
+ *   A number of bytes to encrypt/decrypt. Must be a multiple of 16.
+ *
+ * @param[in] key
+ *   When encrypting, this is the 256 bit encryption key. When
+ *   decrypting, this is the 256 bit decryption key. The decryption key may
+ *   be generated from the encryption key with CRYPTO_AES_DecryptKey256().
+ *
+ * @param[in] iv
+ *   128 bit initialization vector to use.
+ *
+ * @param[in] encrypt
+ *   Set to true to encrypt, false to decrypt.
+ *
+ * @param[in] keyWidth
+ *   Set to cryptoKey128Bits or cryptoKey256Bits.
+ ******************************************************************************/
+static void CRYPTO_AES_CBCx(CRYPTO_TypeDef *  crypto,
+                            uint8_t *         out,
+                            const uint8_t *   in,
+                            unsigned int      len,
+                            const uint8_t *   key,
+                            const uint8_t *   iv,
+                            bool              encrypt,
+                            CRYPTO_KeyWidth_TypeDef keyWidth)
+{
+  EFM_ASSERT((len % CRYPTO_AES_BLOCKSIZE) == 0U);
+
+  /* Initialize control registers. */
+  crypto->WAC = 0;
+
+  CRYPTO_KeyBufWriteUnaligned(crypto, key, keyWidth);
+
+  if (encrypt) {
+    CRYPTO_DataWriteUnaligned(&crypto->DATA0, iv);
+
+    CRYPTO_SEQ_LOAD_2(crypto,
+                      CRYPTO_CMD_INSTR_DATA1TODATA0XOR,
+                      CRYPTO_CMD_INSTR_AESENC);
+  } else {
+    CRYPTO_DataWriteUnaligned(&crypto->DATA2, iv);
+
+    CRYPTO_SEQ_LOAD_4(crypto,
+                      CRYPTO_CMD_INSTR_DATA1TODATA0,
+                      CRYPTO_CMD_INSTR_AESDEC,
+                      CRYPTO_CMD_INSTR_DATA2TODATA0XOR,
+                      CRYPTO_CMD_INSTR_DATA1TODATA2);
+  }
+
+  CRYPTO_AES_ProcessLoop(crypto, len,
+                         &crypto->DATA1, in,
+                         &crypto->DATA0, out);
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Propagating cipher-block chaining (PCBC) cipher mode encryption/decryption, 128/256 bit key.
+ *
+ * @details
+ *   See CRYPTO_AES_PCBC128() for PCBC figure.
+ *
+ *   See general comments on layout and byte ordering of parameters.
+ *
+ * @param[in]  crypto
+ *   A pointer to the CRYPTO peripheral register block.
+ *
+ * @param[out] out
+ *   A buffer to place encrypted/decrypted data. Must be at least @p len long. It
+ *   may be set equal to @p in, in which case the input buffer is overwritten.
+ *
+ * @param[in] in
+ *   A buffer holding data to encrypt/decrypt. Must be at least @p len long.
+ *
+ * @param[in] len
+ *   A number of bytes to encrypt/decrypt. Must be a multiple of 16.
+ *
+ * @param[in] key
+ *   When encrypting, this is the 256 bit encryption key. When
+ *   decrypting, this is the 256 bit decryption key. The decryption key may
+ *   be generated from the encryption key with CRYPTO_AES_DecryptKey256().
+ *
+ * @param[in] iv
+ *   128 bit initialization vector to use.
+ *
+ * @param[in] encrypt
+ *   Set to true to encrypt, false to decrypt.
+ *
+ * @param[in] keyWidth
+ *   Set to cryptoKey128Bits or cryptoKey256Bits.
+ ******************************************************************************/
+static void CRYPTO_AES_PCBCx(CRYPTO_TypeDef * crypto,
+                             uint8_t *         out,
+                             const uint8_t *   in,
+                             unsigned int      len,
                              const uint8_t *   key,
                              const uint8_t *   iv,
                              bool              encrypt,
@@ -2367,6 +2606,404 @@ __STATIC_INLINE void CRYPTO_AES_ProcessLoop(CRYPTO_TypeDef *        crypto,
   }
 }
 
+/***************************************************************************//**
+ * @brief
+ *   Initialize the CRYPTO module for SHA-1 and load the initial hash value.
+ *
+ * @param[in]  crypto
+ *   A pointer to the CRYPTO peripheral register block.
+ ******************************************************************************/
+static void cryptoSha1Init(CRYPTO_TypeDef *crypto)
+{
+  /* Initialize the CRYPTO module to do SHA-1. */
+  crypto->CTRL     = CRYPTO_CTRL_SHA_SHA1;
+  crypto->SEQCTRL  = 0;
+  crypto->SEQCTRLB = 0;
+
+  /* Set the result width of the MADD32 operation. */
+  CRYPTO_ResultWidthSet(crypto, cryptoResult256Bits);
+
+  /* Write the initialization value to DDATA1.  */
+  crypto->DDATA1 = 0x67452301UL;
+  crypto->DDATA1 = 0xefcdab89UL;
+  crypto->DDATA1 = 0x98badcfeUL;
+  crypto->DDATA1 = 0x10325476UL;
+  crypto->DDATA1 = 0xc3d2e1f0UL;
+  crypto->DDATA1 = 0x00000000UL;
+  crypto->DDATA1 = 0x00000000UL;
+  crypto->DDATA1 = 0x00000000UL;
+
+  /* Copy data to DDATA0 and select DDATA0 and DDATA1 for SHA operation. */
+  CRYPTO_EXECUTE_2(crypto,
+                   CRYPTO_CMD_INSTR_DDATA1TODDATA0,
+                   CRYPTO_CMD_INSTR_SELDDATA0DDATA1);
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Initialize the CRYPTO module for SHA-256 and load the initial hash value.
+ *
+ * @param[in]  crypto
+ *   A pointer to the CRYPTO peripheral register block.
+ ******************************************************************************/
+static void cryptoSha256Init(CRYPTO_TypeDef *crypto)
+{
+  /* Initial values */
+  static const uint32_t sha256Init[CRYPTO_DDATA_SIZE_IN_32BIT_WORDS] = {
+    0x6a09e667UL, 0xbb67ae85UL, 0x3c6ef372UL, 0xa54ff53aUL,
+    0x510e527fUL, 0x9b05688cUL, 0x1f83d9abUL, 0x5be0cd19UL
+  };
+
+  /* Initialize the CRYPTO module to do SHA-256 (SHA-2). */
+  crypto->CTRL     = CRYPTO_CTRL_SHA_SHA2;
+  crypto->SEQCTRL  = 0;
+  crypto->SEQCTRLB = 0;
+
+  /* Set the result width of the MADD32 operation. */
+  CRYPTO_ResultWidthSet(crypto, cryptoResult256Bits);
+
+  /* Write the initialization value to DDATA1.  */
+  CRYPTO_DDataWrite(&crypto->DDATA1, sha256Init);
+
+  /* Copy data ot DDATA0 and select DDATA0 and DDATA1 for SHA operation. */
+  CRYPTO_EXECUTE_2(crypto,
+                   CRYPTO_CMD_INSTR_DDATA1TODDATA0,
+                   CRYPTO_CMD_INSTR_SELDDATA0DDATA1);
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Pad the remainder of a SHA-1/SHA-256 message and hash the last block(s).
+ *
+ * @details
+ *   On return, the message digest is available in DDATA0BIG.
+ *
+ * @param[in]  crypto
+ *   A pointer to the CRYPTO peripheral register block.
+ *
+ * @param[in]  msg
+ *   The part of the message that does not fill a complete block.
+ *
+ * @param[in]  len
+ *   The length of @p msg in bytes. Must be less than 64.
+ *
+ * @param[in]  msgLen
+ *   The length of the whole message in bytes.
+ ******************************************************************************/
+static void cryptoShaFinal(CRYPTO_TypeDef *crypto,
+                           const uint8_t * msg,
+                           uint32_t len,
+                           uint64_t msgLen)
+{
+  uint32_t  temp;
+  int       blockLen;
+  uint32_t  shaBlock[CRYPTO_SHA256_BLOCK_SIZE_IN_32BIT_WORDS];
+  uint8_t * p8ShaBlock = (uint8_t *) shaBlock;
+
+  blockLen = 0;
+
+  /* Build the last (or second to last) block. */
+  for (; len > 0U; len--) {
+    p8ShaBlock[blockLen++] = *msg++;
+  }
+
+  /* Append the '1' bit. */
+  p8ShaBlock[blockLen++] = 0x80;
+
+  /* If the length is currently above 56 bytes, zeros are appended
+   * then compressed.  Then, zeros are padded and length
+   * encoded like normal.
+   */
+  if (blockLen > 56) {
+    while (blockLen < 64) {
+      p8ShaBlock[blockLen++] = 0;
+    }
+
+    /* Write block to QDATA1BIG. */
+    CRYPTO_InstructionSequenceWait(crypto);
+    CRYPTO_QDataWrite(&crypto->QDATA1BIG, shaBlock);
+
+    /* Execute SHA. */
+    CRYPTO_EXECUTE_3(crypto,
+                     CRYPTO_CMD_INSTR_SHA,
+                     CRYPTO_CMD_INSTR_MADD32,
+                     CRYPTO_CMD_INSTR_DDATA0TODDATA1);
+    blockLen = 0;
+  }
+
+  /* Pad up to 56 bytes of zeros. */
+  while (blockLen < 56) {
+    p8ShaBlock[blockLen++] = 0;
+  }
+
+  /* Finally, encode the message length. */
+  {
+    uint64_t msgLenInBits = msgLen << 3U;
+    temp = (uint32_t)(msgLenInBits >> 32U);
+    *(uint32_t*)&p8ShaBlock[56] = SWAP32(temp);
+    temp = (uint32_t)msgLenInBits & 0xFFFFFFFFUL;
+    *(uint32_t*)&p8ShaBlock[60] = SWAP32(temp);
+  }
+
+  /* Write the final block to QDATA1BIG. */
+  CRYPTO_InstructionSequenceWait(crypto);
+  CRYPTO_QDataWrite(&crypto->QDATA1BIG, shaBlock);
+
+  /* Execute SHA. */
+  CRYPTO_EXECUTE_3(crypto,
+                   CRYPTO_CMD_INSTR_SHA,
+                   CRYPTO_CMD_INSTR_MADD32,
+                   CRYPTO_CMD_INSTR_DDATA0TODDATA1);
+
+  CRYPTO_InstructionSequenceWait(crypto);
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Read a SHA-1 message digest from DDATA0BIG.
+ *
+ * @param[in]  crypto
+ *   A pointer to the CRYPTO peripheral register block.
+ *
+ * @param[out] msgDigest
+ *   A message digest.
+ ******************************************************************************/
+static void cryptoSha1DigestRead(CRYPTO_TypeDef *crypto,
+                                 CRYPTO_SHA1_Digest_TypeDef msgDigest)
+{
+  /* Check if the buffer pointer is 32-bit aligned, if not read the data into a
+     temporary 32-bit aligned buffer then copy the data to the output buffer.*/
+  if ((uintptr_t)msgDigest & 0x3) {
+    CRYPTO_DData_TypeDef tempDData;
+    CRYPTO_DDataRead(&crypto->DDATA0BIG, tempDData);
+    memcpy(msgDigest, tempDData, sizeof(CRYPTO_SHA1_Digest_TypeDef));
+  } else {
+    ((uint32_t*)msgDigest)[0] = crypto->DDATA0BIG;
+    ((uint32_t*)msgDigest)[1] = crypto->DDATA0BIG;
+    ((uint32_t*)msgDigest)[2] = crypto->DDATA0BIG;
+    ((uint32_t*)msgDigest)[3] = crypto->DDATA0BIG;
+    ((uint32_t*)msgDigest)[4] = crypto->DDATA0BIG;
+    crypto->DDATA0BIG;
+    crypto->DDATA0BIG;
+    crypto->DDATA0BIG;
+  }
+}
+
+#if defined(CRYPTO_LDMA_SUPPORTED)
+/***************************************************************************//**
+ * @brief
+ *   Get the LDMA request signal for a CRYPTO data register.
+ *
+ * @param[in] crypto
+ *   A pointer to the CRYPTO peripheral register block.
+ *
+ * @param[in] data1
+ *   Set to true for the DMA1 (DATA1/QDATA1BIG) channel, false for DMA0 (DATA0).
+ *
+ * @param[in] read
+ *   Set to true for the read request, false for the write request.
+ ******************************************************************************/
+static LDMA_PeripheralSignal_t cryptoDmaSignal(CRYPTO_TypeDef *crypto,
+                                               bool data1,
+                                               bool read)
+{
+#if defined(LDMA_CH_REQSEL_SIGSEL_CRYPTO0DATA0WR)
+  if (crypto == CRYPTO0) {
+    if (data1) {
+      return read ? ldmaPeripheralSignal_CRYPTO0_DATA1RD : ldmaPeripheralSignal_CRYPTO0_DATA1WR;
+    }
+    return read ? ldmaPeripheralSignal_CRYPTO0_DATA0RD : ldmaPeripheralSignal_CRYPTO0_DATA0WR;
+  }
+#endif
+#if defined(LDMA_CH_REQSEL_SIGSEL_CRYPTO1DATA0WR)
+  if (crypto == CRYPTO1) {
+    if (data1) {
+      return read ? ldmaPeripheralSignal_CRYPTO1_DATA1RD : ldmaPeripheralSignal_CRYPTO1_DATA1WR;
+    }
+    return read ? ldmaPeripheralSignal_CRYPTO1_DATA0RD : ldmaPeripheralSignal_CRYPTO1_DATA0WR;
+  }
+#endif
+#if defined(LDMA_CH_REQSEL_SIGSEL_CRYPTODATA0WR)
+  if (crypto == CRYPTO) {
+    if (data1) {
+      return read ? ldmaPeripheralSignal_CRYPTO_DATA1RD : ldmaPeripheralSignal_CRYPTO_DATA1WR;
+    }
+    return read ? ldmaPeripheralSignal_CRYPTO_DATA0RD : ldmaPeripheralSignal_CRYPTO_DATA0WR;
+  }
+#endif
+  (void) data1;
+  (void) read;
+  EFM_ASSERT(false);
+  return ldmaPeripheralSignal_NONE;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Prepare the CRYPTO module for an LDMA driven AES operation.
+ *
+ * @param[in] crypto
+ *   A pointer to the CRYPTO peripheral register block.
+ ******************************************************************************/
+static void cryptoDmaAesInit(CRYPTO_TypeDef *crypto)
+{
+  /* DMA0 and DMA1 access DATA0 and DATA1 a full block at a time. */
+  crypto->CTRL &= ~(_CRYPTO_CTRL_DMA0MODE_MASK | _CRYPTO_CTRL_DMA0RSEL_MASK
+                    | _CRYPTO_CTRL_DMA1MODE_MASK | _CRYPTO_CTRL_DMA1RSEL_MASK);
+  crypto->WAC = 0;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Common part of CRYPTO_SHA_1_DmaStart() and CRYPTO_SHA_256_DmaStart().
+ ******************************************************************************/
+static void cryptoDmaShaStart(CRYPTO_DmaTransfer_TypeDef *transfer,
+                              CRYPTO_DmaMode_TypeDef mode,
+                              const uint8_t * msg,
+                              uint64_t msgLen,
+                              uint8_t * msgDigest)
+{
+  CRYPTO_TypeDef *crypto = transfer->crypto;
+  uint32_t len = (uint32_t)msgLen;
+
+  transfer->msgLen  = msgLen;
+  transfer->result  = msgDigest;
+  transfer->tailLen = len % CRYPTO_SHA256_BLOCK_SIZE_IN_BYTES;
+
+  /* DMA1 fills all of QDATA1BIG, one message block per request. */
+  crypto->CTRL |= CRYPTO_CTRL_DMA1RSEL_QDATA1BIG;
+
+  CRYPTO_SEQ_LOAD_4(crypto,
+                    CRYPTO_CMD_INSTR_DMA1TODATA,
+                    CRYPTO_CMD_INSTR_SHA,
+                    CRYPTO_CMD_INSTR_MADD32,
+                    CRYPTO_CMD_INSTR_DDATA0TODDATA1);
+
+  cryptoDmaStart(transfer, mode, NULL, msg, len - transfer->tailLen);
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Set up an LDMA transfer context and start the first chunk.
+ ******************************************************************************/
+static void cryptoDmaStart(CRYPTO_DmaTransfer_TypeDef *transfer,
+                           CRYPTO_DmaMode_TypeDef mode,
+                           uint8_t * out,
+                           const uint8_t * in,
+                           uint32_t len)
+{
+  EFM_ASSERT(((uintptr_t)in & 0x3) == 0U);
+  EFM_ASSERT(((uintptr_t)out & 0x3) == 0U);
+  EFM_ASSERT((len % CRYPTO_AES_BLOCKSIZE) == 0U);
+
+  transfer->mode      = mode;
+  transfer->in        = in;
+  transfer->out       = out;
+  transfer->remaining = len;
+  transfer->done      = false;
+
+  if (len == 0UL) {
+    cryptoDmaComplete(transfer);
+  } else {
+    cryptoDmaChunkStart(transfer);
+  }
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Start the LDMA channels and the CRYPTO sequence for the next chunk of a
+ *   transfer.
+ ******************************************************************************/
+static void cryptoDmaChunkStart(CRYPTO_DmaTransfer_TypeDef *transfer)
+{
+  CRYPTO_TypeDef *crypto = transfer->crypto;
+  uint32_t chunk = SL_MIN(transfer->remaining, CRYPTO_DMA_CHUNK_SIZE_IN_BYTES);
+  bool isSha = (transfer->mode == cryptoDmaSha1)
+               || (transfer->mode == cryptoDmaSha256);
+  /* CBC, CFB and PCBC take their input in DATA1, the others in DATA0. */
+  bool inData1 = isSha
+                 || (transfer->mode == cryptoDmaAesCbc)
+                 || (transfer->mode == cryptoDmaAesCfb)
+                 || (transfer->mode == cryptoDmaAesPcbc);
+  /* Only PCBC returns its output in DATA1. */
+  bool outData1 = (transfer->mode == cryptoDmaAesPcbc);
+  volatile uint32_t *inReg  = isSha ? &crypto->QDATA1BIG
+                              : (inData1 ? &crypto->DATA1 : &crypto->DATA0);
+  volatile uint32_t *outReg = outData1 ? &crypto->DATA1 : &crypto->DATA0;
+
+  LDMA_Descriptor_t txDesc =
+    LDMA_DESCRIPTOR_SINGLE_M2P_BYTE(transfer->in, inReg, chunk / sizeof(uint32_t));
+  LDMA_TransferCfg_t txCfg =
+    LDMA_TRANSFER_CFG_PERIPHERAL(cryptoDmaSignal(crypto, inData1, false));
+
+  txDesc.xfer.size      = ldmaCtrlSizeWord;
+  txDesc.xfer.blockSize = isSha ? ldmaCtrlBlockSizeUnit16 : ldmaCtrlBlockSizeUnit4;
+  /* For SHA the write channel signals completion, for AES the read channel. */
+  txDesc.xfer.doneIfs   = isSha ? 1U : 0U;
+  transfer->txDesc      = txDesc;
+
+  if (!isSha) {
+    LDMA_Descriptor_t rxDesc =
+      LDMA_DESCRIPTOR_SINGLE_P2M_BYTE(outReg, transfer->out, chunk / sizeof(uint32_t));
+    LDMA_TransferCfg_t rxCfg =
+      LDMA_TRANSFER_CFG_PERIPHERAL(cryptoDmaSignal(crypto, outData1, true));
+
+    rxDesc.xfer.size      = ldmaCtrlSizeWord;
+    rxDesc.xfer.blockSize = ldmaCtrlBlockSizeUnit4;
+    transfer->rxDesc      = rxDesc;
+
+    LDMA_StartTransfer((int)transfer->rxChannel, &rxCfg, &transfer->rxDesc);
+    transfer->out += chunk;
+  }
+  LDMA_StartTransfer((int)transfer->txChannel, &txCfg, &transfer->txDesc);
+
+  transfer->in        += chunk;
+  transfer->remaining -= chunk;
+
+  /* Run the sequence once per block, LDMA requests pace the execution. */
+  crypto->SEQCTRL = (isSha ? CRYPTO_SEQCTRL_BLOCKSIZE_64BYTES
+                     : CRYPTO_SEQCTRL_BLOCKSIZE_16BYTES)
+                    | (chunk << _CRYPTO_SEQCTRL_LENGTHA_SHIFT);
+  CRYPTO_InstructionSequenceExecute(crypto);
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Finalize a completed LDMA transfer and invoke its callback.
+ ******************************************************************************/
+static void cryptoDmaComplete(CRYPTO_DmaTransfer_TypeDef *transfer)
+{
+  CRYPTO_TypeDef *crypto = transfer->crypto;
+
+  crypto->CTRL &= ~(_CRYPTO_CTRL_DMA0MODE_MASK | _CRYPTO_CTRL_DMA0RSEL_MASK
+                    | _CRYPTO_CTRL_DMA1MODE_MASK | _CRYPTO_CTRL_DMA1RSEL_MASK);
+  crypto->SEQCTRL = 0;
+
+  switch (transfer->mode) {
+    case cryptoDmaAesCtr:
+      CRYPTO_DataReadUnaligned(&crypto->DATA1, transfer->result);
+      break;
+
+    case cryptoDmaSha1:
+      cryptoShaFinal(crypto, transfer->in, transfer->tailLen, transfer->msgLen);
+      cryptoSha1DigestRead(crypto, transfer->result);
+      break;
+
+    case cryptoDmaSha256:
+      cryptoShaFinal(crypto, transfer->in, transfer->tailLen, transfer->msgLen);
+      CRYPTO_DDataReadUnaligned(&crypto->DDATA0BIG, transfer->result);
+      break;
+
+    default:
+      break;
+  }
+
+  transfer->done = true;
+  if (transfer->callback != NULL) {
+    transfer->callback(transfer);
+  }
+}
+#endif /* defined(CRYPTO_LDMA_SUPPORTED) */
+
 /** @} (end addtogroup crypto) */
 
 #endif /* defined(CRYPTO_COUNT) && (CRYPTO_COUNT > 0) */
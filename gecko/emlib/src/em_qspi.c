@@ -45,9 +45,12 @@
  *    memory.
  *  @li @b STIG Command, used for configuring and executing commands on the
  *    external memory device.
+ *  @li @b Indirect Read/Write, used for moving blocks of data through the
+ *    internal SRAM. The data is read from or written to the trigger address
+ *    range, either by the CPU or by memory-to-memory LDMA transfers.
  *
- *  Indirect read/write, PHY configuration, and Execute-In-Place (XIP)
- *  configurations are not supported.
+ *  PHY configuration and Execute-In-Place (XIP) configurations are not
+ *  supported.
  *
  * The example below shows how to set up the QSPI for direct read and write
  * operation:
@@ -274,6 +277,98 @@ void QSPI_ExecStigCmd(QSPI_TypeDef * qspi, const QSPI_StigCmd_TypeDef * stigCmd)
   }
 }
 
+/***************************************************************************//**
+ * @brief
+ *   Configure indirect transfers.
+ *
+ * @param[in] qspi
+ *   A pointer to the QSPI peripheral register block.
+ *
+ * @param[in] config
+ *   A pointer to the configuration structure for QSPI indirect transfers.
+ ******************************************************************************/
+void QSPI_IndirectConfig(QSPI_TypeDef * qspi, const QSPI_IndirectConfig_TypeDef * config)
+{
+  EFM_ASSERT(config->triggerRangeWidth <= _QSPI_INDIRECTTRIGGERADDRRANGE_INDRANGEWIDTH_MASK);
+  EFM_ASSERT((config->triggerAddress & ((1UL << config->triggerRangeWidth) - 1)) == 0);
+
+  QSPI_WaitForIdle(qspi);
+  qspi->INDAHBADDRTRIGGER = config->triggerAddress;
+  qspi->INDIRECTTRIGGERADDRRANGE = config->triggerRangeWidth
+                                   << _QSPI_INDIRECTTRIGGERADDRRANGE_INDRANGEWIDTH_SHIFT;
+  qspi->SRAMPARTITIONCFG = config->readPartition << _QSPI_SRAMPARTITIONCFG_ADDR_SHIFT;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Start an indirect read.
+ *
+ * @details
+ *   The device is read with the instruction set up by @ref QSPI_ReadConfig().
+ *   Data is collected from the trigger address range as it arrives in the
+ *   read partition of the SRAM, see @ref QSPI_GetReadLevel().
+ *
+ * @param[in] qspi
+ *   A pointer to the QSPI peripheral register block.
+ *
+ * @param[in] address
+ *   Device address to start reading from.
+ *
+ * @param[in] size
+ *   Number of bytes to read.
+ ******************************************************************************/
+void QSPI_IndirectReadStart(QSPI_TypeDef * qspi, uint32_t address, uint32_t size)
+{
+  EFM_ASSERT(size > 0);
+
+  qspi->INDIRECTREADXFERCTRL = QSPI_INDIRECTREADXFERCTRL_INDOPSDONESTATUS;
+  qspi->INDIRECTREADXFERSTART = address;
+  qspi->INDIRECTREADXFERNUMBYTES = size;
+  qspi->INDIRECTREADXFERCTRL = QSPI_INDIRECTREADXFERCTRL_START;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Start an indirect write.
+ *
+ * @details
+ *   The device is written with the instruction set up by
+ *   @ref QSPI_WriteConfig(). Data written to the trigger address range is
+ *   sent to the device as it arrives in the write partition of the SRAM, see
+ *   @ref QSPI_GetWriteLevel(). The last word may be partially used.
+ *
+ * @param[in] qspi
+ *   A pointer to the QSPI peripheral register block.
+ *
+ * @param[in] address
+ *   Device address to start writing to.
+ *
+ * @param[in] size
+ *   Number of bytes to write.
+ ******************************************************************************/
+void QSPI_IndirectWriteStart(QSPI_TypeDef * qspi, uint32_t address, uint32_t size)
+{
+  EFM_ASSERT(size > 0);
+
+  qspi->INDIRECTWRITEXFERCTRL = QSPI_INDIRECTWRITEXFERCTRL_INDOPSDONESTATUS;
+  qspi->INDIRECTWRITEXFERSTART = address;
+  qspi->INDIRECTWRITEXFERNUMBYTES = size;
+  qspi->INDIRECTWRITEXFERCTRL = QSPI_INDIRECTWRITEXFERCTRL_START;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Cancel ongoing indirect reads and writes.
+ *
+ * @param[in] qspi
+ *   A pointer to the QSPI peripheral register block.
+ ******************************************************************************/
+void QSPI_IndirectCancel(QSPI_TypeDef * qspi)
+{
+  qspi->INDIRECTREADXFERCTRL = QSPI_INDIRECTREADXFERCTRL_CANCEL;
+  qspi->INDIRECTWRITEXFERCTRL = QSPI_INDIRECTWRITEXFERCTRL_CANCEL;
+}
+
 /** @} (end addtogroup qspi) */
 
 #endif /* defined(QSPI_COUNT) && (QSPI_COUNT > 0) */
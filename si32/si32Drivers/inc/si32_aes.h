@@ -0,0 +1,286 @@
+//------------------------------------------------------------------------------
+// Copyright 2024 (c) Silicon Laboratories Inc.
+//
+// SPDX-License-Identifier: Zlib
+//
+// This siHAL software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+//------------------------------------------------------------------------------
+/// @file si32_aes.h
+///
+/// Bulk ECB, CBC, CTR and XTS operations on the AES module (AES_A, or AES_B
+/// on SiM3L1xx).
+///
+/// Word aligned buffers of at least SI32_AES_MIN_DMA_BLOCKS blocks are moved
+/// through the module FIFOs by DMA channels routed to the module:
+///
+/// - ECB and CBC runs of up to 2048 blocks are moved by the transmit and
+///   receive channels, chaining peripheral scatter-gather descriptors when a
+///   run needs more than one descriptor. CBC uses the hardware chaining of
+///   the module, seeded with the IV through the XOR FIFO.
+/// - CTR and XTS move the counter or tweak of each block through the module
+///   as well. The driver computes them into one half of a scratch buffer
+///   while the module processes the blocks of the other half, so the
+///   counter follows SP 800-38A and the tweak IEEE 1619 exactly.
+/// - Other buffers, and the partial blocks of CTR and XTS, are processed one
+///   block at a time by the CPU.
+///
+/// A key holds the key words and the decryption key, which the module
+/// captures once on the first decryption. The driver remembers which key is
+/// in the module and only writes the key registers when another one is
+/// used.
+///
+/// Operations with a callback complete from the DMA interrupt of the receive
+/// channel, so the application must route that DMACHn_IRQHandler to
+/// SI32_DMA_irq_handler(). The signatures follow the mbedTLS block cipher
+/// modes, so an mbedTLS or PSA alternative implementation can keep a key per
+/// context and map each call directly.
+
+#ifndef __SI32_AES_H__
+#define __SI32_AES_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "si32_dma.h"
+
+#if defined(SI32_MCU_SIM3L1XX)
+#include "SI32_AES_B_Type.h"
+#else
+#include "SI32_AES_A_Type.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//-----------------------------------------------------------------------------
+// Define the driver configuration.
+
+// Runs shorter than this are processed by the CPU
+#ifndef SI32_AES_MIN_DMA_BLOCKS
+#define SI32_AES_MIN_DMA_BLOCKS  4
+#endif
+
+// Blocks in each half of the CTR and XTS scratch buffer
+#ifndef SI32_AES_SCRATCH_BLOCKS
+#define SI32_AES_SCRATCH_BLOCKS  16
+#endif
+
+#if SI32_AES_MIN_DMA_BLOCKS < 1
+#error "SI32_AES_MIN_DMA_BLOCKS must be at least 1"
+#endif
+
+#if (SI32_AES_SCRATCH_BLOCKS < 1) || (SI32_AES_SCRATCH_BLOCKS > 256)
+#error "SI32_AES_SCRATCH_BLOCKS must be between 1 and 256"
+#endif
+
+#define SI32_AES_BLOCK_SIZE  16
+
+//-----------------------------------------------------------------------------
+// Define the driver types.
+
+typedef enum SI32_AES_DIRECTION_Enum
+{
+  SI32_AES_ENCRYPT = 0x0,
+  SI32_AES_DECRYPT = 0x1
+} SI32_AES_DIRECTION_Enum_Type;
+
+typedef struct SI32_AES_Config_Struct
+{
+   // Crossbar selection for the transmit channel, see SI32_DMAXBAR_A_Support.h
+   SI32_DMAXBAR_CHNSEL_Enum_Type tx_chnsel;
+   // Crossbar selection for the receive channel
+   SI32_DMAXBAR_CHNSEL_Enum_Type rx_chnsel;
+   // Crossbar selection for the XOR channel, used by CTR and XTS
+   SI32_DMAXBAR_CHNSEL_Enum_Type xor_chnsel;
+} SI32_AES_Config_Type;
+
+typedef struct SI32_AES_Key_Struct
+{
+   uint32_t key[8];
+   // Last round key, captured by the module
+   uint32_t decrypt_key[8];
+   // Key length in words: 4, 6 or 8
+   uint8_t words;
+   bool has_decrypt_key;
+} SI32_AES_Key_Type;
+
+/// Operation completion callback.
+typedef void (*SI32_AES_callback_t)(SI32_DMA_STATUS_Enum_Type status, void *user);
+
+/// @fn SI32_AES_init(const SI32_AES_Config_Type *config)
+///
+/// @brief
+/// Enables the AES module, claims its DMA channels and checks the module
+/// against the FIPS-197 and SP 800-38A test vectors.
+///
+/// @return
+///  SI32_DMA_STATUS_NO_CHANNEL if a channel is already claimed, in which
+///  case the modes needing it are processed by the CPU.
+///  SI32_DMA_STATUS_INVALID_PARAMETER if the module fails the test vectors,
+///  in which case every operation fails.
+///
+SI32_DMA_STATUS_Enum_Type
+SI32_AES_init(const SI32_AES_Config_Type *config);
+
+/// @fn SI32_AES_set_key(SI32_AES_Key_Type *key,
+///      const uint8_t *data,
+///      uint32_t bits)
+///
+/// @brief
+/// Loads a 128, 192 or 256-bit key. The decryption key is captured on the
+/// first decryption with the key.
+///
+SI32_DMA_STATUS_Enum_Type
+SI32_AES_set_key(SI32_AES_Key_Type *key,
+   const uint8_t *data,
+   uint32_t bits);
+
+/// @fn SI32_AES_clear_key(SI32_AES_Key_Type *key)
+///
+/// @brief
+/// Wipes a key, and the key registers if the key is in the module.
+///
+void
+SI32_AES_clear_key(SI32_AES_Key_Type *key);
+
+/// @fn SI32_AES_crypt_ecb(SI32_AES_Key_Type *key,
+///      SI32_AES_DIRECTION_Enum_Type direction,
+///      const uint8_t *input,
+///      uint8_t *output,
+///      uint32_t length,
+///      SI32_AES_callback_t callback,
+///      void *user)
+///
+/// @brief
+/// ECB over a multiple of 16 bytes.
+///
+/// Without a callback the function waits for the result. With a callback,
+/// the callback is called once the operation completes and the buffers
+/// must stay valid until then. Operations processed by the CPU complete
+/// before the function returns.
+///
+/// @return
+///  SI32_DMA_STATUS_BUSY if another operation holds the module, or
+///  SI32_DMA_STATUS_INVALID_PARAMETER if the length is not supported by the
+///  mode, in which cases the callback is not called.
+///
+SI32_DMA_STATUS_Enum_Type
+SI32_AES_crypt_ecb(SI32_AES_Key_Type *key,
+   SI32_AES_DIRECTION_Enum_Type direction,
+   const uint8_t *input,
+   uint8_t *output,
+   uint32_t length,
+   SI32_AES_callback_t callback,
+   void *user);
+
+/// @fn SI32_AES_crypt_cbc(SI32_AES_Key_Type *key,
+///      SI32_AES_DIRECTION_Enum_Type direction,
+///      uint8_t iv[16],
+///      const uint8_t *input,
+///      uint8_t *output,
+///      uint32_t length,
+///      SI32_AES_callback_t callback,
+///      void *user)
+///
+/// @brief
+/// CBC over a multiple of 16 bytes. The IV is updated for the next call.
+///
+SI32_DMA_STATUS_Enum_Type
+SI32_AES_crypt_cbc(SI32_AES_Key_Type *key,
+   SI32_AES_DIRECTION_Enum_Type direction,
+   uint8_t iv[16],
+   const uint8_t *input,
+   uint8_t *output,
+   uint32_t length,
+   SI32_AES_callback_t callback,
+   void *user);
+
+/// @fn SI32_AES_crypt_ctr(SI32_AES_Key_Type *key,
+///      uint32_t *nc_off,
+///      uint8_t nonce_counter[16],
+///      uint8_t stream_block[16],
+///      const uint8_t *input,
+///      uint8_t *output,
+///      uint32_t length,
+///      SI32_AES_callback_t callback,
+///      void *user)
+///
+/// @brief
+/// CTR over any length. The counter is incremented as a 128-bit big endian
+/// value. The unused key stream of the last block is kept in stream_block,
+/// with its offset in nc_off, for the next call.
+///
+SI32_DMA_STATUS_Enum_Type
+SI32_AES_crypt_ctr(SI32_AES_Key_Type *key,
+   uint32_t *nc_off,
+   uint8_t nonce_counter[16],
+   uint8_t stream_block[16],
+   const uint8_t *input,
+   uint8_t *output,
+   uint32_t length,
+   SI32_AES_callback_t callback,
+   void *user);
+
+/// @fn SI32_AES_crypt_xts(SI32_AES_Key_Type *data_key,
+///      SI32_AES_Key_Type *tweak_key,
+///      SI32_AES_DIRECTION_Enum_Type direction,
+///      const uint8_t data_unit[16],
+///      const uint8_t *input,
+///      uint8_t *output,
+///      uint32_t length,
+///      SI32_AES_callback_t callback,
+///      void *user)
+///
+/// @brief
+/// XTS over one data unit of at least 16 bytes, with ciphertext stealing
+/// when the length is not a multiple of 16.
+///
+SI32_DMA_STATUS_Enum_Type
+SI32_AES_crypt_xts(SI32_AES_Key_Type *data_key,
+   SI32_AES_Key_Type *tweak_key,
+   SI32_AES_DIRECTION_Enum_Type direction,
+   const uint8_t data_unit[16],
+   const uint8_t *input,
+   uint8_t *output,
+   uint32_t length,
+   SI32_AES_callback_t callback,
+   void *user);
+
+/// @fn SI32_AES_is_busy(void)
+///
+/// @return
+///  True while an operation holds the module.
+///
+bool
+SI32_AES_is_busy(void);
+
+/// @fn SI32_AES_abort(void)
+///
+/// @brief
+/// Stops the operation in progress and resets the module. The callback is
+/// called with SI32_DMA_STATUS_ABORTED and the output is undefined.
+///
+void
+SI32_AES_abort(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __SI32_AES_H__
+
+//-eof--------------------------------------------------------------------------
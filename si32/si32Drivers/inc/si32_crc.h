@@ -0,0 +1,263 @@
+//------------------------------------------------------------------------------
+// Copyright 2024 (c) Silicon Laboratories Inc.
+//
+// SPDX-License-Identifier: Zlib
+//
+// This siHAL software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+//------------------------------------------------------------------------------
+/// @file si32_crc.h
+///
+/// CRC service on top of the CRC module (CRC_A, or ECRC_A on SiM3L1xx).
+///
+/// A computation is held in a context that only stores the running CRC
+/// register, so any number of computations can be in progress at once and
+/// each can be fed any number of non-contiguous buffers or flash ranges
+/// (flash is memory mapped and read directly by the DMA controller).
+///
+/// The module is only held for the duration of a single update:
+///
+/// - The module can only seed itself with all zeros or all ones, so the
+///   running register S of the context is restored by seeding with zeros and
+///   feeding the one width-bit value that leaves S in the register, found by
+///   shifting S backwards through the polynomial.
+/// - Leading and trailing bytes are written one at a time. The word aligned
+///   middle is written by the CPU, or by a DMA channel in auto request mode
+///   once it is at least SI32_CRC_MIN_DMA_WORDS long.
+/// - An update finding the module held by another one returns
+///   SI32_DMA_STATUS_BUSY and leaves its context untouched.
+///
+/// Parameters follow the usual width/poly/init/refin/refout/xorout model.
+/// Parameters the module cannot implement are computed with the software
+/// reference, SI32_CRC_reference_update(), which is bit-exact with the
+/// module and checked against it by SI32_CRC_init().
+
+#ifndef __SI32_CRC_H__
+#define __SI32_CRC_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "si32_dma.h"
+
+#if defined(SI32_MCU_SIM3L1XX)
+#include "SI32_ECRC_A_Type.h"
+#else
+#include "SI32_CRC_A_Type.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//-----------------------------------------------------------------------------
+// Define the service configuration.
+
+// Word aligned blocks shorter than this are written by the CPU
+#ifndef SI32_CRC_MIN_DMA_WORDS
+#define SI32_CRC_MIN_DMA_WORDS  16
+#endif
+
+//-----------------------------------------------------------------------------
+// Define the CRC parameter sets.
+
+typedef struct SI32_CRC_Params_Struct
+{
+   // Width in bits, 8 to 32. The module implements 16 and 32.
+   uint8_t width;
+   // Polynomial without the x^width term
+   uint32_t poly;
+   // Initial register value
+   uint32_t init;
+   // Process each input byte least significant bit first
+   bool refin;
+   // Reflect the register before the final xor
+   bool refout;
+   // Value xored into the result
+   uint32_t xorout;
+} SI32_CRC_Params_Type;
+
+/// CRC-32 (Ethernet, zlib), check 0xCBF43926.
+extern const SI32_CRC_Params_Type SI32_CRC_PARAMS_CRC32;
+/// CRC-32/BZIP2, check 0xFC891918.
+extern const SI32_CRC_Params_Type SI32_CRC_PARAMS_CRC32_BZIP2;
+/// CRC-32/MPEG-2, check 0x0376E6E7.
+extern const SI32_CRC_Params_Type SI32_CRC_PARAMS_CRC32_MPEG2;
+/// CRC-16/CCITT-FALSE, check 0x29B1.
+extern const SI32_CRC_Params_Type SI32_CRC_PARAMS_CRC16_CCITT_FALSE;
+/// CRC-16/XMODEM, check 0x31C3.
+extern const SI32_CRC_Params_Type SI32_CRC_PARAMS_CRC16_XMODEM;
+/// CRC-16/KERMIT, check 0x2189.
+extern const SI32_CRC_Params_Type SI32_CRC_PARAMS_CRC16_KERMIT;
+/// CRC-16/ARC, check 0xBB3D.
+extern const SI32_CRC_Params_Type SI32_CRC_PARAMS_CRC16_ARC;
+/// CRC-16/MODBUS, check 0x4B37.
+extern const SI32_CRC_Params_Type SI32_CRC_PARAMS_CRC16_MODBUS;
+/// CRC-16/DNP, check 0xEA82.
+extern const SI32_CRC_Params_Type SI32_CRC_PARAMS_CRC16_DNP;
+/// CRC-16/EN-13757, check 0xC2B7.
+extern const SI32_CRC_Params_Type SI32_CRC_PARAMS_CRC16_EN13757;
+
+//-----------------------------------------------------------------------------
+// Define the CRC context.
+
+struct SI32_CRC_Context_Struct;
+
+/// Asynchronous update completion callback.
+typedef void (*SI32_CRC_callback_t)(struct SI32_CRC_Context_Struct *context,
+   SI32_DMA_STATUS_Enum_Type status,
+   void *user);
+
+typedef struct SI32_CRC_Context_Struct
+{
+   const SI32_CRC_Params_Type *params;
+   // Running CRC register, before reflection and final xor
+   uint32_t state;
+   // The parameters are implemented by the module
+   bool hardware;
+} SI32_CRC_Context_Type;
+
+/// @fn SI32_CRC_init(SI32_DMAXBAR_CHNSEL_Enum_Type chnsel)
+///
+/// @brief
+/// Enables the CRC module, claims a DMA channel for it and checks the
+/// module against the software reference.
+///
+/// @param[in]
+///  chnsel
+///  Channel for the transfers to the module, routed to no peripheral
+///  (e.g. SI32_DMAXBAR_CHAN15_NONE).
+///
+/// @return
+///  SI32_DMA_STATUS_NO_CHANNEL if the channel is already claimed,
+///  SI32_DMA_STATUS_INVALID_PARAMETER if the module does not match the
+///  reference, in which case every update is computed in software.
+///
+SI32_DMA_STATUS_Enum_Type
+SI32_CRC_init(SI32_DMAXBAR_CHNSEL_Enum_Type chnsel);
+
+/// @fn SI32_CRC_start(SI32_CRC_Context_Type *context,
+///      const SI32_CRC_Params_Type *params)
+///
+/// @brief
+/// Starts a computation. The parameters must stay valid while it is used.
+///
+void
+SI32_CRC_start(SI32_CRC_Context_Type *context,
+   const SI32_CRC_Params_Type *params);
+
+/// @fn SI32_CRC_update(SI32_CRC_Context_Type *context,
+///      const void *data,
+///      uint32_t length)
+///
+/// @brief
+/// Feeds a buffer or flash range and waits for the result.
+///
+/// @return
+///  SI32_DMA_STATUS_BUSY if the module is held by another update.
+///
+SI32_DMA_STATUS_Enum_Type
+SI32_CRC_update(SI32_CRC_Context_Type *context,
+   const void *data,
+   uint32_t length);
+
+/// @fn SI32_CRC_update_async(SI32_CRC_Context_Type *context,
+///      const void *data,
+///      uint32_t length,
+///      SI32_CRC_callback_t callback,
+///      void *user)
+///
+/// @brief
+/// Feeds a buffer or flash range, the callback is called from the DMA
+/// channel interrupt once it has been processed. Short blocks, and
+/// parameters the module does not implement, complete before the function
+/// returns.
+///
+/// @return
+///  SI32_DMA_STATUS_BUSY if the module is held by another update, in which
+///  case the callback is not called.
+///
+SI32_DMA_STATUS_Enum_Type
+SI32_CRC_update_async(SI32_CRC_Context_Type *context,
+   const void *data,
+   uint32_t length,
+   SI32_CRC_callback_t callback,
+   void *user);
+
+/// @fn SI32_CRC_finish(const SI32_CRC_Context_Type *context)
+///
+/// @return
+///  The CRC of all the data fed to the context. The context can still be
+///  updated afterwards.
+///
+uint32_t
+SI32_CRC_finish(const SI32_CRC_Context_Type *context);
+
+/// @fn SI32_CRC_compute(const SI32_CRC_Params_Type *params,
+///      const void *data,
+///      uint32_t length,
+///      uint32_t *crc)
+///
+/// @brief
+/// One-shot CRC of a single buffer or flash range.
+///
+SI32_DMA_STATUS_Enum_Type
+SI32_CRC_compute(const SI32_CRC_Params_Type *params,
+   const void *data,
+   uint32_t length,
+   uint32_t *crc);
+
+/// @fn SI32_CRC_is_busy(void)
+///
+/// @return
+///  True while an update holds the module.
+///
+bool
+SI32_CRC_is_busy(void);
+
+/// @fn SI32_CRC_reference_update(const SI32_CRC_Params_Type *params,
+///      uint32_t state,
+///      const void *data,
+///      uint32_t length)
+///
+/// @brief
+/// Bit-at-a-time software model of the module.
+///
+/// @return
+///  The register after feeding the data to a register holding state.
+///
+uint32_t
+SI32_CRC_reference_update(const SI32_CRC_Params_Type *params,
+   uint32_t state,
+   const void *data,
+   uint32_t length);
+
+/// @fn SI32_CRC_reference_finish(const SI32_CRC_Params_Type *params,
+///      uint32_t state)
+///
+/// @return
+///  The CRC for a register value, after reflection and final xor.
+///
+uint32_t
+SI32_CRC_reference_finish(const SI32_CRC_Params_Type *params,
+   uint32_t state);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __SI32_CRC_H__
+
+//-eof--------------------------------------------------------------------------
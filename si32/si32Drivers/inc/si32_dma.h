@@ -0,0 +1,193 @@
+//------------------------------------------------------------------------------
+// Copyright 2024 (c) Silicon Laboratories Inc.
+//
+// SPDX-License-Identifier: Zlib
+//
+// This siHAL software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+//------------------------------------------------------------------------------
+/// @file si32_dma.h
+///
+/// DMA channel bookkeeping shared by the si32 drivers.
+///
+/// The DMA controller has a single channel control table that every user of
+/// the controller has to share. This module owns that table (or adopts the
+/// one already installed if the controller is running), hands out channels
+/// and dispatches the per-channel completion interrupts to the driver that
+/// claimed the channel.
+///
+/// The application routes each DMACHn_IRQHandler used by a driver to
+/// SI32_DMA_irq_handler(n).
+
+#ifndef __SI32_DMA_H__
+#define __SI32_DMA_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "si32_device.h"
+#include "SI32_DMACTRL_A_Type.h"
+#include "SI32_DMADESC_A_Type.h"
+#include "SI32_DMAXBAR_A_Type.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//-----------------------------------------------------------------------------
+// Define status codes returned by the si32 drivers.
+
+typedef enum SI32_DMA_STATUS_Enum
+{
+  SI32_DMA_STATUS_OK                = 0x0,
+  SI32_DMA_STATUS_BUSY              = 0x1,
+  SI32_DMA_STATUS_INVALID_PARAMETER = 0x2,
+  SI32_DMA_STATUS_NO_CHANNEL        = 0x3,
+  SI32_DMA_STATUS_BUS_ERROR         = 0x4,
+  SI32_DMA_STATUS_OVERRUN           = 0x5,
+  SI32_DMA_STATUS_ABORTED           = 0x6
+} SI32_DMA_STATUS_Enum_Type;
+
+//-----------------------------------------------------------------------------
+// Define the largest number of transfers a single descriptor can move.
+
+#define SI32_DMA_MAX_COUNT  ((SI32_DMADESC_A_CONFIG_NCOUNT_MASK >> SI32_DMADESC_A_CONFIG_NCOUNT_SHIFT) + 1)
+
+/// Channel completion callback, called from SI32_DMA_irq_handler().
+typedef void (*SI32_DMA_callback_t)(uint32_t channel, void *context);
+
+/// @fn SI32_DMA_init(void)
+///
+/// @brief
+/// Enables the DMA controller and installs the channel control table.
+///
+/// If the controller is already enabled, the table it uses is adopted so
+/// that channels set up elsewhere keep working. Safe to call more than once.
+///
+void
+SI32_DMA_init(void);
+
+/// @fn SI32_DMA_claim_channel(SI32_DMAXBAR_CHNSEL_Enum_Type chnsel,
+///      SI32_DMA_callback_t callback,
+///      void *context)
+///
+/// @brief
+/// Claims the channel encoded in chnsel and routes the selected peripheral
+/// request to it through the DMA crossbar.
+///
+/// @param[in]
+///  chnsel
+///  Channel and peripheral selection, see SI32_DMAXBAR_A_Support.h.
+///
+/// @param[in]
+///  callback
+///  Completion callback, NULL to leave the channel interrupt disabled.
+///
+/// @param[in]
+///  context
+///  Passed to the callback.
+///
+/// @return
+///  The channel number, or -1 if the channel is already claimed.
+///
+int32_t
+SI32_DMA_claim_channel(SI32_DMAXBAR_CHNSEL_Enum_Type chnsel,
+   SI32_DMA_callback_t callback,
+   void *context);
+
+/// @fn SI32_DMA_release_channel(uint32_t channel)
+///
+/// @brief
+/// Stops the channel, masks its requests and interrupt and returns it.
+///
+void
+SI32_DMA_release_channel(uint32_t channel);
+
+/// @fn SI32_DMA_get_primary_descriptor(uint32_t channel)
+///
+/// @return
+///  The primary descriptor of the channel.
+///
+SI32_DMADESC_A_Type *
+SI32_DMA_get_primary_descriptor(uint32_t channel);
+
+/// @fn SI32_DMA_get_alternate_descriptor(uint32_t channel)
+///
+/// @return
+///  The alternate descriptor of the channel.
+///
+SI32_DMADESC_A_Type *
+SI32_DMA_get_alternate_descriptor(uint32_t channel);
+
+/// @fn SI32_DMA_start_channel(uint32_t channel, bool high_priority)
+///
+/// @brief
+/// Starts a channel whose primary descriptor has been programmed. The
+/// channel runs on peripheral requests until the descriptor is exhausted.
+///
+void
+SI32_DMA_start_channel(uint32_t channel, bool high_priority);
+
+/// @fn SI32_DMA_software_request(uint32_t channel)
+///
+/// @brief
+/// Requests a started channel from software. A channel programmed in auto
+/// request mode then runs until its descriptor is exhausted.
+///
+void
+SI32_DMA_software_request(uint32_t channel);
+
+/// @fn SI32_DMA_stop_channel(uint32_t channel)
+///
+/// @brief
+/// Disables the channel. Data already in flight is not recovered.
+///
+void
+SI32_DMA_stop_channel(uint32_t channel);
+
+/// @fn SI32_DMA_is_channel_done(uint32_t channel)
+///
+/// @return
+///  True once the channel has exhausted its descriptor or has been stopped.
+///
+bool
+SI32_DMA_is_channel_done(uint32_t channel);
+
+/// @fn SI32_DMA_check_bus_error(void)
+///
+/// @brief
+/// Reads and clears the controller bus error flag.
+///
+/// @return
+///  True if a bus error occurred since the last call.
+///
+bool
+SI32_DMA_check_bus_error(void);
+
+/// @fn SI32_DMA_irq_handler(uint32_t channel)
+///
+/// @brief
+/// Dispatches a channel completion interrupt to the owner of the channel.
+///
+void
+SI32_DMA_irq_handler(uint32_t channel);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __SI32_DMA_H__
+
+//-eof--------------------------------------------------------------------------
@@ -0,0 +1,213 @@
+//------------------------------------------------------------------------------
+// Copyright 2024 (c) Silicon Laboratories Inc.
+//
+// SPDX-License-Identifier: Zlib
+//
+// This siHAL software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+//------------------------------------------------------------------------------
+/// @file si32_spi_dma.h
+///
+/// Full-duplex SPI master block transfers driven by the DMA controller.
+///
+/// A transfer is a chain of segments clocked out back to back while the
+/// chip select stays active. Each segment is moved by a pair of DMA channels,
+/// one feeding the transmit FIFO and one draining the receive FIFO, routed to
+/// the SPI through the DMA crossbar:
+///
+/// - When both buffers are word aligned the channels move 32-bit words and
+///   the FIFO thresholds are set to four bytes, so each DMA request moves
+///   four bytes. Otherwise the channels move single bytes.
+/// - The receive channel runs at high priority and always runs, into a
+///   scratch word when there is no receive buffer, so that its completion
+///   marks the end of the segment on the wire.
+/// - Segments shorter than SI32_SPIDMA_MIN_DMA_LENGTH, and the last bytes of
+///   a segment that do not fill a word, are moved by the CPU with 32-bit FIFO
+///   accesses wherever four bytes fit.
+///
+/// The SPI module must be enabled and configured as master with 8-bit frames
+/// before starting a transfer. The engine only toggles DMA requests, the FIFO
+/// thresholds and, in SI32_SPIDMA_CS_NSS mode, the NSS output.
+///
+/// The completion callback runs from the DMA interrupt of the receive
+/// channel, so the application must route that DMACHn_IRQHandler to
+/// SI32_DMA_irq_handler(). A transfer moved entirely by the CPU completes,
+/// and calls its callback, before SI32_SPIDMA_transfer() returns.
+
+#ifndef __SI32_SPI_DMA_H__
+#define __SI32_SPI_DMA_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "si32_dma.h"
+
+#if defined(SI32_MCU_SIM3L1XX)
+#include "SI32_SPI_B_Type.h"
+#else
+#include "SI32_SPI_A_Type.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//-----------------------------------------------------------------------------
+// Define the engine configuration.
+
+// Segments shorter than this are moved by the CPU
+#ifndef SI32_SPIDMA_MIN_DMA_LENGTH
+#define SI32_SPIDMA_MIN_DMA_LENGTH  16
+#endif
+
+// Depth of the SPI transmit and receive FIFOs in bytes
+#ifndef SI32_SPIDMA_FIFO_DEPTH
+#define SI32_SPIDMA_FIFO_DEPTH  8
+#endif
+
+#if SI32_SPIDMA_MIN_DMA_LENGTH < 4
+#error "SI32_SPIDMA_MIN_DMA_LENGTH must be at least 4"
+#endif
+
+//-----------------------------------------------------------------------------
+// Define the engine types.
+
+#if defined(SI32_MCU_SIM3L1XX)
+typedef SI32_SPI_B_Type SI32_SPIDMA_SPI_Type;
+#else
+typedef SI32_SPI_A_Type SI32_SPIDMA_SPI_Type;
+#endif
+
+typedef enum SI32_SPIDMA_CS_Enum
+{
+  // Chip select is handled by the application
+  SI32_SPIDMA_CS_NONE     = 0x0,
+  // NSS is driven low for the duration of a transfer (4-wire master mode)
+  SI32_SPIDMA_CS_NSS      = 0x1,
+  // cs_callback is called to select and deselect the device
+  SI32_SPIDMA_CS_CALLBACK = 0x2
+} SI32_SPIDMA_CS_Enum_Type;
+
+/// One segment of a transfer. Either buffer may be NULL: a missing transmit
+/// buffer sends the fill byte, a missing receive buffer discards the data.
+typedef struct SI32_SPIDMA_Segment_Struct
+{
+   const void *tx;
+   void *rx;
+   uint32_t length;
+   const struct SI32_SPIDMA_Segment_Struct *next;
+} SI32_SPIDMA_Segment_Type;
+
+typedef struct SI32_SPIDMA_Config_Struct
+{
+   SI32_SPIDMA_SPI_Type *spi;
+   // Crossbar selection for the receive channel, see SI32_DMAXBAR_A_Support.h
+   SI32_DMAXBAR_CHNSEL_Enum_Type rx_chnsel;
+   // Crossbar selection for the transmit channel
+   SI32_DMAXBAR_CHNSEL_Enum_Type tx_chnsel;
+   SI32_SPIDMA_CS_Enum_Type cs_mode;
+   void (*cs_callback)(bool active, void *context);
+   void *cs_context;
+   // Byte sent when a segment has no transmit buffer
+   uint8_t fill;
+} SI32_SPIDMA_Config_Type;
+
+struct SI32_SPIDMA_Handle_Struct;
+
+/// Transfer completion callback.
+typedef void (*SI32_SPIDMA_callback_t)(struct SI32_SPIDMA_Handle_Struct *handle,
+   SI32_DMA_STATUS_Enum_Type status,
+   void *context);
+
+/// Engine state, owned by the driver.
+typedef struct SI32_SPIDMA_Handle_Struct
+{
+   SI32_SPIDMA_Config_Type config;
+   uint32_t rx_channel;
+   uint32_t tx_channel;
+   const SI32_SPIDMA_Segment_Type *segment;
+   uint32_t offset;
+   uint32_t dma_length;
+   SI32_SPIDMA_callback_t callback;
+   void *context;
+   uint32_t fill_word;
+   uint32_t sink_word;
+   volatile bool busy;
+} SI32_SPIDMA_Handle_Type;
+
+/// @fn SI32_SPIDMA_init(SI32_SPIDMA_Handle_Type *handle,
+///      const SI32_SPIDMA_Config_Type *config)
+///
+/// @brief
+/// Claims and routes the receive and transmit DMA channels of an engine.
+///
+/// @return
+///  SI32_DMA_STATUS_NO_CHANNEL if either channel is already claimed.
+///
+SI32_DMA_STATUS_Enum_Type
+SI32_SPIDMA_init(SI32_SPIDMA_Handle_Type *handle,
+   const SI32_SPIDMA_Config_Type *config);
+
+/// @fn SI32_SPIDMA_deinit(SI32_SPIDMA_Handle_Type *handle)
+///
+/// @brief
+/// Aborts any transfer in progress and releases the DMA channels.
+///
+void
+SI32_SPIDMA_deinit(SI32_SPIDMA_Handle_Type *handle);
+
+/// @fn SI32_SPIDMA_transfer(SI32_SPIDMA_Handle_Type *handle,
+///      const SI32_SPIDMA_Segment_Type *segments,
+///      SI32_SPIDMA_callback_t callback,
+///      void *context)
+///
+/// @brief
+/// Selects the device and starts clocking out a chain of segments.
+///
+/// The segments and buffers must stay valid until the callback is called.
+///
+/// @return
+///  SI32_DMA_STATUS_BUSY if a transfer is already in progress.
+///
+SI32_DMA_STATUS_Enum_Type
+SI32_SPIDMA_transfer(SI32_SPIDMA_Handle_Type *handle,
+   const SI32_SPIDMA_Segment_Type *segments,
+   SI32_SPIDMA_callback_t callback,
+   void *context);
+
+/// @fn SI32_SPIDMA_is_busy(SI32_SPIDMA_Handle_Type *handle)
+///
+/// @return
+///  True while a transfer is in progress.
+///
+bool
+SI32_SPIDMA_is_busy(SI32_SPIDMA_Handle_Type *handle);
+
+/// @fn SI32_SPIDMA_abort(SI32_SPIDMA_Handle_Type *handle)
+///
+/// @brief
+/// Stops the transfer in progress, flushes the FIFOs and deselects the
+/// device. The callback is called with SI32_DMA_STATUS_ABORTED.
+///
+void
+SI32_SPIDMA_abort(SI32_SPIDMA_Handle_Type *handle);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __SI32_SPI_DMA_H__
+
+//-eof--------------------------------------------------------------------------
@@ -0,0 +1,1192 @@
+//------------------------------------------------------------------------------
+// Copyright 2024 (c) Silicon Laboratories Inc.
+//
+// SPDX-License-Identifier: Zlib
+//
+// This siHAL software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+//------------------------------------------------------------------------------
+/// @file si32_aes.c
+
+#include <assert.h>
+#include <stddef.h>
+#include <string.h>
+#include "si32_aes.h"
+#include "SI32_CLKCTRL_A_Type.h"
+
+#if defined(SI32_MCU_SIM3L1XX)
+#define SI32_AES_REG(name)   SI32_AES_B_##name
+#define SI32_AES_ERROR_MASK  (SI32_AES_B_STATUS_DURI_MASK | SI32_AES_B_STATUS_DORI_MASK \
+                              | SI32_AES_B_STATUS_XORI_MASK)
+#else
+#define SI32_AES_REG(name)   SI32_AES_A_##name
+#define SI32_AES_ERROR_MASK  (SI32_AES_A_STATUS_DURF_MASK | SI32_AES_A_STATUS_DORF_MASK \
+                              | SI32_AES_A_STATUS_XORF_MASK)
+#endif
+
+#define SI32_AES_MODULE  SI32_AES_0
+
+// The key registers are 16 bytes apart
+#define SI32_AES_HWKEY(n)  ((&SI32_AES_MODULE->HWKEY0.U32)[4 * (n)])
+
+// Transfers per DMA arbitration, one 2^2 word block
+#define SI32_AES_DMA_RPOWER  2
+
+// Blocks in a single module operation
+#define SI32_AES_MAX_RUN_BLOCKS  (SI32_AES_REG(XFRSIZE_XFRSIZE_MASK) + 1)
+
+// Scatter-gather tasks needed to move the longest run
+#define SI32_AES_MAX_TASKS \
+   ((SI32_AES_MAX_RUN_BLOCKS * 4 + SI32_DMA_MAX_COUNT - 1) / SI32_DMA_MAX_COUNT)
+
+typedef enum SI32_AES_MODE_Enum
+{
+  SI32_AES_MODE_ECB = 0x0,
+  SI32_AES_MODE_CBC = 0x1,
+  SI32_AES_MODE_CTR = 0x2,
+  SI32_AES_MODE_XTS = 0x3
+} SI32_AES_MODE_Enum_Type;
+
+// FIPS-197 appendix C.1
+static const uint8_t SI32_AES_fips197_key[16] =
+{
+   0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+   0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F
+};
+static const uint8_t SI32_AES_fips197_plain[16] =
+{
+   0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77,
+   0x88, 0x99, 0xAA, 0xBB, 0xCC, 0xDD, 0xEE, 0xFF
+};
+static const uint8_t SI32_AES_fips197_cipher[16] =
+{
+   0x69, 0xC4, 0xE0, 0xD8, 0x6A, 0x7B, 0x04, 0x30,
+   0xD8, 0xCD, 0xB7, 0x80, 0x70, 0xB4, 0xC5, 0x5A
+};
+
+// SP 800-38A F.2.1 and F.2.2
+static const uint8_t SI32_AES_sp800_key[16] =
+{
+   0x2B, 0x7E, 0x15, 0x16, 0x28, 0xAE, 0xD2, 0xA6,
+   0xAB, 0xF7, 0x15, 0x88, 0x09, 0xCF, 0x4F, 0x3C
+};
+static const uint8_t SI32_AES_sp800_iv[16] =
+{
+   0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+   0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F
+};
+static const uint8_t SI32_AES_sp800_plain[64] =
+{
+   0x6B, 0xC1, 0xBE, 0xE2, 0x2E, 0x40, 0x9F, 0x96,
+   0xE9, 0x3D, 0x7E, 0x11, 0x73, 0x93, 0x17, 0x2A,
+   0xAE, 0x2D, 0x8A, 0x57, 0x1E, 0x03, 0xAC, 0x9C,
+   0x9E, 0xB7, 0x6F, 0xAC, 0x45, 0xAF, 0x8E, 0x51,
+   0x30, 0xC8, 0x1C, 0x46, 0xA3, 0x5C, 0xE4, 0x11,
+   0xE5, 0xFB, 0xC1, 0x19, 0x1A, 0x0A, 0x52, 0xEF,
+   0xF6, 0x9F, 0x24, 0x45, 0xDF, 0x4F, 0x9B, 0x17,
+   0xAD, 0x2B, 0x41, 0x7B, 0xE6, 0x6C, 0x37, 0x10
+};
+static const uint8_t SI32_AES_sp800_cipher[64] =
+{
+   0x76, 0x49, 0xAB, 0xAC, 0x81, 0x19, 0xB2, 0x46,
+   0xCE, 0xE9, 0x8E, 0x9B, 0x12, 0xE9, 0x19, 0x7D,
+   0x50, 0x86, 0xCB, 0x9B, 0x50, 0x72, 0x19, 0xEE,
+   0x95, 0xDB, 0x11, 0x3A, 0x91, 0x76, 0x78, 0xB2,
+   0x73, 0xBE, 0xD6, 0xB8, 0xE3, 0xC1, 0x74, 0x3B,
+   0x71, 0x16, 0xE6, 0x9E, 0x22, 0x22, 0x95, 0x16,
+   0x3F, 0xF1, 0xCA, 0xA1, 0x68, 0x1F, 0xAC, 0x09,
+   0x12, 0x0E, 0xCA, 0x30, 0x75, 0x86, 0xE1, 0xA7
+};
+
+static struct
+{
+   bool ready;
+   volatile bool busy;
+   bool has_channels;
+   bool has_xor_channel;
+   uint32_t tx_channel;
+   uint32_t rx_channel;
+   uint32_t xor_channel;
+   // Key in the key registers
+   const SI32_AES_Key_Type *loaded;
+   bool loaded_decrypt;
+   // Operation in progress
+   SI32_AES_MODE_Enum_Type mode;
+   bool decrypt;
+   uint32_t control;
+   const uint8_t *input;
+   uint8_t *output;
+   // Blocks left to start by DMA, and blocks of the run in progress
+   uint32_t blocks;
+   uint32_t run;
+   // Scratch half of the run in progress, and blocks ready in each half
+   uint32_t half;
+   uint32_t filled[2];
+   // CBC IV, CTR counter or XTS tweak of the next block
+   uint32_t chain[4];
+   // CBC decryption IV of the run after the one in progress
+   uint32_t next_chain[4];
+   // Bytes after the last whole block
+   uint32_t tail;
+   // Caller IV or counter, CTR key stream
+   uint8_t *iv;
+   uint8_t *stream_block;
+   uint32_t *nc_off;
+   bool async;
+   SI32_AES_callback_t callback;
+   void *user;
+} SI32_AES_engine;
+
+// Counters or tweaks moved through the module by CTR and XTS
+static uint32_t SI32_AES_scratch[2][SI32_AES_SCRATCH_BLOCKS * 4];
+
+static SI32_DMADESC_A_Type SI32_AES_tx_tasks[SI32_AES_MAX_TASKS];
+static SI32_DMADESC_A_Type SI32_AES_rx_tasks[SI32_AES_MAX_TASKS];
+
+
+//-----------------------------------------------------------------------------
+// SI32_AES_xor_block
+//
+//-----------------------------------------------------------------------------
+static void
+SI32_AES_xor_block(
+   uint8_t *output,
+   const uint8_t *a,
+   const uint8_t *b)
+{
+   uint32_t i;
+
+   for (i = 0; i < SI32_AES_BLOCK_SIZE; i++)
+   {
+      output[i] = a[i] ^ b[i];
+   }
+}
+
+//-----------------------------------------------------------------------------
+// SI32_AES_increment
+//
+// Increments a counter block as a 128-bit big endian value.
+//-----------------------------------------------------------------------------
+static void
+SI32_AES_increment(
+   uint32_t *counter)
+{
+   uint8_t *byte = (uint8_t *)counter;
+   uint32_t i = SI32_AES_BLOCK_SIZE;
+
+   while ((i > 0) && (++byte[i - 1] == 0))
+   {
+      i--;
+   }
+}
+
+//-----------------------------------------------------------------------------
+// SI32_AES_multiply_alpha
+//
+// Multiplies a tweak by x in GF(2^128). The tweak is stored least
+// significant byte first, so on the little endian core its words are in
+// order of significance.
+//-----------------------------------------------------------------------------
+static void
+SI32_AES_multiply_alpha(
+   uint32_t *tweak)
+{
+   uint32_t carry = tweak[3] >> 31;
+
+   tweak[3] = (tweak[3] << 1) | (tweak[2] >> 31);
+   tweak[2] = (tweak[2] << 1) | (tweak[1] >> 31);
+   tweak[1] = (tweak[1] << 1) | (tweak[0] >> 31);
+   tweak[0] = (tweak[0] << 1) ^ (carry * 0x87);
+}
+
+//-----------------------------------------------------------------------------
+// SI32_AES_acquire
+//
+//-----------------------------------------------------------------------------
+static bool
+SI32_AES_acquire(void)
+{
+   uint32_t primask = __get_PRIMASK();
+
+   __disable_irq();
+   if (SI32_AES_engine.busy)
+   {
+      __set_PRIMASK(primask);
+      return false;
+   }
+   SI32_AES_engine.busy = true;
+   __set_PRIMASK(primask);
+   return true;
+}
+
+//-----------------------------------------------------------------------------
+// SI32_AES_load_key
+//
+//-----------------------------------------------------------------------------
+static void
+SI32_AES_load_key(
+   const SI32_AES_Key_Type *key,
+   bool decrypt)
+{
+   const uint32_t *words = decrypt ? key->decrypt_key : key->key;
+   uint32_t i;
+
+   if ((SI32_AES_engine.loaded != key) || (SI32_AES_engine.loaded_decrypt != decrypt))
+   {
+      for (i = 0; i < key->words; i++)
+      {
+         SI32_AES_HWKEY(i) = words[i];
+      }
+      SI32_AES_engine.loaded = key;
+      SI32_AES_engine.loaded_decrypt = decrypt;
+   }
+}
+
+//-----------------------------------------------------------------------------
+// SI32_AES_process_block
+//
+// Processes one block by the CPU with the key in the module.
+//-----------------------------------------------------------------------------
+static void
+SI32_AES_process_block(
+   uint32_t control,
+   const uint8_t *input,
+   uint8_t *output)
+{
+   uint32_t data[4];
+   uint32_t i;
+
+   memcpy(data, input, sizeof(data));
+
+   SI32_AES_MODULE->CONTROL.U32 = control | SI32_AES_REG(CONTROL_SWMDEN_ENABLED_U32);
+   SI32_AES_MODULE->XFRSIZE.U32 = 0;
+   SI32_AES_MODULE->STATUS_CLR = SI32_AES_REG(STATUS_OCI_MASK) | SI32_AES_ERROR_MASK;
+   for (i = 0; i < 4; i++)
+   {
+      SI32_AES_MODULE->DATAFIFO.U32 = data[i];
+   }
+   SI32_AES_MODULE->CONTROL_SET = SI32_AES_REG(CONTROL_XFRSTA_MASK);
+
+   while (!(SI32_AES_MODULE->STATUS.U32 & SI32_AES_REG(STATUS_OCI_MASK)))
+   {
+   }
+   for (i = 0; i < 4; i++)
+   {
+      data[i] = SI32_AES_MODULE->DATAFIFO.U32;
+   }
+
+   memcpy(output, data, sizeof(data));
+}
+
+//-----------------------------------------------------------------------------
+// SI32_AES_process_xts_block
+//
+//-----------------------------------------------------------------------------
+static void
+SI32_AES_process_xts_block(
+   uint32_t control,
+   const uint8_t *input,
+   uint8_t *output,
+   const uint32_t *tweak)
+{
+   uint8_t block[SI32_AES_BLOCK_SIZE];
+
+   SI32_AES_xor_block(block, input, (const uint8_t *)tweak);
+   SI32_AES_process_block(control, block, block);
+   SI32_AES_xor_block(output, block, (const uint8_t *)tweak);
+}
+
+//-----------------------------------------------------------------------------
+// SI32_AES_select_key
+//
+// Loads a key in the module, capturing its decryption key first if needed,
+// and returns the module control for it.
+//-----------------------------------------------------------------------------
+static uint32_t
+SI32_AES_select_key(
+   SI32_AES_Key_Type *key,
+   bool decrypt)
+{
+   uint32_t control = (uint32_t)((key->words - 4) / 2) << SI32_AES_REG(CONTROL_KEYSIZE_SHIFT);
+   uint8_t block[SI32_AES_BLOCK_SIZE];
+   uint32_t i;
+
+   if (decrypt && !key->has_decrypt_key)
+   {
+      // The module leaves the last round key in the key registers when it
+      // encrypts with key capture enabled.
+      memset(block, 0, sizeof(block));
+      SI32_AES_load_key(key, false);
+      SI32_AES_process_block(control
+                             | SI32_AES_REG(CONTROL_EDMD_ENCRYPT_U32)
+                             | SI32_AES_REG(CONTROL_KEYCPEN_MASK),
+                             block, block);
+      for (i = 0; i < key->words; i++)
+      {
+         key->decrypt_key[i] = SI32_AES_HWKEY(i);
+      }
+      key->has_decrypt_key = true;
+      SI32_AES_engine.loaded_decrypt = true;
+   }
+   SI32_AES_load_key(key, decrypt);
+
+   if (!decrypt)
+   {
+      control |= SI32_AES_REG(CONTROL_EDMD_ENCRYPT_U32);
+   }
+   return control;
+}
+
+//-----------------------------------------------------------------------------
+// SI32_AES_setup
+//
+//-----------------------------------------------------------------------------
+static void
+SI32_AES_setup(
+   SI32_AES_MODE_Enum_Type mode,
+   SI32_AES_Key_Type *key,
+   bool decrypt,
+   const uint8_t *input,
+   uint8_t *output)
+{
+   SI32_AES_engine.mode = mode;
+   SI32_AES_engine.decrypt = decrypt;
+   SI32_AES_engine.control = SI32_AES_select_key(key, decrypt);
+   SI32_AES_engine.input = input;
+   SI32_AES_engine.output = output;
+   SI32_AES_engine.tail = 0;
+   SI32_AES_engine.iv = NULL;
+}
+
+//-----------------------------------------------------------------------------
+// SI32_AES_process_cpu
+//
+// Processes whole blocks of the operation in progress by the CPU.
+//-----------------------------------------------------------------------------
+static void
+SI32_AES_process_cpu(
+   uint32_t blocks)
+{
+   uint32_t control = SI32_AES_engine.control;
+   uint8_t *chain = (uint8_t *)SI32_AES_engine.chain;
+   const uint8_t *input = SI32_AES_engine.input;
+   uint8_t *output = SI32_AES_engine.output;
+   uint8_t block[SI32_AES_BLOCK_SIZE];
+
+   while (blocks--)
+   {
+      switch (SI32_AES_engine.mode)
+      {
+      case SI32_AES_MODE_ECB:
+         SI32_AES_process_block(control, input, output);
+         break;
+
+      case SI32_AES_MODE_CBC:
+         if (SI32_AES_engine.decrypt)
+         {
+            // The output may overwrite the input
+            memcpy(block, input, sizeof(block));
+            SI32_AES_process_block(control, block, output);
+            SI32_AES_xor_block(output, output, chain);
+            memcpy(chain, block, sizeof(block));
+         }
+         else
+         {
+            SI32_AES_xor_block(block, input, chain);
+            SI32_AES_process_block(control, block, output);
+            memcpy(chain, output, sizeof(block));
+         }
+         break;
+
+      case SI32_AES_MODE_CTR:
+         SI32_AES_process_block(control, chain, block);
+         SI32_AES_xor_block(output, input, block);
+         SI32_AES_increment(SI32_AES_engine.chain);
+         break;
+
+      default:
+         SI32_AES_process_xts_block(control, input, output, SI32_AES_engine.chain);
+         SI32_AES_multiply_alpha(SI32_AES_engine.chain);
+         break;
+      }
+      input += SI32_AES_BLOCK_SIZE;
+      output += SI32_AES_BLOCK_SIZE;
+   }
+
+   SI32_AES_engine.input = input;
+   SI32_AES_engine.output = output;
+}
+
+//-----------------------------------------------------------------------------
+// SI32_AES_fill
+//
+// Writes the counters or tweaks of the next blocks to a scratch half and
+// returns how many were written.
+//-----------------------------------------------------------------------------
+static uint32_t
+SI32_AES_fill(
+   uint32_t half,
+   uint32_t blocks)
+{
+   uint32_t *next = SI32_AES_scratch[half];
+   uint32_t i;
+
+   if (blocks > SI32_AES_SCRATCH_BLOCKS)
+   {
+      blocks = SI32_AES_SCRATCH_BLOCKS;
+   }
+
+   for (i = 0; i < blocks; i++)
+   {
+      next[0] = SI32_AES_engine.chain[0];
+      next[1] = SI32_AES_engine.chain[1];
+      next[2] = SI32_AES_engine.chain[2];
+      next[3] = SI32_AES_engine.chain[3];
+      next += 4;
+
+      if (SI32_AES_engine.mode == SI32_AES_MODE_CTR)
+      {
+         SI32_AES_increment(SI32_AES_engine.chain);
+      }
+      else
+      {
+         SI32_AES_multiply_alpha(SI32_AES_engine.chain);
+      }
+   }
+   return blocks;
+}
+
+//-----------------------------------------------------------------------------
+// SI32_AES_configure_task
+//
+//-----------------------------------------------------------------------------
+static void
+SI32_AES_configure_task(
+   SI32_DMADESC_A_Type *desc,
+   void volatile *fifo,
+   const uint8_t *memory,
+   uint32_t words,
+   bool receive,
+   bool more)
+{
+   if (receive)
+   {
+      SI32_DMADESC_A_configure(desc, fifo, (void volatile *)memory, words,
+         (more ? SI32_DMADESC_A_CONFIG_WORD_RX_SG : SI32_DMADESC_A_CONFIG_WORD_RX)
+         | SI32_DMADESC_A_CONFIG_RPOWER(SI32_AES_DMA_RPOWER));
+   }
+   else
+   {
+      SI32_DMADESC_A_configure(desc, (void volatile *)memory, fifo, words,
+         (more ? SI32_DMADESC_A_CONFIG_WORD_TX_SG : SI32_DMADESC_A_CONFIG_WORD_TX)
+         | SI32_DMADESC_A_CONFIG_RPOWER(SI32_AES_DMA_RPOWER));
+   }
+}
+
+//-----------------------------------------------------------------------------
+// SI32_AES_configure_channel
+//
+// Sets up a channel to move words between memory and a FIFO, through a
+// chain of scatter-gather tasks when a single descriptor cannot move them.
+//-----------------------------------------------------------------------------
+static void
+SI32_AES_configure_channel(
+   uint32_t channel,
+   SI32_DMADESC_A_Type *tasks,
+   void volatile *fifo,
+   const uint8_t *memory,
+   uint32_t words,
+   bool receive)
+{
+   SI32_DMADESC_A_Type *desc = SI32_DMA_get_primary_descriptor(channel);
+   uint32_t count = 0;
+   uint32_t chunk;
+
+   if (words <= SI32_DMA_MAX_COUNT)
+   {
+      SI32_AES_configure_task(desc, fifo, memory, words, receive, false);
+      return;
+   }
+
+   assert(tasks != NULL);
+   while (words > 0)
+   {
+      chunk = (words > SI32_DMA_MAX_COUNT) ? SI32_DMA_MAX_COUNT : words;
+      words -= chunk;
+      SI32_AES_configure_task(&tasks[count++], fifo, memory, chunk, receive, words > 0);
+      memory += chunk * 4;
+   }
+   SI32_DMADESC_A_configure_peripheral_scatter_gather(desc, tasks, count);
+}
+
+//-----------------------------------------------------------------------------
+// SI32_AES_start_run
+//
+// Starts the module and its DMA channels on the next run of blocks. Returns
+// false once every block has been started.
+//-----------------------------------------------------------------------------
+static bool
+SI32_AES_start_run(void)
+{
+   uint32_t control = SI32_AES_engine.control;
+   const uint8_t *data = SI32_AES_engine.input;
+   const uint8_t *xor_data = NULL;
+   uint32_t run;
+   uint32_t i;
+
+   if (SI32_AES_engine.blocks == 0)
+   {
+      return false;
+   }
+
+   switch (SI32_AES_engine.mode)
+   {
+   case SI32_AES_MODE_ECB:
+   case SI32_AES_MODE_CBC:
+      run = SI32_AES_engine.blocks;
+      if (run > SI32_AES_MAX_RUN_BLOCKS)
+      {
+         run = SI32_AES_MAX_RUN_BLOCKS;
+      }
+      if (SI32_AES_engine.mode == SI32_AES_MODE_CBC)
+      {
+         control |= SI32_AES_REG(CONTROL_HCBCEN_MASK)
+                    | (SI32_AES_engine.decrypt ? SI32_AES_REG(CONTROL_XOREN_XOR_OUTPUT_U32)
+                                               : SI32_AES_REG(CONTROL_XOREN_XOR_INPUT_U32));
+      }
+      break;
+
+   case SI32_AES_MODE_CTR:
+      // The counters are encrypted and the input comes in through the XOR
+      // FIFO to be combined with them.
+      run = SI32_AES_engine.filled[SI32_AES_engine.half];
+      data = (const uint8_t *)SI32_AES_scratch[SI32_AES_engine.half];
+      xor_data = SI32_AES_engine.input;
+      control |= SI32_AES_REG(CONTROL_XOREN_XOR_OUTPUT_U32);
+      break;
+
+   default:
+      // The tweak is added on the way in here, and again by the CPU once the
+      // run is done.
+      run = SI32_AES_engine.filled[SI32_AES_engine.half];
+      xor_data = (const uint8_t *)SI32_AES_scratch[SI32_AES_engine.half];
+      control |= SI32_AES_REG(CONTROL_XOREN_XOR_INPUT_U32);
+      break;
+   }
+
+   SI32_AES_MODULE->CONTROL.U32 = control;
+   SI32_AES_MODULE->XFRSIZE.U32 = run - 1;
+   SI32_AES_MODULE->STATUS_CLR = SI32_AES_REG(STATUS_OCI_MASK) | SI32_AES_ERROR_MASK;
+
+   if (SI32_AES_engine.mode == SI32_AES_MODE_CBC)
+   {
+      for (i = 0; i < 4; i++)
+      {
+         SI32_AES_MODULE->XORFIFO.U32 = SI32_AES_engine.chain[i];
+      }
+      if (SI32_AES_engine.decrypt)
+      {
+         memcpy(SI32_AES_engine.next_chain,
+                &SI32_AES_engine.input[(run - 1) * SI32_AES_BLOCK_SIZE],
+                SI32_AES_BLOCK_SIZE);
+      }
+   }
+
+   SI32_AES_configure_channel(SI32_AES_engine.rx_channel, SI32_AES_rx_tasks,
+      &SI32_AES_MODULE->DATAFIFO.U32, SI32_AES_engine.output, run * 4, true);
+   SI32_AES_configure_channel(SI32_AES_engine.tx_channel, SI32_AES_tx_tasks,
+      &SI32_AES_MODULE->DATAFIFO.U32, data, run * 4, false);
+   SI32_DMA_start_channel(SI32_AES_engine.rx_channel, true);
+   SI32_DMA_start_channel(SI32_AES_engine.tx_channel, false);
+   if (xor_data != NULL)
+   {
+      SI32_AES_configure_channel(SI32_AES_engine.xor_channel, NULL,
+         &SI32_AES_MODULE->XORFIFO.U32, xor_data, run * 4, false);
+      SI32_DMA_start_channel(SI32_AES_engine.xor_channel, false);
+   }
+
+   SI32_AES_MODULE->CONTROL_SET = SI32_AES_REG(CONTROL_XFRSTA_MASK);
+
+   SI32_AES_engine.run = run;
+   SI32_AES_engine.blocks -= run;
+   return true;
+}
+
+//-----------------------------------------------------------------------------
+// SI32_AES_finish
+//
+// Processes the partial blocks, hands the chaining value back to the caller
+// and releases the module.
+//-----------------------------------------------------------------------------
+static SI32_DMA_STATUS_Enum_Type
+SI32_AES_finish(
+   SI32_DMA_STATUS_Enum_Type status)
+{
+   uint32_t control = SI32_AES_engine.control;
+   const uint8_t *input = SI32_AES_engine.input;
+   uint8_t *output = SI32_AES_engine.output;
+   uint32_t tail = SI32_AES_engine.tail;
+   SI32_AES_callback_t callback = SI32_AES_engine.callback;
+   void *user = SI32_AES_engine.user;
+   uint8_t block[SI32_AES_BLOCK_SIZE];
+   uint8_t last[SI32_AES_BLOCK_SIZE];
+   uint32_t tweak[4];
+   uint32_t i;
+
+   if ((status == SI32_DMA_STATUS_OK) && (tail > 0))
+   {
+      if (SI32_AES_engine.mode == SI32_AES_MODE_CTR)
+      {
+         SI32_AES_process_block(control, (const uint8_t *)SI32_AES_engine.chain,
+                                SI32_AES_engine.stream_block);
+         SI32_AES_increment(SI32_AES_engine.chain);
+         for (i = 0; i < tail; i++)
+         {
+            output[i] = input[i] ^ SI32_AES_engine.stream_block[i];
+         }
+         *SI32_AES_engine.nc_off = tail;
+      }
+      else
+      {
+         // Ciphertext stealing over the last whole block and the tail. The
+         // whole block is processed with the tweak of the tail first when
+         // decrypting.
+         memcpy(tweak, SI32_AES_engine.chain, sizeof(tweak));
+         SI32_AES_multiply_alpha(tweak);
+
+         SI32_AES_process_xts_block(control, input, block,
+            SI32_AES_engine.decrypt ? tweak : SI32_AES_engine.chain);
+         memcpy(last, &input[SI32_AES_BLOCK_SIZE], tail);
+         memcpy(&last[tail], &block[tail], SI32_AES_BLOCK_SIZE - tail);
+         memcpy(&output[SI32_AES_BLOCK_SIZE], block, tail);
+         SI32_AES_process_xts_block(control, last, output,
+            SI32_AES_engine.decrypt ? SI32_AES_engine.chain : tweak);
+      }
+   }
+
+   if ((status == SI32_DMA_STATUS_OK) && (SI32_AES_engine.iv != NULL))
+   {
+      memcpy(SI32_AES_engine.iv, SI32_AES_engine.chain, SI32_AES_BLOCK_SIZE);
+   }
+
+   SI32_AES_engine.async = false;
+   SI32_AES_engine.busy = false;
+
+   if (callback != NULL)
+   {
+      callback(status, user);
+   }
+   return status;
+}
+
+//-----------------------------------------------------------------------------
+// SI32_AES_run_done
+//
+// Completes the run whose last block has been read and starts the next one.
+// Returns SI32_DMA_STATUS_BUSY while runs are left, the operation status
+// otherwise.
+//-----------------------------------------------------------------------------
+static SI32_DMA_STATUS_Enum_Type
+SI32_AES_run_done(void)
+{
+   uint8_t *output = SI32_AES_engine.output;
+   uint32_t half = SI32_AES_engine.half;
+   uint32_t run = SI32_AES_engine.run;
+   bool started;
+   uint32_t i;
+
+   if (SI32_DMA_check_bus_error())
+   {
+      return SI32_AES_finish(SI32_DMA_STATUS_BUS_ERROR);
+   }
+   if (SI32_AES_MODULE->STATUS.U32 & SI32_AES_ERROR_MASK)
+   {
+      return SI32_AES_finish(SI32_DMA_STATUS_OVERRUN);
+   }
+
+   SI32_AES_engine.input += run * SI32_AES_BLOCK_SIZE;
+   SI32_AES_engine.output += run * SI32_AES_BLOCK_SIZE;
+   if (SI32_AES_engine.mode == SI32_AES_MODE_CBC)
+   {
+      memcpy(SI32_AES_engine.chain,
+             SI32_AES_engine.decrypt ? (const uint8_t *)SI32_AES_engine.next_chain
+                                     : SI32_AES_engine.output - SI32_AES_BLOCK_SIZE,
+             SI32_AES_BLOCK_SIZE);
+   }
+
+   // The other scratch half is ready, keep the module busy while this one
+   // is released and refilled.
+   SI32_AES_engine.half ^= 1;
+   started = SI32_AES_start_run();
+
+   if (SI32_AES_engine.mode == SI32_AES_MODE_XTS)
+   {
+      for (i = 0; i < run; i++)
+      {
+         SI32_AES_xor_block(&output[i * SI32_AES_BLOCK_SIZE],
+                            &output[i * SI32_AES_BLOCK_SIZE],
+                            (const uint8_t *)&SI32_AES_scratch[half][i * 4]);
+      }
+   }
+   if (!started)
+   {
+      return SI32_AES_finish(SI32_DMA_STATUS_OK);
+   }
+   if (SI32_AES_engine.mode >= SI32_AES_MODE_CTR)
+   {
+      SI32_AES_engine.filled[half] = SI32_AES_fill(half, SI32_AES_engine.blocks);
+   }
+   return SI32_DMA_STATUS_BUSY;
+}
+
+//-----------------------------------------------------------------------------
+// SI32_AES_dma_done
+//
+// Receive channel completion of an asynchronous operation.
+//-----------------------------------------------------------------------------
+static void
+SI32_AES_dma_done(
+   uint32_t channel,
+   void *unused)
+{
+   (void)unused;
+
+   if (!SI32_AES_engine.async || !SI32_DMA_is_channel_done(channel))
+   {
+      return;
+   }
+   (void)SI32_AES_run_done();
+}
+
+//-----------------------------------------------------------------------------
+// SI32_AES_execute
+//
+// Processes the whole blocks of the operation set up in the engine, by DMA
+// when the buffers allow it, then finishes the operation.
+//-----------------------------------------------------------------------------
+static SI32_DMA_STATUS_Enum_Type
+SI32_AES_execute(
+   uint32_t blocks,
+   SI32_AES_callback_t callback,
+   void *user)
+{
+   bool pipelined = SI32_AES_engine.mode >= SI32_AES_MODE_CTR;
+   SI32_DMA_STATUS_Enum_Type status;
+
+   SI32_AES_engine.callback = callback;
+   SI32_AES_engine.user = user;
+
+   if (!SI32_AES_engine.has_channels
+       || (pipelined && !SI32_AES_engine.has_xor_channel)
+       || (blocks < SI32_AES_MIN_DMA_BLOCKS)
+       || ((((uint32_t)SI32_AES_engine.input) | ((uint32_t)SI32_AES_engine.output)) & 3))
+   {
+      SI32_AES_process_cpu(blocks);
+      return SI32_AES_finish(SI32_DMA_STATUS_OK);
+   }
+
+   SI32_AES_engine.blocks = blocks;
+   SI32_AES_engine.half = 0;
+   if (pipelined)
+   {
+      SI32_AES_engine.filled[0] = SI32_AES_fill(0, blocks);
+      SI32_AES_engine.filled[1] = SI32_AES_fill(1, blocks - SI32_AES_engine.filled[0]);
+   }
+   SI32_AES_engine.async = (callback != NULL);
+   (void)SI32_AES_start_run();
+
+   if (SI32_AES_engine.async)
+   {
+      return SI32_DMA_STATUS_OK;
+   }
+
+   do
+   {
+      while (!SI32_DMA_is_channel_done(SI32_AES_engine.rx_channel))
+      {
+      }
+      if (!SI32_AES_engine.busy)
+      {
+         return SI32_DMA_STATUS_ABORTED;
+      }
+      status = SI32_AES_run_done();
+   } while (status == SI32_DMA_STATUS_BUSY);
+
+   return status;
+}
+
+//-----------------------------------------------------------------------------
+// SI32_AES_self_test
+//
+//-----------------------------------------------------------------------------
+static bool
+SI32_AES_self_test(void)
+{
+   SI32_AES_Key_Type key;
+   uint32_t block[16];
+   uint8_t iv[SI32_AES_BLOCK_SIZE];
+   uint8_t *data = (uint8_t *)block;
+   bool passed;
+
+   // Single block, which also captures a decryption key
+   (void)SI32_AES_set_key(&key, SI32_AES_fips197_key, 128);
+   memcpy(data, SI32_AES_fips197_plain, SI32_AES_BLOCK_SIZE);
+   passed = (SI32_AES_crypt_ecb(&key, SI32_AES_ENCRYPT, data, data, SI32_AES_BLOCK_SIZE,
+                NULL, NULL) == SI32_DMA_STATUS_OK)
+            && (memcmp(data, SI32_AES_fips197_cipher, SI32_AES_BLOCK_SIZE) == 0)
+            && (SI32_AES_crypt_ecb(&key, SI32_AES_DECRYPT, data, data, SI32_AES_BLOCK_SIZE,
+                   NULL, NULL) == SI32_DMA_STATUS_OK)
+            && (memcmp(data, SI32_AES_fips197_plain, SI32_AES_BLOCK_SIZE) == 0);
+
+   // Hardware chaining, moved by the DMA when the channels are available
+   if (passed)
+   {
+      (void)SI32_AES_set_key(&key, SI32_AES_sp800_key, 128);
+      memcpy(data, SI32_AES_sp800_plain, sizeof(block));
+      memcpy(iv, SI32_AES_sp800_iv, sizeof(iv));
+      passed = (SI32_AES_crypt_cbc(&key, SI32_AES_ENCRYPT, iv, data, data, sizeof(block),
+                   NULL, NULL) == SI32_DMA_STATUS_OK)
+               && (memcmp(data, SI32_AES_sp800_cipher, sizeof(block)) == 0);
+
+      memcpy(iv, SI32_AES_sp800_iv, sizeof(iv));
+      passed = passed
+               && (SI32_AES_crypt_cbc(&key, SI32_AES_DECRYPT, iv, data, data, sizeof(block),
+                      NULL, NULL) == SI32_DMA_STATUS_OK)
+               && (memcmp(data, SI32_AES_sp800_plain, sizeof(block)) == 0);
+   }
+
+   SI32_AES_clear_key(&key);
+   return passed;
+}
+
+//-----------------------------------------------------------------------------
+// SI32_AES_init
+//
+//-----------------------------------------------------------------------------
+SI32_DMA_STATUS_Enum_Type
+SI32_AES_init(
+   const SI32_AES_Config_Type *config)
+{
+   SI32_DMA_STATUS_Enum_Type status = SI32_DMA_STATUS_OK;
+   int32_t tx_channel;
+   int32_t rx_channel;
+   int32_t xor_channel;
+
+   if (SI32_AES_engine.busy)
+   {
+      return SI32_DMA_STATUS_BUSY;
+   }
+
+   SI32_CLKCTRL_A_enable_apb_to_modules_0(SI32_CLKCTRL_0,
+      SI32_CLKCTRL_A_APBCLKG0_AES0CEN_MASK);
+   SI32_AES_REG(reset_module)(SI32_AES_MODULE);
+   SI32_AES_engine.loaded = NULL;
+
+   SI32_DMA_init();
+   if (!SI32_AES_engine.has_channels)
+   {
+      tx_channel = SI32_DMA_claim_channel(config->tx_chnsel, NULL, NULL);
+      rx_channel = SI32_DMA_claim_channel(config->rx_chnsel, SI32_AES_dma_done, NULL);
+      if ((tx_channel < 0) || (rx_channel < 0))
+      {
+         if (tx_channel >= 0)
+         {
+            SI32_DMA_release_channel((uint32_t)tx_channel);
+         }
+         if (rx_channel >= 0)
+         {
+            SI32_DMA_release_channel((uint32_t)rx_channel);
+         }
+         status = SI32_DMA_STATUS_NO_CHANNEL;
+      }
+      else
+      {
+         SI32_AES_engine.tx_channel = (uint32_t)tx_channel;
+         SI32_AES_engine.rx_channel = (uint32_t)rx_channel;
+         SI32_AES_engine.has_channels = true;
+      }
+   }
+   if (!SI32_AES_engine.has_xor_channel)
+   {
+      xor_channel = SI32_DMA_claim_channel(config->xor_chnsel, NULL, NULL);
+      if (xor_channel < 0)
+      {
+         status = SI32_DMA_STATUS_NO_CHANNEL;
+      }
+      else
+      {
+         SI32_AES_engine.xor_channel = (uint32_t)xor_channel;
+         SI32_AES_engine.has_xor_channel = true;
+      }
+   }
+
+   SI32_AES_engine.ready = true;
+   if (!SI32_AES_self_test())
+   {
+      SI32_AES_engine.ready = false;
+      if (status == SI32_DMA_STATUS_OK)
+      {
+         status = SI32_DMA_STATUS_INVALID_PARAMETER;
+      }
+   }
+   return status;
+}
+
+//-----------------------------------------------------------------------------
+// SI32_AES_set_key
+//
+//-----------------------------------------------------------------------------
+SI32_DMA_STATUS_Enum_Type
+SI32_AES_set_key(
+   SI32_AES_Key_Type *key,
+   const uint8_t *data,
+   uint32_t bits)
+{
+   if ((bits != 128) && (bits != 192) && (bits != 256))
+   {
+      return SI32_DMA_STATUS_INVALID_PARAMETER;
+   }
+
+   if (SI32_AES_engine.loaded == key)
+   {
+      SI32_AES_engine.loaded = NULL;
+   }
+   memcpy(key->key, data, bits / 8);
+   key->words = (uint8_t)(bits / 32);
+   key->has_decrypt_key = false;
+   return SI32_DMA_STATUS_OK;
+}
+
+//-----------------------------------------------------------------------------
+// SI32_AES_clear_key
+//
+//-----------------------------------------------------------------------------
+void
+SI32_AES_clear_key(
+   SI32_AES_Key_Type *key)
+{
+   volatile uint8_t *byte = (volatile uint8_t *)key;
+   uint32_t i;
+
+   if (SI32_AES_engine.loaded == key)
+   {
+      SI32_AES_engine.loaded = NULL;
+      if (!SI32_AES_engine.busy)
+      {
+         for (i = 0; i < 8; i++)
+         {
+            SI32_AES_HWKEY(i) = 0;
+         }
+      }
+   }
+   for (i = 0; i < sizeof(*key); i++)
+   {
+      byte[i] = 0;
+   }
+}
+
+//-----------------------------------------------------------------------------
+// SI32_AES_crypt_ecb
+//
+//-----------------------------------------------------------------------------
+SI32_DMA_STATUS_Enum_Type
+SI32_AES_crypt_ecb(
+   SI32_AES_Key_Type *key,
+   SI32_AES_DIRECTION_Enum_Type direction,
+   const uint8_t *input,
+   uint8_t *output,
+   uint32_t length,
+   SI32_AES_callback_t callback,
+   void *user)
+{
+   if (!SI32_AES_engine.ready || (length % SI32_AES_BLOCK_SIZE))
+   {
+      return SI32_DMA_STATUS_INVALID_PARAMETER;
+   }
+   if (!SI32_AES_acquire())
+   {
+      return SI32_DMA_STATUS_BUSY;
+   }
+
+   SI32_AES_setup(SI32_AES_MODE_ECB, key, direction == SI32_AES_DECRYPT, input, output);
+   return SI32_AES_execute(length / SI32_AES_BLOCK_SIZE, callback, user);
+}
+
+//-----------------------------------------------------------------------------
+// SI32_AES_crypt_cbc
+//
+//-----------------------------------------------------------------------------
+SI32_DMA_STATUS_Enum_Type
+SI32_AES_crypt_cbc(
+   SI32_AES_Key_Type *key,
+   SI32_AES_DIRECTION_Enum_Type direction,
+   uint8_t iv[16],
+   const uint8_t *input,
+   uint8_t *output,
+   uint32_t length,
+   SI32_AES_callback_t callback,
+   void *user)
+{
+   if (!SI32_AES_engine.ready || (length % SI32_AES_BLOCK_SIZE))
+   {
+      return SI32_DMA_STATUS_INVALID_PARAMETER;
+   }
+   if (!SI32_AES_acquire())
+   {
+      return SI32_DMA_STATUS_BUSY;
+   }
+
+   SI32_AES_setup(SI32_AES_MODE_CBC, key, direction == SI32_AES_DECRYPT, input, output);
+   memcpy(SI32_AES_engine.chain, iv, SI32_AES_BLOCK_SIZE);
+   SI32_AES_engine.iv = iv;
+   return SI32_AES_execute(length / SI32_AES_BLOCK_SIZE, callback, user);
+}
+
+//-----------------------------------------------------------------------------
+// SI32_AES_crypt_ctr
+//
+//-----------------------------------------------------------------------------
+SI32_DMA_STATUS_Enum_Type
+SI32_AES_crypt_ctr(
+   SI32_AES_Key_Type *key,
+   uint32_t *nc_off,
+   uint8_t nonce_counter[16],
+   uint8_t stream_block[16],
+   const uint8_t *input,
+   uint8_t *output,
+   uint32_t length,
+   SI32_AES_callback_t callback,
+   void *user)
+{
+   uint32_t offset = *nc_off;
+
+   if (!SI32_AES_engine.ready || (offset >= SI32_AES_BLOCK_SIZE))
+   {
+      return SI32_DMA_STATUS_INVALID_PARAMETER;
+   }
+   if (!SI32_AES_acquire())
+   {
+      return SI32_DMA_STATUS_BUSY;
+   }
+
+   // Use up the key stream left by the previous call
+   while ((offset != 0) && (length > 0))
+   {
+      *output++ = *input++ ^ stream_block[offset];
+      offset = (offset + 1) % SI32_AES_BLOCK_SIZE;
+      length--;
+   }
+   *nc_off = offset;
+
+   SI32_AES_setup(SI32_AES_MODE_CTR, key, false, input, output);
+   memcpy(SI32_AES_engine.chain, nonce_counter, SI32_AES_BLOCK_SIZE);
+   SI32_AES_engine.iv = nonce_counter;
+   SI32_AES_engine.stream_block = stream_block;
+   SI32_AES_engine.nc_off = nc_off;
+   SI32_AES_engine.tail = length % SI32_AES_BLOCK_SIZE;
+   return SI32_AES_execute(length / SI32_AES_BLOCK_SIZE, callback, user);
+}
+
+//-----------------------------------------------------------------------------
+// SI32_AES_crypt_xts
+//
+//-----------------------------------------------------------------------------
+SI32_DMA_STATUS_Enum_Type
+SI32_AES_crypt_xts(
+   SI32_AES_Key_Type *data_key,
+   SI32_AES_Key_Type *tweak_key,
+   SI32_AES_DIRECTION_Enum_Type direction,
+   const uint8_t data_unit[16],
+   const uint8_t *input,
+   uint8_t *output,
+   uint32_t length,
+   SI32_AES_callback_t callback,
+   void *user)
+{
+   uint32_t tail = length % SI32_AES_BLOCK_SIZE;
+   uint32_t blocks = length / SI32_AES_BLOCK_SIZE;
+
+   if (!SI32_AES_engine.ready || (length < SI32_AES_BLOCK_SIZE))
+   {
+      return SI32_DMA_STATUS_INVALID_PARAMETER;
+   }
+   if (!SI32_AES_acquire())
+   {
+      return SI32_DMA_STATUS_BUSY;
+   }
+
+   SI32_AES_process_block(SI32_AES_select_key(tweak_key, false), data_unit,
+                          (uint8_t *)SI32_AES_engine.chain);
+
+   // The last whole block is left for ciphertext stealing
+   SI32_AES_setup(SI32_AES_MODE_XTS, data_key, direction == SI32_AES_DECRYPT, input, output);
+   SI32_AES_engine.tail = tail;
+   return SI32_AES_execute(tail ? blocks - 1 : blocks, callback, user);
+}
+
+//-----------------------------------------------------------------------------
+// SI32_AES_is_busy
+//
+//-----------------------------------------------------------------------------
+bool
+SI32_AES_is_busy(void)
+{
+   return SI32_AES_engine.busy;
+}
+
+//-----------------------------------------------------------------------------
+// SI32_AES_abort
+//
+//-----------------------------------------------------------------------------
+void
+SI32_AES_abort(void)
+{
+   SI32_AES_callback_t callback;
+   void *user;
+   uint32_t primask = __get_PRIMASK();
+
+   __disable_irq();
+   if (!SI32_AES_engine.busy)
+   {
+      __set_PRIMASK(primask);
+      return;
+   }
+
+   if (SI32_AES_engine.has_channels)
+   {
+      SI32_DMA_stop_channel(SI32_AES_engine.rx_channel);
+      SI32_DMA_stop_channel(SI32_AES_engine.tx_channel);
+   }
+   if (SI32_AES_engine.has_xor_channel)
+   {
+      SI32_DMA_stop_channel(SI32_AES_engine.xor_channel);
+   }
+   SI32_AES_REG(reset_module)(SI32_AES_MODULE);
+   SI32_AES_engine.loaded = NULL;
+
+   callback = SI32_AES_engine.callback;
+   user = SI32_AES_engine.user;
+   SI32_AES_engine.async = false;
+   SI32_AES_engine.busy = false;
+   __set_PRIMASK(primask);
+
+   if (callback != NULL)
+   {
+      callback(SI32_DMA_STATUS_ABORTED, user);
+   }
+}
+
+//-eof--------------------------------------------------------------------------
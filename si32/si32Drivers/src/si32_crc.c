@@ -0,0 +1,701 @@
+//------------------------------------------------------------------------------
+// Copyright 2024 (c) Silicon Laboratories Inc.
+//
+// SPDX-License-Identifier: Zlib
+//
+// This siHAL software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+//------------------------------------------------------------------------------
+/// @file si32_crc.c
+
+#include <assert.h>
+#include <stddef.h>
+#include "si32_crc.h"
+#include "SI32_CLKCTRL_A_Type.h"
+
+#if defined(SI32_MCU_SIM3L1XX)
+#define SI32_CRC_MODULE        SI32_ECRC_0
+#define SI32_CRC_REG(name)     SI32_ECRC_A_##name
+#else
+#define SI32_CRC_MODULE        SI32_CRC_0
+#define SI32_CRC_REG(name)     SI32_CRC_A_##name
+#endif
+
+#define SI32_CRC_DATA_U8   (*(volatile uint8_t *)&SI32_CRC_MODULE->DATA.U32)
+#define SI32_CRC_DATA_U16  (*(volatile uint16_t *)&SI32_CRC_MODULE->DATA.U32)
+
+// Transfers per DMA arbitration, 2^2 words
+#define SI32_CRC_DMA_RPOWER  2
+
+const SI32_CRC_Params_Type SI32_CRC_PARAMS_CRC32 =
+   { 32, 0x04C11DB7, 0xFFFFFFFF, true, true, 0xFFFFFFFF };
+const SI32_CRC_Params_Type SI32_CRC_PARAMS_CRC32_BZIP2 =
+   { 32, 0x04C11DB7, 0xFFFFFFFF, false, false, 0xFFFFFFFF };
+const SI32_CRC_Params_Type SI32_CRC_PARAMS_CRC32_MPEG2 =
+   { 32, 0x04C11DB7, 0xFFFFFFFF, false, false, 0x00000000 };
+const SI32_CRC_Params_Type SI32_CRC_PARAMS_CRC16_CCITT_FALSE =
+   { 16, 0x1021, 0xFFFF, false, false, 0x0000 };
+const SI32_CRC_Params_Type SI32_CRC_PARAMS_CRC16_XMODEM =
+   { 16, 0x1021, 0x0000, false, false, 0x0000 };
+const SI32_CRC_Params_Type SI32_CRC_PARAMS_CRC16_KERMIT =
+   { 16, 0x1021, 0x0000, true, true, 0x0000 };
+const SI32_CRC_Params_Type SI32_CRC_PARAMS_CRC16_ARC =
+   { 16, 0x8005, 0x0000, true, true, 0x0000 };
+const SI32_CRC_Params_Type SI32_CRC_PARAMS_CRC16_MODBUS =
+   { 16, 0x8005, 0xFFFF, true, true, 0x0000 };
+const SI32_CRC_Params_Type SI32_CRC_PARAMS_CRC16_DNP =
+   { 16, 0x3D65, 0x0000, true, true, 0xFFFF };
+const SI32_CRC_Params_Type SI32_CRC_PARAMS_CRC16_EN13757 =
+   { 16, 0x3D65, 0x0000, false, false, 0xFFFF };
+
+// Data checked by SI32_CRC_init(). The block is long enough to be moved by
+// the DMA when fed from its second byte.
+static const uint8_t SI32_CRC_check_data[] =
+   "123456789 The quick brown fox jumps over the lazy dog 0123456789ABCDEF";
+
+static struct
+{
+   SI32_CRC_Context_Type *owner;
+   bool ready;
+   bool has_channel;
+   uint32_t channel;
+   // Asynchronous update in progress
+   bool async;
+   const uint8_t *next;
+   uint32_t words;
+   uint32_t chunk;
+   uint32_t tail;
+   SI32_CRC_callback_t callback;
+   void *user;
+} SI32_CRC_engine;
+
+
+//-----------------------------------------------------------------------------
+// SI32_CRC_mask
+//
+//-----------------------------------------------------------------------------
+static uint32_t
+SI32_CRC_mask(
+   uint32_t width)
+{
+   uint32_t top = 1UL << (width - 1);
+
+   return top | (top - 1);
+}
+
+//-----------------------------------------------------------------------------
+// SI32_CRC_reflect
+//
+//-----------------------------------------------------------------------------
+static uint32_t
+SI32_CRC_reflect(
+   uint32_t value,
+   uint32_t width)
+{
+   uint32_t result = 0;
+   uint32_t i;
+
+   for (i = 0; i < width; i++)
+   {
+      result = (result << 1) | (value & 1);
+      value >>= 1;
+   }
+   return result;
+}
+
+//-----------------------------------------------------------------------------
+// SI32_CRC_preimage
+//
+// Returns the width-bit value that leaves state in a register seeded with
+// zeros, that is state * x^-width modulo the polynomial. Each step undoes
+// one shift of the register: an odd value had the polynomial folded in.
+//-----------------------------------------------------------------------------
+static uint32_t
+SI32_CRC_preimage(
+   const SI32_CRC_Params_Type *params,
+   uint32_t state)
+{
+   uint32_t top = 1UL << (params->width - 1);
+   uint32_t i;
+
+   for (i = 0; i < params->width; i++)
+   {
+      if (state & 1)
+      {
+         state = ((state ^ params->poly) >> 1) | top;
+      }
+      else
+      {
+         state >>= 1;
+      }
+   }
+   return state;
+}
+
+//-----------------------------------------------------------------------------
+// SI32_CRC_select_polynomial
+//
+// Returns the CONTROL polynomial selection for the parameters, or false if
+// the module does not implement them.
+//-----------------------------------------------------------------------------
+static bool
+SI32_CRC_select_polynomial(
+   const SI32_CRC_Params_Type *params,
+   uint32_t *control)
+{
+   if (params->width == 32)
+   {
+      *control = 0;
+      return params->poly == 0x04C11DB7;
+   }
+   if (params->width != 16)
+   {
+      return false;
+   }
+#if defined(SI32_MCU_SIM3L1XX)
+   *control = SI32_ECRC_A_CONTROL_POLYSEL_CRC16_PROG_U32;
+   return true;
+#else
+   switch (params->poly)
+   {
+      case 0x1021:
+         *control = SI32_CRC_A_CONTROL_POLYSEL_CRC_16_1021_U32;
+         return true;
+      case 0x3D65:
+         *control = SI32_CRC_A_CONTROL_POLYSEL_CRC_16_3D65_U32;
+         return true;
+      case 0x8005:
+         *control = SI32_CRC_A_CONTROL_POLYSEL_CRC_16_8005_U32;
+         return true;
+      default:
+         return false;
+   }
+#endif
+}
+
+//-----------------------------------------------------------------------------
+// SI32_CRC_acquire
+//
+//-----------------------------------------------------------------------------
+static bool
+SI32_CRC_acquire(
+   SI32_CRC_Context_Type *context)
+{
+   uint32_t primask = __get_PRIMASK();
+
+   __disable_irq();
+   if (SI32_CRC_engine.owner != NULL)
+   {
+      __set_PRIMASK(primask);
+      return false;
+   }
+   SI32_CRC_engine.owner = context;
+   __set_PRIMASK(primask);
+   return true;
+}
+
+//-----------------------------------------------------------------------------
+// SI32_CRC_load
+//
+// Configures the module for the context and restores its register.
+//-----------------------------------------------------------------------------
+static void
+SI32_CRC_load(
+   SI32_CRC_Context_Type *context)
+{
+   const SI32_CRC_Params_Type *params = context->params;
+   uint32_t polysel = 0;
+   uint32_t preimage = SI32_CRC_preimage(params, context->state);
+
+   (void)SI32_CRC_select_polynomial(params, &polysel);
+
+   // No reordering and no bit reversal: the preimage goes in MSB first.
+   SI32_CRC_MODULE->CONTROL.U32 = SI32_CRC_REG(CONTROL_CRCEN_ENABLED_U32) | polysel;
+#if defined(SI32_MCU_SIM3L1XX)
+   SI32_CRC_MODULE->POLY.U32 = params->poly & SI32_ECRC_A_POLY_POLY_MASK;
+#endif
+   SI32_CRC_MODULE->CONTROL_SET = SI32_CRC_REG(CONTROL_SINITEN_MASK);
+
+   if (params->width == 32)
+   {
+      SI32_CRC_MODULE->DATA.U32 = preimage;
+   }
+   else
+   {
+      SI32_CRC_DATA_U16 = (uint16_t)preimage;
+   }
+
+   if (params->refin)
+   {
+      SI32_CRC_MODULE->CONTROL_SET = SI32_CRC_REG(CONTROL_BBREN_MASK);
+   }
+}
+
+//-----------------------------------------------------------------------------
+// SI32_CRC_write_bytes
+//
+//-----------------------------------------------------------------------------
+static void
+SI32_CRC_write_bytes(
+   const uint8_t *data,
+   uint32_t length)
+{
+   SI32_CRC_MODULE->CONTROL_CLR = SI32_CRC_REG(CONTROL_ORDER_MASK);
+   while (length--)
+   {
+      SI32_CRC_DATA_U8 = *data++;
+   }
+}
+
+//-----------------------------------------------------------------------------
+// SI32_CRC_select_word_order
+//
+// Words are read little endian from memory, the module has to process
+// their lowest byte first.
+//-----------------------------------------------------------------------------
+static void
+SI32_CRC_select_word_order(void)
+{
+   SI32_CRC_MODULE->CONTROL_CLR = SI32_CRC_REG(CONTROL_ORDER_MASK);
+   SI32_CRC_MODULE->CONTROL_SET = SI32_CRC_REG(CONTROL_ORDER_BIG_ENDIAN_32_U32);
+}
+
+//-----------------------------------------------------------------------------
+// SI32_CRC_write_words
+//
+//-----------------------------------------------------------------------------
+static void
+SI32_CRC_write_words(
+   const uint8_t *data,
+   uint32_t words)
+{
+   const uint32_t *word = (const uint32_t *)data;
+
+   SI32_CRC_select_word_order();
+   while (words--)
+   {
+      SI32_CRC_MODULE->DATA.U32 = *word++;
+   }
+}
+
+//-----------------------------------------------------------------------------
+// SI32_CRC_start_dma
+//
+// Starts the DMA for the next chunk of the words left and returns its size.
+//-----------------------------------------------------------------------------
+static uint32_t
+SI32_CRC_start_dma(
+   const uint8_t *data,
+   uint32_t words)
+{
+   SI32_DMADESC_A_Type *desc = SI32_DMA_get_primary_descriptor(SI32_CRC_engine.channel);
+   uint32_t chunk = words;
+
+   if (chunk > SI32_DMA_MAX_COUNT)
+   {
+      chunk = SI32_DMA_MAX_COUNT;
+   }
+
+   SI32_CRC_select_word_order();
+   SI32_DMADESC_A_configure(desc, (void volatile *)data, &SI32_CRC_MODULE->DATA.U32, chunk,
+      SI32_DMADESC_A_CONFIG_WORD_TX_AUTO | SI32_DMADESC_A_CONFIG_RPOWER(SI32_CRC_DMA_RPOWER));
+   SI32_DMA_start_channel(SI32_CRC_engine.channel, false);
+   SI32_DMA_software_request(SI32_CRC_engine.channel);
+
+   return chunk;
+}
+
+//-----------------------------------------------------------------------------
+// SI32_CRC_store
+//
+// Saves the module register to the owner and releases the module.
+//-----------------------------------------------------------------------------
+static void
+SI32_CRC_store(
+   SI32_DMA_STATUS_Enum_Type status)
+{
+   SI32_CRC_Context_Type *context = SI32_CRC_engine.owner;
+
+   if (status == SI32_DMA_STATUS_OK)
+   {
+      context->state = SI32_CRC_MODULE->DATA.U32 & SI32_CRC_mask(context->params->width);
+   }
+   SI32_CRC_engine.async = false;
+   SI32_CRC_engine.owner = NULL;
+}
+
+//-----------------------------------------------------------------------------
+// SI32_CRC_dma_done
+//
+// DMA channel completion of an asynchronous update.
+//-----------------------------------------------------------------------------
+static void
+SI32_CRC_dma_done(
+   uint32_t channel,
+   void *unused)
+{
+   SI32_CRC_Context_Type *context = SI32_CRC_engine.owner;
+   SI32_DMA_STATUS_Enum_Type status = SI32_DMA_STATUS_OK;
+   SI32_CRC_callback_t callback;
+   void *user;
+
+   (void)unused;
+
+   if (!SI32_CRC_engine.async || !SI32_DMA_is_channel_done(channel))
+   {
+      return;
+   }
+
+   SI32_CRC_engine.next += SI32_CRC_engine.chunk * 4;
+   SI32_CRC_engine.words -= SI32_CRC_engine.chunk;
+
+   if (SI32_DMA_check_bus_error())
+   {
+      status = SI32_DMA_STATUS_BUS_ERROR;
+   }
+   else if (SI32_CRC_engine.words > 0)
+   {
+      SI32_CRC_engine.chunk = SI32_CRC_start_dma(SI32_CRC_engine.next,
+                                                 SI32_CRC_engine.words);
+      return;
+   }
+   else
+   {
+      SI32_CRC_write_bytes(SI32_CRC_engine.next, SI32_CRC_engine.tail);
+   }
+
+   callback = SI32_CRC_engine.callback;
+   user = SI32_CRC_engine.user;
+   SI32_CRC_store(status);
+
+   if (callback != NULL)
+   {
+      callback(context, status, user);
+   }
+}
+
+//-----------------------------------------------------------------------------
+// SI32_CRC_init
+//
+//-----------------------------------------------------------------------------
+SI32_DMA_STATUS_Enum_Type
+SI32_CRC_init(
+   SI32_DMAXBAR_CHNSEL_Enum_Type chnsel)
+{
+   SI32_DMA_STATUS_Enum_Type status = SI32_DMA_STATUS_OK;
+   const SI32_CRC_Params_Type *checks[] =
+   {
+      &SI32_CRC_PARAMS_CRC32,
+      &SI32_CRC_PARAMS_CRC32_MPEG2,
+      &SI32_CRC_PARAMS_CRC16_CCITT_FALSE,
+      &SI32_CRC_PARAMS_CRC16_KERMIT,
+   };
+   SI32_CRC_Context_Type context;
+   uint32_t i;
+   int32_t channel;
+
+   SI32_CLKCTRL_A_enable_apb_to_modules_0(SI32_CLKCTRL_0,
+      SI32_CLKCTRL_A_APBCLKG0_CRC0CEN_MASK);
+
+   if (!SI32_CRC_engine.has_channel)
+   {
+      SI32_DMA_init();
+      channel = SI32_DMA_claim_channel(chnsel, SI32_CRC_dma_done, NULL);
+      if (channel < 0)
+      {
+         status = SI32_DMA_STATUS_NO_CHANNEL;
+      }
+      else
+      {
+         SI32_CRC_engine.channel = (uint32_t)channel;
+         SI32_CRC_engine.has_channel = true;
+      }
+   }
+
+   // Check the module against the reference, both split in two updates
+   // starting from the seeds of the parameter sets and in one unaligned
+   // block moved by the DMA.
+   SI32_CRC_engine.ready = true;
+   for (i = 0; i < sizeof(checks) / sizeof(checks[0]); i++)
+   {
+      uint32_t expected = SI32_CRC_reference_update(checks[i], checks[i]->init,
+                             SI32_CRC_check_data, sizeof(SI32_CRC_check_data) - 1);
+
+      SI32_CRC_start(&context, checks[i]);
+      if ((SI32_CRC_update(&context, SI32_CRC_check_data, 9) != SI32_DMA_STATUS_OK)
+          || (SI32_CRC_update(&context, &SI32_CRC_check_data[9],
+                 sizeof(SI32_CRC_check_data) - 10) != SI32_DMA_STATUS_OK)
+          || (context.state != expected))
+      {
+         SI32_CRC_engine.ready = false;
+         break;
+      }
+
+      expected = SI32_CRC_reference_update(checks[i], checks[i]->init,
+                    &SI32_CRC_check_data[1], sizeof(SI32_CRC_check_data) - 2);
+      SI32_CRC_start(&context, checks[i]);
+      if ((SI32_CRC_update(&context, &SI32_CRC_check_data[1],
+              sizeof(SI32_CRC_check_data) - 2) != SI32_DMA_STATUS_OK)
+          || (context.state != expected))
+      {
+         SI32_CRC_engine.ready = false;
+         break;
+      }
+   }
+
+   if (!SI32_CRC_engine.ready && (status == SI32_DMA_STATUS_OK))
+   {
+      status = SI32_DMA_STATUS_INVALID_PARAMETER;
+   }
+   return status;
+}
+
+//-----------------------------------------------------------------------------
+// SI32_CRC_start
+//
+//-----------------------------------------------------------------------------
+void
+SI32_CRC_start(
+   SI32_CRC_Context_Type *context,
+   const SI32_CRC_Params_Type *params)
+{
+   uint32_t polysel;
+
+   assert((params->width >= 8) && (params->width <= 32));
+
+   context->params = params;
+   context->state = params->init & SI32_CRC_mask(params->width);
+   context->hardware = SI32_CRC_engine.ready
+                       && SI32_CRC_select_polynomial(params, &polysel);
+}
+
+//-----------------------------------------------------------------------------
+// SI32_CRC_update
+//
+//-----------------------------------------------------------------------------
+SI32_DMA_STATUS_Enum_Type
+SI32_CRC_update(
+   SI32_CRC_Context_Type *context,
+   const void *data,
+   uint32_t length)
+{
+   const uint8_t *next = (const uint8_t *)data;
+   SI32_DMA_STATUS_Enum_Type status = SI32_DMA_STATUS_OK;
+   uint32_t head;
+   uint32_t words;
+
+   if (!context->hardware)
+   {
+      context->state = SI32_CRC_reference_update(context->params, context->state,
+                                                 data, length);
+      return SI32_DMA_STATUS_OK;
+   }
+   if (!SI32_CRC_acquire(context))
+   {
+      return SI32_DMA_STATUS_BUSY;
+   }
+
+   head = (4 - ((uint32_t)next & 3)) & 3;
+   if (head > length)
+   {
+      head = length;
+   }
+   words = (length - head) / 4;
+
+   SI32_CRC_load(context);
+   SI32_CRC_write_bytes(next, head);
+   next += head;
+
+   if (SI32_CRC_engine.has_channel && (words >= SI32_CRC_MIN_DMA_WORDS))
+   {
+      while ((words > 0) && (status == SI32_DMA_STATUS_OK))
+      {
+         uint32_t chunk = SI32_CRC_start_dma(next, words);
+
+         while (!SI32_DMA_is_channel_done(SI32_CRC_engine.channel))
+         {
+         }
+         if (SI32_DMA_check_bus_error())
+         {
+            status = SI32_DMA_STATUS_BUS_ERROR;
+         }
+         next += chunk * 4;
+         words -= chunk;
+      }
+   }
+   else
+   {
+      SI32_CRC_write_words(next, words);
+      next += words * 4;
+   }
+
+   if (status == SI32_DMA_STATUS_OK)
+   {
+      SI32_CRC_write_bytes(next, (length - head) & 3);
+   }
+   SI32_CRC_store(status);
+
+   return status;
+}
+
+//-----------------------------------------------------------------------------
+// SI32_CRC_update_async
+//
+//-----------------------------------------------------------------------------
+SI32_DMA_STATUS_Enum_Type
+SI32_CRC_update_async(
+   SI32_CRC_Context_Type *context,
+   const void *data,
+   uint32_t length,
+   SI32_CRC_callback_t callback,
+   void *user)
+{
+   const uint8_t *next = (const uint8_t *)data;
+   SI32_DMA_STATUS_Enum_Type status;
+   uint32_t head;
+   uint32_t words;
+
+   head = (4 - ((uint32_t)next & 3)) & 3;
+   if (head > length)
+   {
+      head = length;
+   }
+   words = (length - head) / 4;
+
+   if (!context->hardware || !SI32_CRC_engine.has_channel
+       || (words < SI32_CRC_MIN_DMA_WORDS))
+   {
+      status = SI32_CRC_update(context, data, length);
+      if ((status != SI32_DMA_STATUS_BUSY) && (callback != NULL))
+      {
+         callback(context, status, user);
+      }
+      return status;
+   }
+   if (!SI32_CRC_acquire(context))
+   {
+      return SI32_DMA_STATUS_BUSY;
+   }
+
+   SI32_CRC_load(context);
+   SI32_CRC_write_bytes(next, head);
+
+   SI32_CRC_engine.next = next + head;
+   SI32_CRC_engine.words = words;
+   SI32_CRC_engine.tail = (length - head) & 3;
+   SI32_CRC_engine.callback = callback;
+   SI32_CRC_engine.user = user;
+   SI32_CRC_engine.async = true;
+   SI32_CRC_engine.chunk = SI32_CRC_start_dma(SI32_CRC_engine.next, words);
+
+   return SI32_DMA_STATUS_OK;
+}
+
+//-----------------------------------------------------------------------------
+// SI32_CRC_finish
+//
+//-----------------------------------------------------------------------------
+uint32_t
+SI32_CRC_finish(
+   const SI32_CRC_Context_Type *context)
+{
+   return SI32_CRC_reference_finish(context->params, context->state);
+}
+
+//-----------------------------------------------------------------------------
+// SI32_CRC_compute
+//
+//-----------------------------------------------------------------------------
+SI32_DMA_STATUS_Enum_Type
+SI32_CRC_compute(
+   const SI32_CRC_Params_Type *params,
+   const void *data,
+   uint32_t length,
+   uint32_t *crc)
+{
+   SI32_CRC_Context_Type context;
+   SI32_DMA_STATUS_Enum_Type status;
+
+   SI32_CRC_start(&context, params);
+   status = SI32_CRC_update(&context, data, length);
+   if (status == SI32_DMA_STATUS_OK)
+   {
+      *crc = SI32_CRC_finish(&context);
+   }
+   return status;
+}
+
+//-----------------------------------------------------------------------------
+// SI32_CRC_is_busy
+//
+//-----------------------------------------------------------------------------
+bool
+SI32_CRC_is_busy(void)
+{
+   return SI32_CRC_engine.owner != NULL;
+}
+
+//-----------------------------------------------------------------------------
+// SI32_CRC_reference_update
+//
+//-----------------------------------------------------------------------------
+uint32_t
+SI32_CRC_reference_update(
+   const SI32_CRC_Params_Type *params,
+   uint32_t state,
+   const void *data,
+   uint32_t length)
+{
+   const uint8_t *next = (const uint8_t *)data;
+   uint32_t top = 1UL << (params->width - 1);
+   uint32_t mask = SI32_CRC_mask(params->width);
+   uint32_t bit;
+
+   while (length--)
+   {
+      uint32_t byte = *next++;
+
+      if (params->refin)
+      {
+         byte = SI32_CRC_reflect(byte, 8);
+      }
+      state ^= byte << (params->width - 8);
+      for (bit = 0; bit < 8; bit++)
+      {
+         state = (state & top) ? ((state << 1) ^ params->poly) : (state << 1);
+      }
+      state &= mask;
+   }
+   return state;
+}
+
+//-----------------------------------------------------------------------------
+// SI32_CRC_reference_finish
+//
+//-----------------------------------------------------------------------------
+uint32_t
+SI32_CRC_reference_finish(
+   const SI32_CRC_Params_Type *params,
+   uint32_t state)
+{
+   if (params->refout)
+   {
+      state = SI32_CRC_reflect(state, params->width);
+   }
+   return (state ^ params->xorout) & SI32_CRC_mask(params->width);
+}
+
+//-eof--------------------------------------------------------------------------
@@ -0,0 +1,259 @@
+//------------------------------------------------------------------------------
+// Copyright 2024 (c) Silicon Laboratories Inc.
+//
+// SPDX-License-Identifier: Zlib
+//
+// This siHAL software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+//------------------------------------------------------------------------------
+/// @file si32_dma.c
+
+#include <assert.h>
+#include <stddef.h>
+#include "si32_dma.h"
+#include "SI32_CLKCTRL_A_Type.h"
+
+// Primary descriptors followed by the alternate ones. Only used when the
+// controller is not already running with a table of its own.
+static SI32_DMADESC_A_Type SI32_DMA_descriptors[2 * SI32_DMADESC_ALT_STRIDE]
+   __ALIGNED(SI32_DMADESC_PRI_ALIGN);
+
+static SI32_DMADESC_A_Type *SI32_DMA_table;
+static uint32_t SI32_DMA_claimed;
+static SI32_DMA_callback_t SI32_DMA_callbacks[SI32_DMACTRL_NUM_CHANNELS];
+static void *SI32_DMA_contexts[SI32_DMACTRL_NUM_CHANNELS];
+
+
+//-----------------------------------------------------------------------------
+// SI32_DMA_init
+//
+//-----------------------------------------------------------------------------
+void
+SI32_DMA_init(void)
+{
+   uint32_t primask = __get_PRIMASK();
+
+   __disable_irq();
+   if (SI32_DMA_table == NULL)
+   {
+      SI32_CLKCTRL_A_enable_ahb_to_dma_controller(SI32_CLKCTRL_0);
+
+      if (SI32_DMACTRL_A_is_enabled(SI32_DMACTRL_0)
+          && (SI32_DMACTRL_A_read_baseptr(SI32_DMACTRL_0) != 0))
+      {
+         SI32_DMA_table =
+            (SI32_DMADESC_A_Type *)SI32_DMACTRL_A_read_baseptr(SI32_DMACTRL_0);
+      }
+      else
+      {
+         SI32_DMACTRL_A_write_baseptr(SI32_DMACTRL_0, (uint32_t)SI32_DMA_descriptors);
+         SI32_DMACTRL_A_enable_module(SI32_DMACTRL_0);
+         SI32_DMA_table = SI32_DMA_descriptors;
+      }
+   }
+   __set_PRIMASK(primask);
+}
+
+//-----------------------------------------------------------------------------
+// SI32_DMA_claim_channel
+//
+//-----------------------------------------------------------------------------
+int32_t
+SI32_DMA_claim_channel(
+   SI32_DMAXBAR_CHNSEL_Enum_Type chnsel,
+   SI32_DMA_callback_t callback,
+   void *context)
+{
+   uint32_t channel = SI32_DMAXBAR_CHANNEL_OF(chnsel);
+   uint32_t primask;
+
+   assert(SI32_DMA_table != NULL);
+   assert(channel < SI32_DMACTRL_NUM_CHANNELS);
+
+   primask = __get_PRIMASK();
+   __disable_irq();
+   if (SI32_DMA_claimed & (1 << channel))
+   {
+      __set_PRIMASK(primask);
+      return -1;
+   }
+   SI32_DMA_claimed |= 1 << channel;
+   __set_PRIMASK(primask);
+
+   SI32_DMA_callbacks[channel] = callback;
+   SI32_DMA_contexts[channel] = context;
+
+   SI32_DMACTRL_A_disable_channel(SI32_DMACTRL_0, channel);
+   SI32_DMACTRL_A_select_primary_data_structure(SI32_DMACTRL_0, channel);
+   SI32_DMAXBAR_A_select_channel_peripheral(SI32_DMAXBAR_0, chnsel);
+   SI32_DMACTRL_A_enable_data_request(SI32_DMACTRL_0, channel);
+
+   NVIC_DisableIRQ((IRQn_Type)(DMACH0_IRQn + channel));
+   NVIC_ClearPendingIRQ((IRQn_Type)(DMACH0_IRQn + channel));
+   if (callback != NULL)
+   {
+      NVIC_EnableIRQ((IRQn_Type)(DMACH0_IRQn + channel));
+   }
+
+   return (int32_t)channel;
+}
+
+//-----------------------------------------------------------------------------
+// SI32_DMA_release_channel
+//
+//-----------------------------------------------------------------------------
+void
+SI32_DMA_release_channel(
+   uint32_t channel)
+{
+   uint32_t primask;
+
+   assert(channel < SI32_DMACTRL_NUM_CHANNELS);
+
+   NVIC_DisableIRQ((IRQn_Type)(DMACH0_IRQn + channel));
+   SI32_DMACTRL_A_disable_channel(SI32_DMACTRL_0, channel);
+   SI32_DMACTRL_A_disable_data_request(SI32_DMACTRL_0, channel);
+   SI32_DMACTRL_A_select_channel_default_priority(SI32_DMACTRL_0, channel);
+   NVIC_ClearPendingIRQ((IRQn_Type)(DMACH0_IRQn + channel));
+
+   SI32_DMA_callbacks[channel] = NULL;
+   SI32_DMA_contexts[channel] = NULL;
+
+   primask = __get_PRIMASK();
+   __disable_irq();
+   SI32_DMA_claimed &= ~(1 << channel);
+   __set_PRIMASK(primask);
+}
+
+//-----------------------------------------------------------------------------
+// SI32_DMA_get_primary_descriptor
+//
+//-----------------------------------------------------------------------------
+SI32_DMADESC_A_Type *
+SI32_DMA_get_primary_descriptor(
+   uint32_t channel)
+{
+   assert(channel < SI32_DMACTRL_NUM_CHANNELS);
+   return &SI32_DMA_table[channel];
+}
+
+//-----------------------------------------------------------------------------
+// SI32_DMA_get_alternate_descriptor
+//
+//-----------------------------------------------------------------------------
+SI32_DMADESC_A_Type *
+SI32_DMA_get_alternate_descriptor(
+   uint32_t channel)
+{
+   assert(channel < SI32_DMACTRL_NUM_CHANNELS);
+   return &SI32_DMA_table[SI32_DMADESC_ALT_STRIDE + channel];
+}
+
+//-----------------------------------------------------------------------------
+// SI32_DMA_start_channel
+//
+//-----------------------------------------------------------------------------
+void
+SI32_DMA_start_channel(
+   uint32_t channel,
+   bool high_priority)
+{
+   assert(channel < SI32_DMACTRL_NUM_CHANNELS);
+
+   if (high_priority)
+   {
+      SI32_DMACTRL_A_select_channel_high_priority(SI32_DMACTRL_0, channel);
+   }
+   else
+   {
+      SI32_DMACTRL_A_select_channel_default_priority(SI32_DMACTRL_0, channel);
+   }
+   SI32_DMACTRL_A_select_primary_data_structure(SI32_DMACTRL_0, channel);
+   SI32_DMACTRL_A_enable_channel(SI32_DMACTRL_0, channel);
+}
+
+//-----------------------------------------------------------------------------
+// SI32_DMA_software_request
+//
+//-----------------------------------------------------------------------------
+void
+SI32_DMA_software_request(
+   uint32_t channel)
+{
+   assert(channel < SI32_DMACTRL_NUM_CHANNELS);
+   SI32_DMACTRL_A_generate_software_request(SI32_DMACTRL_0, channel);
+}
+
+//-----------------------------------------------------------------------------
+// SI32_DMA_stop_channel
+//
+//-----------------------------------------------------------------------------
+void
+SI32_DMA_stop_channel(
+   uint32_t channel)
+{
+   assert(channel < SI32_DMACTRL_NUM_CHANNELS);
+   SI32_DMACTRL_A_disable_channel(SI32_DMACTRL_0, channel);
+}
+
+//-----------------------------------------------------------------------------
+// SI32_DMA_is_channel_done
+//
+//-----------------------------------------------------------------------------
+bool
+SI32_DMA_is_channel_done(
+   uint32_t channel)
+{
+   assert(channel < SI32_DMACTRL_NUM_CHANNELS);
+   // The controller clears the enable bit once the descriptor is exhausted.
+   return !SI32_DMACTRL_A_is_channel_enabled(SI32_DMACTRL_0, channel);
+}
+
+//-----------------------------------------------------------------------------
+// SI32_DMA_check_bus_error
+//
+//-----------------------------------------------------------------------------
+bool
+SI32_DMA_check_bus_error(void)
+{
+   if (SI32_DMACTRL_A_is_bus_error_set(SI32_DMACTRL_0))
+   {
+      SI32_DMACTRL_A_clear_bus_error(SI32_DMACTRL_0);
+      return true;
+   }
+   return false;
+}
+
+//-----------------------------------------------------------------------------
+// SI32_DMA_irq_handler
+//
+//-----------------------------------------------------------------------------
+void
+SI32_DMA_irq_handler(
+   uint32_t channel)
+{
+   SI32_DMA_callback_t callback;
+
+   assert(channel < SI32_DMACTRL_NUM_CHANNELS);
+
+   callback = SI32_DMA_callbacks[channel];
+   if (callback != NULL)
+   {
+      callback(channel, SI32_DMA_contexts[channel]);
+   }
+}
+
+//-eof--------------------------------------------------------------------------
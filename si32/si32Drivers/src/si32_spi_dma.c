@@ -0,0 +1,483 @@
+//------------------------------------------------------------------------------
+// Copyright 2024 (c) Silicon Laboratories Inc.
+//
+// SPDX-License-Identifier: Zlib
+//
+// This siHAL software is provided 'as-is', without any express or implied
+// warranty. In no event will the authors be held liable for any damages
+// arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it
+// freely, subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented; you must not
+//    claim that you wrote the original software. If you use this software
+//    in a product, an acknowledgment in the product documentation would be
+//    appreciated but is not required.
+// 2. Altered source versions must be plainly marked as such, and must not be
+//    misrepresented as being the original software.
+// 3. This notice may not be removed or altered from any source distribution.
+//------------------------------------------------------------------------------
+/// @file si32_spi_dma.c
+
+#include <assert.h>
+#include <stddef.h>
+#include "si32_spi_dma.h"
+
+#if defined(SI32_MCU_SIM3L1XX)
+#define SI32_SPIDMA_REG(name)  SI32_SPI_B_##name
+#else
+#define SI32_SPIDMA_REG(name)  SI32_SPI_A_##name
+#endif
+
+#define SI32_SPIDMA_THRESHOLD_MASK \
+   (SI32_SPIDMA_REG(CONFIG_RFTH_MASK) | SI32_SPIDMA_REG(CONFIG_TFTH_MASK))
+#define SI32_SPIDMA_THRESHOLD_BYTE \
+   (SI32_SPIDMA_REG(CONFIG_RFTH_ONE_U32) | SI32_SPIDMA_REG(CONFIG_TFTH_ONE_U32))
+#define SI32_SPIDMA_THRESHOLD_WORD \
+   (SI32_SPIDMA_REG(CONFIG_RFTH_FOUR_U32) | SI32_SPIDMA_REG(CONFIG_TFTH_FOUR_U32))
+#define SI32_SPIDMA_FLUSH \
+   (SI32_SPIDMA_REG(CONFIG_RFIFOFL_MASK) | SI32_SPIDMA_REG(CONFIG_TFIFOFL_MASK))
+
+static void SI32_SPIDMA_rx_done(uint32_t channel, void *context);
+
+
+//-----------------------------------------------------------------------------
+// SI32_SPIDMA_select
+//
+// Drives the chip select of the device.
+//-----------------------------------------------------------------------------
+static void
+SI32_SPIDMA_select(
+   SI32_SPIDMA_Handle_Type *handle,
+   bool active)
+{
+   SI32_SPIDMA_SPI_Type *spi = handle->config.spi;
+
+   switch (handle->config.cs_mode)
+   {
+      case SI32_SPIDMA_CS_NSS:
+         // NSSMD selects between 4-wire master with NSS low (2) and high (3).
+         if (active)
+         {
+            spi->CONFIG_CLR = SI32_SPIDMA_REG(CONFIG_NSSMD_4_WIRE_SLAVE_U32);
+         }
+         else
+         {
+            spi->CONFIG_SET = SI32_SPIDMA_REG(CONFIG_NSSMD_4_WIRE_SLAVE_U32);
+         }
+         break;
+      case SI32_SPIDMA_CS_CALLBACK:
+         handle->config.cs_callback(active, handle->config.cs_context);
+         break;
+      default:
+         break;
+   }
+}
+
+//-----------------------------------------------------------------------------
+// SI32_SPIDMA_pio
+//
+// Moves a short block through the FIFOs with the CPU. Words are pushed and
+// popped whenever four bytes fit, and no more bytes than the receive FIFO
+// holds are ever in flight so that it cannot overrun.
+//-----------------------------------------------------------------------------
+static void
+SI32_SPIDMA_pio(
+   SI32_SPIDMA_Handle_Type *handle,
+   const uint8_t *tx,
+   uint8_t *rx,
+   uint32_t length)
+{
+   SI32_SPIDMA_SPI_Type *spi = handle->config.spi;
+   uint32_t sent = 0;
+   uint32_t received = 0;
+
+   while (received < length)
+   {
+      uint32_t room = SI32_SPIDMA_FIFO_DEPTH - (sent - received);
+      uint32_t pending = spi->CONTROL.RFCNT;
+
+      if ((length - sent >= 4) && (room >= 4))
+      {
+         uint32_t word = handle->fill_word;
+
+         if (tx != NULL)
+         {
+            word = (uint32_t)tx[sent]
+                   | ((uint32_t)tx[sent + 1] << 8)
+                   | ((uint32_t)tx[sent + 2] << 16)
+                   | ((uint32_t)tx[sent + 3] << 24);
+         }
+         spi->DATA.U32 = word;
+         sent += 4;
+      }
+      else if ((sent < length) && (length - sent < 4) && (room > 0))
+      {
+         spi->DATA.U8 = (tx != NULL) ? tx[sent] : (uint8_t)handle->fill_word;
+         sent++;
+      }
+
+      if ((pending >= 4) && (length - received >= 4))
+      {
+         uint32_t word = spi->DATA.U32;
+
+         if (rx != NULL)
+         {
+            rx[received] = (uint8_t)word;
+            rx[received + 1] = (uint8_t)(word >> 8);
+            rx[received + 2] = (uint8_t)(word >> 16);
+            rx[received + 3] = (uint8_t)(word >> 24);
+         }
+         received += 4;
+      }
+      else if ((pending > 0) && (length - received < 4))
+      {
+         uint8_t data = spi->DATA.U8;
+
+         if (rx != NULL)
+         {
+            rx[received] = data;
+         }
+         received++;
+      }
+   }
+}
+
+//-----------------------------------------------------------------------------
+// SI32_SPIDMA_start_dma
+//
+// Programs both channels for the next part of the current segment.
+//-----------------------------------------------------------------------------
+static void
+SI32_SPIDMA_start_dma(
+   SI32_SPIDMA_Handle_Type *handle,
+   const uint8_t *tx,
+   uint8_t *rx,
+   uint32_t length)
+{
+   SI32_SPIDMA_SPI_Type *spi = handle->config.spi;
+   SI32_DMADESC_A_Type *rx_desc = SI32_DMA_get_primary_descriptor(handle->rx_channel);
+   SI32_DMADESC_A_Type *tx_desc = SI32_DMA_get_primary_descriptor(handle->tx_channel);
+   void volatile *rx_dst = (rx != NULL) ? (void volatile *)rx : &handle->sink_word;
+   void volatile *tx_src = (tx != NULL) ? (void volatile *)tx : &handle->fill_word;
+   bool word = (length >= 4)
+               && ((tx == NULL) || (((uint32_t)tx & 3) == 0))
+               && ((rx == NULL) || (((uint32_t)rx & 3) == 0));
+   uint32_t count;
+
+   if (word)
+   {
+      count = length / 4;
+      if (count > SI32_DMA_MAX_COUNT)
+      {
+         count = SI32_DMA_MAX_COUNT;
+      }
+      SI32_DMADESC_A_configure(rx_desc, &spi->DATA.U32, rx_dst, count,
+         (rx != NULL) ? SI32_DMADESC_A_CONFIG_WORD_RX : SI32_DMADESC_A_CONFIG_WORD_PIPE);
+      SI32_DMADESC_A_configure(tx_desc, tx_src, &spi->DATA.U32, count,
+         (tx != NULL) ? SI32_DMADESC_A_CONFIG_WORD_TX : SI32_DMADESC_A_CONFIG_WORD_PIPE);
+      handle->dma_length = count * 4;
+   }
+   else
+   {
+      count = length;
+      if (count > SI32_DMA_MAX_COUNT)
+      {
+         count = SI32_DMA_MAX_COUNT;
+      }
+      SI32_DMADESC_A_configure(rx_desc, &spi->DATA.U32, rx_dst, count,
+         (rx != NULL) ? SI32_DMADESC_A_CONFIG_BYTE_RX : SI32_DMADESC_A_CONFIG_BYTE_PIPE);
+      SI32_DMADESC_A_configure(tx_desc, tx_src, &spi->DATA.U32, count,
+         (tx != NULL) ? SI32_DMADESC_A_CONFIG_BYTE_TX : SI32_DMADESC_A_CONFIG_BYTE_PIPE);
+      handle->dma_length = count;
+   }
+
+   spi->CONFIG_CLR = SI32_SPIDMA_THRESHOLD_MASK;
+   spi->CONFIG_SET = word ? SI32_SPIDMA_THRESHOLD_WORD : SI32_SPIDMA_THRESHOLD_BYTE;
+
+   // The receive channel is serviced first so that the transmit channel can
+   // never get more than the FIFOs ahead of it.
+   SI32_DMA_start_channel(handle->rx_channel, true);
+   SI32_DMA_start_channel(handle->tx_channel, false);
+   spi->CONFIG_SET = SI32_SPIDMA_REG(CONFIG_DMAEN_ENABLED_U32);
+}
+
+//-----------------------------------------------------------------------------
+// SI32_SPIDMA_advance
+//
+// Moves the transfer forward until either a DMA part has been started or
+// the last segment is done.
+//
+// Returns true if a DMA part is in flight.
+//-----------------------------------------------------------------------------
+static bool
+SI32_SPIDMA_advance(
+   SI32_SPIDMA_Handle_Type *handle)
+{
+   while (handle->segment != NULL)
+   {
+      const SI32_SPIDMA_Segment_Type *segment = handle->segment;
+      const uint8_t *tx = (const uint8_t *)segment->tx;
+      uint8_t *rx = (uint8_t *)segment->rx;
+      uint32_t remaining = segment->length - handle->offset;
+
+      if (tx != NULL)
+      {
+         tx += handle->offset;
+      }
+      if (rx != NULL)
+      {
+         rx += handle->offset;
+      }
+
+      if (remaining == 0)
+      {
+         handle->segment = segment->next;
+         handle->offset = 0;
+      }
+      else if (remaining < SI32_SPIDMA_MIN_DMA_LENGTH)
+      {
+         SI32_SPIDMA_pio(handle, tx, rx, remaining);
+         handle->offset += remaining;
+      }
+      else
+      {
+         SI32_SPIDMA_start_dma(handle, tx, rx, remaining);
+         return true;
+      }
+   }
+   return false;
+}
+
+//-----------------------------------------------------------------------------
+// SI32_SPIDMA_finish
+//
+//-----------------------------------------------------------------------------
+static void
+SI32_SPIDMA_finish(
+   SI32_SPIDMA_Handle_Type *handle,
+   SI32_DMA_STATUS_Enum_Type status)
+{
+   SI32_SPIDMA_callback_t callback = handle->callback;
+   void *context = handle->context;
+
+   SI32_SPIDMA_select(handle, false);
+   handle->segment = NULL;
+   handle->callback = NULL;
+   handle->busy = false;
+
+   if (callback != NULL)
+   {
+      callback(handle, status, context);
+   }
+}
+
+//-----------------------------------------------------------------------------
+// SI32_SPIDMA_rx_done
+//
+// Receive channel completion, the data of the part is now all on the wire.
+//-----------------------------------------------------------------------------
+static void
+SI32_SPIDMA_rx_done(
+   uint32_t channel,
+   void *context)
+{
+   SI32_SPIDMA_Handle_Type *handle = (SI32_SPIDMA_Handle_Type *)context;
+   SI32_SPIDMA_SPI_Type *spi = handle->config.spi;
+   SI32_DMA_STATUS_Enum_Type status = SI32_DMA_STATUS_OK;
+
+   (void)channel;
+
+   if (!handle->busy || (handle->dma_length == 0)
+       || !SI32_DMA_is_channel_done(handle->rx_channel))
+   {
+      return;
+   }
+
+   spi->CONFIG_CLR = SI32_SPIDMA_REG(CONFIG_DMAEN_MASK);
+   SI32_DMA_stop_channel(handle->tx_channel);
+   handle->offset += handle->dma_length;
+   handle->dma_length = 0;
+
+   if (SI32_DMA_check_bus_error())
+   {
+      status = SI32_DMA_STATUS_BUS_ERROR;
+   }
+   else if (spi->CONTROL.RFORI)
+   {
+      spi->CONTROL_CLR = SI32_SPIDMA_REG(CONTROL_RFORI_MASK);
+      status = SI32_DMA_STATUS_OVERRUN;
+   }
+
+   if (status != SI32_DMA_STATUS_OK)
+   {
+      spi->CONFIG_SET = SI32_SPIDMA_FLUSH;
+      SI32_SPIDMA_finish(handle, status);
+   }
+   else if (!SI32_SPIDMA_advance(handle))
+   {
+      SI32_SPIDMA_finish(handle, SI32_DMA_STATUS_OK);
+   }
+}
+
+//-----------------------------------------------------------------------------
+// SI32_SPIDMA_init
+//
+//-----------------------------------------------------------------------------
+SI32_DMA_STATUS_Enum_Type
+SI32_SPIDMA_init(
+   SI32_SPIDMA_Handle_Type *handle,
+   const SI32_SPIDMA_Config_Type *config)
+{
+   int32_t rx_channel;
+   int32_t tx_channel;
+
+   if ((handle == NULL) || (config == NULL) || (config->spi == NULL)
+       || ((config->cs_mode == SI32_SPIDMA_CS_CALLBACK) && (config->cs_callback == NULL)))
+   {
+      return SI32_DMA_STATUS_INVALID_PARAMETER;
+   }
+
+   handle->config = *config;
+   handle->segment = NULL;
+   handle->offset = 0;
+   handle->dma_length = 0;
+   handle->callback = NULL;
+   handle->context = NULL;
+   handle->fill_word = config->fill * 0x01010101UL;
+   handle->busy = false;
+
+   SI32_DMA_init();
+
+   rx_channel = SI32_DMA_claim_channel(config->rx_chnsel, SI32_SPIDMA_rx_done, handle);
+   if (rx_channel < 0)
+   {
+      return SI32_DMA_STATUS_NO_CHANNEL;
+   }
+   tx_channel = SI32_DMA_claim_channel(config->tx_chnsel, NULL, NULL);
+   if (tx_channel < 0)
+   {
+      SI32_DMA_release_channel((uint32_t)rx_channel);
+      return SI32_DMA_STATUS_NO_CHANNEL;
+   }
+
+   handle->rx_channel = (uint32_t)rx_channel;
+   handle->tx_channel = (uint32_t)tx_channel;
+   SI32_SPIDMA_select(handle, false);
+
+   return SI32_DMA_STATUS_OK;
+}
+
+//-----------------------------------------------------------------------------
+// SI32_SPIDMA_deinit
+//
+//-----------------------------------------------------------------------------
+void
+SI32_SPIDMA_deinit(
+   SI32_SPIDMA_Handle_Type *handle)
+{
+   SI32_SPIDMA_abort(handle);
+   SI32_DMA_release_channel(handle->rx_channel);
+   SI32_DMA_release_channel(handle->tx_channel);
+}
+
+//-----------------------------------------------------------------------------
+// SI32_SPIDMA_transfer
+//
+//-----------------------------------------------------------------------------
+SI32_DMA_STATUS_Enum_Type
+SI32_SPIDMA_transfer(
+   SI32_SPIDMA_Handle_Type *handle,
+   const SI32_SPIDMA_Segment_Type *segments,
+   SI32_SPIDMA_callback_t callback,
+   void *context)
+{
+   SI32_SPIDMA_SPI_Type *spi;
+   uint32_t primask;
+
+   if ((handle == NULL) || (segments == NULL))
+   {
+      return SI32_DMA_STATUS_INVALID_PARAMETER;
+   }
+
+   spi = handle->config.spi;
+   // The FIFO word accesses assume one byte per frame.
+   assert(spi->CONFIG.DSIZE == 7);
+
+   primask = __get_PRIMASK();
+   __disable_irq();
+   if (handle->busy)
+   {
+      __set_PRIMASK(primask);
+      return SI32_DMA_STATUS_BUSY;
+   }
+   handle->busy = true;
+   __set_PRIMASK(primask);
+
+   handle->segment = segments;
+   handle->offset = 0;
+   handle->dma_length = 0;
+   handle->callback = callback;
+   handle->context = context;
+
+   spi->CONFIG_CLR = SI32_SPIDMA_REG(CONFIG_DMAEN_MASK);
+   spi->CONFIG_SET = SI32_SPIDMA_FLUSH;
+   spi->CONTROL_CLR = SI32_SPIDMA_REG(CONTROL_RFORI_MASK);
+   SI32_SPIDMA_select(handle, true);
+
+   // Starting a DMA part is the last thing advance does, from there on the
+   // receive channel interrupt owns the transfer.
+   if (!SI32_SPIDMA_advance(handle))
+   {
+      SI32_SPIDMA_finish(handle, SI32_DMA_STATUS_OK);
+   }
+
+   return SI32_DMA_STATUS_OK;
+}
+
+//-----------------------------------------------------------------------------
+// SI32_SPIDMA_is_busy
+//
+//-----------------------------------------------------------------------------
+bool
+SI32_SPIDMA_is_busy(
+   SI32_SPIDMA_Handle_Type *handle)
+{
+   return handle->busy;
+}
+
+//-----------------------------------------------------------------------------
+// SI32_SPIDMA_abort
+//
+//-----------------------------------------------------------------------------
+void
+SI32_SPIDMA_abort(
+   SI32_SPIDMA_Handle_Type *handle)
+{
+   SI32_SPIDMA_SPI_Type *spi = handle->config.spi;
+   uint32_t primask = __get_PRIMASK();
+
+   __disable_irq();
+   if (!handle->busy)
+   {
+      __set_PRIMASK(primask);
+      return;
+   }
+   spi->CONFIG_CLR = SI32_SPIDMA_REG(CONFIG_DMAEN_MASK);
+   SI32_DMA_stop_channel(handle->rx_channel);
+   SI32_DMA_stop_channel(handle->tx_channel);
+   NVIC_ClearPendingIRQ((IRQn_Type)(DMACH0_IRQn + handle->rx_channel));
+   handle->dma_length = 0;
+   __set_PRIMASK(primask);
+
+   // Let the shift register drain before flushing and deselecting.
+   while (spi->CONTROL.BUSYF)
+   {
+   }
+   spi->CONFIG_SET = SI32_SPIDMA_FLUSH;
+   SI32_SPIDMA_finish(handle, SI32_DMA_STATUS_ABORTED);
+}
+
+//-eof--------------------------------------------------------------------------
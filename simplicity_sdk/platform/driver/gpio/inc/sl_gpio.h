@@ -65,10 +65,42 @@ extern "C" {
 ///  The GPIO driver is used for external and EM4 interrupt configuration, port and pin configuration.
 ///  as well as manages the interrupt handler.
 ///
+///@n @section gpio_deferred Deferred interrupts
+///  By default, the callback of an external interrupt is called from the GPIO
+///  interrupt handler. When SL_GPIO_EVENT_QUEUE_SIZE is not 0, an external
+///  interrupt can instead be deferred with sl_gpio_configure_deferred_interrupt().
+///  The interrupt handler then only records the interrupt number, the pin level
+///  and a timestamp in a lock-free queue. The events are delivered later, in
+///  timestamp order, by sl_gpio_process_events(), called from a thread or from
+///  the main loop. Debouncing and rate limiting are applied at that point.
+///  sl_gpio_on_event_pending() is called from the interrupt handler each time
+///  events are queued; override it to wake up the processing context.
+///
 /// @{
 // *****************************************************************************
 /* *INDENT-ON* */
 
+/*******************************************************************************
+ *******************************   DEFINES   ***********************************
+ ******************************************************************************/
+
+/// Number of events in each of the two deferred interrupt queues (even and odd
+/// interrupt numbers). Must be a power of two. 0 disables deferred interrupts.
+#if !defined(SL_GPIO_EVENT_QUEUE_SIZE)
+#define SL_GPIO_EVENT_QUEUE_SIZE  0
+#endif
+
+#if (SL_GPIO_EVENT_QUEUE_SIZE & (SL_GPIO_EVENT_QUEUE_SIZE - 1)) != 0
+#error "SL_GPIO_EVENT_QUEUE_SIZE must be a power of two"
+#endif
+
+/// Set to 1 when the application overrides sl_gpio_get_event_timestamp() with
+/// a time source. Without it, or the sleeptimer, the debounce and rate limit
+/// policies are not supported.
+#if !defined(SL_GPIO_EVENT_TIMESTAMP_OVERRIDE)
+#define SL_GPIO_EVENT_TIMESTAMP_OVERRIDE  0
+#endif
+
 /*******************************************************************************
  ********************************   ENUMS   ************************************
  ******************************************************************************/
@@ -94,6 +126,39 @@ typedef struct {
   sl_gpio_pin_direction_t direction;
 } sl_gpio_pin_config_t;
 
+/***************************************************************************//**
+ * @brief
+ *   Deferred interrupt event, recorded by the GPIO interrupt handler.
+ ******************************************************************************/
+typedef struct {
+  uint32_t timestamp;   ///< Value of sl_gpio_get_event_timestamp() in the interrupt handler.
+  uint8_t int_no;       ///< Interrupt number.
+  bool level;           ///< Pin level in the interrupt handler, true after a rising edge.
+                        ///< Always false for interrupts configured with the interrupt port.
+} sl_gpio_event_t;
+
+/***************************************************************************//**
+ * @brief
+ *   Processing policy of a deferred interrupt.
+ ******************************************************************************/
+typedef struct {
+  uint32_t debounce_tick;           ///< Events following the previous delivered event by less than this are dropped. 0 disables debouncing.
+  uint32_t rate_limit_count;        ///< Events delivered per rate limit period, the others are dropped. 0 disables rate limiting.
+  uint32_t rate_limit_period_tick;  ///< Rate limit period.
+} sl_gpio_event_policy_t;
+
+/***************************************************************************//**
+ * @brief
+ *   Deferred interrupt counters.
+ ******************************************************************************/
+typedef struct {
+  uint32_t queued;        ///< Events recorded by the interrupt handler.
+  uint32_t overflows;     ///< Events lost because a queue was full.
+  uint32_t debounced;     ///< Events dropped by debouncing.
+  uint32_t rate_limited;  ///< Events dropped by rate limiting.
+  uint32_t delivered;     ///< Events passed to a callback.
+} sl_gpio_event_stats_t;
+
 /*******************************************************************************
  *******************************   TYPEDEFS   **********************************
  ******************************************************************************/
@@ -106,6 +171,14 @@ typedef struct {
  ******************************************************************************/
 typedef void (*sl_gpio_irq_callback_t)(uint8_t int_no, void *context);
 
+/***************************************************************************//**
+ * GPIO deferred interrupt callback function pointer.
+ *
+ * @param event Event which was recorded by the interrupt handler.
+ * @param context Pointer to callback context.
+ ******************************************************************************/
+typedef void (*sl_gpio_event_callback_t)(const sl_gpio_event_t *event, void *context);
+
 /*******************************************************************************
  *****************************   PROTOTYPES   **********************************
  ******************************************************************************/
@@ -513,6 +586,95 @@ sl_status_t sl_gpio_unlock(void);
  ******************************************************************************/
 sl_status_t sl_gpio_is_locked(bool *state);
 
+#if (SL_GPIO_EVENT_QUEUE_SIZE > 0)
+/***************************************************************************//**
+ * Defers an external interrupt to sl_gpio_process_events().
+ *
+ * @details The interrupt must have been configured with
+ *          sl_gpio_configure_external_interrupt(). Its callback is no longer
+ *          called from the interrupt handler; instead, an event is queued and
+ *          delivered to the given callback by sl_gpio_process_events().
+ *          sl_gpio_deconfigure_external_interrupt() also ends the deferral.
+ *
+ * @param[in] int_no Interrupt number to defer.
+ * @param[in] callback Callback called for each delivered event. NULL makes the
+ *                     interrupt call its sl_gpio_irq_callback_t callback from
+ *                     the interrupt handler again.
+ * @param[in] context A pointer to the callback context.
+ * @param[in] policy Debounce and rate limit policy, NULL for none.
+ *                   The policy is copied.
+ *
+ * @return SL_STATUS_OK if there's no error.
+ *         SL_STATUS_INVALID_PARAMETER if int_no is invalid.
+ *         SL_STATUS_NOT_SUPPORTED if the policy debounces or rate limits and
+ *         there's no event time source, see sl_gpio_get_event_timestamp().
+ ******************************************************************************/
+sl_status_t sl_gpio_configure_deferred_interrupt(int32_t int_no,
+                                                 sl_gpio_event_callback_t callback,
+                                                 void *context,
+                                                 const sl_gpio_event_policy_t *policy);
+
+/***************************************************************************//**
+ * Delivers the queued deferred interrupt events.
+ *
+ * @note Must always be called from the same context, which must not be an
+ *       interrupt with a higher priority than the GPIO interrupts.
+ *
+ * @param[in] max_events Maximum number of events to take from the queues,
+ *                       0 to empty the queues.
+ *
+ * @return Number of events taken from the queues, including dropped ones.
+ ******************************************************************************/
+uint32_t sl_gpio_process_events(uint32_t max_events);
+
+/***************************************************************************//**
+ * Checks whether deferred interrupt events are waiting to be processed.
+ *
+ * @return true if sl_gpio_process_events() has events to deliver.
+ ******************************************************************************/
+bool sl_gpio_has_pending_events(void);
+
+/***************************************************************************//**
+ * Gets the deferred interrupt counters.
+ *
+ * @param[out] stats Pointer to the counters.
+ *
+ * @return SL_STATUS_OK if there's no error.
+ *         SL_STATUS_NULL_POINTER if stats is passed as null.
+ ******************************************************************************/
+sl_status_t sl_gpio_get_event_stats(sl_gpio_event_stats_t *stats);
+
+/***************************************************************************//**
+ * Clears the deferred interrupt counters.
+ ******************************************************************************/
+void sl_gpio_clear_event_stats(void);
+
+/***************************************************************************//**
+ * Gets the timestamp of deferred interrupt events.
+ *
+ * @note Called from the GPIO interrupt handlers. The default implementation
+ *       returns the sleeptimer tick count. Without the sleeptimer, it returns
+ *       a sequence number, which keeps the events of both queues in order but
+ *       can't measure time, so the debounce and rate limit policies are
+ *       rejected. It can be overridden, e.g. to read a free running TIMER for
+ *       a finer resolution, with SL_GPIO_EVENT_TIMESTAMP_OVERRIDE set to 1.
+ *       The debounce and rate limit policies are in units of this timestamp.
+ *
+ * @return Timestamp.
+ ******************************************************************************/
+uint32_t sl_gpio_get_event_timestamp(void);
+
+/***************************************************************************//**
+ * Hook called from the GPIO interrupt handlers when deferred events have been
+ * queued.
+ *
+ * @note The default implementation does nothing. Override it to signal the
+ *       thread which calls sl_gpio_process_events(), or to pend a low
+ *       priority interrupt which calls it.
+ ******************************************************************************/
+void sl_gpio_on_event_pending(void);
+#endif
+
 /** @} (end addtogroup gpio driver) */
 #ifdef __cplusplus
 }
@@ -29,12 +29,18 @@
  ******************************************************************************/
 
 #include <stddef.h>
+#if defined(SL_COMPONENT_CATALOG_PRESENT)
+#include "sl_component_catalog.h"
+#endif
 #include "sl_core.h"
 #include "sl_common.h"
 #include "sl_interrupt_manager.h"
 #include "sl_clock_manager.h"
 #include "sl_hal_gpio.h"
 #include "sl_gpio.h"
+#if (SL_GPIO_EVENT_QUEUE_SIZE > 0) && defined(SL_CATALOG_SLEEPTIMER_PRESENT)
+#include "sl_sleeptimer.h"
+#endif
 
 /*******************************************************************************
  *******************************   DEFINES   ***********************************
@@ -46,6 +52,13 @@
 /// Pin direction validation.
 #define SL_GPIO_DIRECTION_IS_VALID(direction)  (direction <= SL_GPIO_PIN_DIRECTION_OUT)
 
+/// Whether sl_gpio_get_event_timestamp() measures time.
+#if defined(SL_CATALOG_SLEEPTIMER_PRESENT) || (SL_GPIO_EVENT_TIMESTAMP_OVERRIDE == 1)
+#define SL_GPIO_EVENT_TIME_SOURCE_PRESENT  1
+#else
+#define SL_GPIO_EVENT_TIME_SOURCE_PRESENT  0
+#endif
+
 /*******************************************************************************
  *******************************   STRUCTS   ***********************************
  ******************************************************************************/
@@ -68,6 +81,35 @@ typedef struct {
   sl_gpio_callback_desc_t callback_em4[SL_HAL_GPIO_INTERRUPT_MAX];
 } sl_gpio_callbacks_t;
 
+#if (SL_GPIO_EVENT_QUEUE_SIZE > 0)
+typedef struct {
+  // Pin of the interrupt, port is SL_GPIO_PORT_INTERRUPT if unknown.
+  sl_gpio_t gpio;
+  // Callback for deferred events, NULL if the interrupt isn't deferred.
+  sl_gpio_event_callback_t callback;
+  // Pointer to callback context.
+  void *context;
+  sl_gpio_event_policy_t policy;
+  // Debounce and rate limit state, only used by the processing context.
+  bool has_delivered;
+  uint32_t last_delivered_timestamp;
+  uint32_t rate_period_start;
+  uint32_t rate_period_count;
+} sl_gpio_deferred_desc_t;
+
+// Single producer, single consumer queue. The producer is one of the GPIO
+// interrupt handlers, the consumer is sl_gpio_process_events().
+typedef struct {
+  sl_gpio_event_t events[SL_GPIO_EVENT_QUEUE_SIZE];
+  // Written by the interrupt handler only.
+  volatile uint32_t head;
+  volatile uint32_t queued;
+  volatile uint32_t overflows;
+  // Written by the processing context only.
+  volatile uint32_t tail;
+} sl_gpio_event_queue_t;
+#endif
+
 /*******************************************************************************
  ********************************   GLOBALS   **********************************
  ******************************************************************************/
@@ -75,10 +117,29 @@ typedef struct {
 // Variable to manage and organize the callback functions for External and EM4 interrupts.
 static sl_gpio_callbacks_t gpio_interrupts = { 0 };
 
+#if (SL_GPIO_EVENT_QUEUE_SIZE > 0)
+// State of the deferred interrupts.
+static sl_gpio_deferred_desc_t gpio_deferred[SL_HAL_GPIO_INTERRUPT_MAX + 1] = { 0 };
+
+// Mask of the deferred interrupt numbers.
+static volatile uint32_t gpio_deferred_mask = 0;
+
+// Event queues of the even and odd interrupt handlers. One queue per handler
+// keeps them lock-free whatever the priorities of the two interrupts.
+static sl_gpio_event_queue_t gpio_event_queues[2];
+
+// Counters updated by the processing context.
+static sl_gpio_event_stats_t gpio_event_stats = { 0 };
+#endif
+
 /*******************************************************************************
  ******************************   LOCAL FUCTIONS   *****************************
  ******************************************************************************/
 static void sl_gpio_dispatch_interrupt(uint32_t iflags);
+#if (SL_GPIO_EVENT_QUEUE_SIZE > 0)
+static uint32_t sl_gpio_queue_events(sl_gpio_event_queue_t *queue, uint32_t iflags);
+static bool sl_gpio_filter_event(sl_gpio_deferred_desc_t *deferred, const sl_gpio_event_t *event);
+#endif
 
 /***************************************************************************//**
  *   Driver GPIO Initialization.
@@ -470,6 +531,9 @@ sl_status_t sl_gpio_configure_external_interrupt(const sl_gpio_t *gpio,
     // Callback registration.
     gpio_interrupts.callback_ext[*int_no].callback = (void *)gpio_callback;
     gpio_interrupts.callback_ext[*int_no].context = context;
+#if (SL_GPIO_EVENT_QUEUE_SIZE > 0)
+    gpio_deferred[*int_no].gpio = *gpio;
+#endif
 
     if (gpio->port != SL_GPIO_PORT_INTERRUPT) {
       sl_hal_gpio_enable_interrupts(1 << *int_no);
@@ -505,6 +569,11 @@ sl_status_t sl_gpio_deconfigure_external_interrupt(int32_t int_no)
   // Callback deregistration.
   gpio_interrupts.callback_ext[int_no].callback = NULL;
   gpio_interrupts.callback_ext[int_no].context = NULL;
+#if (SL_GPIO_EVENT_QUEUE_SIZE > 0)
+  gpio_deferred_mask &= ~(1UL << int_no);
+  gpio_deferred[int_no].callback = NULL;
+  gpio_deferred[int_no].context = NULL;
+#endif
 
   CORE_EXIT_ATOMIC();
   return SL_STATUS_OK;
@@ -756,6 +825,188 @@ sl_status_t sl_gpio_is_locked(bool *state)
   return SL_STATUS_OK;
 }
 
+#if (SL_GPIO_EVENT_QUEUE_SIZE > 0)
+/***************************************************************************//**
+ *  Defers an external interrupt to sl_gpio_process_events().
+ ******************************************************************************/
+sl_status_t sl_gpio_configure_deferred_interrupt(int32_t int_no,
+                                                 sl_gpio_event_callback_t callback,
+                                                 void *context,
+                                                 const sl_gpio_event_policy_t *policy)
+{
+  sl_gpio_deferred_desc_t *deferred;
+  CORE_DECLARE_IRQ_STATE;
+
+  if (!((int_no != SL_GPIO_INTERRUPT_UNAVAILABLE) && (int_no <= SL_HAL_GPIO_INTERRUPT_MAX) && (int_no >= 0))) {
+    EFM_ASSERT(false);
+    return SL_STATUS_INVALID_PARAMETER;
+  }
+
+#if (SL_GPIO_EVENT_TIME_SOURCE_PRESENT == 0)
+  if ((policy != NULL)
+      && ((policy->debounce_tick != 0) || (policy->rate_limit_count != 0))) {
+    // The timestamps are sequence numbers, policies would drop most events
+    return SL_STATUS_NOT_SUPPORTED;
+  }
+#endif
+
+  deferred = &gpio_deferred[int_no];
+
+  CORE_ENTER_ATOMIC();
+
+  if (callback == NULL) {
+    gpio_deferred_mask &= ~(1UL << int_no);
+  }
+
+  deferred->callback = callback;
+  deferred->context = context;
+  if (policy != NULL) {
+    deferred->policy = *policy;
+  } else {
+    deferred->policy.debounce_tick = 0;
+    deferred->policy.rate_limit_count = 0;
+    deferred->policy.rate_limit_period_tick = 0;
+  }
+  deferred->has_delivered = false;
+  deferred->rate_period_count = 0;
+
+  if (callback != NULL) {
+    gpio_deferred_mask |= (1UL << int_no);
+  }
+
+  CORE_EXIT_ATOMIC();
+  return SL_STATUS_OK;
+}
+
+/***************************************************************************//**
+ *  Delivers the queued deferred interrupt events.
+ ******************************************************************************/
+uint32_t sl_gpio_process_events(uint32_t max_events)
+{
+  sl_gpio_event_queue_t *queue;
+  sl_gpio_event_queue_t *even_queue = &gpio_event_queues[0];
+  sl_gpio_event_queue_t *odd_queue = &gpio_event_queues[1];
+  sl_gpio_deferred_desc_t *deferred;
+  sl_gpio_event_t event;
+  uint32_t count = 0;
+  bool even_empty;
+  bool odd_empty;
+
+  while ((max_events == 0) || (count < max_events)) {
+    even_empty = (even_queue->head == even_queue->tail);
+    odd_empty = (odd_queue->head == odd_queue->tail);
+    // Read the events only after their publication.
+    __DMB();
+
+    // Take the oldest event of the two queues.
+    if (even_empty && odd_empty) {
+      break;
+    } else if (even_empty) {
+      queue = odd_queue;
+    } else if (odd_empty) {
+      queue = even_queue;
+    } else if ((int32_t)(even_queue->events[even_queue->tail & (SL_GPIO_EVENT_QUEUE_SIZE - 1)].timestamp
+                         - odd_queue->events[odd_queue->tail & (SL_GPIO_EVENT_QUEUE_SIZE - 1)].timestamp) <= 0) {
+      queue = even_queue;
+    } else {
+      queue = odd_queue;
+    }
+
+    // Read the event before handing its slot back to the interrupt handler.
+    event = queue->events[queue->tail & (SL_GPIO_EVENT_QUEUE_SIZE - 1)];
+    __DMB();
+    queue->tail++;
+    count++;
+
+    deferred = &gpio_deferred[event.int_no];
+    if ((deferred->callback != NULL) && sl_gpio_filter_event(deferred, &event)) {
+      gpio_event_stats.delivered++;
+      deferred->callback(&event, deferred->context);
+    }
+  }
+
+  return count;
+}
+
+/***************************************************************************//**
+ *  Checks whether deferred interrupt events are waiting to be processed.
+ ******************************************************************************/
+bool sl_gpio_has_pending_events(void)
+{
+  return (gpio_event_queues[0].head != gpio_event_queues[0].tail)
+         || (gpio_event_queues[1].head != gpio_event_queues[1].tail);
+}
+
+/***************************************************************************//**
+ *  Gets the deferred interrupt counters.
+ ******************************************************************************/
+sl_status_t sl_gpio_get_event_stats(sl_gpio_event_stats_t *stats)
+{
+  CORE_DECLARE_IRQ_STATE;
+
+  if (stats == NULL) {
+    EFM_ASSERT(false);
+    return SL_STATUS_NULL_POINTER;
+  }
+
+  CORE_ENTER_ATOMIC();
+
+  *stats = gpio_event_stats;
+  stats->queued = gpio_event_queues[0].queued + gpio_event_queues[1].queued;
+  stats->overflows = gpio_event_queues[0].overflows + gpio_event_queues[1].overflows;
+
+  CORE_EXIT_ATOMIC();
+  return SL_STATUS_OK;
+}
+
+/***************************************************************************//**
+ *  Clears the deferred interrupt counters.
+ ******************************************************************************/
+void sl_gpio_clear_event_stats(void)
+{
+  CORE_DECLARE_IRQ_STATE;
+  CORE_ENTER_ATOMIC();
+
+  gpio_event_stats.debounced = 0;
+  gpio_event_stats.rate_limited = 0;
+  gpio_event_stats.delivered = 0;
+  gpio_event_queues[0].queued = 0;
+  gpio_event_queues[0].overflows = 0;
+  gpio_event_queues[1].queued = 0;
+  gpio_event_queues[1].overflows = 0;
+
+  CORE_EXIT_ATOMIC();
+}
+
+/***************************************************************************//**
+ *  Gets the timestamp of deferred interrupt events.
+ ******************************************************************************/
+SL_WEAK uint32_t sl_gpio_get_event_timestamp(void)
+{
+#if defined(SL_CATALOG_SLEEPTIMER_PRESENT)
+  return sl_sleeptimer_get_tick_count();
+#else
+  static uint32_t sequence = 0;
+  uint32_t timestamp;
+  CORE_DECLARE_IRQ_STATE;
+
+  // Only orders the events, the GPIO interrupts can preempt each other
+  CORE_ENTER_ATOMIC();
+  timestamp = sequence++;
+  CORE_EXIT_ATOMIC();
+
+  return timestamp;
+#endif
+}
+
+/***************************************************************************//**
+ *  Hook called when deferred events have been queued.
+ ******************************************************************************/
+SL_WEAK void sl_gpio_on_event_pending(void)
+{
+}
+#endif
+
 /***************************************************************************//**
  * Function calls users callback for registered pin interrupts.
  *
@@ -790,6 +1041,102 @@ static void sl_gpio_dispatch_interrupt(uint32_t iflags)
   }
 }
 
+#if (SL_GPIO_EVENT_QUEUE_SIZE > 0)
+/***************************************************************************//**
+ * Records the deferred interrupts in an event queue.
+ *
+ * @details Called from the GPIO interrupt handlers. All the events recorded by
+ *          one call share the same timestamp.
+ *
+ * @param queue Event queue of the interrupt handler.
+ * @param iflags Interrupt flags which triggered the interrupt.
+ *
+ * @return Interrupt flags which still have to be dispatched.
+ ******************************************************************************/
+static uint32_t sl_gpio_queue_events(sl_gpio_event_queue_t *queue, uint32_t iflags)
+{
+  uint32_t deferred_flags = iflags & gpio_deferred_mask;
+  uint32_t pending_flags = deferred_flags;
+  uint32_t timestamp;
+  uint32_t irq_idx;
+  uint32_t head;
+  sl_gpio_event_t *event;
+  sl_gpio_t *gpio;
+
+  if (deferred_flags == 0) {
+    return iflags;
+  }
+
+  timestamp = sl_gpio_get_event_timestamp();
+  head = queue->head;
+
+  while (pending_flags != 0) {
+    irq_idx = SL_CTZ(pending_flags);
+    pending_flags &= ~(1UL << irq_idx);
+
+    if ((head - queue->tail) >= SL_GPIO_EVENT_QUEUE_SIZE) {
+      queue->overflows++;
+      continue;
+    }
+
+    gpio = &gpio_deferred[irq_idx].gpio;
+    event = &queue->events[head & (SL_GPIO_EVENT_QUEUE_SIZE - 1)];
+    event->timestamp = timestamp;
+    event->int_no = (uint8_t)irq_idx;
+    event->level = (gpio->port != SL_GPIO_PORT_INTERRUPT) && sl_hal_gpio_get_pin_input(gpio);
+    head++;
+    queue->queued++;
+  }
+
+  // Publish the events once they are written.
+  __DMB();
+  if (head != queue->head) {
+    queue->head = head;
+    sl_gpio_on_event_pending();
+  }
+
+  return iflags & ~deferred_flags;
+}
+
+/***************************************************************************//**
+ * Applies the debounce and rate limit policy of a deferred interrupt.
+ *
+ * @param deferred Deferred interrupt.
+ * @param event Event to deliver.
+ *
+ * @return true if the event must be delivered, false if it is dropped.
+ ******************************************************************************/
+static bool sl_gpio_filter_event(sl_gpio_deferred_desc_t *deferred, const sl_gpio_event_t *event)
+{
+  const sl_gpio_event_policy_t *policy = &deferred->policy;
+
+  if ((policy->debounce_tick != 0)
+      && deferred->has_delivered
+      && ((event->timestamp - deferred->last_delivered_timestamp) < policy->debounce_tick)) {
+    gpio_event_stats.debounced++;
+    return false;
+  }
+
+  if (policy->rate_limit_count != 0) {
+    if ((deferred->rate_period_count == 0)
+        || ((event->timestamp - deferred->rate_period_start) >= policy->rate_limit_period_tick)) {
+      deferred->rate_period_start = event->timestamp;
+      deferred->rate_period_count = 0;
+    }
+    if (deferred->rate_period_count >= policy->rate_limit_count) {
+      gpio_event_stats.rate_limited++;
+      return false;
+    }
+    deferred->rate_period_count++;
+  }
+
+  deferred->has_delivered = true;
+  deferred->last_delivered_timestamp = event->timestamp;
+
+  return true;
+}
+#endif
+
 /***************************************************************************//**
  *   GPIO EVEN interrupt handler. Interrupt handler clears all IF even flags and
  *   call the dispatcher passing the flags which triggered the interrupt.
@@ -803,6 +1150,10 @@ void GPIO_EVEN_IRQHandler(void)
   // Clears only even interrupts.
   sl_hal_gpio_clear_interrupts(even_flags);
 
+#if (SL_GPIO_EVENT_QUEUE_SIZE > 0)
+  even_flags = sl_gpio_queue_events(&gpio_event_queues[0], even_flags);
+#endif
+
   sl_gpio_dispatch_interrupt(even_flags);
 }
 
@@ -820,5 +1171,9 @@ void GPIO_ODD_IRQHandler(void)
   // Clears only odd interrupts.
   sl_hal_gpio_clear_interrupts(odd_flags);
 
+#if (SL_GPIO_EVENT_QUEUE_SIZE > 0)
+  odd_flags = sl_gpio_queue_events(&gpio_event_queues[1], odd_flags);
+#endif
+
   sl_gpio_dispatch_interrupt(odd_flags);
 }
@@ -62,6 +62,8 @@ typedef uint32_t Ecode_t;
 #define ECODE_EMDRV_UARTDRV_BASE     (ECODE_EMDRV_BASE | 0x00007000U)   ///< Base value for UARTDRV error codes.
 #define ECODE_EMDRV_DMADRV_BASE      (ECODE_EMDRV_BASE | 0x00008000U)   ///< Base value for DMADRV error codes.
 #define ECODE_EMDRV_EZRADIODRV_BASE  (ECODE_EMDRV_BASE | 0x00009000U)   ///< Base value for EZRADIODRV error codes.
+#define ECODE_EMDRV_UARTDMA_BASE     (ECODE_EMDRV_BASE | 0x0000A000U)   ///< Base value for UARTDMA error codes.
+#define ECODE_EMDRV_SPIDMA_BASE      (ECODE_EMDRV_BASE | 0x0000B000U)   ///< Base value for SPIDMA error codes.
 #define ECODE_EMDRV_TEMPDRV_BASE     (ECODE_EMDRV_BASE | 0x0000D000U)   ///< Base value for TEMPDRV error codes.
 #define ECODE_EMDRV_NVM3_BASE        (ECODE_EMDRV_BASE | 0x0000E000U)   ///< Base value for NVM3 error codes.
 
@@ -21,6 +21,16 @@
 // <i> Default: 0
 #define EMDRV_DMADRV_DMA_CH_PRIORITY 0
 
+// <o EMDRV_DMADRV_RING_MAX_SEGMENTS> Maximum number of ring transfer segments
+// <1=> 1
+// <2=> 2
+// <4=> 4
+// <8=> 8
+// <i> Largest number of segments of a DMADRV_PeripheralMemoryRing() transfer.
+// <i> Each segment above 2 costs one LDMA descriptor per channel.
+// <i> Default: 4
+#define EMDRV_DMADRV_RING_MAX_SEGMENTS 4
+
 // <<< end of configuration section >>>
 
 #endif // DMADRV_CONFIG_H
@@ -73,6 +73,7 @@ extern "C" {
 #define ECODE_EMDRV_DMADRV_IN_USE              (ECODE_EMDRV_DMADRV_BASE | 0x00000005)   ///< DMA is in use.
 #define ECODE_EMDRV_DMADRV_ALREADY_FREED       (ECODE_EMDRV_DMADRV_BASE | 0x00000006)   ///< A DMA channel was free.
 #define ECODE_EMDRV_DMADRV_CH_NOT_ALLOCATED    (ECODE_EMDRV_DMADRV_BASE | 0x00000007)   ///< A channel is not reserved.
+#define ECODE_EMDRV_DMADRV_RING_OVERRUN        (ECODE_EMDRV_DMADRV_BASE | 0x00000008)   ///< Ring data was overwritten before it was read.
 
 /** @} (end addtogroup error codes) */
 /***************************************************************************//**
@@ -93,8 +94,8 @@ extern "C" {
  *  Optional user parameter supplied on DMA invocation.
  *
  * @return
- *   When doing ping-pong transfers, return true to continue or false to
- *   stop transfers.
+ *   When doing ping-pong or ring transfers, return true to continue or false
+ *   to stop transfers.
  ******************************************************************************/
 typedef bool (*DMADRV_Callback_t)(unsigned int channel,
                                   unsigned int sequenceNo,
@@ -161,6 +162,25 @@ Ecode_t DMADRV_LdmaStartTransfer(int                            channelId,
                                  void                           *cbUserParam);
 #endif
 
+#if defined(EMDRV_DMADRV_LDMA) || defined(EMDRV_DMADRV_LDMA_S3)
+Ecode_t DMADRV_PeripheralMemoryRing(unsigned int              channelId,
+                                    DMADRV_PeripheralSignal_t peripheralSignal,
+                                    void                      *dst,
+                                    void                      *src,
+                                    int                       len,
+                                    unsigned int              segments,
+                                    DMADRV_DataSize_t         size,
+                                    DMADRV_Callback_t         callback,
+                                    void                      *cbUserParam);
+SL_CODE_CLASSIFY(SL_CODE_COMPONENT_DMADRV, SL_CODE_CLASS_TIME_CRITICAL)
+Ecode_t DMADRV_RingAvailable(unsigned int channelId,
+                             int          *readIndex,
+                             int          *available);
+SL_CODE_CLASSIFY(SL_CODE_COMPONENT_DMADRV, SL_CODE_CLASS_TIME_CRITICAL)
+Ecode_t DMADRV_RingConsume(unsigned int channelId,
+                           int          count);
+#endif
+
 Ecode_t DMADRV_PauseTransfer(unsigned int channelId);
 Ecode_t DMADRV_ResumeTransfer(unsigned int channelId);
 SL_CODE_CLASSIFY(SL_CODE_COMPONENT_DMADRV, SL_CODE_CLASS_TIME_CRITICAL)
@@ -203,6 +203,9 @@ SL_ENUM_GENERIC(DMADRV_PeripheralSignal_t, uint32_t) {
   #if defined LDMAXBAR_CH_REQSEL_SIGSEL_EUSART4RXFL
   dmadrvPeripheralSignal_EUSART4_RXDATAV = LDMAXBAR_CH_REQSEL_SIGSEL_EUSART4RXFL | LDMAXBAR_CH_REQSEL_SOURCESEL_EUSART4,       ///< Trig on EUART4_RXBL.
   #endif
+  #if defined LDMAXBAR_CH_REQSEL_SIGSEL_MSCWDATA
+  dmadrvPeripheralSignal_MSC_WDATA = LDMAXBAR_CH_REQSEL_SIGSEL_MSCWDATA | LDMAXBAR_CH_REQSEL_SOURCESEL_MSC,                    ///< Trig on MSC_WDATA.
+  #endif
 };
 
 /// Data size of one LDMA transfer item.
@@ -52,6 +52,22 @@
 #endif
 #endif
 
+#if !defined(EMDRV_DMADRV_RING_MAX_SEGMENTS)
+#define EMDRV_DMADRV_RING_MAX_SEGMENTS 4
+#endif
+
+#if (EMDRV_DMADRV_RING_MAX_SEGMENTS < 1) \
+  || (EMDRV_DMADRV_RING_MAX_SEGMENTS & (EMDRV_DMADRV_RING_MAX_SEGMENTS - 1))
+#error "EMDRV_DMADRV_RING_MAX_SEGMENTS must be a power of two"
+#endif
+
+// Ring segments share the ping-pong descriptor storage of the channel.
+#if (EMDRV_DMADRV_RING_MAX_SEGMENTS > 2)
+#define DMADRV_DESC_COUNT EMDRV_DMADRV_RING_MAX_SEGMENTS
+#else
+#define DMADRV_DESC_COUNT 2
+#endif
+
 typedef enum {
   dmaDirectionMemToPeripheral,
   dmaDirectionPeripheralToMem
@@ -59,7 +75,8 @@ typedef enum {
 
 typedef enum {
   dmaModeBasic,
-  dmaModePingPong
+  dmaModePingPong,
+  dmaModeRing
 } DmaMode_t;
 
 typedef struct {
@@ -72,6 +89,14 @@ typedef struct {
   bool              allocated;
 #if defined(EMDRV_DMADRV_LDMA) || defined(EMDRV_DMADRV_LDMA_S3)
   DmaMode_t         mode;
+  uint8_t           *ringBase;          // Ring buffer start address
+  unsigned int      ringSizeShift;      // log2 of the ring item size
+  unsigned int      ringLen;            // Ring buffer length in items
+  unsigned int      ringSegments;       // Number of ring segments
+  unsigned int      ringIrqStep;        // Segments completed per interrupt
+  volatile uint32_t ringSegmentsDone;   // Updated by the interrupt handler
+  uint32_t          ringReadCount;      // Items consumed, modulo 2^32
+  unsigned int      ringReadIndex;      // Consumer read index
 #endif
 } ChTable_t;
 
@@ -89,7 +114,7 @@ const LDMA_Descriptor_t m2p = LDMA_DESCRIPTOR_SINGLE_M2P_BYTE(NULL, NULL, 1UL);
 const LDMA_Descriptor_t p2m = LDMA_DESCRIPTOR_SINGLE_P2M_BYTE(NULL, NULL, 1UL);
 
 typedef struct {
-  LDMA_Descriptor_t desc[2];
+  LDMA_Descriptor_t desc[DMADRV_DESC_COUNT];
 } DmaXfer_t;
 #else
 const sl_hal_ldma_transfer_config_t xferCfgPeripheral = SL_HAL_LDMA_TRANSFER_CFG_PERIPHERAL(0);
@@ -97,7 +122,7 @@ const sl_hal_ldma_descriptor_t m2p = SL_HAL_LDMA_DESCRIPTOR_SINGLE_M2P(SL_HAL_LD
 const sl_hal_ldma_descriptor_t p2m = SL_HAL_LDMA_DESCRIPTOR_SINGLE_P2M(SL_HAL_LDMA_CTRL_SIZE_BYTE, NULL, NULL, 1UL);
 
 typedef struct {
-  sl_hal_ldma_descriptor_t desc[2];
+  sl_hal_ldma_descriptor_t desc[DMADRV_DESC_COUNT];
 } DmaXfer_t;
 #endif
 
@@ -121,6 +146,11 @@ static Ecode_t StartTransfer(DmaMode_t                 mode,
 static void LDMA_IRQHandlerDefault(uint8_t chnum);
 #endif
 
+#if defined(EMDRV_DMADRV_LDMA) || defined(EMDRV_DMADRV_LDMA_S3)
+static void RingBreakLinks(unsigned int channelId);
+static unsigned int RingWritePosition(unsigned int channelId);
+#endif
+
 /// @endcond
 
 /***************************************************************************//**
@@ -433,6 +463,7 @@ Ecode_t DMADRV_LdmaStartTransfer(int                channelId,
   ch->callback      = callback;
   ch->userParam     = cbUserParam;
   ch->callbackCount = 0;
+  ch->mode          = dmaModeBasic;
   LDMA_StartTransfer(channelId, transfer, descriptor);
 
   return ECODE_EMDRV_DMADRV_OK;
@@ -462,6 +493,7 @@ Ecode_t DMADRV_LdmaStartTransfer(int                            channelId,
   ch->callback      = callback;
   ch->userParam     = cbUserParam;
   ch->callbackCount = 0;
+  ch->mode          = dmaModeBasic;
   sl_hal_ldma_init_transfer(LDMA0, channelId, transfer, descriptor);
   sl_hal_ldma_enable_interrupts(LDMA0, (1 << channelId));
   sl_hal_ldma_start_transfer(LDMA0, channelId);
@@ -728,6 +760,171 @@ Ecode_t DMADRV_PeripheralMemoryPingPong(
                        cbUserParam);
 }
 
+#if defined(EMDRV_DMADRV_LDMA) || defined(EMDRV_DMADRV_LDMA_S3) || defined(DOXYGEN)
+/***************************************************************************//**
+ * @brief
+ *  Start an endless DMA transfer from a peripheral into a circular buffer.
+ *
+ * @details
+ *  The buffer is split in @p segments equally sized segments, each described
+ *  by its own LDMA descriptor. The last descriptor links back to the first one,
+ *  so the transfer wraps around without any software involvement.
+ *
+ *  The consumer side uses @ref DMADRV_RingAvailable() to find how much data
+ *  the DMA has written and @ref DMADRV_RingConsume() to release it. The write
+ *  position is read from the LDMA channel, so no interrupt per segment is
+ *  needed for this. When @p callback is NULL, only the last segment raises
+ *  an interrupt, once per turn of the ring.
+ *
+ *  When @p callback is not NULL, it is called each time a segment is complete,
+ *  i.e. on half and full buffer with 2 segments, on each quarter with
+ *  4 segments. The index of the completed segment is
+ *  (sequenceNo - 1) % segments. The ring is stopped at the end of the current
+ *  segment when the callback returns false.
+ *
+ * @param[in] channelId
+ *  The channel ID to use for the transfer.
+ *
+ * @param[in] peripheralSignal
+ *  Selects which peripheral/peripheralsignal to use.
+ *
+ * @param[in] dst
+ *  A destination circular buffer. It must be aligned to the item size.
+ *
+ * @param[in] src
+ *  A source (peripheral register) address.
+ *
+ * @param[in] len
+ *  A number of items in the buffer. It must be a multiple of @p segments.
+ *  A segment can't be longer than DMADRV_MAX_XFER_COUNT items.
+ *
+ * @param[in] segments
+ *  A number of segments in the buffer, a power of two no larger than
+ *  EMDRV_DMADRV_RING_MAX_SEGMENTS.
+ *
+ * @param[in] size
+ *  An item size, byte, halfword or word.
+ *
+ * @param[in] callback
+ *  A function to call on segment completion, use NULL if not needed.
+ *
+ * @param[in] cbUserParam
+ *  An optional user parameter to feed to the callback function. Use NULL if
+ *  not needed.
+ *
+ * @return
+ *   @ref ECODE_EMDRV_DMADRV_OK on success. On failure, an appropriate
+ *   DMADRV @ref Ecode_t is returned.
+ ******************************************************************************/
+Ecode_t DMADRV_PeripheralMemoryRing(unsigned int              channelId,
+                                    DMADRV_PeripheralSignal_t peripheralSignal,
+                                    void                      *dst,
+                                    void                      *src,
+                                    int                       len,
+                                    unsigned int              segments,
+                                    DMADRV_DataSize_t         size,
+                                    DMADRV_Callback_t         callback,
+                                    void                      *cbUserParam)
+{
+  ChTable_t *ch;
+  unsigned int i;
+  unsigned int segLen;
+#if defined(EMDRV_DMADRV_LDMA)
+  LDMA_TransferCfg_t xfer;
+  LDMA_Descriptor_t *desc;
+#else
+  sl_hal_ldma_transfer_config_t xfer;
+  sl_hal_ldma_descriptor_t *desc;
+#endif
+
+  if ( !initialized ) {
+    return ECODE_EMDRV_DMADRV_NOT_INITIALIZED;
+  }
+
+  if ( (channelId >= EMDRV_DMADRV_DMA_CH_COUNT)
+       || (dst == NULL)
+       || (src == NULL)
+       || (len <= 0)
+       || (segments == 0)
+       || (segments > EMDRV_DMADRV_RING_MAX_SEGMENTS)
+       || ((segments & (segments - 1)) != 0)
+       || (((unsigned int)len % segments) != 0)
+       || (((unsigned int)len / segments) > DMADRV_MAX_XFER_COUNT)
+       || (((uint32_t)dst & ((1UL << (unsigned int)size) - 1)) != 0) ) {
+    return ECODE_EMDRV_DMADRV_PARAM_ERROR;
+  }
+
+  ch = &chTable[channelId];
+  if ( ch->allocated == false ) {
+    return ECODE_EMDRV_DMADRV_CH_NOT_ALLOCATED;
+  }
+
+  segLen = (unsigned int)len / segments;
+  xfer   = xferCfgPeripheral;
+
+  for ( i = 0; i < segments; i++ ) {
+    desc  = &dmaXfer[channelId].desc[i];
+    *desc = p2m;
+
+#if defined(EMDRV_DMADRV_LDMA)
+    desc->xfer.xferCnt  = segLen - 1;
+    desc->xfer.dstAddr  = (uint32_t)((uint8_t *)dst + ((i * segLen) << (unsigned int)size));
+    desc->xfer.srcAddr  = (uint32_t)(uint8_t *)src;
+    desc->xfer.size     = size;
+    desc->xfer.linkMode = ldmaLinkModeRel;
+    desc->xfer.link     = 1;
+    /* Refer to the next descriptor, the last one back to the first one. */
+    desc->xfer.linkAddr = (i < (segments - 1)) ? 4 : -4 * (int)(segments - 1);
+
+    /* Without callback, only count the turns of the ring. */
+    if ( (callback == NULL) && (i < (segments - 1)) ) {
+      desc->xfer.doneIfs = 0;
+    }
+#else
+    desc->xfer.xfer_count = segLen - 1;
+    desc->xfer.dst_addr   = (uint32_t)((uint8_t *)dst + ((i * segLen) << (unsigned int)size));
+    desc->xfer.src_addr   = (uint32_t)(uint8_t *)src;
+    desc->xfer.size       = size;
+    desc->xfer.link_mode  = SL_HAL_LDMA_LINK_MODE_REL;
+    desc->xfer.link       = 1;
+    /* Refer to the next descriptor, the last one back to the first one. */
+    desc->xfer.link_addr  = (i < (segments - 1)) ? 4 : -4 * (int)(segments - 1);
+
+    /* Without callback, only count the turns of the ring. */
+    if ( (callback == NULL) && (i < (segments - 1)) ) {
+      desc->xfer.done_ifs = 0;
+    }
+#endif
+  }
+
+  ch->callback         = callback;
+  ch->userParam        = cbUserParam;
+  ch->callbackCount    = 0;
+  ch->mode             = dmaModeRing;
+  ch->ringBase         = (uint8_t *)dst;
+  ch->ringSizeShift    = (unsigned int)size;
+  ch->ringLen          = (unsigned int)len;
+  ch->ringSegments     = segments;
+  ch->ringIrqStep      = (callback == NULL) ? segments : 1;
+  ch->ringSegmentsDone = 0;
+  ch->ringReadCount    = 0;
+  ch->ringReadIndex    = 0;
+
+  desc = &dmaXfer[channelId].desc[0];
+#if defined(EMDRV_DMADRV_LDMA)
+  xfer.ldmaReqSel = peripheralSignal;
+  LDMA_StartTransfer(channelId, &xfer, desc);
+#else
+  xfer.request_sel = peripheralSignal;
+  sl_hal_ldma_init_transfer(LDMA0, channelId, &xfer, desc);
+  sl_hal_ldma_start_transfer(LDMA0, channelId);
+  sl_hal_ldma_enable_interrupts(LDMA0, (0x1UL << channelId));
+#endif
+
+  return ECODE_EMDRV_DMADRV_OK;
+}
+#endif
+
 /***************************************************************************//**
  * @brief
  *  Pause an ongoing DMA transfer.
@@ -800,6 +997,158 @@ Ecode_t DMADRV_ResumeTransfer(unsigned int channelId)
   return ECODE_EMDRV_DMADRV_OK;
 }
 
+#if defined(EMDRV_DMADRV_LDMA) || defined(EMDRV_DMADRV_LDMA_S3) || defined(DOXYGEN)
+/***************************************************************************//**
+ * @brief
+ *  Get the unread data of a ring transfer.
+ *
+ * @details
+ *  The write position is taken from the LDMA channel, so the result is exact
+ *  to the item even in the middle of a segment. This function doesn't disable
+ *  interrupts and can be polled, but it must not be called from an interrupt
+ *  with a higher priority than the DMA interrupt.
+ *
+ *  If the DMA has overwritten data which was not consumed yet, the read index
+ *  is moved to the write position, @p available is set to 0 and
+ *  @ref ECODE_EMDRV_DMADRV_RING_OVERRUN is returned.
+ *
+ * @param[in] channelId
+ *  The channel ID of the ring transfer.
+ *
+ * @param[out] readIndex
+ *  The index of the first unread item in the buffer. Use NULL if not needed.
+ *
+ * @param[out] available
+ *  A number of unread items, starting at @p readIndex. Data may wrap around
+ *  the end of the buffer.
+ *
+ * @return
+ *  @ref ECODE_EMDRV_DMADRV_OK on success. On failure, an appropriate
+ *  DMADRV @ref Ecode_t is returned.
+ ******************************************************************************/
+Ecode_t DMADRV_RingAvailable(unsigned int channelId,
+                             int          *readIndex,
+                             int          *available)
+{
+  ChTable_t *ch;
+  uint32_t done, lap, written, unread;
+  unsigned int pos, pos2, segLen;
+  bool pending;
+
+  if ( !initialized ) {
+    return ECODE_EMDRV_DMADRV_NOT_INITIALIZED;
+  }
+
+  if ( (channelId >= EMDRV_DMADRV_DMA_CH_COUNT)
+       || (available == NULL) ) {
+    return ECODE_EMDRV_DMADRV_PARAM_ERROR;
+  }
+
+  ch = &chTable[channelId];
+  if ( ch->allocated == false ) {
+    return ECODE_EMDRV_DMADRV_CH_NOT_ALLOCATED;
+  }
+
+  if ( ch->mode != dmaModeRing ) {
+    return ECODE_EMDRV_DMADRV_PARAM_ERROR;
+  }
+
+  /* Take a consistent snapshot of the interrupt handler count, the write
+     position and the interrupt flag. Retry if the ring wrapped meanwhile. */
+  do {
+    done = ch->ringSegmentsDone;
+    pos  = RingWritePosition(channelId);
+#if defined(EMDRV_DMADRV_LDMA)
+    pending = (LDMA->IF & (1 << channelId)) != 0;
+#else
+    pending = (sl_hal_ldma_get_pending_interrupts(LDMA0) & (1 << channelId)) != 0;
+#endif
+    pos2 = RingWritePosition(channelId);
+  } while ( (done != ch->ringSegmentsDone) || (pos2 < pos) );
+
+  segLen = ch->ringLen / ch->ringSegments;
+  lap    = done / ch->ringSegments;
+
+  /* Account for a ring wrap which the interrupt handler hasn't seen yet. */
+  if ( ch->ringIrqStep == 1U && ch->ringSegments > 1U ) {
+    if ( (pos / segLen) < (done % ch->ringSegments) ) {
+      lap++;
+    }
+  } else if ( pending ) {
+    lap++;
+  }
+
+  /* Counters wrap at 2^32, which is a whole number of segments. */
+  written = (lap * ch->ringLen) + pos;
+  unread  = written - ch->ringReadCount;
+
+  if ( unread > ch->ringLen ) {
+    ch->ringReadCount = written;
+    ch->ringReadIndex = pos;
+    if ( readIndex != NULL ) {
+      *readIndex = (int)pos;
+    }
+    *available = 0;
+    return ECODE_EMDRV_DMADRV_RING_OVERRUN;
+  }
+
+  if ( readIndex != NULL ) {
+    *readIndex = (int)ch->ringReadIndex;
+  }
+  *available = (int)unread;
+
+  return ECODE_EMDRV_DMADRV_OK;
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Release data of a ring transfer once it has been read.
+ *
+ * @param[in] channelId
+ *  The channel ID of the ring transfer.
+ *
+ * @param[in] count
+ *  A number of items to release, at most the number returned by
+ *  @ref DMADRV_RingAvailable().
+ *
+ * @return
+ *  @ref ECODE_EMDRV_DMADRV_OK on success. On failure, an appropriate
+ *  DMADRV @ref Ecode_t is returned.
+ ******************************************************************************/
+Ecode_t DMADRV_RingConsume(unsigned int channelId, int count)
+{
+  ChTable_t *ch;
+
+  if ( !initialized ) {
+    return ECODE_EMDRV_DMADRV_NOT_INITIALIZED;
+  }
+
+  if ( channelId >= EMDRV_DMADRV_DMA_CH_COUNT ) {
+    return ECODE_EMDRV_DMADRV_PARAM_ERROR;
+  }
+
+  ch = &chTable[channelId];
+  if ( ch->allocated == false ) {
+    return ECODE_EMDRV_DMADRV_CH_NOT_ALLOCATED;
+  }
+
+  if ( (ch->mode != dmaModeRing)
+       || (count < 0)
+       || ((unsigned int)count > ch->ringLen) ) {
+    return ECODE_EMDRV_DMADRV_PARAM_ERROR;
+  }
+
+  /* Only the consumer updates these, the interrupt handler never does. */
+  ch->ringReadCount += (uint32_t)count;
+  ch->ringReadIndex += (unsigned int)count;
+  if ( ch->ringReadIndex >= ch->ringLen ) {
+    ch->ringReadIndex -= ch->ringLen;
+  }
+
+  return ECODE_EMDRV_DMADRV_OK;
+}
+#endif
+
 /***************************************************************************//**
  * @brief
  *  Stop an ongoing DMA transfer.
@@ -1092,6 +1441,10 @@ void LDMA_IRQHandler(void)
 #endif
 
       ch = &chTable[chnum];
+      if ( ch->mode == dmaModeRing ) {
+        ch->ringSegmentsDone += ch->ringIrqStep;
+      }
+
       if ( ch->callback != NULL ) {
         ch->callbackCount++;
         stop = !ch->callback(chnum, ch->callbackCount, ch->userParam);
@@ -1099,6 +1452,8 @@ void LDMA_IRQHandler(void)
         if ( (ch->mode == dmaModePingPong) && stop ) {
           dmaXfer[chnum].desc[0].xfer.link = 0;
           dmaXfer[chnum].desc[1].xfer.link = 0;
+        } else if ( (ch->mode == dmaModeRing) && stop ) {
+          RingBreakLinks(chnum);
         }
       }
     }
@@ -1139,14 +1494,20 @@ static void LDMA_IRQHandlerDefault(uint8_t chnum)
 
     /* Callback called if it was provided for the given channel. */
     ch = &chTable[chnum];
+    if ( ch->mode == dmaModeRing ) {
+      ch->ringSegmentsDone += ch->ringIrqStep;
+    }
+
     if ( ch->callback != NULL ) {
       ch->callbackCount++;
       stop = !ch->callback(chnum, ch->callbackCount, ch->userParam);
 
-      /* Continue or not a ping-pong transfer. */
+      /* Continue or not a ping-pong or ring transfer. */
       if ( (ch->mode == dmaModePingPong) && stop ) {
         dmaXfer[chnum].desc[0].xfer.link = 0;
         dmaXfer[chnum].desc[1].xfer.link = 0;
+      } else if ( (ch->mode == dmaModeRing) && stop ) {
+        RingBreakLinks(chnum);
       }
     }
   }
@@ -1594,6 +1955,47 @@ static Ecode_t StartTransfer(DmaMode_t             mode,
 }
 #endif /* defined( EMDRV_DMADRV_LDMA_S3 ) */
 
+#if defined(EMDRV_DMADRV_LDMA) || defined(EMDRV_DMADRV_LDMA_S3)
+/***************************************************************************//**
+ * @brief
+ *  Unlink the descriptors of a ring transfer, the transfer stops at the end
+ *  of the current segment.
+ ******************************************************************************/
+static void RingBreakLinks(unsigned int channelId)
+{
+  unsigned int i;
+
+  for ( i = 0; i < chTable[channelId].ringSegments; i++ ) {
+    dmaXfer[channelId].desc[i].xfer.link = 0;
+  }
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Get the ring index the DMA will write next. The end of the last segment
+ *  is reported as index 0 of the next turn.
+ ******************************************************************************/
+static unsigned int RingWritePosition(unsigned int channelId)
+{
+  ChTable_t *ch = &chTable[channelId];
+  uint32_t dst;
+  unsigned int pos;
+
+#if defined(EMDRV_DMADRV_LDMA)
+  dst = LDMA->CH[channelId].DST;
+#else
+  dst = LDMA0->CH[channelId].DST;
+#endif
+
+  pos = (unsigned int)((dst - (uint32_t)ch->ringBase) >> ch->ringSizeShift);
+  if ( pos >= ch->ringLen ) {
+    pos = 0;
+  }
+
+  return pos;
+}
+#endif
+
 /// @endcond
 
 // ******** THE REST OF THE FILE IS DOCUMENTATION ONLY !***********************
@@ -1690,6 +2092,15 @@ static Ecode_t StartTransfer(DmaMode_t             mode,
 ///   @ref DMADRV_LdmaStartTransfer() @n
 ///    Start a DMA transfer on an LDMA controller.
 ///
+///   @ref DMADRV_PeripheralMemoryRing() @n
+///    Start an endless DMA transfer from a peripheral into a circular buffer
+///    split in segments, with an optional callback per segment.
+///
+///   @ref DMADRV_RingAvailable(), @ref DMADRV_RingConsume() @n
+///    Get the unread data of a ring transfer and release it once read.
+///    The DMA write position is read back from the hardware, so polling the
+///    ring needs no interrupt per segment.
+///
 ///   @ref DMADRV_PauseTransfer() @n
 ///    Pause an ongoing DMA transfer.
 ///
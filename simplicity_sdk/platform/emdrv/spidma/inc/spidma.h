@@ -0,0 +1,157 @@
+/***************************************************************************//**
+ * @file
+ * @brief SPIDMA API definition.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+
+#ifndef __SILICON_LABS_SPIDMA_H__
+#define __SILICON_LABS_SPIDMA_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "em_device.h"
+#include "em_gpio.h"
+
+#include "ecode.h"
+#include "dmadrv.h"
+#include "spidma_config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***************************************************************************//**
+ * @addtogroup spidma
+ * @{
+ ******************************************************************************/
+
+/***************************************************************************//**
+ * @addtogroup spidma_error_codes Error Codes
+ * @{
+ ******************************************************************************/
+
+#define ECODE_EMDRV_SPIDMA_OK                (ECODE_OK)                               ///< A successful return value.
+#define ECODE_EMDRV_SPIDMA_PARAM_ERROR       (ECODE_EMDRV_SPIDMA_BASE | 0x00000001)   ///< An illegal input parameter.
+#define ECODE_EMDRV_SPIDMA_NOT_INITIALIZED   (ECODE_EMDRV_SPIDMA_BASE | 0x00000002)   ///< The handle is not initialized.
+#define ECODE_EMDRV_SPIDMA_BUSY              (ECODE_EMDRV_SPIDMA_BASE | 0x00000003)   ///< The peripheral or transfer is already in use.
+#define ECODE_EMDRV_SPIDMA_ABORTED           (ECODE_EMDRV_SPIDMA_BASE | 0x00000004)   ///< The transfer was aborted.
+#define ECODE_EMDRV_SPIDMA_DMA_ERROR         (ECODE_EMDRV_SPIDMA_BASE | 0x00000005)   ///< A DMADRV call failed.
+
+/** @} (end addtogroup error codes) */
+
+/// SPIDMA handle data, must stay allocated while the handle is in use.
+typedef struct SPIDMA_HandleData SPIDMA_HandleData_t;
+
+/// SPIDMA handle.
+typedef SPIDMA_HandleData_t *SPIDMA_Handle_t;
+
+/// SPIDMA transfer, must stay allocated until its callback is called.
+typedef struct SPIDMA_Transfer SPIDMA_Transfer_t;
+
+/***************************************************************************//**
+ * @brief
+ *  Transfer completion callback, called from the DMA interrupt handler.
+ *
+ * @details
+ *  The transfer can be queued again from the callback.
+ *
+ * @param[in] handle
+ *  The SPIDMA handle.
+ *
+ * @param[in] transfer
+ *  The completed transfer.
+ *
+ * @param[in] status
+ *  @ref ECODE_EMDRV_SPIDMA_OK when the transfer is complete,
+ *  @ref ECODE_EMDRV_SPIDMA_ABORTED when it was removed by
+ *  @ref SPIDMA_AbortAll().
+ ******************************************************************************/
+typedef void (*SPIDMA_Callback_t)(SPIDMA_Handle_t   handle,
+                                  SPIDMA_Transfer_t *transfer,
+                                  Ecode_t           status);
+
+/// SPIDMA full duplex transfer.
+struct SPIDMA_Transfer {
+  const uint8_t      *txBuffer;      ///< Data to send, NULL to send EMDRV_SPIDMA_DUMMY_TX_VALUE.
+  uint8_t            *rxBuffer;      ///< Buffer for the received data, NULL to discard it.
+  uint32_t           count;          ///< Number of bytes, at most DMADRV_MAX_XFER_COUNT.
+  bool               keepCsActive;   ///< Keep chip select asserted for the next transfer.
+  SPIDMA_Callback_t  callback;       ///< Completion callback, NULL if not used.
+  void               *userParam;     ///< User parameter for the callback.
+  /// @cond DO_NOT_INCLUDE_WITH_DOXYGEN
+  SPIDMA_Transfer_t  *next;
+  /// @endcond
+};
+
+/// SPIDMA initialization structure.
+typedef struct {
+#if defined(USART_PRESENT)
+  USART_TypeDef      *usart;         ///< USART to use, NULL when an EUSART is used.
+#endif
+#if defined(EUSART_PRESENT)
+  EUSART_TypeDef     *eusart;        ///< EUSART to use, NULL when a USART is used.
+#endif
+  bool               csControl;      ///< Drive the chip select pin from the driver.
+  GPIO_Port_TypeDef  csPort;         ///< Chip select port, active low.
+  unsigned int       csPin;          ///< Chip select pin.
+} SPIDMA_Init_t;
+
+/// @cond DO_NOT_INCLUDE_WITH_DOXYGEN
+struct SPIDMA_HandleData {
+#if defined(USART_PRESENT)
+  USART_TypeDef      *usart;
+#endif
+#if defined(EUSART_PRESENT)
+  EUSART_TypeDef     *eusart;
+#endif
+  unsigned int       portIndex;      // Index in the port table
+  bool               csControl;
+  GPIO_Port_TypeDef  csPort;
+  unsigned int       csPin;
+  unsigned int       txDmaCh;
+  unsigned int       rxDmaCh;
+  SPIDMA_Transfer_t  *head;          // Ongoing transfer
+  SPIDMA_Transfer_t  *tail;          // Last queued transfer
+  uint8_t            rxDiscard;      // Sink of received data which is not kept
+  bool               initialized;
+};
+/// @endcond
+
+Ecode_t SPIDMA_Init(SPIDMA_Handle_t handle, const SPIDMA_Init_t *init);
+Ecode_t SPIDMA_DeInit(SPIDMA_Handle_t handle);
+Ecode_t SPIDMA_Queue(SPIDMA_Handle_t handle, SPIDMA_Transfer_t *transfer);
+Ecode_t SPIDMA_AbortAll(SPIDMA_Handle_t handle);
+bool SPIDMA_IsIdle(SPIDMA_Handle_t handle);
+
+/** @} (end addtogroup spidma) */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __SILICON_LABS_SPIDMA_H__
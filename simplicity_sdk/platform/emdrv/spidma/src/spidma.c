@@ -0,0 +1,612 @@
+/***************************************************************************//**
+ * @file
+ * @brief SPIDMA API implementation.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "em_device.h"
+#include "em_gpio.h"
+#if defined(USART_PRESENT)
+#include "em_usart.h"
+#endif
+#if defined(EUSART_PRESENT)
+#include "em_eusart.h"
+#endif
+#include "sl_core.h"
+
+#include "spidma.h"
+
+/// @cond DO_NOT_INCLUDE_WITH_DOXYGEN
+
+#if !defined(EMDRV_SPIDMA_DUMMY_TX_VALUE)
+#define EMDRV_SPIDMA_DUMMY_TX_VALUE 0xFF
+#endif
+
+// Hardware resources of a USART or EUSART instance
+typedef struct {
+  const void                *port;
+  bool                      eusart;
+  DMADRV_PeripheralSignal_t txSignal;
+  DMADRV_PeripheralSignal_t rxSignal;
+} PortInfo_t;
+
+static const PortInfo_t portTable[] = {
+#if defined(USART0)
+  { USART0, false, dmadrvPeripheralSignal_USART0_TXBL, dmadrvPeripheralSignal_USART0_RXDATAV },
+#endif
+#if defined(USART1)
+  { USART1, false, dmadrvPeripheralSignal_USART1_TXBL, dmadrvPeripheralSignal_USART1_RXDATAV },
+#endif
+#if defined(USART2)
+  { USART2, false, dmadrvPeripheralSignal_USART2_TXBL, dmadrvPeripheralSignal_USART2_RXDATAV },
+#endif
+#if defined(EUSART0)
+  { EUSART0, true, dmadrvPeripheralSignal_EUSART0_TXBL, dmadrvPeripheralSignal_EUSART0_RXDATAV },
+#endif
+#if defined(EUSART1)
+  { EUSART1, true, dmadrvPeripheralSignal_EUSART1_TXBL, dmadrvPeripheralSignal_EUSART1_RXDATAV },
+#endif
+#if defined(EUSART2)
+  { EUSART2, true, dmadrvPeripheralSignal_EUSART2_TXBL, dmadrvPeripheralSignal_EUSART2_RXDATAV },
+#endif
+};
+
+#define PORT_COUNT  (sizeof(portTable) / sizeof(portTable[0]))
+
+static SPIDMA_Handle_t handleTable[PORT_COUNT];
+
+static const uint8_t txDummy = EMDRV_SPIDMA_DUMMY_TX_VALUE;
+
+static Ecode_t StartTransfer(SPIDMA_Handle_t handle);
+static bool RxDmaComplete(unsigned int channel,
+                          unsigned int sequenceNo,
+                          void *userParam);
+static void ClearRx(SPIDMA_Handle_t handle);
+static void *TxDataRegister(SPIDMA_Handle_t handle);
+static void *RxDataRegister(SPIDMA_Handle_t handle);
+
+/// @endcond
+
+/***************************************************************************//**
+ * @brief
+ *  Initialize a SPIDMA handle.
+ *
+ * @details
+ *  The USART or EUSART must be clocked, routed to its pins and initialized as
+ *  SPI master, e.g. with USART_InitSync() or EUSART_SpiInit(), before calling
+ *  this function. When csControl is set, the chip select pin is configured as
+ *  a push-pull output and driven high.
+ *
+ * @param[in] handle
+ *  A pointer to the handle data, which must stay allocated until
+ *  @ref SPIDMA_DeInit() is called.
+ *
+ * @param[in] init
+ *  A pointer to the initialization structure.
+ *
+ * @return
+ *  @ref ECODE_EMDRV_SPIDMA_OK on success. On failure, an appropriate
+ *  SPIDMA @ref Ecode_t is returned.
+ ******************************************************************************/
+Ecode_t SPIDMA_Init(SPIDMA_Handle_t handle, const SPIDMA_Init_t *init)
+{
+  const void *port = NULL;
+  unsigned int portIndex;
+  Ecode_t ecode;
+  CORE_DECLARE_IRQ_STATE;
+
+  if ((handle == NULL) || (init == NULL)) {
+    return ECODE_EMDRV_SPIDMA_PARAM_ERROR;
+  }
+#if defined(USART_PRESENT)
+  if (init->usart != NULL) {
+    port = init->usart;
+  }
+#endif
+#if defined(EUSART_PRESENT)
+  if (init->eusart != NULL) {
+    if (port != NULL) {
+      return ECODE_EMDRV_SPIDMA_PARAM_ERROR;
+    }
+    port = init->eusart;
+  }
+#endif
+  for (portIndex = 0; portIndex < PORT_COUNT; portIndex++) {
+    if (portTable[portIndex].port == port) {
+      break;
+    }
+  }
+  if ((port == NULL) || (portIndex == PORT_COUNT)) {
+    return ECODE_EMDRV_SPIDMA_PARAM_ERROR;
+  }
+
+  CORE_ENTER_ATOMIC();
+  if (handleTable[portIndex] != NULL) {
+    CORE_EXIT_ATOMIC();
+    return ECODE_EMDRV_SPIDMA_BUSY;
+  }
+  handleTable[portIndex] = handle;
+  CORE_EXIT_ATOMIC();
+
+#if defined(USART_PRESENT)
+  handle->usart = init->usart;
+#endif
+#if defined(EUSART_PRESENT)
+  handle->eusart = init->eusart;
+#endif
+  handle->portIndex = portIndex;
+  handle->csControl = init->csControl;
+  handle->csPort    = init->csPort;
+  handle->csPin     = init->csPin;
+  handle->head      = NULL;
+  handle->tail      = NULL;
+
+  ecode = DMADRV_Init();
+  if ((ecode != ECODE_EMDRV_DMADRV_OK)
+      && (ecode != ECODE_EMDRV_DMADRV_ALREADY_INITIALIZED)) {
+    handleTable[portIndex] = NULL;
+    return ECODE_EMDRV_SPIDMA_DMA_ERROR;
+  }
+  if (DMADRV_AllocateChannel(&handle->txDmaCh, NULL) != ECODE_EMDRV_DMADRV_OK) {
+    handleTable[portIndex] = NULL;
+    return ECODE_EMDRV_SPIDMA_DMA_ERROR;
+  }
+  if (DMADRV_AllocateChannel(&handle->rxDmaCh, NULL) != ECODE_EMDRV_DMADRV_OK) {
+    DMADRV_FreeChannel(handle->txDmaCh);
+    handleTable[portIndex] = NULL;
+    return ECODE_EMDRV_SPIDMA_DMA_ERROR;
+  }
+
+  if (handle->csControl) {
+    GPIO_PinModeSet(handle->csPort, handle->csPin, gpioModePushPull, 1);
+  }
+
+  handle->initialized = true;
+
+  return ECODE_EMDRV_SPIDMA_OK;
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Deinitialize a SPIDMA handle.
+ *
+ * @details
+ *  Queued transfers are aborted, see @ref SPIDMA_AbortAll().
+ *
+ * @param[in] handle
+ *  The SPIDMA handle.
+ *
+ * @return
+ *  @ref ECODE_EMDRV_SPIDMA_OK on success. On failure, an appropriate
+ *  SPIDMA @ref Ecode_t is returned.
+ ******************************************************************************/
+Ecode_t SPIDMA_DeInit(SPIDMA_Handle_t handle)
+{
+  Ecode_t ecode;
+
+  ecode = SPIDMA_AbortAll(handle);
+  if (ecode != ECODE_EMDRV_SPIDMA_OK) {
+    return ecode;
+  }
+
+  DMADRV_FreeChannel(handle->rxDmaCh);
+  DMADRV_FreeChannel(handle->txDmaCh);
+  if (handle->csControl) {
+    GPIO_PinModeSet(handle->csPort, handle->csPin, gpioModeDisabled, 0);
+  }
+
+  handle->initialized = false;
+  handleTable[handle->portIndex] = NULL;
+
+  return ECODE_EMDRV_SPIDMA_OK;
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Queue a full duplex transfer.
+ *
+ * @details
+ *  Transfers are run back-to-back in the order they are queued, the next one
+ *  is started from the DMA interrupt handler as soon as the previous one is
+ *  complete. Chip select is asserted before a transfer and released after it
+ *  unless keepCsActive is set, which allows splitting a transaction into
+ *  several transfers, e.g. a command header and a payload, without copying
+ *  them into one buffer.
+ *
+ *  This function can be called from interrupt context, including from a
+ *  transfer callback.
+ *
+ * @param[in] handle
+ *  The SPIDMA handle.
+ *
+ * @param[in] transfer
+ *  The transfer, which must stay allocated and unmodified until its callback
+ *  is called.
+ *
+ * @return
+ *  @ref ECODE_EMDRV_SPIDMA_OK on success. On failure, an appropriate
+ *  SPIDMA @ref Ecode_t is returned and the transfer callback is not called.
+ ******************************************************************************/
+Ecode_t SPIDMA_Queue(SPIDMA_Handle_t handle, SPIDMA_Transfer_t *transfer)
+{
+  bool idle;
+  Ecode_t ecode;
+  CORE_DECLARE_IRQ_STATE;
+
+  if ((handle == NULL) || !handle->initialized) {
+    return ECODE_EMDRV_SPIDMA_NOT_INITIALIZED;
+  }
+  if ((transfer == NULL)
+      || (transfer->count == 0U)
+      || (transfer->count > (uint32_t)DMADRV_MAX_XFER_COUNT)) {
+    return ECODE_EMDRV_SPIDMA_PARAM_ERROR;
+  }
+
+  transfer->next = NULL;
+
+  CORE_ENTER_ATOMIC();
+  idle = (handle->head == NULL);
+  if (idle) {
+    handle->head = transfer;
+  } else {
+    handle->tail->next = transfer;
+  }
+  handle->tail = transfer;
+  CORE_EXIT_ATOMIC();
+
+  if (idle) {
+    ecode = StartTransfer(handle);
+    if (ecode != ECODE_EMDRV_SPIDMA_OK) {
+      // The failure is only reported by the return value. Transfers queued
+      // behind this one in the meantime are aborted.
+      CORE_ENTER_ATOMIC();
+      handle->head = transfer->next;
+      if (handle->head == NULL) {
+        handle->tail = NULL;
+      }
+      CORE_EXIT_ATOMIC();
+      SPIDMA_AbortAll(handle);
+    }
+    return ecode;
+  }
+
+  return ECODE_EMDRV_SPIDMA_OK;
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Abort all queued transfers.
+ *
+ * @details
+ *  The ongoing transfer is stopped and chip select is released. The callback
+ *  of every queued transfer is called with @ref ECODE_EMDRV_SPIDMA_ABORTED.
+ *
+ * @param[in] handle
+ *  The SPIDMA handle.
+ *
+ * @return
+ *  @ref ECODE_EMDRV_SPIDMA_OK on success. On failure, an appropriate
+ *  SPIDMA @ref Ecode_t is returned.
+ ******************************************************************************/
+Ecode_t SPIDMA_AbortAll(SPIDMA_Handle_t handle)
+{
+  SPIDMA_Transfer_t *transfer;
+  CORE_DECLARE_IRQ_STATE;
+
+  if ((handle == NULL) || !handle->initialized) {
+    return ECODE_EMDRV_SPIDMA_NOT_INITIALIZED;
+  }
+
+  CORE_ENTER_ATOMIC();
+  DMADRV_StopTransfer(handle->txDmaCh);
+  DMADRV_StopTransfer(handle->rxDmaCh);
+  if (handle->csControl) {
+    GPIO_PinOutSet(handle->csPort, handle->csPin);
+  }
+  transfer     = handle->head;
+  handle->head = NULL;
+  handle->tail = NULL;
+  CORE_EXIT_ATOMIC();
+
+  while (transfer != NULL) {
+    SPIDMA_Transfer_t *next = transfer->next;
+
+    if (transfer->callback != NULL) {
+      transfer->callback(handle, transfer, ECODE_EMDRV_SPIDMA_ABORTED);
+    }
+    transfer = next;
+  }
+
+  return ECODE_EMDRV_SPIDMA_OK;
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Check whether all queued transfers are complete.
+ *
+ * @param[in] handle
+ *  The SPIDMA handle.
+ *
+ * @return
+ *  true if no transfer is ongoing or queued, or if the handle is not
+ *  initialized.
+ ******************************************************************************/
+bool SPIDMA_IsIdle(SPIDMA_Handle_t handle)
+{
+  if ((handle == NULL) || !handle->initialized) {
+    return true;
+  }
+
+  return handle->head == NULL;
+}
+
+/// @cond DO_NOT_INCLUDE_WITH_DOXYGEN
+
+/***************************************************************************//**
+ * @brief
+ *  Start the transfer at the head of the queue.
+ *
+ * @details
+ *  RX is started first so that no received byte can be missed. The transfer
+ *  is complete when the RX DMA has received its last byte. On failure, the
+ *  DMA and chip select are released and the queue is left to the caller.
+ ******************************************************************************/
+static Ecode_t StartTransfer(SPIDMA_Handle_t handle)
+{
+  SPIDMA_Transfer_t *transfer = handle->head;
+  Ecode_t ecode;
+
+  ClearRx(handle);
+
+  if (handle->csControl) {
+    GPIO_PinOutClear(handle->csPort, handle->csPin);
+  }
+
+  ecode = DMADRV_PeripheralMemory(handle->rxDmaCh,
+                                  portTable[handle->portIndex].rxSignal,
+                                  (transfer->rxBuffer != NULL)
+                                  ? (void *)transfer->rxBuffer
+                                  : (void *)&handle->rxDiscard,
+                                  RxDataRegister(handle),
+                                  transfer->rxBuffer != NULL,
+                                  (int)transfer->count,
+                                  dmadrvDataSize1,
+                                  RxDmaComplete,
+                                  handle);
+  if (ecode == ECODE_EMDRV_DMADRV_OK) {
+    ecode = DMADRV_MemoryPeripheral(handle->txDmaCh,
+                                    portTable[handle->portIndex].txSignal,
+                                    TxDataRegister(handle),
+                                    (transfer->txBuffer != NULL)
+                                    ? (void *)transfer->txBuffer
+                                    : (void *)&txDummy,
+                                    transfer->txBuffer != NULL,
+                                    (int)transfer->count,
+                                    dmadrvDataSize1,
+                                    NULL,
+                                    NULL);
+  }
+
+  if (ecode != ECODE_EMDRV_DMADRV_OK) {
+    DMADRV_StopTransfer(handle->rxDmaCh);
+    if (handle->csControl) {
+      GPIO_PinOutSet(handle->csPort, handle->csPin);
+    }
+    return ECODE_EMDRV_SPIDMA_DMA_ERROR;
+  }
+
+  return ECODE_EMDRV_SPIDMA_OK;
+}
+
+/***************************************************************************//**
+ * @brief
+ *  RX DMA completion callback. Completes the ongoing transfer and starts the
+ *  next one.
+ ******************************************************************************/
+static bool RxDmaComplete(unsigned int channel,
+                          unsigned int sequenceNo,
+                          void *userParam)
+{
+  SPIDMA_Handle_t handle = (SPIDMA_Handle_t)userParam;
+  SPIDMA_Transfer_t *transfer = handle->head;
+  bool startFailed = false;
+
+  (void)channel;
+  (void)sequenceNo;
+
+  if (transfer == NULL) {
+    return true;
+  }
+
+  if (handle->csControl && !transfer->keepCsActive) {
+    GPIO_PinOutSet(handle->csPort, handle->csPin);
+  }
+
+  handle->head = transfer->next;
+  if (handle->head == NULL) {
+    handle->tail = NULL;
+  }
+
+  // Start the next transfer before the callback to keep the bus busy
+  if (handle->head != NULL) {
+    startFailed = (StartTransfer(handle) != ECODE_EMDRV_SPIDMA_OK);
+  }
+
+  if (transfer->callback != NULL) {
+    transfer->callback(handle, transfer, ECODE_EMDRV_SPIDMA_OK);
+  }
+
+  // The queued transfers can't run, report them as aborted
+  if (startFailed) {
+    SPIDMA_AbortAll(handle);
+  }
+
+  return true;
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Discard stale data in the RX FIFO.
+ ******************************************************************************/
+static void ClearRx(SPIDMA_Handle_t handle)
+{
+#if defined(EUSART_PRESENT)
+  if (portTable[handle->portIndex].eusart) {
+    while ((handle->eusart->STATUS & EUSART_STATUS_RXFL) != 0U) {
+      (void)handle->eusart->RXDATA;
+    }
+    return;
+  }
+#endif
+#if defined(USART_PRESENT)
+  handle->usart->CMD = USART_CMD_CLEARRX;
+#endif
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Get the TX data register of the peripheral.
+ ******************************************************************************/
+static void *TxDataRegister(SPIDMA_Handle_t handle)
+{
+#if defined(EUSART_PRESENT)
+  if (portTable[handle->portIndex].eusart) {
+    return (void *)&handle->eusart->TXDATA;
+  }
+#endif
+#if defined(USART_PRESENT)
+  return (void *)&handle->usart->TXDATA;
+#else
+  return NULL;
+#endif
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Get the RX data register of the peripheral.
+ ******************************************************************************/
+static void *RxDataRegister(SPIDMA_Handle_t handle)
+{
+#if defined(EUSART_PRESENT)
+  if (portTable[handle->portIndex].eusart) {
+    return (void *)&handle->eusart->RXDATA;
+  }
+#endif
+#if defined(USART_PRESENT)
+  return (void *)&handle->usart->RXDATA;
+#else
+  return NULL;
+#endif
+}
+
+/// @endcond
+
+// ******** THE REST OF THE FILE IS DOCUMENTATION ONLY !***********************
+/// @addtogroup spidma SPIDMA - DMA SPI Driver
+/// @brief Asynchronous DMA based SPI master driver
+/// @{
+///
+///   @details
+///
+///   @n @section spidma_intro Introduction
+///
+///   The SPIDMA driver runs queued full duplex SPI master transfers on a USART
+///   or EUSART with the LDMA. Transfers are started back-to-back from the DMA
+///   interrupt handler and the driver drives the chip select pin around them,
+///   so a sequence of transactions needs no CPU involvement between bytes,
+///   unlike USART_SpiTransfer() or EUSART_Spi_TxRx() which poll the status
+///   register for every byte.
+///
+///   The peripheral is set up with the emlib API, the driver only takes over
+///   data transfers. The spidma.c and spidma.h source files are in the
+///   emdrv/spidma folder. SPIDMA is not related to the SPIDRV driver and has
+///   its own API.
+///
+///   @note The transfer callbacks are called from the DMA interrupt handler.
+///
+///   @n @section spidma_perf CPU Load
+///
+///   With the polled API the CPU is busy for every bit on the bus and adds a
+///   status poll and a register access between bytes, which typically leaves
+///   gaps between bytes at high bit rates. With SPIDMA the bytes are moved by
+///   the LDMA at the bus rate and the CPU handles one DMA interrupt per
+///   transfer.
+///
+///   @n @section spidma_api The API
+///
+///   Most functions return an error code, @ref ECODE_EMDRV_SPIDMA_OK is
+///   returned on success, see @ref ecode and @ref spidma_error_codes for other
+///   error codes.
+///
+///   @ref SPIDMA_Init(), @ref SPIDMA_DeInit() @n
+///    Start and stop the driver on an initialized USART or EUSART.
+///
+///   @ref SPIDMA_Queue() @n
+///    Queue a full duplex transfer.
+///
+///   @ref SPIDMA_AbortAll() @n
+///    Stop the ongoing transfer and drop the queued ones.
+///
+///   @ref SPIDMA_IsIdle() @n
+///    Check whether all queued transfers are complete.
+///
+///   @n @section spidma_example Example
+///   @code{.c}
+/// static SPIDMA_HandleData_t handleData;
+/// static uint8_t command[4] = { 0x03, 0x00, 0x10, 0x00 };
+/// static uint8_t data[256];
+///
+/// static void readDone(SPIDMA_Handle_t handle, SPIDMA_Transfer_t *transfer, Ecode_t status)
+/// {
+///   // data[] holds the flash content
+/// }
+///
+/// static SPIDMA_Transfer_t commandTransfer = {
+///   .txBuffer = command, .count = sizeof(command), .keepCsActive = true,
+/// };
+/// static SPIDMA_Transfer_t dataTransfer = {
+///   .rxBuffer = data, .count = sizeof(data), .callback = readDone,
+/// };
+///
+/// void readFlash(void)
+/// {
+///   SPIDMA_Init_t init = {
+///     .usart = USART0, .csControl = true, .csPort = gpioPortC, .csPin = 1,
+///   };
+///
+///   // USART0 clocks, pins and USART_InitSync() set up here
+///
+///   SPIDMA_Init(&handleData, &init);
+///   SPIDMA_Queue(&handleData, &commandTransfer);
+///   SPIDMA_Queue(&handleData, &dataTransfer);
+/// }
+///   @endcode
+///
+/// @} end group spidma ********************************************************
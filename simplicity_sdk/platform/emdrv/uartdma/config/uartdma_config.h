@@ -0,0 +1,58 @@
+/***************************************************************************//**
+ * @file
+ * @brief UARTDMA configuration file.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+
+#ifndef UARTDMA_CONFIG_H
+#define UARTDMA_CONFIG_H
+
+// <<< Use Configuration Wizard in Context Menu >>>
+
+// <o EMDRV_UARTDMA_IRQ_PRIORITY> UART RX interrupt priority <0-15>
+// <i> Priority of the interrupt used for RX idle line detection. It must not
+// <i> be higher (smaller number) than the DMA interrupt priority.
+// <i> Default: 8
+#define EMDRV_UARTDMA_IRQ_PRIORITY 8
+
+// <q EMDRV_UARTDMA_RX_IDLE_DETECTION> RX idle line detection
+// <i> When enabled, the USART/EUSART RX interrupt is used to detect idle
+// <i> lines, see rxIdleFrames.
+// <i> Default: 0
+#define EMDRV_UARTDMA_RX_IDLE_DETECTION 0
+
+// <q EMDRV_UARTDMA_IRQ_HANDLERS> USART/EUSART RX interrupt handlers
+// <i> When enabled together with RX idle line detection, the driver
+// <i> implements the RX interrupt handlers of all USART and EUSART instances.
+// <i> Disable it if the application or another driver needs these interrupt
+// <i> handlers, the application must then call UARTDMA_IRQHandler() from them.
+// <i> Default: 1
+#define EMDRV_UARTDMA_IRQ_HANDLERS 1
+
+// <<< end of configuration section >>>
+
+#endif // UARTDMA_CONFIG_H
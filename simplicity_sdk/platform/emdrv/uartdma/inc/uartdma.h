@@ -0,0 +1,192 @@
+/***************************************************************************//**
+ * @file
+ * @brief UARTDMA API definition.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+
+#ifndef __SILICON_LABS_UARTDMA_H__
+#define __SILICON_LABS_UARTDMA_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "em_device.h"
+
+#include "ecode.h"
+#include "dmadrv.h"
+#include "uartdma_config.h"
+#include "sl_code_classification.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***************************************************************************//**
+ * @addtogroup uartdma
+ * @{
+ ******************************************************************************/
+
+/***************************************************************************//**
+ * @addtogroup uartdma_error_codes Error Codes
+ * @{
+ ******************************************************************************/
+
+#define ECODE_EMDRV_UARTDMA_OK                (ECODE_OK)                                ///< A successful return value.
+#define ECODE_EMDRV_UARTDMA_PARAM_ERROR       (ECODE_EMDRV_UARTDMA_BASE | 0x00000001)   ///< An illegal input parameter.
+#define ECODE_EMDRV_UARTDMA_NOT_INITIALIZED   (ECODE_EMDRV_UARTDMA_BASE | 0x00000002)   ///< The handle is not initialized.
+#define ECODE_EMDRV_UARTDMA_BUSY              (ECODE_EMDRV_UARTDMA_BASE | 0x00000003)   ///< The peripheral is already used by another handle.
+#define ECODE_EMDRV_UARTDMA_BUFFER_FULL       (ECODE_EMDRV_UARTDMA_BASE | 0x00000004)   ///< Not enough room in the TX buffer.
+#define ECODE_EMDRV_UARTDMA_RX_OVERRUN        (ECODE_EMDRV_UARTDMA_BASE | 0x00000005)   ///< RX data was overwritten before it was read.
+#define ECODE_EMDRV_UARTDMA_DMA_ERROR         (ECODE_EMDRV_UARTDMA_BASE | 0x00000006)   ///< A DMADRV call failed.
+
+/** @} (end addtogroup error codes) */
+
+/// RX event reported to the RX callback.
+typedef enum {
+  uartdmaRxEventSegment = 0,  ///< An RX buffer segment has been filled.
+  uartdmaRxEventIdle    = 1,  ///< The RX line went idle after receiving data.
+} UARTDMA_RxEvent_t;
+
+/// UARTDMA handle data, must stay allocated while the handle is in use.
+typedef struct UARTDMA_HandleData UARTDMA_HandleData_t;
+
+/// UARTDMA handle.
+typedef UARTDMA_HandleData_t *UARTDMA_Handle_t;
+
+/***************************************************************************//**
+ * @brief
+ *  RX event callback.
+ *
+ * @details
+ *  Called from interrupt context. Use @ref UARTDMA_RxSpanGet() to get the
+ *  received data, here or later from thread context.
+ *
+ * @param[in] handle
+ *  The UARTDMA handle.
+ *
+ * @param[in] event
+ *  What happened on the RX side.
+ *
+ * @param[in] userParam
+ *  The user parameter given in @ref UARTDMA_Init_t.
+ ******************************************************************************/
+typedef void (*UARTDMA_RxCallback_t)(UARTDMA_Handle_t  handle,
+                                     UARTDMA_RxEvent_t event,
+                                     void              *userParam);
+
+/***************************************************************************//**
+ * @brief
+ *  TX callback, called from interrupt context when the TX buffer has been
+ *  emptied.
+ *
+ * @param[in] handle
+ *  The UARTDMA handle.
+ *
+ * @param[in] userParam
+ *  The user parameter given in @ref UARTDMA_Init_t.
+ ******************************************************************************/
+typedef void (*UARTDMA_TxCallback_t)(UARTDMA_Handle_t handle,
+                                     void             *userParam);
+
+/// UARTDMA initialization structure.
+typedef struct {
+#if defined(USART_PRESENT)
+  USART_TypeDef         *usart;         ///< USART to use, NULL when an EUSART is used.
+#endif
+#if defined(EUSART_PRESENT)
+  EUSART_TypeDef        *eusart;        ///< EUSART to use, NULL when a USART is used.
+#endif
+  uint8_t               *txBuffer;      ///< TX ring buffer.
+  uint32_t              txBufferSize;   ///< TX ring buffer size, a power of two.
+  uint8_t               *rxBuffer;      ///< RX ring buffer.
+  uint32_t              rxBufferSize;   ///< RX ring buffer size, a multiple of rxSegments.
+  unsigned int          rxSegments;     ///< Number of RX buffer segments, see DMADRV_PeripheralMemoryRing().
+  uint8_t               rxIdleFrames;   ///< RX idle time in frames before uartdmaRxEventIdle, 0 to disable. Requires EMDRV_UARTDMA_RX_IDLE_DETECTION.
+  UARTDMA_RxCallback_t  rxCallback;     ///< RX event callback, NULL if not used.
+  UARTDMA_TxCallback_t  txCallback;     ///< TX buffer empty callback, NULL if not used.
+  void                  *userParam;     ///< User parameter passed to the callbacks.
+} UARTDMA_Init_t;
+
+/// @cond DO_NOT_INCLUDE_WITH_DOXYGEN
+struct UARTDMA_HandleData {
+#if defined(USART_PRESENT)
+  USART_TypeDef         *usart;
+#endif
+#if defined(EUSART_PRESENT)
+  EUSART_TypeDef        *eusart;
+#endif
+  uint8_t               *txBuffer;
+  uint32_t              txMask;
+  volatile uint32_t     txHead;         // Free running write index
+  volatile uint32_t     txTail;         // Free running read index
+  volatile uint32_t     txDmaLen;       // Bytes handed to the DMA, 0 when idle
+  uint8_t               *rxBuffer;
+  uint32_t              rxBufferSize;
+  unsigned int          txDmaCh;
+  unsigned int          rxDmaCh;
+  unsigned int          portIndex;      // Index in the port table
+  UARTDMA_RxCallback_t  rxCallback;
+  UARTDMA_TxCallback_t  txCallback;
+  void                  *userParam;
+  bool                  initialized;
+};
+/// @endcond
+
+Ecode_t UARTDMA_Init(UARTDMA_Handle_t handle, const UARTDMA_Init_t *init);
+Ecode_t UARTDMA_DeInit(UARTDMA_Handle_t handle);
+
+Ecode_t UARTDMA_Transmit(UARTDMA_Handle_t handle,
+                         const uint8_t    *data,
+                         uint32_t         count);
+Ecode_t UARTDMA_TxSpanGet(UARTDMA_Handle_t handle,
+                          uint8_t          **span,
+                          uint32_t         *count);
+Ecode_t UARTDMA_TxSpanCommit(UARTDMA_Handle_t handle,
+                             uint32_t         count);
+uint32_t UARTDMA_TxPending(UARTDMA_Handle_t handle);
+
+Ecode_t UARTDMA_Receive(UARTDMA_Handle_t handle,
+                        uint8_t          *data,
+                        uint32_t         maxCount,
+                        uint32_t         *count);
+SL_CODE_CLASSIFY(SL_CODE_COMPONENT_UARTDMA, SL_CODE_CLASS_TIME_CRITICAL)
+Ecode_t UARTDMA_RxSpanGet(UARTDMA_Handle_t handle,
+                          const uint8_t    **span,
+                          uint32_t         *count);
+SL_CODE_CLASSIFY(SL_CODE_COMPONENT_UARTDMA, SL_CODE_CLASS_TIME_CRITICAL)
+Ecode_t UARTDMA_RxSpanRelease(UARTDMA_Handle_t handle,
+                              uint32_t         count);
+
+void UARTDMA_IRQHandler(UARTDMA_Handle_t handle);
+
+/** @} (end addtogroup uartdma) */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __SILICON_LABS_UARTDMA_H__
@@ -0,0 +1,1059 @@
+/***************************************************************************//**
+ * @file
+ * @brief UARTDMA API implementation.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "em_device.h"
+#if defined(USART_PRESENT)
+#include "em_usart.h"
+#endif
+#if defined(EUSART_PRESENT)
+#include "em_eusart.h"
+#endif
+#include "sl_core.h"
+#include "sl_common.h"
+
+#include "uartdma.h"
+
+/// @cond DO_NOT_INCLUDE_WITH_DOXYGEN
+
+#if !defined(EMDRV_UARTDMA_IRQ_PRIORITY)
+#define EMDRV_UARTDMA_IRQ_PRIORITY 8
+#endif
+
+#if !defined(EMDRV_UARTDMA_RX_IDLE_DETECTION)
+#define EMDRV_UARTDMA_RX_IDLE_DETECTION 0
+#endif
+
+#if !defined(EMDRV_UARTDMA_IRQ_HANDLERS)
+#define EMDRV_UARTDMA_IRQ_HANDLERS 1
+#endif
+
+// Bit times per frame assumed when converting the idle time for a USART
+#define USART_BITS_PER_FRAME  10U
+
+// Hardware resources of a USART or EUSART instance
+typedef struct {
+  const void                *port;
+  bool                      eusart;
+  DMADRV_PeripheralSignal_t txSignal;
+  DMADRV_PeripheralSignal_t rxSignal;
+  IRQn_Type                 rxIrq;
+} PortInfo_t;
+
+static const PortInfo_t portTable[] = {
+#if defined(USART0)
+  { USART0, false, dmadrvPeripheralSignal_USART0_TXBL, dmadrvPeripheralSignal_USART0_RXDATAV, USART0_RX_IRQn },
+#endif
+#if defined(USART1)
+  { USART1, false, dmadrvPeripheralSignal_USART1_TXBL, dmadrvPeripheralSignal_USART1_RXDATAV, USART1_RX_IRQn },
+#endif
+#if defined(USART2)
+  { USART2, false, dmadrvPeripheralSignal_USART2_TXBL, dmadrvPeripheralSignal_USART2_RXDATAV, USART2_RX_IRQn },
+#endif
+#if defined(EUSART0)
+  { EUSART0, true, dmadrvPeripheralSignal_EUSART0_TXBL, dmadrvPeripheralSignal_EUSART0_RXDATAV, EUSART0_RX_IRQn },
+#endif
+#if defined(EUSART1)
+  { EUSART1, true, dmadrvPeripheralSignal_EUSART1_TXBL, dmadrvPeripheralSignal_EUSART1_RXDATAV, EUSART1_RX_IRQn },
+#endif
+#if defined(EUSART2)
+  { EUSART2, true, dmadrvPeripheralSignal_EUSART2_TXBL, dmadrvPeripheralSignal_EUSART2_RXDATAV, EUSART2_RX_IRQn },
+#endif
+};
+
+#define PORT_COUNT  (sizeof(portTable) / sizeof(portTable[0]))
+
+static UARTDMA_Handle_t handleTable[PORT_COUNT];
+
+static Ecode_t StartTx(UARTDMA_Handle_t handle);
+static bool TxDmaComplete(unsigned int channel,
+                          unsigned int sequenceNo,
+                          void *userParam);
+static bool RxDmaSegmentComplete(unsigned int channel,
+                                 unsigned int sequenceNo,
+                                 void *userParam);
+static void *TxDataRegister(UARTDMA_Handle_t handle);
+static void *RxDataRegister(UARTDMA_Handle_t handle);
+static void EnableIdleDetection(UARTDMA_Handle_t handle, uint8_t frames);
+static void EnableIdleInterrupt(UARTDMA_Handle_t handle);
+static void DisableIdleDetection(UARTDMA_Handle_t handle);
+
+/// @endcond
+
+/***************************************************************************//**
+ * @brief
+ *  Initialize a UARTDMA handle.
+ *
+ * @details
+ *  The USART or EUSART must be clocked, routed to its pins and initialized in
+ *  asynchronous mode, e.g. with USART_InitAsync() or EUSART_UartInitHf(),
+ *  before calling this function. Reception into the RX ring buffer starts
+ *  immediately.
+ *
+ *  An EUSART RX timeout can only be set while the EUSART is disabled. When
+ *  rxIdleFrames is used with an enabled EUSART, it is briefly disabled and
+ *  then restored to its previous RX/TX state, which drops a frame arriving
+ *  in between. Initialize the EUSART with eusartDisable as the enable
+ *  setting to avoid this, and enable it after this function returns.
+ *
+ * @param[in] handle
+ *  A pointer to the handle data, which must stay allocated until
+ *  @ref UARTDMA_DeInit() is called.
+ *
+ * @param[in] init
+ *  A pointer to the initialization structure.
+ *
+ * @return
+ *  @ref ECODE_EMDRV_UARTDMA_OK on success. On failure, an appropriate
+ *  UARTDMA @ref Ecode_t is returned.
+ ******************************************************************************/
+Ecode_t UARTDMA_Init(UARTDMA_Handle_t handle, const UARTDMA_Init_t *init)
+{
+  const void *port = NULL;
+  unsigned int portIndex;
+  Ecode_t ecode;
+  CORE_DECLARE_IRQ_STATE;
+
+  if ((handle == NULL) || (init == NULL)) {
+    return ECODE_EMDRV_UARTDMA_PARAM_ERROR;
+  }
+#if defined(USART_PRESENT)
+  if (init->usart != NULL) {
+    port = init->usart;
+  }
+#endif
+#if defined(EUSART_PRESENT)
+  if (init->eusart != NULL) {
+    if (port != NULL) {
+      return ECODE_EMDRV_UARTDMA_PARAM_ERROR;
+    }
+    port = init->eusart;
+  }
+#endif
+  for (portIndex = 0; portIndex < PORT_COUNT; portIndex++) {
+    if (portTable[portIndex].port == port) {
+      break;
+    }
+  }
+  if ((port == NULL)
+      || (portIndex == PORT_COUNT)
+      || (init->txBuffer == NULL)
+      || (init->txBufferSize == 0U)
+      || ((init->txBufferSize & (init->txBufferSize - 1U)) != 0U)
+      || (init->rxBuffer == NULL)
+      || (init->rxSegments == 0U)
+      || ((init->rxBufferSize % init->rxSegments) != 0U)) {
+    return ECODE_EMDRV_UARTDMA_PARAM_ERROR;
+  }
+#if (EMDRV_UARTDMA_RX_IDLE_DETECTION == 0)
+  if (init->rxIdleFrames != 0U) {
+    return ECODE_EMDRV_UARTDMA_PARAM_ERROR;
+  }
+#endif
+
+  CORE_ENTER_ATOMIC();
+  if (handleTable[portIndex] != NULL) {
+    CORE_EXIT_ATOMIC();
+    return ECODE_EMDRV_UARTDMA_BUSY;
+  }
+  handleTable[portIndex] = handle;
+  CORE_EXIT_ATOMIC();
+
+  memset(handle, 0, sizeof(*handle));
+#if defined(USART_PRESENT)
+  handle->usart = init->usart;
+#endif
+#if defined(EUSART_PRESENT)
+  handle->eusart = init->eusart;
+#endif
+  handle->portIndex    = portIndex;
+  handle->txBuffer     = init->txBuffer;
+  handle->txMask       = init->txBufferSize - 1U;
+  handle->rxBuffer     = init->rxBuffer;
+  handle->rxBufferSize = init->rxBufferSize;
+  handle->rxCallback   = init->rxCallback;
+  handle->txCallback   = init->txCallback;
+  handle->userParam    = init->userParam;
+
+  ecode = DMADRV_Init();
+  if ((ecode != ECODE_EMDRV_DMADRV_OK)
+      && (ecode != ECODE_EMDRV_DMADRV_ALREADY_INITIALIZED)) {
+    handleTable[portIndex] = NULL;
+    return ECODE_EMDRV_UARTDMA_DMA_ERROR;
+  }
+  if (DMADRV_AllocateChannel(&handle->txDmaCh, NULL) != ECODE_EMDRV_DMADRV_OK) {
+    handleTable[portIndex] = NULL;
+    return ECODE_EMDRV_UARTDMA_DMA_ERROR;
+  }
+  if (DMADRV_AllocateChannel(&handle->rxDmaCh, NULL) != ECODE_EMDRV_DMADRV_OK) {
+    DMADRV_FreeChannel(handle->txDmaCh);
+    handleTable[portIndex] = NULL;
+    return ECODE_EMDRV_UARTDMA_DMA_ERROR;
+  }
+
+  // Set up the RX timeout before the RX ring starts, so the EUSART isn't
+  // reconfigured while the DMA is reading it
+  if (init->rxIdleFrames != 0U) {
+    EnableIdleDetection(handle, init->rxIdleFrames);
+  }
+
+  ecode = DMADRV_PeripheralMemoryRing(handle->rxDmaCh,
+                                      portTable[portIndex].rxSignal,
+                                      handle->rxBuffer,
+                                      RxDataRegister(handle),
+                                      (int)handle->rxBufferSize,
+                                      init->rxSegments,
+                                      dmadrvDataSize1,
+                                      RxDmaSegmentComplete,
+                                      handle);
+  if (ecode != ECODE_EMDRV_DMADRV_OK) {
+    DisableIdleDetection(handle);
+    DMADRV_FreeChannel(handle->rxDmaCh);
+    DMADRV_FreeChannel(handle->txDmaCh);
+    handleTable[portIndex] = NULL;
+    return (ecode == ECODE_EMDRV_DMADRV_PARAM_ERROR)
+           ? ECODE_EMDRV_UARTDMA_PARAM_ERROR
+           : ECODE_EMDRV_UARTDMA_DMA_ERROR;
+  }
+
+  handle->initialized = true;
+
+  if (init->rxIdleFrames != 0U) {
+    EnableIdleInterrupt(handle);
+  }
+
+  return ECODE_EMDRV_UARTDMA_OK;
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Deinitialize a UARTDMA handle.
+ *
+ * @details
+ *  Ongoing transmissions are aborted and the DMA channels are released. The
+ *  USART or EUSART itself is left enabled.
+ *
+ * @param[in] handle
+ *  The UARTDMA handle.
+ *
+ * @return
+ *  @ref ECODE_EMDRV_UARTDMA_OK on success. On failure, an appropriate
+ *  UARTDMA @ref Ecode_t is returned.
+ ******************************************************************************/
+Ecode_t UARTDMA_DeInit(UARTDMA_Handle_t handle)
+{
+  if ((handle == NULL) || !handle->initialized) {
+    return ECODE_EMDRV_UARTDMA_NOT_INITIALIZED;
+  }
+
+  DisableIdleDetection(handle);
+  DMADRV_StopTransfer(handle->rxDmaCh);
+  DMADRV_StopTransfer(handle->txDmaCh);
+  DMADRV_FreeChannel(handle->rxDmaCh);
+  DMADRV_FreeChannel(handle->txDmaCh);
+
+  handle->initialized = false;
+  handleTable[handle->portIndex] = NULL;
+
+  return ECODE_EMDRV_UARTDMA_OK;
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Queue data for transmission.
+ *
+ * @details
+ *  The data is copied to the TX ring buffer, so the caller's buffer can be
+ *  reused when the function returns. Either all or none of the data is
+ *  queued.
+ *
+ * @param[in] handle
+ *  The UARTDMA handle.
+ *
+ * @param[in] data
+ *  The data to send.
+ *
+ * @param[in] count
+ *  A number of bytes to send.
+ *
+ * @return
+ *  @ref ECODE_EMDRV_UARTDMA_OK on success,
+ *  @ref ECODE_EMDRV_UARTDMA_BUFFER_FULL if the TX buffer doesn't have room
+ *  for @p count bytes. On other failures, an appropriate UARTDMA
+ *  @ref Ecode_t is returned.
+ ******************************************************************************/
+Ecode_t UARTDMA_Transmit(UARTDMA_Handle_t handle,
+                         const uint8_t    *data,
+                         uint32_t         count)
+{
+  uint32_t head;
+  uint32_t chunk;
+
+  if ((handle == NULL) || !handle->initialized) {
+    return ECODE_EMDRV_UARTDMA_NOT_INITIALIZED;
+  }
+  if ((data == NULL) && (count != 0U)) {
+    return ECODE_EMDRV_UARTDMA_PARAM_ERROR;
+  }
+  if (count > (handle->txMask + 1U) - (handle->txHead - handle->txTail)) {
+    return ECODE_EMDRV_UARTDMA_BUFFER_FULL;
+  }
+
+  // Copy in at most two parts, before and after the buffer wrap
+  head  = handle->txHead & handle->txMask;
+  chunk = (handle->txMask + 1U) - head;
+  if (chunk > count) {
+    chunk = count;
+  }
+  memcpy(&handle->txBuffer[head], data, chunk);
+  memcpy(handle->txBuffer, &data[chunk], count - chunk);
+
+  return UARTDMA_TxSpanCommit(handle, count);
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Get the free space of the TX ring buffer for zero-copy transmission.
+ *
+ * @details
+ *  The span is the contiguous free space starting at the write position. Fill
+ *  it and call @ref UARTDMA_TxSpanCommit() to send the data. When the free
+ *  space wraps around the end of the buffer, a second span is available once
+ *  the first one is committed.
+ *
+ * @param[in] handle
+ *  The UARTDMA handle.
+ *
+ * @param[out] span
+ *  The start of the free space.
+ *
+ * @param[out] count
+ *  A number of bytes which can be written at @p span, 0 if the buffer is full.
+ *
+ * @return
+ *  @ref ECODE_EMDRV_UARTDMA_OK on success. On failure, an appropriate
+ *  UARTDMA @ref Ecode_t is returned.
+ ******************************************************************************/
+Ecode_t UARTDMA_TxSpanGet(UARTDMA_Handle_t handle,
+                          uint8_t          **span,
+                          uint32_t         *count)
+{
+  uint32_t head;
+  uint32_t space;
+
+  if ((handle == NULL) || !handle->initialized) {
+    return ECODE_EMDRV_UARTDMA_NOT_INITIALIZED;
+  }
+  if ((span == NULL) || (count == NULL)) {
+    return ECODE_EMDRV_UARTDMA_PARAM_ERROR;
+  }
+
+  head  = handle->txHead & handle->txMask;
+  space = (handle->txMask + 1U) - (handle->txHead - handle->txTail);
+  if (space > (handle->txMask + 1U) - head) {
+    space = (handle->txMask + 1U) - head;
+  }
+
+  *span  = &handle->txBuffer[head];
+  *count = space;
+
+  return ECODE_EMDRV_UARTDMA_OK;
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Send data written to a span returned by @ref UARTDMA_TxSpanGet().
+ *
+ * @param[in] handle
+ *  The UARTDMA handle.
+ *
+ * @param[in] count
+ *  A number of bytes written to the span.
+ *
+ * @return
+ *  @ref ECODE_EMDRV_UARTDMA_OK on success. On failure, an appropriate
+ *  UARTDMA @ref Ecode_t is returned.
+ ******************************************************************************/
+Ecode_t UARTDMA_TxSpanCommit(UARTDMA_Handle_t handle,
+                             uint32_t         count)
+{
+  if ((handle == NULL) || !handle->initialized) {
+    return ECODE_EMDRV_UARTDMA_NOT_INITIALIZED;
+  }
+  if (count > (handle->txMask + 1U) - (handle->txHead - handle->txTail)) {
+    return ECODE_EMDRV_UARTDMA_PARAM_ERROR;
+  }
+
+  handle->txHead += count;
+
+  return StartTx(handle);
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Get the number of bytes queued for transmission.
+ *
+ * @details
+ *  Bytes are removed from the count once the DMA has moved them to the
+ *  peripheral, the last ones may still be in the TX FIFO or shift register.
+ *
+ * @param[in] handle
+ *  The UARTDMA handle.
+ *
+ * @return
+ *  A number of bytes in the TX ring buffer.
+ ******************************************************************************/
+uint32_t UARTDMA_TxPending(UARTDMA_Handle_t handle)
+{
+  if ((handle == NULL) || !handle->initialized) {
+    return 0U;
+  }
+
+  return handle->txHead - handle->txTail;
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Copy received data out of the RX ring buffer.
+ *
+ * @param[in] handle
+ *  The UARTDMA handle.
+ *
+ * @param[out] data
+ *  A buffer receiving the data.
+ *
+ * @param[in] maxCount
+ *  The size of @p data.
+ *
+ * @param[out] count
+ *  A number of bytes copied.
+ *
+ * @return
+ *  @ref ECODE_EMDRV_UARTDMA_OK on success,
+ *  @ref ECODE_EMDRV_UARTDMA_RX_OVERRUN if received data was lost because the
+ *  RX buffer was not read in time. The data received after the overrun can
+ *  be read with the next call. On other failures, an appropriate UARTDMA
+ *  @ref Ecode_t is returned.
+ ******************************************************************************/
+Ecode_t UARTDMA_Receive(UARTDMA_Handle_t handle,
+                        uint8_t          *data,
+                        uint32_t         maxCount,
+                        uint32_t         *count)
+{
+  const uint8_t *span;
+  uint32_t spanCount;
+  uint32_t copied = 0;
+  Ecode_t ecode = ECODE_EMDRV_UARTDMA_OK;
+
+  if ((data == NULL) || (count == NULL)) {
+    return ECODE_EMDRV_UARTDMA_PARAM_ERROR;
+  }
+
+  // The unread data is in at most two spans, before and after the buffer wrap
+  while (copied < maxCount) {
+    ecode = UARTDMA_RxSpanGet(handle, &span, &spanCount);
+    if ((ecode != ECODE_EMDRV_UARTDMA_OK) || (spanCount == 0U)) {
+      break;
+    }
+    if (spanCount > maxCount - copied) {
+      spanCount = maxCount - copied;
+    }
+    memcpy(&data[copied], span, spanCount);
+    UARTDMA_RxSpanRelease(handle, spanCount);
+    copied += spanCount;
+  }
+
+  *count = copied;
+
+  return ecode;
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Get received data in place, for zero-copy reception.
+ *
+ * @details
+ *  The span is the contiguous unread data starting at the read position. Call
+ *  @ref UARTDMA_RxSpanRelease() once the data has been processed. When the
+ *  unread data wraps around the end of the buffer, a second span is available
+ *  once the first one is released.
+ *
+ *  The span is overwritten if the data is not released before the DMA has
+ *  gone around the whole RX buffer.
+ *
+ * @param[in] handle
+ *  The UARTDMA handle.
+ *
+ * @param[out] span
+ *  The start of the unread data.
+ *
+ * @param[out] count
+ *  A number of bytes available at @p span.
+ *
+ * @return
+ *  @ref ECODE_EMDRV_UARTDMA_OK on success,
+ *  @ref ECODE_EMDRV_UARTDMA_RX_OVERRUN if received data was lost. @p count is
+ *  0 then and reading resumes with the data received after the overrun. On
+ *  other failures, an appropriate UARTDMA @ref Ecode_t is returned.
+ ******************************************************************************/
+Ecode_t UARTDMA_RxSpanGet(UARTDMA_Handle_t handle,
+                          const uint8_t    **span,
+                          uint32_t         *count)
+{
+  int readIndex;
+  int available;
+  Ecode_t ecode;
+
+  if ((handle == NULL) || !handle->initialized) {
+    return ECODE_EMDRV_UARTDMA_NOT_INITIALIZED;
+  }
+  if ((span == NULL) || (count == NULL)) {
+    return ECODE_EMDRV_UARTDMA_PARAM_ERROR;
+  }
+
+  ecode = DMADRV_RingAvailable(handle->rxDmaCh, &readIndex, &available);
+  if (ecode == ECODE_EMDRV_DMADRV_RING_OVERRUN) {
+    *span  = &handle->rxBuffer[readIndex];
+    *count = 0U;
+    return ECODE_EMDRV_UARTDMA_RX_OVERRUN;
+  }
+  if (ecode != ECODE_EMDRV_DMADRV_OK) {
+    return ECODE_EMDRV_UARTDMA_DMA_ERROR;
+  }
+
+  if ((uint32_t)available > handle->rxBufferSize - (uint32_t)readIndex) {
+    available = (int)(handle->rxBufferSize - (uint32_t)readIndex);
+  }
+
+  *span  = &handle->rxBuffer[readIndex];
+  *count = (uint32_t)available;
+
+  return ECODE_EMDRV_UARTDMA_OK;
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Release data returned by @ref UARTDMA_RxSpanGet().
+ *
+ * @param[in] handle
+ *  The UARTDMA handle.
+ *
+ * @param[in] count
+ *  A number of bytes processed, at most the span size.
+ *
+ * @return
+ *  @ref ECODE_EMDRV_UARTDMA_OK on success. On failure, an appropriate
+ *  UARTDMA @ref Ecode_t is returned.
+ ******************************************************************************/
+Ecode_t UARTDMA_RxSpanRelease(UARTDMA_Handle_t handle,
+                              uint32_t         count)
+{
+  Ecode_t ecode;
+
+  if ((handle == NULL) || !handle->initialized) {
+    return ECODE_EMDRV_UARTDMA_NOT_INITIALIZED;
+  }
+
+  ecode = DMADRV_RingConsume(handle->rxDmaCh, (int)count);
+  if (ecode == ECODE_EMDRV_DMADRV_PARAM_ERROR) {
+    return ECODE_EMDRV_UARTDMA_PARAM_ERROR;
+  }
+
+  return (ecode == ECODE_EMDRV_DMADRV_OK) ? ECODE_EMDRV_UARTDMA_OK
+         : ECODE_EMDRV_UARTDMA_DMA_ERROR;
+}
+
+/// @cond DO_NOT_INCLUDE_WITH_DOXYGEN
+
+/***************************************************************************//**
+ * @brief
+ *  Start a TX DMA transfer of the next contiguous span of queued data, unless
+ *  one is already ongoing.
+ ******************************************************************************/
+static Ecode_t StartTx(UARTDMA_Handle_t handle)
+{
+  uint32_t tail;
+  uint32_t len;
+  Ecode_t ecode = ECODE_EMDRV_UARTDMA_OK;
+  CORE_DECLARE_IRQ_STATE;
+
+  CORE_ENTER_ATOMIC();
+  if ((handle->txDmaLen == 0U) && (handle->txHead != handle->txTail)) {
+    tail = handle->txTail & handle->txMask;
+    len  = handle->txHead - handle->txTail;
+    if (len > (handle->txMask + 1U) - tail) {
+      len = (handle->txMask + 1U) - tail;
+    }
+    if (len > (uint32_t)DMADRV_MAX_XFER_COUNT) {
+      len = (uint32_t)DMADRV_MAX_XFER_COUNT;
+    }
+
+    handle->txDmaLen = len;
+    if (DMADRV_MemoryPeripheral(handle->txDmaCh,
+                                portTable[handle->portIndex].txSignal,
+                                TxDataRegister(handle),
+                                &handle->txBuffer[tail],
+                                true,
+                                (int)len,
+                                dmadrvDataSize1,
+                                TxDmaComplete,
+                                handle) != ECODE_EMDRV_DMADRV_OK) {
+      handle->txDmaLen = 0U;
+      ecode = ECODE_EMDRV_UARTDMA_DMA_ERROR;
+    }
+  }
+  CORE_EXIT_ATOMIC();
+
+  return ecode;
+}
+
+/***************************************************************************//**
+ * @brief
+ *  TX DMA completion callback. Releases the sent span and starts the next one.
+ ******************************************************************************/
+static bool TxDmaComplete(unsigned int channel,
+                          unsigned int sequenceNo,
+                          void *userParam)
+{
+  UARTDMA_Handle_t handle = (UARTDMA_Handle_t)userParam;
+
+  (void)channel;
+  (void)sequenceNo;
+
+  handle->txTail  += handle->txDmaLen;
+  handle->txDmaLen = 0U;
+  StartTx(handle);
+
+  if ((handle->txDmaLen == 0U) && (handle->txCallback != NULL)) {
+    handle->txCallback(handle, handle->userParam);
+  }
+
+  return true;
+}
+
+/***************************************************************************//**
+ * @brief
+ *  RX DMA ring segment completion callback.
+ ******************************************************************************/
+static bool RxDmaSegmentComplete(unsigned int channel,
+                                 unsigned int sequenceNo,
+                                 void *userParam)
+{
+  UARTDMA_Handle_t handle = (UARTDMA_Handle_t)userParam;
+
+  (void)channel;
+  (void)sequenceNo;
+
+  if (handle->rxCallback != NULL) {
+    handle->rxCallback(handle, uartdmaRxEventSegment, handle->userParam);
+  }
+
+  return true;
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Get the TX data register of the peripheral.
+ ******************************************************************************/
+static void *TxDataRegister(UARTDMA_Handle_t handle)
+{
+#if defined(EUSART_PRESENT)
+  if (portTable[handle->portIndex].eusart) {
+    return (void *)&handle->eusart->TXDATA;
+  }
+#endif
+#if defined(USART_PRESENT)
+  return (void *)&handle->usart->TXDATA;
+#else
+  return NULL;
+#endif
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Get the RX data register of the peripheral.
+ ******************************************************************************/
+static void *RxDataRegister(UARTDMA_Handle_t handle)
+{
+#if defined(EUSART_PRESENT)
+  if (portTable[handle->portIndex].eusart) {
+    return (void *)&handle->eusart->RXDATA;
+  }
+#endif
+#if defined(USART_PRESENT)
+  return (void *)&handle->usart->RXDATA;
+#else
+  return NULL;
+#endif
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Set up RX idle line detection.
+ *
+ * @details
+ *  An EUSART uses its RX timeout, counted in frames from the last received
+ *  frame, up to 7 frames. It must be set up before the RX ring is started.
+ *  A USART uses timer comparator 1, started at the end of each received frame
+ *  and stopped when the RX line becomes active again. Its timeout is counted
+ *  in bit times, assuming 10 bit frames, up to 255 bit times. The interrupt
+ *  is enabled separately, once the handle is initialized.
+ ******************************************************************************/
+static void EnableIdleDetection(UARTDMA_Handle_t handle, uint8_t frames)
+{
+#if (EMDRV_UARTDMA_RX_IDLE_DETECTION == 1)
+#if defined(EUSART_PRESENT)
+  if (portTable[handle->portIndex].eusart) {
+    EUSART_TypeDef *eusart = handle->eusart;
+    uint32_t timeout = SL_MIN((uint32_t)frames,
+                              _EUSART_CFG1_RXTIMEOUT_MASK >> _EUSART_CFG1_RXTIMEOUT_SHIFT);
+    bool enabled = (eusart->EN & _EUSART_EN_EN_MASK) != 0U;
+    uint32_t status = eusart->STATUS;
+
+    // CFG1 can only be written while the EUSART is disabled
+    if (enabled) {
+      EUSART_Enable(eusart, eusartDisable);
+    }
+    eusart->CFG1 = (eusart->CFG1 & ~_EUSART_CFG1_RXTIMEOUT_MASK)
+                   | (timeout << _EUSART_CFG1_RXTIMEOUT_SHIFT);
+    if (enabled) {
+      EUSART_Enable(eusart, (EUSART_Enable_TypeDef)
+                    (((status & EUSART_STATUS_RXENS) ? EUSART_CMD_RXEN : EUSART_CMD_RXDIS)
+                     | ((status & EUSART_STATUS_TXENS) ? EUSART_CMD_TXEN : EUSART_CMD_TXDIS)));
+    }
+    EUSART_IntClear(eusart, EUSART_IF_RXTO);
+  } else
+#endif
+  {
+#if defined(USART_PRESENT)
+    USART_TypeDef *usart = handle->usart;
+    uint32_t bitTimes = SL_MIN((uint32_t)frames * USART_BITS_PER_FRAME,
+                               _USART_TIMECMP1_TCMPVAL_MASK >> _USART_TIMECMP1_TCMPVAL_SHIFT);
+
+    usart->TIMECMP1 = (bitTimes << _USART_TIMECMP1_TCMPVAL_SHIFT)
+                      | USART_TIMECMP1_TSTART_RXEOF
+                      | USART_TIMECMP1_TSTOP_RXACT;
+    USART_IntClear(usart, USART_IF_TCMP1);
+#endif
+  }
+#else
+  (void)handle;
+  (void)frames;
+#endif
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Enable the RX idle line interrupt.
+ ******************************************************************************/
+static void EnableIdleInterrupt(UARTDMA_Handle_t handle)
+{
+#if (EMDRV_UARTDMA_RX_IDLE_DETECTION == 1)
+  IRQn_Type irq = portTable[handle->portIndex].rxIrq;
+
+#if defined(EUSART_PRESENT)
+  if (portTable[handle->portIndex].eusart) {
+    EUSART_IntEnable(handle->eusart, EUSART_IEN_RXTO);
+  } else
+#endif
+  {
+#if defined(USART_PRESENT)
+    USART_IntEnable(handle->usart, USART_IEN_TCMP1);
+#endif
+  }
+
+  NVIC_ClearPendingIRQ(irq);
+  NVIC_SetPriority(irq, EMDRV_UARTDMA_IRQ_PRIORITY);
+  NVIC_EnableIRQ(irq);
+#else
+  (void)handle;
+#endif
+}
+
+/***************************************************************************//**
+ * @brief
+ *  Disable the RX idle line interrupt.
+ ******************************************************************************/
+static void DisableIdleDetection(UARTDMA_Handle_t handle)
+{
+#if (EMDRV_UARTDMA_RX_IDLE_DETECTION == 1)
+  NVIC_DisableIRQ(portTable[handle->portIndex].rxIrq);
+#if defined(EUSART_PRESENT)
+  if (portTable[handle->portIndex].eusart) {
+    EUSART_IntDisable(handle->eusart, EUSART_IEN_RXTO);
+  } else
+#endif
+  {
+#if defined(USART_PRESENT)
+    USART_IntDisable(handle->usart, USART_IEN_TCMP1);
+    handle->usart->TIMECMP1 = 0U;
+#endif
+  }
+#else
+  (void)handle;
+#endif
+}
+
+/// @endcond
+
+/***************************************************************************//**
+ * @brief
+ *  USART/EUSART RX interrupt handler, reports an idle line to the RX callback.
+ *
+ * @details
+ *  Called by the driver's own interrupt handlers, or by the application when
+ *  EMDRV_UARTDMA_IRQ_HANDLERS is 0. Does nothing unless the handle is
+ *  initialized with rxIdleFrames and EMDRV_UARTDMA_RX_IDLE_DETECTION is 1.
+ *
+ * @param[in] handle
+ *  The UARTDMA handle of the USART or EUSART.
+ ******************************************************************************/
+void UARTDMA_IRQHandler(UARTDMA_Handle_t handle)
+{
+#if (EMDRV_UARTDMA_RX_IDLE_DETECTION == 1)
+  if ((handle == NULL) || !handle->initialized) {
+    return;
+  }
+
+#if defined(EUSART_PRESENT)
+  if (portTable[handle->portIndex].eusart) {
+    EUSART_IntClear(handle->eusart, EUSART_IF_RXTO);
+  } else
+#endif
+  {
+#if defined(USART_PRESENT)
+    USART_IntClear(handle->usart, USART_IF_TCMP1);
+#endif
+  }
+
+  if (handle->rxCallback != NULL) {
+    handle->rxCallback(handle, uartdmaRxEventIdle, handle->userParam);
+  }
+#else
+  (void)handle;
+#endif
+}
+
+/// @cond DO_NOT_INCLUDE_WITH_DOXYGEN
+
+#if (EMDRV_UARTDMA_RX_IDLE_DETECTION == 1) && (EMDRV_UARTDMA_IRQ_HANDLERS == 1)
+// Position of each instance in portTable
+enum {
+#if defined(USART0)
+  PORT_INDEX_USART0,
+#endif
+#if defined(USART1)
+  PORT_INDEX_USART1,
+#endif
+#if defined(USART2)
+  PORT_INDEX_USART2,
+#endif
+#if defined(EUSART0)
+  PORT_INDEX_EUSART0,
+#endif
+#if defined(EUSART1)
+  PORT_INDEX_EUSART1,
+#endif
+#if defined(EUSART2)
+  PORT_INDEX_EUSART2,
+#endif
+};
+
+#if defined(USART0)
+void USART0_RX_IRQHandler(void)
+{
+  UARTDMA_IRQHandler(handleTable[PORT_INDEX_USART0]);
+}
+#endif
+
+#if defined(USART1)
+void USART1_RX_IRQHandler(void)
+{
+  UARTDMA_IRQHandler(handleTable[PORT_INDEX_USART1]);
+}
+#endif
+
+#if defined(USART2)
+void USART2_RX_IRQHandler(void)
+{
+  UARTDMA_IRQHandler(handleTable[PORT_INDEX_USART2]);
+}
+#endif
+
+#if defined(EUSART0)
+void EUSART0_RX_IRQHandler(void)
+{
+  UARTDMA_IRQHandler(handleTable[PORT_INDEX_EUSART0]);
+}
+#endif
+
+#if defined(EUSART1)
+void EUSART1_RX_IRQHandler(void)
+{
+  UARTDMA_IRQHandler(handleTable[PORT_INDEX_EUSART1]);
+}
+#endif
+
+#if defined(EUSART2)
+void EUSART2_RX_IRQHandler(void)
+{
+  UARTDMA_IRQHandler(handleTable[PORT_INDEX_EUSART2]);
+}
+#endif
+#endif // EMDRV_UARTDMA_IRQ_HANDLERS
+
+/// @endcond
+
+// ******** THE REST OF THE FILE IS DOCUMENTATION ONLY !***********************
+/// @addtogroup uartdma UARTDMA - DMA UART Driver
+/// @brief Asynchronous DMA based UART driver
+/// @{
+///
+///   @details
+///
+///   @n @section uartdma_intro Introduction
+///
+///   The UARTDMA driver moves UART data between ring buffers in RAM and a
+///   USART or EUSART with the LDMA, so the CPU is only involved once per
+///   block of data instead of once per byte as with USART_Tx()/USART_Rx() or
+///   EUSART_Tx()/EUSART_Rx().
+///
+///   The peripheral is set up with the emlib API, the driver only takes over
+///   data transfers. The uartdma.c and uartdma.h source files are in the
+///   emdrv/uartdma folder. UARTDMA is not related to the UARTDRV driver and
+///   has its own API.
+///
+///   @li TX data is queued in a ring buffer. Each contiguous span of queued
+///       data is sent with one DMA transfer.
+///   @li RX data is received endlessly in a ring buffer with
+///       DMADRV_PeripheralMemoryRing(). The RX callback is called each time a
+///       segment of the buffer is filled, and when the line goes idle after
+///       a frame, which ends variable length messages without waiting for a
+///       segment to fill up.
+///   @li Both directions can be accessed in place through spans, avoiding
+///       a copy between the ring buffers and the application buffers.
+///
+///   @note The callbacks are called from the DMA and the USART/EUSART RX
+///   interrupt handlers.
+///
+///   @n @section uartdma_perf CPU Load
+///
+///   The polled API keeps the CPU busy for the whole time a byte is on the
+///   line, about 87 us per byte at 115200 baud. With UARTDMA the CPU handles
+///   one DMA interrupt per TX span and per RX segment, plus one interrupt per
+///   idle line, and is otherwise free or sleeping in EM1. The throughput is
+///   the line rate in both cases, as long as the RX buffer is read before the
+///   DMA has gone around it once.
+///
+///   @n @section uartdma_conf Configuration Options
+///
+///   The configuration options are in uartdma_config.h:
+///   @li The priority of the RX interrupt used for idle line detection.
+///   @li Whether RX idle line detection is supported. It is disabled by
+///       default, rxIdleFrames must then be 0.
+///   @li Whether the driver implements the USART/EUSART RX interrupt handlers
+///       used for idle line detection. When disabled, the application calls
+///       @ref UARTDMA_IRQHandler() from its own handlers.
+///
+///   @n @section uartdma_api The API
+///
+///   Most functions return an error code, @ref ECODE_EMDRV_UARTDMA_OK is
+///   returned on success, see @ref ecode and @ref uartdma_error_codes for other
+///   error codes.
+///
+///   @ref UARTDMA_Init(), @ref UARTDMA_DeInit() @n
+///    Start and stop the driver on an initialized USART or EUSART.
+///
+///   @ref UARTDMA_Transmit() @n
+///    Copy data to the TX ring buffer and start sending it.
+///
+///   @ref UARTDMA_TxSpanGet(), @ref UARTDMA_TxSpanCommit() @n
+///    Write data to send directly into the TX ring buffer.
+///
+///   @ref UARTDMA_TxPending() @n
+///    Get the amount of data which hasn't been handed to the peripheral yet.
+///
+///   @ref UARTDMA_Receive() @n
+///    Copy received data out of the RX ring buffer.
+///
+///   @ref UARTDMA_RxSpanGet(), @ref UARTDMA_RxSpanRelease() @n
+///    Process received data directly in the RX ring buffer.
+///
+///   @ref UARTDMA_IRQHandler() @n
+///    RX idle line interrupt handling, for application interrupt handlers.
+///
+///   @n @section uartdma_example Example
+///   @code{.c}
+/// static uint8_t txBuffer[256];
+/// static uint8_t rxBuffer[256];
+/// static UARTDMA_HandleData_t handleData;
+/// static volatile bool frameReceived;
+///
+/// static void rxCallback(UARTDMA_Handle_t handle, UARTDMA_RxEvent_t event, void *userParam)
+/// {
+///   if (event == uartdmaRxEventIdle) {
+///     frameReceived = true;
+///   }
+/// }
+///
+/// void main(void)
+/// {
+///   UARTDMA_Init_t init = {
+///     .eusart = EUSART0,
+///     .txBuffer = txBuffer, .txBufferSize = sizeof(txBuffer),
+///     .rxBuffer = rxBuffer, .rxBufferSize = sizeof(rxBuffer), .rxSegments = 2,
+///     .rxIdleFrames = 2,         // Needs EMDRV_UARTDMA_RX_IDLE_DETECTION set to 1
+///     .rxCallback = rxCallback,
+///   };
+///   const uint8_t *span;
+///   uint32_t count;
+///
+///   // EUSART0 clocks, pins and EUSART_UartInitHf() set up here
+///
+///   UARTDMA_Init(&handleData, &init);
+///   UARTDMA_Transmit(&handleData, (const uint8_t *)"hello", 5);
+///
+///   while (1) {
+///     if (frameReceived) {
+///       frameReceived = false;
+///       while ((UARTDMA_RxSpanGet(&handleData, &span, &count) == ECODE_EMDRV_UARTDMA_OK)
+///              && (count > 0)) {
+///         process(span, count);
+///         UARTDMA_RxSpanRelease(&handleData, count);
+///       }
+///     }
+///   }
+/// }
+///   @endcode
+///
+/// @} end group uartdma ********************************************************
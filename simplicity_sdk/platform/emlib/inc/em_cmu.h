@@ -52,7 +52,15 @@ extern "C" {
  ******************************************************************************/
 
 /** Macro to set clock sources in the clock tree. */
+#if defined(_SILICON_LABS_32B_SERIES_2)
+#define CMU_CLOCK_SELECT_SET(clock, sel) \
+  do {                                   \
+    CMU_##clock##_SELECT_##sel;          \
+    sli_em_cmu_ClockTreeChanged();       \
+  } while (0)
+#else
 #define CMU_CLOCK_SELECT_SET(clock, sel) CMU_##clock##_SELECT_##sel
+#endif
 
 #if defined(_SILICON_LABS_32B_SERIES_2)
 
@@ -144,6 +152,12 @@ extern "C" {
 
 /** @endcond */
 
+/** Number of clock frequencies cached by @ref CMU_ClockFreqGet(), 0 disables
+ *  the cache. */
+#if !defined(CMU_CLOCK_FREQ_CACHE_SIZE)
+#define CMU_CLOCK_FREQ_CACHE_SIZE       0
+#endif
+
 /*******************************************************************************
  ********************************   ENUMS   ************************************
  ******************************************************************************/
@@ -1359,6 +1373,7 @@ void                       CMU_ClockDivSet(CMU_Clock_TypeDef clock,
 #if (_SILICON_LABS_32B_SERIES_2_CONFIG > 1)
 void                       CMU_ClockEnable(CMU_Clock_TypeDef clock, bool enable);
 #endif
+void                       CMU_ClockFreqCacheInvalidate(void);
 uint32_t                   CMU_ClockFreqGet(CMU_Clock_TypeDef clock);
 CMU_Select_TypeDef         CMU_ClockSelectGet(CMU_Clock_TypeDef clock);
 void                       CMU_ClockSelectSet(CMU_Clock_TypeDef clock,
@@ -1035,6 +1035,49 @@ typedef struct {
   uint8_t  id;    /**< ID of FIFO entry; Scan table entry id or single indicator (0x20). */
 } IADC_Result_t;
 
+/** Number of scan table entries tracked by a result stream. */
+#define IADC_STREAM_ID_COUNT  16U
+
+/** Result stream initialization structure. */
+typedef struct {
+  IADC_Alignment_t       alignment;     /**< Alignment of the raw scan FIFO data, as set by IADC_initScan(). */
+  const IADC_ScanTable_t *scanTable;    /**< Scan table given to IADC_initScan(). Entries with a negative input other than GND are differential and have signed data. NULL treats all entries as single-ended. */
+  uint32_t               decimation;    /**< Number of samples of a scan entry averaged into one result, 1 to 256. 1 disables averaging. */
+  int64_t                thresholdLow;  /**< Samples below this value are counted as below threshold. */
+  int64_t                thresholdHigh; /**< Samples above this value are counted as above threshold. */
+} IADC_StreamInit_t;
+
+/** Default config for result stream initialization structure. */
+#define IADC_STREAM_INIT_DEFAULT                         \
+  {                                                      \
+    iadcAlignRight12, /* Right aligned 12 bit data. */   \
+    NULL,             /* Single-ended entries. */        \
+    1,                /* No averaging. */                \
+    INT64_MIN,        /* No low threshold. */            \
+    INT64_MAX         /* No high threshold. */           \
+  }
+
+/** Result stream statistics of one scan table entry. */
+typedef struct {
+  int64_t  min;             /**< Smallest sample. */
+  int64_t  max;             /**< Largest sample. */
+  uint32_t sampleCount;     /**< Number of samples. */
+  uint32_t belowCount;      /**< Number of samples below the low threshold. */
+  uint32_t aboveCount;      /**< Number of samples above the high threshold. */
+  int64_t  decimationSum;   /**< Sum of the samples of the ongoing averaging window. */
+  uint32_t decimationCount; /**< Number of samples in the ongoing averaging window. */
+} IADC_StreamEntry_t;
+
+/** Result stream, converting and filtering raw scan FIFO data in batches. */
+typedef struct {
+  IADC_Alignment_t   alignment;                    /**< Alignment of the raw data. */
+  uint32_t           signedMask;                   /**< Bit n set when entry ID n has signed (differential) data. */
+  uint32_t           decimation;                   /**< Averaging ratio. */
+  int64_t            thresholdLow;                 /**< Low threshold. */
+  int64_t            thresholdHigh;                /**< High threshold. */
+  IADC_StreamEntry_t entry[IADC_STREAM_ID_COUNT];  /**< Statistics per scan table entry ID. */
+} IADC_Stream_t;
+
 /*******************************************************************************
  *****************************   PROTOTYPES   **********************************
  ******************************************************************************/
@@ -1068,6 +1111,20 @@ IADC_Result_t IADC_pullSingleFifoResult(IADC_TypeDef *iadc);
 IADC_Result_t IADC_readScanResult(IADC_TypeDef *iadc);
 IADC_Result_t IADC_pullScanFifoResult(IADC_TypeDef *iadc);
 uint32_t IADC_getReferenceVoltage(IADC_CfgReference_t reference);
+void IADC_convertRawData(const uint32_t *rawData,
+                         IADC_Result_t *results,
+                         uint32_t count,
+                         IADC_Alignment_t alignment);
+uint32_t IADC_pullScanFifoResults(IADC_TypeDef *iadc,
+                                  IADC_Result_t *results,
+                                  uint32_t maxCount);
+void IADC_streamInit(IADC_Stream_t *stream, const IADC_StreamInit_t *init);
+void IADC_streamResetStatistics(IADC_Stream_t *stream);
+uint32_t IADC_streamProcess(IADC_Stream_t *stream,
+                            const uint32_t *rawData,
+                            uint32_t count,
+                            IADC_Result_t *results);
+uint32_t IADC_calcScanSampleRate(IADC_TypeDef *iadc, uint32_t cmuClkFreq);
 
 /***************************************************************************//**
  * @brief
@@ -88,6 +88,29 @@ void sli_em_cmu_SYSTICEXTCLKENSet(void);
  ******************************************************************************/
 void sli_em_cmu_SYSTICEXTCLKENClear(void);
 
+/***************************************************************************//**
+ * @brief Invalidates the clock frequency cache and notifies the clock tree
+ *        change hook.
+ *
+ * @note FOR INTERNAL USE ONLY.
+ *
+ * @note This function is needed for macro expansion of CMU_CLOCK_SELECT_SET.
+ *       It must also be called by code which changes a clock selection,
+ *       a clock divider or an oscillator frequency without going through the
+ *       CMU API.
+ ******************************************************************************/
+void sli_em_cmu_ClockTreeChanged(void);
+
+/***************************************************************************//**
+ * @brief Called after each change of the clock tree.
+ *
+ * @note FOR INTERNAL USE ONLY.
+ *
+ * @note The default implementation does nothing. The Clock Manager overrides
+ *       it to notify its clock change subscribers.
+ ******************************************************************************/
+void sli_em_cmu_OnClockTreeChange(void);
+
 #define CMU_SYSCLK_SELECT_HFRCODPLL                                    \
   do {                                                                 \
     sli_em_cmu_SYSCLKInitPreClockSelect();                             \
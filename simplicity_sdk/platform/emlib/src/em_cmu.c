@@ -35,6 +35,7 @@
 #include "sl_assert.h"
 #include "em_bus.h"
 #include "sl_common.h"
+#include "em_core.h"
 #include "em_emu.h"
 #include "em_gpio.h"
 #include "em_system.h"
@@ -195,6 +196,19 @@ static int8_t ctuneDelta = 0;
 
 static uint8_t pclkDiv = 0;
 
+#if (CMU_CLOCK_FREQ_CACHE_SIZE > 0)
+// Frequencies computed by CMU_ClockFreqGet() since the last clock tree change.
+static struct {
+  CMU_Clock_TypeDef clock;
+  uint32_t freq;
+} clockFreqCache[CMU_CLOCK_FREQ_CACHE_SIZE];
+static uint8_t clockFreqCacheCount = 0;   // Number of valid entries
+static uint8_t clockFreqCacheNext = 0;    // Entry to replace when full
+// Incremented on each invalidation, a frequency computed across a clock tree
+// change must not be cached.
+static uint32_t clockFreqCacheGeneration = 0;
+#endif
+
 /*******************************************************************************
  **************************   LOCAL PROTOTYPES   *******************************
  ******************************************************************************/
@@ -236,6 +250,7 @@ static void     rhclkPrescOptimize(void);
 #if defined(HFRCOEM23_PRESENT)
 static uint32_t HFRCOEM23DevinfoGet(CMU_HFRCOEM23Freq_TypeDef freq);
 #endif
+static uint32_t clockFreqCompute(CMU_Clock_TypeDef clock);
 static void     traceClkGet(uint32_t *freq, CMU_Select_TypeDef *sel);
 static void     dpllRefClkGet(uint32_t *freq, CMU_Select_TypeDef *sel);
 static void     em01GrpaClkGet(uint32_t *freq, CMU_Select_TypeDef *sel);
@@ -792,6 +807,8 @@ void CMU_ClockDivSet(CMU_Clock_TypeDef clock, CMU_ClkDiv_TypeDef div)
       EFM_ASSERT(false);
       break;
   }
+
+  sli_em_cmu_ClockTreeChanged();
 }
 
 #if (_SILICON_LABS_32B_SERIES_2_CONFIG > 1)
@@ -847,7 +864,7 @@ SL_WEAK void CMU_ClockEnable(CMU_Clock_TypeDef clock, bool enable)
 #if defined(_SILICON_LABS_32B_SERIES_2_CONFIG_1)
 /***************************************************************************//**
  * @brief
- *   Get clock frequency for a clock point.
+ *   Compute the clock frequency of a clock point from the CMU registers.
  *
  * @param[in] clock
  *   Clock point to fetch frequency for.
@@ -855,7 +872,7 @@ SL_WEAK void CMU_ClockEnable(CMU_Clock_TypeDef clock, bool enable)
  * @return
  *   The current frequency in Hz.
  ******************************************************************************/
-uint32_t CMU_ClockFreqGet(CMU_Clock_TypeDef clock)
+static uint32_t clockFreqCompute(CMU_Clock_TypeDef clock)
 {
   uint32_t ret = 0U;
 
@@ -953,7 +970,7 @@ uint32_t CMU_ClockFreqGet(CMU_Clock_TypeDef clock)
 #if (_SILICON_LABS_32B_SERIES_2_CONFIG > 1)
 /***************************************************************************//**
  * @brief
- *   Get clock frequency for a clock point.
+ *   Compute the clock frequency of a clock point from the CMU registers.
  *
  * @param[in] clock
  *   Clock point to fetch frequency for.
@@ -961,7 +978,7 @@ uint32_t CMU_ClockFreqGet(CMU_Clock_TypeDef clock)
  * @return
  *   The current frequency in Hz.
  ******************************************************************************/
-uint32_t CMU_ClockFreqGet(CMU_Clock_TypeDef clock)
+static uint32_t clockFreqCompute(CMU_Clock_TypeDef clock)
 {
   uint32_t ret = 0U;
   uint32_t freq = 0U;
@@ -1193,6 +1210,86 @@ uint32_t CMU_ClockFreqGet(CMU_Clock_TypeDef clock)
 }
 #endif // (_SILICON_LABS_32B_SERIES_2_CONFIG > 1)
 
+/***************************************************************************//**
+ * @brief
+ *   Invalidate the clock frequencies cached by @ref CMU_ClockFreqGet().
+ *
+ * @details
+ *   The cache is invalidated by the CMU functions which change a clock
+ *   selection, a clock divider or an oscillator band. Code that writes these
+ *   CMU or oscillator registers directly, or that changes the frequency
+ *   reported by SystemHFXOClockSet() and similar functions, must call this
+ *   function afterwards.
+ ******************************************************************************/
+void CMU_ClockFreqCacheInvalidate(void)
+{
+#if (CMU_CLOCK_FREQ_CACHE_SIZE > 0)
+  CORE_DECLARE_IRQ_STATE;
+
+  CORE_ENTER_ATOMIC();
+  clockFreqCacheCount = 0U;
+  clockFreqCacheNext = 0U;
+  clockFreqCacheGeneration++;
+  CORE_EXIT_ATOMIC();
+#endif
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Get clock frequency for a clock point.
+ *
+ * @details
+ *   When @ref CMU_CLOCK_FREQ_CACHE_SIZE is not 0, the frequency of the most
+ *   recently used clock points is cached until the next clock tree change,
+ *   so that drivers computing their baudrate or prescaler on each transfer
+ *   don't have to walk the clock tree every time.
+ *
+ * @param[in] clock
+ *   Clock point to fetch frequency for.
+ *
+ * @return
+ *   The current frequency in Hz.
+ ******************************************************************************/
+uint32_t CMU_ClockFreqGet(CMU_Clock_TypeDef clock)
+{
+#if (CMU_CLOCK_FREQ_CACHE_SIZE > 0)
+  uint32_t freq;
+  uint32_t generation;
+  uint8_t i;
+  CORE_DECLARE_IRQ_STATE;
+
+  CORE_ENTER_ATOMIC();
+  for (i = 0U; i < clockFreqCacheCount; i++) {
+    if (clockFreqCache[i].clock == clock) {
+      freq = clockFreqCache[i].freq;
+      CORE_EXIT_ATOMIC();
+      return freq;
+    }
+  }
+  generation = clockFreqCacheGeneration;
+  CORE_EXIT_ATOMIC();
+
+  freq = clockFreqCompute(clock);
+
+  CORE_ENTER_ATOMIC();
+  if (generation == clockFreqCacheGeneration) {
+    if (clockFreqCacheCount < CMU_CLOCK_FREQ_CACHE_SIZE) {
+      i = clockFreqCacheCount++;
+    } else {
+      i = clockFreqCacheNext;
+      clockFreqCacheNext = (uint8_t)((clockFreqCacheNext + 1U) % CMU_CLOCK_FREQ_CACHE_SIZE);
+    }
+    clockFreqCache[i].clock = clock;
+    clockFreqCache[i].freq = freq;
+  }
+  CORE_EXIT_ATOMIC();
+
+  return freq;
+#else
+  return clockFreqCompute(clock);
+#endif
+}
+
 /***************************************************************************//**
  * @brief
  *   Get currently selected reference clock used for a clock branch.
@@ -1544,6 +1641,32 @@ void sli_em_cmu_SYSTICEXTCLKENClear(void)
 #endif
 }
 
+/***************************************************************************//**
+ * @brief Invalidates the clock frequency cache and notifies the clock tree
+ *        change hook.
+ *
+ * @note FOR INTERNAL USE ONLY.
+ *
+ * @note This function is needed for macro expansion of CMU_CLOCK_SELECT_SET.
+ ******************************************************************************/
+void sli_em_cmu_ClockTreeChanged(void)
+{
+  CMU_ClockFreqCacheInvalidate();
+  sli_em_cmu_OnClockTreeChange();
+}
+
+/***************************************************************************//**
+ * @brief Called after each change of the clock tree.
+ *
+ * @note FOR INTERNAL USE ONLY.
+ *
+ * @note The default implementation does nothing. The Clock Manager overrides
+ *       it to notify its clock change subscribers.
+ ******************************************************************************/
+SL_WEAK void sli_em_cmu_OnClockTreeChange(void)
+{
+}
+
 /***************************************************************************//**
  * @brief
  *   Select reference clock/oscillator used for a clock branch.
@@ -2399,6 +2522,8 @@ void CMU_ClockSelectSet(CMU_Clock_TypeDef clock, CMU_Select_TypeDef ref)
       EFM_ASSERT(false);
       break;
   }
+
+  sli_em_cmu_ClockTreeChanged();
 }
 
 /***************************************************************************//**
@@ -2632,6 +2757,8 @@ void CMU_HFRCODPLLBandSet(CMU_HFRCODPLLFreq_TypeDef freq)
     EMU_VScaleEM01ByClock(0, true);
   }
 #endif
+
+  sli_em_cmu_ClockTreeChanged();
 }
 
 /**************************************************************************//**
@@ -2830,6 +2957,8 @@ bool CMU_DPLLLock(const CMU_DPLLInit_TypeDef *init)
 #endif
   }
 
+  sli_em_cmu_ClockTreeChanged();
+
   if (hfrcoClamped) {
     return false;
   } else if (lockStatus == DPLL_IF_LOCK) {
@@ -2891,6 +3020,8 @@ void CMU_USBPLLInit(const CMU_USBPLL_Init_TypeDef *pllInit)
   if (pllInit->regLock) {
     USBPLL0->LOCK = ~USBPLL_LOCK_LOCKKEY_UNLOCK;
   }
+
+  sli_em_cmu_ClockTreeChanged();
 }
 #endif
 
@@ -2932,6 +3063,8 @@ void CMU_RFFPLLInit(const CMU_RFFPLL_Init_TypeDef *pllInit)
   if (pllInit->regLock) {
     RFFPLL0->LOCK = ~USBPLL_LOCK_LOCKKEY_UNLOCK;
   }
+
+  sli_em_cmu_ClockTreeChanged();
 }
 #endif
 
@@ -3993,6 +4126,8 @@ void CMU_HFRCOEM23BandSet(CMU_HFRCOEM23Freq_TypeDef freq)
 
   // Activate new band selection
   HFRCOEM23->CAL = freqCal;
+
+  sli_em_cmu_ClockTreeChanged();
 }
 #endif // defined(HFRCOEM23_PRESENT)
 
@@ -74,6 +74,14 @@ void sli_em_cmu_SYSCLKInitPostClockSelect(bool optimize_divider)
 {
 }
 
+void sli_em_cmu_ClockTreeChanged(void)
+{
+}
+
+void CMU_ClockFreqCacheInvalidate(void)
+{
+}
+
 uint32_t Get_Fpga_Core_freq(void)
 {
   if ((SYSCFG->FPGAIPOTHW & SYSCFG_FPGAIPOTHW_FPGA_FPGA) != 0U) {
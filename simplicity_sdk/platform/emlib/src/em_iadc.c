@@ -183,6 +183,92 @@ static IADC_Result_t IADC_ConvertRawDataToResult(uint32_t rawData,
   return result;
 }
 
+/* Check whether a result alignment is one of the right aligned formats. */
+static bool IADC_isRightAligned(IADC_Alignment_t alignment)
+{
+  switch (alignment) {
+    case iadcAlignRight12:
+#if defined(IADC_SINGLEFIFOCFG_ALIGNMENT_RIGHT16)
+    case iadcAlignRight16:
+#endif
+#if defined(IADC_SINGLEFIFOCFG_ALIGNMENT_RIGHT20)
+    case iadcAlignRight20:
+#endif
+      return true;
+    default:
+      return false;
+  }
+}
+
+/* Mask out the ID of a right aligned raw result and replace it with the
+ * sign extension, same as IADC_ConvertRawDataToResult(). */
+__STATIC_INLINE uint32_t IADC_rightAlignedSample(uint32_t rawData)
+{
+  return (rawData & 0x00FFFFFFUL)
+         | ((rawData & 0x00800000UL) != 0x0UL ? 0xFF000000UL : 0x0UL);
+}
+
+/* Mask out the ID of a left aligned raw result. */
+__STATIC_INLINE uint32_t IADC_leftAlignedSample(uint32_t rawData)
+{
+  return rawData & 0xFFFFFF00UL;
+}
+
+/* Run the data of one result through the statistics and decimation stages of
+ * a stream. Returns true and writes the result when a decimated result is
+ * complete. */
+__STATIC_INLINE bool IADC_streamAccumulate(IADC_Stream_t *stream,
+                                           uint8_t id,
+                                           uint32_t data,
+                                           IADC_Result_t *result)
+{
+  IADC_StreamEntry_t *entry;
+  int64_t sample;
+
+  if (id >= IADC_STREAM_ID_COUNT) {
+    return false;
+  }
+  entry = &stream->entry[id];
+
+  // Only differential entries produce signed data
+  if ((stream->signedMask & (1UL << id)) != 0UL) {
+    sample = (int32_t)data;
+  } else {
+    sample = (int64_t)data;
+  }
+
+  if (sample < entry->min) {
+    entry->min = sample;
+  }
+  if (sample > entry->max) {
+    entry->max = sample;
+  }
+  if (sample < stream->thresholdLow) {
+    entry->belowCount++;
+  } else if (sample > stream->thresholdHigh) {
+    entry->aboveCount++;
+  }
+  entry->sampleCount++;
+
+  if (stream->decimation <= 1UL) {
+    result->data = data;
+    result->id   = id;
+    return true;
+  }
+
+  entry->decimationSum += sample;
+  entry->decimationCount++;
+  if (entry->decimationCount < stream->decimation) {
+    return false;
+  }
+  result->data = (uint32_t)(entry->decimationSum
+                            / (int64_t)entry->decimationCount);
+  result->id   = id;
+  entry->decimationSum   = 0;
+  entry->decimationCount = 0;
+  return true;
+}
+
 /** @endcond */
 
 /*******************************************************************************
@@ -1173,6 +1259,328 @@ uint32_t IADC_getReferenceVoltage(IADC_CfgReference_t reference)
   return refVoltage;
 }
 
+/***************************************************************************//**
+ * @brief
+ *   Convert a block of raw scan or single FIFO words to results.
+ *
+ * @details
+ *   This is the batch version of the conversion done by
+ *   @ref IADC_pullScanFifoResult(), meant for data moved out of the FIFO by
+ *   LDMA. The alignment is resolved once for the whole block.
+ *
+ * @param[in] rawData
+ *   Raw FIFO words.
+ *
+ * @param[out] results
+ *   Converted results, must hold @p count entries.
+ *
+ * @param[in] count
+ *   Number of words to convert.
+ *
+ * @param[in] alignment
+ *   Alignment the FIFO was configured with.
+ ******************************************************************************/
+void IADC_convertRawData(const uint32_t *rawData,
+                         IADC_Result_t *results,
+                         uint32_t count,
+                         IADC_Alignment_t alignment)
+{
+  uint32_t i;
+
+  EFM_ASSERT((rawData != NULL) || (count == 0UL));
+  EFM_ASSERT((results != NULL) || (count == 0UL));
+
+  if (IADC_isRightAligned(alignment)) {
+    for (i = 0; i < count; i++) {
+      results[i].data = IADC_rightAlignedSample(rawData[i]);
+      results[i].id   = (uint8_t)(rawData[i] >> 24);
+    }
+  } else {
+    for (i = 0; i < count; i++) {
+      results[i].data = IADC_leftAlignedSample(rawData[i]);
+      results[i].id   = (uint8_t)(rawData[i] & 0x000000FFUL);
+    }
+  }
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Pull all available results from the scan data FIFO.
+ *
+ * @param[in] iadc
+ *   Pointer to IADC peripheral register block.
+ *
+ * @param[out] results
+ *   Buffer receiving the results.
+ *
+ * @param[in] maxCount
+ *   Number of entries in @p results.
+ *
+ * @return
+ *   Number of results pulled from the FIFO.
+ ******************************************************************************/
+uint32_t IADC_pullScanFifoResults(IADC_TypeDef *iadc,
+                                  IADC_Result_t *results,
+                                  uint32_t maxCount)
+{
+  uint32_t alignment = (iadc->SCANFIFOCFG & _IADC_SCANFIFOCFG_ALIGNMENT_MASK)
+                       >> _IADC_SCANFIFOCFG_ALIGNMENT_SHIFT;
+  uint32_t count = (iadc->SCANFIFOSTAT & _IADC_SCANFIFOSTAT_FIFOREADCNT_MASK)
+                   >> _IADC_SCANFIFOSTAT_FIFOREADCNT_SHIFT;
+  uint32_t rawData;
+  uint32_t i;
+
+  EFM_ASSERT(IADC_REF_VALID(iadc));
+
+  count = SL_MIN(count, maxCount);
+
+  if (IADC_isRightAligned((IADC_Alignment_t)alignment)) {
+    for (i = 0; i < count; i++) {
+      rawData = iadc->SCANFIFODATA;
+      results[i].data = IADC_rightAlignedSample(rawData);
+      results[i].id   = (uint8_t)(rawData >> 24);
+    }
+  } else {
+    for (i = 0; i < count; i++) {
+      rawData = iadc->SCANFIFODATA;
+      results[i].data = IADC_leftAlignedSample(rawData);
+      results[i].id   = (uint8_t)(rawData & 0x000000FFUL);
+    }
+  }
+
+  return count;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Initialize a scan result stream.
+ *
+ * @details
+ *   A stream processes blocks of raw scan FIFO words, typically the segments
+ *   of a DMADRV ring buffer filled from the IADC scan FIFO:
+ *   @code{.c}
+ *   DMADRV_PeripheralMemoryRing(channel, dmadrvPeripheralSignal_IADC0_IADC_SCAN,
+ *                               ring, (void *)&IADC0->SCANFIFODATA,
+ *                               RING_LEN, 4, dmadrvDataSize4, NULL, NULL);
+ *   ...
+ *   DMADRV_RingAvailable(channel, &index, &available);
+ *   // Unread data may wrap around the end of the ring
+ *   available = SL_MIN(available, RING_LEN - index);
+ *   n = IADC_streamProcess(&stream, &ring[index], available, results);
+ *   DMADRV_RingConsume(channel, available);
+ *   @endcode
+ *   The scan entries must be configured with showId set, since the ID is used
+ *   to sort samples to their statistics entry.
+ *
+ * @param[out] stream
+ *   Stream to initialize.
+ *
+ * @param[in] init
+ *   Stream configuration.
+ ******************************************************************************/
+void IADC_streamInit(IADC_Stream_t *stream, const IADC_StreamInit_t *init)
+{
+  uint32_t i;
+
+  EFM_ASSERT((init->decimation >= 1UL) && (init->decimation <= 256UL));
+  EFM_ASSERT(init->thresholdLow <= init->thresholdHigh);
+
+  stream->signedMask = 0;
+  if (init->scanTable != NULL) {
+    for (i = 0; (i < IADC0_ENTRIES) && (i < IADC_STREAM_ID_COUNT); i++) {
+      if ((init->scanTable->entries[i].negInput != iadcNegInputGnd)
+          && (init->scanTable->entries[i].negInput != iadcNegInputGndaux)) {
+        stream->signedMask |= 1UL << i;
+      }
+    }
+  }
+
+  stream->alignment     = init->alignment;
+  stream->decimation    = init->decimation;
+  stream->thresholdLow  = init->thresholdLow;
+  stream->thresholdHigh = init->thresholdHigh;
+  IADC_streamResetStatistics(stream);
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Reset the statistics and discard the partial averages of a stream.
+ *
+ * @param[in] stream
+ *   Stream to reset.
+ ******************************************************************************/
+void IADC_streamResetStatistics(IADC_Stream_t *stream)
+{
+  uint32_t i;
+
+  for (i = 0; i < IADC_STREAM_ID_COUNT; i++) {
+    stream->entry[i].min             = INT64_MAX;
+    stream->entry[i].max             = INT64_MIN;
+    stream->entry[i].sampleCount     = 0;
+    stream->entry[i].belowCount      = 0;
+    stream->entry[i].aboveCount      = 0;
+    stream->entry[i].decimationSum   = 0;
+    stream->entry[i].decimationCount = 0;
+  }
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Process a block of raw scan FIFO words.
+ *
+ * @details
+ *   Every sample updates the min/max and threshold statistics of its scan
+ *   table entry. With a decimation of 1 every sample is written to
+ *   @p results, otherwise one averaged result is written per
+ *   decimation samples of each entry. Partial averages carry over to the next
+ *   call. Samples with an ID of @ref IADC_STREAM_ID_COUNT or above are
+ *   dropped.
+ *
+ *   Sample values and thresholds are in the format of @ref IADC_Result_t data,
+ *   i.e. right aligned or in the upper 24 bits when left aligned. The data of
+ *   differential entries is compared and averaged as signed, the data of
+ *   single-ended entries as unsigned, see @ref IADC_StreamInit_t::scanTable.
+ *
+ * @param[in] stream
+ *   Stream to run the samples through.
+ *
+ * @param[in] rawData
+ *   Raw FIFO words.
+ *
+ * @param[in] count
+ *   Number of words to process.
+ *
+ * @param[out] results
+ *   Buffer receiving the results, must hold @p count entries. May be NULL
+ *   when only the statistics are of interest.
+ *
+ * @return
+ *   Number of results written.
+ ******************************************************************************/
+uint32_t IADC_streamProcess(IADC_Stream_t *stream,
+                            const uint32_t *rawData,
+                            uint32_t count,
+                            IADC_Result_t *results)
+{
+  IADC_Result_t result;
+  uint32_t resultCount = 0;
+  uint32_t i;
+
+  EFM_ASSERT((rawData != NULL) || (count == 0UL));
+
+  if (IADC_isRightAligned(stream->alignment)) {
+    for (i = 0; i < count; i++) {
+      if (IADC_streamAccumulate(stream,
+                                (uint8_t)(rawData[i] >> 24),
+                                IADC_rightAlignedSample(rawData[i]),
+                                &result)) {
+        if (results != NULL) {
+          results[resultCount] = result;
+        }
+        resultCount++;
+      }
+    }
+  } else {
+    for (i = 0; i < count; i++) {
+      if (IADC_streamAccumulate(stream,
+                                (uint8_t)(rawData[i] & 0x000000FFUL),
+                                IADC_leftAlignedSample(rawData[i]),
+                                &result)) {
+        // Averaging may have set bits below the data field
+        result.data &= 0xFFFFFF00UL;
+        if (results != NULL) {
+          results[resultCount] = result;
+        }
+        resultCount++;
+      }
+    }
+  }
+
+  return resultCount;
+}
+
+/***************************************************************************//**
+ * @brief
+ *   Calculate the scan sample rate achievable with the current configuration.
+ *
+ * @details
+ *   The conversion time of each entry enabled in the scan mask is estimated
+ *   as (4 * OSR + 2) * digital averaging CLK_ADC cycles, using the
+ *   oversampling ratio, averaging and CLK_ADC prescaler of the configuration
+ *   the entry uses. Warm-up and trigger latencies are not included, so the
+ *   result is an upper bound for continuous scans.
+ *
+ * @param[in] iadc
+ *   Pointer to IADC peripheral register block.
+ *
+ * @param[in] cmuClkFreq
+ *   Frequency in Hz of CLK_CMU_ADC. Set to 0 to use currently defined CMU
+ *   clock setting for the IADC.
+ *
+ * @return
+ *   Samples per second, summed over all entries of the scan, 0 if the scan
+ *   mask is empty.
+ ******************************************************************************/
+uint32_t IADC_calcScanSampleRate(IADC_TypeDef *iadc, uint32_t cmuClkFreq)
+{
+  uint32_t mask = iadc->MASKREQ & _IADC_MASKREQ_MASK;
+  uint32_t srcClkFreq;
+  uint64_t totalCycles = 0;
+  uint32_t entries = 0;
+  uint32_t i;
+
+  EFM_ASSERT(IADC_REF_VALID(iadc));
+
+  if (cmuClkFreq == 0UL) {
+    cmuClkFreq = CMU_ClockFreqGet(IADC_CMU_CLOCK(iadc));
+  }
+  srcClkFreq = cmuClkFreq
+               / (((iadc->CTRL & _IADC_CTRL_HSCLKRATE_MASK) >> _IADC_CTRL_HSCLKRATE_SHIFT) + 1UL);
+
+  for (i = 0; i < IADC_STREAM_ID_COUNT; i++) {
+    uint32_t config;
+    uint32_t cfg;
+    uint32_t osr;
+    uint32_t cycles;
+
+    if ((mask & (1UL << i)) == 0UL) {
+      continue;
+    }
+    config = (iadc->SCANTABLE[i].SCAN & _IADC_SCAN_CFG_MASK) >> _IADC_SCAN_CFG_SHIFT;
+    cfg = iadc->CFG[config].CFG;
+
+    switch ((cfg & _IADC_CFG_ADCMODE_MASK) >> _IADC_CFG_ADCMODE_SHIFT) {
+#if defined(_IADC_CFG_ADCMODE_HIGHACCURACY)
+      case _IADC_CFG_ADCMODE_HIGHACCURACY:
+        osr = (cfg & _IADC_CFG_OSRHA_MASK) >> _IADC_CFG_OSRHA_SHIFT;
+        osr = (osr == _IADC_CFG_OSRHA_HIACC92) ? 92UL
+              : (osr < _IADC_CFG_OSRHA_HIACC92) ? (16UL << osr)
+              : (8UL << osr);
+        break;
+#endif
+      default:
+        osr = 2UL << ((cfg & _IADC_CFG_OSRHS_MASK) >> _IADC_CFG_OSRHS_SHIFT);
+        break;
+    }
+
+    cycles = (4UL * osr) + 2UL;
+#if defined(_IADC_CFG_DIGAVG_MASK)
+    cycles <<= (cfg & _IADC_CFG_DIGAVG_MASK) >> _IADC_CFG_DIGAVG_SHIFT;
+#endif
+    // Cycles of CLK_SRC_ADC per conversion
+    cycles *= ((iadc->CFG[config].SCHED & _IADC_SCHED_PRESCALE_MASK)
+               >> _IADC_SCHED_PRESCALE_SHIFT) + 1UL;
+
+    totalCycles += cycles;
+    entries++;
+  }
+
+  if (totalCycles == 0UL) {
+    return 0UL;
+  }
+  return (uint32_t)(((uint64_t)entries * srcClkFreq) / totalCycles);
+}
+
 /** @} (end addtogroup iadc) */
 /** @} (end addtogroup emlib) */
 #endif /* defined(IADC_COUNT) && (IADC_COUNT > 0) */
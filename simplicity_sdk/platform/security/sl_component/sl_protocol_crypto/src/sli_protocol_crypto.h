@@ -203,6 +203,41 @@ int sli_process_ble_rpa(const unsigned char keytable[],
                         uint32_t            prand,
                         uint32_t            hash);
 
+/***************************************************************************//**
+ * @brief          Resolve a list of BLE RPAs against a table of device keys
+ *
+ * @details        Addresses are processed in groups, and each group is run
+ *                 through the AES as one multi-block message per key. Recently
+ *                 resolved addresses are kept in a small cache and are checked
+ *                 against their cached key first.
+ *
+ * @param keytable Pointer to an array of AES-128 keys, corresponding to the
+ *                 per-device key in the BLE RPA process
+ * @param keymask  Bitmask indicating with key indices in keytable are valid
+ * @param prand    Array of 24-bit BLE nonces, one per address
+ * @param hash     Array of BLE RPA hashes, one per address
+ * @param count    Number of addresses
+ * @param irk_index Output array receiving the 0-based index of the matching
+ *                 key for each address, or -1 for no match.
+ *
+ * @return         SL_STATUS_OK if successful, relevant status code on error
+ ******************************************************************************/
+sl_status_t sli_process_ble_rpa_batch(const unsigned char keytable[],
+                                      uint32_t            keymask,
+                                      const uint32_t      prand[],
+                                      const uint32_t      hash[],
+                                      size_t              count,
+                                      int                 irk_index[]);
+
+/***************************************************************************//**
+ * @brief          Clear the BLE resolved-address cache
+ *
+ * @details        Call this when keys in the IRK table are changed in place.
+ *                 Changing the key table pointer or the key mask is detected
+ *                 automatically.
+ ******************************************************************************/
+void sli_process_ble_rpa_cache_invalidate(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -46,6 +46,23 @@
 #define RADIOAES_BLE_RPA_MAX_KEYS 32
 #endif
 
+// Maximum number of addresses resolved in one pass over the key table
+#ifndef RADIOAES_BLE_RPA_BATCH_SIZE
+#define RADIOAES_BLE_RPA_BATCH_SIZE 8
+#endif
+
+// Number of entries in the resolved-address cache, 0 disables the cache
+#ifndef RADIOAES_BLE_RPA_CACHE_SIZE
+#define RADIOAES_BLE_RPA_CACHE_SIZE 16
+#endif
+
+// Also cache addresses which did not resolve against any key. Only enable
+// this if sli_process_ble_rpa_cache_invalidate() is called whenever a key in
+// the table is replaced without changing the key table pointer or mask.
+#ifndef RADIOAES_BLE_RPA_CACHE_UNRESOLVED
+#define RADIOAES_BLE_RPA_CACHE_UNRESOLVED 0
+#endif
+
 /// value for sli_radioaes_dma_sg_descr.tag to direct data to parameters
 #define DMA_SG_TAG_ISCONFIG 0x00000010
 /// value for sli_radioaes_dma_sg_descr.tag to direct data to processing
@@ -720,40 +737,212 @@ sl_status_t sli_ccm_zigbee(bool encrypt,
                        tag_len);
 }
 
+// -----------------------------------------------------------------------------
+// BLE RPA resolution
+
+#define BLE_RPA_WORDS_PER_BLOCK   (AES_BLOCK_BYTES / sizeof(uint32_t))
+#define BLE_RPA_HASH_MASK         0xFFFFFF00UL
+#define BLE_RPA_CACHE_MISS        (-2)
+
+#if RADIOAES_BLE_RPA_CACHE_SIZE > 0
+
+#if (RADIOAES_BLE_RPA_CACHE_SIZE & (RADIOAES_BLE_RPA_CACHE_SIZE - 1)) != 0
+#error "RADIOAES_BLE_RPA_CACHE_SIZE must be a power of two"
+#endif
+
+// Resolved-address cache. Direct-mapped, indexed by the low bits of the
+// address. Entries with irk_index >= 0 are hints only: they are verified by
+// running the RPA against the cached key before being reported, so an IRK
+// table update can never produce a false match.
+typedef struct {
+  uint32_t prand;
+  uint32_t hash;
+  int8_t   irk_index;
+  bool     valid;
+} ble_rpa_cache_entry_t;
+
+static ble_rpa_cache_entry_t ble_rpa_cache[RADIOAES_BLE_RPA_CACHE_SIZE];
+static const unsigned char *ble_rpa_cache_keytable = NULL;
+static uint32_t ble_rpa_cache_keymask = 0;
+
+static inline ble_rpa_cache_entry_t *ble_rpa_cache_slot(uint32_t prand,
+                                                         uint32_t hash)
+{
+  return &ble_rpa_cache[(prand ^ hash) & (RADIOAES_BLE_RPA_CACHE_SIZE - 1)];
+}
+
+// Drop cached unresolved addresses when the caller's IRK table has changed,
+// since a key added to the table may now resolve them.
+static void ble_rpa_cache_check_table(const unsigned char keytable[],
+                                      uint32_t            keymask)
+{
+  CORE_DECLARE_IRQ_STATE;
+  CORE_ENTER_ATOMIC();
+  if ((keytable != ble_rpa_cache_keytable) || (keymask != ble_rpa_cache_keymask)) {
+    for (size_t i = 0; i < RADIOAES_BLE_RPA_CACHE_SIZE; i++) {
+      if (ble_rpa_cache[i].irk_index < 0) {
+        ble_rpa_cache[i].valid = false;
+      }
+    }
+    ble_rpa_cache_keytable = keytable;
+    ble_rpa_cache_keymask = keymask;
+  }
+  CORE_EXIT_ATOMIC();
+}
+
+// Returns the cached key index, -1 for a cached unresolved address or
+// BLE_RPA_CACHE_MISS.
+static int ble_rpa_cache_lookup(uint32_t prand, uint32_t hash)
+{
+  int irk_index = BLE_RPA_CACHE_MISS;
+  ble_rpa_cache_entry_t *entry = ble_rpa_cache_slot(prand, hash);
+  CORE_DECLARE_IRQ_STATE;
+  CORE_ENTER_ATOMIC();
+  if (entry->valid && (entry->prand == prand) && (entry->hash == hash)) {
+    irk_index = entry->irk_index;
+  }
+  CORE_EXIT_ATOMIC();
+  return irk_index;
+}
+
+static void ble_rpa_cache_store(uint32_t prand, uint32_t hash, int irk_index)
+{
+  ble_rpa_cache_entry_t *entry = ble_rpa_cache_slot(prand, hash);
+  CORE_DECLARE_IRQ_STATE;
+  CORE_ENTER_ATOMIC();
+  if ((irk_index >= 0) || RADIOAES_BLE_RPA_CACHE_UNRESOLVED) {
+    entry->prand = prand;
+    entry->hash = hash;
+    entry->irk_index = (int8_t)irk_index;
+    entry->valid = true;
+  } else if ((entry->prand == prand) && (entry->hash == hash)) {
+    // Address no longer resolves, don't keep a stale hint around
+    entry->valid = false;
+  }
+  CORE_EXIT_ATOMIC();
+}
+
+void sli_process_ble_rpa_cache_invalidate(void)
+{
+  CORE_DECLARE_IRQ_STATE;
+  CORE_ENTER_ATOMIC();
+  for (size_t i = 0; i < RADIOAES_BLE_RPA_CACHE_SIZE; i++) {
+    ble_rpa_cache[i].valid = false;
+  }
+  ble_rpa_cache_keytable = NULL;
+  ble_rpa_cache_keymask = 0;
+  CORE_EXIT_ATOMIC();
+}
+
+#else // RADIOAES_BLE_RPA_CACHE_SIZE > 0
+
+static inline void ble_rpa_cache_check_table(const unsigned char keytable[],
+                                             uint32_t            keymask)
+{
+  (void)keytable;
+  (void)keymask;
+}
+
+static inline int ble_rpa_cache_lookup(uint32_t prand, uint32_t hash)
+{
+  (void)prand;
+  (void)hash;
+  return BLE_RPA_CACHE_MISS;
+}
+
+static inline void ble_rpa_cache_store(uint32_t prand, uint32_t hash, int irk_index)
+{
+  (void)prand;
+  (void)hash;
+  (void)irk_index;
+}
+
+void sli_process_ble_rpa_cache_invalidate(void)
+{
+}
+
+#endif // RADIOAES_BLE_RPA_CACHE_SIZE > 0
+
+// Compare one key's worth of RPA output blocks against the expected hashes.
+// Returns the number of newly resolved addresses.
+static size_t ble_rpa_match(volatile uint32_t data_out[][BLE_RPA_WORDS_PER_BLOCK],
+                            const uint32_t    hash[],
+                            size_t            count,
+                            int               irk_index[],
+                            int               block)
+{
+  size_t matches = 0;
+
+  // Data output contains hash in the most significant word (WORD3).
+  for (size_t i = 0; i < count; i++) {
+    if ((irk_index[i] < 0)
+        && ((data_out[i][3] & BLE_RPA_HASH_MASK) == __REV(hash[i]))) {
+      irk_index[i] = block;
+      matches++;
+    }
+  }
+
+  return matches;
+}
+
 //
-// Process a table of BLE RPA device keys and look for a
-// match against the supplied hash. Algorithm is AES-128.
+// Encrypt the prand of up to RADIOAES_BLE_RPA_BATCH_SIZE addresses with each
+// key in keymask and record the first matching key for every address. All
+// addresses are pushed through the AES as one multi-block ECB message per
+// key, so the key and config are loaded once per key rather than once per
+// key and address. Algorithm is AES-128.
 //
-int sli_process_ble_rpa(const unsigned char keytable[],
-                        uint32_t            keymask,
-                        uint32_t            prand,
-                        uint32_t            hash)
+static sl_status_t ble_rpa_resolve(const unsigned char keytable[],
+                                   uint32_t            keymask,
+                                   const uint32_t      prand[],
+                                   const uint32_t      hash[],
+                                   size_t              count,
+                                   int                 irk_index[])
 {
   int block;
-  int previous_block = -1, result = -1;
+  int previous_block = -1;
+  size_t pending = count;
+  unsigned int out = 0;
   static const uint32_t  aes_rpa_config = AES_MODEID_ECB
                                           | AES_MODEID_NO_CX
                                           | AES_MODEID_AES128
                                           | AES_MODEID_ENCRYPT;
 
-  uint32_t rpa_data_in[AES_BLOCK_BYTES / sizeof(uint32_t)] = { 0 };
-  volatile uint32_t rpa_data_out[AES_BLOCK_BYTES / sizeof(uint32_t)];
+  uint32_t rpa_data_in[RADIOAES_BLE_RPA_BATCH_SIZE][BLE_RPA_WORDS_PER_BLOCK] = { { 0 } };
+  volatile uint32_t rpa_data_out[2][RADIOAES_BLE_RPA_BATCH_SIZE][BLE_RPA_WORDS_PER_BLOCK];
   sli_radioaes_state_t aes_ctx;
   CORE_DECLARE_IRQ_STATE;
 
-  rpa_data_in[3] = __REV(prand);
+  for (size_t i = 0; i < count; i++) {
+    rpa_data_in[i][3] = __REV(prand[i]);
+    irk_index[i] = -1;
+  }
 
-  sli_radioaes_dma_descr_t aes_desc_pusher_data = {
-    .address       = (uint32_t) rpa_data_out,
-    .nextDescr     = DMA_AXI_DESCR_NEXT_STOP,
-    .lengthAndIrq  = AES_BLOCK_BYTES | (BLOCK_S_INCR_ADDR & BLOCK_S_FLAG_MASK_DMA_PROPS),
-    .tag           = DMA_SG_ENGINESELECT_BA411E | DMA_SG_TAG_ISLAST
+  if ((count == 0) || (keymask == 0)) {
+    return SL_STATUS_OK;
+  }
+
+  // Double-buffered output, so the results of one key can be checked while
+  // the next key is being processed.
+  sli_radioaes_dma_descr_t aes_desc_pusher_data[2] = {
+    {
+      .address       = (uint32_t) rpa_data_out[0],
+      .nextDescr     = DMA_AXI_DESCR_NEXT_STOP,
+      .lengthAndIrq  = (count * AES_BLOCK_BYTES) | (BLOCK_S_INCR_ADDR & BLOCK_S_FLAG_MASK_DMA_PROPS),
+      .tag           = DMA_SG_ENGINESELECT_BA411E | DMA_SG_TAG_ISLAST
+    },
+    {
+      .address       = (uint32_t) rpa_data_out[1],
+      .nextDescr     = DMA_AXI_DESCR_NEXT_STOP,
+      .lengthAndIrq  = (count * AES_BLOCK_BYTES) | (BLOCK_S_INCR_ADDR & BLOCK_S_FLAG_MASK_DMA_PROPS),
+      .tag           = DMA_SG_ENGINESELECT_BA411E | DMA_SG_TAG_ISLAST
+    }
   };
 
   sli_radioaes_dma_descr_t aes_desc_fetcher_data = {
     .address       = (uint32_t) rpa_data_in,
     .nextDescr     = DMA_AXI_DESCR_NEXT_STOP,
-    .lengthAndIrq  = AES_BLOCK_BYTES | (BLOCK_S_INCR_ADDR & BLOCK_S_FLAG_MASK_DMA_PROPS),
+    .lengthAndIrq  = (count * AES_BLOCK_BYTES) | (BLOCK_S_INCR_ADDR & BLOCK_S_FLAG_MASK_DMA_PROPS),
     .tag           = DMA_SG_ENGINESELECT_BA411E | DMA_SG_TAG_ISLAST | DMA_SG_TAG_ISDATA | DMA_SG_TAG_DATATYPE_AESPAYLOAD
   };
 
@@ -776,7 +965,7 @@ int sli_process_ble_rpa(const unsigned char keytable[],
   if (status == SL_STATUS_ISR) {
     sli_radioaes_save_state(&aes_ctx);
   } else if (status != SL_STATUS_OK) {
-    return -1;
+    return status;
   }
 
   RADIOAES->CTRL = AES_CTRL_FETCHERSCATTERGATHER | AES_CTRL_PUSHERSCATTERGATHER;
@@ -792,7 +981,6 @@ int sli_process_ble_rpa(const unsigned char keytable[],
   // and starting the corresponding data pusher.
   CORE_ENTER_CRITICAL();
 
-  // Data output contains hash in the most significant word (WORD3).
   // Descriptors for blocks that are not included in key mask will be skipped.
   for (block = 0; block < RADIOAES_BLE_RPA_MAX_KEYS; block++) {
     if ( keymask & (1U << block) ) {  // Skip masked keys
@@ -811,25 +999,28 @@ int sli_process_ble_rpa(const unsigned char keytable[],
       while (RADIOAES->STATUS & AES_STATUS_PUSHERBSY) {
         // Wait for completion
       }
-      RADIOAES->PUSHADDR  = (uint32_t) &aes_desc_pusher_data;
+
+      // Start pusher so it is ready to push results when encryption is done
+      RADIOAES->PUSHADDR  = (uint32_t) &aes_desc_pusher_data[out];
+      RADIOAES->CMD = AES_CMD_STARTPUSHER;
 
       // Check previous results while AES is processing
-      if ((previous_block >= 0) && ((rpa_data_out[3] & 0xFFFFFF00) == __REV(hash)) ) {
-        // Make sure AES is finished before returning
-        RADIOAES->CMD = AES_CMD_STARTPUSHER;
-        result = previous_block;
-        break;
+      if (previous_block >= 0) {
+        pending -= ble_rpa_match(rpa_data_out[out ^ 1U], hash, count, irk_index, previous_block);
+        if (pending == 0) {
+          previous_block = -1;
+          break;
+        }
       }
 
-      // Start pusher so it is ready to push results when encryption is done
-      RADIOAES->CMD = AES_CMD_STARTPUSHER;
       previous_block = block;
+      out ^= 1U;
     }
   }
 
   CORE_EXIT_CRITICAL();
 
-  // Wait for last data and check it
+  // Wait for last data
   while (RADIOAES->STATUS & AES_STATUS_PUSHERBSY) {
     // Wait for completion
   }
@@ -840,16 +1031,107 @@ int sli_process_ble_rpa(const unsigned char keytable[],
 
   sli_radioaes_release();
 
-  if (result >= 0) {
-    return result;
+  if (previous_block >= 0) {
+    (void) ble_rpa_match(rpa_data_out[out ^ 1U], hash, count, irk_index, previous_block);
   }
 
-  if ((rpa_data_out[3] & 0xFFFFFF00) == __REV(hash) ) {
-    return previous_block;
+  return SL_STATUS_OK;
+}
+
+//
+// Resolve a list of BLE RPAs against a table of device keys.
+//
+sl_status_t sli_process_ble_rpa_batch(const unsigned char keytable[],
+                                      uint32_t            keymask,
+                                      const uint32_t      prand[],
+                                      const uint32_t      hash[],
+                                      size_t              count,
+                                      int                 irk_index[])
+{
+  uint32_t batch_prand[RADIOAES_BLE_RPA_BATCH_SIZE];
+  uint32_t batch_hash[RADIOAES_BLE_RPA_BATCH_SIZE];
+  int batch_index[RADIOAES_BLE_RPA_BATCH_SIZE];
+  size_t batch_pos[RADIOAES_BLE_RPA_BATCH_SIZE];
+  sl_status_t status;
+
+  ble_rpa_cache_check_table(keytable, keymask);
+
+  for (size_t start = 0; start < count; start += RADIOAES_BLE_RPA_BATCH_SIZE) {
+    size_t n = count - start;
+    size_t m = 0;
+    uint32_t verify_mask = 0;
+
+    if (n > RADIOAES_BLE_RPA_BATCH_SIZE) {
+      n = RADIOAES_BLE_RPA_BATCH_SIZE;
+    }
+
+    // Verify cached matches against their cached key only
+    for (size_t i = start; i < start + n; i++) {
+      irk_index[i] = ble_rpa_cache_lookup(prand[i], hash[i]);
+      if (irk_index[i] >= 0) {
+        verify_mask |= 1U << irk_index[i];
+        batch_prand[m] = prand[i];
+        batch_hash[m] = hash[i];
+        batch_pos[m] = i;
+        m++;
+      }
+    }
+
+    if (m > 0) {
+      status = ble_rpa_resolve(keytable, keymask & verify_mask,
+                               batch_prand, batch_hash, m, batch_index);
+      if (status != SL_STATUS_OK) {
+        return status;
+      }
+      for (size_t j = 0; j < m; j++) {
+        irk_index[batch_pos[j]] = (batch_index[j] >= 0) ? batch_index[j] : BLE_RPA_CACHE_MISS;
+      }
+    }
+
+    // Search the whole table for cache misses and stale cache entries
+    m = 0;
+    for (size_t i = start; i < start + n; i++) {
+      if (irk_index[i] == BLE_RPA_CACHE_MISS) {
+        batch_prand[m] = prand[i];
+        batch_hash[m] = hash[i];
+        batch_pos[m] = i;
+        m++;
+      }
+    }
+
+    if (m > 0) {
+      status = ble_rpa_resolve(keytable, keymask,
+                               batch_prand, batch_hash, m, batch_index);
+      if (status != SL_STATUS_OK) {
+        return status;
+      }
+      for (size_t j = 0; j < m; j++) {
+        irk_index[batch_pos[j]] = batch_index[j];
+        ble_rpa_cache_store(batch_prand[j], batch_hash[j], batch_index[j]);
+      }
+    }
+  }
+
+  return SL_STATUS_OK;
+}
+
+//
+// Process a table of BLE RPA device keys and look for a
+// match against the supplied hash. Algorithm is AES-128.
+//
+int sli_process_ble_rpa(const unsigned char keytable[],
+                        uint32_t            keymask,
+                        uint32_t            prand,
+                        uint32_t            hash)
+{
+  int irk_index;
+
+  if (sli_process_ble_rpa_batch(keytable, keymask, &prand, &hash, 1, &irk_index)
+      != SL_STATUS_OK) {
+    return -1;
   }
 
-  // No match
-  return -1;
+  return irk_index;
 }
 
 void sli_aes_seed_mask(void)
@@ -64,6 +64,12 @@
   #define SLI_PSA_DRIVER_FEATURE_TRNG
 #endif
 
+// The entropy pool is opt-in since it keeps unconsumed entropy in RAM.
+#if defined(SL_PSA_TRNG_POOL_ENABLE) \
+  && (defined(SLI_MBEDTLS_DEVICE_HSE) || defined(SLI_MBEDTLS_DEVICE_VSE))
+  #define SLI_PSA_DRIVER_FEATURE_TRNG_POOL
+#endif
+
 #if defined(SLI_MBEDTLS_DEVICE_S1_WITH_TRNG_ERRATA)
   #define SLI_PSA_DRIVER_FEATURE_TRNG_ERRATA_HANDLING
 #endif
@@ -0,0 +1,96 @@
+/***************************************************************************//**
+ * @file
+ * @brief Silicon Labs extensions to the NVM3 based PSA ITS implementation.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+
+#ifndef SLI_PSA_ITS_NVM3_H
+#define SLI_PSA_ITS_NVM3_H
+
+#include "psa/crypto.h"
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// -----------------------------------------------------------------------------
+// Defines
+
+/// NVM3 key reserved for the persisted ITS UID index. The ITS driver owns
+/// the keys just below its file range: SLI_PSA_ITS_NVM3_RANGE_BASE - 1 holds
+/// the driver version flag, and this key holds the index. Other NVM3 users
+/// must not use it, whether SL_PSA_ITS_UID_INDEX_PERSIST is enabled or not.
+#define SLI_PSA_ITS_UID_INDEX_NVM3_ID (SLI_PSA_ITS_NVM3_RANGE_BASE - 2)
+
+// -----------------------------------------------------------------------------
+// Function declarations
+
+/**
+ * @brief
+ *   Write the ITS UID index to NVM3 if it changed since it was last persisted.
+ *
+ * @details
+ *   Only has an effect when SL_PSA_ITS_UID_INDEX_PERSIST is enabled. The
+ *   index is stored in SL_PSA_ITS_UID_INDEX_NVM3_KEY, which defaults to
+ *   SLI_PSA_ITS_UID_INDEX_NVM3_ID. The persisted index is dropped on the
+ *   first change to the set of ITS files and is otherwise only written again
+ *   on the next boot. An index that maps a UID to another UID's file is
+ *   detected on the next access to that UID, and rebuilt.
+ *
+ * @return
+ *   PSA_SUCCESS if the persisted index is up to date,
+ *   PSA_ERROR_INSUFFICIENT_MEMORY or PSA_ERROR_STORAGE_FAILURE otherwise.
+ */
+psa_status_t sli_psa_its_flush_uid_index(void);
+
+#if defined(SLI_PSA_ITS_ENCRYPTED)
+/**
+ * @brief
+ *   Get the hit/miss statistics of the ITS session key cache.
+ *
+ * @param[out] hits       Number of decryptions which used a cached session key. May be NULL.
+ * @param[out] misses     Number of decryptions which had to derive the session key. May be NULL.
+ * @param[out] evictions  Number of cached keys replaced by a key for another UID. May be NULL.
+ */
+void sli_psa_its_get_session_key_cache_stats(uint32_t *hits,
+                                             uint32_t *misses,
+                                             uint32_t *evictions);
+
+/**
+ * @brief
+ *   Zeroize all cached ITS session keys and reset the cache statistics.
+ */
+void sli_psa_its_flush_session_key_cache(void);
+#endif // defined(SLI_PSA_ITS_ENCRYPTED)
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SLI_PSA_ITS_NVM3_H
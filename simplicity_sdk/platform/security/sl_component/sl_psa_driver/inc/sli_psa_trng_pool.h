@@ -0,0 +1,196 @@
+/***************************************************************************//**
+ * @file
+ * @brief Buffered entropy pool in front of the PSA TRNG hook.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+
+#ifndef SLI_PSA_TRNG_POOL_H
+#define SLI_PSA_TRNG_POOL_H
+
+#include "sli_psa_driver_features.h"
+
+#if defined(SLI_PSA_DRIVER_FEATURE_TRNG_POOL)
+
+#include "psa/crypto.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+ * The entropy pool keeps a ring buffer of TRNG output in RAM such that small
+ * requests to mbedtls_psa_external_get_random() (nonces, IVs, backoff values)
+ * don't have to wait for a TRNG/SE round-trip each.
+ *
+ * The pool is refilled in bulk by sli_psa_trng_pool_process_action().
+ * mbedtls_psa_external_get_random() calls it when a small request finds the
+ * pool short. Calling it from an idle hook or a low priority task as well
+ * keeps the pool topped up, so that the refill cost is taken out of the
+ * request path. Requests that are larger than
+ * SL_PSA_TRNG_POOL_MAX_REQUEST_SIZE, or which can't be served because the
+ * refill failed, go straight to the TRNG as before.
+ *
+ * Security properties:
+ * - Every pool byte is handed out at most once. Bytes are wiped from the pool
+ *   as soon as they have been copied to the caller.
+ * - Pooled entropy is held in plain RAM, like the CTR_DRBG state. Code which
+ *   can read RAM can observe entropy that hasn't been consumed yet. Do not
+ *   enable the pool if that is not acceptable.
+ * - Every refill is split in SLI_PSA_TRNG_POOL_HEALTH_BLOCK_SIZE byte blocks
+ *   and run through a continuous repetition test. A block which is equal to
+ *   the previous one discards the whole refill and is counted as a health
+ *   failure. This is in addition to the health tests of the TRNG itself.
+ *   The last block of each refill is kept as the reference for the next one
+ *   and is never handed out.
+ * - Once SL_PSA_TRNG_POOL_MAX_HEALTH_FAILURES consecutive refills have
+ *   failed, the pool is wiped and disabled. All requests then go to the TRNG
+ *   directly and fail if the TRNG fails.
+ */
+
+// -----------------------------------------------------------------------------
+// Configuration
+
+// Size of the entropy pool in bytes
+#if !defined(SL_PSA_TRNG_POOL_SIZE)
+  #define SL_PSA_TRNG_POOL_SIZE 256
+#endif
+
+// Refill is due once fewer bytes than this are left in the pool
+#if !defined(SL_PSA_TRNG_POOL_LOW_WATERMARK)
+  #define SL_PSA_TRNG_POOL_LOW_WATERMARK 64
+#endif
+
+// Largest request served from the pool. Larger ones go to the TRNG.
+#if !defined(SL_PSA_TRNG_POOL_MAX_REQUEST_SIZE)
+  #define SL_PSA_TRNG_POOL_MAX_REQUEST_SIZE 32
+#endif
+
+// Number of bytes fetched from the TRNG per refill step
+#if !defined(SL_PSA_TRNG_POOL_REFILL_CHUNK_SIZE)
+  #define SL_PSA_TRNG_POOL_REFILL_CHUNK_SIZE 64
+#endif
+
+// Consecutive failed refills after which the pool is disabled
+#if !defined(SL_PSA_TRNG_POOL_MAX_HEALTH_FAILURES)
+  #define SL_PSA_TRNG_POOL_MAX_HEALTH_FAILURES 3
+#endif
+
+#define SLI_PSA_TRNG_POOL_HEALTH_BLOCK_SIZE 16
+
+#if (SL_PSA_TRNG_POOL_SIZE & (SL_PSA_TRNG_POOL_SIZE - 1)) != 0
+  #error "SL_PSA_TRNG_POOL_SIZE must be a power of two"
+#endif
+#if SL_PSA_TRNG_POOL_LOW_WATERMARK >= SL_PSA_TRNG_POOL_SIZE
+  #error "SL_PSA_TRNG_POOL_LOW_WATERMARK must be smaller than SL_PSA_TRNG_POOL_SIZE"
+#endif
+#if SL_PSA_TRNG_POOL_MAX_REQUEST_SIZE > SL_PSA_TRNG_POOL_SIZE
+  #error "SL_PSA_TRNG_POOL_MAX_REQUEST_SIZE must not exceed SL_PSA_TRNG_POOL_SIZE"
+#endif
+#if (SL_PSA_TRNG_POOL_REFILL_CHUNK_SIZE % SLI_PSA_TRNG_POOL_HEALTH_BLOCK_SIZE) != 0
+  #error "SL_PSA_TRNG_POOL_REFILL_CHUNK_SIZE must be a multiple of 16"
+#endif
+
+// -----------------------------------------------------------------------------
+// Typedefs
+
+/// Entropy pool statistics and health counters
+typedef struct {
+  uint32_t pool_hits;        ///< Requests served from the pool
+  uint32_t pool_misses;      ///< Small requests that found the pool short
+  uint32_t direct_requests;  ///< Requests too large for the pool
+  uint32_t refills;          ///< Successful refill steps
+  uint32_t trng_failures;    ///< Refill steps where the TRNG returned an error
+  uint32_t health_failures;  ///< Refill steps rejected by the repetition test
+  uint32_t level;            ///< Bytes currently available in the pool
+  bool disabled;             ///< Pool disabled after repeated failures
+} sli_psa_trng_pool_stats_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// -----------------------------------------------------------------------------
+// Function declarations
+
+/**
+ * @brief
+ *   Take bytes from the entropy pool.
+ *
+ * @param[out] output       Buffer receiving the random bytes.
+ * @param[in]  output_size  Number of bytes requested.
+ *
+ * @return
+ *   true if the full request was served from the pool, false if the pool
+ *   doesn't hold enough entropy. Nothing is consumed in the latter case.
+ */
+bool sli_psa_trng_pool_get(uint8_t *output, size_t output_size);
+
+/**
+ * @brief
+ *   Top up the entropy pool by at most one refill chunk.
+ *
+ * @details
+ *   Called by mbedtls_psa_external_get_random() when the pool can't serve a
+ *   request. Calling it from an idle hook or a low priority task whenever
+ *   sli_psa_trng_pool_refill_needed() returns true avoids that wait. A single
+ *   call fetches at most SL_PSA_TRNG_POOL_REFILL_CHUNK_SIZE bytes of pool
+ *   data, so the caller's latency is bounded.
+ *
+ * @return
+ *   PSA_SUCCESS if the pool was refilled or didn't need it,
+ *   PSA_ERROR_HARDWARE_FAILURE if the TRNG failed,
+ *   PSA_ERROR_INSUFFICIENT_ENTROPY if the refill failed the health test,
+ *   PSA_ERROR_BAD_STATE if the pool has been disabled.
+ */
+psa_status_t sli_psa_trng_pool_process_action(void);
+
+/**
+ * @brief
+ *   Check whether the entropy pool is below its low watermark.
+ */
+bool sli_psa_trng_pool_refill_needed(void);
+
+/**
+ * @brief
+ *   Read the entropy pool statistics and health counters.
+ */
+void sli_psa_trng_pool_get_stats(sli_psa_trng_pool_stats_t *stats);
+
+/**
+ * @brief
+ *   Wipe all pooled entropy, e.g. before entering EM4 or handing the RAM to
+ *   another image. The pool is refilled by the next process action.
+ */
+void sli_psa_trng_pool_flush(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SLI_PSA_DRIVER_FEATURE_TRNG_POOL
+
+#endif // SLI_PSA_TRNG_POOL_H
@@ -42,6 +42,7 @@
 
 #include "psa/internal_trusted_storage.h"
 #include "psa/sli_internal_trusted_storage.h"
+#include "sli_psa_its_nvm3.h"
 #include "nvm3_default.h"
 #include "mbedtls/platform.h"
 #include <stdbool.h>
@@ -55,6 +56,8 @@
 #if defined(SLI_PSA_ITS_ENCRYPTED)
   #include "psa_crypto_core.h"
   #include "psa_crypto_driver_wrappers.h"
+  #include "mbedtls/platform_util.h"
+  #include "sl_common.h"
   #if defined(SEMAILBOX_PRESENT)
     #include "psa/crypto_extra.h"
     #include "sl_psa_values.h"
@@ -147,6 +150,159 @@ void sli_its_release_mutex(void)
 #endif
 }
 
+// -------------------------------------
+// Session key cache
+
+#if defined(SLI_PSA_ITS_ENCRYPTED)
+// The session key is derived from CMAC, which means it is equal to the AES block size, i.e. 16 bytes
+#define SESSION_KEY_SIZE  (16)
+// The session key is derived from the 12 byte AES-GCM IV of the ITS file
+#define SESSION_KEY_IV_SIZE (12)
+
+// Number of derived session keys kept in RAM. Each entry saves a key
+// derivation when the corresponding ITS file is read again.
+#if !defined(SL_PSA_ITS_SESSION_KEY_CACHE_SIZE)
+#define SL_PSA_ITS_SESSION_KEY_CACHE_SIZE 4
+#endif
+
+#if SL_PSA_ITS_SESSION_KEY_CACHE_SIZE < 1
+#error "SL_PSA_ITS_SESSION_KEY_CACHE_SIZE must be at least 1"
+#endif
+
+// Optionally place the cached keys in a dedicated (e.g. secure-only or
+// retention-excluded) RAM section.
+#if defined(SL_PSA_ITS_SESSION_KEY_CACHE_SECTION)
+#define SLI_PSA_ITS_SESSION_KEY_CACHE_ATTRIBUTE SL_ATTRIBUTE_SECTION(SL_PSA_ITS_SESSION_KEY_CACHE_SECTION)
+#else
+#define SLI_PSA_ITS_SESSION_KEY_CACHE_ATTRIBUTE
+#endif
+
+typedef struct {
+  bool active;
+  psa_storage_uid_t uid;
+  uint8_t iv[SESSION_KEY_IV_SIZE];
+  uint32_t last_used;
+  uint8_t data[SESSION_KEY_SIZE];
+} session_key_t;
+
+static session_key_t g_cached_session_keys[SL_PSA_ITS_SESSION_KEY_CACHE_SIZE] SLI_PSA_ITS_SESSION_KEY_CACHE_ATTRIBUTE;
+static uint32_t g_session_key_cache_clock = 0;
+static uint32_t g_session_key_cache_hits = 0;
+static uint32_t g_session_key_cache_misses = 0;
+static uint32_t g_session_key_cache_evictions = 0;
+
+static inline void evict_session_key(session_key_t *entry)
+{
+  mbedtls_platform_zeroize(entry, sizeof(*entry));
+}
+
+// Copy the cached session key for the given UID and IV to session_key.
+// Returns false if no such key has been cached.
+static bool lookup_session_key(psa_storage_uid_t uid,
+                               const uint8_t *iv,
+                               uint8_t *session_key)
+{
+  for (size_t i = 0; i < SL_PSA_ITS_SESSION_KEY_CACHE_SIZE; i++) {
+    session_key_t *entry = &g_cached_session_keys[i];
+    if (entry->active
+        && entry->uid == uid
+        && memcmp(entry->iv, iv, sizeof(entry->iv)) == 0) {
+      entry->last_used = ++g_session_key_cache_clock;
+      memcpy(session_key, entry->data, sizeof(entry->data));
+      g_session_key_cache_hits++;
+      return true;
+    }
+  }
+
+  g_session_key_cache_misses++;
+  return false;
+}
+
+// Cache a session key. An older key for the same UID is replaced, otherwise
+// a free entry or the least recently used one is taken.
+static void cache_session_key(uint8_t *session_key,
+                              psa_storage_uid_t uid,
+                              const uint8_t *iv)
+{
+  session_key_t *victim = NULL;
+  uint32_t victim_age = 0;
+
+  for (size_t i = 0; i < SL_PSA_ITS_SESSION_KEY_CACHE_SIZE; i++) {
+    session_key_t *entry = &g_cached_session_keys[i];
+    if (!entry->active || entry->uid == uid) {
+      victim = entry;
+      break;
+    }
+    // Unsigned difference keeps the ordering valid across clock wrap-around
+    uint32_t age = g_session_key_cache_clock - entry->last_used;
+    if (victim == NULL || age > victim_age) {
+      victim = entry;
+      victim_age = age;
+    }
+  }
+
+  if (victim->active && victim->uid != uid) {
+    g_session_key_cache_evictions++;
+  }
+  evict_session_key(victim);
+
+  memcpy(victim->data, session_key, sizeof(victim->data));
+  memcpy(victim->iv, iv, sizeof(victim->iv));
+  victim->uid = uid;
+  victim->last_used = ++g_session_key_cache_clock;
+  victim->active = true;
+}
+
+// Drop the cached session key of an ITS file which no longer exists
+static void invalidate_session_key(psa_storage_uid_t uid)
+{
+  for (size_t i = 0; i < SL_PSA_ITS_SESSION_KEY_CACHE_SIZE; i++) {
+    if (g_cached_session_keys[i].active && g_cached_session_keys[i].uid == uid) {
+      evict_session_key(&g_cached_session_keys[i]);
+    }
+  }
+}
+
+/**
+ * \brief Get the hit/miss statistics of the ITS session key cache.
+ *
+ * \param[out] hits       Number of decryptions which used a cached session key. May be NULL.
+ * \param[out] misses     Number of decryptions which had to derive the session key. May be NULL.
+ * \param[out] evictions  Number of cached keys replaced by a key for another UID. May be NULL.
+ */
+void sli_psa_its_get_session_key_cache_stats(uint32_t *hits,
+                                             uint32_t *misses,
+                                             uint32_t *evictions)
+{
+  sli_its_acquire_mutex();
+  if (hits != NULL) {
+    *hits = g_session_key_cache_hits;
+  }
+  if (misses != NULL) {
+    *misses = g_session_key_cache_misses;
+  }
+  if (evictions != NULL) {
+    *evictions = g_session_key_cache_evictions;
+  }
+  sli_its_release_mutex();
+}
+
+/**
+ * \brief Zeroize all cached ITS session keys and reset the cache statistics.
+ */
+void sli_psa_its_flush_session_key_cache(void)
+{
+  sli_its_acquire_mutex();
+  for (size_t i = 0; i < SL_PSA_ITS_SESSION_KEY_CACHE_SIZE; i++) {
+    evict_session_key(&g_cached_session_keys[i]);
+  }
+  g_session_key_cache_hits = 0;
+  g_session_key_cache_misses = 0;
+  g_session_key_cache_evictions = 0;
+  sli_its_release_mutex();
+}
+#endif // defined(SLI_PSA_ITS_ENCRYPTED)
+
 // -------------------------------------
 // Defines
 
@@ -163,6 +319,53 @@ void sli_its_release_mutex(void)
 
 #define SLI_PSA_ITS_CACHE_INIT_CHUNK_SIZE 16
 
+// Keep a RAM-resident UID -> NVM3 object ID hash index unless disabled. When
+// disabled, only the most recent lookup is cached.
+#if !defined(SL_PSA_ITS_UID_INDEX_ENABLE)
+#define SL_PSA_ITS_UID_INDEX_ENABLE 1
+#endif
+
+// Persist a compact copy of the UID index in NVM3 such that it doesn't have to
+// be rebuilt from the metadata of every ITS file on boot. The copy is written
+// lazily, see sli_psa_its_flush_uid_index().
+#if !defined(SL_PSA_ITS_UID_INDEX_PERSIST)
+#define SL_PSA_ITS_UID_INDEX_PERSIST 0
+#endif
+
+#if SL_PSA_ITS_UID_INDEX_ENABLE
+// Number of hash buckets. Twice the file count keeps the load factor <= 50 %.
+#define SLI_PSA_ITS_UID_INDEX_SIZE        (2 * SL_PSA_ITS_MAX_FILES)
+#define SLI_PSA_ITS_UID_INDEX_EMPTY       (0xFFFFU)
+
+#if SL_PSA_ITS_MAX_FILES >= SLI_PSA_ITS_UID_INDEX_EMPTY
+#error "SL_PSA_ITS_MAX_FILES is too large for the UID index"
+#endif
+
+#if SL_PSA_ITS_UID_INDEX_PERSIST
+// The persisted index is stored in SLI_PSA_ITS_UID_INDEX_NVM3_ID, reserved
+// for it just below the ITS range. It must not be inside the range, since
+// every object in there is treated as an ITS file by the scans and the
+// legacy format upgrade, nor in SLI_PSA_ITS_V2_DRIVER_FLAG_NVM3_ID.
+#if !defined(SL_PSA_ITS_UID_INDEX_NVM3_KEY)
+#define SL_PSA_ITS_UID_INDEX_NVM3_KEY SLI_PSA_ITS_UID_INDEX_NVM3_ID
+#endif
+
+#if ((SL_PSA_ITS_UID_INDEX_NVM3_KEY >= SLI_PSA_ITS_NVM3_RANGE_START) \
+  && (SL_PSA_ITS_UID_INDEX_NVM3_KEY < SLI_PSA_ITS_NVM3_RANGE_START + SLI_PSA_ITS_NVM3_RANGE_SIZE)) \
+  || (SL_PSA_ITS_UID_INDEX_NVM3_KEY == SLI_PSA_ITS_NVM3_RANGE_START - 1)
+#error "SL_PSA_ITS_UID_INDEX_NVM3_KEY must be outside of the ITS NVM3 range and its flag key"
+#endif
+
+#define SLI_PSA_ITS_UID_INDEX_MAGIC       (0x58444955UL) // "UIDX"
+// Each persisted entry is a 16-bit slot offset followed by the 64-bit UID.
+#define SLI_PSA_ITS_UID_INDEX_ENTRY_SIZE  (sizeof(uint16_t) + sizeof(psa_storage_uid_t))
+#endif // SL_PSA_ITS_UID_INDEX_PERSIST
+#else // SL_PSA_ITS_UID_INDEX_ENABLE
+#if SL_PSA_ITS_UID_INDEX_PERSIST
+#error "SL_PSA_ITS_UID_INDEX_PERSIST requires SL_PSA_ITS_UID_INDEX_ENABLE"
+#endif
+#endif // SL_PSA_ITS_UID_INDEX_ENABLE
+
 // Enable backwards-compatibility with keys stored with a v1 header unless disabled.
 #if !defined(SL_PSA_ITS_REMOVE_V1_HEADER_SUPPORT)
 #define SLI_PSA_ITS_SUPPORT_V1_FORMAT
@@ -192,6 +395,20 @@ void sli_its_release_mutex(void)
 SLI_STATIC bool nvm3_uid_set_cache_initialized = false;
 SLI_STATIC uint32_t nvm3_uid_set_cache[(SL_PSA_ITS_MAX_FILES + 31) / 32] = { 0 };
 
+#if SL_PSA_ITS_UID_INDEX_ENABLE
+// UID of the ITS file stored in each slot of the NVM3 range. Only valid for
+// slots which are marked in nvm3_uid_set_cache and referenced by the index.
+SLI_STATIC psa_storage_uid_t nvm3_uid_index_uids[SL_PSA_ITS_MAX_FILES] = { 0 };
+// Open-addressing (linear probing) hash table of slot offsets, keyed on UID.
+SLI_STATIC uint16_t nvm3_uid_index_buckets[SLI_PSA_ITS_UID_INDEX_SIZE];
+// Set when every ITS file in NVM3 is referenced by the index, meaning that an
+// index miss is authoritative and no flash scan is needed.
+SLI_STATIC bool nvm3_uid_index_complete = false;
+#if SL_PSA_ITS_UID_INDEX_PERSIST
+// Set when the persisted copy of the index matches the RAM index.
+static bool nvm3_uid_index_persisted = false;
+#endif
+#else // SL_PSA_ITS_UID_INDEX_ENABLE
 typedef struct {
   psa_storage_uid_t uid;
   nvm3_ObjectKey_t object_id;
@@ -201,12 +418,11 @@ typedef struct {
 static previous_lookup_t previous_lookup = {
   0, 0, false
 };
+#endif // SL_PSA_ITS_UID_INDEX_ENABLE
 
 #if defined(SLI_PSA_ITS_ENCRYPTED)
 // The root key is an AES-256 key, and is therefore 32 bytes.
 #define ROOT_KEY_SIZE     (32)
-// The session key is derived from CMAC, which means it is equal to the AES block size, i.e. 16 bytes
-#define SESSION_KEY_SIZE  (16)
 
 #if !defined(SEMAILBOX_PRESENT)
 typedef struct {
@@ -219,23 +435,21 @@ static root_key_t g_root_key = {
   .data = { 0 },
 };
 #endif // !defined(SEMAILBOX_PRESENT)
-
-typedef struct {
-  bool active;
-  psa_storage_uid_t uid;
-  uint8_t data[SESSION_KEY_SIZE];
-} session_key_t;
-
-static session_key_t g_cached_session_key = {
-  .active = false,
-  .uid = 0,
-  .data = { 0 },
-};
 #endif // defined(SLI_PSA_ITS_ENCRYPTED)
 
 // -------------------------------------
 // Structs
 
+#if SL_PSA_ITS_UID_INDEX_PERSIST
+// Header of the persisted UID index object. It is followed by `count` packed
+// entries of SLI_PSA_ITS_UID_INDEX_ENTRY_SIZE bytes, sorted on slot offset.
+typedef struct {
+  uint32_t magic;
+  uint16_t max_files;
+  uint16_t count;
+} sli_its_uid_index_header_t;
+#endif // SL_PSA_ITS_UID_INDEX_PERSIST
+
 #if defined(SLI_PSA_ITS_SUPPORT_V1_FORMAT)
 typedef struct {
   uint32_t magic;
@@ -265,6 +479,15 @@ typedef struct {
 
 static nvm3_ObjectKey_t get_nvm3_id(psa_storage_uid_t uid, bool find_empty_slot);
 static nvm3_ObjectKey_t prepare_its_get_nvm3_id(psa_storage_uid_t uid);
+static Ecode_t get_file_metadata(nvm3_ObjectKey_t key,
+                                 sli_its_file_meta_v2_t* metadata,
+                                 size_t* its_file_offset,
+                                 size_t* its_file_size);
+static Ecode_t get_uid_file_metadata(psa_storage_uid_t uid,
+                                     nvm3_ObjectKey_t* key,
+                                     sli_its_file_meta_v2_t* metadata,
+                                     size_t* its_file_offset,
+                                     size_t* its_file_size);
 
 #if defined(TFM_CONFIG_SL_SECURE_LIBRARY)
 static inline bool object_lives_in_s(const void *object, size_t object_size);
@@ -339,6 +562,350 @@ static inline bool cache_lookup(nvm3_ObjectKey_t key)
   return (bool)((nvm3_uid_set_cache[bin] >> offset) & 0x1);
 }
 
+#if SL_PSA_ITS_UID_INDEX_ENABLE
+static inline uint32_t uid_index_hash(psa_storage_uid_t uid)
+{
+  // Fold the 64-bit UID and spread it with a multiplicative hash
+  uint32_t hash = (uint32_t)uid ^ (uint32_t)(uid >> 32);
+  hash *= 0x9E3779B1UL;
+  hash ^= hash >> 16;
+  return hash % SLI_PSA_ITS_UID_INDEX_SIZE;
+}
+
+static inline uint32_t uid_index_next(uint32_t bucket)
+{
+  return (bucket + 1 == SLI_PSA_ITS_UID_INDEX_SIZE) ? 0 : bucket + 1;
+}
+
+// Return the bucket holding uid, or SLI_PSA_ITS_UID_INDEX_SIZE if not indexed
+static uint32_t uid_index_find_bucket(psa_storage_uid_t uid)
+{
+  uint32_t bucket = uid_index_hash(uid);
+
+  for (size_t probes = 0; probes < SLI_PSA_ITS_UID_INDEX_SIZE; probes++) {
+    uint16_t slot = nvm3_uid_index_buckets[bucket];
+    if (slot == SLI_PSA_ITS_UID_INDEX_EMPTY) {
+      break;
+    }
+    if (nvm3_uid_index_uids[slot] == uid) {
+      return bucket;
+    }
+    bucket = uid_index_next(bucket);
+  }
+
+  return SLI_PSA_ITS_UID_INDEX_SIZE;
+}
+
+static void uid_index_reset(void)
+{
+  memset(nvm3_uid_index_buckets, 0xFF, sizeof(nvm3_uid_index_buckets));
+  nvm3_uid_index_complete = false;
+}
+
+static nvm3_ObjectKey_t uid_index_lookup(psa_storage_uid_t uid)
+{
+  uint32_t bucket = uid_index_find_bucket(uid);
+  if (bucket == SLI_PSA_ITS_UID_INDEX_SIZE) {
+    return SLI_PSA_ITS_NVM3_RANGE_END + 1U;
+  }
+  return nvm3_uid_index_buckets[bucket] + SLI_PSA_ITS_NVM3_RANGE_START;
+}
+
+static void uid_index_insert(psa_storage_uid_t uid, nvm3_ObjectKey_t object_id)
+{
+  uint16_t slot = (uint16_t)(object_id - SLI_PSA_ITS_NVM3_RANGE_START);
+  uint32_t bucket = uid_index_find_bucket(uid);
+
+  if (bucket == SLI_PSA_ITS_UID_INDEX_SIZE) {
+    // The table holds at most SL_PSA_ITS_MAX_FILES entries in twice as many
+    // buckets, so an empty bucket is always found.
+    bucket = uid_index_hash(uid);
+    while (nvm3_uid_index_buckets[bucket] != SLI_PSA_ITS_UID_INDEX_EMPTY) {
+      bucket = uid_index_next(bucket);
+    }
+  }
+
+  nvm3_uid_index_uids[slot] = uid;
+  nvm3_uid_index_buckets[bucket] = slot;
+}
+
+static void uid_index_remove(psa_storage_uid_t uid)
+{
+  uint32_t hole = uid_index_find_bucket(uid);
+  if (hole == SLI_PSA_ITS_UID_INDEX_SIZE) {
+    return;
+  }
+
+  // Backward-shift deletion: move later entries of the probe sequence into
+  // the hole when their home bucket doesn't lie between the hole and them.
+  uint32_t bucket = hole;
+  for (;;) {
+    bucket = uid_index_next(bucket);
+    uint16_t slot = nvm3_uid_index_buckets[bucket];
+    if (slot == SLI_PSA_ITS_UID_INDEX_EMPTY) {
+      break;
+    }
+    uint32_t home = uid_index_hash(nvm3_uid_index_uids[slot]);
+    bool stays = (hole <= bucket)
+                 ? (hole < home && home <= bucket)
+                 : (hole < home || home <= bucket);
+    if (!stays) {
+      nvm3_uid_index_buckets[hole] = slot;
+      hole = bucket;
+    }
+  }
+  nvm3_uid_index_buckets[hole] = SLI_PSA_ITS_UID_INDEX_EMPTY;
+}
+
+static void uid_index_rename(psa_storage_uid_t old_uid, psa_storage_uid_t new_uid)
+{
+  nvm3_ObjectKey_t object_id = uid_index_lookup(old_uid);
+  if (object_id > SLI_PSA_ITS_NVM3_RANGE_END) {
+    return;
+  }
+  uid_index_remove(old_uid);
+  uid_index_insert(new_uid, object_id);
+}
+
+static inline bool uid_index_is_complete(void)
+{
+  return nvm3_uid_index_complete;
+}
+
+// Read the metadata of every ITS file once and index it. Objects without a
+// valid header are removed, same as when they are encountered during a scan.
+static void uid_index_build(void)
+{
+  Ecode_t status;
+  sli_its_file_meta_v2_t key_meta;
+  bool complete = true;
+
+  uid_index_reset();
+
+  for (size_t i = 0; i < SL_PSA_ITS_MAX_FILES; i++) {
+    nvm3_ObjectKey_t object_id = i + SLI_PSA_ITS_NVM3_RANGE_START;
+    if (!cache_lookup(object_id)) {
+      continue;
+    }
+
+    status = get_file_metadata(object_id, &key_meta, NULL, NULL);
+
+    if (status == ECODE_NVM3_OK
+        || status == SLI_PSA_ITS_ECODE_NEEDS_UPGRADE) {
+      uid_index_insert(key_meta.uid, object_id);
+    } else if ((status == SLI_PSA_ITS_ECODE_NO_VALID_HEADER
+                || status == ECODE_NVM3_ERR_READ_DATA_SIZE)
+               && nvm3_deleteObject(nvm3_defaultHandle, object_id) == ECODE_NVM3_OK) {
+      cache_clear(object_id);
+    } else {
+      // Leave the object for the fallback scan in get_nvm3_id()
+      complete = false;
+    }
+  }
+
+  nvm3_uid_index_complete = complete;
+}
+
+#if SL_PSA_ITS_UID_INDEX_PERSIST
+static size_t uid_index_count_files(void)
+{
+  size_t count = 0;
+  for (size_t i = 0; i < SL_PSA_ITS_MAX_FILES; i++) {
+    if (cache_lookup(i + SLI_PSA_ITS_NVM3_RANGE_START)) {
+      count++;
+    }
+  }
+  return count;
+}
+
+// Try to restore the index from its persisted copy. The copy is only accepted
+// if it references exactly the set of objects enumerated from NVM3.
+static bool uid_index_load(void)
+{
+  uint32_t obj_type;
+  size_t object_size = 0;
+  size_t count = uid_index_count_files();
+  bool loaded = false;
+
+  Ecode_t status = nvm3_getObjectInfo(nvm3_defaultHandle,
+                                      SL_PSA_ITS_UID_INDEX_NVM3_KEY,
+                                      &obj_type,
+                                      &object_size);
+  if (status != ECODE_NVM3_OK
+      || object_size != sizeof(sli_its_uid_index_header_t) + count * SLI_PSA_ITS_UID_INDEX_ENTRY_SIZE) {
+    return false;
+  }
+
+  uint8_t *buffer = mbedtls_calloc(1, object_size);
+  if (buffer == NULL) {
+    return false;
+  }
+
+  status = nvm3_readData(nvm3_defaultHandle,
+                         SL_PSA_ITS_UID_INDEX_NVM3_KEY,
+                         buffer,
+                         object_size);
+  if (status != ECODE_NVM3_OK) {
+    goto exit;
+  }
+
+  sli_its_uid_index_header_t header;
+  memcpy(&header, buffer, sizeof(header));
+  if (header.magic != SLI_PSA_ITS_UID_INDEX_MAGIC
+      || header.max_files != SL_PSA_ITS_MAX_FILES
+      || header.count != count) {
+    goto exit;
+  }
+
+  uid_index_reset();
+
+  const uint8_t *entry = buffer + sizeof(header);
+  int32_t previous_slot = -1;
+  for (size_t i = 0; i < count; i++) {
+    uint16_t slot;
+    psa_storage_uid_t uid;
+    memcpy(&slot, entry, sizeof(slot));
+    memcpy(&uid, entry + sizeof(slot), sizeof(uid));
+    entry += SLI_PSA_ITS_UID_INDEX_ENTRY_SIZE;
+
+    // Entries are strictly ordered on slot, which rules out duplicates
+    if ((int32_t)slot <= previous_slot
+        || slot >= SL_PSA_ITS_MAX_FILES
+        || !cache_lookup(slot + SLI_PSA_ITS_NVM3_RANGE_START)) {
+      uid_index_reset();
+      goto exit;
+    }
+    previous_slot = slot;
+
+    uid_index_insert(uid, slot + SLI_PSA_ITS_NVM3_RANGE_START);
+  }
+
+  nvm3_uid_index_complete = true;
+  nvm3_uid_index_persisted = true;
+  loaded = true;
+
+  exit:
+  mbedtls_free(buffer);
+  return loaded;
+}
+
+// Write the RAM index to NVM3 unless the persisted copy is up to date. Only a
+// complete index is persisted.
+static psa_status_t uid_index_store(void)
+{
+  if (!nvm3_uid_index_complete || nvm3_uid_index_persisted) {
+    return PSA_SUCCESS;
+  }
+
+  size_t count = uid_index_count_files();
+  size_t object_size = sizeof(sli_its_uid_index_header_t) + count * SLI_PSA_ITS_UID_INDEX_ENTRY_SIZE;
+  uint8_t *buffer = mbedtls_calloc(1, object_size);
+  if (buffer == NULL) {
+    return PSA_ERROR_INSUFFICIENT_MEMORY;
+  }
+
+  sli_its_uid_index_header_t header = {
+    .magic = SLI_PSA_ITS_UID_INDEX_MAGIC,
+    .max_files = SL_PSA_ITS_MAX_FILES,
+    .count = (uint16_t)count,
+  };
+  memcpy(buffer, &header, sizeof(header));
+
+  uint8_t *entry = buffer + sizeof(header);
+  for (uint16_t slot = 0; slot < SL_PSA_ITS_MAX_FILES; slot++) {
+    if (!cache_lookup(slot + SLI_PSA_ITS_NVM3_RANGE_START)) {
+      continue;
+    }
+    memcpy(entry, &slot, sizeof(slot));
+    memcpy(entry + sizeof(slot), &nvm3_uid_index_uids[slot], sizeof(psa_storage_uid_t));
+    entry += SLI_PSA_ITS_UID_INDEX_ENTRY_SIZE;
+  }
+
+  psa_status_t psa_status = PSA_ERROR_STORAGE_FAILURE;
+  if (nvm3_writeData(nvm3_defaultHandle,
+                     SL_PSA_ITS_UID_INDEX_NVM3_KEY,
+                     buffer,
+                     object_size) == ECODE_NVM3_OK) {
+    nvm3_uid_index_persisted = true;
+    psa_status = PSA_SUCCESS;
+  }
+
+  mbedtls_free(buffer);
+  return psa_status;
+}
+
+// Drop the persisted index before the set of ITS files is modified, such that
+// a power loss in the middle of the update can't leave a stale index behind.
+// Only the first update after the index was persisted costs a delete. The
+// index is written again by the next boot or sli_psa_its_flush_uid_index().
+static void uid_index_begin_update(void)
+{
+  if (nvm3_uid_index_persisted) {
+    (void)nvm3_deleteObject(nvm3_defaultHandle, SL_PSA_ITS_UID_INDEX_NVM3_KEY);
+    nvm3_uid_index_persisted = false;
+  }
+}
+#else // SL_PSA_ITS_UID_INDEX_PERSIST
+static inline void uid_index_begin_update(void)
+{
+}
+#endif // SL_PSA_ITS_UID_INDEX_PERSIST
+
+// The index mapped a UID to a file holding another UID, e.g. a persisted
+// index left stale by a reset. Drop it and rebuild it from the file metadata.
+static void uid_index_invalidate(void)
+{
+  uid_index_begin_update();
+  uid_index_build();
+}
+
+#else // SL_PSA_ITS_UID_INDEX_ENABLE
+
+// Without the index, only remember the most recent lookup
+static inline nvm3_ObjectKey_t uid_index_lookup(psa_storage_uid_t uid)
+{
+  if (previous_lookup.set && previous_lookup.uid == uid) {
+    return previous_lookup.object_id;
+  }
+  return SLI_PSA_ITS_NVM3_RANGE_END + 1U;
+}
+
+static inline void uid_index_insert(psa_storage_uid_t uid, nvm3_ObjectKey_t object_id)
+{
+  previous_lookup.set = true;
+  previous_lookup.object_id = object_id;
+  previous_lookup.uid = uid;
+}
+
+static inline void uid_index_remove(psa_storage_uid_t uid)
+{
+  if (previous_lookup.set && previous_lookup.uid == uid) {
+    previous_lookup.set = false;
+  }
+}
+
+static inline void uid_index_rename(psa_storage_uid_t old_uid, psa_storage_uid_t new_uid)
+{
+  if (previous_lookup.set && previous_lookup.uid == old_uid) {
+    previous_lookup.uid = new_uid;
+  }
+}
+
+static inline bool uid_index_is_complete(void)
+{
+  return false;
+}
+
+static inline void uid_index_begin_update(void)
+{
+}
+
+static inline void uid_index_invalidate(void)
+{
+  previous_lookup.set = false;
+}
+#endif // SL_PSA_ITS_UID_INDEX_ENABLE
+
 static void init_cache(void)
 {
   size_t num_keys_referenced_by_nvm3;
@@ -363,6 +930,15 @@ static void init_cache(void)
     }
   }
 
+#if SL_PSA_ITS_UID_INDEX_PERSIST
+  if (!uid_index_load()) {
+    uid_index_build();
+    (void)uid_index_store();
+  }
+#elif SL_PSA_ITS_UID_INDEX_ENABLE
+  uid_index_build();
+#endif
+
   nvm3_uid_set_cache_initialized = true;
 }
 
@@ -455,10 +1031,10 @@ static nvm3_ObjectKey_t get_nvm3_id(psa_storage_uid_t uid, bool find_empty_slot)
       }
     }
   } else {
-    if (previous_lookup.set) {
-      if (previous_lookup.uid == uid) {
-        return previous_lookup.object_id;
-      }
+    nvm3_ObjectKey_t indexed_object_id = uid_index_lookup(uid);
+    if (indexed_object_id <= SLI_PSA_ITS_NVM3_RANGE_END
+        || uid_index_is_complete()) {
+      return indexed_object_id;
     }
 
     for (size_t i = 0; i < SL_PSA_ITS_MAX_FILES; i++) {
@@ -472,9 +1048,7 @@ static nvm3_ObjectKey_t get_nvm3_id(psa_storage_uid_t uid, bool find_empty_slot)
       if (status == ECODE_NVM3_OK
           || status == SLI_PSA_ITS_ECODE_NEEDS_UPGRADE) {
         if (key_meta.uid == uid) {
-          previous_lookup.set = true;
-          previous_lookup.object_id = object_id;
-          previous_lookup.uid = uid;
+          uid_index_insert(uid, object_id);
 
           return object_id;
         } else {
@@ -498,6 +1072,32 @@ static nvm3_ObjectKey_t get_nvm3_id(psa_storage_uid_t uid, bool find_empty_slot)
   return SLI_PSA_ITS_NVM3_RANGE_END + 1U;
 }
 
+// Read the metadata of the file *key that the index maps uid to, and check
+// that the file holds uid. If it doesn't, the index is rebuilt and uid looked
+// up again. *key is set past SLI_PSA_ITS_NVM3_RANGE_END, and
+// SLI_PSA_ITS_ECODE_NO_VALID_HEADER returned, if uid doesn't exist after all.
+static Ecode_t get_uid_file_metadata(psa_storage_uid_t uid,
+                                     nvm3_ObjectKey_t* key,
+                                     sli_its_file_meta_v2_t* metadata,
+                                     size_t* its_file_offset,
+                                     size_t* its_file_size)
+{
+  Ecode_t status = get_file_metadata(*key, metadata, its_file_offset, its_file_size);
+
+  if ((status == ECODE_NVM3_OK
+       || status == SLI_PSA_ITS_ECODE_NEEDS_UPGRADE)
+      && metadata->uid != uid) {
+    uid_index_invalidate();
+    *key = get_nvm3_id(uid, false);
+    if (*key > SLI_PSA_ITS_NVM3_RANGE_END) {
+      return SLI_PSA_ITS_ECODE_NO_VALID_HEADER;
+    }
+    status = get_file_metadata(*key, metadata, its_file_offset, its_file_size);
+  }
+
+  return status;
+}
+
 // Perform NVM3 open and fill the look-up table.
 // Try to find the mapping NVM3 object ID with PSA ITS UID.
 static nvm3_ObjectKey_t prepare_its_get_nvm3_id(psa_storage_uid_t uid)
@@ -520,14 +1120,6 @@ static nvm3_ObjectKey_t prepare_its_get_nvm3_id(psa_storage_uid_t uid)
 }
 
 #if defined(SLI_PSA_ITS_ENCRYPTED)
-static inline void cache_session_key(uint8_t *session_key, psa_storage_uid_t uid)
-{
-  // Cache the session key
-  memcpy(g_cached_session_key.data, session_key, sizeof(g_cached_session_key.data));
-  g_cached_session_key.uid = uid;
-  g_cached_session_key.active = true;
-}
-
 /**
  * \brief Derive a session key for ITS file encryption from the initialized root key and provided IV.
  *
@@ -672,7 +1264,7 @@ static psa_status_t encrypt_its_file(sli_its_file_meta_v2_t *metadata,
     return psa_status;
   }
 
-  cache_session_key(session_key, metadata->uid);
+  cache_session_key(session_key, metadata->uid, blob->iv);
 
   // Retrieve data to be encrypted
   if (plaintext_size != 0U) {
@@ -750,15 +1342,12 @@ static psa_status_t decrypt_its_file(sli_its_file_meta_v2_t *metadata,
   psa_status_t psa_status = PSA_ERROR_CORRUPTION_DETECTED;
   uint8_t session_key[SESSION_KEY_SIZE];
 
-  if (g_cached_session_key.active && g_cached_session_key.uid == metadata->uid) {
-    // Use cached session key if it's already set and UID matches
-    memcpy(session_key, g_cached_session_key.data, sizeof(session_key));
-  } else {
+  if (!lookup_session_key(metadata->uid, blob->iv, session_key)) {
     psa_status = derive_session_key(blob->iv, AES_IV_GCM_SIZE, session_key, sizeof(session_key));
     if (psa_status != PSA_SUCCESS) {
       return psa_status;
     }
-    cache_session_key(session_key, metadata->uid);
+    cache_session_key(session_key, metadata->uid, blob->iv);
   }
 
   // Decrypt and authenticate blob
@@ -934,6 +1523,7 @@ psa_status_t psa_its_set(psa_storage_uid_t uid,
   Ecode_t status;
   psa_status_t ret = PSA_SUCCESS;
   sli_its_file_meta_v2_t* its_file_meta;
+  bool new_file = false;
 
 #if defined(SLI_PSA_ITS_ENCRYPTED)
   psa_storage_uid_t authenticated_uid;
@@ -954,6 +1544,12 @@ psa_status_t psa_its_set(psa_storage_uid_t uid,
   memset(its_file_buffer, 0, its_file_size + sizeof(sli_its_file_meta_v2_t));
 
   its_file_meta = (sli_its_file_meta_v2_t *)its_file_buffer;
+  status = ECODE_NVM3_OK;
+  if (nvm3_object_id <= SLI_PSA_ITS_NVM3_RANGE_END) {
+    // ITS UID was found. Read ITS meta data, which also checks the index.
+    status = get_uid_file_metadata(uid, &nvm3_object_id, its_file_meta, NULL, NULL);
+  }
+
   if (nvm3_object_id > SLI_PSA_ITS_NVM3_RANGE_END) {
     // ITS UID was not found. Request a new.
     nvm3_object_id = get_nvm3_id(0ULL, true);
@@ -961,13 +1557,12 @@ psa_status_t psa_its_set(psa_storage_uid_t uid,
       // The storage is full, or an error was returned during cleanup.
       ret = PSA_ERROR_INSUFFICIENT_STORAGE;
     } else {
+      memset(its_file_meta, 0, sizeof(*its_file_meta));
       its_file_meta->uid = uid;
       its_file_meta->magic = SLI_PSA_ITS_META_MAGIC_V2;
+      new_file = true;
     }
   } else {
-    // ITS UID was found. Read ITS meta data.
-    status = get_file_metadata(nvm3_object_id, its_file_meta, NULL, NULL);
-
     if (status != ECODE_NVM3_OK
         && status != SLI_PSA_ITS_ECODE_NEEDS_UPGRADE) {
       ret = PSA_ERROR_STORAGE_FAILURE;
@@ -1027,6 +1622,10 @@ psa_status_t psa_its_set(psa_storage_uid_t uid,
   }
 #endif
 
+  if (new_file) {
+    uid_index_begin_update();
+  }
+
   status = nvm3_writeData(nvm3_defaultHandle,
                           nvm3_object_id,
                           its_file_buffer, its_file_size + sizeof(sli_its_file_meta_v2_t));
@@ -1035,6 +1634,9 @@ psa_status_t psa_its_set(psa_storage_uid_t uid,
     // Power-loss might occur, however upon boot, the look-up table will be
     // re-filled as long as the data has been successfully written to NVM3.
     cache_set(nvm3_object_id);
+    if (new_file) {
+      uid_index_insert(uid, nvm3_object_id);
+    }
   } else {
     ret = PSA_ERROR_STORAGE_FAILURE;
   }
@@ -1108,7 +1710,7 @@ psa_status_t psa_its_get(psa_storage_uid_t uid,
     goto exit;
   }
 
-  status = get_file_metadata(nvm3_object_id, &its_file_meta, &its_file_offset, &its_file_size);
+  status = get_uid_file_metadata(uid, &nvm3_object_id, &its_file_meta, &its_file_offset, &its_file_size);
   if (status == SLI_PSA_ITS_ECODE_NO_VALID_HEADER) {
     ret = PSA_ERROR_DOES_NOT_EXIST;
     goto exit;
@@ -1265,7 +1867,7 @@ psa_status_t psa_its_get_info(psa_storage_uid_t uid,
     goto exit;
   }
 
-  status = get_file_metadata(nvm3_object_id, &its_file_meta, &its_file_offset, &its_file_size);
+  status = get_uid_file_metadata(uid, &nvm3_object_id, &its_file_meta, &its_file_offset, &its_file_size);
   if (status == SLI_PSA_ITS_ECODE_NO_VALID_HEADER) {
     psa_status = PSA_ERROR_DOES_NOT_EXIST;
     goto exit;
@@ -1332,7 +1934,7 @@ psa_status_t psa_its_remove(psa_storage_uid_t uid)
     goto exit;
   }
 
-  status = get_file_metadata(nvm3_object_id, &its_file_meta, &its_file_offset, &its_file_size);
+  status = get_uid_file_metadata(uid, &nvm3_object_id, &its_file_meta, &its_file_offset, &its_file_size);
   if (status == SLI_PSA_ITS_ECODE_NO_VALID_HEADER) {
     psa_status = PSA_ERROR_DOES_NOT_EXIST;
     goto exit;
@@ -1366,15 +1968,18 @@ psa_status_t psa_its_remove(psa_storage_uid_t uid)
   }
 #endif
 
+  uid_index_begin_update();
+
   status = nvm3_deleteObject(nvm3_defaultHandle, nvm3_object_id);
 
   if (status == ECODE_NVM3_OK) {
     // Power-loss might occur, however upon boot, the look-up table will be
     // re-filled as long as the data has been successfully written to NVM3.
-    if (previous_lookup.set && previous_lookup.uid == uid) {
-      previous_lookup.set = false;
-    }
+    uid_index_remove(uid);
     cache_clear(nvm3_object_id);
+#if defined(SLI_PSA_ITS_ENCRYPTED)
+    invalidate_session_key(uid);
+#endif
 
     psa_status = PSA_SUCCESS;
   } else {
@@ -1412,7 +2017,8 @@ psa_status_t sli_psa_its_change_key_id(mbedtls_svc_key_id_t old_id,
   psa_storage_uid_t old_uid = psa_its_identifier_of_slot(old_id);
   psa_storage_uid_t new_uid = psa_its_identifier_of_slot(new_id);
   Ecode_t status;
-  uint32_t obj_type;
+  sli_its_file_meta_v2_t its_file_meta = { 0 };
+  size_t its_file_offset = 0;
   size_t its_file_size = 0;
   psa_status_t psa_status = PSA_ERROR_CORRUPTION_DETECTED;
   int8_t *its_file_buffer = NULL;
@@ -1434,15 +2040,18 @@ psa_status_t sli_psa_its_change_key_id(mbedtls_svc_key_id_t old_id,
     goto exit;
   }
 
-  // Get total length to allocate
-  status = nvm3_getObjectInfo(nvm3_defaultHandle,
-                              nvm3_object_id,
-                              &obj_type,
-                              &its_file_size);
-  if (status != ECODE_NVM3_OK) {
+  // Check the index and get total length to allocate
+  status = get_uid_file_metadata(old_uid, &nvm3_object_id, &its_file_meta, &its_file_offset, &its_file_size);
+  if (status == SLI_PSA_ITS_ECODE_NO_VALID_HEADER) {
+    psa_status = PSA_ERROR_DOES_NOT_EXIST;
+    goto exit;
+  }
+  if (status != ECODE_NVM3_OK
+      && status != SLI_PSA_ITS_ECODE_NEEDS_UPGRADE) {
     psa_status = PSA_ERROR_STORAGE_FAILURE;
     goto exit;
   }
+  its_file_size += its_file_offset;
 
   // Allocate temporary buffer and cast it to the metadata format
   its_file_buffer = mbedtls_calloc(1, its_file_size);
@@ -1526,24 +2135,28 @@ psa_status_t sli_psa_its_change_key_id(mbedtls_svc_key_id_t old_id,
   }
 #endif
 
+  uid_index_begin_update();
+
   // Overwrite the NVM3 token with the changed buffer
   status = nvm3_writeData(nvm3_defaultHandle,
                           nvm3_object_id,
                           its_file_buffer,
                           its_file_size);
   if (status == ECODE_NVM3_OK) {
-    // Update last lookup and report success
-    if (previous_lookup.set) {
-      if (previous_lookup.uid == old_uid) {
-        previous_lookup.uid = new_uid;
-      }
-    }
+    // Update the UID index and report success
+    uid_index_rename(old_uid, new_uid);
     psa_status = PSA_SUCCESS;
   } else {
     psa_status = PSA_ERROR_STORAGE_FAILURE;
   }
 
   exit:
+#if defined(SLI_PSA_ITS_ENCRYPTED)
+  // The session key cached for the old UID is stale once the file has moved.
+  // If the move failed, drop the key cached while re-encrypting the file for
+  // the new UID instead.
+  invalidate_session_key(psa_status == PSA_SUCCESS ? old_uid : new_uid);
+#endif
   if (its_file_buffer != NULL) {
     // Clear and free key buffer before return.
     memset(its_file_buffer, 0, its_file_size);
@@ -1553,6 +2166,35 @@ psa_status_t sli_psa_its_change_key_id(mbedtls_svc_key_id_t old_id,
   return psa_status;
 }
 
+/**
+ * \brief Write the UID index to NVM3 if it changed since it was last persisted.
+ *
+ * The persisted copy of the index is dropped on the first change to the set
+ * of ITS files and only written again on the next boot or by this function.
+ * Call it e.g. before a planned reset so that the next boot can skip the scan.
+ *
+ * \retval PSA_SUCCESS                    The persisted index is up to date, or
+ *                                        SL_PSA_ITS_UID_INDEX_PERSIST is disabled.
+ * \retval PSA_ERROR_INSUFFICIENT_MEMORY  No memory to serialize the index.
+ * \retval PSA_ERROR_STORAGE_FAILURE      The index could not be written.
+ */
+psa_status_t sli_psa_its_flush_uid_index(void)
+{
+#if SL_PSA_ITS_UID_INDEX_PERSIST
+  psa_status_t psa_status = PSA_SUCCESS;
+
+  sli_its_acquire_mutex();
+  if (nvm3_uid_set_cache_initialized) {
+    psa_status = uid_index_store();
+  }
+  sli_its_release_mutex();
+
+  return psa_status;
+#else
+  return PSA_SUCCESS;
+#endif
+}
+
 /**
  * \brief Check if the ITS encryption is enabled
  */
@@ -1634,8 +2276,6 @@ SLI_STATIC uint32_t its_driver_version = SLI_PSA_ITS_NOT_CHECKED;
 #if defined(SLI_PSA_ITS_ENCRYPTED)
 // The root key is an AES-256 key, and is therefore 32 bytes.
 #define ROOT_KEY_SIZE     (32)
-// The session key is derived from CMAC, which means it is equal to the AES block size, i.e. 16 bytes
-#define SESSION_KEY_SIZE  (16)
 
 #if !defined(SEMAILBOX_PRESENT)
 typedef struct {
@@ -1648,18 +2288,6 @@ static root_key_t g_root_key = {
   .data = { 0 },
 };
 #endif // !defined(SEMAILBOX_PRESENT)
-
-typedef struct {
-  bool active;
-  psa_storage_uid_t uid;
-  uint8_t data[SESSION_KEY_SIZE];
-} session_key_t;
-
-static session_key_t g_cached_session_key = {
-  .active = false,
-  .uid = 0,
-  .data = { 0 },
-};
 #endif // defined(SLI_PSA_ITS_ENCRYPTED)
 
 // -------------------------------------
@@ -2429,14 +3057,6 @@ static psa_status_t find_nvm3_id(psa_storage_uid_t uid,
 }
 
 #if defined(SLI_PSA_ITS_ENCRYPTED)
-static inline void cache_session_key(uint8_t *session_key, psa_storage_uid_t uid)
-{
-  // Cache the session key
-  memcpy(g_cached_session_key.data, session_key, sizeof(g_cached_session_key.data));
-  g_cached_session_key.uid = uid;
-  g_cached_session_key.active = true;
-}
-
 /**
  * \brief Derive a session key for ITS file encryption from the initialized root key and provided IV.
  *
@@ -2581,7 +3201,7 @@ psa_status_t sli_encrypt_its_file(sli_its_file_meta_v2_t *metadata,
     return psa_status;
   }
 
-  cache_session_key(session_key, metadata->uid);
+  cache_session_key(session_key, metadata->uid, blob->iv);
 
   // Retrieve data to be encrypted
   if (plaintext_size != 0U) {
@@ -2659,15 +3279,12 @@ static psa_status_t sli_decrypt_its_file(sli_its_file_meta_v2_t *metadata,
   psa_status_t psa_status = PSA_ERROR_CORRUPTION_DETECTED;
   uint8_t session_key[SESSION_KEY_SIZE];
 
-  if (g_cached_session_key.active && g_cached_session_key.uid == metadata->uid) {
-    // Use cached session key if it's already set and UID matches
-    memcpy(session_key, g_cached_session_key.data, sizeof(session_key));
-  } else {
+  if (!lookup_session_key(metadata->uid, blob->iv, session_key)) {
     psa_status = derive_session_key(blob->iv, AES_GCM_IV_SIZE, session_key, sizeof(session_key));
     if (psa_status != PSA_SUCCESS) {
       return psa_status;
     }
-    cache_session_key(session_key, metadata->uid);
+    cache_session_key(session_key, metadata->uid, blob->iv);
   }
 
   // Decrypt and authenticate blob
@@ -3172,6 +3789,9 @@ psa_status_t psa_its_remove(psa_storage_uid_t uid)
     // re-filled as long as the data has been successfully written to NVM3.
     clear_cache(nvm3_object_id);
     set_tomb(nvm3_object_id);
+#if defined(SLI_PSA_ITS_ENCRYPTED)
+    invalidate_session_key(uid);
+#endif
     psa_status = PSA_SUCCESS;
   } else {
     psa_status = PSA_ERROR_STORAGE_FAILURE;
@@ -3253,6 +3873,14 @@ psa_status_t sli_psa_its_change_key_id(mbedtls_svc_key_id_t old_id,
   return status;
 }
 
+/**
+ * \brief Write the UID index to NVM3. This driver version has no UID index.
+ */
+psa_status_t sli_psa_its_flush_uid_index(void)
+{
+  return PSA_SUCCESS;
+}
+
 /**
  * \brief Check if the ITS encryption is enabled
  */
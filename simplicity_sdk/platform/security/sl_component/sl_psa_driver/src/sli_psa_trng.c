@@ -45,6 +45,12 @@
   #include "sl_si91x_psa_trng.h"
 #endif
 
+#if defined(SLI_PSA_DRIVER_FEATURE_TRNG_POOL)
+  #include "sli_psa_trng_pool.h"
+  #include "sl_core.h"
+  #include <string.h>
+#endif
+
 // -----------------------------------------------------------------------------
 // Typedefs
 
@@ -90,19 +96,13 @@ static psa_status_t se_get_random(unsigned char *output,
 
 #endif // SLI_MBEDTLS_DEVICE_HSE
 
-// -----------------------------------------------------------------------------
-// Global entry points
+#if defined(SLI_PSA_DRIVER_FEATURE_TRNG)
 
-psa_status_t mbedtls_psa_external_get_random(
-  mbedtls_psa_external_random_context_t *context,
-  uint8_t *output,
-  size_t output_size,
-  size_t *output_length)
+// Read random bytes from the device TRNG
+static psa_status_t trng_get_random(uint8_t *output,
+                                    size_t output_size,
+                                    size_t *output_length)
 {
-  (void)context;
-
-  #if defined(SLI_PSA_DRIVER_FEATURE_TRNG)
-
   psa_status_t entropy_status = PSA_ERROR_CORRUPTION_DETECTED;
   *output_length = 0;
 
@@ -145,6 +145,202 @@ psa_status_t mbedtls_psa_external_get_random(
   #endif
 
   return entropy_status;
+}
+
+#endif // SLI_PSA_DRIVER_FEATURE_TRNG
+
+#if defined(SLI_PSA_DRIVER_FEATURE_TRNG_POOL)
+
+// -----------------------------------------------------------------------------
+// Entropy pool
+
+#define POOL_MASK (SL_PSA_TRNG_POOL_SIZE - 1)
+
+// Free-running read and write positions. The fill level is their difference.
+static uint8_t pool[SL_PSA_TRNG_POOL_SIZE];
+static uint32_t pool_head = 0;
+static uint32_t pool_tail = 0;
+
+// Reference block for the repetition test. It is never handed out.
+static uint8_t pool_reference[SLI_PSA_TRNG_POOL_HEALTH_BLOCK_SIZE];
+static bool pool_reference_valid = false;
+
+static bool pool_refill_in_progress = false;
+static uint32_t pool_consecutive_failures = 0;
+static sli_psa_trng_pool_stats_t pool_stats = { 0 };
+
+static void pool_zeroize(void *buffer, size_t size)
+{
+  volatile uint8_t *p = buffer;
+  while (size--) {
+    *p++ = 0;
+  }
+}
+
+// Must be called from within an atomic section
+static void pool_wipe(void)
+{
+  pool_zeroize(pool, sizeof(pool));
+  pool_zeroize(pool_reference, sizeof(pool_reference));
+  pool_reference_valid = false;
+  pool_head = 0;
+  pool_tail = 0;
+}
+
+static void pool_refill_failed(uint32_t *failure_counter)
+{
+  CORE_DECLARE_IRQ_STATE;
+  CORE_ENTER_ATOMIC();
+  (*failure_counter)++;
+  if (++pool_consecutive_failures >= SL_PSA_TRNG_POOL_MAX_HEALTH_FAILURES) {
+    pool_wipe();
+    pool_stats.disabled = true;
+  }
+  pool_refill_in_progress = false;
+  CORE_EXIT_ATOMIC();
+}
+
+bool sli_psa_trng_pool_get(uint8_t *output, size_t output_size)
+{
+  bool served = false;
+
+  CORE_DECLARE_IRQ_STATE;
+  CORE_ENTER_ATOMIC();
+  if (!pool_stats.disabled && (pool_head - pool_tail) >= output_size) {
+    for (size_t i = 0; i < output_size; i++) {
+      uint8_t *byte = &pool[(pool_tail + i) & POOL_MASK];
+      output[i] = *byte;
+      *byte = 0;
+    }
+    pool_tail += output_size;
+    pool_stats.pool_hits++;
+    served = true;
+  } else {
+    pool_stats.pool_misses++;
+  }
+  CORE_EXIT_ATOMIC();
+
+  return served;
+}
+
+bool sli_psa_trng_pool_refill_needed(void)
+{
+  return !pool_stats.disabled
+         && (pool_head - pool_tail) < SL_PSA_TRNG_POOL_LOW_WATERMARK;
+}
+
+psa_status_t sli_psa_trng_pool_process_action(void)
+{
+  // Room for one chunk of pool data plus the next reference block
+  uint8_t chunk[SL_PSA_TRNG_POOL_REFILL_CHUNK_SIZE + SLI_PSA_TRNG_POOL_HEALTH_BLOCK_SIZE];
+  size_t refill_size;
+  size_t chunk_length = 0;
+
+  CORE_DECLARE_IRQ_STATE;
+  CORE_ENTER_ATOMIC();
+  if (pool_stats.disabled) {
+    CORE_EXIT_ATOMIC();
+    return PSA_ERROR_BAD_STATE;
+  }
+  refill_size = SL_PSA_TRNG_POOL_SIZE - (pool_head - pool_tail);
+  if (refill_size > SL_PSA_TRNG_POOL_REFILL_CHUNK_SIZE) {
+    refill_size = SL_PSA_TRNG_POOL_REFILL_CHUNK_SIZE;
+  }
+  refill_size -= refill_size % SLI_PSA_TRNG_POOL_HEALTH_BLOCK_SIZE;
+  if (pool_refill_in_progress || refill_size == 0) {
+    CORE_EXIT_ATOMIC();
+    return PSA_SUCCESS;
+  }
+  pool_refill_in_progress = true;
+  CORE_EXIT_ATOMIC();
+
+  // Fetch entropy without blocking interrupts
+  size_t fetch_size = refill_size + SLI_PSA_TRNG_POOL_HEALTH_BLOCK_SIZE;
+  psa_status_t status = trng_get_random(chunk, fetch_size, &chunk_length);
+  if (status != PSA_SUCCESS || chunk_length != fetch_size) {
+    pool_zeroize(chunk, sizeof(chunk));
+    pool_refill_failed(&pool_stats.trng_failures);
+    return PSA_ERROR_HARDWARE_FAILURE;
+  }
+
+  // Continuous repetition test: no block may equal its predecessor
+  const uint8_t *previous = pool_reference_valid ? pool_reference : NULL;
+  for (size_t offset = 0; offset < fetch_size; offset += SLI_PSA_TRNG_POOL_HEALTH_BLOCK_SIZE) {
+    if (previous != NULL
+        && memcmp(previous, &chunk[offset], SLI_PSA_TRNG_POOL_HEALTH_BLOCK_SIZE) == 0) {
+      pool_zeroize(chunk, sizeof(chunk));
+      pool_refill_failed(&pool_stats.health_failures);
+      return PSA_ERROR_INSUFFICIENT_ENTROPY;
+    }
+    previous = &chunk[offset];
+  }
+
+  CORE_ENTER_ATOMIC();
+  // Consumers only ever free up space, so the chunk still fits
+  for (size_t i = 0; i < refill_size; i++) {
+    pool[(pool_head + i) & POOL_MASK] = chunk[i];
+  }
+  pool_head += refill_size;
+  memcpy(pool_reference, &chunk[refill_size], sizeof(pool_reference));
+  pool_reference_valid = true;
+  pool_consecutive_failures = 0;
+  pool_stats.refills++;
+  pool_refill_in_progress = false;
+  CORE_EXIT_ATOMIC();
+
+  pool_zeroize(chunk, sizeof(chunk));
+
+  return PSA_SUCCESS;
+}
+
+void sli_psa_trng_pool_get_stats(sli_psa_trng_pool_stats_t *stats)
+{
+  CORE_DECLARE_IRQ_STATE;
+  CORE_ENTER_ATOMIC();
+  *stats = pool_stats;
+  stats->level = pool_head - pool_tail;
+  CORE_EXIT_ATOMIC();
+}
+
+void sli_psa_trng_pool_flush(void)
+{
+  CORE_DECLARE_IRQ_STATE;
+  CORE_ENTER_ATOMIC();
+  pool_wipe();
+  CORE_EXIT_ATOMIC();
+}
+
+#endif // SLI_PSA_DRIVER_FEATURE_TRNG_POOL
+
+// -----------------------------------------------------------------------------
+// Global entry points
+
+psa_status_t mbedtls_psa_external_get_random(
+  mbedtls_psa_external_random_context_t *context,
+  uint8_t *output,
+  size_t output_size,
+  size_t *output_length)
+{
+  (void)context;
+
+  #if defined(SLI_PSA_DRIVER_FEATURE_TRNG)
+
+  #if defined(SLI_PSA_DRIVER_FEATURE_TRNG_POOL)
+  if (output_size <= SL_PSA_TRNG_POOL_MAX_REQUEST_SIZE) {
+    // When the pool runs short, refill it in bulk and serve the request from
+    // it rather than paying a TRNG round-trip for this request alone
+    if (sli_psa_trng_pool_get(output, output_size)
+        || (sli_psa_trng_pool_process_action() == PSA_SUCCESS
+            && sli_psa_trng_pool_get(output, output_size))) {
+      *output_length = output_size;
+      return PSA_SUCCESS;
+    }
+  } else {
+    CORE_ATOMIC_SECTION(pool_stats.direct_requests++; )
+  }
+  #endif // SLI_PSA_DRIVER_FEATURE_TRNG_POOL
+
+  return trng_get_random(output, output_size, output_length);
 
   #else // SLI_PSA_DRIVER_FEATURE_TRNG
 
@@ -145,6 +145,36 @@ sl_status_t sli_crypto_process_rpa(sli_crypto_descriptor_t     *key_descriptor,
                                    uint32_t                    hash,
                                    int                         *irk_index);
 
+/***************************************************************************//**
+ * @brief                Resolve a list of BLE RPAs against a table of device
+ *                       keys
+ *
+ * @param key_descriptor SLI crypto descriptor providing a pointer to an array
+ *                       of AES-128 keys
+ * @param irk_len        Number of IRK to be resolved for the RPA operation
+ * @param keymask        Bitmask indicating with key indices in key table are valid
+ * @param prand          Array of 24-bit BLE nonces, one per address
+ * @param hash           Array of BLE RPA hashes, one per address
+ * @param count          Number of addresses
+ * @param irk_index      Output array receiving the 0-based index of the
+ *                       matching key for each address, or -1 for no match
+ *
+ * @return               SL_STATUS_OK if successful, relevant status code on error
+ ******************************************************************************/
+sl_status_t sli_crypto_process_rpa_batch(sli_crypto_descriptor_t     *key_descriptor,
+                                         size_t                      irk_len,
+                                         uint64_t                    keymask,
+                                         const uint32_t              *prand,
+                                         const uint32_t              *hash,
+                                         size_t                      count,
+                                         int                         *irk_index);
+
+/***************************************************************************//**
+ * @brief                Clear the BLE resolved-address cache. Call this when
+ *                       keys in the IRK table are changed in place.
+ ******************************************************************************/
+void sli_crypto_process_rpa_cache_invalidate(void);
+
 /***************************************************************************//**
  * @brief                AES-CTR block encryption/decryption optimized for radio
  *
@@ -143,6 +143,42 @@ sl_status_t sli_crypto_process_rpa(sli_crypto_descriptor_t     *key_descriptor,
   return SL_STATUS_OK;
 }
 
+/***************************************************************************//**
+ * @brief          Resolve a list of BLE RPAs against a table of device keys
+ ******************************************************************************/
+sl_status_t sli_crypto_process_rpa_batch(sli_crypto_descriptor_t     *key_descriptor,
+                                         size_t                      irk_len,
+                                         uint64_t                    keymask,
+                                         const uint32_t              *prand,
+                                         const uint32_t              *hash,
+                                         size_t                      count,
+                                         int                         *irk_index)
+{
+  EFM_ASSERT(key_descriptor != NULL);
+  EFM_ASSERT(prand != NULL);
+  EFM_ASSERT(hash != NULL);
+  EFM_ASSERT(irk_index != NULL);
+  EFM_ASSERT(key_descriptor->location == SLI_CRYPTO_KEY_LOCATION_PLAINTEXT);
+  EFM_ASSERT(key_descriptor->key.plaintext_key.buffer.pointer != NULL);
+  (void)irk_len;
+  const unsigned char *keytable
+    = (const unsigned char *)key_descriptor->key.plaintext_key.buffer.pointer;
+  return sli_process_ble_rpa_batch(keytable,
+                                   (uint32_t)keymask,
+                                   prand,
+                                   hash,
+                                   count,
+                                   irk_index);
+}
+
+/***************************************************************************//**
+ * @brief          Clear the BLE resolved-address cache
+ ******************************************************************************/
+void sli_crypto_process_rpa_cache_invalidate(void)
+{
+  sli_process_ble_rpa_cache_invalidate();
+}
+
 // /***************************************************************************//**
 // * @brief          AES-CTR block encryption/decryption optimized for radio
 // *******************************************************************************/
@@ -35,6 +35,7 @@
 #include <stdlib.h>
 #include "sl_status.h"
 #include "sl_enum.h"
+#include "sl_slist.h"
 #include "sl_device_clock.h"
 #include "sl_code_classification.h"
 
@@ -157,6 +158,7 @@ extern "C" {
  *    - Retrieving or setting calibration values for oscillators
  *    - Exporting clocks to GPIO
  *    - Starting an RCO Calibration process based on a reference clock source
+ *    - Getting notified of clock tree changes
  *
  *  ### Retrieve the frequency or precision of an oscillator or clock branch
  *  API functions sl_clock_manager_get_oscillator_frequency() and
@@ -260,6 +262,15 @@ extern "C" {
  * sl_clock_manager_get_rco_calibration_count() can be called to retrieve the
  * calibration process result.
  *
+ * ### Clock Change Notification
+ * Drivers that derive a baudrate or prescaler from a clock branch frequency
+ * can subscribe to clock tree changes with
+ * sl_clock_manager_subscribe_clock_change_event() and recompute their
+ * divisors in the callback, instead of retrieving the frequency before each
+ * transfer. The callback is called after each clock selection, clock divider
+ * or oscillator band change done through the CMU API, including changes done
+ * by the Clock Manager initialization.
+ *
  * @{
  ******************************************************************************/
 
@@ -301,6 +312,21 @@ SL_ENUM(sl_clock_manager_clock_calibration_t) {
   SL_CLOCK_MANAGER_CLOCK_CALIBRATION_ULFRCO      ///< Clock Calibration ULFRCO
 };
 
+/***************************************************************************//**
+ * Typedef for the user supplied callback function which is called after a
+ * change of the clock tree.
+ *
+ * @param context  Context given when subscribing.
+ ******************************************************************************/
+typedef void (*sl_clock_manager_clock_change_on_event_t)(void *context);
+
+/// @brief Struct representing a clock change event handle
+typedef struct {
+  sl_slist_node_t node;                               ///< List node.
+  sl_clock_manager_clock_change_on_event_t on_event;  ///< Function called after a clock tree change.
+  void *context;                                      ///< Context passed to the callback.
+} sl_clock_manager_clock_change_event_handle_t;
+
 // -----------------------------------------------------------------------------
 // Prototypes
 
@@ -627,6 +653,40 @@ sl_status_t sl_clock_manager_wait_usbpll(void);
  ******************************************************************************/
 void sl_clock_manager_hfxo_notify_consecutive_failed_startups(void);
 
+/***************************************************************************//**
+ * Registers a callback to be called after each change of the clock tree.
+ *
+ * @param[in] event_handle  Event handle, must stay valid until the callback
+ *                          is unsubscribed.
+ *
+ * @param[in] on_event      Function called after a clock tree change.
+ *
+ * @param[in] context       Context passed to the callback.
+ *
+ * @return  Status code.
+ *          SL_STATUS_OK if successful. Error code otherwise.
+ *
+ * @note The callback is called from the context which changed the clock
+ *       tree, possibly from an interrupt or with interrupts disabled. It
+ *       must be short and must not change the clock tree itself.
+ *
+ * @note The callback can be called more than once for a single change, for
+ *       example when a SYSCLK change also updates the PCLK divider.
+ ******************************************************************************/
+sl_status_t sl_clock_manager_subscribe_clock_change_event(sl_clock_manager_clock_change_event_handle_t *event_handle,
+                                                          sl_clock_manager_clock_change_on_event_t     on_event,
+                                                          void                                         *context);
+
+/***************************************************************************//**
+ * Unregisters a clock change callback.
+ *
+ * @param[in] event_handle  Event handle given when subscribing.
+ *
+ * @return  Status code.
+ *          SL_STATUS_OK if successful. Error code otherwise.
+ ******************************************************************************/
+sl_status_t sl_clock_manager_unsubscribe_clock_change_event(sl_clock_manager_clock_change_event_handle_t *event_handle);
+
 /** @} (end addtogroup clock_manager) */
 
 #ifdef __cplusplus
@@ -54,6 +54,11 @@ sl_status_t sli_clock_manager_get_sysclk_source(sl_oscillator_t *source);
  ******************************************************************************/
 __WEAK void sli_clock_manager_notify_hfxo_ready(void);
 
+/***************************************************************************//**
+ * Calls the clock change event subscribers.
+ ******************************************************************************/
+void sli_clock_manager_notify_clock_change(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -29,10 +29,16 @@
  ******************************************************************************/
 
 #include "sl_clock_manager.h"
+#include "sli_clock_manager.h"
 #include "sli_clock_manager_hal.h"
 #include "sl_assert.h"
+#include "sl_core.h"
+#include "sl_slist.h"
 #include "cmsis_compiler.h"
 
+// List of clock change event handles.
+static sl_slist_node_t *clock_change_event_list = NULL;
+
 /***************************************************************************//**
  * Performs Clock Manager runtime initialization.
  ******************************************************************************/
@@ -293,3 +299,56 @@ __WEAK void sl_clock_manager_hfxo_notify_consecutive_failed_startups(void)
 {
   EFM_ASSERT(false);
 }
+
+/***************************************************************************//**
+ * Registers a callback to be called after each change of the clock tree.
+ ******************************************************************************/
+sl_status_t sl_clock_manager_subscribe_clock_change_event(sl_clock_manager_clock_change_event_handle_t *event_handle,
+                                                          sl_clock_manager_clock_change_on_event_t     on_event,
+                                                          void                                         *context)
+{
+  CORE_DECLARE_IRQ_STATE;
+
+  if ((event_handle == NULL) || (on_event == NULL)) {
+    return SL_STATUS_NULL_POINTER;
+  }
+
+  event_handle->on_event = on_event;
+  event_handle->context = context;
+
+  CORE_ENTER_CRITICAL();
+  sl_slist_push(&clock_change_event_list, &event_handle->node);
+  CORE_EXIT_CRITICAL();
+
+  return SL_STATUS_OK;
+}
+
+/***************************************************************************//**
+ * Unregisters a clock change callback.
+ ******************************************************************************/
+sl_status_t sl_clock_manager_unsubscribe_clock_change_event(sl_clock_manager_clock_change_event_handle_t *event_handle)
+{
+  CORE_DECLARE_IRQ_STATE;
+
+  if (event_handle == NULL) {
+    return SL_STATUS_NULL_POINTER;
+  }
+
+  CORE_ENTER_CRITICAL();
+  sl_slist_remove(&clock_change_event_list, &event_handle->node);
+  CORE_EXIT_CRITICAL();
+
+  return SL_STATUS_OK;
+}
+
+/***************************************************************************//**
+ * Calls the clock change event subscribers.
+ ******************************************************************************/
+void sli_clock_manager_notify_clock_change(void)
+{
+  sl_clock_manager_clock_change_event_handle_t *handle;
+
+  SL_SLIST_FOR_EACH_ENTRY(clock_change_event_list, handle, sl_clock_manager_clock_change_event_handle_t, node) {
+    handle->on_event(handle->context);
+  }
+}
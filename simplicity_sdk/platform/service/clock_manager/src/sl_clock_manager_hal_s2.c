@@ -967,6 +967,10 @@ sl_status_t sli_clock_manager_hal_set_sysclk_source(sl_oscillator_t source)
 
   CORE_EXIT_ATOMIC();
 
+  if (return_status == SL_STATUS_OK) {
+    sli_em_cmu_ClockTreeChanged();
+  }
+
   return return_status;
 }
 
@@ -1038,3 +1042,12 @@ sl_status_t sli_clock_manager_get_current_qspi_clk(sl_oscillator_t *oscillator)
   (void)oscillator;
   return SL_STATUS_NOT_AVAILABLE;
 }
+
+/***************************************************************************//**
+ * Notifies the clock change subscribers after a change of the clock tree made
+ * through the CMU API.
+ ******************************************************************************/
+void sli_em_cmu_OnClockTreeChange(void)
+{
+  sli_clock_manager_notify_clock_change();
+}
@@ -878,5 +878,8 @@ sl_status_t sli_clock_manager_hal_init(void)
     return status;
   }
 
+  // Clock branches are configured through direct register writes.
+  sli_em_cmu_ClockTreeChanged();
+
   return SL_STATUS_OK;
 }
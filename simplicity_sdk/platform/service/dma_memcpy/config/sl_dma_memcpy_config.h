@@ -0,0 +1,53 @@
+/***************************************************************************//**
+ * @file
+ * @brief DMA memory copy service configuration file.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+
+// <<< Use Configuration Wizard in Context Menu >>>
+
+#ifndef SL_DMA_MEMCPY_CONFIG_H
+#define SL_DMA_MEMCPY_CONFIG_H
+
+// <h>DMA Memory Copy Configuration
+
+// <o SL_DMA_MEMCPY_CPU_THRESHOLD> Size below which copies are done by the CPU, in bytes <0-65536>
+// <i> Default value until sl_dma_memcpy_calibrate() or sl_dma_memcpy_set_cpu_threshold() is called.
+// <i> Default: 64
+#define SL_DMA_MEMCPY_CPU_THRESHOLD  64
+
+// <o SL_DMA_MEMCPY_DESCRIPTOR_COUNT> Number of linked LDMA descriptors <1-16>
+// <i> Larger requests are split, each part costs one DMA interrupt.
+// <i> Each descriptor moves at most 2048 items and uses 16 bytes of RAM.
+// <i> Default: 4
+#define SL_DMA_MEMCPY_DESCRIPTOR_COUNT  4
+
+// </h>
+
+#endif /* SL_DMA_MEMCPY_CONFIG_H */
+
+// <<< end of configuration section >>>
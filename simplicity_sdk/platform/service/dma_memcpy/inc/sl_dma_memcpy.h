@@ -0,0 +1,225 @@
+/***************************************************************************//**
+ * @file
+ * @brief DMA memory copy service API definition.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+
+/***************************************************************************//**
+ * @addtogroup dma_memcpy DMA Memory Copy
+ * @brief DMA Memory Copy
+ * @details
+ * ## Overview
+ *
+ * The DMA Memory Copy service moves or fills memory with the LDMA, through
+ * DMADRV, so that large buffer moves (radio frames, display frame buffers)
+ * leave the core free.
+ *
+ * Starting a DMA transfer and taking its completion interrupt costs a fixed
+ * number of cycles. Requests smaller than a threshold are therefore done by
+ * the CPU with memcpy()/memset(). The threshold defaults to
+ * SL_DMA_MEMCPY_CPU_THRESHOLD and can be measured on the running chip with
+ * sl_dma_memcpy_calibrate().
+ *
+ * Requests larger than what a chain of SL_DMA_MEMCPY_DESCRIPTOR_COUNT
+ * descriptors can move are split; the next part is started from the DMA
+ * interrupt. The widest item size allowed by the buffer alignment is used,
+ * and a 1 to 3 byte tail is handled by the CPU. Requests too small for a
+ * single item are done by the CPU whatever the threshold.
+ *
+ * The service uses a single DMA channel and runs one request at a time.
+ * Overlapping source and destination buffers are not supported.
+ *
+ * ## Initialization
+ *
+ * sl_dma_memcpy_init() initializes DMADRV if needed and allocates the channel.
+ *
+ * @{
+ ******************************************************************************/
+
+#ifndef SL_DMA_MEMCPY_H
+#define SL_DMA_MEMCPY_H
+
+#include "sl_status.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***************************************************************************//**
+ * Completion callback.
+ *
+ * @param status   SL_STATUS_OK, or the error which stopped the request.
+ * @param context  Context given when the request was started.
+ *
+ * @note The callback is called from the DMA interrupt, or from the calling
+ *       function itself when the request was done by the CPU.
+ ******************************************************************************/
+typedef void (*sl_dma_memcpy_callback_t)(sl_status_t status,
+                                         void        *context);
+
+/***************************************************************************//**
+ * Initialize the DMA Memory Copy service.
+ *
+ * @return Status Code.
+ ******************************************************************************/
+sl_status_t sl_dma_memcpy_init(void);
+
+/***************************************************************************//**
+ * Release the DMA channel of the DMA Memory Copy service.
+ *
+ * @return Status Code. SL_STATUS_BUSY if a request is ongoing.
+ ******************************************************************************/
+sl_status_t sl_dma_memcpy_deinit(void);
+
+/***************************************************************************//**
+ * Start copying memory.
+ *
+ * @param dst       Destination buffer.
+ * @param src       Source buffer. It must not overlap the destination buffer.
+ * @param size      Number of bytes to copy.
+ * @param callback  Function called when the copy is complete, can be NULL.
+ * @param context   Context passed to the callback.
+ *
+ * @return Status Code. SL_STATUS_BUSY if a request is ongoing.
+ *
+ * @note Both buffers must stay valid and untouched until the callback.
+ ******************************************************************************/
+sl_status_t sl_dma_memcpy_async(void                     *dst,
+                                const void               *src,
+                                size_t                   size,
+                                sl_dma_memcpy_callback_t callback,
+                                void                     *context);
+
+/***************************************************************************//**
+ * Start filling memory with a byte value.
+ *
+ * @param dst       Destination buffer.
+ * @param value     Byte value to write.
+ * @param size      Number of bytes to write.
+ * @param callback  Function called when the fill is complete, can be NULL.
+ * @param context   Context passed to the callback.
+ *
+ * @return Status Code. SL_STATUS_BUSY if a request is ongoing.
+ ******************************************************************************/
+sl_status_t sl_dma_memset_async(void                     *dst,
+                                uint8_t                  value,
+                                size_t                   size,
+                                sl_dma_memcpy_callback_t callback,
+                                void                     *context);
+
+/***************************************************************************//**
+ * Copy memory and wait for the end of the copy.
+ *
+ * @param dst   Destination buffer.
+ * @param src   Source buffer. It must not overlap the destination buffer.
+ * @param size  Number of bytes to copy.
+ *
+ * @return Status Code.
+ *
+ * @note The core sleeps in EM1 until the end of the copy. When called with
+ *       interrupts disabled, or from an interrupt handler with a priority
+ *       higher than or equal to EMDRV_DMADRV_DMA_IRQ_PRIORITY, the copy is
+ *       done by the CPU, since the DMA interrupt could not be taken.
+ ******************************************************************************/
+sl_status_t sl_dma_memcpy(void       *dst,
+                          const void *src,
+                          size_t     size);
+
+/***************************************************************************//**
+ * Fill memory with a byte value and wait for the end of the fill.
+ *
+ * @param dst    Destination buffer.
+ * @param value  Byte value to write.
+ * @param size   Number of bytes to write.
+ *
+ * @return Status Code.
+ *
+ * @note The core sleeps in EM1 until the end of the fill. When called with
+ *       interrupts disabled, or from an interrupt handler with a priority
+ *       higher than or equal to EMDRV_DMADRV_DMA_IRQ_PRIORITY, the fill is
+ *       done by the CPU, since the DMA interrupt could not be taken.
+ ******************************************************************************/
+sl_status_t sl_dma_memset(void    *dst,
+                          uint8_t value,
+                          size_t  size);
+
+/***************************************************************************//**
+ * Check whether a request is ongoing.
+ *
+ * @return true if a DMA request is ongoing, false otherwise.
+ ******************************************************************************/
+bool sl_dma_memcpy_is_busy(void);
+
+/***************************************************************************//**
+ * Set the size below which requests are done by the CPU.
+ *
+ * @param threshold  Size in bytes. 0 sends every request to the DMA.
+ ******************************************************************************/
+void sl_dma_memcpy_set_cpu_threshold(size_t threshold);
+
+/***************************************************************************//**
+ * Get the size below which requests are done by the CPU.
+ *
+ * @return Size in bytes.
+ ******************************************************************************/
+size_t sl_dma_memcpy_get_cpu_threshold(void);
+
+/***************************************************************************//**
+ * Measure the size from which the DMA completes a copy as fast as the CPU and
+ * use it as the CPU threshold.
+ *
+ * Copies of growing sizes, from 16 bytes to half of the scratch buffer, are
+ * timed with the DWT cycle counter, both with memcpy() and with the DMA,
+ * including the completion interrupt.
+ *
+ * @param buffer       Scratch buffer, word aligned. Its content is lost.
+ * @param buffer_size  Size of the scratch buffer in bytes, at least 64.
+ * @param threshold    Measured threshold in bytes, can be NULL. When the DMA
+ *                     never catches up, half of the scratch buffer size plus
+ *                     one is used.
+ *
+ * @return Status Code. SL_STATUS_NOT_SUPPORTED if the core has no cycle
+ *         counter.
+ *
+ * @note Call it with interrupts enabled and with the usual bus load, i.e.
+ *       with the radio and other DMA users in their typical state. Run it
+ *       again if the HCLK frequency changes.
+ ******************************************************************************/
+sl_status_t sl_dma_memcpy_calibrate(void   *buffer,
+                                    size_t buffer_size,
+                                    size_t *threshold);
+
+/** @} (end addtogroup dma_memcpy) */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SL_DMA_MEMCPY_H
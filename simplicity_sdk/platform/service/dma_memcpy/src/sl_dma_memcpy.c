@@ -0,0 +1,716 @@
+/***************************************************************************//**
+ * @file
+ * @brief DMA memory copy service implementation.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+
+#include "sl_dma_memcpy.h"
+#include "sl_dma_memcpy_config.h"
+#include "dmadrv.h"
+#include "sl_core.h"
+#include "em_device.h"
+
+#include <string.h>
+
+/*******************************************************************************
+ *********************************   DEFINES   *********************************
+ ******************************************************************************/
+
+// Smallest copy size timed by the calibration
+#define CALIBRATION_MIN_SIZE  16U
+
+// Number of times each size is timed, the fastest run is kept
+#define CALIBRATION_RUN_COUNT  2U
+
+/*******************************************************************************
+ ***************************   LOCAL DATA TYPES   ******************************
+ ******************************************************************************/
+
+#if defined(EMDRV_DMADRV_LDMA)
+typedef LDMA_Descriptor_t descriptor_t;
+typedef LDMA_TransferCfg_t transfer_config_t;
+#else
+typedef sl_hal_ldma_descriptor_t descriptor_t;
+typedef sl_hal_ldma_transfer_config_t transfer_config_t;
+#endif
+
+// Ongoing request
+typedef struct {
+  uint8_t *dst;                       // Next byte to write
+  const uint8_t *src;                 // Next byte to read, NULL for a fill
+  size_t remaining;                   // Bytes left to hand to the DMA
+  unsigned int size_shift;            // log2 of the DMA item size
+  sl_dma_memcpy_callback_t callback;
+  void *context;
+} request_t;
+
+// Completion of a synchronous request
+typedef struct {
+  volatile bool done;
+  sl_status_t status;
+} sync_request_t;
+
+/*******************************************************************************
+ ***************************  LOCAL VARIABLES   ********************************
+ ******************************************************************************/
+
+#if defined(EMDRV_DMADRV_LDMA)
+static const transfer_config_t xfer_config = LDMA_TRANSFER_CFG_MEMORY();
+static const descriptor_t m2m = LDMA_DESCRIPTOR_SINGLE_M2M_BYTE(NULL, NULL, 1UL);
+#else
+static const transfer_config_t xfer_config = SL_HAL_LDMA_TRANSFER_CFG_MEMORY();
+static const descriptor_t m2m = SL_HAL_LDMA_DESCRIPTOR_SINGLE_M2M(SL_HAL_LDMA_CTRL_SIZE_BYTE, NULL, NULL, 1UL);
+#endif
+
+static bool initialized = false;
+static unsigned int dma_channel;
+static volatile bool busy = false;
+static request_t request;
+static size_t cpu_threshold = SL_DMA_MEMCPY_CPU_THRESHOLD;
+
+// Source of the fills, the byte value repeated over a word
+static uint32_t fill_pattern;
+
+static descriptor_t descriptors[SL_DMA_MEMCPY_DESCRIPTOR_COUNT];
+
+/*******************************************************************************
+ **************************   LOCAL FUNCTIONS   ********************************
+ ******************************************************************************/
+
+static sl_status_t start_request(void                     *dst,
+                                 const void               *src,
+                                 uint8_t                  value,
+                                 size_t                   size,
+                                 sl_dma_memcpy_callback_t callback,
+                                 void                     *context);
+
+static sl_status_t start_next_part(void);
+
+static void complete_request(sl_status_t status);
+
+static bool on_dma_complete(unsigned int channel,
+                            unsigned int sequence_no,
+                            void         *user_param);
+
+static void on_sync_request_complete(sl_status_t status,
+                                     void        *context);
+
+static bool completion_irq_can_run(void);
+
+static void wait_for_completion(sync_request_t *sync);
+
+static void cpu_transfer(uint8_t       *dst,
+                         const uint8_t *src,
+                         uint8_t       value,
+                         size_t        size);
+
+/*******************************************************************************
+ **************************   GLOBAL FUNCTIONS   *******************************
+ ******************************************************************************/
+
+/***************************************************************************//**
+ * Initialize the DMA Memory Copy service.
+ ******************************************************************************/
+sl_status_t sl_dma_memcpy_init(void)
+{
+  Ecode_t ecode;
+
+  if (initialized) {
+    return SL_STATUS_OK;
+  }
+
+  ecode = DMADRV_Init();
+  if ((ecode != ECODE_EMDRV_DMADRV_OK)
+      && (ecode != ECODE_EMDRV_DMADRV_ALREADY_INITIALIZED)) {
+    return SL_STATUS_FAIL;
+  }
+
+  ecode = DMADRV_AllocateChannel(&dma_channel, NULL);
+  if (ecode != ECODE_EMDRV_DMADRV_OK) {
+    return SL_STATUS_NO_MORE_RESOURCE;
+  }
+
+  initialized = true;
+
+  return SL_STATUS_OK;
+}
+
+/***************************************************************************//**
+ * Release the DMA channel of the DMA Memory Copy service.
+ ******************************************************************************/
+sl_status_t sl_dma_memcpy_deinit(void)
+{
+  if (!initialized) {
+    return SL_STATUS_OK;
+  }
+
+  if (busy) {
+    return SL_STATUS_BUSY;
+  }
+
+  if (DMADRV_FreeChannel(dma_channel) != ECODE_EMDRV_DMADRV_OK) {
+    return SL_STATUS_FAIL;
+  }
+
+  initialized = false;
+
+  return SL_STATUS_OK;
+}
+
+/***************************************************************************//**
+ * Start copying memory.
+ ******************************************************************************/
+sl_status_t sl_dma_memcpy_async(void                     *dst,
+                                const void               *src,
+                                size_t                   size,
+                                sl_dma_memcpy_callback_t callback,
+                                void                     *context)
+{
+  if ((dst == NULL) || (src == NULL)) {
+    return SL_STATUS_NULL_POINTER;
+  }
+
+  return start_request(dst, src, 0, size, callback, context);
+}
+
+/***************************************************************************//**
+ * Start filling memory with a byte value.
+ ******************************************************************************/
+sl_status_t sl_dma_memset_async(void                     *dst,
+                                uint8_t                  value,
+                                size_t                   size,
+                                sl_dma_memcpy_callback_t callback,
+                                void                     *context)
+{
+  if (dst == NULL) {
+    return SL_STATUS_NULL_POINTER;
+  }
+
+  return start_request(dst, NULL, value, size, callback, context);
+}
+
+/***************************************************************************//**
+ * Copy memory and wait for the end of the copy.
+ ******************************************************************************/
+sl_status_t sl_dma_memcpy(void       *dst,
+                          const void *src,
+                          size_t     size)
+{
+  sync_request_t sync = { .done = false, .status = SL_STATUS_OK };
+  sl_status_t status;
+
+  if ((dst == NULL) || (src == NULL)) {
+    return SL_STATUS_NULL_POINTER;
+  }
+
+  if (!completion_irq_can_run()) {
+    // The completion interrupt could never be taken
+    memcpy(dst, src, size);
+    return SL_STATUS_OK;
+  }
+
+  status = start_request(dst, src, 0, size, on_sync_request_complete, &sync);
+  if (status == SL_STATUS_BUSY) {
+    // Don't wait for another request, the CPU is going to be busy anyway
+    memcpy(dst, src, size);
+    return SL_STATUS_OK;
+  } else if (status != SL_STATUS_OK) {
+    return status;
+  }
+
+  wait_for_completion(&sync);
+
+  return sync.status;
+}
+
+/***************************************************************************//**
+ * Fill memory with a byte value and wait for the end of the fill.
+ ******************************************************************************/
+sl_status_t sl_dma_memset(void    *dst,
+                          uint8_t value,
+                          size_t  size)
+{
+  sync_request_t sync = { .done = false, .status = SL_STATUS_OK };
+  sl_status_t status;
+
+  if (dst == NULL) {
+    return SL_STATUS_NULL_POINTER;
+  }
+
+  if (!completion_irq_can_run()) {
+    memset(dst, value, size);
+    return SL_STATUS_OK;
+  }
+
+  status = start_request(dst, NULL, value, size, on_sync_request_complete, &sync);
+  if (status == SL_STATUS_BUSY) {
+    memset(dst, value, size);
+    return SL_STATUS_OK;
+  } else if (status != SL_STATUS_OK) {
+    return status;
+  }
+
+  wait_for_completion(&sync);
+
+  return sync.status;
+}
+
+/***************************************************************************//**
+ * Check whether a request is ongoing.
+ ******************************************************************************/
+bool sl_dma_memcpy_is_busy(void)
+{
+  return busy;
+}
+
+/***************************************************************************//**
+ * Set the size below which requests are done by the CPU.
+ ******************************************************************************/
+void sl_dma_memcpy_set_cpu_threshold(size_t threshold)
+{
+  cpu_threshold = threshold;
+}
+
+/***************************************************************************//**
+ * Get the size below which requests are done by the CPU.
+ ******************************************************************************/
+size_t sl_dma_memcpy_get_cpu_threshold(void)
+{
+  return cpu_threshold;
+}
+
+/***************************************************************************//**
+ * Measure the CPU threshold.
+ ******************************************************************************/
+sl_status_t sl_dma_memcpy_calibrate(void   *buffer,
+                                    size_t buffer_size,
+                                    size_t *threshold)
+{
+#if defined(DWT_CTRL_CYCCNTENA_Msk)
+  sync_request_t sync;
+  sl_status_t status = SL_STATUS_OK;
+  uint8_t *src;
+  uint8_t *dst;
+  size_t half_size;
+  size_t size;
+  size_t result;
+  size_t saved_threshold;
+  uint32_t saved_demcr;
+  uint32_t saved_dwt_ctrl;
+  uint32_t start;
+  uint32_t cycles;
+  uint32_t cpu_cycles;
+  uint32_t dma_cycles;
+  uint32_t run;
+
+  if (buffer == NULL) {
+    return SL_STATUS_NULL_POINTER;
+  }
+
+  if ((buffer_size < (4U * CALIBRATION_MIN_SIZE))
+      || (((uintptr_t)buffer & 0x3U) != 0U)) {
+    return SL_STATUS_INVALID_PARAMETER;
+  }
+
+  if (!initialized) {
+    return SL_STATUS_NOT_INITIALIZED;
+  }
+
+  if (!completion_irq_can_run()) {
+    return SL_STATUS_INVALID_STATE;
+  }
+
+  if (busy) {
+    return SL_STATUS_BUSY;
+  }
+
+  half_size = (buffer_size / 2U) & ~(size_t)0x3U;
+  src = (uint8_t *)buffer;
+  dst = src + half_size;
+  result = half_size + 1U;
+
+  // Send every timed request to the DMA
+  saved_threshold = cpu_threshold;
+  cpu_threshold = 0;
+
+  saved_demcr = CoreDebug->DEMCR;
+  CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+  saved_dwt_ctrl = DWT->CTRL;
+  DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+  for (size = CALIBRATION_MIN_SIZE; size <= half_size; size *= 2U) {
+    cpu_cycles = UINT32_MAX;
+    dma_cycles = UINT32_MAX;
+
+    // The first run also warms up the instruction cache
+    for (run = 0; run < CALIBRATION_RUN_COUNT; run++) {
+      start = DWT->CYCCNT;
+      memcpy(dst, src, size);
+      cycles = DWT->CYCCNT - start;
+      if (cycles < cpu_cycles) {
+        cpu_cycles = cycles;
+      }
+
+      sync.done = false;
+      start = DWT->CYCCNT;
+      status = start_request(dst, src, 0, size, on_sync_request_complete, &sync);
+      if (status != SL_STATUS_OK) {
+        break;
+      }
+      while (!sync.done) {
+        // Poll, waking up from EM1 would be part of the measurement
+      }
+      cycles = DWT->CYCCNT - start;
+      if (cycles < dma_cycles) {
+        dma_cycles = cycles;
+      }
+    }
+
+    if (status != SL_STATUS_OK) {
+      break;
+    }
+
+    if (dma_cycles <= cpu_cycles) {
+      result = size;
+      break;
+    }
+  }
+
+  DWT->CTRL = saved_dwt_ctrl;
+  CoreDebug->DEMCR = saved_demcr;
+
+  cpu_threshold = (status == SL_STATUS_OK) ? result : saved_threshold;
+  if (threshold != NULL) {
+    *threshold = cpu_threshold;
+  }
+
+  return status;
+#else
+  (void)buffer;
+  (void)buffer_size;
+  (void)threshold;
+
+  return SL_STATUS_NOT_SUPPORTED;
+#endif
+}
+
+/*******************************************************************************
+ **************************   LOCAL FUNCTIONS   ********************************
+ ******************************************************************************/
+
+/***************************************************************************//**
+ * Run a request on the CPU or start it on the DMA.
+ *
+ * @param dst       Destination buffer.
+ * @param src       Source buffer, NULL for a fill.
+ * @param value     Fill value.
+ * @param size      Number of bytes.
+ * @param callback  Completion callback, can be NULL.
+ * @param context   Context passed to the callback.
+ *
+ * @return Status Code.
+ ******************************************************************************/
+static sl_status_t start_request(void                     *dst,
+                                 const void               *src,
+                                 uint8_t                  value,
+                                 size_t                   size,
+                                 sl_dma_memcpy_callback_t callback,
+                                 void                     *context)
+{
+  CORE_DECLARE_IRQ_STATE;
+  uintptr_t alignment;
+  unsigned int size_shift;
+  size_t tail;
+  sl_status_t status;
+
+  if (!initialized) {
+    return SL_STATUS_NOT_INITIALIZED;
+  }
+
+  // Use the widest item size allowed by the buffer alignment
+  alignment = (uintptr_t)dst | (uintptr_t)src;
+  if ((alignment & 0x3U) == 0U) {
+    size_shift = 2U;
+  } else if ((alignment & 0x1U) == 0U) {
+    size_shift = 1U;
+  } else {
+    size_shift = 0U;
+  }
+
+  // Requests which don't fill a single DMA item are done by the CPU as well,
+  // whatever the threshold
+  if ((size < cpu_threshold) || ((size >> size_shift) == 0U)) {
+    cpu_transfer((uint8_t *)dst, (const uint8_t *)src, value, size);
+    if (callback != NULL) {
+      callback(SL_STATUS_OK, context);
+    }
+    return SL_STATUS_OK;
+  }
+
+  CORE_ENTER_ATOMIC();
+  if (busy) {
+    CORE_EXIT_ATOMIC();
+    return SL_STATUS_BUSY;
+  }
+  busy = true;
+  CORE_EXIT_ATOMIC();
+
+  request.size_shift = size_shift;
+
+  // The tail which doesn't fill a whole item is done by the CPU
+  tail = size & ((1U << size_shift) - 1U);
+  size -= tail;
+  cpu_transfer((uint8_t *)dst + size,
+               (src != NULL) ? ((const uint8_t *)src + size) : NULL,
+               value,
+               tail);
+
+  fill_pattern = 0x01010101UL * value;
+
+  request.dst = (uint8_t *)dst;
+  request.src = (const uint8_t *)src;
+  request.remaining = size;
+  request.callback = callback;
+  request.context = context;
+
+  status = start_next_part();
+  if (status != SL_STATUS_OK) {
+    busy = false;
+  }
+
+  return status;
+}
+
+/***************************************************************************//**
+ * Hand the next part of the ongoing request to the DMA, as a chain of up to
+ * SL_DMA_MEMCPY_DESCRIPTOR_COUNT descriptors.
+ *
+ * @return Status Code.
+ ******************************************************************************/
+static sl_status_t start_next_part(void)
+{
+  transfer_config_t xfer = xfer_config;
+  descriptor_t *desc = NULL;
+  size_t items;
+  size_t bytes;
+  uint32_t i;
+
+  for (i = 0; (i < SL_DMA_MEMCPY_DESCRIPTOR_COUNT) && (request.remaining > 0); i++) {
+    items = request.remaining >> request.size_shift;
+    if (items > (size_t)DMADRV_MAX_XFER_COUNT) {
+      items = (size_t)DMADRV_MAX_XFER_COUNT;
+    }
+    bytes = items << request.size_shift;
+
+    desc = &descriptors[i];
+    *desc = m2m;
+#if defined(EMDRV_DMADRV_LDMA)
+    desc->xfer.xferCnt  = items - 1;
+    desc->xfer.size     = request.size_shift;
+    desc->xfer.dstAddr  = (uint32_t)request.dst;
+    desc->xfer.doneIfs  = 0;
+    desc->xfer.linkMode = ldmaLinkModeRel;
+    desc->xfer.link     = 1;
+    desc->xfer.linkAddr = 4;
+    if (request.src != NULL) {
+      desc->xfer.srcAddr = (uint32_t)request.src;
+    } else {
+      desc->xfer.srcAddr = (uint32_t)&fill_pattern;
+      desc->xfer.srcInc  = ldmaCtrlSrcIncNone;
+    }
+#else
+    desc->xfer.xfer_count = items - 1;
+    desc->xfer.size       = request.size_shift;
+    desc->xfer.dst_addr   = (uint32_t)request.dst;
+    desc->xfer.done_ifs   = 0;
+    desc->xfer.link_mode  = SL_HAL_LDMA_LINK_MODE_REL;
+    desc->xfer.link       = 1;
+    desc->xfer.link_addr  = 4;
+    if (request.src != NULL) {
+      desc->xfer.src_addr = (uint32_t)request.src;
+    } else {
+      desc->xfer.src_addr = (uint32_t)&fill_pattern;
+      desc->xfer.src_inc  = SL_HAL_LDMA_CTRL_SRC_INC_NONE;
+    }
+#endif
+
+    request.dst += bytes;
+    if (request.src != NULL) {
+      request.src += bytes;
+    }
+    request.remaining -= bytes;
+  }
+
+  if (desc == NULL) {
+    return SL_STATUS_INVALID_STATE;
+  }
+
+  // The last descriptor ends the chain and raises the interrupt
+#if defined(EMDRV_DMADRV_LDMA)
+  desc->xfer.link    = 0;
+  desc->xfer.doneIfs = 1;
+#else
+  desc->xfer.link     = 0;
+  desc->xfer.done_ifs = 1;
+#endif
+
+  if (DMADRV_LdmaStartTransfer((int)dma_channel,
+                               &xfer,
+                               &descriptors[0],
+                               on_dma_complete,
+                               NULL) != ECODE_EMDRV_DMADRV_OK) {
+    return SL_STATUS_FAIL;
+  }
+
+  return SL_STATUS_OK;
+}
+
+/***************************************************************************//**
+ * End the ongoing request and notify its owner.
+ *
+ * @param status  Status of the request.
+ ******************************************************************************/
+static void complete_request(sl_status_t status)
+{
+  sl_dma_memcpy_callback_t callback = request.callback;
+  void *context = request.context;
+
+  // A new request can be started from the callback
+  busy = false;
+
+  if (callback != NULL) {
+    callback(status, context);
+  }
+}
+
+/***************************************************************************//**
+ * DMADRV completion callback, called from the DMA interrupt.
+ ******************************************************************************/
+static bool on_dma_complete(unsigned int channel,
+                            unsigned int sequence_no,
+                            void         *user_param)
+{
+  sl_status_t status = SL_STATUS_OK;
+
+  (void)channel;
+  (void)sequence_no;
+  (void)user_param;
+
+  if (request.remaining > 0) {
+    status = start_next_part();
+    if (status == SL_STATUS_OK) {
+      return true;
+    }
+  }
+
+  complete_request(status);
+
+  return true;
+}
+
+/***************************************************************************//**
+ * Completion callback of the synchronous requests.
+ ******************************************************************************/
+static void on_sync_request_complete(sl_status_t status,
+                                     void        *context)
+{
+  sync_request_t *sync = (sync_request_t *)context;
+
+  sync->status = status;
+  sync->done = true;
+}
+
+/***************************************************************************//**
+ * Check whether the DMA completion interrupt can be taken by the caller.
+ *
+ * @return false if interrupts are disabled, or if the caller is an interrupt
+ *         handler that the DMA interrupt can't preempt.
+ ******************************************************************************/
+static bool completion_irq_can_run(void)
+{
+  uint32_t active = __get_IPSR();
+
+  if (CORE_IrqIsDisabled()) {
+    return false;
+  }
+
+  if (active == 0U) {
+    return true;
+  }
+
+  // Exception numbers are offset by 16 from the IRQ numbers
+  return NVIC_GetPriority((IRQn_Type)((int32_t)active - 16))
+         > EMDRV_DMADRV_DMA_IRQ_PRIORITY;
+}
+
+/***************************************************************************//**
+ * Wait until a synchronous request is complete.
+ *
+ * @param sync  Synchronous request.
+ *
+ * @details The core sleeps in EM1 with WFI. Interrupts are masked with
+ *          PRIMASK around the check, so the completion interrupt wakes up the
+ *          core even if it becomes pending between the check and the WFI, and
+ *          is taken right after the wake-up. An ATOMIC section would mask it
+ *          with BASEPRI, which also prevents the wake-up.
+ ******************************************************************************/
+static void wait_for_completion(sync_request_t *sync)
+{
+  CORE_DECLARE_IRQ_STATE;
+
+  CORE_ENTER_CRITICAL();
+  while (!sync->done) {
+    __WFI();
+    CORE_EXIT_CRITICAL();
+    CORE_ENTER_CRITICAL();
+  }
+  CORE_EXIT_CRITICAL();
+}
+
+/***************************************************************************//**
+ * Copy or fill memory with the CPU.
+ *
+ * @param dst    Destination buffer.
+ * @param src    Source buffer, NULL for a fill.
+ * @param value  Fill value.
+ * @param size   Number of bytes.
+ ******************************************************************************/
+static void cpu_transfer(uint8_t       *dst,
+                         const uint8_t *src,
+                         uint8_t       value,
+                         size_t        size)
+{
+  if (size == 0) {
+    return;
+  }
+
+  if (src != NULL) {
+    memcpy(dst, src, size);
+  } else {
+    memset(dst, value, size);
+  }
+}
@@ -0,0 +1,66 @@
+/***************************************************************************//**
+ * @file
+ * @brief Flash writer service configuration file.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+
+// <<< Use Configuration Wizard in Context Menu >>>
+
+#ifndef SL_FLASH_WRITER_CONFIG_H
+#define SL_FLASH_WRITER_CONFIG_H
+
+// <h>Flash Writer Configuration
+
+// <o SL_FLASH_WRITER_BUFFER_SIZE> Size of a staging buffer, in bytes
+// <32=> 32
+// <64=> 64
+// <128=> 128
+// <256=> 256
+// <512=> 512
+// <1024=> 1024
+// <i> Each buffer combines the writes to one aligned block of flash of this
+// <i> size, which is then programmed with a single DMA transfer.
+// <i> Default: 256
+#define SL_FLASH_WRITER_BUFFER_SIZE  256
+
+// <o SL_FLASH_WRITER_BUFFER_COUNT> Number of staging buffers <2-8>
+// <i> One buffer can be filled while others are being programmed.
+// <i> Default: 2
+#define SL_FLASH_WRITER_BUFFER_COUNT  2
+
+// <q SL_FLASH_WRITER_ERASE_AHEAD> Erase the next page ahead of time
+// <i> Erase the page following the one being written from
+// <i> sl_flash_writer_process_action(), so that a write crossing a page
+// <i> boundary doesn't have to wait for an erase.
+// <i> Default: 1
+#define SL_FLASH_WRITER_ERASE_AHEAD  1
+
+// </h>
+
+#endif /* SL_FLASH_WRITER_CONFIG_H */
+
+// <<< end of configuration section >>>
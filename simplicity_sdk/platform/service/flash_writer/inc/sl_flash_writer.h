@@ -0,0 +1,200 @@
+/***************************************************************************//**
+ * @file
+ * @brief Flash writer service API definition.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+
+/***************************************************************************//**
+ * @addtogroup flash_writer Flash Writer
+ * @brief Flash Writer
+ * @details
+ * ## Overview
+ *
+ * The Flash Writer service combines many small writes to the internal flash,
+ * such as log records or OTA image chunks, into few large ones programmed in
+ * the background by the LDMA.
+ *
+ * Writes are copied to RAM staging buffers, each covering one aligned block
+ * of SL_FLASH_WRITER_BUFFER_SIZE bytes of flash. A buffer is programmed when
+ * it is full, when a write goes to another block and no buffer is left, or on
+ * sl_flash_writer_flush(). Programming a buffer is a single MSC write burst
+ * fed by the LDMA, so the per-write setup and status polling of
+ * MSC_WriteWord() are paid once per buffer instead of once per write.
+ *
+ * Writes follow flash semantics: bits can only be cleared, and writing the
+ * same byte twice stores the AND of both values. sl_flash_writer_read()
+ * returns what the flash will hold once everything is programmed, merging
+ * flash content with the staged and in-flight buffers.
+ *
+ * ## Erasing
+ *
+ * The service works on a region of whole flash pages. Pages from a given
+ * offset of the region onwards are erased by the service, in order, before
+ * they are first programmed. With SL_FLASH_WRITER_ERASE_AHEAD, the page
+ * following the last one written is erased from
+ * sl_flash_writer_process_action(), so that sequential writes don't wait for
+ * an erase when crossing a page boundary. Pages below that offset are
+ * programmed as they are and must have been erased by the application.
+ *
+ * ## Limitations
+ *
+ * - The service drives the MSC itself. Other flash writers, such as NVM3 or
+ *   MSC_WriteWord(), must not be used while the service is busy.
+ * - Code executing from flash stalls while a word is being programmed or a
+ *   page erased.
+ * - The API is not reentrant and must be called from a single thread.
+ *
+ * @{
+ ******************************************************************************/
+
+#ifndef SL_FLASH_WRITER_H
+#define SL_FLASH_WRITER_H
+
+#include "sl_status.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// Flash writer statistics.
+typedef struct {
+  uint32_t writes;            ///< Calls to sl_flash_writer_write()
+  uint32_t bytes_written;     ///< Bytes passed to sl_flash_writer_write()
+  uint32_t bursts;            ///< Buffers programmed
+  uint32_t words_programmed;  ///< Flash words programmed
+  uint32_t pages_erased;      ///< Pages erased
+  uint32_t write_stalls;      ///< Writes which had to wait for programming or erasing
+} sl_flash_writer_stats_t;
+
+/***************************************************************************//**
+ * Initialize the Flash Writer service.
+ *
+ * @param region_start  Start address of the flash region, page aligned.
+ * @param region_size   Size of the region in bytes, a multiple of the page
+ *                      size.
+ * @param erase_offset  Offset in the region from which pages are erased by
+ *                      the service, a multiple of the page size. Use 0 to
+ *                      let the service erase the whole region as it is
+ *                      written, region_size if the region is already erased.
+ *
+ * @return Status Code.
+ ******************************************************************************/
+sl_status_t sl_flash_writer_init(uint32_t region_start,
+                                 uint32_t region_size,
+                                 uint32_t erase_offset);
+
+/***************************************************************************//**
+ * Flush all data and release the DMA channel of the Flash Writer service.
+ *
+ * @return Status Code.
+ ******************************************************************************/
+sl_status_t sl_flash_writer_deinit(void);
+
+/***************************************************************************//**
+ * Write data to flash.
+ *
+ * @param address  Flash address, with any alignment.
+ * @param data     Data to write.
+ * @param size     Number of bytes to write.
+ *
+ * @return Status Code. SL_STATUS_INVALID_RANGE if the data doesn't fit in the
+ *         region. SL_STATUS_BUSY if called with interrupts disabled while
+ *         the free staging buffers can't hold the data; nothing is staged
+ *         then, and the write can be retried once interrupts are enabled.
+ *
+ * @note The data is copied, the buffer can be reused on return. The data
+ *       reaches the flash later, use sl_flash_writer_flush() to make sure it
+ *       has been programmed.
+ *
+ * @note When all staging buffers are in use, the function waits for the
+ *       oldest one to be programmed, with interrupts enabled.
+ ******************************************************************************/
+sl_status_t sl_flash_writer_write(uint32_t   address,
+                                  const void *data,
+                                  size_t     size);
+
+/***************************************************************************//**
+ * Read data, including data which has not been programmed yet.
+ *
+ * @param address  Flash address, with any alignment.
+ * @param data     Buffer receiving the data.
+ * @param size     Number of bytes to read.
+ *
+ * @return Status Code. SL_STATUS_INVALID_RANGE if the data is not in the
+ *         region.
+ *
+ * @note Pages which are still to be erased by the service read as erased.
+ ******************************************************************************/
+sl_status_t sl_flash_writer_read(uint32_t address,
+                                 void     *data,
+                                 size_t   size);
+
+/***************************************************************************//**
+ * Program all staged data and wait for completion.
+ *
+ * @return Status Code. The first programming or erase error since the last
+ *         flush, if any.
+ *
+ * @note Data written before the call is in flash when the function returns.
+ *       It is a barrier, e.g. before a reset or before handing the region to
+ *       another flash user.
+ ******************************************************************************/
+sl_status_t sl_flash_writer_flush(void);
+
+/***************************************************************************//**
+ * Advance background work: complete erases, start pending programming and
+ * erase the next page ahead.
+ *
+ * @note Call it from the idle loop or a low priority task.
+ ******************************************************************************/
+void sl_flash_writer_process_action(void);
+
+/***************************************************************************//**
+ * Check whether the service has data which is not programmed yet, or an
+ * ongoing flash operation.
+ *
+ * @return true if busy, false otherwise.
+ ******************************************************************************/
+bool sl_flash_writer_is_busy(void);
+
+/***************************************************************************//**
+ * Get the Flash Writer statistics.
+ *
+ * @param stats  Statistics.
+ ******************************************************************************/
+void sl_flash_writer_get_stats(sl_flash_writer_stats_t *stats);
+
+/** @} (end addtogroup flash_writer) */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SL_FLASH_WRITER_H
@@ -0,0 +1,841 @@
+/***************************************************************************//**
+ * @file
+ * @brief Flash writer service implementation.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+
+#include "sl_flash_writer.h"
+#include "sl_flash_writer_config.h"
+#include "dmadrv.h"
+#include "sl_common.h"
+#include "sl_core.h"
+#include "em_device.h"
+#include "em_msc.h"
+
+#include <string.h>
+
+#if !defined(_SILICON_LABS_32B_SERIES_2)
+#error "The Flash Writer service only supports Series 2 devices"
+#endif
+
+/*******************************************************************************
+ *********************************   DEFINES   *********************************
+ ******************************************************************************/
+
+#if (SL_FLASH_WRITER_BUFFER_SIZE < 8) \
+  || ((SL_FLASH_WRITER_BUFFER_SIZE & (SL_FLASH_WRITER_BUFFER_SIZE - 1)) != 0)
+#error "SL_FLASH_WRITER_BUFFER_SIZE must be a power of two of at least 8"
+#endif
+
+#if (SL_FLASH_WRITER_BUFFER_SIZE > FLASH_PAGE_SIZE)
+#error "SL_FLASH_WRITER_BUFFER_SIZE must not exceed the flash page size"
+#endif
+
+#if (SL_FLASH_WRITER_BUFFER_COUNT < 2)
+#error "SL_FLASH_WRITER_BUFFER_COUNT must be at least 2"
+#endif
+
+#define BUFFER_WORDS  (SL_FLASH_WRITER_BUFFER_SIZE / 4U)
+
+// Start of the flash block or page holding an address
+#define BLOCK_OF(address)  ((address) & ~(SL_FLASH_WRITER_BUFFER_SIZE - 1U))
+#define PAGE_OF(address)   ((address) & ~(FLASH_PAGE_SIZE - 1U))
+
+#define MSC_IS_LOCKED()    ((MSC->STATUS & _MSC_STATUS_REGLOCK_MASK) != 0U)
+
+/*******************************************************************************
+ ***************************   LOCAL DATA TYPES   ******************************
+ ******************************************************************************/
+
+typedef enum {
+  BUFFER_FREE,         // Unused
+  BUFFER_STAGING,      // Accepting writes
+  BUFFER_PENDING,      // Waiting to be programmed
+  BUFFER_PROGRAMMING,  // Being programmed by the DMA
+} buffer_state_t;
+
+// Staging buffer of one flash block
+typedef struct {
+  volatile buffer_state_t state;
+  uint32_t base;        // Flash address of the block
+  uint32_t sequence;    // Age, the oldest buffers are programmed first
+  uint32_t first_word;  // Written words are in [first_word, end_word)
+  uint32_t end_word;
+  uint32_t data[BUFFER_WORDS];
+} staging_buffer_t;
+
+typedef enum {
+  OPERATION_NONE,
+  OPERATION_PROGRAM,
+  OPERATION_ERASE,
+} operation_t;
+
+/*******************************************************************************
+ ***************************  LOCAL VARIABLES   ********************************
+ ******************************************************************************/
+
+static bool initialized = false;
+static unsigned int dma_channel;
+static uint32_t region_start;
+static uint32_t region_end;
+
+// Pages from here to region_end still have to be erased by the service
+static uint32_t erased_end;
+
+// Page of the latest write, the erase-ahead target is the one after it
+static uint32_t write_page;
+
+static volatile operation_t operation = OPERATION_NONE;
+static bool msc_was_locked;
+static uint32_t sequence;
+static volatile sl_status_t first_error = SL_STATUS_OK;
+static sl_flash_writer_stats_t stats;
+
+static staging_buffer_t buffers[SL_FLASH_WRITER_BUFFER_COUNT];
+
+/*******************************************************************************
+ **************************   LOCAL FUNCTIONS   ********************************
+ ******************************************************************************/
+
+static bool staging_buffers_available(uint32_t address,
+                                      size_t   size);
+
+static staging_buffer_t *get_staging_buffer(uint32_t block,
+                                            bool     *stalled);
+
+static void queue_buffer(staging_buffer_t *buffer);
+
+static void queue_oldest_buffer(void);
+
+static void service(bool erase_ahead);
+
+static void start_next_operation(bool erase_ahead);
+
+static void start_program(staging_buffer_t *buffer);
+
+static void start_erase(uint32_t page);
+
+static bool on_program_complete(unsigned int channel,
+                                unsigned int sequence_no,
+                                void         *user_param);
+
+static sl_status_t wait_msc_idle(void);
+
+static void msc_unlock(void);
+
+static void msc_restore_lock(void);
+
+static void record_error(sl_status_t status);
+
+static bool has_unprogrammed_data(void);
+
+/*******************************************************************************
+ **************************   GLOBAL FUNCTIONS   *******************************
+ ******************************************************************************/
+
+/***************************************************************************//**
+ * Initialize the Flash Writer service.
+ ******************************************************************************/
+sl_status_t sl_flash_writer_init(uint32_t region_start_address,
+                                 uint32_t region_size,
+                                 uint32_t erase_offset)
+{
+  Ecode_t ecode;
+  uint32_t i;
+
+  if (initialized) {
+    return SL_STATUS_ALREADY_INITIALIZED;
+  }
+
+  if (((region_start_address & (FLASH_PAGE_SIZE - 1U)) != 0U)
+      || ((region_size & (FLASH_PAGE_SIZE - 1U)) != 0U)
+      || ((erase_offset & (FLASH_PAGE_SIZE - 1U)) != 0U)
+      || (region_size == 0U)
+      || (erase_offset > region_size)
+      || (region_start_address < FLASH_BASE)
+      || (region_size > FLASH_SIZE)
+      || (region_start_address - FLASH_BASE > FLASH_SIZE - region_size)) {
+    return SL_STATUS_INVALID_PARAMETER;
+  }
+
+  ecode = DMADRV_Init();
+  if ((ecode != ECODE_EMDRV_DMADRV_OK)
+      && (ecode != ECODE_EMDRV_DMADRV_ALREADY_INITIALIZED)) {
+    return SL_STATUS_FAIL;
+  }
+
+  ecode = DMADRV_AllocateChannel(&dma_channel, NULL);
+  if (ecode != ECODE_EMDRV_DMADRV_OK) {
+    return SL_STATUS_NO_MORE_RESOURCE;
+  }
+
+#if defined(_CMU_CLKEN1_MASK)
+  CMU->CLKEN1_SET = CMU_CLKEN1_MSC;
+#endif
+
+  region_start = region_start_address;
+  region_end   = region_start_address + region_size;
+  erased_end   = region_start_address + erase_offset;
+  write_page   = region_start_address;
+  operation    = OPERATION_NONE;
+  sequence     = 0;
+  first_error  = SL_STATUS_OK;
+  memset(&stats, 0, sizeof(stats));
+  for (i = 0; i < SL_FLASH_WRITER_BUFFER_COUNT; i++) {
+    buffers[i].state = BUFFER_FREE;
+  }
+
+  initialized = true;
+
+  return SL_STATUS_OK;
+}
+
+/***************************************************************************//**
+ * Flush all data and release the DMA channel of the Flash Writer service.
+ ******************************************************************************/
+sl_status_t sl_flash_writer_deinit(void)
+{
+  sl_status_t status;
+
+  if (!initialized) {
+    return SL_STATUS_OK;
+  }
+
+  status = sl_flash_writer_flush();
+  if (status == SL_STATUS_INVALID_STATE) {
+    return status;
+  }
+
+  if (DMADRV_FreeChannel(dma_channel) != ECODE_EMDRV_DMADRV_OK) {
+    return SL_STATUS_FAIL;
+  }
+
+  initialized = false;
+
+  return status;
+}
+
+/***************************************************************************//**
+ * Write data to flash.
+ ******************************************************************************/
+sl_status_t sl_flash_writer_write(uint32_t   address,
+                                  const void *data,
+                                  size_t     size)
+{
+  const uint8_t *src = (const uint8_t *)data;
+  bool stalled = false;
+
+  if (!initialized) {
+    return SL_STATUS_NOT_INITIALIZED;
+  }
+  if (data == NULL) {
+    return SL_STATUS_NULL_POINTER;
+  }
+  if ((address < region_start) || (address > region_end)
+      || (size > region_end - address)) {
+    return SL_STATUS_INVALID_RANGE;
+  }
+
+  // Nothing is staged unless all of the data can be. Staging part of it
+  // before failing would program the staged words again on the retry, and
+  // each word can only be written a limited number of times between erases.
+  if ((size > 0U) && CORE_IrqIsDisabled()
+      && !staging_buffers_available(address, size)) {
+    queue_oldest_buffer();
+    service(false);
+    return SL_STATUS_BUSY;
+  }
+
+  stats.writes++;
+  stats.bytes_written += size;
+
+  while (size > 0U) {
+    uint32_t block = BLOCK_OF(address);
+    uint32_t offset = address - block;
+    uint32_t chunk = SL_FLASH_WRITER_BUFFER_SIZE - offset;
+    staging_buffer_t *buffer;
+    uint8_t *dst;
+    uint32_t i;
+
+    if (chunk > size) {
+      chunk = (uint32_t)size;
+    }
+
+    buffer = get_staging_buffer(block, &stalled);
+
+    // Combine like the flash would, bits can only be cleared
+    dst = (uint8_t *)buffer->data + offset;
+    for (i = 0; i < chunk; i++) {
+      dst[i] &= src[i];
+    }
+
+    if ((offset / 4U) < buffer->first_word) {
+      buffer->first_word = offset / 4U;
+    }
+    if (((offset + chunk + 3U) / 4U) > buffer->end_word) {
+      buffer->end_word = (offset + chunk + 3U) / 4U;
+    }
+
+    // A block written up to its end is done with when writing sequentially
+    if ((offset + chunk) == SL_FLASH_WRITER_BUFFER_SIZE) {
+      queue_buffer(buffer);
+    }
+
+    write_page = PAGE_OF(address);
+    address   += chunk;
+    src       += chunk;
+    size      -= chunk;
+  }
+
+  if (stalled) {
+    stats.write_stalls++;
+  }
+
+  service(false);
+
+  return SL_STATUS_OK;
+}
+
+/***************************************************************************//**
+ * Read data, including data which has not been programmed yet.
+ ******************************************************************************/
+sl_status_t sl_flash_writer_read(uint32_t address,
+                                 void     *data,
+                                 size_t   size)
+{
+  uint8_t *dst = (uint8_t *)data;
+  uint32_t end;
+  uint32_t flash_end;
+  uint32_t i;
+
+  if (!initialized) {
+    return SL_STATUS_NOT_INITIALIZED;
+  }
+  if (data == NULL) {
+    return SL_STATUS_NULL_POINTER;
+  }
+  if ((address < region_start) || (address > region_end)
+      || (size > region_end - address)) {
+    return SL_STATUS_INVALID_RANGE;
+  }
+
+  end = address + (uint32_t)size;
+  memset(dst, 0xFF, size);
+
+  // Merge the buffers before reading the flash: a buffer which completes in
+  // between is then seen in both, instead of in none.
+  for (i = 0; i < SL_FLASH_WRITER_BUFFER_COUNT; i++) {
+    const staging_buffer_t *buffer = &buffers[i];
+    const uint8_t *src = (const uint8_t *)buffer->data;
+    uint32_t from;
+    uint32_t to;
+
+    if ((buffer->state == BUFFER_FREE)
+        || (buffer->base >= end)
+        || (buffer->base + SL_FLASH_WRITER_BUFFER_SIZE <= address)) {
+      continue;
+    }
+    from = SL_MAX(address, buffer->base);
+    to   = SL_MIN(end, buffer->base + SL_FLASH_WRITER_BUFFER_SIZE);
+    for (; from < to; from++) {
+      dst[from - address] &= src[from - buffer->base];
+    }
+  }
+
+  // Pages still to be erased read as erased
+  flash_end = SL_MIN(end, erased_end);
+  for (i = address; i < flash_end; i++) {
+    dst[i - address] &= *(const volatile uint8_t *)i;
+  }
+
+  return SL_STATUS_OK;
+}
+
+/***************************************************************************//**
+ * Program all staged data and wait for completion.
+ ******************************************************************************/
+sl_status_t sl_flash_writer_flush(void)
+{
+  sl_status_t status;
+  uint32_t i;
+
+  if (!initialized) {
+    return SL_STATUS_NOT_INITIALIZED;
+  }
+
+  for (i = 0; i < SL_FLASH_WRITER_BUFFER_COUNT; i++) {
+    if (buffers[i].state == BUFFER_STAGING) {
+      queue_buffer(&buffers[i]);
+    }
+  }
+
+  if (has_unprogrammed_data() && CORE_IrqIsDisabled()) {
+    // The DMA completion interrupt could never be taken
+    return SL_STATUS_INVALID_STATE;
+  }
+
+  while (has_unprogrammed_data() || (operation != OPERATION_NONE)) {
+    service(false);
+  }
+
+  status = first_error;
+  first_error = SL_STATUS_OK;
+
+  return status;
+}
+
+/***************************************************************************//**
+ * Advance background work.
+ ******************************************************************************/
+void sl_flash_writer_process_action(void)
+{
+  if (initialized) {
+    service(SL_FLASH_WRITER_ERASE_AHEAD != 0);
+  }
+}
+
+/***************************************************************************//**
+ * Check whether the service is busy.
+ ******************************************************************************/
+bool sl_flash_writer_is_busy(void)
+{
+  uint32_t i;
+
+  if (operation != OPERATION_NONE) {
+    return true;
+  }
+  for (i = 0; i < SL_FLASH_WRITER_BUFFER_COUNT; i++) {
+    if (buffers[i].state != BUFFER_FREE) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+/***************************************************************************//**
+ * Get the Flash Writer statistics.
+ ******************************************************************************/
+void sl_flash_writer_get_stats(sl_flash_writer_stats_t *stats_out)
+{
+  CORE_DECLARE_IRQ_STATE;
+
+  CORE_ENTER_ATOMIC();
+  *stats_out = stats;
+  CORE_EXIT_ATOMIC();
+}
+
+/*******************************************************************************
+ **************************   LOCAL FUNCTIONS   ********************************
+ ******************************************************************************/
+
+/***************************************************************************//**
+ * Check whether a write can be staged without waiting for a buffer to be
+ * programmed: every block it covers either has a staging or pending buffer
+ * already, or gets one of the free buffers. Used when interrupts are
+ * disabled, since buffers are freed by the DMA completion interrupt.
+ *
+ * @param address  Flash address of the write.
+ * @param size     Number of bytes of the write, not 0.
+ *
+ * @return true if the write can be staged at once.
+ ******************************************************************************/
+static bool staging_buffers_available(uint32_t address,
+                                      size_t   size)
+{
+  uint32_t block = BLOCK_OF(address);
+  uint32_t last = BLOCK_OF(address + (uint32_t)size - 1U);
+  uint32_t free_count = 0;
+  uint32_t i;
+
+  for (i = 0; i < SL_FLASH_WRITER_BUFFER_COUNT; i++) {
+    if (buffers[i].state == BUFFER_FREE) {
+      free_count++;
+    }
+  }
+
+  // Ends after at most twice the buffer count of blocks
+  while (true) {
+    bool staged = false;
+
+    for (i = 0; i < SL_FLASH_WRITER_BUFFER_COUNT; i++) {
+      if (((buffers[i].state == BUFFER_STAGING)
+           || (buffers[i].state == BUFFER_PENDING))
+          && (buffers[i].base == block)) {
+        staged = true;
+        break;
+      }
+    }
+    if (!staged) {
+      if (free_count == 0U) {
+        return false;
+      }
+      free_count--;
+    }
+    if (block == last) {
+      return true;
+    }
+    block += SL_FLASH_WRITER_BUFFER_SIZE;
+  }
+}
+
+/***************************************************************************//**
+ * Get the staging buffer of a block, allocating one if needed. A pending
+ * buffer of the block takes writes again, instead of a second buffer which
+ * would program the words they share once more. When all buffers are in use,
+ * the oldest staging buffer is queued for programming and the function waits
+ * for a buffer to be free. A buffer is freed by the DMA completion interrupt,
+ * so with interrupts disabled staging_buffers_available() must have been
+ * checked first.
+ *
+ * @param block    Flash address of the block.
+ * @param stalled  Set to true when the function had to wait.
+ *
+ * @return Staging buffer.
+ ******************************************************************************/
+static staging_buffer_t *get_staging_buffer(uint32_t block,
+                                            bool     *stalled)
+{
+  staging_buffer_t *found = NULL;
+  uint32_t i;
+  CORE_DECLARE_IRQ_STATE;
+
+  // A pending buffer can be started by the DMA completion interrupt
+  CORE_ENTER_ATOMIC();
+  for (i = 0; i < SL_FLASH_WRITER_BUFFER_COUNT; i++) {
+    if (((buffers[i].state == BUFFER_STAGING)
+         || (buffers[i].state == BUFFER_PENDING))
+        && (buffers[i].base == block)) {
+      buffers[i].state = BUFFER_STAGING;
+      found = &buffers[i];
+      break;
+    }
+  }
+  CORE_EXIT_ATOMIC();
+  if (found != NULL) {
+    return found;
+  }
+
+  while (true) {
+    for (i = 0; i < SL_FLASH_WRITER_BUFFER_COUNT; i++) {
+      staging_buffer_t *buffer = &buffers[i];
+
+      if (buffer->state == BUFFER_FREE) {
+        memset(buffer->data, 0xFF, sizeof(buffer->data));
+        buffer->base       = block;
+        buffer->sequence   = sequence++;
+        buffer->first_word = BUFFER_WORDS;
+        buffer->end_word   = 0;
+        buffer->state      = BUFFER_STAGING;
+        return buffer;
+      }
+    }
+
+    queue_oldest_buffer();
+    *stalled = true;
+    service(false);
+  }
+}
+
+/***************************************************************************//**
+ * Queue a staging buffer for programming.
+ *
+ * @param buffer  Staging buffer.
+ ******************************************************************************/
+static void queue_buffer(staging_buffer_t *buffer)
+{
+  if (buffer->end_word == 0U) {
+    // Nothing was written
+    buffer->state = BUFFER_FREE;
+  } else {
+    buffer->state = BUFFER_PENDING;
+  }
+}
+
+/***************************************************************************//**
+ * Queue the oldest staging buffer for programming, if any.
+ ******************************************************************************/
+static void queue_oldest_buffer(void)
+{
+  staging_buffer_t *oldest = NULL;
+  uint32_t i;
+
+  for (i = 0; i < SL_FLASH_WRITER_BUFFER_COUNT; i++) {
+    staging_buffer_t *buffer = &buffers[i];
+
+    if ((buffer->state == BUFFER_STAGING)
+        && ((oldest == NULL)
+            || ((int32_t)(buffer->sequence - oldest->sequence) < 0))) {
+      oldest = buffer;
+    }
+  }
+
+  if (oldest != NULL) {
+    queue_buffer(oldest);
+  }
+}
+
+/***************************************************************************//**
+ * Complete a finished erase and start the next flash operation.
+ *
+ * @param erase_ahead  Allow erasing the page after the latest written one.
+ ******************************************************************************/
+static void service(bool erase_ahead)
+{
+  CORE_DECLARE_IRQ_STATE;
+
+  CORE_ENTER_ATOMIC();
+  if ((operation == OPERATION_ERASE)
+      && ((MSC->STATUS & (MSC_STATUS_BUSY | MSC_STATUS_PENDING)) == 0U)
+      // We need to check twice to be sure
+      && ((MSC->STATUS & (MSC_STATUS_BUSY | MSC_STATUS_PENDING)) == 0U)) {
+    if ((MSC->STATUS & MSC_STATUS_LOCKED) != 0U) {
+      record_error(SL_STATUS_FLASH_ERASE_FAILED);
+    }
+    MSC->WRITECTRL_CLR = MSC_WRITECTRL_WREN;
+    msc_restore_lock();
+    // Move on even on failure, so that writes don't wait forever
+    erased_end += FLASH_PAGE_SIZE;
+    stats.pages_erased++;
+    operation = OPERATION_NONE;
+  }
+  if (operation == OPERATION_NONE) {
+    start_next_operation(erase_ahead);
+  }
+  CORE_EXIT_ATOMIC();
+}
+
+/***************************************************************************//**
+ * Start programming the oldest pending buffer, erasing its page first if
+ * needed. Must be called with interrupts disabled and no ongoing operation.
+ *
+ * @param erase_ahead  Allow erasing the page after the latest written one
+ *                     when there is nothing to program.
+ ******************************************************************************/
+static void start_next_operation(bool erase_ahead)
+{
+  staging_buffer_t *next = NULL;
+  uint32_t i;
+
+  for (i = 0; i < SL_FLASH_WRITER_BUFFER_COUNT; i++) {
+    staging_buffer_t *buffer = &buffers[i];
+
+    if ((buffer->state == BUFFER_PENDING)
+        && ((next == NULL)
+            || ((int32_t)(buffer->sequence - next->sequence) < 0))) {
+      next = buffer;
+    }
+  }
+
+  if (next != NULL) {
+    if (next->base >= erased_end) {
+      // Pages are erased in order up to the one of the buffer
+      start_erase(erased_end);
+    } else {
+      start_program(next);
+    }
+  } else if (erase_ahead
+             && (erased_end < region_end)
+             && (erased_end <= write_page + FLASH_PAGE_SIZE)) {
+    start_erase(erased_end);
+  }
+}
+
+/***************************************************************************//**
+ * Start programming a buffer with the DMA.
+ *
+ * @param buffer  Pending buffer, in an erased page.
+ ******************************************************************************/
+static void start_program(staging_buffer_t *buffer)
+{
+  uint32_t words = buffer->end_word - buffer->first_word;
+  Ecode_t ecode;
+
+  msc_unlock();
+  MSC->WRITECTRL_SET = MSC_WRITECTRL_WREN;
+  MSC->ADDRB = buffer->base + (buffer->first_word * 4U);
+
+  if ((MSC->STATUS & MSC_STATUS_INVADDR) != 0U) {
+    MSC->WRITECTRL_CLR = MSC_WRITECTRL_WREN;
+    msc_restore_lock();
+    record_error(SL_STATUS_FLASH_PROGRAM_FAILED);
+    buffer->state = BUFFER_FREE;
+    return;
+  }
+
+  buffer->state = BUFFER_PROGRAMMING;
+  operation = OPERATION_PROGRAM;
+
+  ecode = DMADRV_MemoryPeripheral(dma_channel,
+                                  dmadrvPeripheralSignal_MSC_WDATA,
+                                  (void *)&MSC->WDATA,
+                                  &buffer->data[buffer->first_word],
+                                  true,
+                                  (int)words,
+                                  dmadrvDataSize4,
+                                  on_program_complete,
+                                  buffer);
+  if (ecode != ECODE_EMDRV_DMADRV_OK) {
+    MSC->WRITECTRL_CLR = MSC_WRITECTRL_WREN;
+    msc_restore_lock();
+    record_error(SL_STATUS_FAIL);
+    buffer->state = BUFFER_FREE;
+    operation = OPERATION_NONE;
+  }
+}
+
+/***************************************************************************//**
+ * Start erasing a page. Completion is polled by service().
+ *
+ * @param page  Page address.
+ ******************************************************************************/
+static void start_erase(uint32_t page)
+{
+  msc_unlock();
+  MSC->WRITECTRL_SET = MSC_WRITECTRL_WREN;
+  MSC->ADDRB = page;
+
+  if ((MSC->STATUS & MSC_STATUS_INVADDR) != 0U) {
+    MSC->WRITECTRL_CLR = MSC_WRITECTRL_WREN;
+    msc_restore_lock();
+    record_error(SL_STATUS_FLASH_ERASE_FAILED);
+    erased_end += FLASH_PAGE_SIZE;
+    return;
+  }
+
+  MSC->WRITECMD = MSC_WRITECMD_ERASEPAGE;
+  operation = OPERATION_ERASE;
+}
+
+/***************************************************************************//**
+ * DMA completion callback of a buffer programming.
+ ******************************************************************************/
+static bool on_program_complete(unsigned int channel,
+                                unsigned int sequence_no,
+                                void         *user_param)
+{
+  staging_buffer_t *buffer = (staging_buffer_t *)user_param;
+  sl_status_t status;
+
+  (void)channel;
+  (void)sequence_no;
+
+  MSC->WRITECMD = MSC_WRITECMD_WRITEEND;
+
+  // The last word is still being programmed
+  status = wait_msc_idle();
+  if (status == SL_STATUS_OK) {
+    status = wait_msc_idle();
+  }
+  if ((status == SL_STATUS_OK)
+      && ((MSC->STATUS & MSC_STATUS_LOCKED) != 0U)) {
+    status = SL_STATUS_FLASH_PROGRAM_FAILED;
+  }
+  if (status != SL_STATUS_OK) {
+    record_error(status);
+  }
+
+  MSC->WRITECTRL_CLR = MSC_WRITECTRL_WREN;
+  msc_restore_lock();
+
+  stats.bursts++;
+  stats.words_programmed += buffer->end_word - buffer->first_word;
+
+  buffer->state = BUFFER_FREE;
+  operation = OPERATION_NONE;
+  start_next_operation(false);
+
+  return true;
+}
+
+/***************************************************************************//**
+ * Wait for the MSC to be done with the ongoing write or erase.
+ *
+ * @return SL_STATUS_OK, or SL_STATUS_TIMEOUT.
+ ******************************************************************************/
+static sl_status_t wait_msc_idle(void)
+{
+  uint32_t timeout = MSC_PROGRAM_TIMEOUT;
+
+  while ((MSC->STATUS & (MSC_STATUS_BUSY | MSC_STATUS_PENDING)) != 0U) {
+    if (--timeout == 0U) {
+      return SL_STATUS_TIMEOUT;
+    }
+  }
+
+  return SL_STATUS_OK;
+}
+
+/***************************************************************************//**
+ * Unlock the MSC registers for an operation.
+ ******************************************************************************/
+static void msc_unlock(void)
+{
+  msc_was_locked = MSC_IS_LOCKED();
+  MSC->LOCK = MSC_LOCK_LOCKKEY_UNLOCK;
+}
+
+/***************************************************************************//**
+ * Restore the MSC register lock after an operation.
+ ******************************************************************************/
+static void msc_restore_lock(void)
+{
+  if (msc_was_locked) {
+    MSC->LOCK = MSC_LOCK_LOCKKEY_LOCK;
+  }
+}
+
+/***************************************************************************//**
+ * Keep the first error until the next flush.
+ *
+ * @param status  Error.
+ ******************************************************************************/
+static void record_error(sl_status_t status)
+{
+  if (first_error == SL_STATUS_OK) {
+    first_error = status;
+  }
+}
+
+/***************************************************************************//**
+ * Check whether some buffers are waiting for or being programmed.
+ *
+ * @return true if data is not programmed yet.
+ ******************************************************************************/
+static bool has_unprogrammed_data(void)
+{
+  uint32_t i;
+
+  for (i = 0; i < SL_FLASH_WRITER_BUFFER_COUNT; i++) {
+    if ((buffers[i].state == BUFFER_PENDING)
+        || (buffers[i].state == BUFFER_PROGRAMMING)) {
+      return true;
+    }
+  }
+
+  return false;
+}
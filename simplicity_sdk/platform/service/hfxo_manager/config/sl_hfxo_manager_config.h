@@ -49,6 +49,22 @@
 // <i> Default: 0
 #define SL_HFXO_MANAGER_SLEEPY_CRYSTAL_SUPPORT  0
 
+// <o SL_HFXO_MANAGER_STARTUP_TIME_PERCENTILE> Percentile of the measured HFXO startup times used for early wake-up <0-100>
+// <i> 0 uses the average of the last 10 startups, to which the Power Manager adds a fixed 12.5% margin.
+// <i> Any other value uses that percentile of the recent startups as the startup time, margin included.
+// <i> Default: 0
+#define SL_HFXO_MANAGER_STARTUP_TIME_PERCENTILE  0
+
+// <o SL_HFXO_MANAGER_STARTUP_TIME_HISTORY_SIZE> Number of recent HFXO startups the percentile is taken from <4-64>
+// <i> Default: 32
+#define SL_HFXO_MANAGER_STARTUP_TIME_HISTORY_SIZE  32
+
+// <o SL_HFXO_MANAGER_STARTUP_TIME_TEMPERATURE_BAND> Temperature band in degrees Celsius <0-100>
+// <i> Only the startups measured within this many degrees of the current temperature are used for the percentile,
+// <i> as long as there are at least a quarter of the history size of them. 0 ignores the temperature.
+// <i> Default: 10
+#define SL_HFXO_MANAGER_STARTUP_TIME_TEMPERATURE_BAND  10
+
 // </h>
 
 #endif /* SL_HFXO_MANAGER_CONFIG_H */
@@ -79,6 +79,7 @@
 
 #include "sl_status.h"
 #include <stdbool.h>
+#include <stdint.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -90,6 +91,17 @@ typedef struct sl_hfxo_manager_sleepy_xtal_settings {
   uint32_t core_bias_current; ///< Core Bias current value during all stages
 } sl_hfxo_manager_sleepy_xtal_settings_t;
 
+/// @brief HFXO startup time statistics
+typedef struct sl_hfxo_manager_startup_statistics {
+  uint32_t startup_time_tick;         ///< Startup time currently used to schedule early wake-ups
+  uint32_t latest_startup_time_tick;  ///< Latest measured startup time
+  uint32_t min_startup_time_tick;     ///< Shortest measured startup time, 0 if none was measured
+  uint32_t max_startup_time_tick;     ///< Longest measured startup time
+  uint32_t measurement_count;         ///< Number of startup time measurements
+  uint32_t miss_count;                ///< Startups that took longer than the startup time in use when they started
+  uint32_t rejected_count;            ///< Measurements discarded as out of bound
+} sl_hfxo_manager_startup_statistics_t;
+
 /***************************************************************************//**
  * HFXO Manager module hardware specific initialization.
  ******************************************************************************/
@@ -125,6 +137,26 @@ sl_status_t sl_hfxo_manager_update_sleepy_xtal_settings(const sl_hfxo_manager_sl
  ******************************************************************************/
 void sl_hfxo_manager_notify_consecutive_failed_startups(void);
 
+/***************************************************************************//**
+ * Retrieves HFXO startup time statistics.
+ *
+ * @param  stats  Pointer to statistics structure to fill.
+ *
+ * @return Status Code.
+ *
+ * @note Times are given in sleeptimer ticks. A high miss count means the
+ *       early wake-up margin is too small, a startup time well above the
+ *       maximum means it is too large.
+ ******************************************************************************/
+sl_status_t sl_hfxo_manager_get_startup_statistics(sl_hfxo_manager_startup_statistics_t *stats);
+
+/***************************************************************************//**
+ * Clears the HFXO startup time statistics counters.
+ *
+ * @note The startup time history used to compute the startup time is kept.
+ ******************************************************************************/
+void sl_hfxo_manager_reset_startup_statistics(void);
+
 /***************************************************************************//**
  * HFXO Manager HFXO interrupt handler.
  *
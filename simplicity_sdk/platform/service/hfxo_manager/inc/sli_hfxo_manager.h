@@ -81,6 +81,15 @@ uint32_t sli_hfxo_manager_get_startup_time(void);
  ******************************************************************************/
 uint32_t sli_hfxo_manager_get_latest_startup_time(void);
 
+/***************************************************************************//**
+ * Checks if the HFXO startup time already includes a margin for variations.
+ *
+ * @return True, if a startup time percentile is used.
+ *         False, if the startup time is an average and the caller must add
+ *         its own margin.
+ ******************************************************************************/
+bool sli_hfxo_manager_is_startup_time_margin_included(void);
+
 /***************************************************************************//**
  * Checks if HFXO is ready and, if needed, waits for it to be.
  *
@@ -32,10 +32,13 @@
 #include "sl_hfxo_manager.h"
 #include "sli_hfxo_manager.h"
 #include "sli_hfxo_manager_internal.h"
+#include "sl_hfxo_manager_config.h"
 #include "sl_sleeptimer.h"
 #include "sl_assert.h"
+#include "sl_core.h"
 #include "sl_status.h"
 #include <stdbool.h>
+#include <stdint.h>
 
 /*******************************************************************************
  *********************************   DEFINES   *********************************
@@ -46,10 +49,42 @@
 // Default time value in microseconds required to wake-up the hfxo oscillator.
 #define HFXO_STARTUP_TIME_DEFAULT_VALUE_US  (600u)
 
+#ifndef SL_HFXO_MANAGER_STARTUP_TIME_PERCENTILE
+#define SL_HFXO_MANAGER_STARTUP_TIME_PERCENTILE  0
+#endif
+
+#ifndef SL_HFXO_MANAGER_STARTUP_TIME_HISTORY_SIZE
+#define SL_HFXO_MANAGER_STARTUP_TIME_HISTORY_SIZE  32
+#endif
+
+#ifndef SL_HFXO_MANAGER_STARTUP_TIME_TEMPERATURE_BAND
+#define SL_HFXO_MANAGER_STARTUP_TIME_TEMPERATURE_BAND  10
+#endif
+
+#if (SL_HFXO_MANAGER_STARTUP_TIME_PERCENTILE > 100)
+#error "SL_HFXO_MANAGER_STARTUP_TIME_PERCENTILE must be between 0 and 100"
+#endif
+
+#if (SL_HFXO_MANAGER_STARTUP_TIME_PERCENTILE > 0) \
+  && ((SL_HFXO_MANAGER_STARTUP_TIME_HISTORY_SIZE < 4) || (SL_HFXO_MANAGER_STARTUP_TIME_HISTORY_SIZE > 64))
+#error "SL_HFXO_MANAGER_STARTUP_TIME_HISTORY_SIZE must be between 4 and 64"
+#endif
+
+// Offset between Kelvin and degrees Celsius
+#define HFXO_KELVIN_TO_CELSIUS_OFFSET  (273)
+
 /*******************************************************************************
  *****************************   DATA TYPES   **********************************
  ******************************************************************************/
 
+#if (SL_HFXO_MANAGER_STARTUP_TIME_PERCENTILE > 0)
+// HFXO startup time measurement and the temperature it was taken at
+typedef struct {
+  uint32_t startup_time;
+  int16_t temperature;
+} hfxo_startup_sample_t;
+#endif
+
 /*******************************************************************************
  ***************************  LOCAL VARIABLES   ********************************
  ******************************************************************************/
@@ -59,16 +94,39 @@ static volatile uint32_t hfxo_startup_time_tick = 0;
 
 static volatile uint32_t hfxo_last_startup_time = 0;
 
+#if (SL_HFXO_MANAGER_STARTUP_TIME_PERCENTILE > 0)
+static hfxo_startup_sample_t hfxo_startup_history[SL_HFXO_MANAGER_STARTUP_TIME_HISTORY_SIZE];
+
+static uint8_t hfxo_startup_history_index = 0;
+#else
 static uint32_t hfxo_startup_time_table[HFXO_STARTUP_TIME_TABLE_SIZE];
 
 static uint8_t hfxo_startup_time_table_index = 0;
 
 static uint32_t hfxo_startup_time_sum_average = 0;
+#endif
+
+// Startup time statistics
+static uint32_t hfxo_startup_measurement_count = 0;
+static uint32_t hfxo_startup_miss_count = 0;
+static uint32_t hfxo_startup_rejected_count = 0;
+static uint32_t hfxo_startup_time_min = UINT32_MAX;
+static uint32_t hfxo_startup_time_max = 0;
 
 static volatile uint32_t hfxo_startup_time_tc_initial = 0;
 
 static volatile bool hfxo_measurement_on = false;
 
+/*******************************************************************************
+ **************************   LOCAL FUNCTIONS   ********************************
+ ******************************************************************************/
+
+#if (SL_HFXO_MANAGER_STARTUP_TIME_PERCENTILE > 0)
+static int16_t get_temperature(void);
+
+static uint32_t get_startup_time_percentile(int16_t temperature);
+#endif
+
 /*******************************************************************************
  **************************   GLOBAL FUNCTIONS   *******************************
  ******************************************************************************/
@@ -100,10 +158,18 @@ sl_status_t sl_hfxo_manager_init(void)
 
   // Set HFXO startup time to conservative default value
   hfxo_startup_time_tick = (((HFXO_STARTUP_TIME_DEFAULT_VALUE_US * sl_sleeptimer_get_timer_frequency()) + (1000000 - 1)) / 1000000);
+#if (SL_HFXO_MANAGER_STARTUP_TIME_PERCENTILE > 0)
+  int16_t temperature = get_temperature();
+  for (uint8_t i = 0; i < SL_HFXO_MANAGER_STARTUP_TIME_HISTORY_SIZE; i++) {
+    hfxo_startup_history[i].startup_time = hfxo_startup_time_tick;
+    hfxo_startup_history[i].temperature = temperature;
+  }
+#else
   for (uint8_t i = 0; i < HFXO_STARTUP_TIME_TABLE_SIZE; i++) {
     hfxo_startup_time_table[i] = hfxo_startup_time_tick;
     hfxo_startup_time_sum_average += hfxo_startup_time_tick;
   }
+#endif
 
   return SL_STATUS_OK;
 }
@@ -137,6 +203,50 @@ __WEAK void sl_hfxo_manager_notify_consecutive_failed_startups(void)
   EFM_ASSERT(false);
 }
 
+/***************************************************************************//**
+ * Retrieves HFXO startup time statistics.
+ *
+ * @param  stats  Pointer to statistics structure to fill.
+ *
+ * @return Status Code.
+ ******************************************************************************/
+sl_status_t sl_hfxo_manager_get_startup_statistics(sl_hfxo_manager_startup_statistics_t *stats)
+{
+  CORE_DECLARE_IRQ_STATE;
+
+  if (stats == NULL) {
+    return SL_STATUS_NULL_POINTER;
+  }
+
+  CORE_ENTER_ATOMIC();
+  stats->startup_time_tick = hfxo_startup_time_tick;
+  stats->latest_startup_time_tick = hfxo_last_startup_time;
+  stats->min_startup_time_tick = (hfxo_startup_measurement_count == 0) ? 0 : hfxo_startup_time_min;
+  stats->max_startup_time_tick = hfxo_startup_time_max;
+  stats->measurement_count = hfxo_startup_measurement_count;
+  stats->miss_count = hfxo_startup_miss_count;
+  stats->rejected_count = hfxo_startup_rejected_count;
+  CORE_EXIT_ATOMIC();
+
+  return SL_STATUS_OK;
+}
+
+/***************************************************************************//**
+ * Clears the HFXO startup time statistics counters.
+ ******************************************************************************/
+void sl_hfxo_manager_reset_startup_statistics(void)
+{
+  CORE_DECLARE_IRQ_STATE;
+
+  CORE_ENTER_ATOMIC();
+  hfxo_startup_measurement_count = 0;
+  hfxo_startup_miss_count = 0;
+  hfxo_startup_rejected_count = 0;
+  hfxo_startup_time_min = UINT32_MAX;
+  hfxo_startup_time_max = 0;
+  CORE_EXIT_ATOMIC();
+}
+
 /*******************************************************************************
  **********************   GLOBAL INTERNAL FUNCTIONS   **************************
  ******************************************************************************/
@@ -198,10 +308,36 @@ void sli_hfxo_manager_end_startup_measurement(void)
   default_startup_ticks = (((HFXO_STARTUP_TIME_DEFAULT_VALUE_US * sl_sleeptimer_get_timer_frequency()) + (1000000 - 1)) / 1000000);
   EFM_ASSERT(hfxo_last_startup_time <= default_startup_ticks);
   if (hfxo_last_startup_time > default_startup_ticks) {
+    hfxo_startup_rejected_count++;
+    hfxo_startup_miss_count++;
     hfxo_measurement_on = false;
     return;
   }
 
+  // Update statistics, a startup longer than the expected time means the
+  // early wake-up was late.
+  hfxo_startup_measurement_count++;
+  if (hfxo_last_startup_time > hfxo_startup_time_tick) {
+    hfxo_startup_miss_count++;
+  }
+  if (hfxo_last_startup_time < hfxo_startup_time_min) {
+    hfxo_startup_time_min = hfxo_last_startup_time;
+  }
+  if (hfxo_last_startup_time > hfxo_startup_time_max) {
+    hfxo_startup_time_max = hfxo_last_startup_time;
+  }
+
+#if (SL_HFXO_MANAGER_STARTUP_TIME_PERCENTILE > 0)
+  // Use the configured percentile of the recent startups as HFXO restore time
+  int16_t temperature = get_temperature();
+  hfxo_startup_history[hfxo_startup_history_index].startup_time = hfxo_last_startup_time;
+  hfxo_startup_history[hfxo_startup_history_index].temperature = temperature;
+  hfxo_startup_time_tick = get_startup_time_percentile(temperature);
+
+  // Update index of startup time history
+  hfxo_startup_history_index++;
+  hfxo_startup_history_index %= SL_HFXO_MANAGER_STARTUP_TIME_HISTORY_SIZE;
+#else
   // Calculate average for HFXO restore time
   hfxo_startup_time_sum_average -= (int32_t)hfxo_startup_time_table[hfxo_startup_time_table_index] - (int32_t)hfxo_last_startup_time;
   hfxo_startup_time_table[hfxo_startup_time_table_index] = hfxo_last_startup_time;
@@ -210,6 +346,7 @@ void sli_hfxo_manager_end_startup_measurement(void)
   // Update index of wakeup time table
   hfxo_startup_time_table_index++;
   hfxo_startup_time_table_index %= HFXO_STARTUP_TIME_TABLE_SIZE;
+#endif
 
   hfxo_measurement_on = false;
 }
@@ -233,3 +370,89 @@ uint32_t sli_hfxo_manager_get_latest_startup_time(void)
 {
   return hfxo_last_startup_time;
 }
+
+/***************************************************************************//**
+ * Checks if the HFXO startup time already includes a margin for variations.
+ *
+ * @return  True, if a startup time percentile is used, false otherwise.
+ ******************************************************************************/
+bool sli_hfxo_manager_is_startup_time_margin_included(void)
+{
+  return (SL_HFXO_MANAGER_STARTUP_TIME_PERCENTILE > 0);
+}
+
+#if (SL_HFXO_MANAGER_STARTUP_TIME_PERCENTILE > 0)
+/*******************************************************************************
+ **************************   LOCAL FUNCTIONS   ********************************
+ ******************************************************************************/
+
+/***************************************************************************//**
+ * Gets the die temperature used to sort startup time measurements.
+ *
+ * @return  Temperature in degrees Celsius, 0 if not available.
+ ******************************************************************************/
+static int16_t get_temperature(void)
+{
+#if defined(_EMU_TEMP_TEMP_MASK) && (SL_HFXO_MANAGER_STARTUP_TIME_TEMPERATURE_BAND > 0)
+  // The EMU temperature sensor is updated periodically in hardware,
+  // the integer part of the value is in Kelvin.
+  return (int16_t)((int32_t)((EMU->TEMP & _EMU_TEMP_TEMP_MASK) >> _EMU_TEMP_TEMP_SHIFT)
+                   - HFXO_KELVIN_TO_CELSIUS_OFFSET);
+#else
+  return 0;
+#endif
+}
+
+/***************************************************************************//**
+ * Computes the configured percentile of the startup time history.
+ *
+ * @param  temperature  Current temperature in degrees Celsius.
+ *
+ * @return  Startup time percentile.
+ *
+ * @note Only the measurements taken close to the current temperature are used,
+ *       unless there are too few of them.
+ ******************************************************************************/
+static uint32_t get_startup_time_percentile(int16_t temperature)
+{
+  uint32_t values[SL_HFXO_MANAGER_STARTUP_TIME_HISTORY_SIZE];
+  uint32_t count = 0;
+  uint32_t rank;
+
+  for (uint32_t i = 0; i < SL_HFXO_MANAGER_STARTUP_TIME_HISTORY_SIZE; i++) {
+    int32_t delta = (int32_t)hfxo_startup_history[i].temperature - temperature;
+
+    if ((delta <= SL_HFXO_MANAGER_STARTUP_TIME_TEMPERATURE_BAND)
+        && (delta >= -SL_HFXO_MANAGER_STARTUP_TIME_TEMPERATURE_BAND)) {
+      values[count++] = hfxo_startup_history[i].startup_time;
+    }
+  }
+
+  if (count < (SL_HFXO_MANAGER_STARTUP_TIME_HISTORY_SIZE / 4)) {
+    count = 0;
+    for (uint32_t i = 0; i < SL_HFXO_MANAGER_STARTUP_TIME_HISTORY_SIZE; i++) {
+      values[count++] = hfxo_startup_history[i].startup_time;
+    }
+  }
+
+  // Insertion sort, the history is small
+  for (uint32_t i = 1; i < count; i++) {
+    uint32_t value = values[i];
+    uint32_t j = i;
+
+    while ((j > 0) && (values[j - 1] > value)) {
+      values[j] = values[j - 1];
+      j--;
+    }
+    values[j] = value;
+  }
+
+  // Nearest-rank percentile
+  rank = ((count * SL_HFXO_MANAGER_STARTUP_TIME_PERCENTILE) + 99) / 100;
+  if (rank == 0) {
+    rank = 1;
+  }
+
+  return values[rank - 1];
+}
+#endif
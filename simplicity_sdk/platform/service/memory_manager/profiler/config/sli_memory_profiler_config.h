@@ -57,6 +57,49 @@
 #define SLI_MEMORY_PROFILER_RTT_BUFFER_SIZE  1024
 
 // </h>
+
+// <e SLI_MEMORY_PROFILER_ENABLE_AGGREGATION> Aggregate allocations on the device
+// <i> Default: 0
+// <i>
+// <i> When enabled, allocations, reallocations and frees are not sent as
+// <i> individual events. The device instead keeps live bytes, peak bytes and
+// <i> allocation and free counts per call site, and sends the changes to the
+// <i> counters in batches when "sli_memory_profiler_flush()" is called or when
+// <i> "sli_memory_profiler_process_action()" finds enough changes pending.
+// <i> Tracker, snapshot and log events are sent as before.
+#define SLI_MEMORY_PROFILER_ENABLE_AGGREGATION 0
+
+// <o SLI_MEMORY_PROFILER_AGGREGATION_SITE_COUNT> Number of call sites
+// <16=> 16
+// <32=> 32
+// <64=> 64
+// <128=> 128
+// <256=> 256
+// <i> Default: 64
+// <i> Number of call sites with their own counters. Allocations from call
+// <i> sites that don't fit in the table are counted on a shared overflow site.
+#define SLI_MEMORY_PROFILER_AGGREGATION_SITE_COUNT  64
+
+// <o SLI_MEMORY_PROFILER_AGGREGATION_BLOCK_COUNT> Number of live blocks <16-1024>
+// <i> Default: 128
+// <i> Number of live memory blocks that can be tracked, which is needed to
+// <i> account frees to the call site of the allocation. Allocations that don't
+// <i> fit in the table are counted as dropped.
+#define SLI_MEMORY_PROFILER_AGGREGATION_BLOCK_COUNT  128
+
+// <o SLI_MEMORY_PROFILER_AGGREGATION_BATCH_SIZE> Maximum batch payload size <64-252>
+// <i> Default: 240
+// <i> Maximum payload size in bytes of a batch event.
+#define SLI_MEMORY_PROFILER_AGGREGATION_BATCH_SIZE  240
+
+// <o SLI_MEMORY_PROFILER_AGGREGATION_FLUSH_THRESHOLD> Flush threshold <0-65535>
+// <i> Default: 64
+// <i> Number of tracked operations after which
+// <i> "sli_memory_profiler_process_action()" flushes the counters. With 0, every
+// <i> call flushes the pending changes.
+#define SLI_MEMORY_PROFILER_AGGREGATION_FLUSH_THRESHOLD  64
+
+// </e>
 // <<< end of configuration section >>>
 
 #endif /* SLI_MEMORY_PROFILER_CONFIG_H */
@@ -501,6 +501,63 @@ void sli_memory_profiler_log(uint32_t log_id,
                              uint32_t arg3,
                              void * pc);
 
+/**
+ * @brief Event transport
+ *
+ * The events are written to the RTT by default. A different transport can be
+ * set with @ref sli_memory_profiler_set_transport(), for example to write the
+ * events to a file when the profiler runs in a host build.
+ */
+typedef struct {
+  /// Called when the profiler starts to use the transport. May be NULL.
+  void (*init)(void);
+
+  /// Write one complete event. Called with interrupts masked, so that events
+  /// are written in the order of their sequence numbers.
+  void (*write)(const void *data, size_t length);
+} sli_memory_profiler_transport_t;
+
+/**
+ * @brief Set the transport used for the events
+ *
+ * If the memory profiler is already initialized, the init event is sent again
+ * on the new transport so that the receiver can sync to the event stream.
+ *
+ * @param[in] transport Transport to use, or NULL to drop the events. The
+ *   transport must stay valid until it is replaced.
+ */
+void sli_memory_profiler_set_transport(const sli_memory_profiler_transport_t *transport);
+
+/**
+ * @brief Send the pending changes of the aggregated counters
+ *
+ * When the aggregation is enabled with `SLI_MEMORY_PROFILER_ENABLE_AGGREGATION`,
+ * the live bytes, peak bytes and allocation and free counts of each call site
+ * are kept on the device. This function sends the changes made to the counters
+ * since the previous flush, as batch events in which each call site that has
+ * changed is encoded with the difference to the previously sent values. A
+ * call site is identified by the tracker and the program counter of the owner
+ * of the allocations.
+ *
+ * The batches are built and sent one at a time, so that interrupts are masked
+ * only for the duration of one batch.
+ *
+ * This function does nothing when the aggregation is disabled.
+ */
+void sli_memory_profiler_flush(void);
+
+/**
+ * @brief Flush the aggregated counters when enough changes are pending
+ *
+ * Meant to be called periodically, for example from the application's main
+ * loop or a low priority task. The counters are flushed when at least
+ * `SLI_MEMORY_PROFILER_AGGREGATION_FLUSH_THRESHOLD` allocations, reallocations,
+ * frees or ownership changes have been tracked since the previous flush.
+ *
+ * This function does nothing when the aggregation is disabled.
+ */
+void sli_memory_profiler_process_action(void);
+
 // The macros expand to their full content only when profiling is included
 #if SLI_MEMORY_PROFILER_ENABLE_PROFILING
 
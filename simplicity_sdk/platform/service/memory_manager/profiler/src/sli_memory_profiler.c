@@ -36,8 +36,17 @@
 #include "sli_memory_profiler_config.h"
 #include "sl_common.h"
 #include "em_core.h"
+
+// Host builds without the RTT disable the default transport and set their own
+// with sli_memory_profiler_set_transport()
+#if !defined(SLI_MEMORY_PROFILER_ENABLE_RTT_TRANSPORT)
+#define SLI_MEMORY_PROFILER_ENABLE_RTT_TRANSPORT 1
+#endif
+
+#if SLI_MEMORY_PROFILER_ENABLE_RTT_TRANSPORT
 #include "SEGGER_RTT.h"
 #include "sl_rtt_buffer_index.h"
+#endif
 
 // The type byte is composed of flag bits and a field for the event ID
 #define SLI_MEMPROF_EVENT_FLAG_HAS_CHECKSUM ((uint8_t) 0x80)
@@ -55,9 +64,16 @@
 #define SLI_MEMPROF_EVENT_TRACK_OWNERSHIP_ID      9
 #define SLI_MEMPROF_EVENT_TAKE_SNAPSHOT_ID        10
 #define SLI_MEMPROF_EVENT_LOG_ID                  11
-
-// Version of the binary format for the events we send over RTT
+#define SLI_MEMPROF_EVENT_AGGREGATE_BATCH_ID      12
+
+// Version of the binary format for the events we send over RTT. The aggregated
+// event stream has its own version, as it lacks the individual allocation
+// events that the host expects in the normal stream.
+#if SLI_MEMORY_PROFILER_ENABLE_AGGREGATION
+#define SLI_MEMPROF_EVENT_FORMAT_VERSION 10
+#else
 #define SLI_MEMPROF_EVENT_FORMAT_VERSION 9
+#endif
 
 /**
  * @brief Maximum length of a tracker description string
@@ -193,22 +209,153 @@ typedef __PACKED_STRUCT {
   uint32_t  pc;                 ///< The program counter at the location of the log call
 } sli_memprof_evt_log_t;
 
+#if SLI_MEMORY_PROFILER_ENABLE_AGGREGATION
+
+#if (SLI_MEMORY_PROFILER_AGGREGATION_SITE_COUNT & (SLI_MEMORY_PROFILER_AGGREGATION_SITE_COUNT - 1)) != 0
+#error "SLI_MEMORY_PROFILER_AGGREGATION_SITE_COUNT must be a power of two"
+#endif
+
+#if SLI_MEMORY_PROFILER_AGGREGATION_BATCH_SIZE > 252
+#error "SLI_MEMORY_PROFILER_AGGREGATION_BATCH_SIZE must fit in the event length"
+#endif
+
+// Site that counts the allocations of the sites that don't fit in the table
+#define OVERFLOW_SITE_INDEX 0
+
+// Number of table slots probed when looking for a site
+#define MAX_SITE_PROBES 8
+
+// Flag bits in the "flags" field of "sli_memprof_site_t"
+#define SITE_FLAG_USED      ((uint8_t) 0x01)
+#define SITE_FLAG_ANNOUNCED ((uint8_t) 0x02)
+#define SITE_FLAG_DIRTY     ((uint8_t) 0x04)
+
+// Maximum length of an encoded 32-bit value
+#define VARINT_MAX_LEN 5
+
+// Maximum length of an encoded site record: the site index with the
+// announcement flag, the optional PC and tracker, and the four counter deltas
+#define MAX_BATCH_RECORD_LEN (2 + 6 * VARINT_MAX_LEN)
+
+/**
+ * @brief Event structure for the "aggregate_batch" event
+ *
+ * The payload starts with the number of allocations dropped since the
+ * previous batch because the block table was full. One record per call site
+ * follows, until the end of the payload. All values are encoded as unsigned
+ * LEB128 varints:
+ *
+ * - The site index shifted left by one. Bit 0 is set on the first record of a
+ *   site, which is then followed by the PC and the tracker handle of the site.
+ * - The change of the live bytes, zigzag encoded.
+ * - The increase of the peak bytes.
+ * - The number of allocations since the previous record of the site.
+ * - The number of frees since the previous record of the site.
+ */
+typedef __PACKED_STRUCT {
+  sli_memprof_evt_hdr_t header;                               ///< The common event header
+  uint8_t payload[SLI_MEMORY_PROFILER_AGGREGATION_BATCH_SIZE]; ///< Encoded records
+} sli_memprof_evt_aggregate_batch_t;
+
+/**
+ * @brief Counters of one call site
+ */
+typedef struct {
+  uint32_t pc;               ///< The program counter of the owner
+  uint32_t tracker;          ///< The tracker the allocations are made on
+  uint32_t live_bytes;       ///< Bytes currently allocated
+  uint32_t peak_bytes;       ///< Highest number of bytes allocated at once
+  uint32_t alloc_count;      ///< Number of allocations
+  uint32_t free_count;       ///< Number of frees
+  uint32_t sent_live_bytes;  ///< Live bytes sent in the latest batch
+  uint32_t sent_peak_bytes;  ///< Peak bytes sent in the latest batch
+  uint32_t sent_alloc_count; ///< Allocation count sent in the latest batch
+  uint32_t sent_free_count;  ///< Free count sent in the latest batch
+  uint8_t  flags;            ///< SITE_FLAG_ bits
+} sli_memprof_site_t;
+
+/**
+ * @brief Live memory block
+ */
+typedef struct {
+  uint32_t ptr;     ///< Pointer to the block
+  uint32_t size;    ///< Size of the block
+  uint32_t tracker; ///< The tracker the block was allocated on
+  uint16_t site;    ///< Index of the site that owns the block
+} sli_memprof_block_t;
+
+/** @brief Call site counters, indexed by a hash of the tracker and the PC */
+static sli_memprof_site_t sites[SLI_MEMORY_PROFILER_AGGREGATION_SITE_COUNT];
+
+/** @brief Live blocks, sorted by address. Nested blocks follow their parent. */
+static sli_memprof_block_t blocks[SLI_MEMORY_PROFILER_AGGREGATION_BLOCK_COUNT];
+
+/** @brief Number of live blocks */
+static size_t block_count = 0;
+
+/** @brief Allocations not tracked because the block table was full */
+static uint32_t dropped_count = 0;
+
+/** @brief Dropped allocations sent in the latest batch */
+static uint32_t sent_dropped_count = 0;
+
+/** @brief Tracked operations since the latest flush */
+static uint32_t pending_operation_count = 0;
+
+#endif // SLI_MEMORY_PROFILER_ENABLE_AGGREGATION
+
 /** brief Set to true when the Memory Profiler has initialized */
 static bool memory_profiler_initialized = false;
 
 /** @brief The sequence number for the next event to send */
 static uint8_t next_sequence_number = 0;
 
+#if SLI_MEMORY_PROFILER_ENABLE_RTT_TRANSPORT
 /**
  * @brief RTT buffer for sending events
  */
 static uint8_t rtt_buffer[SLI_MEMORY_PROFILER_RTT_BUFFER_SIZE];
 
 /**
- * @brief Send a memory profiler event over RTT
+ * @brief Configure the RTT buffer for our events
+ */
+static void rtt_transport_init(void)
+{
+  SEGGER_RTT_ConfigUpBuffer(SL_MEMORY_PROFILER_RTT_BUFFER_INDEX,
+                            "sli_memory_profiler",
+                            rtt_buffer,
+                            sizeof(rtt_buffer),
+                            SEGGER_RTT_MODE_BLOCK_IF_FIFO_FULL);
+}
+
+/**
+ * @brief Write an event to the RTT buffer
+ */
+static void rtt_transport_write(const void *data, size_t length)
+{
+  SEGGER_RTT_Write(SL_MEMORY_PROFILER_RTT_BUFFER_INDEX, data, length);
+}
+
+/**
+ * @brief The default transport
+ */
+static const sli_memory_profiler_transport_t rtt_transport = {
+  .init = rtt_transport_init,
+  .write = rtt_transport_write,
+};
+
+/** @brief The transport used for the events */
+static const sli_memory_profiler_transport_t *transport = &rtt_transport;
+#else
+/** @brief The transport used for the events */
+static const sli_memory_profiler_transport_t *transport = NULL;
+#endif
+
+/**
+ * @brief Send a memory profiler event
  *
  * This function fills the event header of the specified event structure and
- * sends the event over the RTT.
+ * sends the event over the transport.
  *
  * @param[in] header Pointer to the header structure. The payload must follow
  *   right after the header in contiguous memory addresses
@@ -226,9 +373,406 @@ static void send_memory_profiler_event(sli_memprof_evt_hdr_t *header,
   header->seq_num = next_sequence_number++;
 
   // Send the event
-  SEGGER_RTT_Write(SL_MEMORY_PROFILER_RTT_BUFFER_INDEX, header, event_len);
+  if (transport != NULL) {
+    transport->write(header, event_len);
+  }
 }
 
+#if SLI_MEMORY_PROFILER_ENABLE_AGGREGATION
+/**
+ * @brief Get the index of the site of a tracker and a PC, adding it if needed
+ *
+ * @param[in] tracker The tracker handle
+ * @param[in] pc The program counter of the owner
+ *
+ * @return The site index, or OVERFLOW_SITE_INDEX if the site doesn't fit
+ */
+static uint16_t get_site(uint32_t tracker, uint32_t pc)
+{
+  uint32_t hash = pc ^ (tracker * 2654435761UL);
+  hash ^= hash >> 16;
+
+  // Sites are never removed, so the first unused slot ends the search
+  for (uint32_t probe = 0; probe < MAX_SITE_PROBES; probe++) {
+    uint16_t index = (uint16_t) ((hash + probe) & (SLI_MEMORY_PROFILER_AGGREGATION_SITE_COUNT - 1));
+    sli_memprof_site_t *site = &sites[index];
+
+    if (index == OVERFLOW_SITE_INDEX) {
+      continue;
+    }
+    if ((site->flags & SITE_FLAG_USED) == 0) {
+      memset(site, 0, sizeof(*site));
+      site->pc = pc;
+      site->tracker = tracker;
+      site->flags = SITE_FLAG_USED;
+      return index;
+    }
+    if ((site->pc == pc) && (site->tracker == tracker)) {
+      return index;
+    }
+  }
+
+  return OVERFLOW_SITE_INDEX;
+}
+
+/**
+ * @brief Change the live bytes of a site
+ */
+static void site_resize(uint16_t index, uint32_t old_size, uint32_t new_size)
+{
+  sli_memprof_site_t *site = &sites[index];
+
+  site->live_bytes = site->live_bytes - old_size + new_size;
+  if (site->live_bytes > site->peak_bytes) {
+    site->peak_bytes = site->live_bytes;
+  }
+  site->flags |= SITE_FLAG_DIRTY;
+}
+
+/**
+ * @brief Count an allocation on a site
+ */
+static void site_add_block(uint16_t index, uint32_t size)
+{
+  site_resize(index, 0, size);
+  sites[index].alloc_count++;
+}
+
+/**
+ * @brief Count a free on a site
+ */
+static void site_remove_block(uint16_t index, uint32_t size)
+{
+  site_resize(index, size, 0);
+  sites[index].free_count++;
+}
+
+/**
+ * @brief Move a live block to another site
+ *
+ * The move is counted as a free on the previous site and as an allocation on
+ * the new one, so that the allocation count minus the free count stays the
+ * number of live blocks of each site.
+ */
+static void set_block_site(sli_memprof_block_t *block, uint16_t index)
+{
+  if (block->site != index) {
+    site_remove_block(block->site, block->size);
+    site_add_block(index, block->size);
+    block->site = index;
+  }
+}
+
+/**
+ * @brief Get the index of the first block at or after an address
+ */
+static size_t find_block_index(uint32_t ptr)
+{
+  size_t low = 0;
+  size_t high = block_count;
+
+  while (low < high) {
+    size_t middle = low + (high - low) / 2;
+    if (blocks[middle].ptr < ptr) {
+      low = middle + 1;
+    } else {
+      high = middle;
+    }
+  }
+
+  return low;
+}
+
+/**
+ * @brief Find the innermost block of a tracker at an address
+ *
+ * @param[in] tracker The tracker handle, or SLI_INVALID_MEMORY_TRACKER_HANDLE
+ *   to find the innermost block of any tracker
+ * @param[in] ptr Pointer to the block
+ *
+ * @return The block, or NULL if it's not tracked
+ */
+static sli_memprof_block_t *find_block(uint32_t tracker, uint32_t ptr)
+{
+  sli_memprof_block_t *found = NULL;
+
+  // Blocks at the same address are sorted from the outermost to the innermost
+  for (size_t i = find_block_index(ptr); (i < block_count) && (blocks[i].ptr == ptr); i++) {
+    if ((tracker == (uint32_t) (uintptr_t) SLI_INVALID_MEMORY_TRACKER_HANDLE)
+        || (blocks[i].tracker == tracker)) {
+      found = &blocks[i];
+    }
+  }
+
+  return found;
+}
+
+/**
+ * @brief Get the index after the last block nested in a block
+ */
+static size_t find_nested_end(size_t index)
+{
+  uint32_t end = blocks[index].ptr + blocks[index].size;
+  size_t i = index + 1;
+
+  while ((i < block_count) && (blocks[i].ptr < end)) {
+    i++;
+  }
+
+  return i;
+}
+
+/**
+ * @brief Aggregate the allocation of a memory block
+ */
+static void aggregate_alloc(uint32_t tracker, uint32_t ptr, uint32_t size, uint32_t pc)
+{
+  size_t index;
+
+  if (ptr == 0) {
+    // Failed allocations don't change the counters
+    return;
+  }
+
+  pending_operation_count++;
+  if (block_count == SLI_MEMORY_PROFILER_AGGREGATION_BLOCK_COUNT) {
+    dropped_count++;
+    return;
+  }
+
+  // Insert after the blocks at the same address, which contain the new block
+  index = find_block_index(ptr);
+  while ((index < block_count) && (blocks[index].ptr == ptr)) {
+    index++;
+  }
+  memmove(&blocks[index + 1], &blocks[index], (block_count - index) * sizeof(blocks[0]));
+  block_count++;
+
+  blocks[index].ptr = ptr;
+  blocks[index].size = size;
+  blocks[index].tracker = tracker;
+  blocks[index].site = get_site(tracker, pc);
+  site_add_block(blocks[index].site, size);
+}
+
+/**
+ * @brief Aggregate the freeing of a memory block and of the blocks nested in it
+ */
+static void aggregate_free(uint32_t tracker, uint32_t ptr)
+{
+  sli_memprof_block_t *block = find_block(tracker, ptr);
+  size_t index;
+  size_t end;
+
+  if (block == NULL) {
+    return;
+  }
+
+  pending_operation_count++;
+  index = (size_t) (block - blocks);
+  end = find_nested_end(index);
+  for (size_t i = index; i < end; i++) {
+    site_remove_block(blocks[i].site, blocks[i].size);
+  }
+  memmove(&blocks[index], &blocks[end], (block_count - end) * sizeof(blocks[0]));
+  block_count -= end - index;
+}
+
+/**
+ * @brief Aggregate the reallocation of a memory block
+ *
+ * A block resized in place resizes the blocks nested in it by the same amount,
+ * within the bounds of the block. When the block has moved, the new block and
+ * the blocks nested in it have been tracked already, and the old block is
+ * freed next. The new blocks are then accounted to the sites of the old ones.
+ */
+static void aggregate_realloc(uint32_t tracker, uint32_t ptr, uint32_t realloced_ptr, uint32_t size)
+{
+  sli_memprof_block_t *block = find_block(tracker, ptr);
+  size_t index;
+  size_t end;
+
+  if (block == NULL) {
+    return;
+  }
+
+  pending_operation_count++;
+  index = (size_t) (block - blocks);
+  end = find_nested_end(index);
+
+  if (realloced_ptr == ptr) {
+    uint32_t new_end = ptr + size;
+    uint32_t old_size = block->size;
+
+    site_resize(block->site, old_size, size);
+    block->size = size;
+
+    for (size_t i = index + 1; i < end; i++) {
+      sli_memprof_block_t *nested = &blocks[i];
+      uint32_t nested_size = 0;
+
+      if (nested->ptr < new_end) {
+        if (size >= old_size) {
+          nested_size = nested->size + (size - old_size);
+        } else if (nested->size > old_size - size) {
+          nested_size = nested->size - (old_size - size);
+        }
+        if (nested_size > new_end - nested->ptr) {
+          nested_size = new_end - nested->ptr;
+        }
+      }
+      site_resize(nested->site, nested->size, nested_size);
+      nested->size = nested_size;
+    }
+  } else {
+    for (size_t i = index; i < end; i++) {
+      sli_memprof_block_t *moved = find_block(blocks[i].tracker,
+                                              realloced_ptr + (blocks[i].ptr - ptr));
+      if (moved != NULL) {
+        set_block_site(moved, blocks[i].site);
+      }
+    }
+  }
+}
+
+/**
+ * @brief Aggregate the transfer of memory allocation ownership
+ */
+static void aggregate_ownership(uint32_t tracker, uint32_t ptr, uint32_t pc)
+{
+  sli_memprof_block_t *block = find_block(tracker, ptr);
+
+  if (block == NULL) {
+    return;
+  }
+
+  pending_operation_count++;
+  set_block_site(block, get_site(block->tracker, pc));
+}
+
+/**
+ * @brief Aggregate the freeing of all blocks of a deleted tracker
+ */
+static void aggregate_delete_tracker(uint32_t tracker)
+{
+  size_t kept = 0;
+
+  for (size_t i = 0; i < block_count; i++) {
+    if (blocks[i].tracker == tracker) {
+      site_remove_block(blocks[i].site, blocks[i].size);
+    } else {
+      blocks[kept++] = blocks[i];
+    }
+  }
+  block_count = kept;
+}
+
+/**
+ * @brief Encode a value as an unsigned LEB128 varint
+ *
+ * @return Pointer past the encoded value
+ */
+static uint8_t *encode_varint(uint8_t *out, uint32_t value)
+{
+  while (value >= 0x80) {
+    *out++ = (uint8_t) (value | 0x80);
+    value >>= 7;
+  }
+  *out++ = (uint8_t) value;
+
+  return out;
+}
+
+/**
+ * @brief Zigzag encode a signed difference, so that small changes of either
+ *   sign encode to small varints
+ */
+static uint32_t zigzag(uint32_t difference)
+{
+  return ((int32_t) difference < 0) ? ~(difference << 1) : (difference << 1);
+}
+
+/**
+ * @brief Send one batch of site records
+ *
+ * @param[in,out] next_site Index of the first site to consider. Advanced past
+ *   the sites included in the batch.
+ *
+ * @return true if all sites have been considered
+ */
+static bool send_aggregate_batch(size_t *next_site)
+{
+  sli_memprof_evt_aggregate_batch_t event;
+  uint8_t *out = event.payload;
+  const uint8_t *payload_end = event.payload + sizeof(event.payload);
+  bool has_changes = (dropped_count != sent_dropped_count);
+
+  out = encode_varint(out, dropped_count - sent_dropped_count);
+  sent_dropped_count = dropped_count;
+
+  for (; *next_site < SLI_MEMORY_PROFILER_AGGREGATION_SITE_COUNT; (*next_site)++) {
+    sli_memprof_site_t *site = &sites[*next_site];
+    uint32_t announce;
+
+    if ((site->flags & SITE_FLAG_DIRTY) == 0) {
+      continue;
+    }
+    if ((size_t) (payload_end - out) < MAX_BATCH_RECORD_LEN) {
+      break;
+    }
+
+    announce = ((site->flags & SITE_FLAG_ANNOUNCED) == 0) ? 1 : 0;
+    out = encode_varint(out, ((uint32_t) *next_site << 1) | announce);
+    if (announce) {
+      out = encode_varint(out, site->pc);
+      out = encode_varint(out, site->tracker);
+    }
+    out = encode_varint(out, zigzag(site->live_bytes - site->sent_live_bytes));
+    out = encode_varint(out, site->peak_bytes - site->sent_peak_bytes);
+    out = encode_varint(out, site->alloc_count - site->sent_alloc_count);
+    out = encode_varint(out, site->free_count - site->sent_free_count);
+
+    site->sent_live_bytes = site->live_bytes;
+    site->sent_peak_bytes = site->peak_bytes;
+    site->sent_alloc_count = site->alloc_count;
+    site->sent_free_count = site->free_count;
+    site->flags = (uint8_t) ((site->flags | SITE_FLAG_ANNOUNCED) & ~SITE_FLAG_DIRTY);
+    has_changes = true;
+  }
+
+  if (has_changes) {
+    send_memory_profiler_event(&event.header,
+                               SLI_MEMPROF_EVENT_AGGREGATE_BATCH_ID,
+                               sizeof(event.header) + (size_t) (out - event.payload));
+  }
+
+  return *next_site == SLI_MEMORY_PROFILER_AGGREGATION_SITE_COUNT;
+}
+
+/**
+ * @brief Make the next flush send the full state of all sites
+ *
+ * Used when the event stream restarts, as the receiver doesn't have the state
+ * that the differences would be relative to.
+ */
+static void restart_aggregation(void)
+{
+  for (size_t i = 0; i < SLI_MEMORY_PROFILER_AGGREGATION_SITE_COUNT; i++) {
+    sli_memprof_site_t *site = &sites[i];
+
+    site->sent_live_bytes = 0;
+    site->sent_peak_bytes = 0;
+    site->sent_alloc_count = 0;
+    site->sent_free_count = 0;
+    site->flags &= (uint8_t) ~SITE_FLAG_ANNOUNCED;
+    if ((site->alloc_count != 0) || (site->free_count != 0)) {
+      site->flags |= SITE_FLAG_DIRTY;
+    }
+  }
+  sent_dropped_count = 0;
+}
+#endif // SLI_MEMORY_PROFILER_ENABLE_AGGREGATION
+
 /**
  * @brief Initialize the memory profiler
  */
@@ -237,12 +781,10 @@ static void init_memory_profiler()
   // Callers must ensure that this internal init happens only once
   EFM_ASSERT(!memory_profiler_initialized);
 
-  // Configure the RTT buffer for our events
-  SEGGER_RTT_ConfigUpBuffer(SL_MEMORY_PROFILER_RTT_BUFFER_INDEX,
-                            "sli_memory_profiler",
-                            rtt_buffer,
-                            sizeof(rtt_buffer),
-                            SEGGER_RTT_MODE_BLOCK_IF_FIFO_FULL);
+  // Prepare the transport for our events
+  if ((transport != NULL) && (transport->init != NULL)) {
+    transport->init();
+  }
 
   // Send the init event
   next_sequence_number = 0;
@@ -250,6 +792,10 @@ static void init_memory_profiler()
   event.format_version = SLI_MEMPROF_EVENT_FORMAT_VERSION;
   send_memory_profiler_event(&event.header, SLI_MEMPROF_EVENT_INIT_ID, sizeof(event));
 
+#if SLI_MEMORY_PROFILER_ENABLE_AGGREGATION
+  restart_aggregation();
+#endif
+
   memory_profiler_initialized = true;
 }
 
@@ -266,6 +812,54 @@ void sli_memory_profiler_init()
   CORE_EXIT_ATOMIC();
 }
 
+/* Set the transport used for the events */
+void sli_memory_profiler_set_transport(const sli_memory_profiler_transport_t *new_transport)
+{
+  CORE_DECLARE_IRQ_STATE;
+
+  CORE_ENTER_ATOMIC();
+  transport = new_transport;
+
+  // Restart the event stream on the new transport
+  if (memory_profiler_initialized) {
+    memory_profiler_initialized = false;
+    init_memory_profiler();
+  }
+  CORE_EXIT_ATOMIC();
+}
+
+/* Send the pending changes of the aggregated counters */
+void sli_memory_profiler_flush(void)
+{
+#if SLI_MEMORY_PROFILER_ENABLE_AGGREGATION
+  CORE_DECLARE_IRQ_STATE;
+  size_t next_site = 0;
+  bool done;
+
+  // Send one batch per critical section to bound the interrupt latency
+  do {
+    CORE_ENTER_ATOMIC();
+    if (next_site == 0) {
+      pending_operation_count = 0;
+    }
+    done = send_aggregate_batch(&next_site);
+    CORE_EXIT_ATOMIC();
+  } while (!done);
+#endif
+}
+
+/* Flush the aggregated counters when enough changes are pending */
+void sli_memory_profiler_process_action(void)
+{
+#if SLI_MEMORY_PROFILER_ENABLE_AGGREGATION
+  uint32_t threshold = SLI_MEMORY_PROFILER_AGGREGATION_FLUSH_THRESHOLD;
+
+  if ((pending_operation_count != 0) && (pending_operation_count >= threshold)) {
+    sli_memory_profiler_flush();
+  }
+#endif
+}
+
 /* Create a pool memory tracker */
 sl_status_t sli_memory_profiler_create_pool_tracker(sli_memory_tracker_handle_t tracker_handle,
                                                     const char *description,
@@ -376,6 +970,9 @@ void sli_memory_profiler_delete_tracker(sli_memory_tracker_handle_t tracker_hand
 
   // Send the event atomically
   CORE_ENTER_ATOMIC();
+#if SLI_MEMORY_PROFILER_ENABLE_AGGREGATION
+  aggregate_delete_tracker(event.tracker_handle);
+#endif
   send_memory_profiler_event(&event.header, SLI_MEMPROF_EVENT_DELETE_TRACKER_ID, sizeof(event));
   CORE_EXIT_ATOMIC();
 }
@@ -398,6 +995,15 @@ void sli_memory_profiler_track_alloc_with_ownership(sli_memory_tracker_handle_t
 {
   CORE_DECLARE_IRQ_STATE;
 
+#if SLI_MEMORY_PROFILER_ENABLE_AGGREGATION
+  // Count on the site, the counters are sent by the next flush
+  CORE_ENTER_ATOMIC();
+  aggregate_alloc((uint32_t) (uintptr_t) tracker_handle,
+                  (uint32_t) (uintptr_t) ptr,
+                  (uint32_t) size,
+                  (uint32_t) (uintptr_t) pc);
+  CORE_EXIT_ATOMIC();
+#else
   // Fill the event structure
   sli_memprof_evt_track_alloc_t event;
   event.tracker_handle = (uint32_t) (uintptr_t) tracker_handle;
@@ -409,6 +1015,7 @@ void sli_memory_profiler_track_alloc_with_ownership(sli_memory_tracker_handle_t
   CORE_ENTER_ATOMIC();
   send_memory_profiler_event(&event.header, SLI_MEMPROF_EVENT_TRACK_ALLOC_ID, sizeof(event));
   CORE_EXIT_ATOMIC();
+#endif
 }
 
 /* Track the reallocation of a memory block */
@@ -419,6 +1026,14 @@ void sli_memory_profiler_track_realloc(sli_memory_tracker_handle_t tracker_handl
 {
   CORE_DECLARE_IRQ_STATE;
 
+#if SLI_MEMORY_PROFILER_ENABLE_AGGREGATION
+  CORE_ENTER_ATOMIC();
+  aggregate_realloc((uint32_t) (uintptr_t) tracker_handle,
+                    (uint32_t) (uintptr_t) ptr,
+                    (uint32_t) (uintptr_t) realloced_ptr,
+                    (uint32_t) size);
+  CORE_EXIT_ATOMIC();
+#else
   // Fill the event structure
   sli_memprof_evt_track_realloc_t event;
   event.tracker_handle = (uint32_t) (uintptr_t) tracker_handle;
@@ -430,6 +1045,7 @@ void sli_memory_profiler_track_realloc(sli_memory_tracker_handle_t tracker_handl
   CORE_ENTER_ATOMIC();
   send_memory_profiler_event(&event.header, SLI_MEMPROF_EVENT_TRACK_REALLOC_ID, sizeof(event));
   CORE_EXIT_ATOMIC();
+#endif
 }
 
 /* Track the freeing of a memory block */
@@ -438,6 +1054,11 @@ void sli_memory_profiler_track_free(sli_memory_tracker_handle_t tracker_handle,
 {
   CORE_DECLARE_IRQ_STATE;
 
+#if SLI_MEMORY_PROFILER_ENABLE_AGGREGATION
+  CORE_ENTER_ATOMIC();
+  aggregate_free((uint32_t) (uintptr_t) tracker_handle, (uint32_t) (uintptr_t) ptr);
+  CORE_EXIT_ATOMIC();
+#else
   // Fill the event structure
   sli_memprof_evt_track_free_t event;
   event.tracker_handle = (uint32_t) (uintptr_t) tracker_handle;
@@ -447,6 +1068,7 @@ void sli_memory_profiler_track_free(sli_memory_tracker_handle_t tracker_handle,
   CORE_ENTER_ATOMIC();
   send_memory_profiler_event(&event.header, SLI_MEMPROF_EVENT_TRACK_FREE_ID, sizeof(event));
   CORE_EXIT_ATOMIC();
+#endif
 }
 
 /* Track the transfer of memory allocation ownership */
@@ -456,6 +1078,13 @@ void sli_memory_profiler_track_ownership(sli_memory_tracker_handle_t tracker_han
 {
   CORE_DECLARE_IRQ_STATE;
 
+#if SLI_MEMORY_PROFILER_ENABLE_AGGREGATION
+  CORE_ENTER_ATOMIC();
+  aggregate_ownership((uint32_t) (uintptr_t) tracker_handle,
+                      (uint32_t) (uintptr_t) ptr,
+                      (uint32_t) (uintptr_t) pc);
+  CORE_EXIT_ATOMIC();
+#else
   // Fill the event structure
   sli_memprof_evt_track_ownership_t event;
   event.tracker_handle = (uint32_t) (uintptr_t) tracker_handle;
@@ -466,6 +1095,7 @@ void sli_memory_profiler_track_ownership(sli_memory_tracker_handle_t tracker_han
   CORE_ENTER_ATOMIC();
   send_memory_profiler_event(&event.header, SLI_MEMPROF_EVENT_TRACK_OWNERSHIP_ID, sizeof(event));
   CORE_EXIT_ATOMIC();
+#endif
 }
 
 /* Trigger the creation of a snapshot of the current state */
@@ -473,6 +1103,11 @@ void sli_memory_profiler_take_snapshot(const char *name)
 {
   CORE_DECLARE_IRQ_STATE;
 
+#if SLI_MEMORY_PROFILER_ENABLE_AGGREGATION
+  // Bring the receiver up to date so that the snapshot sees the current state
+  sli_memory_profiler_flush();
+#endif
+
   // Fill the event structure
   sli_memprof_evt_take_snapshot_t event;
   size_t name_len = strlen(name);
@@ -124,3 +124,19 @@ void sli_memory_profiler_log(uint32_t log_id,
   (void) arg3;
   (void) pc;
 }
+
+/* Set the transport used for the events */
+void sli_memory_profiler_set_transport(const sli_memory_profiler_transport_t *transport)
+{
+  (void) transport;
+}
+
+/* Send the pending changes of the aggregated counters */
+void sli_memory_profiler_flush(void)
+{
+}
+
+/* Flush the aggregated counters when enough changes are pending */
+void sli_memory_profiler_process_action(void)
+{
+}
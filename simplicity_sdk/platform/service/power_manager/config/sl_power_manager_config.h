@@ -57,6 +57,21 @@
 #define SL_POWER_MANAGER_DEBUG_POOL_SIZE  10
 // </e>
 
+// <e SL_POWER_MANAGER_DEBUG_PROFILER> Enable energy mode profiler
+// <i> Record energy mode residency, transition counts, wake-up latency and wake-up sources.
+// <i> Requirement owners blocking deepsleep are also recorded when SL_POWER_MANAGER_DEBUG is enabled.
+// <i> Default: 0
+#define SL_POWER_MANAGER_DEBUG_PROFILER  0
+
+// <o SL_POWER_MANAGER_DEBUG_PROFILER_WAKEUP_SOURCE_COUNT> Maximum number of wake-up sources (IRQs) that can be recorded
+// <i> Default: 8
+#define SL_POWER_MANAGER_DEBUG_PROFILER_WAKEUP_SOURCE_COUNT  8
+
+// <o SL_POWER_MANAGER_DEBUG_PROFILER_BLOCKER_COUNT> Maximum number of deepsleep blocking modules that can be recorded
+// <i> Default: 8
+#define SL_POWER_MANAGER_DEBUG_PROFILER_BLOCKER_COUNT  8
+// </e>
+
 // <o SL_POWER_MANAGER_INIT_EMU_EM4_PIN_RETENTION_MODE> Pin retention mode
 // <i>
 // <EMU_EM4CTRL_EM4IORETMODE_DISABLE=> No retention
@@ -42,6 +42,54 @@ extern "C" {
  * @{
  ******************************************************************************/
 
+// -----------------------------------------------------------------------------
+// Defines
+
+#ifndef SL_POWER_MANAGER_DEBUG_PROFILER_WAKEUP_SOURCE_COUNT
+#define SL_POWER_MANAGER_DEBUG_PROFILER_WAKEUP_SOURCE_COUNT  8  ///< Number of wake-up sources recorded by the profiler
+#endif
+
+#ifndef SL_POWER_MANAGER_DEBUG_PROFILER_BLOCKER_COUNT
+#define SL_POWER_MANAGER_DEBUG_PROFILER_BLOCKER_COUNT  8        ///< Number of deepsleep blockers recorded by the profiler
+#endif
+
+#define SL_POWER_MANAGER_DEBUG_PROFILER_EM_COUNT             4  ///< Energy modes tracked by the profiler (EM0 to EM3)
+#define SL_POWER_MANAGER_DEBUG_PROFILER_LATENCY_BUCKET_COUNT 8  ///< Number of latency histogram buckets
+
+// -----------------------------------------------------------------------------
+// Data Types
+
+/// @brief Wake-up source recorded by the profiler
+typedef struct {
+  int16_t irq;                  ///< IRQ number, negative for system exceptions (e.g. -1 for SysTick)
+  uint32_t count;               ///< Number of wake-ups caused by this IRQ
+} sl_power_manager_debug_wakeup_source_t;
+
+/// @brief Module that held an EM1 requirement while the system slept
+typedef struct {
+  const char *module_name;      ///< Module name given by CURRENT_MODULE_NAME
+  uint32_t count;               ///< Number of times the system entered EM1 with the requirement held
+  uint64_t ticks;               ///< Sleeptimer ticks spent in EM1 with the requirement held
+} sl_power_manager_debug_blocker_t;
+
+/// @brief Energy mode profile
+///
+/// Latency histogram bucket 0 counts zero tick latencies, bucket n (n > 0)
+/// counts latencies from 2^(n-1) to 2^n - 1 ticks. The last bucket also counts
+/// all longer latencies.
+typedef struct {
+  uint64_t residency_ticks[SL_POWER_MANAGER_DEBUG_PROFILER_EM_COUNT];                                             ///< Sleeptimer ticks spent in each energy mode
+  uint32_t transition_count[SL_POWER_MANAGER_DEBUG_PROFILER_EM_COUNT][SL_POWER_MANAGER_DEBUG_PROFILER_EM_COUNT];  ///< Transitions, indexed [from][to]
+  uint32_t sleep_aborted_count;                                                                                   ///< Sleeps refused by sl_power_manager_is_ok_to_sleep()
+  uint32_t wakeup_latency_histogram[SL_POWER_MANAGER_DEBUG_PROFILER_LATENCY_BUCKET_COUNT];                        ///< Ticks from deepsleep wake-up to clocks restored
+  uint32_t wakeup_latency_max_ticks;                                                                              ///< Longest deepsleep wake-up latency
+  uint32_t restore_wait_histogram[SL_POWER_MANAGER_DEBUG_PROFILER_LATENCY_BUCKET_COUNT];                          ///< Ticks spent actively waiting for a clock restore from an ISR
+  uint32_t restore_wait_max_ticks;                                                                                ///< Longest active wait for a clock restore
+  sl_power_manager_debug_wakeup_source_t wakeup_sources[SL_POWER_MANAGER_DEBUG_PROFILER_WAKEUP_SOURCE_COUNT];      ///< Wake-up sources, unused entries have a zero count
+  uint32_t wakeup_unattributed_count;                                                                             ///< Wake-ups without a pending IRQ, or with a full source table
+  sl_power_manager_debug_blocker_t blockers[SL_POWER_MANAGER_DEBUG_PROFILER_BLOCKER_COUNT];                       ///< Deepsleep blockers, unused entries have a NULL name
+} sl_power_manager_debug_profile_t;
+
 // -----------------------------------------------------------------------------
 // Prototypes
 
@@ -51,6 +99,33 @@ extern "C" {
  ******************************************************************************/
 void sl_power_manager_debug_print_em_requirements(void);
 
+/***************************************************************************//**
+ * Get a snapshot of the energy mode profile.
+ *
+ * @param profile  Profile to fill. The residency of the current energy mode
+ *                 is accounted up to the time of the call.
+ *
+ * @return SL_STATUS_OK if successful,
+ *         SL_STATUS_NOT_AVAILABLE if SL_POWER_MANAGER_DEBUG_PROFILER is not
+ *         enabled.
+ *
+ * @note Deepsleep blockers are only recorded when SL_POWER_MANAGER_DEBUG is
+ *       also enabled.
+ ******************************************************************************/
+sl_status_t sl_power_manager_debug_get_profile(sl_power_manager_debug_profile_t *profile);
+
+/***************************************************************************//**
+ * Clear the energy mode profile.
+ ******************************************************************************/
+void sl_power_manager_debug_reset_profile(void);
+
+/***************************************************************************//**
+ * Print the energy mode profile.
+ *
+ * @note Times are given in sleeptimer ticks.
+ ******************************************************************************/
+void sl_power_manager_debug_print_profile(void);
+
 /** @} (end addtogroup power_manager) */
 
 #ifdef __cplusplus
@@ -0,0 +1,142 @@
+/***************************************************************************//**
+ * @file
+ * @brief Power Manager Sleep Governor API definition.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+
+#ifndef SL_POWER_MANAGER_GOVERNOR_H
+#define SL_POWER_MANAGER_GOVERNOR_H
+
+#include "sl_power_manager.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***************************************************************************//**
+ * @addtogroup power_manager
+ * @{
+ ******************************************************************************/
+
+// -----------------------------------------------------------------------------
+// Defines
+
+// Number of wake-up sources tracked by the predictive governor
+#ifndef SL_POWER_MANAGER_PREDICTIVE_GOVERNOR_SOURCE_COUNT
+#define SL_POWER_MANAGER_PREDICTIVE_GOVERNOR_SOURCE_COUNT  8     ///< Wake-up sources tracked by the predictive governor
+#endif
+
+// Weight of a new sample in the idle time average, as a power of two divider
+#ifndef SL_POWER_MANAGER_PREDICTIVE_GOVERNOR_EWMA_SHIFT
+#define SL_POWER_MANAGER_PREDICTIVE_GOVERNOR_EWMA_SHIFT    2     ///< New samples weigh 1/(2^shift) in the idle time average
+#endif
+
+// Samples needed before a wake-up source is used for prediction
+#ifndef SL_POWER_MANAGER_PREDICTIVE_GOVERNOR_MIN_SAMPLES
+#define SL_POWER_MANAGER_PREDICTIVE_GOVERNOR_MIN_SAMPLES   4     ///< Samples needed before a wake-up source is trusted
+#endif
+
+// -----------------------------------------------------------------------------
+// Data Types
+
+/***************************************************************************//**
+ * Sleep governor.
+ *
+ * A governor is consulted each time the power manager is about to enter
+ * deepsleep (EM2/EM3), and is told about every wake-up from the sleep loop.
+ * It can only make the power manager sleep in a higher energy mode than the
+ * requirements allow; it can never override an EM1 requirement.
+ *
+ * Both callbacks are called with interrupts disabled and must be short.
+ ******************************************************************************/
+typedef struct {
+  /// Select the energy mode to sleep in.
+  ///
+  /// @param lowest_em       Lowest energy mode allowed by the requirements,
+  ///                        SL_POWER_MANAGER_EM2 or SL_POWER_MANAGER_EM3.
+  /// @param tick_remaining  Sleeptimer ticks until the next timer expires,
+  ///                        UINT32_MAX if no timer is running.
+  /// @param break_even_tick Minimum sleep time in ticks for deepsleep to pay
+  ///                        off, given the wake-up overhead and the HF
+  ///                        oscillator minimum off-time.
+  ///
+  /// @return Energy mode to use. Returning SL_POWER_MANAGER_EM1 keeps the
+  ///         clocks running for this sleep. Returning a lower mode than
+  ///         lowest_em has no effect.
+  sl_power_manager_em_t (*select_em)(sl_power_manager_em_t lowest_em,
+                                     uint32_t              tick_remaining,
+                                     uint32_t              break_even_tick);
+
+  /// Notification of a wake-up.
+  ///
+  /// @param em          Energy mode the system slept in.
+  /// @param idle_tick   Sleeptimer ticks spent sleeping.
+  /// @param irq         IRQ that caused the wake-up, negative for system
+  ///                    exceptions, -16 when no interrupt was pending.
+  void (*on_wakeup)(sl_power_manager_em_t em,
+                    uint32_t              idle_tick,
+                    int16_t               irq);
+} sl_power_manager_governor_t;
+
+// -----------------------------------------------------------------------------
+// Global Variables
+
+/// History based governor. It keeps an exponentially weighted moving average
+/// of the idle time that followed a wake-up from each interrupt source, and
+/// stays in EM1 when the idle time predicted after the latest wake-up is too
+/// short for deepsleep to pay off.
+extern const sl_power_manager_governor_t sl_power_manager_predictive_governor;
+
+// -----------------------------------------------------------------------------
+// Prototypes
+
+/***************************************************************************//**
+ * Set the sleep governor.
+ *
+ * @param governor  Governor to use, NULL to go back to the default policy which
+ *                  only takes the sleeptimer deadlines into account.
+ *
+ * @note The governor must stay valid until it is replaced.
+ *
+ * @note This function will do nothing when a project contains the
+ *       power_manager_no_deepsleep component, which configures the
+ *       lowest energy mode as EM1.
+ ******************************************************************************/
+void sl_power_manager_set_governor(const sl_power_manager_governor_t *governor);
+
+/***************************************************************************//**
+ * Clear the history of the predictive governor.
+ ******************************************************************************/
+void sl_power_manager_predictive_governor_reset(void);
+
+/** @} (end addtogroup power_manager) */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SL_POWER_MANAGER_GOVERNOR_H
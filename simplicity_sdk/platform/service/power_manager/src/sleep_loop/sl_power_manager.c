@@ -30,6 +30,7 @@
 
 #include "sl_power_manager.h"
 #include "sl_power_manager_config.h"
+#include "sl_power_manager_governor.h"
 #include "sli_power_manager_private.h"
 #include "sli_power_manager.h"
 #include "sli_sleeptimer.h"
@@ -127,6 +128,9 @@ static bool is_actively_waiting_for_clock_restore = false;
 // Indicates if the clock restore was completed from the HFXO ISR
 static volatile bool is_restored_from_hfxo_isr = false;
 static volatile bool is_restored_from_hfxo_isr_internal = false;
+
+// Sleep governor, NULL when only the sleeptimer deadlines are used
+static const sl_power_manager_governor_t *governor = NULL;
 #endif
 
 /*******************************************************************************
@@ -152,6 +156,10 @@ static void clock_restore_and_wait(void);
 
 SL_CODE_CLASSIFY(SL_CODE_COMPONENT_POWER_MANAGER, SL_CODE_CLASS_TIME_CRITICAL)
 static void clock_restore(void);
+
+SL_CODE_CLASSIFY(SL_CODE_COMPONENT_POWER_MANAGER, SL_CODE_CLASS_TIME_CRITICAL)
+static sl_power_manager_em_t governor_select_em(sl_power_manager_em_t to,
+                                                uint32_t tick_remaining);
 #endif
 
 // Use PriMask to enter critical section by disabling interrupts.
@@ -201,6 +209,9 @@ sl_status_t sl_power_manager_init(void)
     sli_power_manager_debug_init();
   #endif
     sli_power_manager_em_transition_event_list_init();
+  #if (SL_POWER_MANAGER_DEBUG_PROFILER == 1)
+    sli_power_manager_profiler_init();
+  #endif
 
 #if !defined(SL_CATALOG_POWER_MANAGER_NO_DEEPSLEEP_PRESENT)
     // If lowest energy mode is not restricted to EM1, determine and set lowest energy mode
@@ -248,12 +259,19 @@ void sl_power_manager_sleep(void)
 {
   CORE_irqState_t primask_state;
   sl_power_manager_em_t lowest_em;
+#if !defined(SL_CATALOG_POWER_MANAGER_NO_DEEPSLEEP_PRESENT)
+  const sl_power_manager_governor_t *sleep_governor;
+  uint32_t sleep_start_tick = 0;
+#endif
 
   primask_state = enter_critical_with_primask();
 
   sli_power_manager_suspend_log_transmission();
 
   if (sl_power_manager_is_ok_to_sleep() != true) {
+#if (SL_POWER_MANAGER_DEBUG_PROFILER == 1)
+    sli_power_manager_profiler_on_sleep_aborted();
+#endif
     sli_power_manager_resume_log_transmission();
     exit_critical_with_primask(primask_state);
     return;
@@ -311,9 +329,24 @@ void sl_power_manager_sleep(void)
       is_states_saved = true;
     }
 
+    sleep_governor = governor;
+    if (sleep_governor != NULL) {
+      sleep_start_tick = sl_sleeptimer_get_tick_count();
+    }
+
     // Apply lowest reachable energy mode
     sli_power_manager_apply_em(current_em);
 
+    if (sleep_governor != NULL) {
+      sleep_governor->on_wakeup(current_em,
+                                sl_sleeptimer_get_tick_count() - sleep_start_tick,
+                                sli_power_manager_get_pending_irq());
+    }
+
+#if (SL_POWER_MANAGER_DEBUG_PROFILER == 1)
+    sli_power_manager_profiler_on_wakeup(current_em);
+#endif
+
     // In case we are waiting for the restore from an early wake-up,
     // we put back the current EM to the one before the early wake-up to do the next notification correctly.
     if (is_sleeping_waiting_for_clock_restore == true) {
@@ -358,6 +391,9 @@ void sl_power_manager_sleep(void)
     }
     sli_power_manager_restore_states();
     is_states_saved = false;
+#if (SL_POWER_MANAGER_DEBUG_PROFILER == 1)
+    sli_power_manager_profiler_on_clock_restored();
+#endif
   }
 
   evaluate_wakeup(SL_POWER_MANAGER_EM0);
@@ -385,6 +421,10 @@ void sl_power_manager_sleep(void)
     // but only EM1 sleep will be entered.
     sli_power_manager_apply_em(lowest_em);
 
+#if (SL_POWER_MANAGER_DEBUG_PROFILER == 1)
+    sli_power_manager_profiler_on_wakeup(SL_POWER_MANAGER_EM1);
+#endif
+
     primask_state = yield_critical_with_primask(primask_state);
   } while (sl_power_manager_sleep_on_isr_exit() == true);
 
@@ -708,6 +748,39 @@ void sl_power_manager_schedule_wakeup_set_minimum_offtime_tick(uint32_t minimum_
 #endif
 }
 
+/***************************************************************************//**
+ * Set the sleep governor.
+ *
+ * @param new_governor  Governor to use, NULL for the default policy.
+ *
+ * @note This function will do nothing when a project contains the
+ *       power_manager_no_deepsleep component, which configures the
+ *       lowest energy mode as EM1.
+ ******************************************************************************/
+void sl_power_manager_set_governor(const sl_power_manager_governor_t *new_governor)
+{
+#if !defined(SL_CATALOG_POWER_MANAGER_NO_DEEPSLEEP_PRESENT)
+  CORE_DECLARE_IRQ_STATE;
+
+  CORE_ENTER_CRITICAL();
+  governor = new_governor;
+  CORE_EXIT_CRITICAL();
+#else
+  (void)new_governor;
+#endif
+}
+
+/*******************************************************************************
+ * Gets the IRQ number of the highest priority pending interrupt.
+ ******************************************************************************/
+int16_t sli_power_manager_get_pending_irq(void)
+{
+  uint32_t vector = (SCB->ICSR & SCB_ICSR_VECTPENDING_Msk) >> SCB_ICSR_VECTPENDING_Pos;
+
+  // Exception numbers map to IRQ numbers with an offset of 16
+  return (int16_t)vector - 16;
+}
+
 #if !defined(SL_CATALOG_POWER_MANAGER_NO_DEEPSLEEP_PRESENT)
 /*******************************************************************************
  * Converts microseconds time in sleeptimer ticks.
@@ -849,7 +922,13 @@ static void evaluate_wakeup(sl_power_manager_em_t to)
     case SL_POWER_MANAGER_EM3:
       // Get the time remaining until the next sleeptimer requiring early wake-up
       status = sl_sleeptimer_get_remaining_time_of_first_timer(0, &tick_remaining);
-      if (status == SL_STATUS_OK) {
+      if ((governor != NULL)
+          && (governor_select_em(to, (status == SL_STATUS_OK) ? tick_remaining : UINT32_MAX) == SL_POWER_MANAGER_EM1)) {
+        // Add EM1 requirement if the governor predicts a wake-up before deepsleep
+        // would be energy efficient.
+        update_em1_requirement(true);
+        requirement_on_em1_added = true;
+      } else if (status == SL_STATUS_OK) {
         if (tick_remaining <= high_frequency_min_offtime_tick) {
           // Add EM1 requirement if time remaining is to short to be energy efficient
           // if going back to deepsleep.
@@ -891,6 +970,37 @@ static void evaluate_wakeup(sl_power_manager_em_t to)
 }
 #endif
 
+#if !defined(SL_CATALOG_POWER_MANAGER_NO_DEEPSLEEP_PRESENT)
+/***************************************************************************//**
+ * Asks the governor which energy mode to use for the coming sleep.
+ *
+ * @param   to              Lowest energy mode allowed by the requirements.
+ *
+ * @param   tick_remaining  Ticks until the next sleeptimer expires.
+ *
+ * @return  Energy mode selected by the governor.
+ *
+ * @note Must be called in a critical section, with a governor set.
+ ******************************************************************************/
+static sl_power_manager_em_t governor_select_em(sl_power_manager_em_t to,
+                                                uint32_t tick_remaining)
+{
+  int32_t wakeup_delay = 0;
+  uint32_t break_even_tick;
+
+  // Deepsleep pays off when it lasts longer than both the wake-up process
+  // and the HF oscillator minimum off-time.
+  sl_atomic_load(wakeup_delay, wakeup_time_config_overhead_tick);
+  wakeup_delay += sli_power_manager_get_wakeup_process_time_overhead();
+  break_even_tick = high_frequency_min_offtime_tick;
+  if ((wakeup_delay > 0) && ((uint32_t)wakeup_delay > break_even_tick)) {
+    break_even_tick = (uint32_t)wakeup_delay;
+  }
+
+  return governor->select_em(to, tick_remaining, break_even_tick);
+}
+#endif
+
 #if !defined(SL_CATALOG_POWER_MANAGER_NO_DEEPSLEEP_PRESENT)
 /***************************************************************************//**
  * Updates internal EM1 requirement.
@@ -950,6 +1060,9 @@ static void update_em1_requirement(bool add)
 static void clock_restore_and_wait(void)
 {
   CORE_DECLARE_IRQ_STATE;
+#if (SL_POWER_MANAGER_DEBUG_PROFILER == 1)
+  uint32_t wait_start_tick = sl_sleeptimer_get_tick_count();
+#endif
 
   CORE_ENTER_CRITICAL();
   if (is_states_saved == true) {
@@ -975,6 +1088,10 @@ static void clock_restore_and_wait(void)
     }
 
     is_states_saved = false;
+#if (SL_POWER_MANAGER_DEBUG_PROFILER == 1)
+    sli_power_manager_profiler_record_restore_wait(sl_sleeptimer_get_tick_count() - wait_start_tick);
+    sli_power_manager_profiler_on_clock_restored();
+#endif
   }
   CORE_EXIT_CRITICAL();
 }
@@ -998,6 +1115,9 @@ static void clock_restore(void)
       // Do the clock restore if the HF oscillator is already ready
       sli_power_manager_restore_states();
       is_states_saved = false;
+#if (SL_POWER_MANAGER_DEBUG_PROFILER == 1)
+      sli_power_manager_profiler_on_clock_restored();
+#endif
 
       // We do the notification only when the restore is completed.
       sli_power_manager_notify_em_transition(current_em, SL_POWER_MANAGER_EM1);
@@ -1067,6 +1187,9 @@ void sli_hfxo_manager_notify_ready_for_power_manager(void)
     is_states_saved = false;
     is_restored_from_hfxo_isr = true;
     is_restored_from_hfxo_isr_internal = true;
+#if (SL_POWER_MANAGER_DEBUG_PROFILER == 1)
+    sli_power_manager_profiler_on_clock_restored();
+#endif
   }
 #endif
 }
@@ -33,11 +33,14 @@
 #include "sl_power_manager_debug.h"
 #include "sli_power_manager_private.h"
 
-#if (SL_POWER_MANAGER_DEBUG == 1)
+#if (SL_POWER_MANAGER_DEBUG == 1) || (SL_POWER_MANAGER_DEBUG_PROFILER == 1)
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdint.h>
 #include <string.h>
+#endif
+
+#if (SL_POWER_MANAGER_DEBUG == 1)
 
 static sl_slist_node_t *power_manager_debug_requirement_em_table[SLI_POWER_MANAGER_EM_TABLE_SIZE];
 static sli_power_debug_requirement_entry_t  power_debug_entry_table[SL_POWER_MANAGER_DEBUG_POOL_SIZE];
@@ -139,6 +142,344 @@ static void power_manager_log_add_requirement(sl_slist_node_t **p_list,
 }
 #endif // SL_POWER_MANAGER_DEBUG
 
+#if (SL_POWER_MANAGER_DEBUG_PROFILER == 1)
+static sl_power_manager_debug_profile_t profile;
+
+// Energy mode being profiled and tick count when it was entered
+static sl_power_manager_em_t profiler_em = SL_POWER_MANAGER_EM0;
+static uint32_t profiler_em_entry_tick = 0;
+
+// Tick count of the latest deepsleep wake-up not yet followed by a clock restore
+static uint32_t profiler_wakeup_tick = 0;
+static bool profiler_wakeup_pending = false;
+
+static void profiler_on_em_transition(sl_power_manager_em_t from,
+                                      sl_power_manager_em_t to);
+
+static sl_power_manager_em_transition_event_handle_t profiler_event_handle;
+static const sl_power_manager_em_transition_event_info_t profiler_event_info = {
+  .event_mask = SL_POWER_MANAGER_EVENT_TRANSITION_ENTERING_EM0
+                | SL_POWER_MANAGER_EVENT_TRANSITION_ENTERING_EM1
+                | SL_POWER_MANAGER_EVENT_TRANSITION_ENTERING_EM2
+                | SL_POWER_MANAGER_EVENT_TRANSITION_ENTERING_EM3,
+  .on_event = profiler_on_em_transition
+};
+
+#if (SL_POWER_MANAGER_DEBUG == 1)
+/***************************************************************************//**
+ * Get the blocker entry of a module, allocating it if needed.
+ *
+ * @param name  Module name.
+ *
+ * @return Blocker entry, NULL if the blocker table is full.
+ ******************************************************************************/
+static sl_power_manager_debug_blocker_t *profiler_get_blocker(const char *name)
+{
+  uint32_t i;
+
+  for (i = 0; i < SL_POWER_MANAGER_DEBUG_PROFILER_BLOCKER_COUNT; i++) {
+    sl_power_manager_debug_blocker_t *blocker = &profile.blockers[i];
+
+    if (blocker->module_name == NULL) {
+      blocker->module_name = name;
+      return blocker;
+    }
+    if ((blocker->module_name == name)
+        || (strcmp(blocker->module_name, name) == 0)) {
+      return blocker;
+    }
+  }
+
+  return NULL;
+}
+
+/***************************************************************************//**
+ * Account EM1 time or an EM1 entry to the modules holding an EM1 requirement.
+ *
+ * @param ticks  Ticks spent in EM1.
+ *
+ * @param entry  Count an EM1 entry (true) or account time (false).
+ ******************************************************************************/
+static void profiler_account_blockers(uint32_t ticks, bool entry)
+{
+  sli_power_debug_requirement_entry_t *requirement;
+
+  SL_SLIST_FOR_EACH_ENTRY(power_manager_debug_requirement_em_table[SL_POWER_MANAGER_EM1 - 1], requirement, sli_power_debug_requirement_entry_t, node) {
+    sl_power_manager_debug_blocker_t *blocker = profiler_get_blocker(requirement->module_name);
+
+    if (blocker == NULL) {
+      continue;
+    }
+    if (entry) {
+      blocker->count++;
+    } else {
+      blocker->ticks += ticks;
+    }
+  }
+}
+#endif
+
+/***************************************************************************//**
+ * Account the time spent in the profiled energy mode up to now.
+ *
+ * @param now  Current sleeptimer tick count.
+ ******************************************************************************/
+static void profiler_account_residency(uint32_t now)
+{
+  uint32_t ticks = now - profiler_em_entry_tick;
+
+  profile.residency_ticks[profiler_em] += ticks;
+  profiler_em_entry_tick = now;
+
+#if (SL_POWER_MANAGER_DEBUG == 1)
+  if (profiler_em == SL_POWER_MANAGER_EM1) {
+    profiler_account_blockers(ticks, false);
+  }
+#endif
+}
+
+/***************************************************************************//**
+ * Get the latency histogram bucket of a duration.
+ *
+ * @param ticks  Duration in sleeptimer ticks.
+ *
+ * @return Bucket index.
+ ******************************************************************************/
+static uint32_t profiler_latency_bucket(uint32_t ticks)
+{
+  uint32_t bucket = 0;
+
+  while ((ticks > 0) && (bucket < (SL_POWER_MANAGER_DEBUG_PROFILER_LATENCY_BUCKET_COUNT - 1))) {
+    ticks >>= 1;
+    bucket++;
+  }
+
+  return bucket;
+}
+
+/***************************************************************************//**
+ * Record a wake-up caused by an IRQ.
+ *
+ * @param irq  IRQ number.
+ ******************************************************************************/
+static void profiler_record_wakeup_source(int16_t irq)
+{
+  uint32_t i;
+
+  for (i = 0; i < SL_POWER_MANAGER_DEBUG_PROFILER_WAKEUP_SOURCE_COUNT; i++) {
+    sl_power_manager_debug_wakeup_source_t *source = &profile.wakeup_sources[i];
+
+    if (source->count == 0) {
+      source->irq = irq;
+    }
+    if (source->irq == irq) {
+      source->count++;
+      return;
+    }
+  }
+
+  profile.wakeup_unattributed_count++;
+}
+
+/***************************************************************************//**
+ * Energy mode transition callback.
+ *
+ * @param from  Energy mode we are leaving.
+ *
+ * @param to    Energy mode we are entering.
+ ******************************************************************************/
+static void profiler_on_em_transition(sl_power_manager_em_t from,
+                                      sl_power_manager_em_t to)
+{
+  profiler_account_residency(sl_sleeptimer_get_tick_count());
+
+  if ((from < SL_POWER_MANAGER_DEBUG_PROFILER_EM_COUNT)
+      && (to < SL_POWER_MANAGER_DEBUG_PROFILER_EM_COUNT)) {
+    profile.transition_count[from][to]++;
+    profiler_em = to;
+  }
+
+#if (SL_POWER_MANAGER_DEBUG == 1)
+  if (to == SL_POWER_MANAGER_EM1) {
+    profiler_account_blockers(0, true);
+  }
+#endif
+}
+
+/***************************************************************************//**
+ * Initialize the energy mode profiler.
+ ******************************************************************************/
+void sli_power_manager_profiler_init(void)
+{
+  sl_power_manager_debug_reset_profile();
+  sl_power_manager_subscribe_em_transition_event(&profiler_event_handle, &profiler_event_info);
+}
+
+/***************************************************************************//**
+ * Record a sleep refused by sl_power_manager_is_ok_to_sleep().
+ ******************************************************************************/
+void sli_power_manager_profiler_on_sleep_aborted(void)
+{
+  profile.sleep_aborted_count++;
+}
+
+/***************************************************************************//**
+ * Record a wake-up and the IRQ that caused it.
+ *
+ * @param em  Energy mode the system woke up from.
+ *
+ * @note Interrupts are still disabled, so the wake-up IRQ is pending.
+ ******************************************************************************/
+void sli_power_manager_profiler_on_wakeup(sl_power_manager_em_t em)
+{
+  int16_t irq = sli_power_manager_get_pending_irq();
+
+  if (em >= SL_POWER_MANAGER_EM2) {
+    profiler_wakeup_tick = sl_sleeptimer_get_tick_count();
+    profiler_wakeup_pending = true;
+  }
+
+  if (irq == -16) {
+    // No interrupt pending
+    profile.wakeup_unattributed_count++;
+  } else {
+    profiler_record_wakeup_source(irq);
+  }
+}
+
+/***************************************************************************//**
+ * Record the end of a clock restore.
+ ******************************************************************************/
+void sli_power_manager_profiler_on_clock_restored(void)
+{
+  uint32_t ticks;
+
+  if (!profiler_wakeup_pending) {
+    return;
+  }
+  profiler_wakeup_pending = false;
+
+  ticks = sl_sleeptimer_get_tick_count() - profiler_wakeup_tick;
+  profile.wakeup_latency_histogram[profiler_latency_bucket(ticks)]++;
+  if (ticks > profile.wakeup_latency_max_ticks) {
+    profile.wakeup_latency_max_ticks = ticks;
+  }
+}
+
+/***************************************************************************//**
+ * Record the time spent actively waiting for a clock restore.
+ *
+ * @param ticks  Wait time in sleeptimer ticks.
+ ******************************************************************************/
+void sli_power_manager_profiler_record_restore_wait(uint32_t ticks)
+{
+  profile.restore_wait_histogram[profiler_latency_bucket(ticks)]++;
+  if (ticks > profile.restore_wait_max_ticks) {
+    profile.restore_wait_max_ticks = ticks;
+  }
+}
+#endif // SL_POWER_MANAGER_DEBUG_PROFILER
+
+/***************************************************************************//**
+ * Get a snapshot of the energy mode profile.
+ ******************************************************************************/
+sl_status_t sl_power_manager_debug_get_profile(sl_power_manager_debug_profile_t *profile_out)
+{
+#if (SL_POWER_MANAGER_DEBUG_PROFILER == 1)
+  CORE_DECLARE_IRQ_STATE;
+
+  CORE_ENTER_CRITICAL();
+  profiler_account_residency(sl_sleeptimer_get_tick_count());
+  *profile_out = profile;
+  CORE_EXIT_CRITICAL();
+
+  return SL_STATUS_OK;
+#else
+  (void)profile_out;
+  return SL_STATUS_NOT_AVAILABLE;
+#endif
+}
+
+/***************************************************************************//**
+ * Clear the energy mode profile.
+ ******************************************************************************/
+void sl_power_manager_debug_reset_profile(void)
+{
+#if (SL_POWER_MANAGER_DEBUG_PROFILER == 1)
+  CORE_DECLARE_IRQ_STATE;
+
+  CORE_ENTER_CRITICAL();
+  memset(&profile, 0, sizeof(profile));
+  profiler_em_entry_tick = sl_sleeptimer_get_tick_count();
+  profiler_wakeup_pending = false;
+  CORE_EXIT_CRITICAL();
+#endif
+}
+
+/***************************************************************************//**
+ * Print the energy mode profile.
+ ******************************************************************************/
+void sl_power_manager_debug_print_profile(void)
+{
+#if (SL_POWER_MANAGER_DEBUG_PROFILER == 1)
+  sl_power_manager_debug_profile_t snapshot;
+  uint32_t i;
+  uint32_t j;
+
+  sl_power_manager_debug_get_profile(&snapshot);
+
+  printf("------------------------------------------\n");
+  printf("| EM profile (sleeptimer ticks)\n");
+  printf("------------------------------------------\n");
+  for (i = 0; i < SL_POWER_MANAGER_DEBUG_PROFILER_EM_COUNT; i++) {
+    printf("| EM%lu residency: %llu\n", (unsigned long)i, (unsigned long long)snapshot.residency_ticks[i]);
+  }
+  printf("| Sleeps aborted: %lu\n", (unsigned long)snapshot.sleep_aborted_count);
+  printf("------------------------------------------\n");
+  printf("| Transitions (from \\ to): EM0 EM1 EM2 EM3\n");
+  for (i = 0; i < SL_POWER_MANAGER_DEBUG_PROFILER_EM_COUNT; i++) {
+    printf("|     EM%lu:", (unsigned long)i);
+    for (j = 0; j < SL_POWER_MANAGER_DEBUG_PROFILER_EM_COUNT; j++) {
+      printf(" %lu", (unsigned long)snapshot.transition_count[i][j]);
+    }
+    printf("\n");
+  }
+  printf("------------------------------------------\n");
+  printf("| Latency buckets (<ticks): wake-up / restore wait\n");
+  for (i = 0; i < SL_POWER_MANAGER_DEBUG_PROFILER_LATENCY_BUCKET_COUNT; i++) {
+    printf("|     %s%lu: %lu / %lu\n",
+           (i == (SL_POWER_MANAGER_DEBUG_PROFILER_LATENCY_BUCKET_COUNT - 1)) ? ">=" : "<",
+           (i == (SL_POWER_MANAGER_DEBUG_PROFILER_LATENCY_BUCKET_COUNT - 1)) ? (1UL << (i - 1)) : (1UL << i),
+           (unsigned long)snapshot.wakeup_latency_histogram[i],
+           (unsigned long)snapshot.restore_wait_histogram[i]);
+  }
+  printf("|     max: %lu / %lu\n",
+         (unsigned long)snapshot.wakeup_latency_max_ticks,
+         (unsigned long)snapshot.restore_wait_max_ticks);
+  printf("------------------------------------------\n");
+  printf("| Wake-up sources (IRQ: count)\n");
+  for (i = 0; i < SL_POWER_MANAGER_DEBUG_PROFILER_WAKEUP_SOURCE_COUNT; i++) {
+    if (snapshot.wakeup_sources[i].count != 0) {
+      printf("|     %d: %lu\n", snapshot.wakeup_sources[i].irq, (unsigned long)snapshot.wakeup_sources[i].count);
+    }
+  }
+  printf("|     unattributed: %lu\n", (unsigned long)snapshot.wakeup_unattributed_count);
+#if (SL_POWER_MANAGER_DEBUG == 1)
+  printf("------------------------------------------\n");
+  printf("| Deepsleep blockers (EM1 entries / ticks)\n");
+  for (i = 0; i < SL_POWER_MANAGER_DEBUG_PROFILER_BLOCKER_COUNT; i++) {
+    if (snapshot.blockers[i].module_name != NULL) {
+      printf("|     %s: %lu / %llu\n",
+             snapshot.blockers[i].module_name,
+             (unsigned long)snapshot.blockers[i].count,
+             (unsigned long long)snapshot.blockers[i].ticks);
+    }
+  }
+#endif
+  printf("------------------------------------------\n");
+#endif
+}
+
 #undef sli_power_manager_debug_log_em_requirement
 /***************************************************************************//**
  * Log energy mode (EM) requirement
@@ -0,0 +1,187 @@
+/***************************************************************************//**
+ * @file
+ * @brief Power Manager Predictive Sleep Governor implementation.
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+
+#include "sl_power_manager.h"
+#include "sl_power_manager_governor.h"
+
+#include <stdint.h>
+#include <string.h>
+
+/*******************************************************************************
+ *****************************   DATA TYPES   **********************************
+ ******************************************************************************/
+
+// Idle time history of a wake-up source
+typedef struct {
+  int16_t irq;              // Wake-up IRQ
+  uint8_t samples;          // Number of samples, saturates at UINT8_MAX
+  uint32_t avg_idle_tick;   // Average idle time after a wake-up from this IRQ
+} governor_source_t;
+
+/*******************************************************************************
+ ***************************  LOCAL VARIABLES   ********************************
+ ******************************************************************************/
+
+static governor_source_t governor_sources[SL_POWER_MANAGER_PREDICTIVE_GOVERNOR_SOURCE_COUNT];
+
+// Source of the latest wake-up, the next idle period is accounted to it
+static governor_source_t *latest_source = NULL;
+
+/*******************************************************************************
+ **************************   LOCAL FUNCTIONS   ********************************
+ ******************************************************************************/
+
+static sl_power_manager_em_t predictive_select_em(sl_power_manager_em_t lowest_em,
+                                                  uint32_t              tick_remaining,
+                                                  uint32_t              break_even_tick);
+
+static void predictive_on_wakeup(sl_power_manager_em_t em,
+                                 uint32_t              idle_tick,
+                                 int16_t               irq);
+
+/*******************************************************************************
+ ***************************  GLOBAL VARIABLES   *******************************
+ ******************************************************************************/
+
+const sl_power_manager_governor_t sl_power_manager_predictive_governor = {
+  .select_em = predictive_select_em,
+  .on_wakeup = predictive_on_wakeup,
+};
+
+/*******************************************************************************
+ **************************   GLOBAL FUNCTIONS   *******************************
+ ******************************************************************************/
+
+/***************************************************************************//**
+ * Clear the history of the predictive governor.
+ ******************************************************************************/
+void sl_power_manager_predictive_governor_reset(void)
+{
+  CORE_DECLARE_IRQ_STATE;
+
+  CORE_ENTER_CRITICAL();
+  memset(governor_sources, 0, sizeof(governor_sources));
+  latest_source = NULL;
+  CORE_EXIT_CRITICAL();
+}
+
+/*******************************************************************************
+ **************************   LOCAL FUNCTIONS   ********************************
+ ******************************************************************************/
+
+/***************************************************************************//**
+ * Get the history entry of a wake-up source. If the source is unknown, the
+ * entry with the fewest samples is recycled for it.
+ *
+ * @param irq  Wake-up IRQ.
+ *
+ * @return History entry.
+ ******************************************************************************/
+static governor_source_t *get_source(int16_t irq)
+{
+  governor_source_t *victim = &governor_sources[0];
+  uint32_t i;
+
+  for (i = 0; i < SL_POWER_MANAGER_PREDICTIVE_GOVERNOR_SOURCE_COUNT; i++) {
+    governor_source_t *source = &governor_sources[i];
+
+    if ((source->samples != 0) && (source->irq == irq)) {
+      return source;
+    }
+    if (source->samples < victim->samples) {
+      victim = source;
+    }
+  }
+
+  victim->irq = irq;
+  victim->samples = 0;
+  victim->avg_idle_tick = 0;
+
+  return victim;
+}
+
+/***************************************************************************//**
+ * Select the energy mode from the idle time predicted after the latest
+ * wake-up.
+ ******************************************************************************/
+static sl_power_manager_em_t predictive_select_em(sl_power_manager_em_t lowest_em,
+                                                  uint32_t              tick_remaining,
+                                                  uint32_t              break_even_tick)
+{
+  uint32_t predicted_tick;
+
+  if ((latest_source == NULL)
+      || (latest_source->samples < SL_POWER_MANAGER_PREDICTIVE_GOVERNOR_MIN_SAMPLES)) {
+    // Not enough history, keep the deadline based decision
+    return lowest_em;
+  }
+
+  predicted_tick = latest_source->avg_idle_tick;
+  if (tick_remaining < predicted_tick) {
+    predicted_tick = tick_remaining;
+  }
+
+  if (predicted_tick <= break_even_tick) {
+    // Saving and restoring the clocks would cost more than it saves
+    return SL_POWER_MANAGER_EM1;
+  }
+
+  return lowest_em;
+}
+
+/***************************************************************************//**
+ * Account the idle time to the previous wake-up source and remember the new
+ * one.
+ *
+ * @note A wrong short prediction costs one EM1 idle period. It is then
+ *       corrected by the long idle time being added to the average.
+ ******************************************************************************/
+static void predictive_on_wakeup(sl_power_manager_em_t em,
+                                 uint32_t              idle_tick,
+                                 int16_t               irq)
+{
+  (void)em;
+
+  if (latest_source != NULL) {
+    if (latest_source->samples == 0) {
+      latest_source->avg_idle_tick = idle_tick;
+    } else {
+      int64_t delta = (int64_t)idle_tick - (int64_t)latest_source->avg_idle_tick;
+
+      latest_source->avg_idle_tick = (uint32_t)((int64_t)latest_source->avg_idle_tick
+                                                + (delta / (1 << SL_POWER_MANAGER_PREDICTIVE_GOVERNOR_EWMA_SHIFT)));
+    }
+    if (latest_source->samples < UINT8_MAX) {
+      latest_source->samples++;
+    }
+  }
+
+  latest_source = get_source(irq);
+}
@@ -349,6 +349,7 @@ void EMU_EM23PresleepHook(void)
 #endif
 
     SystemCoreClockUpdate();
+    CMU_ClockFreqCacheInvalidate();
   }
   // Clear HFXO IEN RDY before entering sleep to prevent HFXO HW requests from waking up the system
   HFXO0->IEN_CLR = HFXO_IEN_RDY;
@@ -399,6 +400,7 @@ void EMU_EM23PostsleepHook(void)
     // Switch SYSCLK to HFXO to measure restore time
     CMU->SYSCLKCTRL = (CMU->SYSCLKCTRL & ~_CMU_SYSCLKCTRL_CLKSEL_MASK) | cmuSelect_HFXO;
     SystemCoreClockUpdate();
+    CMU_ClockFreqCacheInvalidate();
 #else
     sli_hfxo_manager_begin_startup_measurement();
 
@@ -453,6 +455,7 @@ void sli_power_manager_restore_high_freq_accuracy_clk(void)
     // Switch SYSCLK to HFXO to measure restore time
     CMU->SYSCLKCTRL = (CMU->SYSCLKCTRL & ~_CMU_SYSCLKCTRL_CLKSEL_MASK) | cmuSelect_HFXO;
     SystemCoreClockUpdate();
+    CMU_ClockFreqCacheInvalidate();
 #else
     // Start measure HFXO restore time
     sli_hfxo_manager_begin_startup_measurement();
@@ -542,6 +545,7 @@ void sli_power_manager_restore_states(void)
   }
 
   SystemCoreClockUpdate();
+  CMU_ClockFreqCacheInvalidate();
 }
 #endif
 
@@ -636,10 +640,13 @@ uint32_t sli_power_manager_get_wakeup_process_time_overhead(void)
   if (is_hf_x_oscillator_used) {
 #if defined(SL_CATALOG_POWER_MANAGER_DEEPSLEEP_BLOCKING_HFXO_RESTORE_PRESENT)
     delay = hfxo_wakeup_time_tick;
+    delay += delay >> HFXO_START_UP_TIME_OVERHEAD_LOG2;
 #else
     delay = sli_hfxo_manager_get_startup_time();
+    if (!sli_hfxo_manager_is_startup_time_margin_included()) {
+      delay += delay >> HFXO_START_UP_TIME_OVERHEAD_LOG2;
+    }
 #endif
-    delay += delay >> HFXO_START_UP_TIME_OVERHEAD_LOG2;
   }
 
   // Add all additional overhead wake-up delays (DPLL, VSCALE, general wake-up process)
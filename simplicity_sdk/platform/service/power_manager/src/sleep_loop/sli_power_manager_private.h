@@ -59,6 +59,10 @@ extern "C" {
 #define SLI_POWER_MANAGER_EM_TABLE_SIZE  2
 
 #define SLI_POWER_MANAGER_EM4_ENTRY_WAIT_LOOPS 200
+
+#if !defined(SL_POWER_MANAGER_DEBUG_PROFILER)
+#define SL_POWER_MANAGER_DEBUG_PROFILER  0
+#endif
 /*******************************************************************************
  *****************************   DATA TYPES   *********************************
  ******************************************************************************/
@@ -80,6 +84,51 @@ void sli_power_manager_apply_em(sl_power_manager_em_t em);
 
 void sli_power_manager_debug_init(void);
 
+/*******************************************************************************
+ * Gets the IRQ number of the highest priority pending interrupt.
+ *
+ * @return IRQ number, negative for system exceptions, -16 if none is pending.
+ *
+ * @note Called right after a wake-up with interrupts disabled, this is the
+ *       interrupt that caused the wake-up.
+ ******************************************************************************/
+SL_CODE_CLASSIFY(SL_CODE_COMPONENT_POWER_MANAGER, SL_CODE_CLASS_TIME_CRITICAL)
+int16_t sli_power_manager_get_pending_irq(void);
+
+#if (SL_POWER_MANAGER_DEBUG_PROFILER == 1)
+/*******************************************************************************
+ * Initializes the energy mode profiler.
+ *
+ * @note Must be called after the transition event list is initialized.
+ ******************************************************************************/
+void sli_power_manager_profiler_init(void);
+
+/*******************************************************************************
+ * Records a sleep refused by sl_power_manager_is_ok_to_sleep().
+ ******************************************************************************/
+void sli_power_manager_profiler_on_sleep_aborted(void);
+
+/*******************************************************************************
+ * Records a wake-up from the given energy mode and the IRQ that caused it.
+ *
+ * @note Must be called with interrupts disabled, right after the wake-up.
+ ******************************************************************************/
+SL_CODE_CLASSIFY(SL_CODE_COMPONENT_POWER_MANAGER, SL_CODE_CLASS_TIME_CRITICAL)
+void sli_power_manager_profiler_on_wakeup(sl_power_manager_em_t em);
+
+/*******************************************************************************
+ * Records the end of a clock restore, closing the latest deepsleep wake-up.
+ ******************************************************************************/
+SL_CODE_CLASSIFY(SL_CODE_COMPONENT_POWER_MANAGER, SL_CODE_CLASS_TIME_CRITICAL)
+void sli_power_manager_profiler_on_clock_restored(void);
+
+/*******************************************************************************
+ * Records the time spent actively waiting for a clock restore.
+ ******************************************************************************/
+SL_CODE_CLASSIFY(SL_CODE_COMPONENT_POWER_MANAGER, SL_CODE_CLASS_TIME_CRITICAL)
+void sli_power_manager_profiler_record_restore_wait(uint32_t ticks);
+#endif
+
 #if !defined(SL_CATALOG_POWER_MANAGER_NO_DEEPSLEEP_PRESENT)
 SL_CODE_CLASSIFY(SL_CODE_COMPONENT_POWER_MANAGER, SL_CODE_CLASS_TIME_CRITICAL)
 void sli_power_manager_save_states(void);
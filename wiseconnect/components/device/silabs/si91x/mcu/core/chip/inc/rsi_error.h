@@ -201,8 +201,11 @@ typedef enum errnoCode {
   ERROR_CRC_INVALID_ARG = ERROR_CRC_BASE + 1,
 
   /*SSI ERROR CODES*/
-  ERROR_RNG_BASE        = 0x1400,
-  ERROR_RNG_INVALID_ARG = ERROR_RNG_BASE + 1,
+  ERROR_RNG_BASE             = 0x1400,
+  ERROR_RNG_INVALID_ARG      = ERROR_RNG_BASE + 1,
+  ERROR_RNG_NO_ENTROPY       = ERROR_RNG_BASE + 2,
+  ERROR_RNG_HEALTH_TEST_FAIL = ERROR_RNG_BASE + 3,
+  ERROR_RNG_RING_DISABLED    = ERROR_RNG_BASE + 4,
 
   /*NPSS ERROR CODES*/
   ERROR_BOD_BASE               = 0x1500,
@@ -0,0 +1,146 @@
+/***************************************************************************/ /**
+* @file  rsi_rng_ring.h
+ *******************************************************************************
+ * # License
+ * <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+ *******************************************************************************
+ *
+ * SPDX-License-Identifier: Zlib
+ *
+ * The licensor of this software is Silicon Laboratories Inc.
+ *
+ * This software is provided 'as-is', without any express or implied
+ * warranty. In no event will the authors be held liable for any damages
+ * arising from the use of this software.
+ *
+ * Permission is granted to anyone to use this software for any purpose,
+ * including commercial applications, and to alter it and redistribute it
+ * freely, subject to the following restrictions:
+ *
+ * 1. The origin of this software must not be misrepresented; you must not
+ *    claim that you wrote the original software. If you use this software
+ *    in a product, an acknowledgment in the product documentation would be
+ *    appreciated but is not required.
+ * 2. Altered source versions must be plainly marked as such, and must not be
+ *    misrepresented as being the original software.
+ * 3. This notice may not be removed or altered from any source distribution.
+ *
+ ******************************************************************************/
+
+//Include Files
+
+#include "rsi_ccp_common.h"
+#include "base_types.h"
+#include "rsi_rng.h"
+
+#ifndef RSI_RNG_RING_H
+#define RSI_RNG_RING_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * The RNG ring keeps HWRNG output in RAM so that callers needing a few random
+ * words do not have to read the HWRNG themselves. The HWRNG has no interrupt
+ * and no DMA request, so the ring is topped up by rng_ring_refill(), which reads
+ * at most RSI_RNG_RING_REFILL_CHUNK words per call and is meant to be called
+ * from an idle hook, a low priority task or a low priority timer interrupt.
+ *
+ * - Refilling starts once the ring holds fewer than RSI_RNG_RING_LOW_WATERMARK
+ *   words and goes on until it holds RSI_RNG_RING_HIGH_WATERMARK words.
+ * - Every raw word is split in four byte samples and run through the
+ *   repetition count and adaptive proportion tests of NIST SP 800-90B before
+ *   entering the ring. A chunk failing either test is discarded.
+ * - After RSI_RNG_RING_MAX_HEALTH_FAILURES consecutive failed chunks the ring
+ *   is wiped and disabled until rng_ring_init() is called again.
+ * - Words are wiped from the ring as soon as they are handed out.
+ *
+ * A single refill context and a single fetch context may run concurrently,
+ * e.g. refill from an interrupt and fetch from thread context.
+ *
+ * When RSI_RNG_RING_ENABLE is defined, RSI_RNG_GetBytes() is served from the
+ * ring and falls back to the HWRNG for the part the ring cannot provide. The
+ * words read from the HWRNG directly are health tested as well. Once the ring
+ * is disabled, or when a direct word fails the tests, the output is
+ * zero-filled, and rng_ring_get_bytes_checked() returns an error.
+ */
+
+// Size of the ring in 32 bit words, must be a power of two
+#ifndef RSI_RNG_RING_SIZE
+#define RSI_RNG_RING_SIZE 64
+#endif
+
+// A refill is due once fewer words than this are left in the ring
+#ifndef RSI_RNG_RING_LOW_WATERMARK
+#define RSI_RNG_RING_LOW_WATERMARK 16
+#endif
+
+// A refill goes on until the ring holds this many words
+#ifndef RSI_RNG_RING_HIGH_WATERMARK
+#define RSI_RNG_RING_HIGH_WATERMARK RSI_RNG_RING_SIZE
+#endif
+
+// Number of words read from the HWRNG per refill call
+#ifndef RSI_RNG_RING_REFILL_CHUNK
+#define RSI_RNG_RING_REFILL_CHUNK 8
+#endif
+
+// Consecutive failed chunks after which the ring is disabled
+#ifndef RSI_RNG_RING_MAX_HEALTH_FAILURES
+#define RSI_RNG_RING_MAX_HEALTH_FAILURES 3
+#endif
+
+// Repetition count test cutoff, 1 + ceil(20 / H) for 4 bits of min-entropy per byte
+#ifndef RSI_RNG_RING_RCT_CUTOFF
+#define RSI_RNG_RING_RCT_CUTOFF 6
+#endif
+
+// Adaptive proportion test window in byte samples
+#ifndef RSI_RNG_RING_APT_WINDOW
+#define RSI_RNG_RING_APT_WINDOW 512
+#endif
+
+// Adaptive proportion test cutoff for a 512 sample window and 4 bits of min-entropy per byte
+#ifndef RSI_RNG_RING_APT_CUTOFF
+#define RSI_RNG_RING_APT_CUTOFF 62
+#endif
+
+#if (RSI_RNG_RING_SIZE & (RSI_RNG_RING_SIZE - 1)) != 0
+#error "RSI_RNG_RING_SIZE must be a power of two"
+#endif
+#if (RSI_RNG_RING_LOW_WATERMARK >= RSI_RNG_RING_HIGH_WATERMARK) || (RSI_RNG_RING_HIGH_WATERMARK > RSI_RNG_RING_SIZE)
+#error "RSI_RNG_RING watermarks must satisfy LOW < HIGH <= SIZE"
+#endif
+#if (RSI_RNG_RING_REFILL_CHUNK == 0) || (RSI_RNG_RING_REFILL_CHUNK > RSI_RNG_RING_SIZE)
+#error "RSI_RNG_RING_REFILL_CHUNK must be between 1 and RSI_RNG_RING_SIZE"
+#endif
+
+/// RNG ring statistics and health counters
+typedef struct rng_ring_stats {
+  uint32_t level;               ///< Words currently available in the ring
+  uint32_t ring_hits;           ///< Requests served from the ring
+  uint32_t ring_misses;         ///< Requests the ring could not fully serve
+  uint32_t refills;             ///< Chunks accepted into the ring
+  uint32_t rct_failures;        ///< Chunks rejected by the repetition count test
+  uint32_t apt_failures;        ///< Chunks rejected by the adaptive proportion test
+  uint32_t direct_rct_failures; ///< Direct HWRNG reads rejected by the repetition count test
+  uint32_t direct_apt_failures; ///< Direct HWRNG reads rejected by the adaptive proportion test
+  uint8_t disabled;             ///< Ring disabled after repeated health test failures
+} rng_ring_stats_t;
+
+rsi_error_t rng_ring_init(HWRNG_Type *pRNG);
+rsi_error_t rng_ring_refill(void);
+uint8_t rng_ring_refill_needed(void);
+uint32_t rng_ring_get_level(void);
+rsi_error_t rng_ring_fetch(uint32_t *random_words, uint32_t number_of_words);
+rsi_error_t rng_ring_get_bytes_checked(HWRNG_Type *pRNG, uint32_t *random_bytes, uint32_t number_of_bytes);
+void rng_ring_get_bytes(HWRNG_Type *pRNG, uint32_t *random_bytes, uint32_t number_of_bytes);
+void rng_ring_flush(void);
+void rng_ring_get_stats(rng_ring_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // RSI_RNG_RING_H
@@ -0,0 +1,475 @@
+/******************************************************************************
+* @file  rsi_rng_ring.c
+*******************************************************************************
+* # License
+* <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+*******************************************************************************
+*
+* SPDX-License-Identifier: Zlib
+*
+* The licensor of this software is Silicon Laboratories Inc.
+*
+* This software is provided 'as-is', without any express or implied
+* warranty. In no event will the authors be held liable for any damages
+* arising from the use of this software.
+*
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it
+* freely, subject to the following restrictions:
+*
+* 1. The origin of this software must not be misrepresented; you must not
+*    claim that you wrote the original software. If you use this software
+*    in a product, an acknowledgment in the product documentation would be
+*    appreciated but is not required.
+* 2. Altered source versions must be plainly marked as such, and must not be
+*    misrepresented as being the original software.
+* 3. This notice may not be removed or altered from any source distribution.
+*
+******************************************************************************/
+
+// Include Files
+
+#include "rsi_rng_ring.h"
+#include "rsi_rom_rng.h"
+#include <string.h>
+
+#define RNG_RING_MASK (RSI_RNG_RING_SIZE - 1U)
+
+#define RNG_HEALTH_OK       0U
+#define RNG_HEALTH_RCT_FAIL 1U
+#define RNG_HEALTH_APT_FAIL 2U
+
+// Ring storage. Words between tail and head are available, the refill context
+// only moves the head and the fetch context only moves the tail.
+static volatile uint32_t ring_words[RSI_RNG_RING_SIZE];
+static volatile uint32_t ring_head;
+static volatile uint32_t ring_tail;
+static volatile uint8_t ring_refilling;
+static volatile uint8_t ring_disabled;
+static HWRNG_Type *ring_rng;
+
+// Continuous health test state
+typedef struct rng_health {
+  uint8_t rct_sample;
+  uint32_t rct_count;
+  uint8_t apt_sample;
+  uint32_t apt_count;
+  uint32_t apt_seen;
+} rng_health_t;
+
+// Owned by the refill context
+static rng_health_t ring_health;
+static uint32_t consecutive_failures;
+
+// Owned by the fetch context, for words read from the HWRNG directly
+static rng_health_t direct_health;
+
+static rng_ring_stats_t ring_stats;
+
+static void rng_ring_health_reset(rng_health_t *health);
+static uint32_t rng_ring_health_test(rng_health_t *health, uint32_t word);
+static uint32_t rng_ring_take(uint32_t *random_words, uint32_t number_of_words, uint8_t all_or_nothing);
+static rsi_error_t rng_ring_hw_get_bytes(HWRNG_Type *pRNG, uint32_t *random_bytes, uint32_t number_of_bytes);
+
+/*==============================================*/
+/**
+ * @fn           rsi_error_t rng_ring_init(HWRNG_Type *pRNG)
+ * @brief        This API is used to bind the RNG ring to a HWRNG instance and empty it
+ * @param[in]    pRNG  : pointer to the control register, the HWRNG must have been
+ *                       started with rng_start() before the first refill
+ * @return       RSI_OK on success, ERROR_RNG_INVALID_ARG if pRNG is NULL
+ * @note         Must not be called concurrently with any other ring API.
+ */
+rsi_error_t rng_ring_init(HWRNG_Type *pRNG)
+{
+  uint32_t i;
+
+  if (pRNG == NULL) {
+    return ERROR_RNG_INVALID_ARG;
+  }
+  for (i = 0; i < RSI_RNG_RING_SIZE; i++) {
+    ring_words[i] = 0;
+  }
+  ring_head            = 0;
+  ring_tail            = 0;
+  ring_refilling       = 1;
+  ring_disabled        = 0;
+  consecutive_failures = 0;
+  rng_ring_health_reset(&ring_health);
+  rng_ring_health_reset(&direct_health);
+  memset(&ring_stats, 0, sizeof(ring_stats));
+  ring_rng = pRNG;
+
+  return RSI_OK;
+}
+
+/*==============================================*/
+/**
+ * @fn           rsi_error_t rng_ring_refill(void)
+ * @brief        This API is used to top up the RNG ring by at most one chunk
+ * @details      Once the ring is below its low watermark, every call reads up to
+ *               RSI_RNG_RING_REFILL_CHUNK words from the HWRNG, health tests them and
+ *               appends them to the ring, until the high watermark is reached.
+ *               Calls made while the ring is above its low watermark return at once.
+ * @return       RSI_OK if the ring was refilled or did not need it,
+ *               ERROR_RNG_HEALTH_TEST_FAIL if the chunk was rejected,
+ *               ERROR_RNG_RING_DISABLED if the ring is not initialized or has been disabled
+ */
+rsi_error_t rng_ring_refill(void)
+{
+  uint32_t level;
+  uint32_t count;
+  uint32_t result = RNG_HEALTH_OK;
+  uint32_t i;
+
+  if ((ring_rng == NULL) || ring_disabled) {
+    return ERROR_RNG_RING_DISABLED;
+  }
+
+  level = ring_head - ring_tail;
+  if (!ring_refilling) {
+    if (level >= RSI_RNG_RING_LOW_WATERMARK) {
+      return RSI_OK;
+    }
+    ring_refilling = 1;
+  }
+  if (level >= RSI_RNG_RING_HIGH_WATERMARK) {
+    ring_refilling = 0;
+    return RSI_OK;
+  }
+
+  count = RSI_RNG_RING_HIGH_WATERMARK - level;
+  if (count > RSI_RNG_RING_REFILL_CHUNK) {
+    count = RSI_RNG_RING_REFILL_CHUNK;
+  }
+
+  // Free slots past the head are not visible to the fetch context, so the chunk
+  // is staged in place and only published once it has passed the health tests.
+  for (i = 0; (i < count) && (result == RNG_HEALTH_OK); i++) {
+    uint32_t word                               = ring_rng->HWRNG_RAND_NUM_REG;
+    ring_words[(ring_head + i) & RNG_RING_MASK] = word;
+    result                                      = rng_ring_health_test(&ring_health, word);
+  }
+
+  if (result != RNG_HEALTH_OK) {
+    while (i > 0) {
+      i--;
+      ring_words[(ring_head + i) & RNG_RING_MASK] = 0;
+    }
+    if (result == RNG_HEALTH_RCT_FAIL) {
+      ring_stats.rct_failures++;
+    } else {
+      ring_stats.apt_failures++;
+    }
+    rng_ring_health_reset(&ring_health);
+    consecutive_failures++;
+    if (consecutive_failures >= RSI_RNG_RING_MAX_HEALTH_FAILURES) {
+      // The flag is raised before wiping, see rng_ring_take()
+      ring_disabled = 1;
+      for (i = 0; i < RSI_RNG_RING_SIZE; i++) {
+        ring_words[i] = 0;
+      }
+    }
+    return ERROR_RNG_HEALTH_TEST_FAIL;
+  }
+
+  consecutive_failures = 0;
+  ring_head += count;
+  ring_stats.refills++;
+  if ((level + count) >= RSI_RNG_RING_HIGH_WATERMARK) {
+    ring_refilling = 0;
+  }
+
+  return RSI_OK;
+}
+
+/*==============================================*/
+/**
+ * @fn           uint8_t rng_ring_refill_needed(void)
+ * @brief        This API is used to check whether rng_ring_refill() has work to do
+ * @return       1 if the ring is being refilled or is below its low watermark, 0 otherwise
+ */
+uint8_t rng_ring_refill_needed(void)
+{
+  if ((ring_rng == NULL) || ring_disabled) {
+    return 0;
+  }
+  return (ring_refilling || ((ring_head - ring_tail) < RSI_RNG_RING_LOW_WATERMARK)) ? 1 : 0;
+}
+
+/*==============================================*/
+/**
+ * @fn           uint32_t rng_ring_get_level(void)
+ * @brief        This API is used to get the number of words available in the RNG ring
+ * @return       number of available words, 0 if the ring is disabled
+ */
+uint32_t rng_ring_get_level(void)
+{
+  if (ring_disabled) {
+    return 0;
+  }
+  return ring_head - ring_tail;
+}
+
+/*==============================================*/
+/**
+ * @fn           rsi_error_t rng_ring_fetch(uint32_t *random_words, uint32_t number_of_words)
+ * @brief        This API is used to take random words from the RNG ring without waiting
+ * @param[out]   random_words     : array receiving the random words
+ * @param[in]    number_of_words  : number of words requested
+ * @return       RSI_OK if the full request was served,
+ *               ERROR_RNG_INVALID_ARG if random_words is NULL,
+ *               ERROR_RNG_NO_ENTROPY if the ring holds fewer words, nothing is consumed then,
+ *               ERROR_RNG_RING_DISABLED if the ring is not initialized or has been disabled
+ */
+rsi_error_t rng_ring_fetch(uint32_t *random_words, uint32_t number_of_words)
+{
+  if ((random_words == NULL) && (number_of_words != 0)) {
+    return ERROR_RNG_INVALID_ARG;
+  }
+  if ((ring_rng == NULL) || ring_disabled) {
+    return ERROR_RNG_RING_DISABLED;
+  }
+  if (number_of_words == 0) {
+    return RSI_OK;
+  }
+  if (rng_ring_take(random_words, number_of_words, 1) != number_of_words) {
+    return ring_disabled ? ERROR_RNG_RING_DISABLED : ERROR_RNG_NO_ENTROPY;
+  }
+  return RSI_OK;
+}
+
+/*==============================================*/
+/**
+ * @fn           rsi_error_t rng_ring_get_bytes_checked(HWRNG_Type *pRNG, uint32_t *random_bytes,
+ *                                                      uint32_t number_of_bytes)
+ * @brief        This API is used to get random words from the RNG ring, the HWRNG provides
+ *               what the ring cannot
+ * @param[in]    pRNG             : pointer to the control register
+ * @param[out]   random_bytes     : array receiving the random words
+ * @param[in]    number_of_bytes  : number of words requested
+ * @return       RSI_OK if the full request was served,
+ *               ERROR_RNG_INVALID_ARG if pRNG or random_bytes is NULL,
+ *               ERROR_RNG_RING_DISABLED if pRNG is the ring's HWRNG and the ring has been disabled,
+ *               ERROR_RNG_HEALTH_TEST_FAIL if a word read from the HWRNG failed the health tests
+ * @note         Words read from the HWRNG directly go through the same health tests as the
+ *               ring, with a separate state. On any failure the output is zero-filled.
+ */
+rsi_error_t rng_ring_get_bytes_checked(HWRNG_Type *pRNG, uint32_t *random_bytes, uint32_t number_of_bytes)
+{
+  uint32_t taken = 0;
+  rsi_error_t status;
+  uint32_t i;
+
+  if ((pRNG == NULL) || ((random_bytes == NULL) && (number_of_bytes != 0))) {
+    return ERROR_RNG_INVALID_ARG;
+  }
+
+  status = RSI_OK;
+  if (pRNG == ring_rng) {
+    if (ring_disabled) {
+      status = ERROR_RNG_RING_DISABLED;
+    } else {
+      taken = rng_ring_take(random_bytes, number_of_bytes, 0);
+    }
+  }
+  if ((status == RSI_OK) && (taken < number_of_bytes)) {
+    status = rng_ring_hw_get_bytes(pRNG, &random_bytes[taken], number_of_bytes - taken);
+  }
+
+  if (status != RSI_OK) {
+    for (i = 0; i < number_of_bytes; i++) {
+      random_bytes[i] = 0;
+    }
+  }
+  return status;
+}
+
+/*==============================================*/
+/**
+ * @fn           void rng_ring_get_bytes(HWRNG_Type *pRNG, uint32_t *random_bytes, uint32_t number_of_bytes)
+ * @brief        This API is used to get random words from the RNG ring, the HWRNG provides
+ *               what the ring cannot
+ * @param[in]    pRNG             : pointer to the control register
+ * @param[out]   random_bytes     : array receiving the random words
+ * @param[in]    number_of_bytes  : number of words requested
+ * @return       none
+ * @note         Same contract as rng_get_bytes(), which backs RSI_RNG_GetBytes() when
+ *               RSI_RNG_RING_ENABLE is defined. The output is zero-filled when
+ *               rng_ring_get_bytes_checked() fails, use it to get the status.
+ */
+void rng_ring_get_bytes(HWRNG_Type *pRNG, uint32_t *random_bytes, uint32_t number_of_bytes)
+{
+  (void)rng_ring_get_bytes_checked(pRNG, random_bytes, number_of_bytes);
+}
+
+/*==============================================*/
+/**
+ * @fn           void rng_ring_flush(void)
+ * @brief        This API is used to wipe all words held in the RNG ring, e.g. before
+ *               entering a sleep state that retains RAM
+ * @return       none
+ * @note         Must not be called concurrently with rng_ring_refill().
+ */
+void rng_ring_flush(void)
+{
+  uint32_t i;
+
+  for (i = 0; i < RSI_RNG_RING_SIZE; i++) {
+    ring_words[i] = 0;
+  }
+  ring_tail      = ring_head;
+  ring_refilling = 1;
+}
+
+/*==============================================*/
+/**
+ * @fn           void rng_ring_get_stats(rng_ring_stats_t *stats)
+ * @brief        This API is used to read the RNG ring statistics and health counters
+ * @param[out]   stats  : statistics snapshot
+ * @return       none
+ */
+void rng_ring_get_stats(rng_ring_stats_t *stats)
+{
+  if (stats == NULL) {
+    return;
+  }
+  *stats          = ring_stats;
+  stats->level    = rng_ring_get_level();
+  stats->disabled = ring_disabled;
+}
+
+/*==============================================*/
+/**
+ * @fn           static void rng_ring_health_reset(rng_health_t *health)
+ * @brief        Restarts both health tests, the next sample opens a new window
+ * @param[in]    health  : health test state
+ * @return       none
+ */
+static void rng_ring_health_reset(rng_health_t *health)
+{
+  health->rct_sample = 0;
+  health->rct_count  = 0;
+  health->apt_sample = 0;
+  health->apt_count  = 0;
+  health->apt_seen   = 0;
+}
+
+/*==============================================*/
+/**
+ * @fn           static uint32_t rng_ring_health_test(rng_health_t *health, uint32_t word)
+ * @brief        Runs the repetition count and adaptive proportion tests of
+ *               NIST SP 800-90B section 4.4 on the four byte samples of a raw word
+ * @param[in]    health  : health test state
+ * @param[in]    word    : raw HWRNG output
+ * @return       RNG_HEALTH_OK, RNG_HEALTH_RCT_FAIL or RNG_HEALTH_APT_FAIL
+ */
+static uint32_t rng_ring_health_test(rng_health_t *health, uint32_t word)
+{
+  uint32_t i;
+
+  for (i = 0; i < 4; i++) {
+    uint8_t sample = (uint8_t)(word >> (8 * i));
+
+    if ((health->rct_count != 0) && (sample == health->rct_sample)) {
+      health->rct_count++;
+      if (health->rct_count >= RSI_RNG_RING_RCT_CUTOFF) {
+        return RNG_HEALTH_RCT_FAIL;
+      }
+    } else {
+      health->rct_sample = sample;
+      health->rct_count  = 1;
+    }
+
+    if (health->apt_seen == 0) {
+      health->apt_sample = sample;
+      health->apt_count  = 1;
+    } else if (sample == health->apt_sample) {
+      health->apt_count++;
+      if (health->apt_count >= RSI_RNG_RING_APT_CUTOFF) {
+        return RNG_HEALTH_APT_FAIL;
+      }
+    }
+    health->apt_seen++;
+    if (health->apt_seen >= RSI_RNG_RING_APT_WINDOW) {
+      health->apt_seen = 0;
+    }
+  }
+  return RNG_HEALTH_OK;
+}
+
+/*==============================================*/
+/**
+ * @fn           static uint32_t rng_ring_take(uint32_t *random_words, uint32_t number_of_words,
+ *                                             uint8_t all_or_nothing)
+ * @brief        Copies words out of the ring and wipes their slots
+ * @param[out]   random_words     : array receiving the random words
+ * @param[in]    number_of_words  : number of words requested
+ * @param[in]    all_or_nothing   : 1 to take nothing unless the full request can be served
+ * @return       number of words taken
+ */
+static uint32_t rng_ring_take(uint32_t *random_words, uint32_t number_of_words, uint8_t all_or_nothing)
+{
+  uint32_t tail  = ring_tail;
+  uint32_t count = ring_head - tail;
+  uint32_t i;
+
+  if (count > number_of_words) {
+    count = number_of_words;
+  }
+  if ((count == 0) || (all_or_nothing && (count < number_of_words))) {
+    ring_stats.ring_misses++;
+    return 0;
+  }
+
+  for (i = 0; i < count; i++) {
+    random_words[i]                        = ring_words[(tail + i) & RNG_RING_MASK];
+    ring_words[(tail + i) & RNG_RING_MASK] = 0;
+  }
+
+  // The refill context raises the flag before wiping the ring on a health
+  // failure, so words copied after the wipe started are caught here.
+  if (ring_disabled) {
+    for (i = 0; i < count; i++) {
+      random_words[i] = 0;
+    }
+    return 0;
+  }
+
+  ring_tail = tail + count;
+  if (count == number_of_words) {
+    ring_stats.ring_hits++;
+  } else {
+    ring_stats.ring_misses++;
+  }
+  return count;
+}
+
+/*==============================================*/
+/**
+ * @fn           static rsi_error_t rng_ring_hw_get_bytes(HWRNG_Type *pRNG, uint32_t *random_bytes,
+ *                                                        uint32_t number_of_bytes)
+ * @brief        Reads random words from the HWRNG, bypassing the ring, and health tests them
+ * @return       RSI_OK, or ERROR_RNG_HEALTH_TEST_FAIL if a word failed the health tests
+ */
+static rsi_error_t rng_ring_hw_get_bytes(HWRNG_Type *pRNG, uint32_t *random_bytes, uint32_t number_of_bytes)
+{
+  uint32_t result = RNG_HEALTH_OK;
+  uint32_t i;
+
+  for (i = 0; (i < number_of_bytes) && (result == RNG_HEALTH_OK); i++) {
+    random_bytes[i] = pRNG->HWRNG_RAND_NUM_REG;
+    result          = rng_ring_health_test(&direct_health, random_bytes[i]);
+  }
+
+  if (result != RNG_HEALTH_OK) {
+    if (result == RNG_HEALTH_RCT_FAIL) {
+      ring_stats.direct_rct_failures++;
+    } else {
+      ring_stats.direct_apt_failures++;
+    }
+    rng_ring_health_reset(&direct_health);
+    return ERROR_RNG_HEALTH_TEST_FAIL;
+  }
+  return RSI_OK;
+}
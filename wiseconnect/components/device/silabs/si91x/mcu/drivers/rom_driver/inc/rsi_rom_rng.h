@@ -43,6 +43,9 @@
 #else
 #include "rsi_rom_table_RS1xxxx.h"
 #endif
+#if defined(RSI_RNG_RING_ENABLE)
+#include "rsi_rng_ring.h"
+#endif
 
 #ifdef __cplusplus
 extern "C" {
@@ -89,10 +92,16 @@ STATIC INLINE void RSI_RNG_Stop(HWRNG_Type *pRNG)
  * @param[in]    numberOfBytes : Number of bytes to generate
  * @param[out]   randomBytes	 : variable or array to store generated random bytes
  * @return       none
+ * @note         With RSI_RNG_RING_ENABLE defined, the words are taken from the RNG ring
+ *               first and the output is zero-filled on a health test failure or once the
+ *               ring is disabled, see rsi_rng_ring.h. Use rng_ring_get_bytes_checked() to
+ *               get the status.
  */
 STATIC INLINE void RSI_RNG_GetBytes(HWRNG_Type *pRNG, uint32_t *randomBytes, uint32_t numberOfBytes)
 {
-#if defined(RNG_ROMDRIVER_PRESENT)
+#if defined(RSI_RNG_RING_ENABLE)
+  rng_ring_get_bytes(pRNG, randomBytes, numberOfBytes);
+#elif defined(RNG_ROMDRIVER_PRESENT)
   ROMAPI_RNG_API->rng_get_bytes(pRNG, randomBytes, numberOfBytes);
 #else
   rng_get_bytes(pRNG, randomBytes, numberOfBytes);
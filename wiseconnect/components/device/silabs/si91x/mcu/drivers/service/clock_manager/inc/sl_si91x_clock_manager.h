@@ -49,6 +49,60 @@ extern "C" {
 // GLOBAL DEFINES / MACROS
 // Macros for defining supported PLL Ref Clock frequencies
 #define PLL_REF_CLK_VAL_XTAL (40000000UL) ///< PLL reference clock frequency value of XTAL CLK
+
+/// PLL output frequencies (in MHz) for which divider sets are generated at build time,
+/// for each reference clock of SL_SI91X_PLL_TABLE_REF_CLOCKS_MHZ. Can be overridden to
+/// match the frequencies the application actually switches to.
+#ifndef SL_SI91X_PLL_TABLE_FREQUENCIES_MHZ
+#define SL_SI91X_PLL_TABLE_FREQUENCIES_MHZ(ENTRY, ref_mhz) \
+  ENTRY(20, ref_mhz)                                       \
+  ENTRY(32, ref_mhz)                                       \
+  ENTRY(40, ref_mhz)                                       \
+  ENTRY(48, ref_mhz)                                       \
+  ENTRY(64, ref_mhz)                                       \
+  ENTRY(80, ref_mhz)                                       \
+  ENTRY(90, ref_mhz)                                       \
+  ENTRY(100, ref_mhz)                                      \
+  ENTRY(120, ref_mhz)                                      \
+  ENTRY(150, ref_mhz)                                      \
+  ENTRY(160, ref_mhz)                                      \
+  ENTRY(180, ref_mhz)                                      \
+  ENTRY(200, ref_mhz)                                      \
+  ENTRY(240, ref_mhz)
+#endif
+
+/// PLL reference clocks (in MHz) for which the divider table is generated
+#ifndef SL_SI91X_PLL_TABLE_REF_CLOCKS_MHZ
+#define SL_SI91X_PLL_TABLE_REF_CLOCKS_MHZ(REF) \
+  REF(40) /* XTAL */                           \
+  REF(32) /* MHz RC */
+#endif
+
+// The macros below compute, as constant expressions, the divider set derived at
+// runtime by clk_set_soc_pll_freq() and clk_set_intf_pll_freq() on parts without the
+// 110 MHz limit: 1 MHz phase detector (N = reference - 1), DCO at the output frequency
+// times the post divider, M halved once the DCO runs above 200 MHz.
+#define SL_SI91X_PLL_SHIFT(f) \
+  ((f) < 2 ? 7 : (f) < 4 ? 6 : (f) < 8 ? 5 : (f) < 16 ? 4 : (f) < 32 ? 3 : (f) < 64 ? 2 : (f) < 127 ? 1 : 0)
+#define SL_SI91X_PLL_DCO(f)        ((f) << SL_SI91X_PLL_SHIFT(f))
+#define SL_SI91X_PLL_DIV_FACTOR(f) ((1 << SL_SI91X_PLL_SHIFT(f)) - 1)
+#define SL_SI91X_PLL_M_FACTOR(f) \
+  (SL_SI91X_PLL_DCO(f) >= 201 ? (SL_SI91X_PLL_DCO(f) / 2) - 1 : SL_SI91X_PLL_DCO(f) - 1)
+#define SL_SI91X_PLL_FCW_F(f) ((((f) >= 201) && ((f) % 2)) ? 8192 : 0)
+#define SL_SI91X_PLL_DCO_FIX_SEL(f) \
+  (SL_SI91X_PLL_DCO(f) >= 251 ? 2 : SL_SI91X_PLL_DCO(f) >= 201 ? 0 : 1)
+#define SL_SI91X_PLL_LDO_PROG(f) (SL_SI91X_PLL_DCO(f) >= 201 ? 5 : 4)
+
+/// Initializer of a @ref sl_si91x_pll_divider_t table entry, frequencies in MHz
+#define SL_SI91X_PLL_DIVIDER(freq_mhz, ref_mhz)                                                    \
+  { .pll_freq    = (freq_mhz) * 1000000UL,                                                         \
+    .pll_ref_clk = (ref_mhz) * 1000000UL,                                                          \
+    .div_factor  = SL_SI91X_PLL_DIV_FACTOR(freq_mhz),                                              \
+    .n_factor    = (ref_mhz) - 1,                                                                  \
+    .m_factor    = SL_SI91X_PLL_M_FACTOR(freq_mhz),                                                \
+    .fcw_f       = SL_SI91X_PLL_FCW_F(freq_mhz),                                                   \
+    .dco_fix_sel = SL_SI91X_PLL_DCO_FIX_SEL(freq_mhz),                                             \
+    .ldo_prog    = SL_SI91X_PLL_LDO_PROG(freq_mhz) },
 // -----------------------------------------------------------------------------------
 
 /***************************************************************************/
@@ -64,6 +118,25 @@ extern "C" {
  * @note Ensure that the selected clock source is properly configured and stable before switching to avoid system instability.
  ******************************************************************************/
 typedef M4_SOC_CLK_SRC_SEL_T sl_si91x_m4_soc_clk_src_sel_t;
+
+/***************************************************************************/
+/**
+ * @brief Validated SoC/interface PLL divider set for one output frequency.
+ *
+ * @details The fields map one-to-one to the parameters of RSI_CLK_SocPllSetFreqDiv()
+ *          and RSI_CLK_IntfPllSetFreqDiv(). Entries are generated at build time with
+ *          @ref SL_SI91X_PLL_DIVIDER so that no divider search is needed on a frequency change.
+ ******************************************************************************/
+typedef struct {
+  uint32_t pll_freq;    ///< PLL output frequency in Hz
+  uint32_t pll_ref_clk; ///< PLL reference clock in Hz
+  uint16_t div_factor;  ///< Post division factor
+  uint16_t n_factor;    ///< Reference division factor
+  uint16_t m_factor;    ///< Feedback multiplication factor
+  uint16_t fcw_f;       ///< Fractional frequency control word
+  uint16_t dco_fix_sel; ///< DCO fixed ring select
+  uint16_t ldo_prog;    ///< PLL LDO output voltage select
+} sl_si91x_pll_divider_t;
 // -----------------------------------------------------------------------------------
 
 // -----------------------------------------------------------------------------------
@@ -152,6 +225,42 @@ uint32_t sl_si91x_clock_manager_get_pll_freq(PLL_TYPE_T pll_type);
  * For more information on status codes, see [SL STATUS DOCUMENTATION](https://docs.silabs.com/gecko-platform/latest/platform-common/status).
  ******************************************************************************/
 sl_status_t sl_si91x_clock_manager_control_pll(PLL_TYPE_T pll_type, bool enable);
+
+/***************************************************************************/
+/**
+ * @brief Looks up the precomputed divider set of a PLL frequency.
+ * 
+ * @param[in] pll_freq PLL output frequency in Hz.
+ * @param[in] pll_ref_clk PLL reference clock frequency in Hz.
+ * 
+ * @return Pointer to the divider set, or NULL if the frequency is not in the table or the
+ *         part is frequency limited. @ref sl_si91x_clock_manager_set_pll_freq must be used then.
+ * 
+ * @note Frequency limited parts derive their dividers differently and check the PLL lock
+ *       quality afterwards, so the table is never used for them.
+ ******************************************************************************/
+const sl_si91x_pll_divider_t *sl_si91x_clock_manager_lookup_pll_divider(uint32_t pll_freq, uint32_t pll_ref_clk);
+
+/***************************************************************************/
+/**
+ * @brief Programs the SoC or interface PLL with a precomputed divider set and waits for lock.
+ * 
+ * @param[in] pll_type SOC_PLL or INTF_PLL.
+ * @param[in] divider Divider set returned by @ref sl_si91x_clock_manager_lookup_pll_divider.
+ * 
+ * @return sl_status_t Status code indicating the result:
+ *         - SL_STATUS_OK  - Success.
+ *         - SL_STATUS_NULL_POINTER  - divider is NULL.
+ *         - SL_STATUS_INVALID_PARAMETER  - pll_type is not supported.
+ *         - Corresponding error code on failure.
+ * 
+ * @note The PLL must have been configured once with @ref sl_si91x_clock_manager_set_pll_freq,
+ *       which turns it on and selects its reference clock. The clocks derived from the PLL must
+ *       be switched away or idle while it is reprogrammed. Power state and voltage are not changed.
+ * 
+ * For more information on status codes, see [SL STATUS DOCUMENTATION](https://docs.silabs.com/gecko-platform/latest/platform-common/status).
+ ******************************************************************************/
+sl_status_t sl_si91x_clock_manager_set_pll_divider(PLL_TYPE_T pll_type, const sl_si91x_pll_divider_t *divider);
 // -----------------------------------------------------------------------------------
 
 /// @} end addtogroup CLOCK-MANAGER ******************************************************/
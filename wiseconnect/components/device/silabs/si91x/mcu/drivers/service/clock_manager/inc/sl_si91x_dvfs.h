@@ -0,0 +1,211 @@
+/******************************************************************************
+* @file sl_si91x_dvfs.h
+* @brief Dynamic Voltage and Frequency Scaling Service API
+*******************************************************************************
+* # License
+* <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+*******************************************************************************
+*
+* SPDX-License-Identifier: Zlib
+*
+* The licensor of this software is Silicon Laboratories Inc.
+*
+* This software is provided 'as-is', without any express or implied
+* warranty. In no event will the authors be held liable for any damages
+* arising from the use of this software.
+*
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it
+* freely, subject to the following restrictions:
+*
+* 1. The origin of this software must not be misrepresented; you must not
+*    claim that you wrote the original software. If you use this software
+*    in a product, an acknowledgment in the product documentation would be
+*    appreciated but is not required.
+* 2. Altered source versions must be plainly marked as such, and must not be
+*    misrepresented as being the original software.
+* 3. This notice may not be removed or altered from any source distribution.
+*
+******************************************************************************/
+
+#ifndef SL_SI91X_DVFS_H
+#define SL_SI91X_DVFS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "sl_status.h"
+#include "sl_si91x_clock_manager.h"
+
+/***************************************************************************/
+/**
+ * @addtogroup  CLOCK-MANAGER Clock Manager
+ * @ingroup SI91X_SERVICE_APIS
+ * @{
+ *
+ ******************************************************************************/
+// -----------------------------------------------------------------------------------
+// GLOBAL DEFINES / MACROS
+// SoC PLL frequency (in Hz) and M4 SoC clock division factor of each profile.
+// A division factor of 0 or 1 runs the core at the PLL frequency. Profiles sharing
+// the same PLL frequency are switched by changing the divider only, without relock.
+#ifndef SL_SI91X_DVFS_HIGH_PERFORMANCE_PLL_FREQ
+#define SL_SI91X_DVFS_HIGH_PERFORMANCE_PLL_FREQ (180000000UL) ///< SoC PLL frequency of the high performance profile
+#endif
+#ifndef SL_SI91X_DVFS_HIGH_PERFORMANCE_DIV_FACTOR
+#define SL_SI91X_DVFS_HIGH_PERFORMANCE_DIV_FACTOR 0 ///< M4 SoC clock divider of the high performance profile
+#endif
+#ifndef SL_SI91X_DVFS_BALANCED_PLL_FREQ
+#define SL_SI91X_DVFS_BALANCED_PLL_FREQ (180000000UL) ///< SoC PLL frequency of the balanced profile
+#endif
+#ifndef SL_SI91X_DVFS_BALANCED_DIV_FACTOR
+#define SL_SI91X_DVFS_BALANCED_DIV_FACTOR 2 ///< M4 SoC clock divider of the balanced profile
+#endif
+#ifndef SL_SI91X_DVFS_LOW_POWER_PLL_FREQ
+#define SL_SI91X_DVFS_LOW_POWER_PLL_FREQ (80000000UL) ///< SoC PLL frequency of the low power profile
+#endif
+#ifndef SL_SI91X_DVFS_LOW_POWER_DIV_FACTOR
+#define SL_SI91X_DVFS_LOW_POWER_DIV_FACTOR 0 ///< M4 SoC clock divider of the low power profile
+#endif
+// -----------------------------------------------------------------------------------
+
+/***************************************************************************/
+/**
+ * @brief Named performance profiles of the M4 core.
+ ******************************************************************************/
+typedef enum {
+  SL_SI91X_DVFS_PROFILE_LOW_POWER,        ///< Lowest PLL frequency, PS3 voltage when the PLL allows it
+  SL_SI91X_DVFS_PROFILE_BALANCED,         ///< Divided down core clock, no relock from high performance
+  SL_SI91X_DVFS_PROFILE_HIGH_PERFORMANCE, ///< Highest core clock
+  SL_SI91X_DVFS_PROFILE_COUNT,            ///< Number of profiles, not a valid profile
+} sl_si91x_dvfs_profile_t;
+
+/***************************************************************************/
+/**
+ * @brief Events notified to the DVFS subscribers.
+ ******************************************************************************/
+typedef enum {
+  SL_SI91X_DVFS_EVENT_PRE_CHANGE,  ///< Clocks are about to change, pause transfers that depend on them
+  SL_SI91X_DVFS_EVENT_POST_CHANGE, ///< Clocks have changed, recompute dividers and resume
+} sl_si91x_dvfs_event_t;
+
+/***************************************************************************/
+/**
+ * @brief Callback notified of a profile change.
+ *
+ * @param[in] event PRE_CHANGE or POST_CHANGE.
+ * @param[in] from Profile being left.
+ * @param[in] to Profile being entered.
+ * @param[in] context Context given at subscription.
+ ******************************************************************************/
+typedef void (*sl_si91x_dvfs_callback_t)(sl_si91x_dvfs_event_t event,
+                                         sl_si91x_dvfs_profile_t from,
+                                         sl_si91x_dvfs_profile_t to,
+                                         void *context);
+
+/***************************************************************************/
+/**
+ * @brief Subscription handle, allocated by the subscriber and owned by the service
+ *        until @ref sl_si91x_dvfs_unsubscribe returns.
+ ******************************************************************************/
+typedef struct sl_si91x_dvfs_subscriber {
+  struct sl_si91x_dvfs_subscriber *next; ///< Next subscriber, for internal use
+  sl_si91x_dvfs_callback_t callback;     ///< Notified function
+  void *context;                         ///< Context passed to the callback
+} sl_si91x_dvfs_subscriber_t;
+// -----------------------------------------------------------------------------------
+
+// -----------------------------------------------------------------------------------
+// GLOBAL FUNCTION PROTOTYPES
+
+/***************************************************************************/
+/**
+ * @brief Initializes the DVFS service and switches to the given profile.
+ *
+ * @details The divider set of every profile is resolved once here, so that later profile
+ *          changes only program registers.
+ *
+ * @param[in] profile Initial profile.
+ *
+ * @return sl_status_t Status code indicating the result:
+ *         - SL_STATUS_OK  - Success.
+ *         - SL_STATUS_INVALID_PARAMETER  - Invalid profile.
+ *         - Corresponding error code on failure.
+ *
+ * @note Call after @ref sl_si91x_clock_manager_init.
+ *
+ * For more information on status codes, see [SL STATUS DOCUMENTATION](https://docs.silabs.com/gecko-platform/latest/platform-common/status).
+ ******************************************************************************/
+sl_status_t sl_si91x_dvfs_init(sl_si91x_dvfs_profile_t profile);
+
+/***************************************************************************/
+/**
+ * @brief Switches the M4 core to another performance profile.
+ *
+ * @details The sequence is:
+ *          - subscribers are notified with @ref SL_SI91X_DVFS_EVENT_PRE_CHANGE,
+ *          - when going up, the PS4 voltage and the above 120 MHz bus registering are applied first,
+ *          - the SoC PLL is reprogrammed from its precomputed divider set while the core
+ *            runs from the reference clock, or only the core divider is changed if the PLL
+ *            frequency is the same,
+ *          - when going down, the bus registering and the voltage are relaxed last,
+ *          - subscribers are notified with @ref SL_SI91X_DVFS_EVENT_POST_CHANGE.
+ *
+ * @param[in] profile Profile to switch to.
+ *
+ * @return sl_status_t Status code indicating the result:
+ *         - SL_STATUS_OK  - Success.
+ *         - SL_STATUS_INVALID_PARAMETER  - Invalid profile.
+ *         - SL_STATUS_NOT_INITIALIZED  - @ref sl_si91x_dvfs_init has not been called.
+ *         - Corresponding error code on failure.
+ *
+ * @note Must be called from thread context, and not concurrently with itself or with
+ *       the subscription functions.
+ *
+ * For more information on status codes, see [SL STATUS DOCUMENTATION](https://docs.silabs.com/gecko-platform/latest/platform-common/status).
+ ******************************************************************************/
+sl_status_t sl_si91x_dvfs_set_profile(sl_si91x_dvfs_profile_t profile);
+
+/***************************************************************************/
+/**
+ * @brief Gets the current performance profile.
+ *
+ * @return sl_si91x_dvfs_profile_t Current profile.
+ ******************************************************************************/
+sl_si91x_dvfs_profile_t sl_si91x_dvfs_get_profile(void);
+
+/***************************************************************************/
+/**
+ * @brief Subscribes to profile changes.
+ *
+ * @param[in] handle Subscription handle, must stay valid until unsubscribed.
+ * @param[in] callback Function notified before and after every profile change.
+ * @param[in] context Context passed to the callback.
+ *
+ * @return sl_status_t Status code indicating the result:
+ *         - SL_STATUS_OK  - Success.
+ *         - SL_STATUS_NULL_POINTER  - handle or callback is NULL.
+ *
+ * For more information on status codes, see [SL STATUS DOCUMENTATION](https://docs.silabs.com/gecko-platform/latest/platform-common/status).
+ ******************************************************************************/
+sl_status_t sl_si91x_dvfs_subscribe(sl_si91x_dvfs_subscriber_t *handle,
+                                    sl_si91x_dvfs_callback_t callback,
+                                    void *context);
+
+/***************************************************************************/
+/**
+ * @brief Unsubscribes from profile changes.
+ *
+ * @param[in] handle Subscription handle given to @ref sl_si91x_dvfs_subscribe.
+ ******************************************************************************/
+void sl_si91x_dvfs_unsubscribe(sl_si91x_dvfs_subscriber_t *handle);
+// -----------------------------------------------------------------------------------
+
+/// @} end addtogroup CLOCK-MANAGER ******************************************************/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SL_SI91X_DVFS_H */
@@ -45,9 +45,14 @@
 #define PLL_PREFETCH_LIMIT     (120000000UL) // 120MHz Limit for pll clock
 #define SOC_PLL_FREQ           (180000000UL) // 180MHz default SoC PLL Clock as source to Processor
 #define INTF_PLL_FREQ          (180000000UL) // 180MHz default Interface PLL Clock as source to all peripherals
+#define PLL_REG9_DEFAULT       0xD900        // Value programmed in PLL_500_CTRL_REG9 before every PLL configuration
+
+#define PLL_TABLE_REF_CLOCK(ref_mhz) SL_SI91X_PLL_TABLE_FREQUENCIES_MHZ(SL_SI91X_PLL_DIVIDER, ref_mhz)
 /************************************************************************************
  *************************  LOCAL VARIABLES  ****************************************
  ************************************************************************************/
+// Divider sets generated at build time for every supported reference clock
+static const sl_si91x_pll_divider_t pll_divider_table[] = { SL_SI91X_PLL_TABLE_REF_CLOCKS_MHZ(PLL_TABLE_REF_CLOCK) };
 
 /************************************************************************************
  *************************  LOCAL TYPE DEFINITIONS  *********************************
@@ -339,6 +344,98 @@ sl_status_t sl_si91x_clock_manager_control_pll(PLL_TYPE_T pll_type, bool enable)
 
   return status;
 }
+/***************************************************************************/
+/**
+ * @brief Looks up the precomputed divider set of a PLL frequency.
+ * 
+ * @param[in] pll_freq PLL output frequency in Hz.
+ * @param[in] pll_ref_clk PLL reference clock frequency in Hz.
+ * 
+ * @return Pointer to the divider set, or NULL if the frequency is not in the table or the
+ *         part is frequency limited.
+ ******************************************************************************/
+const sl_si91x_pll_divider_t *sl_si91x_clock_manager_lookup_pll_divider(uint32_t pll_freq, uint32_t pll_ref_clk)
+{
+  // Frequency limited parts use another divider derivation and a lock quality check
+  if ((MCU_RET->CHIP_CONFIG_MCU_READ_b.LIMIT_M4_FREQ_110MHZ_b == 1) || (M4_BBFF_STORAGE1 & BIT(10))) {
+    return NULL;
+  }
+
+  for (uint32_t i = 0; i < (sizeof(pll_divider_table) / sizeof(pll_divider_table[0])); i++) {
+    if ((pll_divider_table[i].pll_freq == pll_freq) && (pll_divider_table[i].pll_ref_clk == pll_ref_clk)) {
+      return &pll_divider_table[i];
+    }
+  }
+
+  return NULL;
+}
+
+/***************************************************************************/
+/**
+ * @brief Programs the SoC or interface PLL with a precomputed divider set and waits for lock.
+ * 
+ * @param[in] pll_type SOC_PLL or INTF_PLL.
+ * @param[in] divider Divider set returned by sl_si91x_clock_manager_lookup_pll_divider().
+ * 
+ * @return sl_status_t Status code indicating the result:
+ *         - SL_STATUS_OK  - Success.
+ *         - SL_STATUS_NULL_POINTER  - divider is NULL.
+ *         - SL_STATUS_INVALID_PARAMETER  - pll_type is not supported.
+ *         - Corresponding error code on failure.
+ * 
+ * For more information on status codes, see [SL STATUS DOCUMENTATION](https://docs.silabs.com/gecko-platform/latest/platform-common/status).
+ ******************************************************************************/
+sl_status_t sl_si91x_clock_manager_set_pll_divider(PLL_TYPE_T pll_type, const sl_si91x_pll_divider_t *divider)
+{
+  M4CLK_Type *pCLK         = M4CLK;
+  rsi_error_t error_status = RSI_OK;
+
+  if (divider == NULL) {
+    return SL_STATUS_NULL_POINTER;
+  }
+
+  switch (pll_type) {
+    case SOC_PLL:
+      // Same lock settings and register preset as the runtime configuration path
+      RSI_CLK_SocPllLockConfig(MANUAL_LOCK, BYPASS_MANUAL_LOCK, SOC_PLL_MM_COUNT_LIMIT);
+      SPI_MEM_MAP_PLL(SOC_PLL_500_CTRL_REG9) = PLL_REG9_DEFAULT;
+
+      error_status = RSI_CLK_SocPllSetFreqDiv(pCLK,
+                                              1,
+                                              divider->div_factor,
+                                              divider->n_factor,
+                                              divider->m_factor,
+                                              divider->fcw_f,
+                                              divider->dco_fix_sel,
+                                              divider->ldo_prog);
+      if (error_status == RSI_OK) {
+        system_clocks.soc_pll_clock = divider->pll_freq;
+      }
+      break;
+
+    case INTF_PLL:
+      SPI_MEM_MAP_PLL(INTF_PLL_500_CTRL_REG9) = PLL_REG9_DEFAULT;
+
+      error_status = RSI_CLK_IntfPllSetFreqDiv(pCLK,
+                                               1,
+                                               divider->div_factor,
+                                               divider->n_factor,
+                                               divider->m_factor,
+                                               divider->fcw_f,
+                                               divider->dco_fix_sel,
+                                               divider->ldo_prog);
+      if (error_status == RSI_OK) {
+        system_clocks.intf_pll_clock = divider->pll_freq;
+      }
+      break;
+
+    default:
+      return SL_STATUS_INVALID_PARAMETER;
+  }
+
+  return convert_rsi_to_sl_error_code(error_status);
+}
+
 /*******************************************************************************
  * To validate the RSI error code
  * While calling the RSI APIs, it returns the RSI Error codes.
@@ -0,0 +1,294 @@
+/******************************************************************************
+* @file sl_si91x_dvfs.c
+* @brief Dynamic Voltage and Frequency Scaling Service API implementation
+*******************************************************************************
+* # License
+* <b>Copyright 2024 Silicon Laboratories Inc. www.silabs.com</b>
+*******************************************************************************
+*
+* SPDX-License-Identifier: Zlib
+*
+* The licensor of this software is Silicon Laboratories Inc.
+*
+* This software is provided 'as-is', without any express or implied
+* warranty. In no event will the authors be held liable for any damages
+* arising from the use of this software.
+*
+* Permission is granted to anyone to use this software for any purpose,
+* including commercial applications, and to alter it and redistribute it
+* freely, subject to the following restrictions:
+*
+* 1. The origin of this software must not be misrepresented; you must not
+*    claim that you wrote the original software. If you use this software
+*    in a product, an acknowledgment in the product documentation would be
+*    appreciated but is not required.
+* 2. Altered source versions must be plainly marked as such, and must not be
+*    misrepresented as being the original software.
+* 3. This notice may not be removed or altered from any source distribution.
+*
+******************************************************************************/
+
+#include "sl_si91x_dvfs.h"
+#include "rsi_rom_clks.h"
+/************************************************************************************
+ *************************  DEFINES / MACROS  ***************************************
+ ************************************************************************************/
+#define PLL_PREFETCH_LIMIT (120000000UL) // Core clock from which prefetch and registering are needed
+#define PS3_PLL_FREQ_LIMIT (90000000UL)  // SoC PLL frequency above which PS4 voltage is needed
+/************************************************************************************
+ *************************  LOCAL TYPE DEFINITIONS  *********************************
+ ************************************************************************************/
+typedef struct {
+  uint32_t pll_freq;   // SoC PLL frequency in Hz
+  uint32_t div_factor; // M4 SoC clock division factor
+} dvfs_profile_config_t;
+/************************************************************************************
+ *************************  LOCAL VARIABLES  ****************************************
+ ************************************************************************************/
+static const dvfs_profile_config_t profile_configs[SL_SI91X_DVFS_PROFILE_COUNT] = {
+  [SL_SI91X_DVFS_PROFILE_LOW_POWER]        = { SL_SI91X_DVFS_LOW_POWER_PLL_FREQ, SL_SI91X_DVFS_LOW_POWER_DIV_FACTOR },
+  [SL_SI91X_DVFS_PROFILE_BALANCED]         = { SL_SI91X_DVFS_BALANCED_PLL_FREQ, SL_SI91X_DVFS_BALANCED_DIV_FACTOR },
+  [SL_SI91X_DVFS_PROFILE_HIGH_PERFORMANCE] = { SL_SI91X_DVFS_HIGH_PERFORMANCE_PLL_FREQ,
+                                               SL_SI91X_DVFS_HIGH_PERFORMANCE_DIV_FACTOR },
+};
+
+// Divider set of each profile, NULL when the runtime search has to be used
+static const sl_si91x_pll_divider_t *profile_dividers[SL_SI91X_DVFS_PROFILE_COUNT];
+
+static sl_si91x_dvfs_profile_t current_profile = SL_SI91X_DVFS_PROFILE_HIGH_PERFORMANCE;
+static bool dvfs_initialized                   = false;
+static bool dvfs_resync                        = false; // Clock state unknown after a failed change
+static sl_si91x_dvfs_subscriber_t *subscribers = NULL;
+/************************************************************************************
+ *************************  LOCAL FUNCTION PROTOTYPES  ******************************
+ ************************************************************************************/
+static sl_status_t apply_profile(sl_si91x_dvfs_profile_t from, sl_si91x_dvfs_profile_t to, bool full_reconfig);
+static void notify_subscribers(sl_si91x_dvfs_event_t event, sl_si91x_dvfs_profile_t from, sl_si91x_dvfs_profile_t to);
+static uint32_t get_core_clock(const dvfs_profile_config_t *config);
+/************************************************************************************
+ *************************  GLOBAL FUNCTION DEFINITIONS  ****************************
+ ************************************************************************************/
+/***************************************************************************/
+/**
+ * @brief Initializes the DVFS service and switches to the given profile.
+ *
+ * @param[in] profile Initial profile.
+ *
+ * @return sl_status_t Status code indicating the result:
+ *         - SL_STATUS_OK  - Success.
+ *         - SL_STATUS_INVALID_PARAMETER  - Invalid profile.
+ *         - Corresponding error code on failure.
+ *
+ * For more information on status codes, see [SL STATUS DOCUMENTATION](https://docs.silabs.com/gecko-platform/latest/platform-common/status).
+ ******************************************************************************/
+sl_status_t sl_si91x_dvfs_init(sl_si91x_dvfs_profile_t profile)
+{
+  sl_status_t status;
+
+  if (profile >= SL_SI91X_DVFS_PROFILE_COUNT) {
+    return SL_STATUS_INVALID_PARAMETER;
+  }
+
+  // Resolve the divider sets once, profile changes then only program registers
+  for (uint32_t i = 0; i < SL_SI91X_DVFS_PROFILE_COUNT; i++) {
+    profile_dividers[i] = sl_si91x_clock_manager_lookup_pll_divider(profile_configs[i].pll_freq, PLL_REF_CLK_VAL_XTAL);
+  }
+
+  // The first configuration goes through the runtime path, which also turns the PLL on
+  // and selects its reference clock
+  status = apply_profile(profile, profile, true);
+  if (status != SL_STATUS_OK) {
+    return status;
+  }
+
+  current_profile  = profile;
+  dvfs_initialized = true;
+
+  return status;
+}
+
+/***************************************************************************/
+/**
+ * @brief Switches the M4 core to another performance profile.
+ *
+ * @param[in] profile Profile to switch to.
+ *
+ * @return sl_status_t Status code indicating the result:
+ *         - SL_STATUS_OK  - Success.
+ *         - SL_STATUS_INVALID_PARAMETER  - Invalid profile.
+ *         - SL_STATUS_NOT_INITIALIZED  - Service not initialized.
+ *         - Corresponding error code on failure.
+ *
+ * For more information on status codes, see [SL STATUS DOCUMENTATION](https://docs.silabs.com/gecko-platform/latest/platform-common/status).
+ ******************************************************************************/
+sl_status_t sl_si91x_dvfs_set_profile(sl_si91x_dvfs_profile_t profile)
+{
+  sl_status_t status;
+
+  if (profile >= SL_SI91X_DVFS_PROFILE_COUNT) {
+    return SL_STATUS_INVALID_PARAMETER;
+  }
+  if (!dvfs_initialized) {
+    return SL_STATUS_NOT_INITIALIZED;
+  }
+  if ((profile == current_profile) && !dvfs_resync) {
+    return SL_STATUS_OK;
+  }
+
+  status = apply_profile(current_profile, profile, dvfs_resync);
+  if (status == SL_STATUS_OK) {
+    current_profile = profile;
+  }
+  dvfs_resync = (status != SL_STATUS_OK);
+
+  return status;
+}
+
+/***************************************************************************/
+/**
+ * @brief Gets the current performance profile.
+ *
+ * @return sl_si91x_dvfs_profile_t Current profile.
+ ******************************************************************************/
+sl_si91x_dvfs_profile_t sl_si91x_dvfs_get_profile(void)
+{
+  return current_profile;
+}
+
+/***************************************************************************/
+/**
+ * @brief Subscribes to profile changes.
+ *
+ * @param[in] handle Subscription handle, must stay valid until unsubscribed.
+ * @param[in] callback Function notified before and after every profile change.
+ * @param[in] context Context passed to the callback.
+ *
+ * @return sl_status_t Status code indicating the result:
+ *         - SL_STATUS_OK  - Success.
+ *         - SL_STATUS_NULL_POINTER  - handle or callback is NULL.
+ *
+ * For more information on status codes, see [SL STATUS DOCUMENTATION](https://docs.silabs.com/gecko-platform/latest/platform-common/status).
+ ******************************************************************************/
+sl_status_t sl_si91x_dvfs_subscribe(sl_si91x_dvfs_subscriber_t *handle,
+                                    sl_si91x_dvfs_callback_t callback,
+                                    void *context)
+{
+  if ((handle == NULL) || (callback == NULL)) {
+    return SL_STATUS_NULL_POINTER;
+  }
+
+  handle->callback = callback;
+  handle->context  = context;
+  handle->next     = subscribers;
+  subscribers      = handle;
+
+  return SL_STATUS_OK;
+}
+
+/***************************************************************************/
+/**
+ * @brief Unsubscribes from profile changes.
+ *
+ * @param[in] handle Subscription handle given to sl_si91x_dvfs_subscribe().
+ ******************************************************************************/
+void sl_si91x_dvfs_unsubscribe(sl_si91x_dvfs_subscriber_t *handle)
+{
+  sl_si91x_dvfs_subscriber_t **link = &subscribers;
+
+  while (*link != NULL) {
+    if (*link == handle) {
+      *link        = handle->next;
+      handle->next = NULL;
+      return;
+    }
+    link = &(*link)->next;
+  }
+}
+
+/*******************************************************************************
+ * Sequences a profile change. Everything that has to be in place before the core
+ * runs faster (PS4 voltage, prefetch and registering) is applied before the clock
+ * change, everything that can only be relaxed once it runs slower is applied after.
+ * The SoC PLL is only reprogrammed when its frequency changes, with the core running
+ * from the reference clock meanwhile. Subscribers are notified around the change,
+ * including on failure so they can resume with whatever clock is in place.
+ ******************************************************************************/
+static sl_status_t apply_profile(sl_si91x_dvfs_profile_t from, sl_si91x_dvfs_profile_t to, bool full_reconfig)
+{
+  M4CLK_Type *pCLK                      = M4CLK;
+  const dvfs_profile_config_t *config   = &profile_configs[to];
+  const sl_si91x_pll_divider_t *divider = full_reconfig ? NULL : profile_dividers[to];
+  uint32_t core_clock                   = get_core_clock(config);
+  rsi_error_t error_status              = RSI_OK;
+  sl_status_t status                    = SL_STATUS_OK;
+
+  notify_subscribers(SL_SI91X_DVFS_EVENT_PRE_CHANGE, from, to);
+
+  // Raise the voltage before the clocks go up
+  if ((config->pll_freq > PS3_PLL_FREQ_LIMIT) && (!(BATT_FF->MCU_PMU_LDO_CTRL_CLEAR & MCU_SOC_LDO_LVL))) {
+    RSI_PS_SetDcDcToHigerVoltage();
+    RSI_PS_PowerStateChangePs3toPs4();
+  }
+  if (core_clock >= PLL_PREFETCH_LIMIT) {
+    RSI_PS_PS4SetRegisters();
+  }
+
+  if (full_reconfig || (profile_configs[from].pll_freq != config->pll_freq)) {
+    // Run the core from the reference clock while the SoC PLL relocks
+    error_status = RSI_CLK_M4SocClkConfig(pCLK, M4_ULPREFCLK, 0);
+    if (error_status == RSI_OK) {
+      if (divider != NULL) {
+        status = sl_si91x_clock_manager_set_pll_divider(SOC_PLL, divider);
+      } else {
+        status = sl_si91x_clock_manager_set_pll_freq(SOC_PLL, config->pll_freq, PLL_REF_CLK_VAL_XTAL);
+      }
+    }
+  }
+
+  if ((error_status == RSI_OK) && (status == SL_STATUS_OK)) {
+    // Also updates SystemCoreClock, if only the divider changes the PLL keeps running
+    error_status = RSI_CLK_M4SocClkConfig(pCLK, M4_SOCPLLCLK, config->div_factor);
+  }
+
+  if ((error_status == RSI_OK) && (status == SL_STATUS_OK)) {
+    // Relax the registering and the voltage once the clocks went down
+    if (core_clock < PLL_PREFETCH_LIMIT) {
+      RSI_PS_PS4ClearRegisters();
+    }
+    if (config->pll_freq < PS3_PLL_FREQ_LIMIT) {
+      RSI_PS_PowerStateChangePs4toPs3();
+      RSI_PS_SetDcDcToLowerVoltage();
+    }
+  }
+
+  notify_subscribers(SL_SI91X_DVFS_EVENT_POST_CHANGE, from, to);
+
+  if (error_status != RSI_OK) {
+    status = (error_status == INVALID_PARAMETERS) ? SL_STATUS_INVALID_PARAMETER : SL_STATUS_FAIL;
+  }
+  return status;
+}
+
+/*******************************************************************************
+ * Calls every subscriber with the given event.
+ ******************************************************************************/
+static void notify_subscribers(sl_si91x_dvfs_event_t event, sl_si91x_dvfs_profile_t from, sl_si91x_dvfs_profile_t to)
+{
+  sl_si91x_dvfs_subscriber_t *subscriber = subscribers;
+
+  while (subscriber != NULL) {
+    // Read the next one first, a subscriber may unsubscribe from its callback
+    sl_si91x_dvfs_subscriber_t *next = subscriber->next;
+    subscriber->callback(event, from, to, subscriber->context);
+    subscriber = next;
+  }
+}
+
+/*******************************************************************************
+ * Returns the M4 core clock of a profile. Division factors 0 and 1 both mean
+ * no division.
+ ******************************************************************************/
+static uint32_t get_core_clock(const dvfs_profile_config_t *config)
+{
+  return (config->div_factor > 1) ? (config->pll_freq / config->div_factor) : config->pll_freq;
+}
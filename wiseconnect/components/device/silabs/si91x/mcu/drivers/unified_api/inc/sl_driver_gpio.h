@@ -78,6 +78,64 @@ typedef struct {
   sl_si91x_gpio_direction_t direction; ///< The direction of the GPIO pin (input or output)
 } sl_si91x_gpio_pin_config_t;
 
+/// @brief Entry of a bulk pin configuration table, build it with @ref SL_SI91X_GPIO_PIN_TABLE_ENTRY.
+typedef struct {
+  sl_gpio_t port_pin;    ///< HP port A,B,C,D or ULP port, and pin number
+  uint8_t mode;          ///< Pin MUX mode, 0 for normal GPIO
+  uint8_t direction;     ///< Direction of type sl_si91x_gpio_direction_t
+  uint8_t output_value;  ///< Level driven on the pin, 0 or 1
+  uint8_t strength;      ///< Driver strength of type sl_si91x_gpio_driver_strength_select_t
+  uint8_t disable_state; ///< Driver disable state of type sl_si91x_gpio_driver_disable_state_t
+} sl_si91x_gpio_pin_table_entry_t;
+
+/// @brief Register values of one pin, computed from a pin table entry.
+typedef struct {
+  uint8_t gpio_num;    ///< HP GPIO number (port * 16 + pin), or ULP GPIO number
+  uint8_t ulp;         ///< 1 if the pin belongs to the ULP instance
+  uint8_t pad_config;  ///< Strength, receiver and disable state bits of the HP PAD configuration register
+  uint8_t gpio_config; ///< Mode and direction bits of the GPIO configuration register
+} sl_si91x_gpio_pin_snapshot_entry_t;
+
+/// @brief Register values of a whole pin table, recorded by @ref sl_si91x_gpio_driver_apply_pin_table
+///        and written back by @ref sl_si91x_gpio_driver_restore_pin_snapshot.
+typedef struct {
+  sl_si91x_gpio_pin_snapshot_entry_t *entries; ///< Storage for one entry per table entry, provided by the caller
+  uint32_t max_entries;                        ///< Number of entries available in storage
+  uint32_t entry_count;                        ///< Number of recorded entries
+  uint32_t pad_selection;                      ///< PAD selection bits of PADs 0 to 21
+  uint32_t pad_selection_1;                    ///< PAD selection bits of PADs 22 to 33
+  uint32_t host_pad_selection;                 ///< HOST PAD selection bits
+  uint32_t ulp_pad_receiver;                   ///< ULP PAD receiver enable bits
+  uint32_t ulp_pad_config_mask[2];             ///< Bits of the ULP PAD configuration registers 0 and 1 owned by the table
+  uint32_t ulp_pad_config[2];                  ///< Values of the owned bits of the ULP PAD configuration registers
+  uint16_t output_set[2][SL_GPIO_ULP_PORT + 1];   ///< Pins set before ([0]) and after ([1]) the modes are applied
+  uint16_t output_clear[2][SL_GPIO_ULP_PORT + 1]; ///< Pins cleared before ([0]) and after ([1]) the modes are applied
+} sl_si91x_gpio_pin_snapshot_t;
+
+/// @brief Evaluates to value, and fails to compile when condition is false.
+#define SL_SI91X_GPIO_PIN_TABLE_ASSERT(value, condition) ((value) + (0 * sizeof(char[(condition) ? 1 : -1])))
+
+/// @brief Checks a pin number against its HP or ULP port.
+#define SL_SI91X_GPIO_PIN_TABLE_VALID_PIN(port, pin)                       \
+  (((port) == SL_GPIO_PORT_A)                                 ? ((pin) <= PORTA_PIN_MAX_VALUE) \
+   : (((port) == SL_GPIO_PORT_B) || ((port) == SL_GPIO_PORT_C)) ? ((pin) <= PORT_PIN_MAX_VALUE)  \
+   : ((port) == SL_GPIO_PORT_D)                               ? ((pin) <= PORTD_PIN_MAX_VALUE) \
+   : ((port) == SL_GPIO_ULP_PORT)                             ? ((pin) <= ULP_PIN_MAX_VALUE)   \
+                                                              : 0)
+
+/// @brief Pin table entry whose port, pin and values are validated at compile time.
+///        All arguments must be constant expressions.
+#define SL_SI91X_GPIO_PIN_TABLE_ENTRY(port, pin, mode, direction, output_value, strength, disable_state)                \
+  {                                                                                                                      \
+    { (sl_gpio_port_t)SL_SI91X_GPIO_PIN_TABLE_ASSERT(port, (port) <= SL_GPIO_ULP_PORT),                                   \
+      (uint8_t)SL_SI91X_GPIO_PIN_TABLE_ASSERT(pin, SL_SI91X_GPIO_PIN_TABLE_VALID_PIN(port, pin)) },                      \
+      (uint8_t)SL_SI91X_GPIO_PIN_TABLE_ASSERT(mode, (mode) <= (((port) == SL_GPIO_ULP_PORT) ? ULP_MAX_MODE : MAX_MODE)), \
+      (uint8_t)SL_SI91X_GPIO_PIN_TABLE_ASSERT(direction, (direction) <= GPIO_INPUT),                                     \
+      (uint8_t)SL_SI91X_GPIO_PIN_TABLE_ASSERT(output_value, (output_value) <= GPIO_MAX_OUTPUT_VALUE),                    \
+      (uint8_t)SL_SI91X_GPIO_PIN_TABLE_ASSERT(strength, (strength) <= GPIO_TWELVE_MILLI_AMPS),                           \
+      (uint8_t)SL_SI91X_GPIO_PIN_TABLE_ASSERT(disable_state, (disable_state) <= GPIO_REPEATER)                           \
+  }
+
 /*******************************************************************************
  ********************************   Local Variables   ************************* ******************************************************************************/
 /// @brief GPIO interrupt callback function pointer.
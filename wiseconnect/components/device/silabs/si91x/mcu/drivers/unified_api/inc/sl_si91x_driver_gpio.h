@@ -63,6 +63,52 @@ extern "C" {
  *******************************************************************************/
 sl_status_t sl_gpio_set_configuration(sl_si91x_gpio_pin_config_t pin_config);
 
+/***************************************************************************/ /**
+ * @brief  Configure a table of HP and ULP GPIO pins in a single pass.
+ * @details Each entry gets the same settings as @ref sl_gpio_set_configuration followed by
+ *      @ref sl_si91x_gpio_driver_select_pad_driver_strength, @ref sl_si91x_gpio_driver_select_pad_driver_disable_state
+ *      and @ref sl_gpio_driver_set_pin_mode, but:
+ *      - the whole table is validated first, and nothing is written if an entry is invalid,
+ *      - the PAD selection, HOST PAD selection and ULP PAD receiver registers are written once,
+ *      - the output levels are written once per port,
+ *      - the PAD and GPIO configuration registers of a pin are written once each.
+ *      For ULP pins, the driver strength and disable state are shared by groups of 4 pins;
+ *      the last entry of a group wins, as with the per pin APIs called in table order.
+ *      UULP pins are not supported, use @ref sl_gpio_set_configuration for them.
+ * @pre Pre-conditions:
+ * -   \ref sl_gpio_driver_init()
+ * @param[in]  table - Pin table, preferably const and built with @ref SL_SI91X_GPIO_PIN_TABLE_ENTRY.
+ * @param[in]  count - Number of entries in the table.
+ * @param[out] snapshot - Optional, receives the register values for @ref sl_si91x_gpio_driver_restore_pin_snapshot.
+ *      entries and max_entries must be set by the caller. Pass NULL if not needed.
+ *
+ * @return Status code indicating the result:
+ *         - SL_STATUS_OK   - Success.
+ *         - SL_STATUS_NULL_POINTER  - The table is a null pointer.
+ *         - SL_STATUS_INVALID_PARAMETER  - An entry is invalid or the snapshot storage is too small.
+ *
+ * For more information on status codes, refer to [SL STATUS DOCUMENTATION](https://docs.silabs.com/gecko-platform/latest/platform-common/status).
+ *******************************************************************************/
+sl_status_t sl_si91x_gpio_driver_apply_pin_table(const sl_si91x_gpio_pin_table_entry_t *table,
+                                                 uint32_t count,
+                                                 sl_si91x_gpio_pin_snapshot_t *snapshot);
+
+/***************************************************************************/ /**
+ * @brief  Write back the pin configuration recorded by @ref sl_si91x_gpio_driver_apply_pin_table.
+ * @details No validation or table lookup is done, so this is the fast path to restore the
+ *      pads after a wakeup from a sleep state that does not retain them.
+ * @pre Pre-conditions:
+ * -   \ref sl_si91x_gpio_driver_enable_clock(), for every GPIO instance used by the snapshot
+ * @param[in]  snapshot - Snapshot filled by @ref sl_si91x_gpio_driver_apply_pin_table.
+ *
+ * @return Status code indicating the result:
+ *         - SL_STATUS_OK   - Success.
+ *         - SL_STATUS_NULL_POINTER  - The snapshot is a null pointer.
+ *
+ * For more information on status codes, refer to [SL STATUS DOCUMENTATION](https://docs.silabs.com/gecko-platform/latest/platform-common/status).
+ *******************************************************************************/
+sl_status_t sl_si91x_gpio_driver_restore_pin_snapshot(const sl_si91x_gpio_pin_snapshot_t *snapshot);
+
 /***************************************************************************/ /**
  * @brief   Set the direction for a GPIO pin.
  * @pre Pre-conditions:
@@ -28,6 +28,7 @@
 ******************************************************************************/
 #include "sl_si91x_driver_gpio.h"
 #include <stdio.h>
+#include <string.h>
 #include "sl_status.h"
 /*******************************************************************************
  ***************************  DEFINES / MACROS ********************************
@@ -102,6 +103,17 @@
 #define GPIO_PAD_SELECT_32     32 // GPIO PAD selection number 32
 #define GPIO_PAD_SELECT_33     33 // GPIO PAD selection number 33
 #define OUTPUT_VALUE           0  // GPIO output value
+
+#define GPIO_PAD_CONFIG_TABLE_MASK 0xD3 // PAD configuration bits owned by a pin table: E1_E2[1..0], REN[4], P1_P2[7..6]
+#define GPIO_PAD_CONFIG_REN        0x10 // PAD configuration receiver enable bit
+#define GPIO_PAD_CONFIG_P1_P2_POS  6    // PAD configuration driver disable state position
+#define GPIO_CONFIG_TABLE_MASK     0x3D // GPIO configuration bits owned by a pin table: DIRECTION[0], MODE[5..2]
+#define GPIO_CONFIG_MODE_POS       2    // GPIO configuration mode position
+#define ULP_PAD_GROUP_SIZE         4    // ULP pins sharing a driver strength and disable state
+#define ULP_PAD_GROUP_SHIFT        8    // Offset of the second ULP PAD group in ULP PAD configuration register 0
+#define ULP_PAD_GROUP_MASK         0xC3 // E1_E2[1..0], P1_P2[7..6] of a ULP PAD group
+#define GPIO_OUTPUT_BEFORE_MODE    0    // Output levels written before the pin modes
+#define GPIO_OUTPUT_AFTER_MODE     1    // Output levels written after the pin modes
 /*******************************************************************************
  ********************************   ENUMS   ************************************
  ******************************************************************************/
@@ -176,6 +188,18 @@ void UULP_PIN_IRQ_Handler(void);
 void ULP_PIN_IRQ_Handler(void);
 void ULP_GROUP_IRQ_Handler(void);
 
+/*******************************************************************************
+ ***********************  Local function Prototypes ****************************
+ ******************************************************************************/
+static sl_status_t gpio_pin_table_validate(const sl_si91x_gpio_pin_table_entry_t *entry);
+static void gpio_pin_table_merge_shared(const sl_si91x_gpio_pin_table_entry_t *entry,
+                                        sl_si91x_gpio_pin_snapshot_t *snapshot);
+static void gpio_pin_table_get_pin(const sl_si91x_gpio_pin_table_entry_t *entry,
+                                   sl_si91x_gpio_pin_snapshot_entry_t *pin);
+static void gpio_pin_snapshot_write_shared(const sl_si91x_gpio_pin_snapshot_t *snapshot);
+static void gpio_pin_snapshot_write_pin(const sl_si91x_gpio_pin_snapshot_entry_t *pin);
+static void gpio_pin_snapshot_write_outputs(const sl_si91x_gpio_pin_snapshot_t *snapshot, uint8_t stage);
+
 /*******************************************************************************
  ************************       GLOBAL FUNCTIONS      **************************
  ******************************************************************************/
@@ -285,6 +309,84 @@ sl_status_t sl_gpio_set_configuration(sl_si91x_gpio_pin_config_t pin_config)
   return SL_STATUS_OK;
 }
 
+/*******************************************************************************
+ * This API is used to configure a table of HP and ULP GPIO pins.
+ * The table is validated first. The registers shared by several pins are then
+ * merged and written once, and each pin register is written once.
+ ******************************************************************************/
+sl_status_t sl_si91x_gpio_driver_apply_pin_table(const sl_si91x_gpio_pin_table_entry_t *table,
+                                                 uint32_t count,
+                                                 sl_si91x_gpio_pin_snapshot_t *snapshot)
+{
+  sl_si91x_gpio_pin_snapshot_t local_snapshot;
+  sl_si91x_gpio_pin_snapshot_entry_t pin;
+  sl_status_t status;
+  uint32_t index;
+  // Check if the table pointer is NULL.
+  if (table == NULL) {
+    return SL_STATUS_NULL_POINTER;
+  }
+  // Check if the snapshot storage can hold the whole table.
+  if ((snapshot != NULL) && ((snapshot->entries == NULL) || (snapshot->max_entries < count))) {
+    return SL_STATUS_INVALID_PARAMETER;
+  }
+  // Validate the whole table before writing any register.
+  for (index = 0; index < count; index++) {
+    status = gpio_pin_table_validate(&table[index]);
+    if (status != SL_STATUS_OK) {
+      return status;
+    }
+  }
+  if (snapshot == NULL) {
+    local_snapshot.entries     = NULL;
+    local_snapshot.max_entries = 0;
+    snapshot                   = &local_snapshot;
+  }
+  snapshot->entry_count        = 0;
+  snapshot->pad_selection      = 0;
+  snapshot->pad_selection_1    = 0;
+  snapshot->host_pad_selection = 0;
+  snapshot->ulp_pad_receiver   = 0;
+  memset(snapshot->ulp_pad_config_mask, 0, sizeof(snapshot->ulp_pad_config_mask));
+  memset(snapshot->ulp_pad_config, 0, sizeof(snapshot->ulp_pad_config));
+  memset(snapshot->output_set, 0, sizeof(snapshot->output_set));
+  memset(snapshot->output_clear, 0, sizeof(snapshot->output_clear));
+  // Merge the PAD selection, receiver, ULP PAD group and output registers of all pins.
+  for (index = 0; index < count; index++) {
+    gpio_pin_table_merge_shared(&table[index], snapshot);
+  }
+  gpio_pin_snapshot_write_shared(snapshot);
+  // Write the PAD and GPIO configuration registers of each pin once.
+  for (index = 0; index < count; index++) {
+    gpio_pin_table_get_pin(&table[index], &pin);
+    gpio_pin_snapshot_write_pin(&pin);
+    if (snapshot->entries != NULL) {
+      snapshot->entries[snapshot->entry_count++] = pin;
+    }
+  }
+  gpio_pin_snapshot_write_outputs(snapshot, GPIO_OUTPUT_AFTER_MODE);
+  return SL_STATUS_OK;
+}
+
+/*******************************************************************************
+ * This API is used to write back the pin configuration recorded by
+ * sl_si91x_gpio_driver_apply_pin_table(), e.g. on wakeup.
+ ******************************************************************************/
+sl_status_t sl_si91x_gpio_driver_restore_pin_snapshot(const sl_si91x_gpio_pin_snapshot_t *snapshot)
+{
+  uint32_t index;
+  // Check if the snapshot pointer is NULL.
+  if ((snapshot == NULL) || ((snapshot->entries == NULL) && (snapshot->entry_count != 0))) {
+    return SL_STATUS_NULL_POINTER;
+  }
+  gpio_pin_snapshot_write_shared(snapshot);
+  for (index = 0; index < snapshot->entry_count; index++) {
+    gpio_pin_snapshot_write_pin(&snapshot->entries[index]);
+  }
+  gpio_pin_snapshot_write_outputs(snapshot, GPIO_OUTPUT_AFTER_MODE);
+  return SL_STATUS_OK;
+}
+
 /*******************************************************************************
  * @brief This API is used to configure the pin interrupt in 3 instance.
  * To configure the interrupt, first GPIO initialization must be done.
@@ -2065,3 +2167,154 @@ sl_status_t sl_gpio_driver_unregister(sl_si91x_gpio_instances_t gpio_instance,
   }
   return SL_STATUS_OK;
 }
+
+/*******************************************************************************
+ * Validate a pin table entry, with the same checks as the per pin APIs.
+ ******************************************************************************/
+static sl_status_t gpio_pin_table_validate(const sl_si91x_gpio_pin_table_entry_t *entry)
+{
+  sl_gpio_t port_pin = entry->port_pin;
+  sl_status_t status;
+  // UULP pins are configured through the NPSS registers, they are not supported in a pin table.
+  if (port_pin.port > SL_GPIO_ULP_PORT) {
+    return SL_STATUS_INVALID_PARAMETER;
+  }
+  status = sl_gpio_validation(&port_pin);
+  if (status != SL_STATUS_OK) {
+    return status;
+  }
+  if ((entry->mode > ((port_pin.port == SL_GPIO_ULP_PORT) ? ULP_MAX_MODE : MAX_MODE))
+      || (entry->direction > GPIO_DIRECTION_MAX_VALUE) || (entry->output_value > GPIO_MAX_OUTPUT_VALUE)
+      || (entry->strength > GPIO_STRENGTH_MAX_VAL) || (entry->disable_state > GPIO_DISABLE_STATE_MAX_VAL)) {
+    return SL_STATUS_INVALID_PARAMETER;
+  }
+  return SL_STATUS_OK;
+}
+
+/*******************************************************************************
+ * Merge the registers a pin shares with other pins into the snapshot.
+ ******************************************************************************/
+static void gpio_pin_table_merge_shared(const sl_si91x_gpio_pin_table_entry_t *entry,
+                                        sl_si91x_gpio_pin_snapshot_t *snapshot)
+{
+  uint8_t port = entry->port_pin.port;
+  uint8_t pin  = entry->port_pin.pin;
+  // Output levels are set before the mode, except for mode 0, as in sl_gpio_set_pin_mode().
+  uint8_t stage = (entry->mode != SL_GPIO_MODE_DISABLED) ? GPIO_OUTPUT_BEFORE_MODE : GPIO_OUTPUT_AFTER_MODE;
+  uint8_t output_port;
+  if (port == SL_GPIO_ULP_PORT) {
+    uint8_t group = pin / ULP_PAD_GROUP_SIZE;
+    uint8_t reg   = (group == 2) ? 1 : 0;
+    uint8_t shift = (group == 1) ? ULP_PAD_GROUP_SHIFT : 0;
+    snapshot->pad_selection_1 |= BIT(ulp_gpio_pad[pin] - PAD_SELECT);
+    snapshot->ulp_pad_receiver |= BIT(pin);
+    // The last entry of a ULP PAD group wins, as with the per pin APIs.
+    snapshot->ulp_pad_config_mask[reg] |= (uint32_t)ULP_PAD_GROUP_MASK << shift;
+    snapshot->ulp_pad_config[reg] = (snapshot->ulp_pad_config[reg] & ~((uint32_t)ULP_PAD_GROUP_MASK << shift))
+                                    | ((uint32_t)(entry->strength | (entry->disable_state << GPIO_PAD_CONFIG_P1_P2_POS))
+                                       << shift);
+    output_port = SL_GPIO_ULP_PORT;
+  } else {
+    uint8_t gpio_num = (uint8_t)((port * MAX_GPIO_PORT_PIN) + pin);
+    uint8_t pad      = m4_gpio_pad[gpio_num];
+    // Same PAD selection as sl_gpio_set_configuration().
+    if ((pad != GPIO_PAD_SELECT_NO_PAD) && (pad != PAD_SELECT_9)) {
+      if (SL_GPIO_VALIDATE_HOST_PIN(port, pin)) {
+        snapshot->host_pad_selection |= BIT(pad - HOST_PAD_SELECT);
+      } else if (pad < PAD_SELECT) {
+        snapshot->pad_selection |= BIT(pad);
+      } else {
+        snapshot->pad_selection_1 |= BIT(pad - PAD_SELECT);
+      }
+    }
+    // Port A pin numbers cover the whole HP instance, so the output port is taken from the GPIO number.
+    output_port = gpio_num / MAX_GPIO_PORT_PIN;
+    pin         = gpio_num % MAX_GPIO_PORT_PIN;
+  }
+  if (entry->output_value) {
+    snapshot->output_set[stage][output_port] |= (uint16_t)BIT(pin);
+  } else {
+    snapshot->output_clear[stage][output_port] |= (uint16_t)BIT(pin);
+  }
+}
+
+/*******************************************************************************
+ * Compute the register values owned by a pin table entry.
+ ******************************************************************************/
+static void gpio_pin_table_get_pin(const sl_si91x_gpio_pin_table_entry_t *entry,
+                                   sl_si91x_gpio_pin_snapshot_entry_t *pin)
+{
+  if (entry->port_pin.port == SL_GPIO_ULP_PORT) {
+    pin->gpio_num   = entry->port_pin.pin;
+    pin->ulp        = 1;
+    pin->pad_config = 0;
+  } else {
+    pin->gpio_num   = (uint8_t)((entry->port_pin.port * MAX_GPIO_PORT_PIN) + entry->port_pin.pin);
+    pin->ulp        = 0;
+    pin->pad_config = (uint8_t)(entry->strength | GPIO_PAD_CONFIG_REN
+                                | (entry->disable_state << GPIO_PAD_CONFIG_P1_P2_POS));
+  }
+  pin->gpio_config = (uint8_t)(entry->direction | (entry->mode << GPIO_CONFIG_MODE_POS));
+}
+
+/*******************************************************************************
+ * Write the registers shared by the pins of a snapshot, and the output levels
+ * to apply before the pin modes.
+ ******************************************************************************/
+static void gpio_pin_snapshot_write_shared(const sl_si91x_gpio_pin_snapshot_t *snapshot)
+{
+  if (snapshot->pad_selection != 0) {
+    PADSELECTION |= snapshot->pad_selection;
+  }
+  if (snapshot->pad_selection_1 != 0) {
+    PADSELECTION_1 |= snapshot->pad_selection_1;
+  }
+  if (snapshot->host_pad_selection != 0) {
+    HOST_PADS_GPIO_MODE |= snapshot->host_pad_selection;
+  }
+  if (snapshot->ulp_pad_receiver != 0) {
+    ULP_PAD_CONFIG_REG |= snapshot->ulp_pad_receiver;
+  }
+  if (snapshot->ulp_pad_config_mask[0] != 0) {
+    ULP_PAD_CONFIG0_REG->ULP_PAD_CONFIG_REG0 =
+      (ULP_PAD_CONFIG0_REG->ULP_PAD_CONFIG_REG0 & ~snapshot->ulp_pad_config_mask[0]) | snapshot->ulp_pad_config[0];
+  }
+  if (snapshot->ulp_pad_config_mask[1] != 0) {
+    ULP_PAD_CONFIG1_REG->ULP_PAD_CONFIG_REG1 =
+      (ULP_PAD_CONFIG1_REG->ULP_PAD_CONFIG_REG1 & ~snapshot->ulp_pad_config_mask[1]) | snapshot->ulp_pad_config[1];
+  }
+  gpio_pin_snapshot_write_outputs(snapshot, GPIO_OUTPUT_BEFORE_MODE);
+}
+
+/*******************************************************************************
+ * Write the PAD and GPIO configuration registers of a pin, keeping the bits
+ * the pin table does not own (slew rate, Schmitt trigger, group interrupts).
+ ******************************************************************************/
+static void gpio_pin_snapshot_write_pin(const sl_si91x_gpio_pin_snapshot_entry_t *pin)
+{
+  if (pin->ulp) {
+    ULP_GPIO->PIN_CONFIG[pin->gpio_num].GPIO_CONFIG_REG =
+      (ULP_GPIO->PIN_CONFIG[pin->gpio_num].GPIO_CONFIG_REG & ~GPIO_CONFIG_TABLE_MASK) | pin->gpio_config;
+  } else {
+    PAD_REG(pin->gpio_num)->PAD_CONFIG_REG =
+      (PAD_REG(pin->gpio_num)->PAD_CONFIG_REG & ~GPIO_PAD_CONFIG_TABLE_MASK) | pin->pad_config;
+    GPIO->PIN_CONFIG[pin->gpio_num].GPIO_CONFIG_REG =
+      (GPIO->PIN_CONFIG[pin->gpio_num].GPIO_CONFIG_REG & ~GPIO_CONFIG_TABLE_MASK) | pin->gpio_config;
+  }
+}
+
+/*******************************************************************************
+ * Write the output levels of a snapshot with one set and one clear write per port.
+ ******************************************************************************/
+static void gpio_pin_snapshot_write_outputs(const sl_si91x_gpio_pin_snapshot_t *snapshot, uint8_t stage)
+{
+  uint8_t port;
+  for (port = 0; port <= SL_GPIO_ULP_PORT; port++) {
+    if (snapshot->output_set[stage][port] != 0) {
+      sl_gpio_set_port_output((sl_gpio_port_t)port, snapshot->output_set[stage][port]);
+    }
+    if (snapshot->output_clear[stage][port] != 0) {
+      sl_gpio_clear_port_output((sl_gpio_port_t)port, snapshot->output_clear[stage][port]);
+    }
+  }
+}
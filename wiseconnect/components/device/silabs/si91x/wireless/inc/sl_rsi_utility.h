@@ -520,4 +520,19 @@ sl_status_t sli_si91x_flush_socket_data_queues_based_on_queue_type(uint8_t index
  */
 sl_status_t sli_si91x_flush_generic_data_queues(sl_si91x_buffer_queue_t *tx_data_queue);
 
+/**
+ * @brief Notifies the transceiver burst tracking that a data buffer has been written to the bus.
+ * @details Buffers that do not belong to a transceiver burst are ignored. Must be called before the buffer is freed.
+ *
+ * @param[in] buffer Buffer that was popped from the TX data queue.
+ * @param[in] status Result of the bus write.
+ */
+void sli_si91x_transceiver_burst_frame_sent(const sl_wifi_buffer_t *buffer, sl_status_t status);
+
+/**
+ * @brief Reports all unsent transceiver burst frames with `SL_STATUS_ABORT` and releases the bursts.
+ * @note Must be called after the TX data queue has been flushed.
+ */
+void sli_si91x_transceiver_burst_abort_all(void);
+
 #endif // _SL_RSI_UTILITY_H_
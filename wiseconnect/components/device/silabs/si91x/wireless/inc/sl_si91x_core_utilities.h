@@ -116,6 +116,20 @@ static inline sl_status_t convert_si91x_status_to_sl_status(si91x_status_t si91x
  */
 void sli_si91x_append_to_buffer_queue(sl_si91x_buffer_queue_t *queue, sl_wifi_buffer_t *buffer);
 
+/**
+ * @brief Atomically append a chain of buffers to the end of a buffer queue.
+ * 
+ * The buffers must already be linked to each other through their node, with the last one
+ * terminating the chain. The whole chain becomes visible to the consumer at once.
+ *
+ * @param[in] queue Pointer to the destination buffer queue where the chain will be appended.
+ * @param[in] head Pointer to the first buffer of the chain.
+ * @param[in] tail Pointer to the last buffer of the chain.
+ */
+void sli_si91x_append_chain_to_buffer_queue(sl_si91x_buffer_queue_t *queue,
+                                            sl_wifi_buffer_t *head,
+                                            sl_wifi_buffer_t *tail);
+
 /**
  * @brief Atomically remove the head buffer from a buffer queue.
  * 
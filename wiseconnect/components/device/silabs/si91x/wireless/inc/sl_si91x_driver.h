@@ -1227,6 +1227,30 @@ sl_status_t sl_si91x_driver_send_transceiver_data(sl_wifi_transceiver_tx_data_co
                                                   uint16_t payload_len,
                                                   uint32_t wait_time);
 
+/***************************************************************************/ /**
+ * @brief     Si91X specific Wi-Fi transceiver mode driver function to prepare a Tx header template
+ * @param[in] control      - Meta data shared by the frames to be sent with the template.
+ * @param[out] tx_template - Template receiving the host descriptor and MAC header.
+ * @return    sl_status_t. See https://docs.silabs.com/gecko-platform/latest/platform-common/status for details.
+ *******************************************************************************/
+sl_status_t sl_si91x_driver_prepare_transceiver_tx_template(sl_wifi_transceiver_tx_data_control_t *control,
+                                                            sl_wifi_transceiver_tx_template_t *tx_template);
+
+/***************************************************************************/ /**
+ * @brief     Si91X specific Wi-Fi transceiver mode driver function to queue a burst of Tx data frames
+ * @param[in] tx_template  - Template prepared by @ref sl_si91x_driver_prepare_transceiver_tx_template.
+ * @param[in] frames       - Frames to be sent to LMAC.
+ * @param[in] frame_count  - Number of frames.
+ * @param[in] callback     - Per-frame completion callback, may be NULL.
+ * @param[in] arg          - Argument passed to the callback.
+ * @return    sl_status_t. See https://docs.silabs.com/gecko-platform/latest/platform-common/status for details.
+ *******************************************************************************/
+sl_status_t sl_si91x_driver_send_transceiver_data_burst(const sl_wifi_transceiver_tx_template_t *tx_template,
+                                                        const sl_wifi_transceiver_burst_frame_t *frames,
+                                                        uint16_t frame_count,
+                                                        sl_wifi_transceiver_burst_callback_t callback,
+                                                        void *arg);
+
 //! @cond Doxygen_Suppress
 /***************************************************************************/ /**
  * @brief
@@ -172,6 +172,20 @@ static uint16_t initialized_opermode = SL_SI91X_INVALID_MODE;
 extern sli_si91x_command_queue_t cmd_queues[SI91X_CMD_MAX];
 extern sl_si91x_buffer_queue_t sli_tx_data_queue;
 
+//! Transceiver TX burst in flight, its frames are queued back to back in sli_tx_data_queue
+typedef struct sli_si91x_transceiver_burst_s {
+  struct sli_si91x_transceiver_burst_s *next;    ///< Next burst in queuing order
+  sl_wifi_buffer_t *context_buffer;              ///< Buffer holding this structure
+  const sl_wifi_buffer_t *next_buffer;           ///< Next frame expected to be written to the bus
+  sl_wifi_transceiver_burst_callback_t callback; ///< Per-frame completion callback
+  void *arg;                                     ///< Callback argument
+  uint16_t frame_count;                          ///< Number of frames in the burst
+  uint16_t sent_count;                           ///< Number of frames written to the bus
+} sli_si91x_transceiver_burst_t;
+
+static sli_si91x_transceiver_burst_t *transceiver_burst_head = NULL;
+static sli_si91x_transceiver_burst_t *transceiver_burst_tail = NULL;
+
 sli_si91x_performance_profile_t performance_profile;
 extern osEventFlagsId_t si91x_events;
 extern volatile uint32_t tx_command_queues_status;
@@ -632,6 +646,9 @@ sl_status_t sl_si91x_driver_deinit(void)
   // Flush the generic TX data queue
   sli_si91x_flush_generic_data_queues(&sli_tx_data_queue);
 
+  // Report the frames of the transceiver bursts that were flushed
+  sli_si91x_transceiver_burst_abort_all();
+
 #if defined(SLI_SI91X_OFFLOAD_NETWORK_STACK) && defined(SLI_SI91X_SOCKETS)
 
   // Flush all pending socket commands in the client VAP queue due to Wi-Fi connection loss
@@ -2295,7 +2312,6 @@ int32_t encapsulate_tx_data_packet(sl_wifi_transceiver_tx_data_control_t *contro
                                    uint8_t *pkt_data,
                                    uint32_t mac_hdr_len)
 {
-  uint16_t seq_ctrl = 0;
   uint16_t *frame_ctrl;
   uint32_t qos_ctrl_off = MAC80211_HDR_MIN_LEN;
 
@@ -2341,11 +2357,6 @@ int32_t encapsulate_tx_data_packet(sl_wifi_transceiver_tx_data_control_t *contro
   memcpy(&pkt_data[10], control->addr2, 6);
   memcpy(&pkt_data[16], control->addr3, 6);
 
-  if (!IS_PEER_DS_SUPPORT_ENABLED(feature_bit_map)) {
-    seq_ctrl = (uint16_t)(get_seq_ctrl(IS_QOS_PKT(control->ctrl_flags)) << 4);
-    memcpy(&pkt_data[22], &seq_ctrl, 2);
-  }
-
   /* Add Addr4 optionally based on ctrl_flag (6 bytes) */
   if (IS_4ADDR(control->ctrl_flags)) {
     memcpy(&pkt_data[24], control->addr4, 6); /* sa */
@@ -2359,19 +2370,16 @@ int32_t encapsulate_tx_data_packet(sl_wifi_transceiver_tx_data_control_t *contro
   return SL_STATUS_OK;
 }
 
-sl_status_t sl_si91x_driver_send_transceiver_data(sl_wifi_transceiver_tx_data_control_t *control,
-                                                  const uint8_t *payload,
-                                                  uint16_t payload_len,
-                                                  uint32_t wait_time)
+sl_status_t sl_si91x_driver_prepare_transceiver_tx_template(sl_wifi_transceiver_tx_data_control_t *control,
+                                                            sl_wifi_transceiver_tx_template_t *tx_template)
 {
-  sl_wifi_buffer_t *buffer;
-  sl_si91x_packet_t *packet;
-  sl_status_t status = SL_STATUS_OK;
-  uint8_t *pkt_offset;
-  uint8_t ext_desc_size;
+  sl_status_t status;
   uint8_t *host_desc;
   uint32_t mac_hdr_len = MAC80211_HDR_MIN_LEN;
 
+  SL_VERIFY_POINTER_OR_RETURN(control, SL_STATUS_NULL_POINTER);
+  SL_VERIFY_POINTER_OR_RETURN(tx_template, SL_STATUS_NULL_POINTER);
+
   if (IS_QOS_PKT(control->ctrl_flags) && !IS_BCAST_MCAST_MAC(control->addr1[0])) {
     mac_hdr_len += MAC80211_HDR_QOS_CTRL_LEN;
   }
@@ -2380,10 +2388,62 @@ sl_status_t sl_si91x_driver_send_transceiver_data(sl_wifi_transceiver_tx_data_co
     mac_hdr_len += MAC80211_HDR_ADDR4_LEN;
   }
 
-  ext_desc_size = TRANSCEIVER_TX_DATA_EXT_DESC_SIZE;
+  memset(tx_template->mac_header, 0, sizeof(tx_template->mac_header));
+  status = encapsulate_tx_data_packet(control, tx_template->mac_header, mac_hdr_len);
+  VERIFY_STATUS_AND_RETURN(status);
+
+  tx_template->mac_header_length = (uint8_t)mac_hdr_len;
+  tx_template->ctrl_flags        = control->ctrl_flags;
+
+  // Prepare the host descriptor, except for the length which depends on the payload
+  memset(tx_template->host_desc, 0, sizeof(tx_template->host_desc));
+  host_desc = tx_template->host_desc;
+
+  host_desc[2] = 0x01; //! Frame Type
+  if (IS_CFM_TO_HOST_SET(control->ctrl_flags)) {
+    host_desc[3] |= CONFIRM_REQUIRED_TO_HOST; //! This bit is used to set CONFIRM_REQUIRED_TO_HOST in firmware.
+  }
+  host_desc[4] = TRANSCEIVER_TX_DATA_EXT_DESC_SIZE; //! xtend_desc size
+  host_desc[5] = (uint8_t)((mac_hdr_len + 3) & ~3); //! Mac_header length
+
+  if (IS_BCAST_MCAST_MAC(control->addr1[0])) {
+    host_desc[7] |= BCAST_INDICATION; //! Bcast_indication
+    //! If auto-rate is enabled for bcast/mcast pkts, use 1 Mbps
+    if (!IS_FIXED_DATA_RATE(control->ctrl_flags)) {
+      host_desc[6] |= MAC_INFO_ENABLE; //! Fixed Rate
+      host_desc[8] = SL_WIFI_DATA_RATE_1;
+    }
+  }
+
+  if (IS_FIXED_DATA_RATE(control->ctrl_flags)) {
+    host_desc[6] |= MAC_INFO_ENABLE; //! Fixed Rate
+    host_desc[8] = (uint8_t)control->rate;
+  }
+
+  if (IS_QOS_PKT(control->ctrl_flags) && !IS_BCAST_MCAST_MAC(control->addr1[0])) {
+    host_desc[13] |= QOS_ENABLE; // QOS ENABLE
+  }
+
+  host_desc[14] =
+    (uint8_t)(((WME_AC_TO_TID(control->priority) & 0xf) << 4) | (WME_AC_TO_QNUM(control->priority) & 0xf));
+
+  return SL_STATUS_OK;
+}
+
+static sl_status_t sli_si91x_build_transceiver_frame(const sl_wifi_transceiver_tx_template_t *tx_template,
+                                                     const uint8_t *payload,
+                                                     uint16_t payload_len,
+                                                     uint32_t token,
+                                                     sl_wifi_buffer_t **buffer)
+{
+  sl_si91x_packet_t *packet;
+  sl_status_t status;
+  uint8_t *pkt_offset;
+  uint8_t ext_desc_size = TRANSCEIVER_TX_DATA_EXT_DESC_SIZE;
+  uint32_t mac_hdr_len  = tx_template->mac_header_length;
 
   // Allocate a data buffer with space for the data and metadata
-  status = sl_si91x_allocate_data_buffer(&buffer,
+  status = sl_si91x_allocate_data_buffer(buffer,
                                          (void **)&packet,
                                          sizeof(sl_si91x_packet_t) + ext_desc_size + mac_hdr_len + payload_len,
                                          SL_WIFI_ALLOCATE_COMMAND_BUFFER_WAIT_TIME);
@@ -2395,10 +2455,11 @@ sl_status_t sl_si91x_driver_send_transceiver_data(sl_wifi_transceiver_tx_data_co
   }
 
   pkt_offset = packet->data + ext_desc_size;
-  status     = encapsulate_tx_data_packet(control, pkt_offset, mac_hdr_len);
-  if (status != SL_STATUS_OK) {
-    sl_si91x_host_free_buffer(buffer);
-    return status;
+  memcpy(pkt_offset, tx_template->mac_header, mac_hdr_len);
+
+  if (!IS_PEER_DS_SUPPORT_ENABLED(feature_bit_map)) {
+    uint16_t seq_ctrl = (uint16_t)(get_seq_ctrl(IS_QOS_PKT(tx_template->ctrl_flags)) << 4);
+    memcpy(&pkt_offset[22], &seq_ctrl, 2);
   }
 
   memcpy(pkt_offset + mac_hdr_len, payload, payload_len);
@@ -2407,48 +2468,168 @@ sl_status_t sl_si91x_driver_send_transceiver_data(sl_wifi_transceiver_tx_data_co
   print_80211_packet(pkt_offset, mac_hdr_len + payload_len, TX_RX_FRAME_DUMP_BYTE_COUNT);
 #endif
 
-  // Clear the packet descriptor and copy the command data if available
-  memset(packet->desc, 0, sizeof(packet->desc));
+  memcpy(packet->desc, tx_template->host_desc, sizeof(packet->desc));
 
   // Fill length in first 2 host_desc bytes
   packet->length = (ext_desc_size + mac_hdr_len + payload_len) & 0xFFF;
 
-  // Fill packet type
-  host_desc = packet->desc;
+  //! Initialize extended desc
+  memcpy(packet->data, &token, TRANSCEIVER_TX_DATA_EXT_DESC_SIZE);
 
-  host_desc[2] = 0x01; //! Frame Type
-  if (IS_CFM_TO_HOST_SET(control->ctrl_flags)) {
-    host_desc[3] |= CONFIRM_REQUIRED_TO_HOST; //! This bit is used to set CONFIRM_REQUIRED_TO_HOST in firmware.
+  return SL_STATUS_OK;
+}
+
+sl_status_t sl_si91x_driver_send_transceiver_data(sl_wifi_transceiver_tx_data_control_t *control,
+                                                  const uint8_t *payload,
+                                                  uint16_t payload_len,
+                                                  uint32_t wait_time)
+{
+  sl_wifi_transceiver_tx_template_t tx_template;
+  sl_wifi_buffer_t *buffer;
+  sl_status_t status;
+
+  status = sl_si91x_driver_prepare_transceiver_tx_template(control, &tx_template);
+  VERIFY_STATUS_AND_RETURN(status);
+
+  status = sli_si91x_build_transceiver_frame(&tx_template, payload, payload_len, control->token, &buffer);
+  VERIFY_STATUS_AND_RETURN(status);
+
+  // Send command packet to the SI91x socket data queue and await a response
+  return sl_si91x_driver_send_data_packet(buffer, wait_time);
+}
+
+sl_status_t sl_si91x_driver_send_transceiver_data_burst(const sl_wifi_transceiver_tx_template_t *tx_template,
+                                                        const sl_wifi_transceiver_burst_frame_t *frames,
+                                                        uint16_t frame_count,
+                                                        sl_wifi_transceiver_burst_callback_t callback,
+                                                        void *arg)
+{
+  sli_si91x_transceiver_burst_t *burst;
+  sl_wifi_buffer_t *context_buffer;
+  sl_wifi_buffer_t *head = NULL;
+  sl_wifi_buffer_t *tail = NULL;
+  sl_wifi_buffer_t *buffer;
+  sl_status_t status;
+
+  SL_VERIFY_POINTER_OR_RETURN(tx_template, SL_STATUS_NULL_POINTER);
+  SL_VERIFY_POINTER_OR_RETURN(frames, SL_STATUS_NULL_POINTER);
+
+  if (frame_count == 0) {
+    return SL_STATUS_INVALID_PARAMETER;
   }
-  host_desc[4] = ext_desc_size;                     //! xtend_desc size
-  host_desc[5] = (uint8_t)((mac_hdr_len + 3) & ~3); //! Mac_header length
 
-  if (IS_BCAST_MCAST_MAC(control->addr1[0])) {
-    host_desc[7] |= BCAST_INDICATION; //! Bcast_indication
-    //! If auto-rate is enabled for bcast/mcast pkts, use 1 Mbps
-    if (!IS_FIXED_DATA_RATE(control->ctrl_flags)) {
-      host_desc[6] |= MAC_INFO_ENABLE; //! Fixed Rate
-      host_desc[8] = SL_WIFI_DATA_RATE_1;
+  status = sli_si91x_allocate_command_buffer(&context_buffer,
+                                             (void **)&burst,
+                                             sizeof(sli_si91x_transceiver_burst_t),
+                                             SL_WIFI_ALLOCATE_COMMAND_BUFFER_WAIT_TIME);
+  VERIFY_STATUS_AND_RETURN(status);
+
+  // Build all frames before queuing any, so that a burst is either queued as a whole or not at all
+  for (uint16_t i = 0; i < frame_count; i++) {
+    status = sli_si91x_build_transceiver_frame(tx_template,
+                                               frames[i].payload,
+                                               frames[i].payload_len,
+                                               frames[i].token,
+                                               &buffer);
+    if (status != SL_STATUS_OK) {
+      while (head != NULL) {
+        buffer = (sl_wifi_buffer_t *)head->node.node;
+        sl_si91x_host_free_buffer(head);
+        head = buffer;
+      }
+      sl_si91x_host_free_buffer(context_buffer);
+      return status;
     }
+
+    buffer->node.node = NULL;
+    if (tail == NULL) {
+      head = buffer;
+    } else {
+      tail->node.node = &buffer->node;
+    }
+    tail = buffer;
   }
 
-  if (IS_FIXED_DATA_RATE(control->ctrl_flags)) {
-    host_desc[6] |= MAC_INFO_ENABLE; //! Fixed Rate
-    host_desc[8] = (uint8_t)control->rate;
+  burst->next           = NULL;
+  burst->context_buffer = context_buffer;
+  burst->next_buffer    = head;
+  burst->callback       = callback;
+  burst->arg            = arg;
+  burst->frame_count    = frame_count;
+  burst->sent_count     = 0;
+
+  // Register the burst and queue its frames in one go, so that they stay contiguous in the queue
+  CORE_irqState_t state = CORE_EnterAtomic();
+  if (transceiver_burst_tail == NULL) {
+    transceiver_burst_head = burst;
+  } else {
+    transceiver_burst_tail->next = burst;
   }
+  transceiver_burst_tail = burst;
+  sli_si91x_append_chain_to_buffer_queue(&sli_tx_data_queue, head, tail);
+  tx_generic_socket_data_queues_status |= SL_SI91X_GENERIC_DATA_TX_PENDING_EVENT;
+  sl_si91x_host_set_bus_event(SL_SI91X_GENERIC_DATA_TX_PENDING_EVENT);
+  CORE_ExitAtomic(state);
 
-  if (IS_QOS_PKT(control->ctrl_flags) && !IS_BCAST_MCAST_MAC(control->addr1[0])) {
-    host_desc[13] |= QOS_ENABLE; // QOS ENABLE
+  return SL_STATUS_OK;
+}
+
+void sli_si91x_transceiver_burst_frame_sent(const sl_wifi_buffer_t *buffer, sl_status_t status)
+{
+  sli_si91x_transceiver_burst_t *burst;
+  uint16_t frame_index;
+  bool burst_done = false;
+
+  CORE_irqState_t state = CORE_EnterAtomic();
+  burst = transceiver_burst_head;
+  // Queued buffers stay allocated until they are written, so a match can only be the expected frame
+  if ((burst == NULL) || (burst->next_buffer != buffer)) {
+    CORE_ExitAtomic(state);
+    return;
+  }
+
+  frame_index = burst->sent_count++;
+  if (burst->sent_count == burst->frame_count) {
+    transceiver_burst_head = burst->next;
+    if (transceiver_burst_head == NULL) {
+      transceiver_burst_tail = NULL;
+    }
+    burst_done = true;
+  } else {
+    burst->next_buffer = (const sl_wifi_buffer_t *)buffer->node.node;
   }
+  CORE_ExitAtomic(state);
 
-  host_desc[14] =
-    (uint8_t)(((WME_AC_TO_TID(control->priority) & 0xf) << 4) | (WME_AC_TO_QNUM(control->priority) & 0xf));
+  if (burst->callback != NULL) {
+    burst->callback(frame_index, status, burst->arg);
+  }
 
-  //! Initialize extended desc
-  memcpy(&host_desc[16], &control->token, TRANSCEIVER_TX_DATA_EXT_DESC_SIZE);
+  if (burst_done) {
+    sl_si91x_host_free_buffer(burst->context_buffer);
+  }
+}
 
-  // Send command packet to the SI91x socket data queue and await a response
-  return sl_si91x_driver_send_data_packet(buffer, wait_time);
+void sli_si91x_transceiver_burst_abort_all(void)
+{
+  sli_si91x_transceiver_burst_t *burst;
+  sli_si91x_transceiver_burst_t *next;
+
+  CORE_irqState_t state  = CORE_EnterAtomic();
+  burst                  = transceiver_burst_head;
+  transceiver_burst_head = NULL;
+  transceiver_burst_tail = NULL;
+  CORE_ExitAtomic(state);
+
+  while (burst != NULL) {
+    next = burst->next;
+    for (uint16_t i = burst->sent_count; i < burst->frame_count; i++) {
+      if (burst->callback != NULL) {
+        burst->callback(i, SL_STATUS_ABORT, burst->arg);
+      }
+    }
+    sl_si91x_host_free_buffer(burst->context_buffer);
+    burst = next;
+  }
 }
 
 sl_status_t sl_si91x_bl_upgrade_firmware(uint8_t *firmware_image, uint32_t fw_image_size, uint8_t flags)
@@ -2550,6 +2731,21 @@ void sli_si91x_append_to_buffer_queue(sl_si91x_buffer_queue_t *queue, sl_wifi_bu
   CORE_ExitAtomic(state);
 }
 
+void sli_si91x_append_chain_to_buffer_queue(sl_si91x_buffer_queue_t *queue,
+                                            sl_wifi_buffer_t *head,
+                                            sl_wifi_buffer_t *tail)
+{
+  CORE_irqState_t state = CORE_EnterAtomic();
+  if (queue->tail == NULL) {
+    assert(queue->head == NULL); // Both should be NULL at the same time
+    queue->head = head;
+  } else {
+    queue->tail->node.node = &head->node;
+  }
+  queue->tail = tail;
+  CORE_ExitAtomic(state);
+}
+
 sl_status_t sli_si91x_pop_from_buffer_queue(sl_si91x_buffer_queue_t *queue, sl_wifi_buffer_t **buffer)
 {
   sl_status_t status    = SL_STATUS_EMPTY;
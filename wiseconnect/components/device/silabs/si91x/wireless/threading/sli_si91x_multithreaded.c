@@ -1626,6 +1626,9 @@ static sl_status_t bus_write_data_frame(sl_si91x_buffer_queue_t *queue)
     sl_si91x_host_clear_sleep_indicator();
   }
 
+  // Report the frame to its transceiver burst, if any, while the buffer is still allocated
+  sli_si91x_transceiver_burst_frame_sent(buffer, status);
+
   sl_si91x_host_free_buffer(buffer);
   return SL_STATUS_OK;
 }
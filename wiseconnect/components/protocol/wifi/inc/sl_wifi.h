@@ -1578,6 +1578,83 @@ sl_status_t sl_wifi_send_transceiver_data(sl_wifi_interface_t interface,
                                           sl_wifi_transceiver_tx_data_control_t *control,
                                           uint8_t *payload,
                                           uint16_t payload_len);
+
+/***************************************************************************/ /**
+ * @brief Host shall call this API to prepare the host descriptor and 802.11 MAC header shared by a burst of transceiver frames.
+ *
+ * @pre Pre-conditions:
+ * - @ref sl_wifi_transceiver_set_channel shall be called before this API.
+ *
+ * @param[in] interface
+ *   Wi-Fi interface as identified by @ref sl_wifi_interface_t
+ * @param[in] control
+ *   Metadata shared by all frames sent with the template. See @ref sl_wifi_transceiver_tx_data_control_t. The token is ignored, each frame carries its own.
+ * @param[out] tx_template
+ *   Template to be passed to @ref sl_wifi_send_transceiver_data_burst. See @ref sl_wifi_transceiver_tx_template_t.
+ *
+ * @return
+ *   sl_status_t. See [Status Codes](../../wiseconnect-api-reference-guide-err-codes/pages/sl-additional-status-errors). Possible Error Codes:
+ *   - `0x11` - SL_STATUS_NOT_INITIALIZED
+ *   - `0x0B44` - SL_STATUS_WIFI_INTERFACE_NOT_UP
+ *   - `0x0B63` - SL_STATUS_TRANSCEIVER_INVALID_MAC_ADDRESS
+ *   - `0x0B64` - SL_STATUS_TRANSCEIVER_INVALID_QOS_PRIORITY
+ *   - `0x0B66` - SL_STATUS_TRANSCEIVER_INVALID_DATA_RATE
+ *   - `0x22` - SL_STATUS_NULL_POINTER
+ *
+ * @note This API is only supported in Wi-Fi Transceiver opermode (7).
+ * @note A template can be reused for any number of bursts to the same peer with the same flags, priority and rate.
+ ******************************************************************************/
+sl_status_t sl_wifi_prepare_transceiver_tx_template(sl_wifi_interface_t interface,
+                                                    sl_wifi_transceiver_tx_data_control_t *control,
+                                                    sl_wifi_transceiver_tx_template_t *tx_template);
+
+/***************************************************************************/ /**
+ * @brief Host shall call this API to queue several payloads sharing the same MAC header for transmission to MAC layer.
+ *
+ * @pre Pre-conditions:
+ * - @ref sl_wifi_prepare_transceiver_tx_template shall be called before this API.
+ *
+ * @param[in] interface
+ *   Wi-Fi interface as identified by @ref sl_wifi_interface_t
+ * @param[in] tx_template
+ *   Template prepared by @ref sl_wifi_prepare_transceiver_tx_template.
+ * @param[in] frames
+ *   Array of frames to be sent. See @ref sl_wifi_transceiver_burst_frame_t. Each payload is 1 - 2020 bytes.
+ * @param[in] frame_count
+ *   Number of frames in the array.
+ * @param[in] callback
+ *   Called once per frame, in order, when the frame has been handed to the NWP. See @ref sl_wifi_transceiver_burst_callback_t. May be NULL.
+ * @param[in] arg
+ *   Argument passed to the callback.
+ *
+ * @return
+ *   sl_status_t. See [Status Codes](../../wiseconnect-api-reference-guide-err-codes/pages/sl-additional-status-errors). Possible Error Codes:
+ *   - `0x11` - SL_STATUS_NOT_INITIALIZED
+ *   - `0x0B44` - SL_STATUS_WIFI_INTERFACE_NOT_UP
+ *   - `0x19` - SL_STATUS_ALLOCATION_FAILED
+ *   - `0x21` - SL_STATUS_INVALID_PARAMETER
+ *   - `0x22` - SL_STATUS_NULL_POINTER
+ *
+ * @note This API is only supported in Wi-Fi Transceiver opermode (7).
+ * @note All frames are queued together, or none of them if this API fails. The bus thread is woken up once for the whole burst.
+ * @note Payloads are copied before this API returns. The frames array and payloads may be reused right away.
+ * @note The TX status report from firmware is still delivered through SL_WIFI_TRANSCEIVER_TX_DATA_STATUS_CB, using each frame's token.
+ * @note Sample command usage:
+ * @code
+ * sl_wifi_transceiver_tx_template_t tx_template;
+ * sl_wifi_transceiver_burst_frame_t frames[4];
+ *
+ * sl_wifi_prepare_transceiver_tx_template(SL_WIFI_TRANSCEIVER_INTERFACE, control, &tx_template);
+ * <Fill payload, payload_len and token of each frame>
+ * sl_wifi_send_transceiver_data_burst(SL_WIFI_TRANSCEIVER_INTERFACE, &tx_template, frames, 4, burst_callback, NULL);
+ * @endcode
+ ******************************************************************************/
+sl_status_t sl_wifi_send_transceiver_data_burst(sl_wifi_interface_t interface,
+                                                const sl_wifi_transceiver_tx_template_t *tx_template,
+                                                const sl_wifi_transceiver_burst_frame_t *frames,
+                                                uint16_t frame_count,
+                                                sl_wifi_transceiver_burst_callback_t callback,
+                                                void *arg);
 /** @} */
 
 /**
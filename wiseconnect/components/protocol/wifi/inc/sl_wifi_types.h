@@ -717,6 +717,50 @@ typedef struct {
   uint8_t addr4[6]; ///< Source MAC address. Initialization of addr4 is optional
 } sl_wifi_transceiver_tx_data_control_t;
 
+/**
+ * @struct sl_wifi_transceiver_tx_template_t
+ * @brief Wi-Fi transceiver TX template.
+ *
+ * Host descriptor and 802.11 MAC header prepared once from a @ref sl_wifi_transceiver_tx_data_control_t by @ref sl_wifi_prepare_transceiver_tx_template,
+ * and shared by all the frames sent with @ref sl_wifi_send_transceiver_data_burst.
+ * @note The application shall not modify the fields of a prepared template.
+ */
+typedef struct {
+  uint8_t host_desc[16]; ///< Host descriptor. The frame length is filled in per frame
+  uint8_t mac_header[MAC80211_HDR_MIN_LEN + MAC80211_HDR_ADDR4_LEN
+                     + MAC80211_HDR_QOS_CTRL_LEN]; ///< 802.11 MAC header. The sequence control is filled in per frame if required
+  uint8_t mac_header_length;                       ///< Length of the MAC header
+  uint8_t ctrl_flags;                              ///< Control flags of the frames, as adjusted for the receiver address
+} sl_wifi_transceiver_tx_template_t;
+
+/**
+ * @struct sl_wifi_transceiver_burst_frame_t
+ * @brief Wi-Fi transceiver burst frame.
+ *
+ * Payload and token of one of the frames passed to @ref sl_wifi_send_transceiver_data_burst.
+ */
+typedef struct {
+  const uint8_t *payload; ///< Pointer to payload (encrypted by host) to be sent to LMAC
+  uint16_t payload_len;   ///< Length of the payload. Valid range is 1 - 2020 bytes
+  uint32_t
+    token; ///< Data packet identifier. MAC layer sends the same token in the status report if the template requests TX data status reports
+} sl_wifi_transceiver_burst_frame_t;
+
+/**
+ * @brief Wi-Fi transceiver burst frame completion callback.
+ *
+ * Called once for each frame of a burst sent with @ref sl_wifi_send_transceiver_data_burst, in the order of the frames.
+ *
+ * @param[in] frame_index
+ *   Index of the frame in the array passed to @ref sl_wifi_send_transceiver_data_burst.
+ * @param[in] status
+ *   SL_STATUS_OK if the frame has been handed over to the NWP. SL_STATUS_ABORT if the frame was dropped because the driver was deinitialized.
+ * @param[in] arg
+ *   User argument passed to @ref sl_wifi_send_transceiver_data_burst.
+ * @note The callback is called from the bus thread context. It should return quickly and must not call APIs that wait for the bus thread.
+ */
+typedef void (*sl_wifi_transceiver_burst_callback_t)(uint16_t frame_index, sl_status_t status, void *arg);
+
 /**
  * @struct sl_wifi_transceiver_cw_config_t
  * @brief Wi-Fi transceiver contention window configuration structure.
@@ -2450,6 +2450,62 @@ sl_status_t sl_wifi_send_transceiver_data(sl_wifi_interface_t interface,
   return status;
 }
 
+sl_status_t sl_wifi_prepare_transceiver_tx_template(sl_wifi_interface_t interface,
+                                                    sl_wifi_transceiver_tx_data_control_t *control,
+                                                    sl_wifi_transceiver_tx_template_t *tx_template)
+{
+  if (!device_initialized) {
+    return SL_STATUS_NOT_INITIALIZED;
+  }
+
+  if (!sl_wifi_is_interface_up(interface)) {
+    return SL_STATUS_WIFI_INTERFACE_NOT_UP;
+  }
+
+  SL_VERIFY_POINTER_OR_RETURN(control, SL_STATUS_NULL_POINTER);
+  SL_VERIFY_POINTER_OR_RETURN(tx_template, SL_STATUS_NULL_POINTER);
+
+  if (IS_FIXED_DATA_RATE(control->ctrl_flags)) {
+    if (validate_datarate(control->rate)) {
+      return SL_STATUS_TRANSCEIVER_INVALID_DATA_RATE;
+    }
+  }
+
+  return sl_si91x_driver_prepare_transceiver_tx_template(control, tx_template);
+}
+
+sl_status_t sl_wifi_send_transceiver_data_burst(sl_wifi_interface_t interface,
+                                                const sl_wifi_transceiver_tx_template_t *tx_template,
+                                                const sl_wifi_transceiver_burst_frame_t *frames,
+                                                uint16_t frame_count,
+                                                sl_wifi_transceiver_burst_callback_t callback,
+                                                void *arg)
+{
+  if (!device_initialized) {
+    return SL_STATUS_NOT_INITIALIZED;
+  }
+
+  if (!sl_wifi_is_interface_up(interface)) {
+    return SL_STATUS_WIFI_INTERFACE_NOT_UP;
+  }
+
+  SL_VERIFY_POINTER_OR_RETURN(tx_template, SL_STATUS_NULL_POINTER);
+  SL_VERIFY_POINTER_OR_RETURN(frames, SL_STATUS_NULL_POINTER);
+
+  if (!frame_count) {
+    return SL_STATUS_INVALID_PARAMETER;
+  }
+
+  for (uint16_t i = 0; i < frame_count; i++) {
+    if ((!frames[i].payload_len) || (frames[i].payload_len > MAX_PAYLOAD_LEN)) {
+      return SL_STATUS_INVALID_PARAMETER;
+    }
+    SL_VERIFY_POINTER_OR_RETURN(frames[i].payload, SL_STATUS_NULL_POINTER);
+  }
+
+  return sl_si91x_driver_send_transceiver_data_burst(tx_template, frames, frame_count, callback, arg);
+}
+
 sl_status_t sl_wifi_update_transceiver_peer_list(sl_wifi_interface_t interface, sl_wifi_transceiver_peer_update_t peer)
 {
   sl_status_t status = SL_STATUS_OK;